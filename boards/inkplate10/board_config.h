@@ -22,6 +22,7 @@
 #define HAS_FRONTLIGHT false
 #define HAS_BATTERY true
 #define HAS_BUTTON true  // Inkplate 10 has a wake button
+#define HAS_RTC true  // PCF85063A real-time clock (keeps time in deep sleep)
 
 // Board-specific pins
 // Inkplate 10 specific pins
@@ -34,6 +35,13 @@
 // Board-specific settings
 #define DISPLAY_TIMEOUT_MS 15000  // Larger display, longer timeout
 
+// Power model for battery life estimates (energy_model.h) - typical values
+#define POWER_ACTIVE_MA 45        // ESP32 awake, WiFi off
+#define POWER_WIFI_MA 110         // ESP32 awake, WiFi on
+#define POWER_DISPLAY_MA 60       // Added during a panel refresh
+#define POWER_SLEEP_UA 22         // Deep sleep, whole board
+#define BATTERY_CAPACITY_MAH 3000 // Inkplate 10 ships with a 3000 mAh battery
+
 // Font definitions using GFXfonts
 // Font objects are defined in font headers included by main_sketch.ino.inc
 // These macros reference the font objects by name
@@ -24,6 +24,7 @@
 #define HAS_FRONTLIGHT false
 #define HAS_BATTERY true
 #define HAS_BUTTON false  // Inkplate 2 does not have a physical button
+#define HAS_RTC false  // Inkplate 2 has no RTC chip
 
 // Board-specific pins
 // Note: Inkplate 2 does not have a physical button, but we define a dummy pin
@@ -40,6 +41,13 @@
 // Watchdog timer timeout (Inkplate 2's display update takes ~20 seconds)
 #define WATCHDOG_TIMEOUT_SECONDS 60
 
+// Power model for battery life estimates (energy_model.h) - typical values
+#define POWER_ACTIVE_MA 40        // ESP32 awake, WiFi off
+#define POWER_WIFI_MA 110         // ESP32 awake, WiFi on
+#define POWER_DISPLAY_MA 15       // Added during a panel refresh
+#define POWER_SLEEP_UA 20         // Deep sleep, whole board
+#define BATTERY_CAPACITY_MAH 600  // Inkplate 2 ships with a 600 mAh battery
+
 // Font definitions using GFXfonts
 // Font objects are defined in font headers included by main_sketch.ino.inc
 // These macros reference the font objects by name
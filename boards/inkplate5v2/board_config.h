@@ -22,6 +22,7 @@
 #define HAS_FRONTLIGHT false
 #define HAS_BATTERY true
 #define HAS_BUTTON true  // Inkplate 5 V2 has a wake button
+#define HAS_RTC true  // PCF85063A real-time clock (keeps time in deep sleep)
 
 // Board-specific pins
 #define WAKE_BUTTON_PIN 36  // GPIO36 - Wake button for config mode
@@ -33,6 +34,13 @@
 // Board-specific settings
 #define DISPLAY_TIMEOUT_MS 10000
 
+// Power model for battery life estimates (energy_model.h) - typical values
+#define POWER_ACTIVE_MA 45        // ESP32 awake, WiFi off
+#define POWER_WIFI_MA 110         // ESP32 awake, WiFi on
+#define POWER_DISPLAY_MA 45       // Added during a panel refresh
+#define POWER_SLEEP_UA 20         // Deep sleep, whole board
+#define BATTERY_CAPACITY_MAH 1200 // Inkplate 5 V2 ships with a 1200 mAh battery
+
 // Font definitions using GFXfonts
 // Font objects are defined in font headers included by main_sketch.ino.inc
 // These macros reference the font objects by name
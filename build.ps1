@@ -31,6 +31,15 @@ if (Test-Path $VERSION_FILE) {
     $FIRMWARE_VERSION = "unknown"
 }
 
+# Minify + gzip the config portal stylesheet and scripts (config_portal_assets.h, rewritten only when they changed)
+$python = Get-Command python3 -ErrorAction SilentlyContinue
+if (-not $python) { $python = Get-Command python -ErrorAction SilentlyContinue }
+if ($python) {
+    & $python.Source (Join-Path $WORKSPACE_PATH "scripts\generate_portal_assets.py")
+} else {
+    Write-Host "Warning: Python not found, using the committed config_portal_assets.h" -ForegroundColor Yellow
+}
+
 # Board configurations
 $boards = @{
     'inkplate2' = @{
@@ -20,6 +20,13 @@ else
     FIRMWARE_VERSION="unknown"
 fi
 
+# Minify + gzip the config portal stylesheet and scripts (config_portal_assets.h, rewritten only when they changed)
+if command -v python3 >/dev/null 2>&1; then
+    python3 "$WORKSPACE_PATH/scripts/generate_portal_assets.py"
+else
+    echo "⚠️  Warning: python3 not found, using the committed config_portal_assets.h"
+fi
+
 # Board configurations
 declare -A BOARDS=(
     [inkplate2]="Inkplate 2|Inkplate_Boards:esp32:Inkplate2|boards/inkplate2"
@@ -0,0 +1,120 @@
+#include "clock_manager.h"
+#include "logger.h"
+#include <esp_sntp.h>
+#include <sys/time.h>
+
+ClockManager::ClockManager(Inkplate* display)
+    : _display(display), _state(nullptr), _rtcChipValid(false) {
+}
+
+void ClockManager::setClockState(ClockState* state) {
+    _state = state;
+    if (_state != nullptr && !isClockStateValid(*_state)) {
+        initClockState(*_state);
+    }
+}
+
+void ClockManager::begin(bool timerWake) {
+#if defined(HAS_RTC) && HAS_RTC == true
+    if (_display->rtcIsSet()) {
+        uint32_t chipTime = _display->rtcGetEpoch();
+        if (chipTime >= CLOCK_MIN_VALID_TIME) {
+            _rtcChipValid = true;
+            setSystemTime(chipTime);
+            return;
+        }
+    }
+#endif
+    if (_state == nullptr) {
+        return;
+    }
+
+    uint32_t now = (uint32_t)time(nullptr);
+    if (now < CLOCK_MIN_VALID_TIME || (_state->sleepStartedAt != 0 && now < _state->sleepStartedAt)) {
+        // System clock lost while RTC memory survived: fall back to the sleep record
+        uint32_t wakeTime = timerWake ? estimateClockWakeTime(*_state) : 0;
+        if (wakeTime != 0) {
+            setSystemTime(wakeTime + millis() / 1000);
+            Logger::begin("Clock");
+            Logger::line("System clock lost - restored from the sleep record");
+            Logger::end();
+        }
+        return;
+    }
+
+    uint32_t corrected = applyClockDriftCorrection(*_state, now);
+    if (corrected != now) {
+        setSystemTime(corrected);
+    }
+}
+
+uint32_t ClockManager::getEstimatedError() {
+    if (_state == nullptr) {
+        return CLOCK_ERROR_UNKNOWN;
+    }
+    return estimateClockErrorSeconds(*_state, (uint32_t)time(nullptr), _rtcChipValid);
+}
+
+bool ClockManager::isSyncNeeded() {
+    return getEstimatedError() > CLOCK_MAX_ERROR_SECONDS;
+}
+
+bool ClockManager::syncWithNtp(uint32_t timeoutMs) {
+    uint32_t before = (uint32_t)time(nullptr);
+    unsigned long start = millis();
+
+    // The clock is usually valid already - wait for SNTP itself, not for a plausible time
+    sntp_set_sync_status(SNTP_SYNC_STATUS_RESET);
+    configTime(0, 0, "pool.ntp.org", "time.nist.gov");
+    while (sntp_get_sync_status() != SNTP_SYNC_STATUS_COMPLETED && millis() - start < timeoutMs) {
+        delay(100);
+    }
+    if (sntp_get_sync_status() != SNTP_SYNC_STATUS_COMPLETED) {
+        return false;
+    }
+
+    uint32_t clockBefore = before + (millis() - start + 500) / 1000;
+    uint32_t now = (uint32_t)time(nullptr);
+    if (_state != nullptr) {
+        recordClockSync(*_state, clockBefore, now, CLOCK_SOURCE_NTP, _rtcChipValid);
+    }
+    setRtcChip(now);
+    return true;
+}
+
+bool ClockManager::syncFromHttpDate(const char* date) {
+    uint32_t serverTime;
+    if (!parseHttpDate(date, serverTime)) {
+        return false;
+    }
+    uint32_t now = (uint32_t)time(nullptr);
+    if (_state == nullptr || !shouldUseHttpDate(*_state, now, serverTime, _rtcChipValid)) {
+        return false;
+    }
+
+    setSystemTime(serverTime);
+    recordClockSync(*_state, now, serverTime, CLOCK_SOURCE_HTTP_DATE, _rtcChipValid);
+    setRtcChip(serverTime);
+    Logger::linef("Clock set from HTTP Date (%+ld s)", (long)serverTime - (long)now);
+    return true;
+}
+
+void ClockManager::recordSleep(uint32_t sleepSeconds) {
+    if (_state != nullptr) {
+        recordClockSleep(*_state, (uint32_t)time(nullptr), sleepSeconds);
+    }
+}
+
+void ClockManager::setSystemTime(uint32_t time) {
+    struct timeval tv = { (time_t)time, 0 };
+    settimeofday(&tv, nullptr);
+}
+
+void ClockManager::setRtcChip(uint32_t time) {
+#if defined(HAS_RTC) && HAS_RTC == true
+    _display->rtcSetEpoch(time);
+    _rtcChipValid = true;
+#else
+    (void)time;
+#endif
+}
@@ -0,0 +1,56 @@
+#ifndef CLOCK_MANAGER_H
+#define CLOCK_MANAGER_H
+
+#include <Arduino.h>
+#include "Inkplate.h"
+#include "board_config.h"
+#include "clock_sync.h"
+
+#define NTP_SYNC_TIMEOUT_MS 7000  // Longest wait for the NTP answer
+
+/**
+ * @brief Keeps the system time across deep sleep so NTP is not needed on every wake
+ *
+ * Restores the time at wake (RTC chip on boards with HAS_RTC, otherwise the
+ * ESP32 clock with drift correction), decides whether NTP has to run, and
+ * takes the HTTP Date header as a free sync. Decisions are made by
+ * clock_sync.h on the state kept in RTC memory.
+ */
+class ClockManager {
+public:
+    ClockManager(Inkplate* display);
+
+    // Set the sync history and drift estimate (RTC memory); re-initialized when invalid
+    void setClockState(ClockState* state);
+
+    // Restore the system time after wake (call after the display, which starts I2C)
+    // timerWake: the sleep record may stand in for a lost system clock
+    void begin(bool timerWake);
+
+    // Estimated error of the system time in seconds (CLOCK_ERROR_UNKNOWN if never synced)
+    uint32_t getEstimatedError();
+
+    // True once the estimated error exceeds CLOCK_MAX_ERROR_SECONDS
+    bool isSyncNeeded();
+
+    // Sync with NTP, waiting up to timeoutMs for the answer
+    // Returns true if the clock was set
+    bool syncWithNtp(uint32_t timeoutMs = NTP_SYNC_TIMEOUT_MS);
+
+    // Set the clock from an HTTP Date header when that improves it
+    // Returns true if the clock was set
+    bool syncFromHttpDate(const char* date);
+
+    // Remember the deep sleep about to start (0 = button only)
+    void recordSleep(uint32_t sleepSeconds);
+
+private:
+    Inkplate* _display;
+    ClockState* _state;   // RTC memory, may be null (every wake then needs NTP)
+    bool _rtcChipValid;   // Time comes from a set RTC chip
+
+    void setSystemTime(uint32_t time);
+    void setRtcChip(uint32_t time);
+};
+
+#endif // CLOCK_MANAGER_H
@@ -0,0 +1,147 @@
+#include <clock_sync.h>
+#include <stdio.h>
+#include <string.h>
+
+static const char MONTH_NAMES[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+
+// Days since 1970-01-01 of a proleptic Gregorian date (month 1..12)
+static int64_t daysFromCivil(int64_t year, int month, int day) {
+    year -= month <= 2 ? 1 : 0;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    int64_t yearOfEra = year - era * 400;
+    int64_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+static int daysInMonth(int year, int month) {
+    static const int DAYS[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    return month == 2 && leap ? 29 : DAYS[month - 1];
+}
+
+void initClockState(ClockState& state) {
+    memset(&state, 0, sizeof(state));
+    state.version = CLOCK_STATE_VERSION;
+}
+
+bool isClockStateValid(const ClockState& state) {
+    return state.version == CLOCK_STATE_VERSION &&
+           state.source <= CLOCK_SOURCE_HTTP_DATE &&
+           state.driftPpm >= -CLOCK_MAX_DRIFT_PPM && state.driftPpm <= CLOCK_MAX_DRIFT_PPM;
+}
+
+uint32_t applyClockDriftCorrection(ClockState& state, uint32_t now) {
+    if (state.syncedAt == 0 || state.driftSamples == 0 || now < state.syncedAt) {
+        return now;
+    }
+    // Raw clock seconds since the sync = corrected elapsed + what was already taken off
+    int64_t rawElapsed = (int64_t)(now - state.syncedAt) + state.correctionS;
+    int64_t total = rawElapsed * state.driftPpm / 1000000;
+    int64_t delta = total - state.correctionS;
+    state.correctionS = (int32_t)total;
+    return (uint32_t)((int64_t)now - delta);
+}
+
+uint32_t estimateClockErrorSeconds(const ClockState& state, uint32_t now, bool rtcChip) {
+    if (state.syncedAt == 0 || now < CLOCK_MIN_VALID_TIME || now < state.syncedAt) {
+        return CLOCK_ERROR_UNKNOWN;
+    }
+    uint64_t ppm = rtcChip ? CLOCK_RTC_CHIP_DRIFT_PPM :
+                   state.driftSamples > 0 ? CLOCK_RESIDUAL_DRIFT_PPM : CLOCK_DEFAULT_DRIFT_PPM;
+    uint64_t drift = ((uint64_t)(now - state.syncedAt) * ppm + 999999) / 1000000;
+    uint64_t error = drift + (state.source == CLOCK_SOURCE_HTTP_DATE ? CLOCK_HTTP_DATE_ERROR_SECONDS
+                                                                     : CLOCK_NTP_ERROR_SECONDS);
+    return error < CLOCK_ERROR_UNKNOWN ? (uint32_t)error : CLOCK_ERROR_UNKNOWN - 1;
+}
+
+bool isClockSyncNeeded(const ClockState& state, uint32_t now, bool rtcChip) {
+    return estimateClockErrorSeconds(state, now, rtcChip) > CLOCK_MAX_ERROR_SECONDS;
+}
+
+bool shouldUseHttpDate(const ClockState& state, uint32_t now, uint32_t serverTime, bool rtcChip) {
+    if (serverTime < CLOCK_MIN_VALID_TIME) {
+        return false;
+    }
+    uint32_t error = estimateClockErrorSeconds(state, now, rtcChip);
+    if (error == CLOCK_ERROR_UNKNOWN) {
+        return true;
+    }
+    if (error <= CLOCK_HTTP_DATE_MIN_ERROR_SECONDS) {
+        return false;
+    }
+    uint32_t skew = serverTime > now ? serverTime - now : now - serverTime;
+    return skew <= (uint64_t)error + CLOCK_HTTP_DATE_MAX_SKEW_SECONDS;
+}
+
+void recordClockSync(ClockState& state, uint32_t clockBefore, uint32_t syncedTime, uint8_t source, bool rtcChip) {
+    // Drift is only measured between NTP syncs: a Date header's latency would swamp it
+    if (!rtcChip && source == CLOCK_SOURCE_NTP && state.source == CLOCK_SOURCE_NTP &&
+        state.syncedAt != 0 && clockBefore >= CLOCK_MIN_VALID_TIME && syncedTime > state.syncedAt &&
+        syncedTime - state.syncedAt >= CLOCK_DRIFT_MIN_INTERVAL_S) {
+        // What the corrected clock still ran off, as a rate over the interval
+        int64_t residual = ((int64_t)clockBefore - (int64_t)syncedTime) * 1000000 /
+                           (int64_t)(syncedTime - state.syncedAt);
+        int64_t drift = state.driftPpm + (state.driftSamples == 0 ? residual : residual / 2);
+        if (drift > CLOCK_MAX_DRIFT_PPM) {
+            drift = CLOCK_MAX_DRIFT_PPM;
+        } else if (drift < -CLOCK_MAX_DRIFT_PPM) {
+            drift = -CLOCK_MAX_DRIFT_PPM;
+        }
+        state.driftPpm = (int32_t)drift;
+        if (state.driftSamples < 0xFF) {
+            state.driftSamples++;
+        }
+    }
+    state.source = source;
+    state.syncedAt = syncedTime;
+    state.correctionS = 0;
+}
+
+void recordClockSleep(ClockState& state, uint32_t now, uint32_t sleepSeconds) {
+    state.sleepStartedAt = now >= CLOCK_MIN_VALID_TIME ? now : 0;
+    state.sleepSeconds = sleepSeconds;
+}
+
+uint32_t estimateClockWakeTime(const ClockState& state) {
+    if (state.sleepStartedAt == 0 || state.sleepSeconds == 0) {
+        return 0;
+    }
+    return state.sleepStartedAt + state.sleepSeconds;
+}
+
+bool parseHttpDate(const char* text, uint32_t& outTime) {
+    if (text == nullptr) {
+        return false;
+    }
+    const char* comma = strchr(text, ',');
+    if (comma == nullptr) {
+        return false;
+    }
+    int day, year, hour, minute, second;
+    char month[4];
+    char zone[4];
+    if (sscanf(comma + 1, " %2d %3s %4d %2d:%2d:%2d %3s",
+               &day, month, &year, &hour, &minute, &second, zone) != 7 ||
+        strcmp(zone, "GMT") != 0 || strlen(month) != 3) {
+        return false;
+    }
+    const char* found = strstr(MONTH_NAMES, month);
+    if (found == nullptr || (found - MONTH_NAMES) % 3 != 0) {
+        return false;
+    }
+    int monthNumber = (int)(found - MONTH_NAMES) / 3 + 1;
+    if (year < 1970 || year > 2105 || day < 1 || day > daysInMonth(year, monthNumber) ||
+        hour < 0 || hour > 23 || minute < 0 || minute > 59 || second < 0 || second > 60) {
+        return false;
+    }
+    if (second == 60) {
+        second = 59;  // Leap second
+    }
+    int64_t time = daysFromCivil(year, monthNumber, day) * 86400 + hour * 3600 + minute * 60 + second;
+    if (time > 0xFFFFFFFFLL) {
+        return false;
+    }
+    outTime = (uint32_t)time;
+    return true;
+}
@@ -0,0 +1,138 @@
+#ifndef CLOCK_SYNC_H
+#define CLOCK_SYNC_H
+
+#include <stdint.h>
+
+// Layout version - bump when the struct changes so stale RTC contents are discarded
+#define CLOCK_STATE_VERSION 1
+#define CLOCK_MIN_VALID_TIME 1600000000u    // Earlier = clock never set (2020-09-13)
+#define CLOCK_MAX_ERROR_SECONDS 60          // Sync with NTP once the estimated error exceeds this
+#define CLOCK_NTP_ERROR_SECONDS 1           // Error right after an NTP sync
+#define CLOCK_HTTP_DATE_ERROR_SECONDS 2     // Date header: whole seconds plus request latency
+#define CLOCK_HTTP_DATE_MIN_ERROR_SECONDS 5 // Below this a Date header is not worth a clock step
+#define CLOCK_HTTP_DATE_MAX_SKEW_SECONDS 600  // Date further off than the error estimate allows is ignored
+#define CLOCK_DEFAULT_DRIFT_PPM 20000       // ESP32 RTC slow clock without a drift estimate
+#define CLOCK_RESIDUAL_DRIFT_PPM 2000       // After drift correction (temperature changes)
+#define CLOCK_RTC_CHIP_DRIFT_PPM 50         // PCF85063A with its crystal
+#define CLOCK_MAX_DRIFT_PPM 100000          // Larger estimates are clamped
+#define CLOCK_DRIFT_MIN_INTERVAL_S 3600     // Shorter sync intervals: 1 s resolution dominates
+#define CLOCK_ERROR_UNKNOWN 0xFFFFFFFFu
+
+/**
+ * @brief Time keeping across deep sleep without NTP on every wake
+ *
+ * Pure C++ with NO dependencies on Arduino/ESP32 APIs, making it fully
+ * testable with standard C++ unit testing frameworks.
+ *
+ * The ESP32 system clock keeps running in deep sleep, but on the RTC slow
+ * clock, which drifts by up to a few percent. The last sync is kept in RTC
+ * memory, and successive NTP syncs measure how far the clock ran off in
+ * between; that drift is then taken off the clock on every wake. The
+ * estimated error (sync accuracy plus remaining drift since the sync)
+ * decides whether NTP has to run. Boards with an RTC chip keep their time
+ * there and need NTP rarely.
+ *
+ * The HTTP Date header of the image server is a second, free time source:
+ * it is applied when the estimated error is large enough to gain from it.
+ *
+ * Times are Unix seconds (UTC).
+ */
+
+enum ClockSource {
+    CLOCK_SOURCE_NONE = 0,
+    CLOCK_SOURCE_NTP = 1,
+    CLOCK_SOURCE_HTTP_DATE = 2
+};
+
+/**
+ * @brief Last sync and drift estimate kept in RTC memory across deep sleep
+ */
+struct ClockState {
+    uint8_t version;            // CLOCK_STATE_VERSION (0 after a cold boot = invalid)
+    uint8_t source;             // ClockSource of the last sync
+    uint8_t driftSamples;       // NTP intervals folded into driftPpm (saturates)
+    uint8_t reserved;
+    uint32_t syncedAt;          // Time of the last sync, 0 = never
+    int32_t driftPpm;           // System clock rate error, positive = runs fast
+    int32_t correctionS;        // Seconds taken off the clock since syncedAt by drift correction
+    uint32_t sleepStartedAt;    // Clock when deep sleep was entered, 0 = unknown
+    uint32_t sleepSeconds;      // Sleep requested in PowerManager::enterDeepSleep()
+};
+
+/**
+ * @brief Reset to "never synced, no drift estimate"
+ */
+void initClockState(ClockState& state);
+
+/**
+ * @brief Check a state read from RTC memory
+ * @return false if it must be re-initialized
+ */
+bool isClockStateValid(const ClockState& state);
+
+/**
+ * @brief Take the drift accumulated since the last correction off the clock
+ *
+ * Keeps track of the correction already applied, so fractions of a second
+ * per wake add up instead of being lost.
+ *
+ * @param now Current system time
+ * @return Corrected time (now if there is no drift estimate)
+ */
+uint32_t applyClockDriftCorrection(ClockState& state, uint32_t now);
+
+/**
+ * @brief Estimated clock error in seconds
+ * @param rtcChip Time comes from a running RTC chip
+ * @return CLOCK_ERROR_UNKNOWN if never synced or the clock is not set
+ */
+uint32_t estimateClockErrorSeconds(const ClockState& state, uint32_t now, bool rtcChip);
+
+/**
+ * @brief Check whether NTP has to run this wake
+ */
+bool isClockSyncNeeded(const ClockState& state, uint32_t now, bool rtcChip);
+
+/**
+ * @brief Check whether a server Date should set the clock
+ *
+ * Only when the estimated error exceeds CLOCK_HTTP_DATE_MIN_ERROR_SECONDS,
+ * and the date is plausible: a synced clock ignores dates further off than
+ * its error estimate plus CLOCK_HTTP_DATE_MAX_SKEW_SECONDS (wrong server clock).
+ */
+bool shouldUseHttpDate(const ClockState& state, uint32_t now, uint32_t serverTime, bool rtcChip);
+
+/**
+ * @brief Record a sync
+ *
+ * Two NTP syncs at least CLOCK_DRIFT_MIN_INTERVAL_S apart update the drift
+ * estimate from how far the (already corrected) clock ran off in between.
+ *
+ * @param clockBefore System time just before the clock was set
+ * @param syncedTime Time the clock was set to
+ * @param source ClockSource
+ * @param rtcChip Time comes from an RTC chip (its drift is not the system clock's)
+ */
+void recordClockSync(ClockState& state, uint32_t clockBefore, uint32_t syncedTime, uint8_t source, bool rtcChip);
+
+/**
+ * @brief Remember when deep sleep starts and for how long (0 = button only)
+ */
+void recordClockSleep(ClockState& state, uint32_t now, uint32_t sleepSeconds);
+
+/**
+ * @brief Time a timer wake should have happened, from the sleep record
+ *
+ * Fallback for a wake whose system clock was lost or moved backwards.
+ *
+ * @return 0 if unknown
+ */
+uint32_t estimateClockWakeTime(const ClockState& state);
+
+/**
+ * @brief Parse an HTTP Date header (IMF-fixdate, e.g. "Sun, 06 Nov 1994 08:49:37 GMT")
+ * @return false if the text is not a valid date
+ */
+bool parseHttpDate(const char* text, uint32_t& outTime);
+
+#endif // CLOCK_SYNC_H
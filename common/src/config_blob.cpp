@@ -0,0 +1,320 @@
+#include <config_blob.h>
+#include <stdio.h>
+#include <string.h>
+
+#define CRC32_POLYNOMIAL 0xEDB88320u
+#define CONFIG_BLOB_CHECKED_OFFSET offsetof(ConfigBlob, settings)
+#define CONFIG_BLOB_MIN_BYTES (offsetof(ConfigBlob, strings) + CONFIG_STRING_COUNT)
+
+static const uint16_t STRING_LIMITS[CONFIG_STRING_COUNT] = {
+    MAX_SSID_LENGTH, MAX_WIFI_PASSWORD_LENGTH, MAX_FRIENDLY_NAME_LENGTH,
+    MAX_MQTT_BROKER_LENGTH, MAX_MQTT_USERNAME_LENGTH, MAX_MQTT_PASSWORD_LENGTH,
+    MAX_TLS_FINGERPRINT_LENGTH,
+    MAX_IPV4_LENGTH, MAX_IPV4_LENGTH, MAX_IPV4_LENGTH, MAX_IPV4_LENGTH, MAX_IPV4_LENGTH,  // Static IP, gateway, subnet, DNS 1 and 2
+    MAX_URL_LENGTH, MAX_URL_LENGTH, MAX_URL_LENGTH, MAX_URL_LENGTH, MAX_URL_LENGTH,
+    MAX_URL_LENGTH, MAX_URL_LENGTH, MAX_URL_LENGTH, MAX_URL_LENGTH, MAX_URL_LENGTH
+};
+
+// Legacy string keys in ConfigStringId order (image URLs are numbered)
+static const char* const LEGACY_STRING_KEYS[CONFIG_STR_IMAGE_URL] = {
+    PREF_WIFI_SSID, PREF_WIFI_PASS, PREF_FRIENDLY_NAME, PREF_MQTT_BROKER, PREF_MQTT_USER, PREF_MQTT_PASS,
+    PREF_TLS_FINGERPRINT, PREF_STATIC_IP, PREF_GATEWAY, PREF_SUBNET, PREF_PRIMARY_DNS, PREF_SECONDARY_DNS
+};
+
+static const char* const LEGACY_KEYS[] = {
+    PREF_CONFIGURED, PREF_IMAGE_URL, PREF_REFRESH_RATE, PREF_MQTT_BATCHED, PREF_USE_CRC32,
+    PREF_CHANGE_DETECTION, PREF_UPDATE_HOURS_0, PREF_UPDATE_HOURS_1, PREF_UPDATE_HOURS_2,
+    PREF_TIMEZONE_OFFSET, PREF_SCREEN_ROTATION, PREF_PARTIAL_REFRESH, PREF_FULL_REFRESH_EVERY,
+    PREF_USE_STATIC_IP, PREF_FRONTLIGHT_DURATION, PREF_FRONTLIGHT_BRIGHTNESS, PREF_OVERLAY_ENABLED,
+    PREF_OVERLAY_POSITION, PREF_OVERLAY_SHOW_BATTERY_ICON, PREF_OVERLAY_SHOW_BATTERY_PCT,
+    PREF_OVERLAY_SHOW_UPDATE_TIME, PREF_OVERLAY_SHOW_CYCLE_TIME, PREF_OVERLAY_SIZE, PREF_OVERLAY_TEXT_COLOR,
+    PREF_CONFIG_VERSION, PREF_IMAGE_COUNT, PREF_PREFETCH_COUNT
+};
+
+static uint32_t crc32Update(uint32_t crc, const uint8_t* data, size_t length) {
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (CRC32_POLYNOMIAL & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+static uint32_t blobChecksum(const uint8_t* data, size_t size) {
+    return crc32Update(0, data + CONFIG_BLOB_CHECKED_OFFSET, size - CONFIG_BLOB_CHECKED_OFFSET);
+}
+
+// Start of a string in the pool (the pool holds all CONFIG_STRING_COUNT strings)
+static char* findString(ConfigBlob& blob, int id) {
+    char* string = blob.strings;
+    for (int i = 0; i < id; i++) {
+        string += strlen(string) + 1;
+    }
+    return string;
+}
+
+static void setFlag(ConfigBlob& blob, uint16_t flag, bool enabled) {
+    if (enabled) {
+        blob.settings.flags |= flag;
+    } else {
+        blob.settings.flags &= ~flag;
+    }
+}
+
+static void formatIndexedKey(char* key, size_t size, const char* prefix, int index) {
+    snprintf(key, size, "%s%d", prefix, index);
+}
+
+// false if the key holds a string over the limit (getString() fails on it, the key stays)
+static bool migrateString(ConfigKeyStore& store, ConfigBlob& blob, ConfigStringId id, const char* key) {
+    char value[MAX_URL_LENGTH + 1];
+    if (store.getString(key, value, getConfigStringLimit(id) + 1)) {
+        return setConfigString(blob, id, value);
+    }
+    return !store.isKey(key);
+}
+
+static bool rejectLegacyKey(const char** rejectedKey, const char* key) {
+    if (rejectedKey != nullptr) {
+        *rejectedKey = key;
+    }
+    return false;
+}
+
+void initConfigBlob(ConfigBlob& blob) {
+    memset(&blob, 0, sizeof(blob));
+    blob.magic = CONFIG_BLOB_MAGIC;
+    blob.version = CONFIG_VERSION_CURRENT;
+    blob.size = CONFIG_BLOB_MIN_BYTES;  // Every string empty = one terminator each
+
+    ConfigSettings& s = blob.settings;
+    s.flags = CONFIG_FLAG_OVERLAY_BATTERY_ICON | CONFIG_FLAG_OVERLAY_BATTERY_PCT | CONFIG_FLAG_OVERLAY_UPDATE_TIME;
+    s.changeDetection = CHANGE_DETECTION_CRC32;
+    s.updateHours[0] = 0xFF;
+    s.updateHours[1] = 0xFF;
+    s.updateHours[2] = 0xFF;
+    s.screenRotation = DEFAULT_SCREEN_ROTATION;
+    s.fullRefreshEvery = DEFAULT_FULL_REFRESH_EVERY;
+    s.prefetchCount = DEFAULT_PREFETCH_COUNT;
+    s.frontlightBrightness = DEFAULT_FRONTLIGHT_BRIGHTNESS;
+    s.overlayPosition = OVERLAY_POS_TOP_RIGHT;
+    s.overlaySize = OVERLAY_SIZE_MEDIUM;
+    s.overlayTextColor = OVERLAY_COLOR_BLACK;
+    sealConfigBlob(blob);
+}
+
+size_t getConfigStringLimit(ConfigStringId id) {
+    return (int)id < CONFIG_STRING_COUNT ? STRING_LIMITS[id] : 0;
+}
+
+const char* getConfigString(const ConfigBlob& blob, ConfigStringId id) {
+    if ((int)id >= CONFIG_STRING_COUNT) {
+        return "";
+    }
+    return findString(const_cast<ConfigBlob&>(blob), id);
+}
+
+bool setConfigString(ConfigBlob& blob, ConfigStringId id, const char* value) {
+    if ((int)id >= CONFIG_STRING_COUNT) {
+        return false;
+    }
+    if (value == nullptr) {
+        value = "";
+    }
+    size_t newLength = strlen(value);
+    if (newLength > STRING_LIMITS[id]) {
+        return false;
+    }
+
+    char* string = findString(blob, id);
+    size_t oldLength = strlen(string);
+    char* tail = string + oldLength + 1;
+    size_t tailBytes = ((char*)&blob + blob.size) - tail;
+    memmove(string + newLength + 1, tail, tailBytes);
+    memcpy(string, value, newLength + 1);
+    blob.size = (uint16_t)(blob.size + newLength - oldLength);
+    return true;
+}
+
+uint16_t sealConfigBlob(ConfigBlob& blob) {
+    blob.crc32 = blobChecksum((const uint8_t*)&blob, blob.size);
+    return blob.size;
+}
+
+bool isConfigBlobValid(const uint8_t* data, size_t length) {
+    if (data == nullptr || length < CONFIG_BLOB_MIN_BYTES || length > sizeof(ConfigBlob)) {
+        return false;
+    }
+    // Header fields are read by copy: the bytes may come from an unaligned buffer
+    uint32_t magic;
+    uint16_t size;
+    uint32_t crc32;
+    memcpy(&magic, data + offsetof(ConfigBlob, magic), sizeof(magic));
+    memcpy(&size, data + offsetof(ConfigBlob, size), sizeof(size));
+    memcpy(&crc32, data + offsetof(ConfigBlob, crc32), sizeof(crc32));
+    uint8_t version = data[offsetof(ConfigBlob, version)];
+    if (magic != CONFIG_BLOB_MAGIC || version != CONFIG_VERSION_CURRENT ||
+        size < CONFIG_BLOB_MIN_BYTES || size > length) {
+        return false;
+    }
+    if (crc32 != blobChecksum(data, size)) {
+        return false;
+    }
+
+    // Exactly CONFIG_STRING_COUNT strings, each within its limit, ending at size
+    const char* string = (const char*)data + offsetof(ConfigBlob, strings);
+    const char* end = (const char*)data + size;
+    for (int i = 0; i < CONFIG_STRING_COUNT; i++) {
+        const char* terminator = (const char*)memchr(string, '\0', end - string);
+        if (terminator == nullptr || (size_t)(terminator - string) > STRING_LIMITS[i]) {
+            return false;
+        }
+        string = terminator + 1;
+    }
+    if (string != end) {
+        return false;
+    }
+
+    uint8_t imageCount = data[offsetof(ConfigBlob, settings) + offsetof(ConfigSettings, imageCount)];
+    return imageCount <= MAX_IMAGE_SLOTS;
+}
+
+ConfigLoadResult loadConfigBlob(ConfigKeyStore& store, ConfigBlob& blob, const char** rejectedKey) {
+    size_t length = store.getBytesLength(PREF_CONFIG_BLOB);
+    if (length > 0 && length <= sizeof(ConfigBlob) &&
+        store.getBytes(PREF_CONFIG_BLOB, &blob, sizeof(blob)) == length &&
+        isConfigBlobValid((const uint8_t*)&blob, length)) {
+        return CONFIG_LOAD_BLOB;
+    }
+
+    // Older firmware (or a blob of another layout): convert the keys, if any
+    const char* tooLong = nullptr;
+    if (!migrateLegacyConfig(store, blob, &tooLong)) {
+        initConfigBlob(blob);
+        if (tooLong != nullptr) {
+            rejectLegacyKey(rejectedKey, tooLong);
+            return CONFIG_LOAD_LEGACY_KEPT;
+        }
+        return CONFIG_LOAD_EMPTY;
+    }
+    if (saveConfigBlob(store, blob)) {
+        removeLegacyConfigKeys(store);  // Only once the blob is safely written
+    }
+    return CONFIG_LOAD_MIGRATED;
+}
+
+bool saveConfigBlob(ConfigKeyStore& store, ConfigBlob& blob) {
+    uint16_t size = sealConfigBlob(blob);
+    return store.putBytes(PREF_CONFIG_BLOB, &blob, size) == size;
+}
+
+bool migrateLegacyConfig(ConfigKeyStore& store, ConfigBlob& blob, const char** rejectedKey) {
+    // WiFi credentials alone are a configuration too (boot mode done, images not set yet)
+    if (!store.isKey(PREF_CONFIGURED) && !store.isKey(PREF_WIFI_SSID)) {
+        return false;
+    }
+    initConfigBlob(blob);
+    ConfigSettings& s = blob.settings;
+
+    for (int i = 0; i < CONFIG_STR_IMAGE_URL; i++) {
+        if (!migrateString(store, blob, (ConfigStringId)i, LEGACY_STRING_KEYS[i])) {
+            return rejectLegacyKey(rejectedKey, LEGACY_STRING_KEYS[i]);
+        }
+    }
+
+    setFlag(blob, CONFIG_FLAG_CONFIGURED, store.getBool(PREF_CONFIGURED, false));
+    setFlag(blob, CONFIG_FLAG_MQTT_BATCHED, store.getBool(PREF_MQTT_BATCHED, false));
+    setFlag(blob, CONFIG_FLAG_USE_CRC32, store.getBool(PREF_USE_CRC32, false));
+    s.changeDetection = store.getUChar(PREF_CHANGE_DETECTION, CHANGE_DETECTION_CRC32);
+    if (s.changeDetection > CHANGE_DETECTION_HTTP) {
+        s.changeDetection = CHANGE_DETECTION_CRC32;
+    }
+    s.updateHours[0] = store.getUChar(PREF_UPDATE_HOURS_0, 0xFF);
+    s.updateHours[1] = store.getUChar(PREF_UPDATE_HOURS_1, 0xFF);
+    s.updateHours[2] = store.getUChar(PREF_UPDATE_HOURS_2, 0xFF);
+    s.timezoneOffset = (int8_t)store.getInt(PREF_TIMEZONE_OFFSET, 0);
+    s.screenRotation = store.getUChar(PREF_SCREEN_ROTATION, DEFAULT_SCREEN_ROTATION);
+    setFlag(blob, CONFIG_FLAG_PARTIAL_REFRESH, store.getBool(PREF_PARTIAL_REFRESH, false));
+    s.fullRefreshEvery = store.getUChar(PREF_FULL_REFRESH_EVERY, DEFAULT_FULL_REFRESH_EVERY);
+    setFlag(blob, CONFIG_FLAG_USE_STATIC_IP, store.getBool(PREF_USE_STATIC_IP, false));
+
+    // Carousel (version 2), or the single image of version 1
+    char key[16];
+    if (store.isKey(PREF_IMAGE_COUNT)) {
+        s.imageCount = store.getUChar(PREF_IMAGE_COUNT, 0);
+        if (s.imageCount > MAX_IMAGE_SLOTS) {
+            s.imageCount = MAX_IMAGE_SLOTS;
+        }
+        for (uint8_t i = 0; i < s.imageCount; i++) {
+            formatIndexedKey(key, sizeof(key), PREF_IMAGE_URL_PREFIX, i);
+            if (!migrateString(store, blob, (ConfigStringId)(CONFIG_STR_IMAGE_URL + i), key)) {
+                return rejectLegacyKey(rejectedKey, PREF_IMAGE_URL_PREFIX);
+            }
+            formatIndexedKey(key, sizeof(key), PREF_IMAGE_INTERVAL, i);
+            s.imageIntervals[i] = store.getInt(key, DEFAULT_INTERVAL_MINUTES);
+            formatIndexedKey(key, sizeof(key), PREF_IMAGE_STAY, i);
+            if (store.getBool(key, false)) {
+                s.imageStayMask |= (uint16_t)(1u << i);
+            }
+        }
+    } else if (store.isKey(PREF_IMAGE_URL)) {
+        s.imageCount = 1;
+        if (!migrateString(store, blob, CONFIG_STR_IMAGE_URL, PREF_IMAGE_URL)) {
+            return rejectLegacyKey(rejectedKey, PREF_IMAGE_URL);
+        }
+        s.imageIntervals[0] = store.getInt(PREF_REFRESH_RATE, DEFAULT_INTERVAL_MINUTES);
+    }
+    s.prefetchCount = store.getUChar(PREF_PREFETCH_COUNT, DEFAULT_PREFETCH_COUNT);
+
+    s.frontlightDuration = store.getUChar(PREF_FRONTLIGHT_DURATION, 0);
+    s.frontlightBrightness = store.getUChar(PREF_FRONTLIGHT_BRIGHTNESS, DEFAULT_FRONTLIGHT_BRIGHTNESS);
+
+    setFlag(blob, CONFIG_FLAG_OVERLAY_ENABLED, store.getBool(PREF_OVERLAY_ENABLED, false));
+    s.overlayPosition = store.getUChar(PREF_OVERLAY_POSITION, OVERLAY_POS_TOP_RIGHT);
+    setFlag(blob, CONFIG_FLAG_OVERLAY_BATTERY_ICON, store.getBool(PREF_OVERLAY_SHOW_BATTERY_ICON, true));
+    setFlag(blob, CONFIG_FLAG_OVERLAY_BATTERY_PCT, store.getBool(PREF_OVERLAY_SHOW_BATTERY_PCT, true));
+    setFlag(blob, CONFIG_FLAG_OVERLAY_UPDATE_TIME, store.getBool(PREF_OVERLAY_SHOW_UPDATE_TIME, true));
+    setFlag(blob, CONFIG_FLAG_OVERLAY_CYCLE_TIME, store.getBool(PREF_OVERLAY_SHOW_CYCLE_TIME, false));
+    s.overlaySize = store.getUChar(PREF_OVERLAY_SIZE, OVERLAY_SIZE_MEDIUM);
+    s.overlayTextColor = store.getUChar(PREF_OVERLAY_TEXT_COLOR, OVERLAY_COLOR_BLACK);
+
+    sealConfigBlob(blob);
+    return true;
+}
+
+void removeLegacyConfigKeys(ConfigKeyStore& store) {
+    for (size_t i = 0; i < sizeof(LEGACY_KEYS) / sizeof(LEGACY_KEYS[0]); i++) {
+        store.remove(LEGACY_KEYS[i]);
+    }
+    for (int i = 0; i < CONFIG_STR_IMAGE_URL; i++) {
+        store.remove(LEGACY_STRING_KEYS[i]);
+    }
+    char key[16];
+    for (int i = 0; i < MAX_IMAGE_SLOTS; i++) {
+        formatIndexedKey(key, sizeof(key), PREF_IMAGE_URL_PREFIX, i);
+        store.remove(key);
+        formatIndexedKey(key, sizeof(key), PREF_IMAGE_INTERVAL, i);
+        store.remove(key);
+        formatIndexedKey(key, sizeof(key), PREF_IMAGE_STAY, i);
+        store.remove(key);
+    }
+}
+
+bool restoreConfigCache(const ConfigCache& cache, ConfigBlob& blob) {
+    if (!isConfigBlobValid(cache.data, sizeof(cache.data))) {
+        return false;
+    }
+    uint16_t size;
+    memcpy(&size, cache.data + offsetof(ConfigBlob, size), sizeof(size));
+    memcpy(&blob, cache.data, size);
+    return true;
+}
+
+void updateConfigCache(ConfigCache& cache, const ConfigBlob& blob) {
+    memset(&cache, 0, sizeof(cache));
+    if (blob.size <= sizeof(cache.data)) {
+        memcpy(cache.data, &blob, blob.size);
+    }
+}
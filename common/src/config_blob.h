@@ -0,0 +1,308 @@
+#ifndef CONFIG_BLOB_H
+#define CONFIG_BLOB_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Configuration keys for Preferences storage
+#define PREF_NAMESPACE "dashboard"
+#define PREF_CONFIG_BLOB "config"  // ConfigBlob - every setting below in one entry
+#define PREF_MQTT_DISCOVERY_HASH "mqtt_disc"  // Hash of the last discovery set published (discovery_hash.h)
+#define PREF_API_TOKEN "api_token"  // Token PUT /api/config needs in config mode (config_json.h), not in the blob
+#define PREF_LAST_CRC32 "last_crc32"  // Legacy - replaced by PREF_IMAGE_SLOTS, removed on first save
+#define PREF_IMAGE_SLOTS "img_slots"  // ImageSlotTable blob (per-slot CRC32 + displayed slot)
+#define PREF_IMAGE_ETAG "img_etag_"  // Followed by index 0-9
+#define PREF_IMAGE_LAST_MODIFIED "img_lmod_"  // Followed by index 0-9
+
+// WiFi channel locking keys (for fast reconnection)
+#define PREF_WIFI_CHANNEL "wifi_ch"
+#define PREF_WIFI_BSSID "wifi_bssid"
+
+// Key-per-field layout of configuration versions 1-2 (read once by migrateLegacyConfig(), then removed)
+#define PREF_CONFIGURED "configured"
+#define PREF_WIFI_SSID "wifi_ssid"
+#define PREF_WIFI_PASS "wifi_pass"
+#define PREF_IMAGE_URL "image_url"  // Version 1 - single image
+#define PREF_REFRESH_RATE "refresh_rate"  // Version 1 - single image interval in minutes
+#define PREF_MQTT_BROKER "mqtt_broker"
+#define PREF_MQTT_USER "mqtt_user"
+#define PREF_MQTT_PASS "mqtt_pass"
+#define PREF_MQTT_BATCHED "mqtt_batch"
+#define PREF_USE_CRC32 "use_crc32"
+#define PREF_CHANGE_DETECTION "chg_detect"
+#define PREF_TLS_FINGERPRINT "tls_fp"
+#define PREF_UPDATE_HOURS_0 "upd_hours_0"
+#define PREF_UPDATE_HOURS_1 "upd_hours_1"
+#define PREF_UPDATE_HOURS_2 "upd_hours_2"
+#define PREF_TIMEZONE_OFFSET "tz_offset"
+#define PREF_SCREEN_ROTATION "screen_rot"
+#define PREF_PARTIAL_REFRESH "partial_ref"
+#define PREF_FULL_REFRESH_EVERY "full_ref_every"
+#define PREF_USE_STATIC_IP "use_static_ip"
+#define PREF_STATIC_IP "static_ip"
+#define PREF_GATEWAY "gateway"
+#define PREF_SUBNET "subnet"
+#define PREF_PRIMARY_DNS "dns1"
+#define PREF_SECONDARY_DNS "dns2"
+#define PREF_FRIENDLY_NAME "friendly_name"
+#define PREF_FRONTLIGHT_DURATION "fl_duration"
+#define PREF_FRONTLIGHT_BRIGHTNESS "fl_bright"
+#define PREF_OVERLAY_ENABLED "ovl_enabled"
+#define PREF_OVERLAY_POSITION "ovl_pos"
+#define PREF_OVERLAY_SHOW_BATTERY_ICON "ovl_bat_icon"
+#define PREF_OVERLAY_SHOW_BATTERY_PCT "ovl_bat_pct"
+#define PREF_OVERLAY_SHOW_UPDATE_TIME "ovl_upd_time"
+#define PREF_OVERLAY_SHOW_CYCLE_TIME "ovl_cyc_time"
+#define PREF_OVERLAY_SIZE "ovl_size"
+#define PREF_OVERLAY_TEXT_COLOR "ovl_txt_col"
+#define PREF_CONFIG_VERSION "cfg_ver"
+#define PREF_IMAGE_COUNT "img_count"
+#define PREF_IMAGE_URL_PREFIX "img_url_"  // Followed by index 0-9
+#define PREF_IMAGE_INTERVAL "img_int_"  // Followed by index 0-9
+#define PREF_IMAGE_STAY "img_stay_"  // Followed by index 0-9
+#define PREF_PREFETCH_COUNT "prefetch_cnt"
+
+// Layout version - continues the key-per-field versions (PREF_CONFIG_VERSION 1-2)
+#define CONFIG_VERSION_CURRENT 3
+#define CONFIG_BLOB_MAGIC 0x47464349  // "ICFG"
+#define CONFIG_CACHE_BYTES 1024  // RTC copy - larger configurations are read from NVS on every wake
+
+// Carousel constraints
+#define MAX_IMAGE_SLOTS 10
+#define MAX_URL_LENGTH 250
+#define MIN_INTERVAL_MINUTES 0  // 0 = button-only mode (no automatic refresh)
+#define DEFAULT_INTERVAL_MINUTES 5
+#define DEFAULT_PREFETCH_COUNT 0  // Carousel slots fetched ahead into flash (0 = every wake goes online)
+
+// Longest value of each string setting (without terminator)
+#define MAX_SSID_LENGTH 32                // 802.11 maximum
+#define MAX_WIFI_PASSWORD_LENGTH 64       // WPA passphrase or 64 hex digit key
+#define MAX_FRIENDLY_NAME_LENGTH 24       // sanitizeFriendlyName()
+#define MAX_MQTT_BROKER_LENGTH 128
+#define MAX_MQTT_USERNAME_LENGTH 64
+#define MAX_MQTT_PASSWORD_LENGTH 128
+#define MAX_TLS_FINGERPRINT_LENGTH 95     // 32 bytes as "AB:CD:..."
+#define MAX_IPV4_LENGTH 15                // "255.255.255.255"
+
+// Default values
+#define DEFAULT_SCREEN_ROTATION 0  // 0 degrees (landscape)
+#define DEFAULT_FULL_REFRESH_EVERY 10  // Partial refreshes between full (ghost-clearing) refreshes
+#define DEFAULT_FRONTLIGHT_BRIGHTNESS 63  // Max brightness
+
+// Change detection method (used when useCRC32Check is enabled)
+#define CHANGE_DETECTION_CRC32 0  // Fetch <url>.crc32 sidecar file before downloading
+#define CHANGE_DETECTION_HTTP 1   // Conditional GET with ETag / Last-Modified validators
+
+// Overlay position enum (matches config)
+#define OVERLAY_POS_TOP_LEFT 0
+#define OVERLAY_POS_TOP_RIGHT 1
+#define OVERLAY_POS_BOTTOM_LEFT 2
+#define OVERLAY_POS_BOTTOM_RIGHT 3
+
+// Overlay size enum (matches config)
+#define OVERLAY_SIZE_SMALL 0
+#define OVERLAY_SIZE_MEDIUM 1
+#define OVERLAY_SIZE_LARGE 2
+
+// Overlay text color enum (matches config)
+#define OVERLAY_COLOR_BLACK 0
+#define OVERLAY_COLOR_DARK_GRAY 1
+#define OVERLAY_COLOR_LIGHT_GRAY 2
+#define OVERLAY_COLOR_WHITE 3
+
+// ConfigSettings::flags
+#define CONFIG_FLAG_CONFIGURED 0x0001
+#define CONFIG_FLAG_MQTT_BATCHED 0x0002
+#define CONFIG_FLAG_USE_CRC32 0x0004
+#define CONFIG_FLAG_PARTIAL_REFRESH 0x0008
+#define CONFIG_FLAG_USE_STATIC_IP 0x0010
+#define CONFIG_FLAG_OVERLAY_ENABLED 0x0020
+#define CONFIG_FLAG_OVERLAY_BATTERY_ICON 0x0040
+#define CONFIG_FLAG_OVERLAY_BATTERY_PCT 0x0080
+#define CONFIG_FLAG_OVERLAY_UPDATE_TIME 0x0100
+#define CONFIG_FLAG_OVERLAY_CYCLE_TIME 0x0200
+
+#define CONFIG_STRING_POOL_BYTES 3200  // Longest value of every string plus terminators (see getConfigStringLimit)
+
+/**
+ * @brief Stored configuration: one CRC-protected binary entry instead of a key per field
+ *
+ * Pure C++ with NO dependencies on Arduino/ESP32 APIs, making it fully
+ * testable with standard C++ unit testing frameworks.
+ *
+ * The whole configuration is read with a single NVS lookup (no key strings
+ * built, no String per field) and mirrored into RTC memory, so timer wakes
+ * do not open NVS for it at all. Strings are packed back to back in a pool
+ * and only the used part is stored: a typical configuration takes a few
+ * hundred bytes, which keeps the RTC copy small.
+ *
+ * Devices with the key-per-field layout of earlier firmware are migrated
+ * on the first load; the old keys are removed afterwards. Per-wake state
+ * (image slot table, validators, channel lock) keeps its own keys, so the
+ * blob is only written when a setting changes.
+ */
+
+enum ConfigStringId {
+    CONFIG_STR_WIFI_SSID,
+    CONFIG_STR_WIFI_PASSWORD,
+    CONFIG_STR_FRIENDLY_NAME,
+    CONFIG_STR_MQTT_BROKER,
+    CONFIG_STR_MQTT_USERNAME,
+    CONFIG_STR_MQTT_PASSWORD,
+    CONFIG_STR_TLS_FINGERPRINT,
+    CONFIG_STR_STATIC_IP,
+    CONFIG_STR_GATEWAY,
+    CONFIG_STR_SUBNET,
+    CONFIG_STR_PRIMARY_DNS,
+    CONFIG_STR_SECONDARY_DNS,
+    CONFIG_STR_IMAGE_URL,  // First of MAX_IMAGE_SLOTS, use CONFIG_STR_IMAGE_URL + slot
+    CONFIG_STRING_COUNT = CONFIG_STR_IMAGE_URL + MAX_IMAGE_SLOTS
+};
+
+/**
+ * @brief Fixed-size settings (everything but the strings)
+ */
+struct ConfigSettings {
+    uint16_t flags;                             // CONFIG_FLAG_* bits
+    uint8_t changeDetection;                    // CHANGE_DETECTION_CRC32 or CHANGE_DETECTION_HTTP
+    uint8_t updateHours[3];                     // 24-bit bitmask: bit i = hour i enabled (0-23)
+    int8_t timezoneOffset;                      // Hours (-12 to +14)
+    uint8_t screenRotation;                     // 0-3 (0°, 90°, 180°, 270°)
+    uint8_t fullRefreshEvery;                   // Full refresh after this many partial refreshes
+    uint8_t imageCount;                         // 0-MAX_IMAGE_SLOTS
+    uint8_t prefetchCount;                      // Next slots downloaded ahead (0 = off)
+    uint8_t frontlightDuration;                 // Seconds (0 = disabled)
+    uint8_t frontlightBrightness;               // 0-63
+    uint8_t overlayPosition;                    // OVERLAY_POS_*
+    uint8_t overlaySize;                        // OVERLAY_SIZE_*
+    uint8_t overlayTextColor;                   // OVERLAY_COLOR_*
+    uint16_t imageStayMask;                     // Bit i = stay on image i
+    uint16_t reserved;
+    int32_t imageIntervals[MAX_IMAGE_SLOTS];    // Minutes per image
+};
+
+struct ConfigBlob {
+    uint32_t magic;                             // CONFIG_BLOB_MAGIC
+    uint8_t version;                            // CONFIG_VERSION_CURRENT (0 after a cold boot = invalid)
+    uint8_t reserved;
+    uint16_t size;                              // Bytes in use: up to and including the last string terminator
+    uint32_t crc32;                             // CRC32 of the bytes after this field up to size (set when sealed)
+    ConfigSettings settings;
+    char strings[CONFIG_STRING_POOL_BYTES];     // CONFIG_STRING_COUNT NUL-terminated strings in ConfigStringId order
+};
+
+/**
+ * @brief RTC memory copy of the stored blob (only its used bytes)
+ */
+struct ConfigCache {
+    uint8_t data[CONFIG_CACHE_BYTES];
+};
+
+/**
+ * @brief Preferences operations the blob needs (Preferences on the device, a map in tests)
+ */
+class ConfigKeyStore {
+public:
+    virtual ~ConfigKeyStore() {}
+
+    virtual bool isKey(const char* key) = 0;
+    virtual bool getBool(const char* key, bool defaultValue) = 0;
+    virtual uint8_t getUChar(const char* key, uint8_t defaultValue) = 0;
+    virtual int32_t getInt(const char* key, int32_t defaultValue) = 0;
+
+    // Copy a string including its terminator - false if missing or longer than size - 1
+    virtual bool getString(const char* key, char* value, size_t size) = 0;
+
+    virtual size_t getBytesLength(const char* key) = 0;
+    virtual size_t getBytes(const char* key, void* buffer, size_t size) = 0;
+    virtual size_t putBytes(const char* key, const void* data, size_t size) = 0;
+    virtual bool remove(const char* key) = 0;
+};
+
+enum ConfigLoadResult {
+    CONFIG_LOAD_EMPTY,          // Nothing stored (or unreadable) - defaults, not configured
+    CONFIG_LOAD_BLOB,           // Read from PREF_CONFIG_BLOB
+    CONFIG_LOAD_MIGRATED,       // Converted from the key-per-field layout and saved as a blob
+    CONFIG_LOAD_LEGACY_KEPT     // Key-per-field layout not converted (a string over its limit) - defaults, keys kept
+};
+
+/**
+ * @brief Reset to defaults with all strings empty (not configured)
+ */
+void initConfigBlob(ConfigBlob& blob);
+
+/**
+ * @brief Longest value a string may have (without terminator)
+ */
+size_t getConfigStringLimit(ConfigStringId id);
+
+/**
+ * @brief A string of a valid blob (never nullptr)
+ */
+const char* getConfigString(const ConfigBlob& blob, ConfigStringId id);
+
+/**
+ * @brief Replace a string (the following strings move up or down in the pool)
+ * @return false if the value is longer than getConfigStringLimit() (blob unchanged)
+ */
+bool setConfigString(ConfigBlob& blob, ConfigStringId id, const char* value);
+
+/**
+ * @brief Set the checksum after changes
+ * @return Bytes to store (ConfigBlob::size)
+ */
+uint16_t sealConfigBlob(ConfigBlob& blob);
+
+/**
+ * @brief Check stored bytes: layout version, size, checksum and string pool
+ */
+bool isConfigBlobValid(const uint8_t* data, size_t length);
+
+/**
+ * @brief Load the configuration
+ *
+ * Reads PREF_CONFIG_BLOB. Without a valid blob, the key-per-field layout of
+ * earlier firmware is migrated when present: the blob is saved and the old
+ * keys removed (per-wake state keys are kept). A string the blob cannot hold
+ * stops the migration and leaves every old key in place.
+ *
+ * @param rejectedKey Set to the key of that string for CONFIG_LOAD_LEGACY_KEPT (optional)
+ * @return Where the configuration came from (blob initialized for CONFIG_LOAD_EMPTY
+ *         and CONFIG_LOAD_LEGACY_KEPT)
+ */
+ConfigLoadResult loadConfigBlob(ConfigKeyStore& store, ConfigBlob& blob, const char** rejectedKey = nullptr);
+
+/**
+ * @brief Seal and save the blob
+ */
+bool saveConfigBlob(ConfigKeyStore& store, ConfigBlob& blob);
+
+/**
+ * @brief Read the key-per-field layout (versions 1-2) into a blob
+ *
+ * Uses the defaults the old loader used for missing keys. The old portal
+ * accepted strings of any length: one longer than its limit fails the
+ * migration rather than being lost.
+ *
+ * @param rejectedKey Set to the key of a string over its limit (image URLs report PREF_IMAGE_URL_PREFIX)
+ * @return false if no configuration is stored in that layout, or a string does not fit
+ */
+bool migrateLegacyConfig(ConfigKeyStore& store, ConfigBlob& blob, const char** rejectedKey = nullptr);
+
+/**
+ * @brief Remove the keys of the key-per-field layout
+ */
+void removeLegacyConfigKeys(ConfigKeyStore& store);
+
+/**
+ * @brief Restore the blob from its RTC copy
+ * @return false if the copy is missing (cold boot), invalid or the blob did not fit
+ */
+bool restoreConfigCache(const ConfigCache& cache, ConfigBlob& blob);
+
+/**
+ * @brief Copy a sealed blob to RTC memory (invalidated if it does not fit)
+ */
+void updateConfigCache(ConfigCache& cache, const ConfigBlob& blob);
+
+#endif // CONFIG_BLOB_H
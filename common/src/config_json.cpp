@@ -0,0 +1,602 @@
+#include <config_json.h>
+#include <config_logic.h>
+#include <tls_session_cache.h>
+#include <prefetch_cache.h>
+#include <ArduinoJson.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define JSON_POOL_ALIGNMENT 8
+
+static const char* const CHANGE_DETECTION_NAMES[] = { "crc32", "http" };  // Indexed by CHANGE_DETECTION_*
+
+// ============================================================================
+// Document Memory
+// ============================================================================
+
+/**
+ * One CONFIG_JSON_POOL_SIZE block per call, handed out front to back and
+ * freed as a whole: the document cannot grow past it or leave the heap
+ * fragmented. Only the newest block is resized or given back in place,
+ * which covers the strings ArduinoJson builds while parsing.
+ */
+class JsonPool : public ArduinoJson::Allocator {
+public:
+    JsonPool() : _memory((uint8_t*)malloc(CONFIG_JSON_POOL_SIZE)), _used(0), _last(nullptr) {}
+    ~JsonPool() { free(_memory); }
+
+    void* allocate(size_t size) override {
+        size_t needed = JSON_POOL_ALIGNMENT + align(size);
+        if (_memory == nullptr || needed > CONFIG_JSON_POOL_SIZE - _used) {
+            return nullptr;
+        }
+        uint8_t* block = _memory + _used + JSON_POOL_ALIGNMENT;
+        setSize(block, size);
+        _used += needed;
+        _last = block;
+        return block;
+    }
+
+    void deallocate(void* pointer) override {
+        if (pointer != nullptr && pointer == _last) {
+            _used = (uint8_t*)pointer - JSON_POOL_ALIGNMENT - _memory;
+            _last = nullptr;
+        }
+    }
+
+    void* reallocate(void* pointer, size_t size) override {
+        if (pointer == nullptr) {
+            return allocate(size);
+        }
+        uint8_t* block = (uint8_t*)pointer;
+        size_t oldSize = getSize(block);
+        if (block == _last) {
+            size_t start = block - _memory;
+            if (align(size) > CONFIG_JSON_POOL_SIZE - start) {
+                return nullptr;
+            }
+            setSize(block, size);
+            _used = start + align(size);
+            return block;
+        }
+        if (size <= oldSize) {
+            return block;  // Shrinking an older block keeps its space
+        }
+        void* moved = allocate(size);
+        if (moved != nullptr) {
+            memcpy(moved, block, oldSize);
+        }
+        return moved;
+    }
+
+private:
+    uint8_t* _memory;
+    size_t _used;
+    uint8_t* _last;
+
+    static size_t align(size_t size) {
+        return (size + JSON_POOL_ALIGNMENT - 1) & ~(size_t)(JSON_POOL_ALIGNMENT - 1);
+    }
+
+    // Each block is preceded by its size
+    static size_t getSize(const uint8_t* block) {
+        size_t size;
+        memcpy(&size, block - JSON_POOL_ALIGNMENT, sizeof(size));
+        return size;
+    }
+
+    static void setSize(uint8_t* block, size_t size) {
+        memcpy(block - JSON_POOL_ALIGNMENT, &size, sizeof(size));
+    }
+};
+
+// ============================================================================
+// Writing
+// ============================================================================
+
+// serializeJson() output straight into the page buffer
+struct TemplateWriterOutput {
+    TemplateWriter& out;
+
+    size_t write(uint8_t c) {
+        out.write((const char*)&c, 1);
+        return 1;
+    }
+
+    size_t write(const uint8_t* data, size_t length) {
+        out.write((const char*)data, length);
+        return length;
+    }
+};
+
+static void writeDocument(TemplateWriter& out, const JsonDocument& doc) {
+    if (doc.overflowed()) {
+        out.write("{\"error\":\"Out of memory\"}");
+        return;
+    }
+    TemplateWriterOutput output = { out };
+    serializeJson(doc, output);
+}
+
+static const char* orEmpty(const char* text) {
+    return text != nullptr ? text : "";
+}
+
+// Rounded as a double: a float would print its binary error (0.123400003)
+static double rounded(float value, double scale) {
+    return floor((double)value * scale + 0.5) / scale;
+}
+
+void writeConfigJson(TemplateWriter& out, const DashboardConfig& config) {
+    JsonPool pool;
+    JsonDocument doc(&pool);
+
+    doc["ssid"] = config.wifiSSID.c_str();
+    doc["wifi_password_set"] = !config.wifiPassword.isEmpty();
+    doc["friendly_name"] = config.friendlyName.c_str();
+
+    doc["use_static_ip"] = config.useStaticIP;
+    doc["static_ip"] = config.staticIP.c_str();
+    doc["gateway"] = config.gateway.c_str();
+    doc["subnet"] = config.subnet.c_str();
+    doc["primary_dns"] = config.primaryDNS.c_str();
+    doc["secondary_dns"] = config.secondaryDNS.c_str();
+
+    JsonArray images = doc["images"].to<JsonArray>();
+    for (uint8_t i = 0; i < config.imageCount && i < MAX_IMAGE_SLOTS; i++) {
+        JsonObject image = images.add<JsonObject>();
+        image["url"] = config.imageUrls[i].c_str();
+        image["interval"] = config.imageIntervals[i];
+        image["stay"] = config.imageStay[i];
+    }
+    doc["prefetch_count"] = (int)config.prefetchCount;
+
+    JsonArray hours = doc["update_hours"].to<JsonArray>();
+    for (int hour = 0; hour < 24; hour++) {
+        if (isHourEnabledInBitmask(hour, config.updateHours)) {
+            hours.add(hour);
+        }
+    }
+    doc["timezone_offset"] = config.timezoneOffset;
+    doc["change_detection_enabled"] = config.useCRC32Check;
+    doc["change_detection"] = CHANGE_DETECTION_NAMES[config.changeDetection == CHANGE_DETECTION_HTTP ? 1 : 0];
+    doc["tls_fingerprint"] = config.tlsFingerprint.c_str();
+
+    doc["screen_rotation"] = (int)config.screenRotation;
+    doc["partial_refresh"] = config.partialRefresh;
+    doc["full_refresh_every"] = (int)config.fullRefreshEvery;
+    doc["frontlight_duration"] = (int)config.frontlightDuration;
+    doc["frontlight_brightness"] = (int)config.frontlightBrightness;
+
+    doc["overlay_enabled"] = config.overlayEnabled;
+    doc["overlay_position"] = (int)config.overlayPosition;
+    doc["overlay_size"] = (int)config.overlaySize;
+    doc["overlay_color"] = (int)config.overlayTextColor;
+    doc["overlay_battery_icon"] = config.overlayShowBatteryIcon;
+    doc["overlay_battery_percentage"] = config.overlayShowBatteryPercentage;
+    doc["overlay_update_time"] = config.overlayShowUpdateTime;
+    doc["overlay_cycle_time"] = config.overlayShowCycleTime;
+
+    doc["mqtt_broker"] = config.mqttBroker.c_str();
+    doc["mqtt_username"] = config.mqttUsername.c_str();
+    doc["mqtt_password_set"] = !config.mqttPassword.isEmpty();
+    doc["mqtt_batched"] = config.mqttBatchedState;
+
+    writeDocument(out, doc);
+}
+
+void writeStatusJson(TemplateWriter& out, const DeviceStatus& status) {
+    JsonPool pool;
+    JsonDocument doc(&pool);
+
+    doc["firmware_version"] = orEmpty(status.firmwareVersion);
+    doc["board"] = orEmpty(status.board);
+    doc["mode"] = orEmpty(status.mode);
+    doc["configured"] = status.configured;
+    doc["api_token_set"] = status.apiTokenSet;
+    doc["device_id"] = orEmpty(status.deviceId);
+    doc["ip"] = orEmpty(status.ipAddress);
+    doc["hostname"] = orEmpty(status.hostname);
+    doc["connected"] = status.connected;
+    if (status.connected) {
+        doc["rssi"] = status.rssi;
+    }
+    doc["uptime_seconds"] = status.uptimeSeconds;
+    doc["free_heap"] = status.freeHeap;
+    if (status.energyStats != nullptr && status.energyStats->cycles > 0) {
+        JsonObject energy = doc["energy"].to<JsonObject>();
+        energy["cycle_mah"] = rounded(status.energyStats->avgCycleMah, 10000);
+        energy["awake_seconds"] = rounded(status.energyStats->avgAwakeSeconds, 100);
+        energy["cycles"] = status.energyStats->cycles;
+    }
+
+    writeDocument(out, doc);
+}
+
+void writeJsonError(TemplateWriter& out, const char* message) {
+    JsonPool pool;
+    JsonDocument doc(&pool);
+    doc["error"] = orEmpty(message);
+    writeDocument(out, doc);
+}
+
+// ============================================================================
+// Reading
+// ============================================================================
+
+struct JsonErrors {
+    char* error;
+    size_t errorSize;
+};
+
+static bool fail(JsonErrors& in, const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+static bool fail(JsonErrors& in, const char* format, ...) {
+    if (in.error != nullptr && in.errorSize > 0) {
+        va_list args;
+        va_start(args, format);
+        vsnprintf(in.error, in.errorSize, format, args);
+        va_end(args);
+    }
+    return false;
+}
+
+// Counts what deserializeJson() consumed, so content after the document can be rejected
+struct CountingReader {
+    const char* data;
+    size_t length;
+    size_t position;
+
+    int read() {
+        return position < length ? (unsigned char)data[position++] : -1;
+    }
+
+    size_t readBytes(char* buffer, size_t size) {
+        size_t count = length - position < size ? length - position : size;
+        memcpy(buffer, data + position, count);
+        position += count;
+        return count;
+    }
+};
+
+static bool readBool(JsonErrors& in, JsonVariantConst value, const char* key, bool& field) {
+    if (!value.is<bool>()) {
+        return fail(in, "%s: expected true or false", key);
+    }
+    field = value.as<bool>();
+    return true;
+}
+
+static bool readInteger(JsonErrors& in, JsonVariantConst value, const char* key, long min, long max, long& result) {
+    if (!value.is<long>()) {
+        // Whole numbers too large for a long arrive as floating point
+        double number = value.as<double>();
+        if (value.is<double>() && number == floor(number) && (number < min || number > max)) {
+            return fail(in, "%s: out of range (%ld to %ld)", key, min, max);
+        }
+        return fail(in, "%s: expected a whole number", key);
+    }
+    result = value.as<long>();
+    if (result < min || result > max) {
+        return fail(in, "%s: out of range (%ld to %ld)", key, min, max);
+    }
+    return true;
+}
+
+template <typename Field>
+static bool readSmallInteger(JsonErrors& in, JsonVariantConst value, const char* key, long min, long max, Field& field) {
+    long number;
+    if (!readInteger(in, value, key, min, max, number)) {
+        return false;
+    }
+    field = (Field)number;
+    return true;
+}
+
+template <size_t Capacity>
+static bool readStringField(JsonErrors& in, JsonVariantConst value, const char* key, FixedString<Capacity>& field) {
+    if (!value.is<const char*>()) {
+        return fail(in, "%s: expected a string", key);
+    }
+    JsonString text = value.as<JsonString>();
+    if (text.size() > Capacity) {
+        return fail(in, "%s: too long (max %u characters)", key, (unsigned)Capacity);
+    }
+    if (strlen(text.c_str()) != text.size()) {
+        return fail(in, "%s: must not contain \\u0000", key);  // Would end the stored string early
+    }
+    field.assign(text.c_str(), text.size());
+    return true;
+}
+
+static bool readImage(JsonErrors& in, JsonVariantConst value, uint8_t slot, DashboardConfig& config) {
+    if (!value.is<JsonObjectConst>()) {
+        return fail(in, "images: expected an object");
+    }
+    config.imageUrls[slot].assign("");
+    config.imageIntervals[slot] = DEFAULT_INTERVAL_MINUTES;
+    config.imageStay[slot] = false;
+
+    bool hasUrl = false;
+    for (JsonPairConst member : value.as<JsonObjectConst>()) {
+        const char* key = member.key().c_str();
+        bool read;
+        if (strcmp(key, "url") == 0) {
+            hasUrl = true;
+            read = readStringField(in, member.value(), "images.url", config.imageUrls[slot]);
+        } else if (strcmp(key, "interval") == 0) {
+            read = readSmallInteger(in, member.value(), "images.interval", MIN_INTERVAL_MINUTES, 1440L * 365,
+                                    config.imageIntervals[slot]);
+        } else if (strcmp(key, "stay") == 0) {
+            read = readBool(in, member.value(), "images.stay", config.imageStay[slot]);
+        } else {
+            return fail(in, "images: unknown key \"%s\"", key);
+        }
+        if (!read) {
+            return false;
+        }
+    }
+    if (!hasUrl) {
+        return fail(in, "images: image %u has no url", (unsigned)slot + 1);
+    }
+    return true;
+}
+
+static bool readImages(JsonErrors& in, JsonVariantConst value, DashboardConfig& config) {
+    if (!value.is<JsonArrayConst>()) {
+        return fail(in, "images: expected an array");
+    }
+    config.imageCount = 0;
+    for (JsonVariantConst image : value.as<JsonArrayConst>()) {
+        if (config.imageCount >= MAX_IMAGE_SLOTS) {
+            return fail(in, "images: at most %d images", MAX_IMAGE_SLOTS);
+        }
+        if (!readImage(in, image, config.imageCount, config)) {
+            return false;
+        }
+        config.imageCount++;
+    }
+    return true;
+}
+
+static bool readUpdateHours(JsonErrors& in, JsonVariantConst value, uint8_t* updateHours) {
+    if (!value.is<JsonArrayConst>()) {
+        return fail(in, "update_hours: expected an array");
+    }
+    uint8_t bitmask[3] = { 0, 0, 0 };
+    for (JsonVariantConst element : value.as<JsonArrayConst>()) {
+        long hour;
+        if (!readInteger(in, element, "update_hours", 0, 23, hour)) {
+            return false;
+        }
+        bitmask[hour / 8] |= (1 << (hour % 8));
+    }
+    memcpy(updateHours, bitmask, sizeof(bitmask));
+    return true;
+}
+
+static bool readApiToken(JsonErrors& in, JsonVariantConst value, ApiTokenUpdate& apiToken) {
+    if (!readStringField(in, value, "api_token", apiToken.value)) {
+        return false;
+    }
+    if (!apiToken.value.isEmpty() && !isValidApiToken(apiToken.value.c_str())) {
+        return fail(in, "api_token: %d to %d characters, no spaces", API_TOKEN_MIN_LENGTH, API_TOKEN_MAX_LENGTH);
+    }
+    apiToken.present = true;
+    return true;
+}
+
+static bool readConfigMember(JsonErrors& in, const char* key, JsonVariantConst value, DashboardConfig& config,
+                             ApiTokenUpdate* apiToken) {
+    // Strings
+    if (strcmp(key, "ssid") == 0) return readStringField(in, value, key, config.wifiSSID);
+    if (strcmp(key, "wifi_password") == 0) return readStringField(in, value, key, config.wifiPassword);
+    if (strcmp(key, "friendly_name") == 0) return readStringField(in, value, key, config.friendlyName);
+    if (strcmp(key, "static_ip") == 0) return readStringField(in, value, key, config.staticIP);
+    if (strcmp(key, "gateway") == 0) return readStringField(in, value, key, config.gateway);
+    if (strcmp(key, "subnet") == 0) return readStringField(in, value, key, config.subnet);
+    if (strcmp(key, "primary_dns") == 0) return readStringField(in, value, key, config.primaryDNS);
+    if (strcmp(key, "secondary_dns") == 0) return readStringField(in, value, key, config.secondaryDNS);
+    if (strcmp(key, "mqtt_broker") == 0) return readStringField(in, value, key, config.mqttBroker);
+    if (strcmp(key, "mqtt_username") == 0) return readStringField(in, value, key, config.mqttUsername);
+    if (strcmp(key, "mqtt_password") == 0) return readStringField(in, value, key, config.mqttPassword);
+
+    // Flags
+    if (strcmp(key, "use_static_ip") == 0) return readBool(in, value, key, config.useStaticIP);
+    if (strcmp(key, "change_detection_enabled") == 0) return readBool(in, value, key, config.useCRC32Check);
+    if (strcmp(key, "partial_refresh") == 0) return readBool(in, value, key, config.partialRefresh);
+    if (strcmp(key, "overlay_enabled") == 0) return readBool(in, value, key, config.overlayEnabled);
+    if (strcmp(key, "overlay_battery_icon") == 0) return readBool(in, value, key, config.overlayShowBatteryIcon);
+    if (strcmp(key, "overlay_battery_percentage") == 0) return readBool(in, value, key, config.overlayShowBatteryPercentage);
+    if (strcmp(key, "overlay_update_time") == 0) return readBool(in, value, key, config.overlayShowUpdateTime);
+    if (strcmp(key, "overlay_cycle_time") == 0) return readBool(in, value, key, config.overlayShowCycleTime);
+    if (strcmp(key, "mqtt_batched") == 0) return readBool(in, value, key, config.mqttBatchedState);
+
+    // Numbers, same ranges as the configuration form
+    if (strcmp(key, "prefetch_count") == 0) return readSmallInteger(in, value, key, 0, PREFETCH_MAX_ENTRIES, config.prefetchCount);
+    if (strcmp(key, "timezone_offset") == 0) return readSmallInteger(in, value, key, -12, 14, config.timezoneOffset);
+    if (strcmp(key, "screen_rotation") == 0) return readSmallInteger(in, value, key, 0, 3, config.screenRotation);
+    if (strcmp(key, "full_refresh_every") == 0) return readSmallInteger(in, value, key, 0, 100, config.fullRefreshEvery);
+    if (strcmp(key, "frontlight_duration") == 0) return readSmallInteger(in, value, key, 0, 255, config.frontlightDuration);
+    if (strcmp(key, "frontlight_brightness") == 0) return readSmallInteger(in, value, key, 0, 63, config.frontlightBrightness);
+    if (strcmp(key, "overlay_position") == 0) return readSmallInteger(in, value, key, OVERLAY_POS_TOP_LEFT, OVERLAY_POS_BOTTOM_RIGHT, config.overlayPosition);
+    if (strcmp(key, "overlay_size") == 0) return readSmallInteger(in, value, key, OVERLAY_SIZE_SMALL, OVERLAY_SIZE_LARGE, config.overlaySize);
+    if (strcmp(key, "overlay_color") == 0) return readSmallInteger(in, value, key, OVERLAY_COLOR_BLACK, OVERLAY_COLOR_WHITE, config.overlayTextColor);
+
+    if (strcmp(key, "change_detection") == 0) {
+        const char* name = value.is<const char*>() ? value.as<const char*>() : "";
+        if (strcmp(name, CHANGE_DETECTION_NAMES[0]) == 0) {
+            config.changeDetection = CHANGE_DETECTION_CRC32;
+        } else if (strcmp(name, CHANGE_DETECTION_NAMES[1]) == 0) {
+            config.changeDetection = CHANGE_DETECTION_HTTP;
+        } else {
+            return fail(in, "change_detection: expected \"crc32\" or \"http\"");
+        }
+        return true;
+    }
+
+    if (strcmp(key, "tls_fingerprint") == 0) {
+        // Stored normalized ("AB:CD:..."), like the form does
+        FixedString<MAX_TLS_FINGERPRINT_LENGTH> text;
+        if (!readStringField(in, value, key, text)) {
+            return false;
+        }
+        if (text.isEmpty()) {
+            config.tlsFingerprint.assign("");
+            return true;
+        }
+        uint8_t fingerprint[TLS_FINGERPRINT_SIZE];
+        if (!parseCertFingerprint(text.c_str(), fingerprint)) {
+            return fail(in, "tls_fingerprint: expected SHA-256 as 64 hex digits");
+        }
+        char normalized[TLS_FINGERPRINT_TEXT_SIZE];
+        formatCertFingerprint(fingerprint, normalized);
+        config.tlsFingerprint.assign(normalized);
+        return true;
+    }
+
+    if (strcmp(key, "images") == 0) return readImages(in, value, config);
+    if (strcmp(key, "update_hours") == 0) return readUpdateHours(in, value, config.updateHours);
+
+    if (strcmp(key, "api_token") == 0 && apiToken != nullptr) return readApiToken(in, value, *apiToken);
+
+    // Reported by GET, accepted back so documents can be copied between devices
+    if (strcmp(key, "wifi_password_set") == 0 || strcmp(key, "mqtt_password_set") == 0) {
+        bool ignored;
+        return readBool(in, value, key, ignored);
+    }
+
+    return fail(in, "Unknown key \"%s\"", key);
+}
+
+bool parseConfigJson(const char* json, size_t length, DashboardConfig& config, char* error, size_t errorSize,
+                     ApiTokenUpdate* apiToken) {
+    if (error != nullptr && errorSize > 0) {
+        error[0] = '\0';
+    }
+    if (apiToken != nullptr) {
+        apiToken->present = false;
+    }
+    JsonErrors in = { error, errorSize };
+    if (json == nullptr || length == 0) {
+        return fail(in, "Empty request body");
+    }
+
+    JsonPool pool;
+    JsonDocument doc(&pool);
+    CountingReader reader = { json, length, 0 };
+    DeserializationError result = deserializeJson(doc, reader);
+    if (result == DeserializationError::NoMemory) {
+        return fail(in, "Document too large");
+    }
+    if (result) {
+        return fail(in, "Invalid JSON (%s)", result.c_str());
+    }
+    // deserializeJson() stops after the document; only whitespace may follow
+    for (size_t i = reader.position; i < length; i++) {
+        if (json[i] != ' ' && json[i] != '\t' && json[i] != '\n' && json[i] != '\r') {
+            return fail(in, "Invalid JSON at offset %u", (unsigned)i);
+        }
+    }
+    if (!doc.is<JsonObjectConst>()) {
+        return fail(in, "document: expected an object");
+    }
+
+    for (JsonPairConst member : doc.as<JsonObjectConst>()) {
+        if (!readConfigMember(in, member.key().c_str(), member.value(), config, apiToken)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool isValidApiToken(const char* token) {
+    if (token == nullptr) {
+        return false;
+    }
+    size_t length = strlen(token);
+    if (length < API_TOKEN_MIN_LENGTH || length > API_TOKEN_MAX_LENGTH) {
+        return false;
+    }
+    for (const char* p = token; *p != '\0'; p++) {
+        if (*p <= ' ' || *p > '~') {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool isApiRequestAuthorized(const char* authorization, const char* token) {
+    static const char prefix[] = "Bearer ";
+    if (authorization == nullptr || token == nullptr || token[0] == '\0' ||
+        strncmp(authorization, prefix, sizeof(prefix) - 1) != 0) {
+        return false;
+    }
+    const char* given = authorization + sizeof(prefix) - 1;
+    size_t length = strlen(token);
+    if (strlen(given) != length) {
+        return false;
+    }
+    // Every byte is compared, so the time taken does not show how much of a guess matched
+    uint8_t difference = 0;
+    for (size_t i = 0; i < length; i++) {
+        difference |= (uint8_t)(given[i] ^ token[i]);
+    }
+    return difference == 0;
+}
+
+bool validateConfigJson(const DashboardConfig& config, char* error, size_t errorSize) {
+    const char* message = nullptr;
+    char text[CONFIG_JSON_ERROR_SIZE];
+
+    if (config.wifiSSID.isEmpty()) {
+        message = "ssid is required";
+    } else if (config.imageCount == 0) {
+        message = "At least one image is required";
+    }
+
+    for (uint8_t i = 0; message == nullptr && i < config.imageCount; i++) {
+        if (!isValidImageUrl(config.imageUrls[i].c_str())) {
+            snprintf(text, sizeof(text), "Image %u URL must start with http:// or https://", (unsigned)i + 1);
+            message = text;
+        }
+    }
+
+    if (message == nullptr && !config.friendlyName.isEmpty()) {
+        // sanitizeFriendlyName() keeps letters, digits and inner hyphens
+        bool usable = false;
+        for (const char* p = config.friendlyName.c_str(); *p != '\0'; p++) {
+            if ((*p >= 'a' && *p <= 'z') || (*p >= 'A' && *p <= 'Z') || (*p >= '0' && *p <= '9')) {
+                usable = true;
+            }
+        }
+        if (!usable) {
+            message = "friendly_name must contain at least one letter or digit";
+        }
+    }
+
+    if (message == nullptr && config.useStaticIP) {
+        if (!isValidIPv4Address(config.staticIP.c_str())) {
+            message = "Invalid static_ip";
+        } else if (!isValidIPv4Address(config.gateway.c_str())) {
+            message = "Invalid gateway";
+        } else if (!isValidIPv4Address(config.subnet.c_str())) {
+            message = "Invalid subnet";
+        } else if (!isValidIPv4Address(config.primaryDNS.c_str())) {
+            message = "Invalid primary_dns";
+        } else if (!config.secondaryDNS.isEmpty() && !isValidIPv4Address(config.secondaryDNS.c_str())) {
+            message = "Invalid secondary_dns";
+        }
+    }
+
+    if (message == nullptr) {
+        return true;
+    }
+    if (error != nullptr && errorSize > 0) {
+        snprintf(error, errorSize, "%s", message);
+    }
+    return false;
+}
@@ -0,0 +1,131 @@
+#ifndef CONFIG_JSON_H
+#define CONFIG_JSON_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <dashboard_config.h>
+#include <energy_model.h>
+#include <page_template.h>
+
+#define CONFIG_JSON_MAX_BODY 8192     // Largest PUT /api/config body accepted (every field at its limit fits)
+#define CONFIG_JSON_ERROR_SIZE 96     // Error message buffer for parseConfigJson() / validateConfigJson()
+#define CONFIG_JSON_POOL_SIZE 16384   // Memory of one document while it is parsed or written (twice the largest body)
+#define API_TOKEN_MIN_LENGTH 16
+#define API_TOKEN_MAX_LENGTH 64
+
+/**
+ * @brief Configuration and status as JSON for the config portal API
+ *
+ * Built on ArduinoJson (header-only, as used for the GitHub OTA check) with
+ * NO dependencies on Arduino/ESP32 APIs, so it builds in the host tests.
+ *
+ * GET /api/config returns the whole DashboardConfig as one object; PUT
+ * /api/config takes the same object. Keys are snake_case versions of the
+ * fields; carousel slots are an "images" array of {url, interval, stay}
+ * and the update schedule is "update_hours", the list of enabled hours.
+ * Passwords are write-only ("wifi_password", "mqtt_password"): GET
+ * reports "wifi_password_set" / "mqtt_password_set" instead, and PUT
+ * accepts those keys back unchanged so a document read from one device
+ * can be sent to another.
+ *
+ * "api_token" is write-only as well and kept apart from DashboardConfig:
+ * once set, PUT over the network needs "Authorization: Bearer <token>".
+ *
+ * Each call keeps its JsonDocument in one CONFIG_JSON_POOL_SIZE block,
+ * allocated once and freed on return: a document never grows past it, and
+ * the output is streamed through a TemplateWriter rather than built in a
+ * String.
+ */
+
+/**
+ * @brief What GET /api/status reports
+ */
+struct DeviceStatus {
+    const char* firmwareVersion;
+    const char* board;               // BOARD_NAME
+    const char* mode;                // "boot" (WiFi setup) or "config"
+    bool configured;                 // Complete configuration stored
+    bool apiTokenSet;                // PUT /api/config possible in config mode
+    const char* deviceId;            // Friendly name or "inkplate-XXXXXX"
+    const char* ipAddress;           // Station IP when connected, else the access point IP
+    const char* hostname;            // mDNS hostname ("" = none)
+    bool connected;                  // Station mode
+    int rssi;                        // dBm (connected only)
+    uint32_t uptimeSeconds;
+    uint32_t freeHeap;               // Bytes
+    const EnergyStats* energyStats;  // Measured wakes (nullptr = none)
+};
+
+/**
+ * @brief "api_token" of a PUT document, stored apart from the configuration
+ */
+struct ApiTokenUpdate {
+    bool present;                                   // Document carried the key
+    FixedString<API_TOKEN_MAX_LENGTH> value;        // "" turns API writes in config mode off
+};
+
+/**
+ * @brief Write the configuration as a JSON object (passwords left out)
+ */
+void writeConfigJson(TemplateWriter& out, const DashboardConfig& config);
+
+/**
+ * @brief Apply a JSON configuration document
+ *
+ * Keys present in the document replace the field; keys left out keep
+ * their current value, so a document may carry only the settings to
+ * change. "images" and "update_hours" replace the whole list. Unknown
+ * keys, wrong types, values out of range and strings longer than can be
+ * stored are rejected. The result still has to pass validateConfigJson().
+ *
+ * @param json Document (need not be terminated)
+ * @param length Bytes of document
+ * @param config Configuration to update; partly updated when false is returned
+ * @param error Message on failure, e.g. "timezone_offset: out of range (-12 to 14)"
+ * @param errorSize Size of error (CONFIG_JSON_ERROR_SIZE)
+ * @param apiToken Receives "api_token" (nullptr = the key is rejected as unknown)
+ * @return true if the document was applied
+ */
+bool parseConfigJson(const char* json, size_t length, DashboardConfig& config, char* error, size_t errorSize,
+                     ApiTokenUpdate* apiToken = nullptr);
+
+/**
+ * @brief Check a complete configuration before it is saved
+ *
+ * Same rules as the configuration form: SSID and at least one image
+ * required, http(s) image URLs, a device name with at least one letter or
+ * digit, and valid IPv4 addresses when a static IP is used.
+ *
+ * @return true if it can be saved, else false with error set
+ */
+bool validateConfigJson(const DashboardConfig& config, char* error, size_t errorSize);
+
+/**
+ * @brief Check a token before it is stored
+ *
+ * @return true for API_TOKEN_MIN_LENGTH to API_TOKEN_MAX_LENGTH printable
+ *         ASCII characters without spaces
+ */
+bool isValidApiToken(const char* token);
+
+/**
+ * @brief Check the Authorization header of a request against the stored token
+ *
+ * Expects "Bearer <token>"; the token is compared in constant time.
+ *
+ * @param authorization Header value ("" or nullptr = none sent)
+ * @param token Stored token ("" = none, never authorized)
+ */
+bool isApiRequestAuthorized(const char* authorization, const char* token);
+
+/**
+ * @brief Write the device status as a JSON object
+ */
+void writeStatusJson(TemplateWriter& out, const DeviceStatus& status);
+
+/**
+ * @brief Write {"error": message}
+ */
+void writeJsonError(TemplateWriter& out, const char* message);
+
+#endif // CONFIG_JSON_H
@@ -1,4 +1,5 @@
 #include <config_logic.h>
+#include <string.h>
 
 int applyTimezoneOffset(int utcHour, int offsetHours) {
     int localHour = utcHour + offsetHours;
@@ -32,3 +33,43 @@ bool isHourEnabledInBitmask(int hour, const uint8_t bitmask[3]) {
 bool areAllHoursEnabled(const uint8_t bitmask[3]) {
     return (bitmask[0] == 0xFF && bitmask[1] == 0xFF && bitmask[2] == 0xFF);
 }
+
+bool isValidIPv4Address(const char* text) {
+    if (text == nullptr) {
+        return false;
+    }
+    
+    int octets = 0;
+    while (true) {
+        // One group: 1 or more digits, value 0-255
+        int value = 0;
+        int digits = 0;
+        while (*text >= '0' && *text <= '9') {
+            value = value * 10 + (*text - '0');
+            if (value > 255) {
+                return false;
+            }
+            digits++;
+            text++;
+        }
+        if (digits == 0) {
+            return false;
+        }
+        octets++;
+        
+        if (*text == '\0') {
+            return octets == 4;
+        }
+        if (*text != '.' || octets == 4) {
+            return false;
+        }
+        text++;
+    }
+}
+
+bool isValidImageUrl(const char* url) {
+    if (url == nullptr) {
+        return false;
+    }
+    return strncmp(url, "http://", 7) == 0 || strncmp(url, "https://", 8) == 0;
+}
@@ -38,4 +38,22 @@ bool isHourEnabledInBitmask(int hour, const uint8_t bitmask[3]);
  */
 bool areAllHoursEnabled(const uint8_t bitmask[3]);
 
+/**
+ * @brief Check a dotted-quad IPv4 address ("192.168.1.10")
+ * 
+ * Four groups of digits separated by dots, each 0-255.
+ * 
+ * @param text Address (nullptr is invalid)
+ * @return true if valid, false otherwise
+ */
+bool isValidIPv4Address(const char* text);
+
+/**
+ * @brief Check that an image URL uses a scheme the firmware can download
+ * 
+ * @param url URL (nullptr is invalid)
+ * @return true if it starts with http:// or https://
+ */
+bool isValidImageUrl(const char* url);
+
 #endif // CONFIG_LOGIC_H
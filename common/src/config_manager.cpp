@@ -1,7 +1,27 @@
 #include "config_manager.h"
 #include "logger.h"
 
-ConfigManager::ConfigManager() : _initialized(false) {
+// Preferences as seen by the config blob functions
+class PreferencesConfigStore : public ConfigKeyStore {
+public:
+    explicit PreferencesConfigStore(Preferences& preferences) : _preferences(preferences) {}
+    
+    bool isKey(const char* key) override { return _preferences.isKey(key); }
+    bool getBool(const char* key, bool defaultValue) override { return _preferences.getBool(key, defaultValue); }
+    uint8_t getUChar(const char* key, uint8_t defaultValue) override { return _preferences.getUChar(key, defaultValue); }
+    int32_t getInt(const char* key, int32_t defaultValue) override { return _preferences.getInt(key, defaultValue); }
+    bool getString(const char* key, char* value, size_t size) override { return _preferences.getString(key, value, size) > 0; }
+    size_t getBytesLength(const char* key) override { return _preferences.getBytesLength(key); }
+    size_t getBytes(const char* key, void* buffer, size_t size) override { return _preferences.getBytes(key, buffer, size); }
+    size_t putBytes(const char* key, const void* data, size_t size) override { return _preferences.putBytes(key, data, size); }
+    bool remove(const char* key) override { return _preferences.remove(key); }
+    
+private:
+    Preferences& _preferences;
+};
+
+ConfigManager::ConfigManager() : _initialized(false), _loaded(false), _cache(nullptr), _configCurrent(false) {
+    initConfigBlob(_blob);
 }
 
 ConfigManager::~ConfigManager() {
@@ -10,7 +30,43 @@ ConfigManager::~ConfigManager() {
     }
 }
 
+void ConfigManager::setConfigCache(ConfigCache* cache) {
+    _cache = cache;
+}
+
 bool ConfigManager::begin() {
+    if (_loaded) {
+        return true;
+    }
+    
+    // Timer wake: the RTC copy is the configuration NVS holds
+    if (_cache != nullptr && restoreConfigCache(*_cache, _blob)) {
+        _loaded = true;
+        return true;
+    }
+    
+    if (!openPreferences()) {
+        return false;
+    }
+    
+    PreferencesConfigStore store(_preferences);
+    const char* rejectedKey = nullptr;
+    ConfigLoadResult result = loadConfigBlob(store, _blob, &rejectedKey);
+    if (result == CONFIG_LOAD_MIGRATED) {
+        Logger::message("Config Migrated", "Settings converted to a single config blob");
+    } else if (result == CONFIG_LOAD_LEGACY_KEPT) {
+        // Old keys stay untouched: earlier firmware can still read them
+        Logger::messagef("Config Error", "Settings not converted: '%s' is too long for this firmware, set up again",
+                         rejectedKey);
+    }
+    if (_cache != nullptr) {
+        updateConfigCache(*_cache, _blob);
+    }
+    _loaded = true;
+    return true;
+}
+
+bool ConfigManager::openPreferences() {
     if (_initialized) {
         return true;
     }
@@ -18,142 +74,125 @@ bool ConfigManager::begin() {
     _initialized = _preferences.begin(PREF_NAMESPACE, false);
     if (!_initialized) {
         Logger::message("ConfigManager Error", "Failed to initialize Preferences");
+    }
+    return _initialized;
+}
+
+bool ConfigManager::commitConfig() {
+    _configCurrent = false;
+    PreferencesConfigStore store(_preferences);
+    if (!openPreferences() || !saveConfigBlob(store, _blob)) {
+        Logger::message("Config Error", "Failed to save configuration");
+        // Reload from NVS next time - the copy in memory no longer matches it
+        if (_cache != nullptr) {
+            memset(_cache, 0, sizeof(*_cache));
+        }
+        _loaded = false;
         return false;
     }
-    
-    // Initialize config version if not set (new device)
-    uint8_t configVersion = _preferences.getUChar(PREF_CONFIG_VERSION, 0);
-    if (configVersion == 0) {
-        _preferences.putUChar(PREF_CONFIG_VERSION, CONFIG_VERSION_CURRENT);
+    if (_cache != nullptr) {
+        updateConfigCache(*_cache, _blob);
+    }
+    return true;
+}
+
+bool ConfigManager::setString(ConfigStringId id, const String& value, const char* name) {
+    if (!setConfigString(_blob, id, value.c_str())) {
+        Logger::messagef("Config Error", "%s too long (max %d characters)", name, (int)getConfigStringLimit(id));
+        return false;
+    }
+    return true;
+}
+
+bool ConfigManager::hasFlag(uint16_t flag) {
+    return (_blob.settings.flags & flag) != 0;
+}
+
+void ConfigManager::setFlag(uint16_t flag, bool enabled) {
+    if (enabled) {
+        _blob.settings.flags |= flag;
+    } else {
+        _blob.settings.flags &= ~flag;
     }
-    
-    return _initialized;
 }
 
 bool ConfigManager::isConfigured() {
-    if (!_initialized && !begin()) {
+    if (!begin()) {
         return false;
     }
     
-    return _preferences.getBool(PREF_CONFIGURED, false);
+    return hasFlag(CONFIG_FLAG_CONFIGURED);
 }
 
 bool ConfigManager::hasWiFiConfig() {
-    if (!_initialized && !begin()) {
+    if (!begin()) {
         return false;
     }
     
-    String ssid = _preferences.getString(PREF_WIFI_SSID, "");
-    return ssid.length() > 0;
+    return getConfigString(_blob, CONFIG_STR_WIFI_SSID)[0] != '\0';
 }
 
 bool ConfigManager::isFullyConfigured() {
-    if (!_initialized && !begin()) {
+    if (!begin()) {
         return false;
     }
     
-    String ssid = _preferences.getString(PREF_WIFI_SSID, "");
-    uint8_t imageCount = _preferences.getUChar(PREF_IMAGE_COUNT, 0);
+    return getConfigString(_blob, CONFIG_STR_WIFI_SSID)[0] != '\0' && _blob.settings.imageCount > 0;
+}
+
+const DashboardConfig& ConfigManager::getConfig() {
+    if (!begin() || _configCurrent) {
+        return _config;  // Defaults (not configured) when storage is unavailable
+    }
     
-    return (ssid.length() > 0 && imageCount > 0);
+    readDashboardConfig(_blob, _config);
+    _configCurrent = true;
+    return _config;
 }
 
-bool ConfigManager::loadConfig(DashboardConfig& config) {
-    if (!_initialized && !begin()) {
+bool ConfigManager::loadConfig() {
+    if (!begin()) {
         Logger::message("ConfigManager Error", "ConfigManager not initialized");
         return false;
     }
     
-    // Load all configuration values
-    config.isConfigured = _preferences.getBool(PREF_CONFIGURED, false);
-    
+    const DashboardConfig& config = getConfig();
     if (!config.isConfigured) {
         Logger::message("Config Status", "Device not configured yet");
         return false;
     }
     
-    config.wifiSSID = _preferences.getString(PREF_WIFI_SSID, "");
-    config.wifiPassword = _preferences.getString(PREF_WIFI_PASS, "");
-    config.friendlyName = _preferences.getString(PREF_FRIENDLY_NAME, "");
-    config.mqttBroker = _preferences.getString(PREF_MQTT_BROKER, "");
-    config.mqttUsername = _preferences.getString(PREF_MQTT_USER, "");
-    config.mqttPassword = _preferences.getString(PREF_MQTT_PASS, "");
-    config.useCRC32Check = _preferences.getBool(PREF_USE_CRC32, false);
-    
-    // Load hourly schedule (3 bytes for 24-bit bitmask)
-    config.updateHours[0] = _preferences.getUChar(PREF_UPDATE_HOURS_0, 0xFF);
-    config.updateHours[1] = _preferences.getUChar(PREF_UPDATE_HOURS_1, 0xFF);
-    config.updateHours[2] = _preferences.getUChar(PREF_UPDATE_HOURS_2, 0xFF);
-    
-    // Load timezone offset
-    config.timezoneOffset = _preferences.getInt(PREF_TIMEZONE_OFFSET, 0);
-    
-    // Load screen rotation
-    config.screenRotation = _preferences.getUChar(PREF_SCREEN_ROTATION, DEFAULT_SCREEN_ROTATION);
-    
-    // Load static IP configuration (backwards compatible - defaults to DHCP if not set)
-    config.useStaticIP = _preferences.getBool(PREF_USE_STATIC_IP, false);
-    config.staticIP = _preferences.getString(PREF_STATIC_IP, "");
-    config.gateway = _preferences.getString(PREF_GATEWAY, "");
-    config.subnet = _preferences.getString(PREF_SUBNET, "");
-    config.primaryDNS = _preferences.getString(PREF_PRIMARY_DNS, "");
-    config.secondaryDNS = _preferences.getString(PREF_SECONDARY_DNS, "");
-    
-    // Load carousel configuration
-    config.imageCount = _preferences.getUChar(PREF_IMAGE_COUNT, 0);
-    if (config.imageCount > MAX_IMAGE_SLOTS) {
-        config.imageCount = MAX_IMAGE_SLOTS;
-    }
-    
-    for (uint8_t i = 0; i < config.imageCount; i++) {
-        String urlKey = "img_url_" + String(i);
-        String intKey = "img_int_" + String(i);
-        String stayKey = String(PREF_IMAGE_STAY) + String(i);
-        
-        config.imageUrls[i] = _preferences.getString(urlKey.c_str(), "");
-        config.imageIntervals[i] = _preferences.getInt(intKey.c_str(), DEFAULT_INTERVAL_MINUTES);
-        config.imageStay[i] = _preferences.getBool(stayKey.c_str(), false);
-    }
-    
-    // Load frontlight configuration (only for boards with HAS_FRONTLIGHT)
-    config.frontlightDuration = _preferences.getUChar(PREF_FRONTLIGHT_DURATION, 0);  // Default: disabled
-    config.frontlightBrightness = _preferences.getUChar(PREF_FRONTLIGHT_BRIGHTNESS, 63);  // Default: max brightness
-    
-    // Load overlay configuration
-    config.overlayEnabled = _preferences.getBool(PREF_OVERLAY_ENABLED, false);
-    config.overlayPosition = _preferences.getUChar(PREF_OVERLAY_POSITION, OVERLAY_POS_TOP_RIGHT);
-    config.overlayShowBatteryIcon = _preferences.getBool(PREF_OVERLAY_SHOW_BATTERY_ICON, true);
-    config.overlayShowBatteryPercentage = _preferences.getBool(PREF_OVERLAY_SHOW_BATTERY_PCT, true);
-    config.overlayShowUpdateTime = _preferences.getBool(PREF_OVERLAY_SHOW_UPDATE_TIME, true);
-    config.overlayShowCycleTime = _preferences.getBool(PREF_OVERLAY_SHOW_CYCLE_TIME, false);
-    config.overlaySize = _preferences.getUChar(PREF_OVERLAY_SIZE, OVERLAY_SIZE_MEDIUM);
-    config.overlayTextColor = _preferences.getUChar(PREF_OVERLAY_TEXT_COLOR, OVERLAY_COLOR_BLACK);
-    
     // Validate configuration
-    if (config.wifiSSID.length() == 0 || config.imageCount == 0) {
+    if (config.wifiSSID.isEmpty() || config.imageCount == 0) {
         Logger::message("Config Error", "Invalid configuration: missing SSID or images");
         return false;
     }
     
     Logger::begin("Configuration Loaded");
-    Logger::line("SSID: " + config.wifiSSID);
+    Logger::linef("SSID: %s", config.wifiSSID.c_str());
     if (config.imageCount == 1) {
         Logger::linef("Single image, %dm interval", config.imageIntervals[0]);
-        Logger::line("URL: " + config.imageUrls[0]);
+        Logger::linef("URL: %s", config.imageUrls[0].c_str());
     } else {
         Logger::linef("Carousel: %d images, avg %dm", config.imageCount, config.getAverageInterval());
     }
-    if (config.mqttBroker.length() > 0) {
+    if (!config.mqttBroker.isEmpty()) {
         Logger::linef("MQTT: %s (user: %s)", config.mqttBroker.c_str(), 
-            config.mqttUsername.length() > 0 ? config.mqttUsername.c_str() : "none");
+            !config.mqttUsername.isEmpty() ? config.mqttUsername.c_str() : "none");
     }
     Logger::end();
     
     return true;
 }
 
+DashboardConfig& ConfigManager::editConfig() {
+    getConfig();
+    _configCurrent = false;
+    return _config;
+}
+
 bool ConfigManager::saveConfig(const DashboardConfig& config) {
-    if (!_initialized && !begin()) {
+    if (!begin()) {
         Logger::message("ConfigManager Error", "ConfigManager not initialized");
         return false;
     }
@@ -181,79 +220,31 @@ bool ConfigManager::saveConfig(const DashboardConfig& config) {
         }
     }
     
-    // Save all configuration values
-    _preferences.putString(PREF_WIFI_SSID, config.wifiSSID);
-    _preferences.putString(PREF_WIFI_PASS, config.wifiPassword);
-    _preferences.putString(PREF_FRIENDLY_NAME, config.friendlyName);
-    _preferences.putString(PREF_MQTT_BROKER, config.mqttBroker);
-    _preferences.putString(PREF_MQTT_USER, config.mqttUsername);
-    _preferences.putString(PREF_MQTT_PASS, config.mqttPassword);
-    _preferences.putBool(PREF_CONFIGURED, true);
-    _preferences.putBool(PREF_USE_CRC32, config.useCRC32Check);
-    
-    // Save hourly schedule (3 bytes for 24-bit bitmask)
-    _preferences.putUChar(PREF_UPDATE_HOURS_0, config.updateHours[0]);
-    _preferences.putUChar(PREF_UPDATE_HOURS_1, config.updateHours[1]);
-    _preferences.putUChar(PREF_UPDATE_HOURS_2, config.updateHours[2]);
-    
-    // Save timezone offset
-    _preferences.putInt(PREF_TIMEZONE_OFFSET, config.timezoneOffset);
-    
-    // Save screen rotation
-    _preferences.putUChar(PREF_SCREEN_ROTATION, config.screenRotation);
-    
-    // Save static IP configuration
-    _preferences.putBool(PREF_USE_STATIC_IP, config.useStaticIP);
-    _preferences.putString(PREF_STATIC_IP, config.staticIP);
-    _preferences.putString(PREF_GATEWAY, config.gateway);
-    _preferences.putString(PREF_SUBNET, config.subnet);
-    _preferences.putString(PREF_PRIMARY_DNS, config.primaryDNS);
-    _preferences.putString(PREF_SECONDARY_DNS, config.secondaryDNS);
+    // Validators belong to the old URL - drop them when the slot points somewhere else (or is unused)
+    uint16_t changedSlots = 0;
+    for (uint8_t i = 0; i < MAX_IMAGE_SLOTS; i++) {
+        const char* storedUrl = getConfigString(_blob, (ConfigStringId)(CONFIG_STR_IMAGE_URL + i));
+        if (i >= config.imageCount || config.imageUrls[i] != storedUrl) {
+            changedSlots |= (1 << i);
+        }
+    }
     
-    // Save config version
-    _preferences.putUChar(PREF_CONFIG_VERSION, CONFIG_VERSION_CURRENT);
+    writeDashboardConfig(config, _blob);
+    setFlag(CONFIG_FLAG_CONFIGURED, true);
     
-    // Save carousel configuration
-    _preferences.putUChar(PREF_IMAGE_COUNT, config.imageCount);
+    if (!commitConfig()) {
+        return false;
+    }
     
-    for (uint8_t i = 0; i < config.imageCount; i++) {
-        String urlKey = "img_url_" + String(i);
-        String intKey = "img_int_" + String(i);
-        String stayKey = String(PREF_IMAGE_STAY) + String(i);
-        
-        size_t urlBytes = _preferences.putString(urlKey.c_str(), config.imageUrls[i]);
-        if (urlBytes == 0) {
-            Logger::messagef("Config Error", "Failed to save URL #%d", i);
-            return false;
+    for (uint8_t i = 0; i < MAX_IMAGE_SLOTS; i++) {
+        if (changedSlots & (1 << i)) {
+            _preferences.remove((String(PREF_IMAGE_ETAG) + String(i)).c_str());
+            _preferences.remove((String(PREF_IMAGE_LAST_MODIFIED) + String(i)).c_str());
         }
-        
-        _preferences.putInt(intKey.c_str(), config.imageIntervals[i]);
-        _preferences.putBool(stayKey.c_str(), config.imageStay[i]);
-    }
-    
-    // Clear unused slots
-    for (uint8_t i = config.imageCount; i < MAX_IMAGE_SLOTS; i++) {
-        String urlKey = "img_url_" + String(i);
-        String intKey = "img_int_" + String(i);
-        String stayKey = String(PREF_IMAGE_STAY) + String(i);
-        _preferences.remove(urlKey.c_str());
-        _preferences.remove(intKey.c_str());
-        _preferences.remove(stayKey.c_str());
-    }
-    
-    // Save frontlight configuration (only for boards with HAS_FRONTLIGHT)
-    _preferences.putUChar(PREF_FRONTLIGHT_DURATION, config.frontlightDuration);
-    _preferences.putUChar(PREF_FRONTLIGHT_BRIGHTNESS, config.frontlightBrightness);
-    
-    // Save overlay configuration
-    _preferences.putBool(PREF_OVERLAY_ENABLED, config.overlayEnabled);
-    _preferences.putUChar(PREF_OVERLAY_POSITION, config.overlayPosition);
-    _preferences.putBool(PREF_OVERLAY_SHOW_BATTERY_ICON, config.overlayShowBatteryIcon);
-    _preferences.putBool(PREF_OVERLAY_SHOW_BATTERY_PCT, config.overlayShowBatteryPercentage);
-    _preferences.putBool(PREF_OVERLAY_SHOW_UPDATE_TIME, config.overlayShowUpdateTime);
-    _preferences.putBool(PREF_OVERLAY_SHOW_CYCLE_TIME, config.overlayShowCycleTime);
-    _preferences.putUChar(PREF_OVERLAY_SIZE, config.overlaySize);
-    _preferences.putUChar(PREF_OVERLAY_TEXT_COLOR, config.overlayTextColor);
+    }
+    
+    // Image list may have changed - start change detection from scratch
+    _preferences.remove(PREF_IMAGE_SLOTS);
     
     Logger::begin("Config Saved");
     if (config.imageCount == 1) {
@@ -267,118 +258,150 @@ bool ConfigManager::saveConfig(const DashboardConfig& config) {
 }
 
 void ConfigManager::clearConfig() {
-    if (!_initialized && !begin()) {
+    if (!openPreferences()) {
         Logger::message("ConfigManager Error", "ConfigManager not initialized");
         return;
     }
     
     _preferences.clear();
+    initConfigBlob(_blob);
+    _configCurrent = false;
+    if (_cache != nullptr) {
+        updateConfigCache(*_cache, _blob);
+    }
+    _loaded = true;
     Logger::message("Factory Reset", "Configuration cleared (factory reset)");
 }
 
 String ConfigManager::getWiFiSSID() {
-    if (!_initialized && !begin()) {
+    if (!begin()) {
         return "";
     }
-    return _preferences.getString(PREF_WIFI_SSID, "");
+    return getConfigString(_blob, CONFIG_STR_WIFI_SSID);
 }
 
 String ConfigManager::getWiFiPassword() {
-    if (!_initialized && !begin()) {
+    if (!begin()) {
         return "";
     }
-    return _preferences.getString(PREF_WIFI_PASS, "");
+    return getConfigString(_blob, CONFIG_STR_WIFI_PASSWORD);
 }
 
 String ConfigManager::getFriendlyName() {
-    if (!_initialized && !begin()) {
+    if (!begin()) {
         return "";
     }
-    return _preferences.getString(PREF_FRIENDLY_NAME, "");
+    return getConfigString(_blob, CONFIG_STR_FRIENDLY_NAME);
 }
 
 String ConfigManager::getMQTTBroker() {
-    if (!_initialized && !begin()) {
+    if (!begin()) {
         return "";
     }
-    return _preferences.getString(PREF_MQTT_BROKER, "");
+    return getConfigString(_blob, CONFIG_STR_MQTT_BROKER);
 }
 
 String ConfigManager::getMQTTUsername() {
-    if (!_initialized && !begin()) {
+    if (!begin()) {
         return "";
     }
-    return _preferences.getString(PREF_MQTT_USER, "");
+    return getConfigString(_blob, CONFIG_STR_MQTT_USERNAME);
 }
 
 String ConfigManager::getMQTTPassword() {
-    if (!_initialized && !begin()) {
+    if (!begin()) {
         return "";
     }
-    return _preferences.getString(PREF_MQTT_PASS, "");
+    return getConfigString(_blob, CONFIG_STR_MQTT_PASSWORD);
+}
+
+bool ConfigManager::getMQTTBatchedState() {
+    if (!begin()) {
+        return false;
+    }
+    return hasFlag(CONFIG_FLAG_MQTT_BATCHED);
 }
 
 void ConfigManager::setWiFiCredentials(const String& ssid, const String& password) {
-    if (!_initialized && !begin()) {
+    if (!begin()) {
         Logger::message("ConfigManager Error", "ConfigManager not initialized");
         return;
     }
     
-    _preferences.putString(PREF_WIFI_SSID, ssid);
-    _preferences.putString(PREF_WIFI_PASS, password);
-    Logger::message("Config Update", "WiFi credentials updated");
+    if (ssid.length() > getConfigStringLimit(CONFIG_STR_WIFI_SSID) ||
+        password.length() > getConfigStringLimit(CONFIG_STR_WIFI_PASSWORD)) {
+        Logger::message("Config Error", "WiFi credentials too long");
+        return;
+    }
+    setString(CONFIG_STR_WIFI_SSID, ssid, "WiFi SSID");
+    setString(CONFIG_STR_WIFI_PASSWORD, password, "WiFi password");
+    if (commitConfig()) {
+        Logger::message("Config Update", "WiFi credentials updated");
+    }
 }
 
 void ConfigManager::setFriendlyName(const String& name) {
-    if (!_initialized && !begin()) {
+    if (!begin()) {
         Logger::message("ConfigManager Error", "ConfigManager not initialized");
         return;
     }
     
-    _preferences.putString(PREF_FRIENDLY_NAME, name);
-    Logger::message("Config Update", "Friendly name updated");
+    if (setString(CONFIG_STR_FRIENDLY_NAME, name, "Friendly name") && commitConfig()) {
+        Logger::message("Config Update", "Friendly name updated");
+    }
 }
 
 void ConfigManager::setMQTTConfig(const String& broker, const String& username, const String& password) {
-    if (!_initialized && !begin()) {
+    if (!begin()) {
         Logger::message("ConfigManager Error", "ConfigManager not initialized");
         return;
     }
     
-    _preferences.putString(PREF_MQTT_BROKER, broker);
-    _preferences.putString(PREF_MQTT_USER, username);
-    _preferences.putString(PREF_MQTT_PASS, password);
-    Logger::message("Config Update", "MQTT configuration updated");
+    if (broker.length() > getConfigStringLimit(CONFIG_STR_MQTT_BROKER) ||
+        username.length() > getConfigStringLimit(CONFIG_STR_MQTT_USERNAME) ||
+        password.length() > getConfigStringLimit(CONFIG_STR_MQTT_PASSWORD)) {
+        Logger::message("Config Error", "MQTT configuration too long");
+        return;
+    }
+    setString(CONFIG_STR_MQTT_BROKER, broker, "MQTT broker");
+    setString(CONFIG_STR_MQTT_USERNAME, username, "MQTT username");
+    setString(CONFIG_STR_MQTT_PASSWORD, password, "MQTT password");
+    if (commitConfig()) {
+        Logger::message("Config Update", "MQTT configuration updated");
+    }
 }
 
 void ConfigManager::setUseCRC32Check(bool enabled) {
-    if (!_initialized && !begin()) {
+    if (!begin()) {
         Logger::message("ConfigManager Error", "ConfigManager not initialized");
         return;
     }
 
-    _preferences.putBool(PREF_USE_CRC32, enabled);
+    setFlag(CONFIG_FLAG_USE_CRC32, enabled);
+    if (!commitConfig()) {
+        return;
+    }
     Logger::begin("Config Update");
     Logger::line("CRC32 check updated: " + String(enabled ? "ON" : "OFF"));
     Logger::end();
 }
 
 bool ConfigManager::getUseCRC32Check() {
-    if (!_initialized && !begin()) {
+    if (!begin()) {
         return false;
     }
-    return _preferences.getBool(PREF_USE_CRC32, false);
+    return hasFlag(CONFIG_FLAG_USE_CRC32);
 }
 
 uint8_t ConfigManager::getScreenRotation() {
-    if (!_initialized && !begin()) {
+    if (!begin()) {
         return DEFAULT_SCREEN_ROTATION;
     }
-    return _preferences.getUChar(PREF_SCREEN_ROTATION, DEFAULT_SCREEN_ROTATION);
+    return _blob.settings.screenRotation;
 }
 
 void ConfigManager::setScreenRotation(uint8_t rotation) {
-    if (!_initialized && !begin()) {
+    if (!begin()) {
         Logger::message("ConfigManager Error", "ConfigManager not initialized");
         return;
     }
@@ -389,37 +412,171 @@ void ConfigManager::setScreenRotation(uint8_t rotation) {
         return;
     }
     
-    _preferences.putUChar(PREF_SCREEN_ROTATION, rotation);
+    _blob.settings.screenRotation = rotation;
+    if (!commitConfig()) {
+        return;
+    }
     Logger::begin("Screen Rotation");
     Logger::line("Rotation updated: " + String(rotation * 90) + "°");
     Logger::end();
 }
 
+void ConfigManager::getImageSlotTable(ImageSlotTable& table) {
+    initImageSlotTable(table);
+    if (!openPreferences()) {
+        return;
+    }
+    
+    ImageSlotTable stored;
+    size_t len = _preferences.getBytesLength(PREF_IMAGE_SLOTS);
+    if (len != sizeof(stored)) {
+        return;  // Missing or written by a different firmware layout
+    }
+    _preferences.getBytes(PREF_IMAGE_SLOTS, &stored, sizeof(stored));
+    if (isImageSlotTableValid(stored)) {
+        table = stored;
+    }
+}
+
+void ConfigManager::setImageSlotTable(const ImageSlotTable& table) {
+    if (!openPreferences()) {
+        Logger::line("ConfigManager not initialized - cannot save CRC32 table");
+        return;
+    }
+    
+    // Skip the flash write when nothing changed (e.g. CRC32 matched)
+    ImageSlotTable stored;
+    if (_preferences.getBytesLength(PREF_IMAGE_SLOTS) == sizeof(stored)) {
+        _preferences.getBytes(PREF_IMAGE_SLOTS, &stored, sizeof(stored));
+        if (memcmp(&stored, &table, sizeof(stored)) == 0) {
+            return;
+        }
+    }
+    
+    _preferences.putBytes(PREF_IMAGE_SLOTS, &table, sizeof(table));
+    if (_preferences.isKey(PREF_LAST_CRC32)) {
+        _preferences.remove(PREF_LAST_CRC32);
+    }
+    if (table.displayedSlot != IMAGE_SLOT_NONE) {
+        Logger::linef("Saved CRC32 table (on screen: image %d, CRC32 0x%08X)",
+                      table.displayedSlot + 1, getSlotCRC32(table, table.displayedSlot));
+    } else {
+        Logger::line("Saved CRC32 table (screen content unknown)");
+    }
+}
+
+void ConfigManager::clearDisplayedImageSlot() {
+    ImageSlotTable table;
+    getImageSlotTable(table);
+    if (table.displayedSlot == IMAGE_SLOT_NONE) {
+        return;
+    }
+    clearDisplayedSlot(table);
+    setImageSlotTable(table);
+}
+
 uint32_t ConfigManager::getLastCRC32() {
-    if (!_initialized && !begin()) {
+    ImageSlotTable table;
+    getImageSlotTable(table);
+    if (table.displayedSlot == IMAGE_SLOT_NONE) {
         return 0;
     }
-    return _preferences.getUInt(PREF_LAST_CRC32, 0);
+    return getSlotCRC32(table, table.displayedSlot);
 }
 
-void ConfigManager::setLastCRC32(uint32_t crc32) {
-    if (!_initialized && !begin()) {
-        Logger::line("ConfigManager not initialized - cannot save CRC32");
+void ConfigManager::getImageValidators(uint8_t index, String& etag, String& lastModified) {
+    etag = "";
+    lastModified = "";
+    if (index >= MAX_IMAGE_SLOTS || (!openPreferences())) {
         return;
     }
     
-    _preferences.putUInt(PREF_LAST_CRC32, crc32);
-    Logger::linef("Saved to preferences: 0x%08X", crc32);
+    String etagKey = String(PREF_IMAGE_ETAG) + String(index);
+    String lastModKey = String(PREF_IMAGE_LAST_MODIFIED) + String(index);
+    etag = _preferences.getString(etagKey.c_str(), "");
+    lastModified = _preferences.getString(lastModKey.c_str(), "");
+}
+
+void ConfigManager::setImageValidators(uint8_t index, const String& etag, const String& lastModified) {
+    if (index >= MAX_IMAGE_SLOTS) {
+        return;
+    }
+    if (!openPreferences()) {
+        Logger::line("ConfigManager not initialized - cannot save validators");
+        return;
+    }
+    
+    // Skip the flash write when nothing changed (the common case on every refresh)
+    String storedEtag;
+    String storedLastModified;
+    getImageValidators(index, storedEtag, storedLastModified);
+    if (storedEtag == etag && storedLastModified == lastModified) {
+        return;
+    }
+    
+    String etagKey = String(PREF_IMAGE_ETAG) + String(index);
+    String lastModKey = String(PREF_IMAGE_LAST_MODIFIED) + String(index);
+    _preferences.putString(etagKey.c_str(), etag);
+    _preferences.putString(lastModKey.c_str(), lastModified);
+    Logger::linef("Saved validators for image %d (ETag: %s, Last-Modified: %s)", index + 1,
+                  etag.length() > 0 ? etag.c_str() : "-",
+                  lastModified.length() > 0 ? lastModified.c_str() : "-");
+}
+
+void ConfigManager::clearImageValidators(uint8_t index) {
+    setImageValidators(index, "", "");
+}
+
+uint32_t ConfigManager::getMQTTDiscoveryHash() {
+    if (!openPreferences()) {
+        return 0;
+    }
+    return _preferences.getUInt(PREF_MQTT_DISCOVERY_HASH, 0);
+}
+
+void ConfigManager::setMQTTDiscoveryHash(uint32_t hash) {
+    if (!openPreferences()) {
+        Logger::line("ConfigManager not initialized - cannot save discovery hash");
+        return;
+    }
+    
+    if (getMQTTDiscoveryHash() == hash) {
+        return;
+    }
+    _preferences.putUInt(PREF_MQTT_DISCOVERY_HASH, hash);
+    Logger::linef("Saved discovery hash 0x%08X", (unsigned)hash);
+}
+
+String ConfigManager::getApiToken() {
+    if (!openPreferences()) {
+        return "";
+    }
+    return _preferences.getString(PREF_API_TOKEN, "");
+}
+
+bool ConfigManager::setApiToken(const char* token) {
+    if (!openPreferences()) {
+        Logger::line("ConfigManager not initialized - cannot save API token");
+        return false;
+    }
+    
+    if (token == nullptr || token[0] == '\0') {
+        _preferences.remove(PREF_API_TOKEN);
+        return true;
+    }
+    return _preferences.putString(PREF_API_TOKEN, token) > 0;
 }
 
 void ConfigManager::markAsConfigured() {
-    if (!_initialized && !begin()) {
+    if (!begin()) {
         Logger::message("ConfigManager Error", "ConfigManager not initialized");
         return;
     }
     
-    _preferences.putBool(PREF_CONFIGURED, true);
-    Logger::message("Config Update", "Device marked as configured");
+    setFlag(CONFIG_FLAG_CONFIGURED, true);
+    if (commitConfig()) {
+        Logger::message("Config Update", "Device marked as configured");
+    }
 }
 
 bool ConfigManager::isHourEnabled(uint8_t hour) {
@@ -427,17 +584,12 @@ bool ConfigManager::isHourEnabled(uint8_t hour) {
         return false;
     }
     
-    // Determine which byte and bit position
-    uint8_t byteIndex = hour / 8;      // 0, 1, or 2
-    uint8_t bitPosition = hour % 8;    // 0-7 within the byte
-    
-    if (!_initialized && !begin()) {
+    if (!begin()) {
         // Default: all hours enabled
         return true;
     }
     
-    uint8_t hourByte = _preferences.getUChar(PREF_UPDATE_HOURS_0 + byteIndex, 0xFF);
-    return (hourByte >> bitPosition) & 1;
+    return ::isHourEnabledInBitmask(hour, _blob.settings.updateHours);
 }
 
 void ConfigManager::setHourEnabled(uint8_t hour, bool enabled) {
@@ -445,7 +597,7 @@ void ConfigManager::setHourEnabled(uint8_t hour, bool enabled) {
         return;
     }
     
-    if (!_initialized && !begin()) {
+    if (!begin()) {
         Logger::message("ConfigManager Error", "ConfigManager not initialized");
         return;
     }
@@ -453,22 +605,18 @@ void ConfigManager::setHourEnabled(uint8_t hour, bool enabled) {
     uint8_t byteIndex = hour / 8;
     uint8_t bitPosition = hour % 8;
     
-    // Read current byte
-    uint8_t hourByte = _preferences.getUChar(PREF_UPDATE_HOURS_0 + byteIndex, 0xFF);
-    
     // Modify bit
     if (enabled) {
-        hourByte |= (1 << bitPosition);
+        _blob.settings.updateHours[byteIndex] |= (1 << bitPosition);
     } else {
-        hourByte &= ~(1 << bitPosition);
+        _blob.settings.updateHours[byteIndex] &= ~(1 << bitPosition);
     }
     
-    // Save byte
-    _preferences.putUChar(PREF_UPDATE_HOURS_0 + byteIndex, hourByte);
+    commitConfig();
 }
 
 void ConfigManager::getUpdateHours(uint8_t hours[3]) {
-    if (!_initialized && !begin()) {
+    if (!begin()) {
         // Default: all hours enabled
         hours[0] = 0xFF;
         hours[1] = 0xFF;
@@ -476,33 +624,36 @@ void ConfigManager::getUpdateHours(uint8_t hours[3]) {
         return;
     }
     
-    hours[0] = _preferences.getUChar(PREF_UPDATE_HOURS_0, 0xFF);
-    hours[1] = _preferences.getUChar(PREF_UPDATE_HOURS_1, 0xFF);
-    hours[2] = _preferences.getUChar(PREF_UPDATE_HOURS_2, 0xFF);
+    hours[0] = _blob.settings.updateHours[0];
+    hours[1] = _blob.settings.updateHours[1];
+    hours[2] = _blob.settings.updateHours[2];
 }
 
 void ConfigManager::setUpdateHours(const uint8_t hours[3]) {
-    if (!_initialized && !begin()) {
+    if (!begin()) {
         Logger::message("ConfigManager Error", "ConfigManager not initialized");
         return;
     }
     
-    _preferences.putUChar(PREF_UPDATE_HOURS_0, hours[0]);
-    _preferences.putUChar(PREF_UPDATE_HOURS_1, hours[1]);
-    _preferences.putUChar(PREF_UPDATE_HOURS_2, hours[2]);
+    _blob.settings.updateHours[0] = hours[0];
+    _blob.settings.updateHours[1] = hours[1];
+    _blob.settings.updateHours[2] = hours[2];
+    if (!commitConfig()) {
+        return;
+    }
     
     Logger::messagef("Config Update", "Update hours bitmask set: 0x%02X%02X%02X", hours[2], hours[1], hours[0]);
 }
 
 int ConfigManager::getTimezoneOffset() {
-    if (!_initialized && !begin()) {
+    if (!begin()) {
         return 0;  // Default to UTC
     }
-    return _preferences.getInt(PREF_TIMEZONE_OFFSET, 0);
+    return _blob.settings.timezoneOffset;
 }
 
 void ConfigManager::setTimezoneOffset(int offset) {
-    if (!_initialized && !begin()) {
+    if (!begin()) {
         Logger::message("ConfigManager Error", "ConfigManager not initialized");
         return;
     }
@@ -513,67 +664,79 @@ void ConfigManager::setTimezoneOffset(int offset) {
         return;
     }
     
-    _preferences.putInt(PREF_TIMEZONE_OFFSET, offset);
+    _blob.settings.timezoneOffset = offset;
+    if (!commitConfig()) {
+        return;
+    }
     Logger::messagef("Config Update", "Timezone offset set to UTC%s%d", offset >= 0 ? "+" : "", offset);
 }
 
 // Static IP getters
 bool ConfigManager::getUseStaticIP() {
-    if (!_initialized && !begin()) {
+    if (!begin()) {
         return false;  // Default to DHCP
     }
-    return _preferences.getBool(PREF_USE_STATIC_IP, false);
+    return hasFlag(CONFIG_FLAG_USE_STATIC_IP);
 }
 
 String ConfigManager::getStaticIP() {
-    if (!_initialized && !begin()) {
+    if (!begin()) {
         return "";
     }
-    return _preferences.getString(PREF_STATIC_IP, "");
+    return getConfigString(_blob, CONFIG_STR_STATIC_IP);
 }
 
 String ConfigManager::getGateway() {
-    if (!_initialized && !begin()) {
+    if (!begin()) {
         return "";
     }
-    return _preferences.getString(PREF_GATEWAY, "");
+    return getConfigString(_blob, CONFIG_STR_GATEWAY);
 }
 
 String ConfigManager::getSubnet() {
-    if (!_initialized && !begin()) {
+    if (!begin()) {
         return "";
     }
-    return _preferences.getString(PREF_SUBNET, "");
+    return getConfigString(_blob, CONFIG_STR_SUBNET);
 }
 
 String ConfigManager::getPrimaryDNS() {
-    if (!_initialized && !begin()) {
+    if (!begin()) {
         return "";
     }
-    return _preferences.getString(PREF_PRIMARY_DNS, "");
+    return getConfigString(_blob, CONFIG_STR_PRIMARY_DNS);
 }
 
 String ConfigManager::getSecondaryDNS() {
-    if (!_initialized && !begin()) {
+    if (!begin()) {
         return "";
     }
-    return _preferences.getString(PREF_SECONDARY_DNS, "");
+    return getConfigString(_blob, CONFIG_STR_SECONDARY_DNS);
 }
 
 // Static IP setter
 void ConfigManager::setStaticIPConfig(bool useStatic, const String& ip, const String& gw, 
                                      const String& sn, const String& dns1, const String& dns2) {
-    if (!_initialized && !begin()) {
+    if (!begin()) {
         Logger::message("ConfigManager Error", "ConfigManager not initialized");
         return;
     }
     
-    _preferences.putBool(PREF_USE_STATIC_IP, useStatic);
-    _preferences.putString(PREF_STATIC_IP, ip);
-    _preferences.putString(PREF_GATEWAY, gw);
-    _preferences.putString(PREF_SUBNET, sn);
-    _preferences.putString(PREF_PRIMARY_DNS, dns1);
-    _preferences.putString(PREF_SECONDARY_DNS, dns2);
+    const String* values[] = { &ip, &gw, &sn, &dns1, &dns2 };
+    for (int i = 0; i < 5; i++) {
+        if (values[i]->length() > getConfigStringLimit((ConfigStringId)(CONFIG_STR_STATIC_IP + i))) {
+            Logger::message("Config Error", "Invalid address: " + *values[i]);
+            return;
+        }
+    }
+    
+    setFlag(CONFIG_FLAG_USE_STATIC_IP, useStatic);
+    for (int i = 0; i < 5; i++) {
+        setConfigString(_blob, (ConfigStringId)(CONFIG_STR_STATIC_IP + i), values[i]->c_str());
+    }
+    if (!commitConfig()) {
+        return;
+    }
     
     if (useStatic) {
         Logger::begin("Static IP Config Saved");
@@ -592,7 +755,7 @@ void ConfigManager::setStaticIPConfig(bool useStatic, const String& ip, const St
 
 // WiFi channel locking methods
 bool ConfigManager::hasWiFiChannelLock() {
-    if (!_initialized && !begin()) {
+    if (!openPreferences()) {
         return false;
     }
     
@@ -601,7 +764,7 @@ bool ConfigManager::hasWiFiChannelLock() {
 }
 
 uint8_t ConfigManager::getWiFiChannel() {
-    if (!_initialized && !begin()) {
+    if (!openPreferences()) {
         return 0;
     }
     
@@ -609,7 +772,7 @@ uint8_t ConfigManager::getWiFiChannel() {
 }
 
 void ConfigManager::getWiFiBSSID(uint8_t* bssid) {
-    if (!_initialized && !begin()) {
+    if (!openPreferences()) {
         memset(bssid, 0, 6);
         return;
     }
@@ -624,7 +787,7 @@ void ConfigManager::getWiFiBSSID(uint8_t* bssid) {
 }
 
 void ConfigManager::setWiFiChannelLock(uint8_t channel, const uint8_t* bssid) {
-    if (!_initialized && !begin()) {
+    if (!openPreferences()) {
         Logger::message("ConfigManager Error", "ConfigManager not initialized");
         return;
     }
@@ -645,7 +808,7 @@ void ConfigManager::setWiFiChannelLock(uint8_t channel, const uint8_t* bssid) {
 }
 
 void ConfigManager::clearWiFiChannelLock() {
-    if (!_initialized && !begin()) {
+    if (!openPreferences()) {
         return;
     }
     
@@ -3,193 +3,21 @@
 
 #include <Arduino.h>
 #include <Preferences.h>
+#include "config_blob.h"
 #include "config_logic.h"
-
-// Configuration keys for Preferences storage
-#define PREF_NAMESPACE "dashboard"
-#define PREF_CONFIGURED "configured"
-#define PREF_WIFI_SSID "wifi_ssid"
-#define PREF_WIFI_PASS "wifi_pass"
-#define PREF_IMAGE_URL "image_url"  // Legacy - kept for compatibility
-#define PREF_REFRESH_RATE "refresh_rate"  // Legacy - kept for compatibility
-#define PREF_MQTT_BROKER "mqtt_broker"
-#define PREF_MQTT_USER "mqtt_user"
-#define PREF_MQTT_PASS "mqtt_pass"
-#define PREF_USE_CRC32 "use_crc32"
-#define PREF_LAST_CRC32 "last_crc32"
-#define PREF_UPDATE_HOURS_0 "upd_hours_0"
-#define PREF_UPDATE_HOURS_1 "upd_hours_1"
-#define PREF_UPDATE_HOURS_2 "upd_hours_2"
-#define PREF_TIMEZONE_OFFSET "tz_offset"
-#define PREF_SCREEN_ROTATION "screen_rot"
-
-// Static IP configuration keys
-#define PREF_USE_STATIC_IP "use_static_ip"
-#define PREF_STATIC_IP "static_ip"
-#define PREF_GATEWAY "gateway"
-#define PREF_SUBNET "subnet"
-#define PREF_PRIMARY_DNS "dns1"
-#define PREF_SECONDARY_DNS "dns2"
-
-// WiFi channel locking keys (for fast reconnection)
-#define PREF_WIFI_CHANNEL "wifi_ch"
-#define PREF_WIFI_BSSID "wifi_bssid"
-
-// Device identification
-#define PREF_FRIENDLY_NAME "friendly_name"
-
-// Frontlight configuration (Inkplate 6 Flick only)
-#define PREF_FRONTLIGHT_DURATION "fl_duration"  // Duration in seconds (0 = disabled)
-#define PREF_FRONTLIGHT_BRIGHTNESS "fl_bright"  // Brightness level (0-63)
-
-// Overlay configuration keys
-#define PREF_OVERLAY_ENABLED "ovl_enabled"
-#define PREF_OVERLAY_POSITION "ovl_pos"
-#define PREF_OVERLAY_SHOW_BATTERY_ICON "ovl_bat_icon"
-#define PREF_OVERLAY_SHOW_BATTERY_PCT "ovl_bat_pct"
-#define PREF_OVERLAY_SHOW_UPDATE_TIME "ovl_upd_time"
-#define PREF_OVERLAY_SHOW_CYCLE_TIME "ovl_cyc_time"
-#define PREF_OVERLAY_SIZE "ovl_size"
-#define PREF_OVERLAY_TEXT_COLOR "ovl_txt_col"
-
-// Carousel configuration keys
-#define PREF_CONFIG_VERSION "cfg_ver"
-#define PREF_IMAGE_COUNT "img_count"
-#define PREF_IMAGE_STAY "img_stay_"  // Followed by index 0-9
-#define CONFIG_VERSION_CURRENT 2
-
-// Carousel constraints
-#define MAX_IMAGE_SLOTS 10
-#define MAX_URL_LENGTH 250
-#define MIN_INTERVAL_MINUTES 0  // 0 = button-only mode (no automatic refresh)
-#define DEFAULT_INTERVAL_MINUTES 5
-
-// Default values
-#define DEFAULT_SCREEN_ROTATION 0  // 0 degrees (landscape)
-
-// Overlay position enum (matches config)
-#define OVERLAY_POS_TOP_LEFT 0
-#define OVERLAY_POS_TOP_RIGHT 1
-#define OVERLAY_POS_BOTTOM_LEFT 2
-#define OVERLAY_POS_BOTTOM_RIGHT 3
-
-// Overlay size enum (matches config)
-#define OVERLAY_SIZE_SMALL 0
-#define OVERLAY_SIZE_MEDIUM 1
-#define OVERLAY_SIZE_LARGE 2
-
-// Overlay text color enum (matches config)
-#define OVERLAY_COLOR_BLACK 0
-#define OVERLAY_COLOR_DARK_GRAY 1
-#define OVERLAY_COLOR_LIGHT_GRAY 2
-#define OVERLAY_COLOR_WHITE 3
-
-// Configuration data structure
-struct DashboardConfig {
-    String wifiSSID;
-    String wifiPassword;
-    String friendlyName;  // User-friendly device name (optional, for MQTT/HA/hostname)
-    String mqttBroker;  // MQTT broker URL (e.g., mqtt://broker.example.com:1883)
-    String mqttUsername;
-    String mqttPassword;
-    bool isConfigured;
-    bool useCRC32Check;  // Enable CRC32-based change detection
-    uint8_t updateHours[3];  // 24-bit bitmask: bit i = hour i enabled (0-23)
-    int timezoneOffset;  // Timezone offset in hours (-12 to +14)
-    uint8_t screenRotation;  // Screen rotation: 0, 1, 2, 3 (0°, 90°, 180°, 270°)
-    
-    // Static IP configuration
-    bool useStaticIP;       // Use static IP instead of DHCP
-    String staticIP;        // Static IP address (e.g., "192.168.1.100")
-    String gateway;         // Gateway address (e.g., "192.168.1.1")
-    String subnet;          // Subnet mask (e.g., "255.255.255.0")
-    String primaryDNS;      // Primary DNS server (e.g., "8.8.8.8")
-    String secondaryDNS;    // Secondary DNS server (optional)
-    
-    // Carousel configuration
-    uint8_t imageCount;           // How many URLs provided (0-10)
-    String imageUrls[MAX_IMAGE_SLOTS];    // Image URLs
-    int imageIntervals[MAX_IMAGE_SLOTS];  // Display duration per image in minutes
-    bool imageStay[MAX_IMAGE_SLOTS];      // Stay on image (don't auto-advance)
-    
-    // Frontlight configuration (only for boards with HAS_FRONTLIGHT)
-    uint8_t frontlightDuration;   // Duration in seconds (0 = disabled, default 0)
-    uint8_t frontlightBrightness; // Brightness level (0-63, default 63)
-    
-    // Overlay configuration (on-image status display)
-    bool overlayEnabled;               // Enable/disable overlay
-    uint8_t overlayPosition;           // 0=TL, 1=TR, 2=BL, 3=BR
-    bool overlayShowBatteryIcon;       // Show battery icon
-    bool overlayShowBatteryPercentage; // Show battery percentage text
-    bool overlayShowUpdateTime;        // Show last update time
-    bool overlayShowCycleTime;         // Show last cycle/loop time
-    uint8_t overlaySize;               // 0=Small, 1=Medium, 2=Large
-    uint8_t overlayTextColor;          // 0=Black, 1=Dark Gray, 2=Light Gray, 3=White
-    
-    // Constructor with defaults
-    DashboardConfig() : 
-        wifiSSID(""),
-        wifiPassword(""),
-        friendlyName(""),
-        mqttBroker(""),
-        mqttUsername(""),
-        mqttPassword(""),
-        isConfigured(false),
-        useCRC32Check(false),
-        timezoneOffset(0),
-        screenRotation(DEFAULT_SCREEN_ROTATION),
-        useStaticIP(false),
-        staticIP(""),
-        gateway(""),
-        subnet(""),
-        primaryDNS(""),
-        secondaryDNS(""),
-        imageCount(0),
-        frontlightDuration(0),      // Default: disabled
-        frontlightBrightness(63),   // Default: max brightness
-        overlayEnabled(false),      // Default: disabled
-        overlayPosition(OVERLAY_POS_TOP_RIGHT),
-        overlayShowBatteryIcon(true),
-        overlayShowBatteryPercentage(true),
-        overlayShowUpdateTime(true),
-        overlayShowCycleTime(false),
-        overlaySize(OVERLAY_SIZE_MEDIUM),
-        overlayTextColor(OVERLAY_COLOR_BLACK) {
-        // Initialize all hours enabled by default (0xFF = all bits set)
-        updateHours[0] = 0xFF;  // Hours 0-7
-        updateHours[1] = 0xFF;  // Hours 8-15
-        updateHours[2] = 0xFF;  // Hours 16-23
-        
-        // Initialize carousel arrays
-        for (int i = 0; i < MAX_IMAGE_SLOTS; i++) {
-            imageUrls[i] = "";
-            imageIntervals[i] = 0;
-            imageStay[i] = false;
-        }
-    }
-    
-    // Helper methods
-    bool isCarouselMode() const {
-        return imageCount > 1;
-    }
-    
-    // Calculate average interval for battery estimates and fallbacks
-    int getAverageInterval() const {
-        if (imageCount == 0) return DEFAULT_INTERVAL_MINUTES;
-        int total = 0;
-        for (uint8_t i = 0; i < imageCount; i++) {
-            total += imageIntervals[i];
-        }
-        return total / imageCount;
-    }
-};
+#include "dashboard_config.h"
+#include "image_slot_table.h"
 
 class ConfigManager {
 public:
     ConfigManager();
     ~ConfigManager();
     
-    // Initialize the configuration manager
+    // RTC memory copy of the stored configuration (optional, set before begin())
+    void setConfigCache(ConfigCache* cache);
+    
+    // Load the configuration: from the RTC copy when valid (NVS is not opened),
+    // otherwise from NVS (migrating the key-per-field layout of older firmware)
     bool begin();
     
     // Check if device has been configured
@@ -201,8 +29,15 @@ public:
     // Check if device is fully configured (WiFi + Image URL)
     bool isFullyConfigured();
     
-    // Load configuration from storage
-    bool loadConfig(DashboardConfig& config);
+    // The configuration, converted from storage on first use and after changes
+    // (one instance for the whole wake - pass it on by const reference)
+    const DashboardConfig& getConfig();
+    
+    // Check the configuration is complete (and log it) - getConfig() holds it
+    bool loadConfig();
+    
+    // getConfig() for filling in before saveConfig() (re-read from storage afterwards)
+    DashboardConfig& editConfig();
     
     // Save configuration to storage
     bool saveConfig(const DashboardConfig& config);
@@ -217,6 +52,7 @@ public:
     String getMQTTBroker();
     String getMQTTUsername();
     String getMQTTPassword();
+    bool getMQTTBatchedState();
     bool getUseCRC32Check();
     uint8_t getScreenRotation();
     
@@ -246,9 +82,29 @@ public:
     void setWiFiChannelLock(uint8_t channel, const uint8_t* bssid);
     void clearWiFiChannelLock();
     
-    // CRC32 storage management
-    uint32_t getLastCRC32();
-    void setLastCRC32(uint32_t crc32);
+    // CRC32 storage management (per image slot)
+    // getImageSlotTable() always returns a usable table (fresh one if missing/invalid)
+    // setImageSlotTable() only writes to flash when the table actually changed
+    void getImageSlotTable(ImageSlotTable& table);
+    void setImageSlotTable(const ImageSlotTable& table);
+    uint32_t getLastCRC32();  // CRC32 of the image currently on screen (0 = unknown)
+    void clearDisplayedImageSlot();  // Call whenever something other than an image replaces the screen
+    
+    // HTTP validator storage per image slot (for conditional GET change detection)
+    // Only writes to flash when the values actually changed
+    void getImageValidators(uint8_t index, String& etag, String& lastModified);
+    void setImageValidators(uint8_t index, const String& etag, const String& lastModified);
+    void clearImageValidators(uint8_t index);
+    
+    // Home Assistant discovery hash (0 = never published)
+    // Only writes to flash when the hash actually changed
+    uint32_t getMQTTDiscoveryHash();
+    void setMQTTDiscoveryHash(uint32_t hash);
+    
+    // Token for PUT /api/config in config mode ("" = API writes off)
+    // Own key: only the portal reads it, so it stays out of the blob and its RTC copy
+    String getApiToken();
+    bool setApiToken(const char* token);
     
     // Hourly scheduling (24-bit bitmask)
     bool isHourEnabled(uint8_t hour);  // hour: 0-23, returns true if updates allowed
@@ -304,7 +160,18 @@ public:
     
 private:
     Preferences _preferences;
-    bool _initialized;
+    bool _initialized;  // NVS namespace open
+    bool _loaded;       // _blob holds the stored configuration
+    ConfigBlob _blob;
+    ConfigCache* _cache;
+    DashboardConfig _config;
+    bool _configCurrent;  // _config matches _blob
+    
+    bool openPreferences();
+    bool commitConfig();  // Save _blob to NVS and its RTC copy
+    bool setString(ConfigStringId id, const String& value, const char* name);
+    bool hasFlag(uint16_t flag);
+    void setFlag(uint16_t flag, bool enabled);
 };
 
 #endif // CONFIG_MANAGER_H
@@ -0,0 +1,453 @@
+#include <config_page.h>
+#include <config_portal_html.h>
+#include <config_portal_assets.h>
+#include <prefetch_cache.h>
+
+// One <option> of a <select>; options are selected by their position
+struct PageOption {
+    const char* value;
+    const char* label;
+};
+
+static const PageOption ROTATION_OPTIONS[] = {
+    { "0", "0° (Landscape)" },
+    { "1", "90° (Portrait)" },
+    { "2", "180° (Inverted Landscape)" },
+    { "3", "270° (Portrait Inverted)" },
+};
+
+// Indexed by OVERLAY_POS_*, OVERLAY_SIZE_*, OVERLAY_COLOR_*
+static const PageOption OVERLAY_POSITION_OPTIONS[] = {
+    { "0", "Top Left" },
+    { "1", "Top Right" },
+    { "2", "Bottom Left" },
+    { "3", "Bottom Right" },
+};
+
+static const PageOption OVERLAY_SIZE_OPTIONS[] = {
+    { "0", "Small" },
+    { "1", "Medium (Default)" },
+    { "2", "Large" },
+};
+
+static const PageOption OVERLAY_COLOR_OPTIONS[] = {
+    { "0", "Black (Default)" },
+    { "1", "Dark Gray" },
+    { "2", "Light Gray" },
+    { "3", "White" },
+};
+
+// Indexed by CHANGE_DETECTION_*
+static const PageOption CHANGE_DETECTION_OPTIONS[] = {
+    { "crc32", "CRC32 checksum file (image.png.crc32)" },
+    { "http", "HTTP ETag / Last-Modified (single request)" },
+};
+
+#define OPTION_COUNT(options) (sizeof(options) / sizeof(options[0]))
+
+// Context of a carousel row or hourly grid cell
+struct PageRow {
+    const ConfigPageContext* page;
+    uint8_t index;
+};
+
+static void writeOptions(TemplateWriter& out, const PageOption* options, size_t count, uint8_t selected) {
+    for (size_t i = 0; i < count; i++) {
+        out.write("<option value='");
+        out.write(options[i].value);
+        out.write(i == selected ? "' selected>" : "'>");
+        out.write(options[i].label);
+        out.write("</option>");
+    }
+}
+
+// value='...' when a value is stored, nothing otherwise (the placeholder shows)
+static void writeValueAttribute(TemplateWriter& out, bool stored, const char* value) {
+    if (stored) {
+        out.write(" value='");
+        out.writeEscaped(value);
+        out.write("'");
+    }
+}
+
+static bool wifiShown(const ConfigPageContext& page) {
+    return page.hasConfig || page.hasPartialConfig;
+}
+
+static bool writeHeadValue(void* context, TemplateWriter& out, const char* name, size_t length) {
+    const ConfigPageContext& page = *static_cast<const ConfigPageContext*>(context);
+    if (isTemplateName(name, length, "STYLES_URL")) {
+        out.write(PORTAL_STYLES_CSS_URL);
+    } else if (isTemplateName(name, length, "SUBTITLE")) {
+        if (!page.configMode) {
+            out.write("Step 1: Connect to WiFi");
+        } else if (page.hasConfig) {
+            out.write("Update your dashboard configuration");
+        } else {
+            out.write("Step 2: Configure your dashboard");
+        }
+    } else if (isTemplateName(name, length, "DEVICE_NAME")) {
+        out.writeEscaped(page.deviceName);
+    } else if (isTemplateName(name, length, "NETWORK_INFO")) {
+        out.write("<strong>IP:</strong> ");
+        out.writeEscaped(page.ipAddress);
+        out.write("<br>");
+        bool hasHostname = page.hostname != nullptr && page.hostname[0] != '\0';
+        if (hasHostname) {
+            out.write("<strong>Hostname:</strong> <a href='http://");
+            out.writeEscaped(page.hostname);
+            out.write("' target='_blank'>");
+            out.writeEscaped(page.hostname);
+            out.write(page.connected ? "</a><br>" : "</a>");
+        }
+        if (page.connected) {
+            if (page.channelLocked) {
+                out.write("<strong>WiFi Optimization:</strong> Active ✓<br>");
+                out.writef("<small>Channel %u, BSSID %02X:%02X:%02X:%02X:%02X:%02X</small>", page.channel,
+                           page.bssid[0], page.bssid[1], page.bssid[2], page.bssid[3], page.bssid[4], page.bssid[5]);
+            } else {
+                out.write("<strong>WiFi Optimization:</strong> Will activate on next power cycle");
+            }
+        }
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static bool writeNetworkValue(void* context, TemplateWriter& out, const char* name, size_t length) {
+    const ConfigPageContext& page = *static_cast<const ConfigPageContext*>(context);
+    const DashboardConfig& config = *page.config;
+    bool stored = wifiShown(page);
+    bool useStaticIP = stored && config.useStaticIP;
+    if (isTemplateName(name, length, "DHCP_CHECKED")) {
+        out.write(useStaticIP ? "" : " checked");
+    } else if (isTemplateName(name, length, "STATIC_CHECKED")) {
+        out.write(useStaticIP ? " checked" : "");
+    } else if (isTemplateName(name, length, "STATIC_FIELDS_STYLE")) {
+        out.write(useStaticIP ? "" : " style='display:none;'");
+    } else if (isTemplateName(name, length, "STATIC_IP")) {
+        out.writeEscaped(stored ? config.staticIP.c_str() : "");
+    } else if (isTemplateName(name, length, "GATEWAY")) {
+        out.writeEscaped(stored ? config.gateway.c_str() : "");
+    } else if (isTemplateName(name, length, "SUBNET")) {
+        out.writeEscaped(stored && !config.subnet.isEmpty() ? config.subnet.c_str() : "255.255.255.0");
+    } else if (isTemplateName(name, length, "DNS1")) {
+        out.writeEscaped(stored && !config.primaryDNS.isEmpty() ? config.primaryDNS.c_str() : "8.8.8.8");
+    } else if (isTemplateName(name, length, "DNS2")) {
+        out.writeEscaped(stored ? config.secondaryDNS.c_str() : "");
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static bool writeWiFiValue(void* context, TemplateWriter& out, const char* name, size_t length) {
+    const ConfigPageContext& page = *static_cast<const ConfigPageContext*>(context);
+    const DashboardConfig& config = *page.config;
+    bool stored = wifiShown(page);
+    bool passwordSet = stored && !config.wifiPassword.isEmpty();
+    if (isTemplateName(name, length, "SSID_VALUE")) {
+        writeValueAttribute(out, stored, config.wifiSSID.c_str());
+    } else if (isTemplateName(name, length, "PASSWORD_VALUE")) {
+        writeValueAttribute(out, passwordSet, config.wifiPassword.c_str());
+    } else if (isTemplateName(name, length, "PASSWORD_HINT")) {
+        if (passwordSet) {
+            out.write("<div class='help-text'>Password is set. Leave empty to keep current password.</div>");
+        }
+    } else if (isTemplateName(name, length, "FRIENDLY_NAME")) {
+        out.writeEscaped(stored ? config.friendlyName.c_str() : "");
+    } else if (isTemplateName(name, length, "FRIENDLY_NAME_HELP")) {
+        out.write(page.configMode ? CONFIG_PAGE_FRIENDLY_NAME_HELP_CONFIG : CONFIG_PAGE_FRIENDLY_NAME_HELP_BOOT);
+    } else if (isTemplateName(name, length, "NETWORK_SETTINGS")) {
+        if (page.configMode) {
+            renderTemplate(out, CONFIG_PAGE_NETWORK_TEMPLATE, writeNetworkValue, context);
+        }
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static bool writeImageSlotValue(void* context, TemplateWriter& out, const char* name, size_t length) {
+    const PageRow& row = *static_cast<const PageRow*>(context);
+    const DashboardConfig& config = *row.page->config;
+    bool existing = row.page->hasConfig && row.index < config.imageCount;
+    if (isTemplateName(name, length, "SLOT")) {
+        out.writef("%u", row.index);
+    } else if (isTemplateName(name, length, "SLOT_NUMBER")) {
+        out.writef("%u", row.index + 1);
+    } else if (isTemplateName(name, length, "SLOT_STYLE")) {
+        out.write(existing ? "" : " style='display:none;'");
+    } else if (isTemplateName(name, length, "URL")) {
+        out.writeEscaped(existing ? config.imageUrls[row.index].c_str() : "");
+    } else if (isTemplateName(name, length, "INTERVAL")) {
+        out.writef("%d", existing ? config.imageIntervals[row.index] : DEFAULT_INTERVAL_MINUTES);
+    } else if (isTemplateName(name, length, "STAY_CHECKED")) {
+        out.write(existing && config.imageStay[row.index] ? " checked" : "");
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static bool writeOptionalSettingValue(void* context, TemplateWriter& out, const char* name, size_t length) {
+    const ConfigPageContext& page = *static_cast<const ConfigPageContext*>(context);
+    const DashboardConfig& config = *page.config;
+    if (isTemplateName(name, length, "PARTIAL_REFRESH_CHECKED")) {
+        out.write(page.hasConfig && config.partialRefresh ? "checked " : "");
+    } else if (isTemplateName(name, length, "FULL_REFRESH_EVERY")) {
+        out.writef("%u", page.hasConfig ? config.fullRefreshEvery : DEFAULT_FULL_REFRESH_EVERY);
+    } else if (isTemplateName(name, length, "DEFAULT_FULL_REFRESH_EVERY")) {
+        out.writef("%u", DEFAULT_FULL_REFRESH_EVERY);
+    } else if (isTemplateName(name, length, "FRONTLIGHT_DURATION")) {
+        out.writef("%u", page.hasConfig ? config.frontlightDuration : 0);
+    } else if (isTemplateName(name, length, "FRONTLIGHT_BRIGHTNESS")) {
+        out.writef("%u", page.hasConfig ? config.frontlightBrightness : DEFAULT_FRONTLIGHT_BRIGHTNESS);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static bool writeImagesValue(void* context, TemplateWriter& out, const char* name, size_t length) {
+    const ConfigPageContext& page = *static_cast<const ConfigPageContext*>(context);
+    const DashboardConfig& config = *page.config;
+    uint8_t existingCount = page.hasConfig ? config.imageCount : 0;
+    if (isTemplateName(name, length, "IMAGE_SLOTS")) {
+        // First slot always shown, the others only when used (addImageSlot() reveals them)
+        for (uint8_t i = 0; i < MAX_IMAGE_SLOTS; i++) {
+            PageRow row = { &page, i };
+            renderTemplate(out, i == 0 ? CONFIG_PAGE_FIRST_IMAGE_SLOT_TEMPLATE : CONFIG_PAGE_IMAGE_SLOT_TEMPLATE,
+                           writeImageSlotValue, &row);
+        }
+    } else if (isTemplateName(name, length, "ADD_BUTTON_STYLE")) {
+        out.write(existingCount >= MAX_IMAGE_SLOTS ? " style='display:none;'" : "");
+    } else if (isTemplateName(name, length, "PREFETCH_COUNT")) {
+        out.writef("%u", page.hasConfig ? config.prefetchCount : DEFAULT_PREFETCH_COUNT);
+    } else if (isTemplateName(name, length, "PREFETCH_MAX")) {
+        out.writef("%u", PREFETCH_MAX_ENTRIES);
+    } else if (isTemplateName(name, length, "PREFETCH_MAX_HOURS")) {
+        out.writef("%u", PREFETCH_MAX_AGE_SECONDS / 3600);
+    } else if (isTemplateName(name, length, "TLS_FINGERPRINT")) {
+        out.writeEscaped(page.hasConfig ? config.tlsFingerprint.c_str() : "");
+    } else if (isTemplateName(name, length, "TIMEZONE")) {
+        out.writef("%d", page.hasConfig ? config.timezoneOffset : 0);
+    } else if (isTemplateName(name, length, "ROTATION_OPTIONS")) {
+        writeOptions(out, ROTATION_OPTIONS, OPTION_COUNT(ROTATION_OPTIONS), page.hasConfig ? config.screenRotation : DEFAULT_SCREEN_ROTATION);
+    } else if (isTemplateName(name, length, "PARTIAL_REFRESH")) {
+        if (page.partialRefreshAvailable) {
+            renderTemplate(out, CONFIG_PAGE_PARTIAL_REFRESH_TEMPLATE, writeOptionalSettingValue, context);
+        }
+    } else if (isTemplateName(name, length, "FRONTLIGHT")) {
+        if (page.frontlightAvailable) {
+            renderTemplate(out, CONFIG_PAGE_FRONTLIGHT_TEMPLATE, writeOptionalSettingValue, context);
+        }
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static bool writeOverlayValue(void* context, TemplateWriter& out, const char* name, size_t length) {
+    const ConfigPageContext& page = *static_cast<const ConfigPageContext*>(context);
+    const DashboardConfig& config = *page.config;
+    bool stored = page.hasConfig;
+    if (isTemplateName(name, length, "OVERLAY_ENABLED_CHECKED")) {
+        out.write(stored && config.overlayEnabled ? "checked " : "");
+    } else if (isTemplateName(name, length, "OVERLAY_POSITION_OPTIONS")) {
+        writeOptions(out, OVERLAY_POSITION_OPTIONS, OPTION_COUNT(OVERLAY_POSITION_OPTIONS),
+                     stored ? config.overlayPosition : OVERLAY_POS_TOP_RIGHT);
+    } else if (isTemplateName(name, length, "OVERLAY_SIZE_OPTIONS")) {
+        writeOptions(out, OVERLAY_SIZE_OPTIONS, OPTION_COUNT(OVERLAY_SIZE_OPTIONS),
+                     stored ? config.overlaySize : OVERLAY_SIZE_MEDIUM);
+    } else if (isTemplateName(name, length, "OVERLAY_COLOR_OPTIONS")) {
+        writeOptions(out, OVERLAY_COLOR_OPTIONS, OPTION_COUNT(OVERLAY_COLOR_OPTIONS),
+                     stored ? config.overlayTextColor : OVERLAY_COLOR_BLACK);
+    } else if (isTemplateName(name, length, "BATTERY_ICON_CHECKED")) {
+        out.write(!stored || config.overlayShowBatteryIcon ? "checked " : "");
+    } else if (isTemplateName(name, length, "BATTERY_PCT_CHECKED")) {
+        out.write(!stored || config.overlayShowBatteryPercentage ? "checked " : "");
+    } else if (isTemplateName(name, length, "UPDATE_TIME_CHECKED")) {
+        out.write(!stored || config.overlayShowUpdateTime ? "checked " : "");
+    } else if (isTemplateName(name, length, "CYCLE_TIME_CHECKED")) {
+        out.write(stored && config.overlayShowCycleTime ? "checked " : "");
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static bool writeMqttValue(void* context, TemplateWriter& out, const char* name, size_t length) {
+    const ConfigPageContext& page = *static_cast<const ConfigPageContext*>(context);
+    const DashboardConfig& config = *page.config;
+    bool passwordSet = page.hasConfig && !config.mqttPassword.isEmpty();
+    if (isTemplateName(name, length, "MQTT_BROKER_VALUE")) {
+        writeValueAttribute(out, page.hasConfig, config.mqttBroker.c_str());
+    } else if (isTemplateName(name, length, "MQTT_USER_VALUE")) {
+        writeValueAttribute(out, page.hasConfig, config.mqttUsername.c_str());
+    } else if (isTemplateName(name, length, "MQTT_PASSWORD_VALUE")) {
+        writeValueAttribute(out, passwordSet, config.mqttPassword.c_str());
+    } else if (isTemplateName(name, length, "MQTT_PASSWORD_HINT")) {
+        if (passwordSet) {
+            out.write("<div class='help-text'>Password is set. Leave empty to keep current password.</div>");
+        }
+    } else if (isTemplateName(name, length, "MQTT_BATCHED_CHECKED")) {
+        out.write(page.hasConfig && config.mqttBatchedState ? "checked " : "");
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static bool writeHourValue(void* context, TemplateWriter& out, const char* name, size_t length) {
+    const PageRow& row = *static_cast<const PageRow*>(context);
+    const DashboardConfig& config = *row.page->config;
+    if (isTemplateName(name, length, "HOUR")) {
+        out.writef("%u", row.index);
+    } else if (isTemplateName(name, length, "HOUR_LABEL")) {
+        out.writef("%02u", row.index);
+    } else if (isTemplateName(name, length, "NEXT_HOUR_LABEL")) {
+        out.writef("%02u", (row.index + 1) % 24);
+    } else if (isTemplateName(name, length, "HOUR_CHECKED")) {
+        // All hours enabled until a configuration is stored
+        bool enabled = !row.page->hasConfig || ((config.updateHours[row.index / 8] >> (row.index % 8)) & 1);
+        out.write(enabled ? " checked" : "");
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static bool writeMeasuredEnergyValue(void* context, TemplateWriter& out, const char* name, size_t length) {
+    const ConfigPageContext& page = *static_cast<const ConfigPageContext*>(context);
+    const EnergyStats& stats = *page.energyStats;
+    if (isTemplateName(name, length, "CYCLE_MAH_DATA")) {
+        out.writef("%.4f", (double)stats.avgCycleMah);
+    } else if (isTemplateName(name, length, "AWAKE_SEC_DATA")) {
+        out.writef("%.2f", (double)stats.avgAwakeSeconds);
+    } else if (isTemplateName(name, length, "SLEEP_MA_DATA")) {
+        out.writef("%.4f", (double)(page.powerProfile.sleepUa / 1000.0f));
+    } else if (isTemplateName(name, length, "CYCLE_MAH")) {
+        out.writef("%.3f", (double)stats.avgCycleMah);
+    } else if (isTemplateName(name, length, "AWAKE_SEC")) {
+        out.writef("%.1f", (double)stats.avgAwakeSeconds);
+    } else if (isTemplateName(name, length, "CYCLES")) {
+        out.writef("%u", (unsigned)stats.cycles);
+    } else if (isTemplateName(name, length, "SAVED_SETTINGS")) {
+        if (page.hasConfig) {
+            const DashboardConfig& config = *page.config;
+            float wakesPerDay = calculateWakesPerDay(config.imageIntervals, config.imageStay, config.imageCount,
+                                                     config.updateHours);
+            BatteryProjection projection = projectBatteryLife(page.powerProfile, stats.avgCycleMah,
+                                                              stats.avgAwakeSeconds, wakesPerDay, 100);
+            out.write("<div class='battery-detail-item'><span class='battery-detail-label'>Saved Settings (");
+            out.writef("%d", (int)page.powerProfile.batteryMah);
+            out.write(" mAh)</span><span class='battery-detail-value'>");
+            out.writef("%.0f", (double)projection.daysFullBattery);
+            out.write(" days</span></div>");
+        }
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static bool writeSchedulingValue(void* context, TemplateWriter& out, const char* name, size_t length) {
+    const ConfigPageContext& page = *static_cast<const ConfigPageContext*>(context);
+    const DashboardConfig& config = *page.config;
+    if (isTemplateName(name, length, "CRC32_CHECKED")) {
+        out.write(page.hasConfig && config.useCRC32Check ? " checked" : "");
+    } else if (isTemplateName(name, length, "CHANGE_DETECTION_OPTIONS")) {
+        writeOptions(out, CHANGE_DETECTION_OPTIONS, OPTION_COUNT(CHANGE_DETECTION_OPTIONS),
+                     page.hasConfig ? config.changeDetection : CHANGE_DETECTION_CRC32);
+    } else if (isTemplateName(name, length, "HOUR_GRID")) {
+        for (uint8_t hour = 0; hour < 24; hour++) {
+            PageRow row = { &page, hour };
+            renderTemplate(out, CONFIG_PAGE_HOUR_TEMPLATE, writeHourValue, &row);
+        }
+    } else if (isTemplateName(name, length, "BATTERY_ESTIMATOR")) {
+        out.write(CONFIG_PORTAL_BATTERY_ESTIMATOR_HTML);
+    } else if (isTemplateName(name, length, "MEASURED_ENERGY")) {
+        // Only once wakes were measured since the last cold boot
+        if (page.energyStats != nullptr && page.energyStats->cycles > 0) {
+            renderTemplate(out, CONFIG_PAGE_MEASURED_ENERGY_TEMPLATE, writeMeasuredEnergyValue, context);
+        }
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static bool writeFormEndValue(void* context, TemplateWriter& out, const char* name, size_t length) {
+    const ConfigPageContext& page = *static_cast<const ConfigPageContext*>(context);
+    if (isTemplateName(name, length, "SUBMIT_LABEL")) {
+        if (!page.configMode) {
+            out.write("➡️ Next: Configure Dashboard");
+        } else if (page.hasConfig) {
+            out.write("🔄 Update Configuration");
+        } else {
+            out.write("💾 Save Configuration");
+        }
+    } else if (isTemplateName(name, length, "DEVICE_ACTIONS")) {
+        if (page.configMode) {
+            out.write(CONFIG_PORTAL_FIRMWARE_UPDATE_BUTTON);
+            out.write(CONFIG_PORTAL_REBOOT_BUTTON);
+            out.write(CONFIG_PORTAL_DANGER_ZONE_START);
+            if (page.vcomAvailable) {
+                out.write(CONFIG_PORTAL_VCOM_BUTTON);
+            }
+            out.write(CONFIG_PORTAL_DANGER_ZONE_END);
+        }
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static bool writeVersionValue(void* context, TemplateWriter& out, const char* name, size_t length) {
+    const ConfigPageContext& page = *static_cast<const ConfigPageContext*>(context);
+    if (!isTemplateName(name, length, "VERSION")) {
+        return false;
+    }
+    out.writeEscaped(page.firmwareVersion);
+    return true;
+}
+
+static bool writeTailValue(void* context, TemplateWriter& out, const char* name, size_t length) {
+    const ConfigPageContext& page = *static_cast<const ConfigPageContext*>(context);
+    if (isTemplateName(name, length, "RESET_MODAL")) {
+        if (page.configMode) {
+            out.write(CONFIG_PORTAL_RESET_MODAL_HTML);
+        }
+    } else if (isTemplateName(name, length, "FOOTER")) {
+        renderTemplate(out, CONFIG_PORTAL_FOOTER_TEMPLATE, writeVersionValue, context);
+    } else if (isTemplateName(name, length, "MAIN_JS_URL")) {
+        out.write(PORTAL_MAIN_JS_URL);
+    } else if (isTemplateName(name, length, "BADGE")) {
+        if (page.configMode) {
+            out.write(CONFIG_PORTAL_BADGE_HTML);
+        }
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void renderConfigPage(TemplateWriter& out, const ConfigPageContext& page) {
+    void* context = const_cast<ConfigPageContext*>(&page);
+    out.write(CONFIG_PORTAL_PAGE_HEADER_START);
+    renderTemplate(out, CONFIG_PAGE_HEAD_TEMPLATE, writeHeadValue, context);
+    renderTemplate(out, CONFIG_PAGE_WIFI_TEMPLATE, writeWiFiValue, context);
+
+    // Step 1 (BOOT_MODE) only asks for WiFi
+    if (page.configMode) {
+        renderTemplate(out, CONFIG_PAGE_IMAGES_TEMPLATE, writeImagesValue, context);
+        renderTemplate(out, CONFIG_PAGE_OVERLAY_TEMPLATE, writeOverlayValue, context);
+        renderTemplate(out, CONFIG_PAGE_MQTT_TEMPLATE, writeMqttValue, context);
+        renderTemplate(out, CONFIG_PAGE_SCHEDULING_TEMPLATE, writeSchedulingValue, context);
+    }
+
+    renderTemplate(out, CONFIG_PAGE_FORM_END_TEMPLATE, writeFormEndValue, context);
+    renderTemplate(out, CONFIG_PAGE_TAIL_TEMPLATE, writeTailValue, context);
+}
@@ -0,0 +1,56 @@
+#ifndef CONFIG_PAGE_H
+#define CONFIG_PAGE_H
+
+#include <stdint.h>
+#include <dashboard_config.h>
+#include <energy_model.h>
+#include <page_template.h>
+
+#define CONFIG_PAGE_BUFFER_SIZE 1024  // Stack buffer handleRoot() streams the page through
+
+/**
+ * @brief Everything the configuration page shows
+ *
+ * Filled by ConfigPortal from the stored configuration, the WiFi state and
+ * the board; strings are only referenced, not copied.
+ */
+struct ConfigPageContext {
+    bool configMode;              // CONFIG_MODE (false = BOOT_MODE, step 1: WiFi only)
+    bool hasConfig;               // Complete configuration stored
+    bool hasPartialConfig;        // Only WiFi stored (step 2)
+    const DashboardConfig* config;
+
+    const char* deviceName;       // Access point name
+    const char* ipAddress;        // Station IP when connected, else the access point IP
+    const char* hostname;         // mDNS hostname ("" = none)
+    bool connected;               // Station mode (shows the WiFi channel lock)
+    bool channelLocked;
+    uint8_t channel;
+    uint8_t bssid[6];
+
+    bool partialRefreshAvailable; // Grayscale panel (not Inkplate 2)
+    bool frontlightAvailable;     // HAS_FRONTLIGHT
+    bool vcomAvailable;           // TPS65186 PMIC (not Inkplate 2)
+
+    const char* firmwareVersion;
+    const EnergyStats* energyStats;   // Measured wakes (nullptr = none)
+    PowerProfile powerProfile;
+};
+
+/**
+ * @brief Pure page rendering function
+ *
+ * This function contains NO dependencies on Arduino/ESP32 APIs,
+ * making it fully testable with standard C++ unit testing frameworks.
+ */
+
+/**
+ * @brief Stream the configuration page
+ *
+ * Renders the config_portal_html.h templates into the writer, section by
+ * section; no memory is allocated, the writer's buffer is the only storage.
+ * Stored values are HTML-escaped. The caller flushes the writer afterwards.
+ */
+void renderConfigPage(TemplateWriter& out, const ConfigPageContext& page);
+
+#endif // CONFIG_PAGE_H
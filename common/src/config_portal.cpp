@@ -1,17 +1,19 @@
 #include "config_portal.h"
-#include "config_portal_css.h"
+#include "config_portal_assets.h"
 #include "config_portal_html.h"
-#include "config_portal_js.h"
 #include "version.h"
 #include "config.h"
+#include "prefetch_cache.h"
 #include <src/logo_bitmap.h>
 #include <src/ui/screen.h>
 #include "logger.h"
 #include "github_ota.h"
+#include "tls_session_cache.h"
+#include "power_manager.h"
 
 ConfigPortal::ConfigPortal(ConfigManager* configManager, WiFiManager* wifiManager, DisplayManager* displayManager)
     : _configManager(configManager), _wifiManager(wifiManager), _displayManager(displayManager),
-      _server(nullptr), _configReceived(false), _port(80), _mode(CONFIG_MODE) {
+      _server(nullptr), _configReceived(false), _port(80), _mode(CONFIG_MODE), _energyStats(nullptr) {
 }
 
 ConfigPortal::~ConfigPortal() {
@@ -29,11 +31,18 @@ bool ConfigPortal::begin(PortalMode mode) {
     
     // Set up routes
     _server->on("/", [this]() { this->handleRoot(); });
-    _server->on("/styles.css", [this]() { this->handleCSS(); });
-    _server->on("/scripts/main.js", [this]() { this->handleMainJS(); });
-    _server->on("/scripts/ota.js", [this]() { this->handleOTAJS(); });
-    _server->on("/scripts/ota-status.js", [this]() { this->handleOTAStatusJS(); });
+    for (size_t i = 0; i < PORTAL_ASSET_COUNT; i++) {
+        const PortalAsset* asset = &PORTAL_ASSETS[i];
+        _server->on(asset->path, HTTP_GET, [this, asset]() { this->handleAsset(*asset); });
+    }
+    // Only request headers listed here are kept for handlers
+    static const char* collectedHeaders[] = {"If-None-Match"};
+    _server->collectHeaders(collectedHeaders, 1);
     _server->on("/submit", HTTP_POST, [this]() { this->handleSubmit(); });
+    // JSON API for scripted provisioning (both modes: new panels are set up over the AP)
+    _server->on("/api/config", HTTP_GET, [this]() { this->handleApiConfigGet(); });
+    _server->on("/api/config", HTTP_PUT, [this]() { this->handleApiConfigPut(); });
+    _server->on("/api/status", HTTP_GET, [this]() { this->handleApiStatus(); });
     _server->on("/factory-reset", HTTP_POST, [this]() { this->handleFactoryReset(); });
     _server->on("/reboot", HTTP_POST, [this]() { this->handleReboot(); });
     #ifndef DISPLAY_MODE_INKPLATE2
@@ -139,53 +148,44 @@ int ConfigPortal::getPort() {
     return _port;
 }
 
-void ConfigPortal::sendChunk(const String& chunk) {
-    if (_server != nullptr) {
-        _server->sendContent(chunk);
-    }
+void ConfigPortal::setEnergyStats(const EnergyStats* stats) {
+    _energyStats = stats;
+}
+
+static void sendPageContent(void* context, const char* data, size_t length) {
+    static_cast<WebServer*>(context)->sendContent(data, length);
 }
 
 void ConfigPortal::handleRoot() {
     Logger::message("Web Request", "Serving configuration page");
     
-    // Use chunked transfer to reduce memory pressure
+    // Use chunked transfer: the page is streamed through one stack buffer
     _server->sendHeader("Connection", "close");
     _server->setContentLength(CONTENT_LENGTH_UNKNOWN);
     _server->send(200, "text/html", "");
     
-    generateConfigPage();
+    char buffer[CONFIG_PAGE_BUFFER_SIZE];
+    TemplateWriter out(buffer, sizeof(buffer), sendPageContent, _server);
+    generateConfigPage(out);
+    out.flush();
     
     _server->sendContent("");  // End chunked transfer
 }
 
-void ConfigPortal::handleCSS() {
-    Logger::message("Web Request", "Serving CSS stylesheet");
-    _server->sendHeader("Connection", "close");
-    _server->send(200, "text/css", CONFIG_PORTAL_CSS);
-}
-
-void ConfigPortal::handleMainJS() {
-    String js;
-    js.reserve(20000);  // Reserve 20KB for combined scripts
-    js = CONFIG_PORTAL_MODAL_SCRIPT;
-    js += "\n";
-    js += CONFIG_PORTAL_FRIENDLY_NAME_SCRIPT;
-    js += "\n";
-    js += CONFIG_PORTAL_BATTERY_CALC_SCRIPT;
-    js += "\n";
-    js += CONFIG_PORTAL_BADGE_SCRIPT;
-    _server->sendHeader("Connection", "close");
-    _server->send(200, "application/javascript", js);
-}
-
-void ConfigPortal::handleOTAJS() {
+void ConfigPortal::handleAsset(const PortalAsset& asset) {
+    // Stylesheet and scripts are stored minified and gzipped (config_portal_assets.h):
+    // sent straight from flash, no heap copy. Pages link them as ?v=<etag>, so a
+    // browser keeps them across portal sessions and only revalidates old links.
+    _server->sendHeader("Cache-Control", PORTAL_ASSET_CACHE_CONTROL);
+    _server->sendHeader("ETag", asset.etag);
     _server->sendHeader("Connection", "close");
-    _server->send(200, "application/javascript", CONFIG_PORTAL_OTA_SCRIPT);
-}
-
-void ConfigPortal::handleOTAStatusJS() {
-    _server->sendHeader("Connection", "close");
-    _server->send(200, "application/javascript", CONFIG_PORTAL_OTA_STATUS_SCRIPT);
+    if (portalETagMatches(_server->header("If-None-Match").c_str(), asset.etag)) {
+        _server->send(304);
+        return;
+    }
+    Logger::messagef("Web Request", "Serving %s (%u bytes gzipped)", asset.path, (unsigned)asset.length);
+    _server->sendHeader("Content-Encoding", "gzip");
+    _server->send_P(200, asset.contentType, (const char*)asset.data, asset.length);
 }
 
 void ConfigPortal::handleSubmit() {
@@ -198,9 +198,13 @@ void ConfigPortal::handleSubmit() {
     String mqttBroker = _server->arg("mqttbroker");
     String mqttUser = _server->arg("mqttuser");
     String mqttPass = _server->arg("mqttpass");
+    bool mqttBatched = _server->hasArg("mqttbatched") && _server->arg("mqttbatched") == "on";
     String timezoneStr = _server->arg("timezone");
     String rotationStr = _server->arg("rotation");
     bool useCRC32Check = _server->hasArg("crc32check") && _server->arg("crc32check") == "on";
+    uint8_t changeDetection = (_server->arg("change_detection") == "http") ? CHANGE_DETECTION_HTTP : CHANGE_DETECTION_CRC32;
+    String tlsFingerprint = _server->arg("tls_fp");
+    tlsFingerprint.trim();
     
     // Parse static IP configuration
     String ipMode = _server->arg("ip_mode");
@@ -235,7 +239,7 @@ void ConfigPortal::handleSubmit() {
         
         if (url.length() > 0) {
             // Validate URL
-            if (!url.startsWith("http://") && !url.startsWith("https://")) {
+            if (!isValidImageUrl(url.c_str())) {
                 String errorMsg = "Image " + String(i + 1) + " URL must start with http:// or https://";
                 _server->send(400, "text/html", generateErrorPage(errorMsg));
                 return;
@@ -262,6 +266,16 @@ void ConfigPortal::handleSubmit() {
         }
     }
     
+    // Parse carousel prefetch depth
+    uint8_t prefetchCount = DEFAULT_PREFETCH_COUNT;
+    if (_server->hasArg("prefetch_count")) {
+        int prefetchCountValue = _server->arg("prefetch_count").toInt();
+        if (prefetchCountValue < 0 || prefetchCountValue > PREFETCH_MAX_ENTRIES) {
+            prefetchCountValue = DEFAULT_PREFETCH_COUNT;  // Default on invalid input
+        }
+        prefetchCount = prefetchCountValue;
+    }
+    
     // Parse timezone offset
     int timezoneOffset = timezoneStr.toInt();
     if (timezoneOffset < -12 || timezoneOffset > 14) {
@@ -274,6 +288,20 @@ void ConfigPortal::handleSubmit() {
         screenRotation = 0;  // Default to 0° on invalid input
     }
     
+    // Parse partial refresh configuration (not available on Inkplate 2)
+    bool partialRefresh = false;
+    uint8_t fullRefreshEvery = DEFAULT_FULL_REFRESH_EVERY;
+    #ifndef DISPLAY_MODE_INKPLATE2
+    partialRefresh = _server->hasArg("partial_refresh") && _server->arg("partial_refresh") == "on";
+    if (_server->hasArg("full_refresh_every")) {
+        int fullRefreshEveryValue = _server->arg("full_refresh_every").toInt();
+        if (fullRefreshEveryValue < 0 || fullRefreshEveryValue > 100) {
+            fullRefreshEveryValue = DEFAULT_FULL_REFRESH_EVERY;  // Default on invalid input
+        }
+        fullRefreshEvery = fullRefreshEveryValue;
+    }
+    #endif
+    
     // Parse frontlight configuration (only for boards with HAS_FRONTLIGHT)
     uint8_t frontlightDuration = 0;
     uint8_t frontlightBrightness = 63;
@@ -375,6 +403,30 @@ void ConfigPortal::handleSubmit() {
         }
     }
     
+    // Validate and normalize the certificate fingerprint (stored as "AB:CD:...")
+    if (_mode == CONFIG_MODE && tlsFingerprint.length() > 0) {
+        uint8_t fingerprint[TLS_FINGERPRINT_SIZE];
+        if (!parseCertFingerprint(tlsFingerprint.c_str(), fingerprint)) {
+            _server->send(400, "text/html", generateErrorPage("Invalid certificate fingerprint: expected SHA-256 as 64 hex digits (e.g. AB:CD:...)"));
+            return;
+        }
+        char normalized[TLS_FINGERPRINT_TEXT_SIZE];
+        formatCertFingerprint(fingerprint, normalized);
+        tlsFingerprint = normalized;
+    }
+    
+    // Values must fit the stored configuration (and the fixed-size DashboardConfig strings)
+    if (ssid.length() > MAX_SSID_LENGTH || password.length() > MAX_WIFI_PASSWORD_LENGTH ||
+        friendlyName.length() > MAX_FRIENDLY_NAME_LENGTH) {
+        _server->send(400, "text/html", generateErrorPage("WiFi network name, password or device name too long"));
+        return;
+    }
+    if (mqttBroker.length() > MAX_MQTT_BROKER_LENGTH || mqttUser.length() > MAX_MQTT_USERNAME_LENGTH ||
+        mqttPass.length() > MAX_MQTT_PASSWORD_LENGTH) {
+        _server->send(400, "text/html", generateErrorPage("MQTT broker, username or password too long"));
+        return;
+    }
+    
     // In CONFIG_MODE, at least one image is required; in BOOT_MODE it's optional
     if (_mode == CONFIG_MODE && imageCount == 0) {
         _server->send(400, "text/html", generateErrorPage("At least one image URL is required"));
@@ -396,18 +448,23 @@ void ConfigPortal::handleSubmit() {
         return;
     }
     
-    // In CONFIG_MODE, save all configuration
-    DashboardConfig config;
+    // In CONFIG_MODE, save all configuration (filled in where the configuration is kept, no copy)
+    DashboardConfig& config = _configManager->editConfig();
     config.wifiSSID = ssid;
     config.friendlyName = friendlyName;  // Save original input (with spaces, capitals, etc)
     config.mqttBroker = mqttBroker;
     config.mqttUsername = mqttUser;
+    config.mqttBatchedState = mqttBatched;
     config.useCRC32Check = useCRC32Check;
+    config.changeDetection = changeDetection;
+    config.tlsFingerprint = tlsFingerprint;
     config.updateHours[0] = updateHours[0];
     config.updateHours[1] = updateHours[1];
     config.updateHours[2] = updateHours[2];
     config.timezoneOffset = timezoneOffset;
     config.screenRotation = screenRotation;
+    config.partialRefresh = partialRefresh;
+    config.fullRefreshEvery = fullRefreshEvery;
     
     // Save static IP configuration
     config.useStaticIP = useStaticIP;
@@ -424,6 +481,7 @@ void ConfigPortal::handleSubmit() {
         config.imageIntervals[i] = imageIntervals[i];
         config.imageStay[i] = imageStay[i];
     }
+    config.prefetchCount = prefetchCount;
     
     // Save frontlight configuration
     config.frontlightDuration = frontlightDuration;
@@ -466,6 +524,118 @@ void ConfigPortal::handleSubmit() {
     }
 }
 
+void ConfigPortal::beginJsonResponse(int code) {
+    _server->sendHeader("Cache-Control", "no-store");
+    _server->sendHeader("Connection", "close");
+    _server->setContentLength(CONTENT_LENGTH_UNKNOWN);
+    _server->send(code, "application/json", "");
+}
+
+void ConfigPortal::sendJsonError(int code, const char* message) {
+    beginJsonResponse(code);
+    char buffer[CONFIG_JSON_ERROR_SIZE * 2];
+    TemplateWriter out(buffer, sizeof(buffer), sendPageContent, _server);
+    writeJsonError(out, message);
+    out.flush();
+    _server->sendContent("");
+}
+
+void ConfigPortal::handleApiConfigGet() {
+    Logger::message("Web Request", "GET /api/config");
+    
+    beginJsonResponse(200);
+    char buffer[CONFIG_PAGE_BUFFER_SIZE];
+    TemplateWriter out(buffer, sizeof(buffer), sendPageContent, _server);
+    writeConfigJson(out, _configManager->getConfig());
+    out.flush();
+    _server->sendContent("");
+}
+
+void ConfigPortal::handleApiConfigPut() {
+    // WebServer keeps a request body that is not a form as the "plain" argument
+    const String& body = _server->arg("plain");
+    Logger::messagef("Web Request", "PUT /api/config (%u bytes)", body.length());
+    
+    // Setup over the access point is open, like the form; on the network a token is needed
+    if (_mode == CONFIG_MODE) {
+        String token = _configManager->getApiToken();
+        if (token.length() == 0) {
+            sendJsonError(403, "API writes are off: set api_token during WiFi setup");
+            return;
+        }
+        // WebServer always collects the Authorization header
+        if (!isApiRequestAuthorized(_server->header("Authorization").c_str(), token.c_str())) {
+            Logger::message("Config Error", "Rejected: missing or wrong API token");
+            _server->sendHeader("WWW-Authenticate", "Bearer");
+            sendJsonError(401, "Missing or wrong API token");
+            return;
+        }
+    }
+    
+    if (body.length() == 0) {
+        sendJsonError(400, "Request body must be a JSON object");
+        return;
+    }
+    if (body.length() > CONFIG_JSON_MAX_BODY) {
+        sendJsonError(413, "Request body too large");
+        return;
+    }
+    
+    // Applied on top of the stored configuration: a document may carry only the changes
+    char error[CONFIG_JSON_ERROR_SIZE];
+    ApiTokenUpdate apiToken;
+    DashboardConfig& config = _configManager->editConfig();
+    if (!parseConfigJson(body.c_str(), body.length(), config, error, sizeof(error), &apiToken) ||
+        !validateConfigJson(config, error, sizeof(error))) {
+        _configManager->getConfig();  // Drop the partly applied document
+        Logger::messagef("Config Error", "Rejected: %s", error);
+        sendJsonError(400, error);
+        return;
+    }
+    
+    if (!_configManager->saveConfig(config) ||
+        (apiToken.present && !_configManager->setApiToken(apiToken.value.c_str()))) {
+        Logger::message("Config Error", "Failed to save configuration");
+        sendJsonError(500, "Failed to save configuration");
+        return;
+    }
+    
+    Logger::message("Config Saved", apiToken.present ? "Configuration and API token saved through the API"
+                                                     : "Configuration saved through the API");
+    _server->sendHeader("Connection", "close");
+    _server->send(200, "application/json", "{\"saved\":true,\"restarting\":true}");
+    _configReceived = true;  // Device restarts with the new configuration
+}
+
+void ConfigPortal::handleApiStatus() {
+    // The status only references these, they live until it is written
+    String deviceId = _wifiManager->getDeviceIdentifier();
+    String hostname = _wifiManager->getMDNSHostname();
+    
+    DeviceStatus status = {};
+    status.connected = _wifiManager->isConnected();
+    String ip = status.connected ? _wifiManager->getLocalIP() : _wifiManager->getAPIPAddress();
+    status.firmwareVersion = FIRMWARE_VERSION;
+    status.board = BOARD_NAME;
+    status.mode = _mode == CONFIG_MODE ? "config" : "boot";
+    status.configured = _configManager->isConfigured();
+    status.apiTokenSet = _configManager->getApiToken().length() > 0;
+    status.deviceId = deviceId.c_str();
+    status.ipAddress = ip.c_str();
+    status.hostname = hostname.c_str();
+    status.rssi = status.connected ? _wifiManager->getRSSI() : 0;
+    status.uptimeSeconds = millis() / 1000;
+    status.freeHeap = ESP.getFreeHeap();
+    status.energyStats = _energyStats;
+    
+    beginJsonResponse(200);
+    char buffer[CONFIG_PAGE_BUFFER_SIZE];
+    TemplateWriter out(buffer, sizeof(buffer), sendPageContent, _server);
+    writeStatusJson(out, status);
+    out.flush();
+    _server->sendContent("");
+}
+
 void ConfigPortal::handleFactoryReset() {
     Logger::message("Factory Reset", "Factory reset requested");
     
@@ -513,597 +683,55 @@ void ConfigPortal::handleNotFound() {
 }
 
 bool ConfigPortal::validateIPv4Format(const String& ip) {
-    // Simple IPv4 validation: check format and range
-    if (ip.length() == 0) {
-        return false;
-    }
-    
-    int octets[4];
-    int octetIndex = 0;
-    String currentOctet = "";
-    
-    for (unsigned int i = 0; i < ip.length(); i++) {
-        char c = ip.charAt(i);
-        
-        if (c == '.') {
-            if (currentOctet.length() == 0 || octetIndex >= 3) {
-                return false;
-            }
-            octets[octetIndex++] = currentOctet.toInt();
-            currentOctet = "";
-        } else if (c >= '0' && c <= '9') {
-            currentOctet += c;
-        } else {
-            return false;
-        }
-    }
-    
-    // Parse last octet
-    if (currentOctet.length() == 0 || octetIndex != 3) {
-        return false;
-    }
-    octets[octetIndex] = currentOctet.toInt();
-    
-    // Validate ranges (0-255)
-    for (int i = 0; i < 4; i++) {
-        if (octets[i] < 0 || octets[i] > 255) {
-            return false;
-        }
-    }
-    
-    return true;
+    return isValidIPv4Address(ip.c_str());
 }
 
-void ConfigPortal::generateConfigPage() {
+void ConfigPortal::generateConfigPage(TemplateWriter& out) {
     // Load current configuration if available
-    DashboardConfig currentConfig;
-    bool hasConfig = _configManager->isConfigured() && _configManager->loadConfig(currentConfig);
+    bool hasConfig = _configManager->isConfigured() && _configManager->loadConfig();
     
+    ConfigPageContext page = {};
+    page.configMode = _mode == CONFIG_MODE;
+    page.hasConfig = hasConfig;
     // Also check for partial config (WiFi but no Image URL) - for Step 2
-    bool hasPartialConfig = false;
-    if (!hasConfig && _configManager->hasWiFiConfig()) {
-        currentConfig.wifiSSID = _configManager->getWiFiSSID();
-        currentConfig.wifiPassword = _configManager->getWiFiPassword();
-        currentConfig.friendlyName = _configManager->getFriendlyName();  // Load friendly name if set in Step 1
-        hasPartialConfig = true;
+    // (the stored WiFi credentials and friendly name from Step 1 are in the config)
+    page.hasPartialConfig = !hasConfig && _configManager->hasWiFiConfig();
+    page.config = &_configManager->getConfig();
+    
+    // The page only references these, they live until it is rendered
+    String apName = _wifiManager->getAPName();
+    String hostname = _wifiManager->getMDNSHostname();
+    page.connected = _wifiManager->isConnected();
+    String ip = page.connected ? _wifiManager->getLocalIP() : _wifiManager->getAPIPAddress();
+    page.deviceName = apName.c_str();
+    page.ipAddress = ip.c_str();
+    page.hostname = hostname.c_str();
+    if (page.connected && _configManager->hasWiFiChannelLock()) {
+        page.channelLocked = true;
+        page.channel = _configManager->getWiFiChannel();
+        _configManager->getWiFiBSSID(page.bssid);
     }
     
-    // Use chunked sending to reduce peak memory from 36KB to ~4KB
-    String chunk;
-    chunk.reserve(4096);  // 4KB chunks
-    
-    chunk = CONFIG_PORTAL_PAGE_HEADER_START;
-    chunk += "<title>Inkplate Dashboard Setup</title>";
-    chunk += "<link rel='stylesheet' href='/styles.css'>";
-    chunk += "</head><body>";
-    chunk += "<div class='container'>";
-    chunk += "<h1>📊 Inkplate Dashboard</h1>";
-    
-    // Different subtitle based on mode
-    if (_mode == BOOT_MODE) {
-        chunk += "<p class='subtitle'>Step 1: Connect to WiFi</p>";
-    } else if (hasConfig) {
-        chunk += "<p class='subtitle'>Update your dashboard configuration</p>";
-    } else {
-        chunk += "<p class='subtitle'>Step 2: Configure your dashboard</p>";
-    }
-    
-    chunk += "<div class='device-info'>";
-    chunk += "<strong>Device:</strong> " + _wifiManager->getAPName() + "<br>";
-    
-    // Show appropriate IP address and mDNS hostname
-    if (_wifiManager->isConnected()) {
-        String mdnsHostname = _wifiManager->getMDNSHostname();
-        chunk += "<strong>IP:</strong> " + _wifiManager->getLocalIP() + "<br>";
-        
-        // Show mDNS hostname if available
-        if (mdnsHostname.length() > 0) {
-            chunk += "<strong>Hostname:</strong> <a href='http://" + mdnsHostname + "' target='_blank'>" + mdnsHostname + "</a><br>";
-        }
-        
-        // Show WiFi optimization info
-        if (_configManager->hasWiFiChannelLock()) {
-            uint8_t channel = _configManager->getWiFiChannel();
-            uint8_t bssid[6];
-            _configManager->getWiFiBSSID(bssid);
-            char bssidStr[18];
-            snprintf(bssidStr, sizeof(bssidStr), "%02X:%02X:%02X:%02X:%02X:%02X",
-                    bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5]);
-            chunk += "<strong>WiFi Optimization:</strong> Active ✓<br>";
-            chunk += "<small>Channel " + String(channel) + ", BSSID " + String(bssidStr) + "</small>";
-        } else {
-            chunk += "<strong>WiFi Optimization:</strong> Will activate on next power cycle";
-        }
-    } else {
-        String mdnsHostname = _wifiManager->getMDNSHostname();
-        chunk += "<strong>IP:</strong> " + _wifiManager->getAPIPAddress() + "<br>";
-        
-        // Show mDNS hostname if available
-        if (mdnsHostname.length() > 0) {
-            chunk += "<strong>Hostname:</strong> <a href='http://" + mdnsHostname + "' target='_blank'>" + mdnsHostname + "</a>";
-        }
-    }
-    chunk += "</div>";
-    
-    chunk += "<form action='/submit' method='POST'>";
-    sendChunk(chunk);  // Send header chunk
-    
-    // WiFi Network Section
-    chunk = "";  // Clear for next section
-    chunk += SECTION_START("📶", "WiFi Network");
-    
-    // WiFi SSID - always shown
-    chunk += "<div class='form-group'>";
-    chunk += "<label for='ssid'>WiFi Network Name (SSID) *</label>";
-    if (hasConfig || hasPartialConfig) {
-        chunk += "<input type='text' id='ssid' name='ssid' required placeholder='Enter your WiFi network name' value='" + currentConfig.wifiSSID + "'>";
-    } else {
-        chunk += "<input type='text' id='ssid' name='ssid' required placeholder='Enter your WiFi network name'>";
-    }
-    chunk += "</div>";
-    
-    // WiFi Password - always shown
-    chunk += "<div class='form-group'>";
-    chunk += "<label for='password'>WiFi Password</label>";
-    if ((hasConfig || hasPartialConfig) && currentConfig.wifiPassword.length() > 0) {
-        chunk += "<input type='password' id='password' name='password' placeholder='Enter WiFi password (leave empty if none)' value='" + currentConfig.wifiPassword + "'>";
-        chunk += "<div class='help-text'>Password is set. Leave empty to keep current password.</div>";
-    } else {
-        chunk += "<input type='password' id='password' name='password' placeholder='Enter WiFi password (leave empty if none)'>";
-    }
-    chunk += "</div>";
-    
-    // Friendly Name (Device Name) - optional, shown in both modes
-    chunk += "<div class='form-group'>";
-    chunk += "<label for='friendlyname'>Device Name (optional)</label>";
-    String currentFriendlyName = (hasConfig || hasPartialConfig) ? currentConfig.friendlyName : "";
-    chunk += "<input type='text' id='friendlyname' name='friendlyname' placeholder='e.g., Living Room' value='" + currentFriendlyName + "' maxlength='24' oninput='sanitizeFriendlyNamePreview()'>";
-    chunk += "<div id='friendlyname-preview' style='font-size: 13px; margin-top: 5px; color: #666;'></div>";
-    chunk += "<div class='help-text'>";
-    if (_mode == BOOT_MODE) {
-        chunk += "Set a friendly name now to access Step 2 via <code>yourname.local</code> (instead of IP address). ";
-        chunk += "Rules: lowercase letters (a-z), digits (0-9), hyphens (-), max 24 characters. ";
-        chunk += "Leave empty to use MAC-based ID.";
-    } else {
-        chunk += "Optional user-friendly name for MQTT topics, Home Assistant, and network hostname (e.g., <code>kitchen.local</code>). ";
-        chunk += "Rules: lowercase letters (a-z), digits (0-9), hyphens (-), max 24 characters. ";
-        chunk += "No leading/trailing hyphens. Leave empty to use MAC-based ID. ";
-        chunk += "<strong>⚠️ Changing this creates a new device in Home Assistant</strong> (old entities will stop updating).";
-    }
-    chunk += "</div>";
-    chunk += "</div>";
-    
-    // IP config only shown in CONFIG_MODE
-    if (_mode == CONFIG_MODE) {
-        // Network Settings (Static IP)
-        chunk += "<div class='form-group' style='margin-top: 20px; padding-top: 20px; border-top: 1px solid #e0e0e0;'>";
-        chunk += "<label style='font-weight: bold; display: block; margin-bottom: 10px;'>🌐 Network Configuration</label>";
-        chunk += "<div class='help-text' style='margin-bottom: 15px;'>Choose between automatic IP assignment (DHCP) or manual static IP configuration. Static IP can reduce wake time by 0.5-2 seconds per cycle.</div>";
-        
-        bool useStaticIP = (hasConfig || hasPartialConfig) && currentConfig.useStaticIP;
-    
-    chunk += "<div style='margin-bottom: 15px;'>";
-    chunk += "<label style='display: flex; align-items: center; gap: 8px; margin-bottom: 8px;'>";
-    chunk += "<input type='radio' name='ip_mode' value='dhcp' id='ip_mode_dhcp'" + String(!useStaticIP ? " checked" : "") + " onchange='toggleStaticIPFields()'>";
-    chunk += "<span>DHCP (Automatic) - Default</span>";
-    chunk += "</label>";
-    chunk += "<label style='display: flex; align-items: center; gap: 8px;'>";
-    chunk += "<input type='radio' name='ip_mode' value='static' id='ip_mode_static'" + String(useStaticIP ? " checked" : "") + " onchange='toggleStaticIPFields()'>";
-    chunk += "<span>Static IP (Manual)</span>";
-    chunk += "</label>";
-    chunk += "</div>";
-    
-    // Static IP fields container
-    String staticDisplay = useStaticIP ? "" : " style='display:none;'";
-    chunk += "<div id='static_ip_fields'" + staticDisplay + ">";
-    
-    // Static IP Address
-    chunk += "<div class='form-group'>";
-    chunk += "<label for='static_ip'>IP Address *</label>";
-    String staticIPValue = (hasConfig || hasPartialConfig) ? currentConfig.staticIP : "";
-    chunk += "<input type='text' id='static_ip' name='static_ip' placeholder='e.g., 192.168.1.100' value='" + staticIPValue + "' pattern='^(\\d{1,3}\\.){3}\\d{1,3}$'>";
-    chunk += "<div class='help-text'>Enter the static IP address for this device</div>";
-    chunk += "</div>";
-    
-    // Gateway
-    chunk += "<div class='form-group'>";
-    chunk += "<label for='gateway'>Gateway *</label>";
-    String gatewayValue = (hasConfig || hasPartialConfig) ? currentConfig.gateway : "";
-    chunk += "<input type='text' id='gateway' name='gateway' placeholder='e.g., 192.168.1.1' value='" + gatewayValue + "' pattern='^(\\d{1,3}\\.){3}\\d{1,3}$'>";
-    chunk += "<div class='help-text'>Usually your router's IP address</div>";
-    chunk += "</div>";
-    
-    // Subnet Mask
-    chunk += "<div class='form-group'>";
-    chunk += "<label for='subnet'>Subnet Mask *</label>";
-    String subnetValue = (hasConfig || hasPartialConfig) && currentConfig.subnet.length() > 0 ? currentConfig.subnet : "255.255.255.0";
-    chunk += "<input type='text' id='subnet' name='subnet' placeholder='e.g., 255.255.255.0' value='" + subnetValue + "' pattern='^(\\d{1,3}\\.){3}\\d{1,3}$'>";
-    chunk += "<div class='help-text'>Typically 255.255.255.0 for home networks</div>";
-    chunk += "</div>";
-    
-    // Primary DNS
-    chunk += "<div class='form-group'>";
-    chunk += "<label for='dns1'>Primary DNS *</label>";
-    String dns1Value = (hasConfig || hasPartialConfig) && currentConfig.primaryDNS.length() > 0 ? currentConfig.primaryDNS : "8.8.8.8";
-    chunk += "<input type='text' id='dns1' name='dns1' placeholder='e.g., 8.8.8.8' value='" + dns1Value + "' pattern='^(\\d{1,3}\\.){3}\\d{1,3}$'>";
-    chunk += "<div class='help-text'>Google DNS (8.8.8.8) or Cloudflare (1.1.1.1)</div>";
-    chunk += "</div>";
-    
-    // Secondary DNS (optional)
-    chunk += "<div class='form-group'>";
-    chunk += "<label for='dns2'>Secondary DNS (Optional)</label>";
-    String dns2Value = (hasConfig || hasPartialConfig) ? currentConfig.secondaryDNS : "";
-    chunk += "<input type='text' id='dns2' name='dns2' placeholder='e.g., 8.8.4.4' value='" + dns2Value + "' pattern='^(\\d{1,3}\\.){3}\\d{1,3}$'>";
-    chunk += "<div class='help-text'>Backup DNS server (optional)</div>";
-    chunk += "</div>";
-    
-        chunk += "</div>"; // End static_ip_fields
-        chunk += "</div>"; // End form-group
-    } // End CONFIG_MODE check for friendly name and IP config
-    
-    chunk += SECTION_END();
-    sendChunk(chunk);  // Send WiFi section
-    
-    // Dashboard Image Section - only shown in CONFIG_MODE
-    if (_mode == CONFIG_MODE) {
-        chunk = "";  // Clear for images section
-        chunk += SECTION_START("🖼️", "Dashboard Images");
-        chunk += "<div class='help-text' style='margin-bottom: 15px;'>Fill 1 image for single image mode, or 2+ for automatic carousel rotation. Supported formats: PNG or JPEG (baseline encoding only, not progressive). Image must match your screen resolution.</div>";
-        
-        // Get existing image configuration if available
-        uint8_t existingCount = hasConfig ? currentConfig.imageCount : 0;
-        
-        // Always show first image slot
-        for (uint8_t i = 0; i < 1; i++) {
-            String imageNum = String(i + 1);
-            bool hasExisting = (i < existingCount);
-            String existingUrl = hasExisting ? currentConfig.imageUrls[i] : "";
-            int existingInterval = hasExisting ? currentConfig.imageIntervals[i] : DEFAULT_INTERVAL_MINUTES;
-            bool existingStay = hasExisting ? currentConfig.imageStay[i] : false;
-            
-            chunk += "<div class='image-slot' id='slot_" + String(i) + "'>";
-            chunk += "<label>Image " + imageNum + " URL *</label>";
-            chunk += "<input type='text' name='img_url_" + String(i) + "' placeholder='https://example.com/image" + imageNum + ".png' value='" + existingUrl + "' required>";
-            chunk += "<label>Display for (minutes) *</label>";
-            chunk += "<input type='number' name='img_int_" + String(i) + "' min='0' placeholder='5' value='" + String(existingInterval) + "' required>";
-            chunk += "<div class='help-text'>Set to 0 for button-only mode (no automatic refresh - wake by button press only)</div>";
-            chunk += "<label style='display: flex; align-items: center; gap: 10px; margin-top: 10px;'>";
-            chunk += "<input type='checkbox' name='img_stay_" + String(i) + "'";
-            if (existingStay) chunk += " checked";
-            chunk += ">";
-            chunk += "Stay on this image (advance on button press)";
-            chunk += "</label>";
-            chunk += "</div>";
-        }
-        
-        // Add remaining slots (2-10) if they have data
-        for (uint8_t i = 1; i < MAX_IMAGE_SLOTS; i++) {
-            bool hasExisting = (i < existingCount);
-            String existingUrl = hasExisting ? currentConfig.imageUrls[i] : "";
-            int existingInterval = hasExisting ? currentConfig.imageIntervals[i] : DEFAULT_INTERVAL_MINUTES;
-            bool existingStay = hasExisting ? currentConfig.imageStay[i] : false;
-            String displayStyle = hasExisting ? "" : " style='display:none;'";
-            
-            chunk += "<div class='image-slot' id='slot_" + String(i) + "'" + displayStyle + ">";
-            chunk += "<div style='display: flex; justify-content: space-between; align-items: center;'>";
-            chunk += "<label>Image " + String(i + 1) + " URL</label>";
-            chunk += "<button type='button' class='btn-remove' id='remove_" + String(i) + "' onclick='removeLastImageSlot()'>❌ Remove</button>";
-            chunk += "</div>";
-            chunk += "<input type='text' name='img_url_" + String(i) + "' placeholder='https://example.com/image" + String(i + 1) + ".png' value='" + existingUrl + "'>";
-            chunk += "<label>Display for (minutes)</label>";
-            chunk += "<input type='number' name='img_int_" + String(i) + "' min='0' placeholder='5' value='" + String(existingInterval) + "'>";
-            chunk += "<div class='help-text'>Set to 0 for button-only mode (no automatic refresh - wake by button press only)</div>";
-            chunk += "<label style='display: flex; align-items: center; gap: 10px; margin-top: 10px;'>";
-            chunk += "<input type='checkbox' name='img_stay_" + String(i) + "'";
-            if (existingStay) chunk += " checked";
-            chunk += ">";
-            chunk += "Stay on this image (advance on button press)";
-            chunk += "</label>";
-            chunk += "</div>";
-        }
-        
-        // Add button to show more slots (hidden when all 10 are visible)
-        String visibleSlots = String(existingCount > 1 ? existingCount : 1);
-        String buttonDisplay = existingCount >= MAX_IMAGE_SLOTS ? " style='display:none;'" : "";
-        chunk += "<button type='button' id='addImageBtn' onclick='addImageSlot()'" + buttonDisplay + ">➕ Add Another Image (up to 10 total)</button>";
-        
-        // Timezone Offset
-        chunk += "<div class='form-group'>";
-        chunk += "<label for='timezone'>Timezone Offset (UTC)</label>";
-        if (hasConfig) {
-            chunk += "<input type='number' id='timezone' name='timezone' min='-12' max='14' value='" + String(currentConfig.timezoneOffset) + "' placeholder='0'>";
-        } else {
-            chunk += "<input type='number' id='timezone' name='timezone' min='-12' max='14' value='0' placeholder='0'>";
-        }
-        chunk += "<div class='help-text'>Enter your timezone offset (range: -12 to +14). Keep in mind that Daylight Saving Time may apply in your region - you'll need to update this offset when DST changes.</div>";
-        chunk += "</div>";
-        
-        // Screen Rotation
-        chunk += "<div class='form-group'>";
-        chunk += "<label for='rotation'>Screen Rotation</label>";
-        chunk += "<select id='rotation' name='rotation'>";
-        uint8_t currentRotation = hasConfig ? currentConfig.screenRotation : 0;
-        chunk += "<option value='0'" + String(currentRotation == 0 ? " selected" : "") + ">0° (Landscape)</option>";
-        chunk += "<option value='1'" + String(currentRotation == 1 ? " selected" : "") + ">90° (Portrait)</option>";
-        chunk += "<option value='2'" + String(currentRotation == 2 ? " selected" : "") + ">180° (Inverted Landscape)</option>";
-        chunk += "<option value='3'" + String(currentRotation == 3 ? " selected" : "") + ">270° (Portrait Inverted)</option>";
-        chunk += "</select>";
-        chunk += "<div class='help-text'>Select the orientation of your display. Important: Your images must be oriented to match this setting (e.g., for 90° portrait, provide a portrait-oriented image).</div>";
-        chunk += "</div>";
-        
-        // Frontlight configuration (only for boards with HAS_FRONTLIGHT)
-        #if defined(HAS_FRONTLIGHT) && HAS_FRONTLIGHT == true
-        chunk += "<div class='form-group'>";
-        chunk += "<label for='frontlight_duration'>Frontlight Duration (seconds)</label>";
-        uint8_t currentDuration = hasConfig ? currentConfig.frontlightDuration : 0;
-        chunk += "<input type='number' id='frontlight_duration' name='frontlight_duration' min='0' max='255' value='" + String(currentDuration) + "' placeholder='0'>";
-        chunk += "<div class='help-text'>How long to keep the frontlight on during manual button refresh (0 = disabled, default). When set to 0, frontlight is never activated and device goes to sleep immediately after refresh.</div>";
-        chunk += "</div>";
-        
-        chunk += "<div class='form-group'>";
-        chunk += "<label for='frontlight_brightness'>Frontlight Brightness (0-63)</label>";
-        uint8_t currentBrightness = hasConfig ? currentConfig.frontlightBrightness : 63;
-        chunk += "<input type='number' id='frontlight_brightness' name='frontlight_brightness' min='0' max='63' value='" + String(currentBrightness) + "' placeholder='63'>";
-        chunk += "<div class='help-text'>Brightness level when frontlight is active (0-63, where 63 is maximum brightness). Not used if duration is set to 0.</div>";
-        chunk += "</div>";
-        #endif
-        
-        chunk += SECTION_END();
-        sendChunk(chunk);  // Send display settings section
-        
-        // Overlay Section
-        chunk = "";  // Clear for overlay section
-        chunk += SECTION_START("📊", "Status Overlay");
-        chunk += "<div class='help-text' style='margin-bottom: 15px;'>Display battery and update status directly on your dashboard images</div>";
-        
-        // Overlay Enable/Disable
-        chunk += "<div class='form-group checkbox-group'>";
-        chunk += "<label>";
-        bool overlayEnabled = hasConfig ? currentConfig.overlayEnabled : false;
-        chunk += "<input type='checkbox' name='overlay_enabled' id='overlay_enabled' ";
-        if (overlayEnabled) chunk += "checked ";
-        chunk += ">";
-        chunk += " Enable status overlay";
-        chunk += "</label>";
-        chunk += "<div class='help-text'>Show battery, time, and cycle information on top of dashboard images</div>";
-        chunk += "</div>";
-        
-        // Overlay Position
-        chunk += "<div class='form-group'>";
-        chunk += "<label for='overlay_position'>Overlay Position</label>";
-        uint8_t overlayPosition = hasConfig ? currentConfig.overlayPosition : OVERLAY_POS_TOP_RIGHT;
-        chunk += "<select id='overlay_position' name='overlay_position'>";
-        chunk += "<option value='0'"; if (overlayPosition == OVERLAY_POS_TOP_LEFT) chunk += " selected"; chunk += ">Top Left</option>";
-        chunk += "<option value='1'"; if (overlayPosition == OVERLAY_POS_TOP_RIGHT) chunk += " selected"; chunk += ">Top Right</option>";
-        chunk += "<option value='2'"; if (overlayPosition == OVERLAY_POS_BOTTOM_LEFT) chunk += " selected"; chunk += ">Bottom Left</option>";
-        chunk += "<option value='3'"; if (overlayPosition == OVERLAY_POS_BOTTOM_RIGHT) chunk += " selected"; chunk += ">Bottom Right</option>";
-        chunk += "</select>";
-        chunk += "</div>";
-        
-        // Overlay Size
-        chunk += "<div class='form-group'>";
-        chunk += "<label for='overlay_size'>Overlay Size</label>";
-        uint8_t overlaySize = hasConfig ? currentConfig.overlaySize : OVERLAY_SIZE_MEDIUM;
-        chunk += "<select id='overlay_size' name='overlay_size'>";
-        chunk += "<option value='0'"; if (overlaySize == OVERLAY_SIZE_SMALL) chunk += " selected"; chunk += ">Small</option>";
-        chunk += "<option value='1'"; if (overlaySize == OVERLAY_SIZE_MEDIUM) chunk += " selected"; chunk += ">Medium (Default)</option>";
-        chunk += "<option value='2'"; if (overlaySize == OVERLAY_SIZE_LARGE) chunk += " selected"; chunk += ">Large</option>";
-        chunk += "</select>";
-        chunk += "</div>";
-        
-        // Overlay Color
-        chunk += "<div class='form-group'>";
-        chunk += "<label for='overlay_color'>Text Color</label>";
-        uint8_t overlayColor = hasConfig ? currentConfig.overlayTextColor : OVERLAY_COLOR_BLACK;
-        chunk += "<select id='overlay_color' name='overlay_color'>";
-        chunk += "<option value='0'"; if (overlayColor == OVERLAY_COLOR_BLACK) chunk += " selected"; chunk += ">Black (Default)</option>";
-        chunk += "<option value='1'"; if (overlayColor == OVERLAY_COLOR_DARK_GRAY) chunk += " selected"; chunk += ">Dark Gray</option>";
-        chunk += "<option value='2'"; if (overlayColor == OVERLAY_COLOR_LIGHT_GRAY) chunk += " selected"; chunk += ">Light Gray</option>";
-        chunk += "<option value='3'"; if (overlayColor == OVERLAY_COLOR_WHITE) chunk += " selected"; chunk += ">White</option>";
-        chunk += "</select>";
-        chunk += "<div class='help-text'>Choose color for best contrast with your dashboard image background</div>";
-        chunk += "</div>";
-        
-        // Overlay Content Options
-        chunk += "<div class='help-text' style='margin: 15px 0 10px 0; font-weight: bold;'>Display Options:</div>";
-        
-        // Battery Icon
-        chunk += "<div class='form-group checkbox-group'>";
-        chunk += "<label>";
-        bool showBatteryIcon = hasConfig ? currentConfig.overlayShowBatteryIcon : true;
-        chunk += "<input type='checkbox' name='overlay_battery_icon' id='overlay_battery_icon' ";
-        if (showBatteryIcon) chunk += "checked ";
-        chunk += ">";
-        chunk += " Show battery icon";
-        chunk += "</label>";
-        chunk += "<div class='help-text'>Display battery icon filled to match current percentage</div>";
-        chunk += "</div>";
-        
-        // Battery Percentage
-        chunk += "<div class='form-group checkbox-group'>";
-        chunk += "<label>";
-        bool showBatteryPct = hasConfig ? currentConfig.overlayShowBatteryPercentage : true;
-        chunk += "<input type='checkbox' name='overlay_battery_pct' id='overlay_battery_pct' ";
-        if (showBatteryPct) chunk += "checked ";
-        chunk += ">";
-        chunk += " Show battery percentage";
-        chunk += "</label>";
-        chunk += "<div class='help-text'>Display battery percentage as text (e.g., \"85%\")</div>";
-        chunk += "</div>";
-        
-        // Update Time
-        chunk += "<div class='form-group checkbox-group'>";
-        chunk += "<label>";
-        bool showUpdateTime = hasConfig ? currentConfig.overlayShowUpdateTime : true;
-        chunk += "<input type='checkbox' name='overlay_update_time' id='overlay_update_time' ";
-        if (showUpdateTime) chunk += "checked ";
-        chunk += ">";
-        chunk += " Show last update time";
-        chunk += "</label>";
-        chunk += "<div class='help-text'>Display time of last image update (e.g., \"11:25\")</div>";
-        chunk += "</div>";
-        
-        // Cycle Time
-        chunk += "<div class='form-group checkbox-group'>";
-        chunk += "<label>";
-        bool showCycleTime = hasConfig ? currentConfig.overlayShowCycleTime : false;
-        chunk += "<input type='checkbox' name='overlay_cycle_time' id='overlay_cycle_time' ";
-        if (showCycleTime) chunk += "checked ";
-        chunk += ">";
-        chunk += " Show last cycle time";
-        chunk += "</label>";
-        chunk += "<div class='help-text'>Display loop duration in seconds (for debugging performance)</div>";
-        chunk += "</div>";
-        
-        chunk += SECTION_END();
-        sendChunk(chunk);  // Send overlay section
-        
-        // MQTT Section
-        chunk = "";  // Clear for MQTT section
-        chunk += SECTION_START("📡", "MQTT / Home Assistant");
-        chunk += "<div class='help-text' style='margin-bottom: 15px;'>Configure MQTT to send battery voltage to Home Assistant (optional)</div>";
-        
-        // MQTT Broker URL
-        chunk += "<div class='form-group'>";
-        chunk += "<label for='mqttbroker'>MQTT Broker URL</label>";
-        if (hasConfig) {
-            chunk += "<input type='text' id='mqttbroker' name='mqttbroker' placeholder='mqtt://broker.example.com:1883' value='" + currentConfig.mqttBroker + "'>";
-        } else {
-            chunk += "<input type='text' id='mqttbroker' name='mqttbroker' placeholder='mqtt://broker.example.com:1883'>";
-        }
-        chunk += "<div class='help-text'>Leave empty to disable MQTT reporting</div>";
-        chunk += "</div>";
-        
-        // MQTT Username
-        chunk += "<div class='form-group'>";
-        chunk += "<label for='mqttuser'>MQTT Username (optional)</label>";
-        if (hasConfig) {
-            chunk += "<input type='text' id='mqttuser' name='mqttuser' placeholder='username' value='" + currentConfig.mqttUsername + "'>";
-        } else {
-            chunk += "<input type='text' id='mqttuser' name='mqttuser' placeholder='username'>";
-        }
-        chunk += "</div>";
-        
-        // MQTT Password
-        chunk += "<div class='form-group'>";
-        chunk += "<label for='mqttpass'>MQTT Password (optional)</label>";
-        if (hasConfig && currentConfig.mqttPassword.length() > 0) {
-            chunk += "<input type='password' id='mqttpass' name='mqttpass' placeholder='password' value='" + currentConfig.mqttPassword + "'>";
-            chunk += "<div class='help-text'>Password is set. Leave empty to keep current password.</div>";
-        } else {
-            chunk += "<input type='password' id='mqttpass' name='mqttpass' placeholder='password'>";
-        }
-        chunk += "</div>";
-        chunk += SECTION_END();
-        sendChunk(chunk);  // Send MQTT section
-        
-        // Scheduling Section
-        chunk = "";  // Clear for scheduling section
-        chunk += SECTION_START("🕐", "Scheduling");
-        
-        // CRC32 change detection toggle
-        chunk += "<div class='form-group'>";
-        chunk += "<label for='crc32check' style='display: flex; align-items: center; gap: 10px;'>";
-        chunk += "<input type='checkbox' id='crc32check' name='crc32check'";
-        if (hasConfig && currentConfig.useCRC32Check) {
-            chunk += " checked";
-        }
-        chunk += "> Enable CRC32-based change detection";
-        chunk += "</label>";
-        chunk += "<div class='help-text'>Skips image download & refresh when unchanged. Works in single image mode and carousel mode (for images with stay:true flag). Requires compatible web server that generates .crc32 checksum files (naming: image.png.crc32). Significantly extends battery life.</div>";
-        chunk += "</div>";
-        
-        // Hourly Schedule - Update Hours
-        chunk += "<div class='form-group' style='margin-top: 20px;'>";
-        chunk += "<label style='font-size: 16px; margin-bottom: 5px;'>📅 Update Hours</label>";
-        chunk += "<div class='help-text' style='margin-bottom: 15px;'>Select which hours the device should perform updates. Unchecked hours will be skipped to save battery.</div>";
-        
-        // 24 checkboxes in a 4x6 grid (4 columns for better UI fit)
-        chunk += "<div style='display: grid; grid-template-columns: repeat(4, 1fr); gap: 10px; margin-bottom: 20px;'>";
-        for (int hour = 0; hour < 24; hour++) {
-            // Check if hour is enabled: use current config if available, otherwise default to enabled
-            bool isEnabled = hasConfig ? 
-                ((currentConfig.updateHours[hour / 8] >> (hour % 8)) & 1) : 
-                true;  // Default all enabled if no config
-            
-            int nextHour = (hour + 1) % 24;
-            
-            chunk += "<label style='display: flex; align-items: center; gap: 8px; padding: 8px; background: #f5f5f5; border-radius: 4px; cursor: pointer;'>";
-            chunk += "<input type='checkbox' id='hour_" + String(hour) + "' name='hour_" + String(hour) + "' class='hour-checkbox'";
-            if (isEnabled) {
-                chunk += " checked";
-            }
-            chunk += "> <div style='line-height: 1.2;'><div>" + String(hour < 10 ? "0" : "") + String(hour) + ":00</div>";
-            chunk += "<div style='font-size: 11px; color: #999; margin-top: 1px;'>to " + String(nextHour < 10 ? "0" : "") + String(nextHour) + ":00</div></div>";
-            chunk += "</label>";
-        }
-        chunk += "</div>";
-        chunk += "</div>";
-        
-        // Battery Life Estimator - placed after all power-impacting settings
-        chunk += CONFIG_PORTAL_BATTERY_ESTIMATOR_HTML;
-        chunk += SECTION_END();
-        sendChunk(chunk);  // Send scheduling section
-    }
-    
-    // Submit button - text varies by mode
-    chunk = "";  // Clear for footer
-    if (_mode == BOOT_MODE) {
-        chunk += "<button type='submit'>➡️ Next: Configure Dashboard</button>";
-    } else if (hasConfig) {
-        chunk += "<button type='submit'>🔄 Update Configuration</button>";
-    } else {
-        chunk += "<button type='submit'>💾 Save Configuration</button>";
-    }
-    chunk += "</form>";
-    
-    // OTA Update button - only shown in CONFIG_MODE
-    if (_mode == CONFIG_MODE) {
-        chunk += CONFIG_PORTAL_FIRMWARE_UPDATE_BUTTON;
-        chunk += CONFIG_PORTAL_REBOOT_BUTTON;
-    }
-    
-    // Factory Reset & VCOM Section - only show in CONFIG_MODE
-    if (_mode == CONFIG_MODE) {
-        chunk += CONFIG_PORTAL_DANGER_ZONE_START;
-        #ifndef DISPLAY_MODE_INKPLATE2
-        // VCOM management only available on boards with TPS65186 PMIC (not Inkplate 2)
-        chunk += CONFIG_PORTAL_VCOM_BUTTON;
-        #endif
-        chunk += CONFIG_PORTAL_DANGER_ZONE_END;
-    }
-    
-    chunk += "</div>";
-    
-    // Modal dialog for factory reset confirmation (only in CONFIG_MODE)
-    if (_mode == CONFIG_MODE) {
-        chunk += CONFIG_PORTAL_RESET_MODAL_HTML;
-    }
-    
-    // Footer with version
-    String footer = CONFIG_PORTAL_FOOTER_TEMPLATE;
-    footer.replace("%VERSION%", String(FIRMWARE_VERSION));
-    chunk += footer;
-    
-    // Factory Reset Modal JavaScript - needed in CONFIG_MODE (for factory reset button in danger zone)
-    // Friendly Name Sanitization JavaScript - needed in both modes (friendly name field now in BOOT_MODE too)
-    // Battery Life Estimator JavaScript - only in CONFIG_MODE
-    // All scripts now served from /scripts/main.js
-    chunk += "<script src='/scripts/main.js'></script>";
+    #ifndef DISPLAY_MODE_INKPLATE2
+    page.partialRefreshAvailable = true;
+    page.vcomAvailable = true;
+    #endif
+    #if defined(HAS_FRONTLIGHT) && HAS_FRONTLIGHT == true
+    page.frontlightAvailable = true;
+    #endif
     
-    // Add floating badge HTML before closing body - only in CONFIG_MODE
-    if (_mode == CONFIG_MODE) {
-        chunk += CONFIG_PORTAL_BADGE_HTML;
-    }
+    page.firmwareVersion = FIRMWARE_VERSION;
+    page.energyStats = _energyStats;
+    page.powerProfile = PowerManager::getPowerProfile();
     
-    chunk += "</body></html>";
-    sendChunk(chunk);  // Send final chunk
+    renderConfigPage(out, page);
 }
 
+
 String ConfigPortal::generateSuccessPage() {
     String html = CONFIG_PORTAL_PAGE_HEADER_START;
     html += "<title>Configuration Saved</title>";
-    html += "<link rel='stylesheet' href='/styles.css'>";
+    html += "<link rel='stylesheet' href='" PORTAL_STYLES_CSS_URL "'>";
     html += "<meta http-equiv='refresh' content='5;url=/'>";
     html += "</head><body>";
     html += "<div class='container'>";
@@ -1127,7 +755,7 @@ String ConfigPortal::generateSuccessPage() {
 String ConfigPortal::generateErrorPage(const String& error) {
     String html = CONFIG_PORTAL_PAGE_HEADER_START;
     html += "<title>Error</title>";
-    html += "<link rel='stylesheet' href='/styles.css'>";
+    html += "<link rel='stylesheet' href='" PORTAL_STYLES_CSS_URL "'>";
     html += "<meta http-equiv='refresh' content='3;url=/'>";
     html += "</head><body>";
     html += "<div class='container'>";
@@ -1150,7 +778,7 @@ String ConfigPortal::generateErrorPage(const String& error) {
 String ConfigPortal::generateFactoryResetPage() {
     String html = CONFIG_PORTAL_PAGE_HEADER_START;
     html += "<title>Factory Reset</title>";
-    html += "<link rel='stylesheet' href='/styles.css'>";
+    html += "<link rel='stylesheet' href='" PORTAL_STYLES_CSS_URL "'>";
     html += "</head><body>";
     html += "<div class='container'>";
     
@@ -1169,7 +797,7 @@ String ConfigPortal::generateFactoryResetPage() {
 String ConfigPortal::generateRebootPage() {
     String html = CONFIG_PORTAL_PAGE_HEADER_START;
     html += "<title>Rebooting</title>";
-    html += "<link rel='stylesheet' href='/styles.css'>";
+    html += "<link rel='stylesheet' href='" PORTAL_STYLES_CSS_URL "'>";
     html += "</head><body>";
     html += "<div class='container'>";
     
@@ -1188,7 +816,7 @@ String ConfigPortal::generateRebootPage() {
 String ConfigPortal::generateOTAPage() {
     String html = CONFIG_PORTAL_PAGE_HEADER_START;
     html += "<title>Firmware Update</title>";
-    html += "<link rel='stylesheet' href='/styles.css'>";
+    html += "<link rel='stylesheet' href='" PORTAL_STYLES_CSS_URL "'>";
     html += "</head><body>";
     html += "<div class='container'>";
     html += "<h1>⬆️ Firmware Update</h1>";
@@ -1211,7 +839,7 @@ String ConfigPortal::generateOTAPage() {
     html += "</div>"; // Close container
     
     // OTA JavaScript (GitHub updates and manual upload)
-    html += "<script src='/scripts/ota.js'></script>";
+    html += "<script src='" PORTAL_OTA_JS_URL "'></script>";
     
     html += "</body></html>";
     
@@ -1437,7 +1065,7 @@ void ConfigPortal::handleVcomSubmit() {
 String ConfigPortal::generateVcomPage(double currentVcom, const String& message, const String& diagnostics) {
     String html = CONFIG_PORTAL_PAGE_HEADER_START;
     html += "<title>VCOM Management</title>";
-    html += "<link rel='stylesheet' href='/styles.css'>";
+    html += "<link rel='stylesheet' href='" PORTAL_STYLES_CSS_URL "'>";
     html += "</head><body>";
     html += "<div class='container'>";
     html += "<h1>⚙️ VCOM Management</h1>";
@@ -1509,7 +1137,7 @@ String ConfigPortal::generateVcomPage(double currentVcom, const String& message,
 String ConfigPortal::generateOTAStatusPage() {
     String html = CONFIG_PORTAL_PAGE_HEADER_START;
     html += "<title>Updating Firmware</title>";
-    html += "<link rel='stylesheet' href='/styles.css'>";
+    html += "<link rel='stylesheet' href='" PORTAL_STYLES_CSS_URL "'>";
     html += CONFIG_PORTAL_OTA_STATUS_STYLES;
     html += "</head><body>";
     html += "<div class='container'>";
@@ -1526,7 +1154,7 @@ String ConfigPortal::generateOTAStatusPage() {
     html += "</div>"; // Close container
     
     // JavaScript to trigger the update and poll progress
-    html += "<script src='/scripts/ota-status.js'></script>";
+    html += "<script src='" PORTAL_OTA_STATUS_JS_URL "'></script>";
     
     html += "</body></html>";
     
@@ -7,6 +7,10 @@
 #include "config_manager.h"
 #include "wifi_manager.h"
 #include "display_manager.h"
+#include "energy_model.h"
+#include "portal_assets.h"
+#include "config_page.h"
+#include "config_json.h"
 
 // Portal mode enum
 enum PortalMode {
@@ -34,6 +38,9 @@ public:
     // Get the port number
     int getPort();
     
+    // Battery life averages measured by normal mode (RTC memory), shown next to the estimator
+    void setEnergyStats(const EnergyStats* stats);
+    
 private:
     ConfigManager* _configManager;
     WiFiManager* _wifiManager;
@@ -42,13 +49,14 @@ private:
     bool _configReceived;
     int _port;
     PortalMode _mode;
+    const EnergyStats* _energyStats;
     
     // HTTP handlers
     void handleRoot();
     void handleSubmit();
-    
-    // Helper for chunked sending
-    void sendChunk(const String& chunk);
+    void handleApiConfigGet();
+    void handleApiConfigPut();
+    void handleApiStatus();
     void handleFactoryReset();
     void handleReboot();
     void handleOTA();
@@ -58,17 +66,14 @@ private:
     void handleOTAStatus();
     void handleOTAProgress();
     void handleNotFound();
-    void handleCSS();
-    void handleMainJS();
-    void handleOTAJS();
-    void handleOTAStatusJS();
+    void handleAsset(const PortalAsset& asset);
     #ifndef DISPLAY_MODE_INKPLATE2
     void handleVcom();
     void handleVcomSubmit();
     #endif
     
     // HTML page generators
-    void generateConfigPage();  // Sends chunked HTML
+    void generateConfigPage(TemplateWriter& out);  // Streams the page through out
     String generateSuccessPage();
     String generateErrorPage(const String& error);
     String generateFactoryResetPage();
@@ -79,6 +84,10 @@ private:
     String generateVcomPage(double currentVcom, const String& message = "", const String& diagnostics = "");
     #endif
     
+    // JSON API responses (chunked, never cached)
+    void beginJsonResponse(int code);
+    void sendJsonError(int code, const char* message);
+    
     // Validation helpers
     bool validateIPv4Format(const String& ip);
 };
@@ -0,0 +1,594 @@
+// Config Portal assets - GENERATED by scripts/generate_portal_assets.py, do not edit
+// Minified + gzipped from config_portal_css.h and config_portal_js.h; run the script
+// after changing them (build.sh does when they changed, the host tests catch stale data).
+
+#ifndef CONFIG_PORTAL_ASSETS_H
+#define CONFIG_PORTAL_ASSETS_H
+
+#include <portal_assets.h>
+
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+
+#define PORTAL_STYLES_CSS_URL "/styles.css?v=b8fb9c6f"
+#define PORTAL_MAIN_JS_URL "/scripts/main.js?v=d756d8e6"
+#define PORTAL_OTA_JS_URL "/scripts/ota.js?v=f57e96bc"
+#define PORTAL_OTA_STATUS_JS_URL "/scripts/ota-status.js?v=b88659d7"
+
+// /styles.css: 15259 bytes source, 10333 minified, 2663 gzipped
+static const uint8_t PORTAL_ASSET_STYLES_CSS[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xc5, 0x5a, 0x59, 0x8f, 0xa3, 0x48,
+    0x12, 0x7e, 0xef, 0x5f, 0x81, 0xba, 0x54, 0x72, 0x79, 0xc7, 0xb8, 0xb8, 0x7d, 0x94, 0x4a, 0x5a,
+    0xf5, 0x68, 0x57, 0x1a, 0x69, 0x47, 0x23, 0xcd, 0x68, 0x1e, 0x56, 0xab, 0x79, 0x48, 0x20, 0xb1,
+    0xd9, 0xc6, 0x80, 0x20, 0x29, 0x97, 0x7b, 0xb4, 0xff, 0x7d, 0x23, 0x0f, 0x20, 0x93, 0x4c, 0x6c,
+    0xf7, 0xf4, 0x1e, 0x5d, 0xdd, 0xd5, 0x18, 0x93, 0x91, 0x71, 0xc7, 0x17, 0x91, 0xfc, 0xc9, 0xfa,
+    0xfd, 0xc3, 0x09, 0x35, 0x87, 0xbc, 0xdc, 0x5b, 0xce, 0xcb, 0x87, 0x1a, 0xa5, 0x69, 0x5e, 0x1e,
+    0xd8, 0x75, 0x5c, 0xbd, 0xdb, 0x6d, 0xfe, 0x85, 0x7d, 0x8c, 0xab, 0x26, 0xc5, 0x8d, 0x0d, 0xb7,
+    0x5e, 0x3e, 0xfc, 0x0b, 0xbe, 0x49, 0x2f, 0xb0, 0x2e, 0xab, 0x4a, 0x62, 0x67, 0xe8, 0x94, 0x17,
+    0x97, 0xbd, 0x65, 0xa3, 0xba, 0x2e, 0xb0, 0xdd, 0x5e, 0x5a, 0x82, 0x4f, 0x2b, 0xeb, 0x53, 0x91,
+    0x97, 0x9f, 0x7f, 0x44, 0xc9, 0x2f, 0xec, 0xf3, 0x5f, 0xe1, 0xc9, 0x95, 0xb5, 0xf8, 0x05, 0x1f,
+    0x2a, 0x6c, 0xfd, 0xfa, 0xc3, 0x62, 0x65, 0xfd, 0x5c, 0xc5, 0x15, 0xa9, 0x56, 0xd6, 0x4f, 0xef,
+    0x97, 0x03, 0x2e, 0x57, 0xd6, 0xaf, 0x71, 0x57, 0x92, 0x6e, 0x65, 0x7d, 0x8f, 0x4a, 0x82, 0x1a,
+    0x5c, 0x14, 0x2b, 0xab, 0x45, 0x65, 0x6b, 0xb7, 0xb8, 0xc9, 0x33, 0xe0, 0x05, 0x25, 0x9f, 0x0f,
+    0x4d, 0xd5, 0x95, 0xe9, 0xde, 0x02, 0xca, 0x18, 0x35, 0xf6, 0xa1, 0x41, 0x69, 0x8e, 0x4b, 0xf2,
+    0xe4, 0xfa, 0x61, 0x8a, 0x0f, 0x2b, 0xeb, 0x21, 0x8a, 0x36, 0x18, 0x23, 0xcb, 0x79, 0x84, 0xeb,
+    0x4d, 0x14, 0xc4, 0xc8, 0xb3, 0x5c, 0xc7, 0x79, 0x5c, 0xbe, 0x7c, 0x38, 0xe5, 0xa5, 0x7d, 0xc4,
+    0xf9, 0xe1, 0x48, 0xf6, 0xf4, 0xd6, 0xdb, 0x51, 0x92, 0xd4, 0x73, 0x6a, 0x26, 0xd4, 0x3a, 0x01,
+    0x26, 0x11, 0xd0, 0x6e, 0x40, 0x34, 0x79, 0xbf, 0x87, 0x6c, 0x9b, 0xed, 0x32, 0x44, 0x15, 0xc2,
+    0x94, 0x40, 0xf7, 0xed, 0x5a, 0x20, 0xe4, 0xd1, 0x85, 0x4c, 0x4b, 0x47, 0x94, 0x56, 0x67, 0x50,
+    0x1a, 0x10, 0xaf, 0xdf, 0xad, 0x80, 0xfe, 0x6a, 0x0e, 0x31, 0x7a, 0x72, 0x56, 0xec, 0x67, 0xed,
+    0x2d, 0xa5, 0x0d, 0x03, 0xb6, 0xe1, 0x09, 0xbd, 0xdb, 0xe7, 0x3c, 0x25, 0xc7, 0xbd, 0x15, 0xf1,
+    0x3b, 0xe2, 0x13, 0x65, 0xf9, 0x65, 0xb4, 0x89, 0x85, 0x3a, 0x52, 0x51, 0xfe, 0x8e, 0x2e, 0xf0,
+    0x95, 0x54, 0x45, 0xd5, 0x00, 0x4b, 0xbe, 0xef, 0xf7, 0xcf, 0x80, 0x51, 0x08, 0xa9, 0x4e, 0x7b,
+    0xb6, 0xf7, 0x0b, 0x37, 0x0a, 0x98, 0x0d, 0x83, 0x64, 0x5b, 0x21, 0x59, 0xdb, 0xc5, 0x24, 0x27,
+    0x05, 0x96, 0x08, 0x44, 0x51, 0xa4, 0x11, 0xf0, 0xa7, 0x04, 0xdc, 0x40, 0x10, 0xc8, 0xaa, 0xe6,
+    0x64, 0x53, 0x7d, 0xd4, 0x83, 0xbb, 0x0c, 0xab, 0x7a, 0xfd, 0x15, 0x28, 0xc6, 0x05, 0x7c, 0x9d,
+    0xe6, 0x6d, 0x5d, 0x20, 0xf0, 0x88, 0xb8, 0xa8, 0x92, 0xcf, 0xda, 0x26, 0x8c, 0x27, 0x45, 0x0c,
+    0xb6, 0xe1, 0x59, 0x58, 0x27, 0x74, 0x1c, 0x23, 0x0b, 0x79, 0x59, 0x77, 0xe4, 0x1f, 0xe4, 0x52,
+    0xe3, 0xd7, 0x8f, 0x04, 0xbf, 0x93, 0x8f, 0xbf, 0xad, 0x94, 0x7b, 0x35, 0x6a, 0xdb, 0x33, 0xd8,
+    0x67, 0x7a, 0xbf, 0xec, 0x4e, 0x31, 0x6e, 0xa6, 0x77, 0xbb, 0xa6, 0xa0, 0xb7, 0x5a, 0x5c, 0xe0,
+    0x84, 0x00, 0xcf, 0x8a, 0xea, 0x07, 0x43, 0xf5, 0x06, 0xa6, 0x56, 0x07, 0x39, 0xc1, 0xa8, 0x6d,
+    0x55, 0xe4, 0xa9, 0xf5, 0x80, 0x1d, 0xfa, 0xa3, 0x39, 0x44, 0x34, 0x55, 0x1f, 0xbb, 0x41, 0x1a,
+    0xf0, 0xe3, 0x9c, 0xe4, 0x55, 0x39, 0x84, 0x11, 0x13, 0xdf, 0x72, 0xd6, 0x7e, 0xfb, 0xf2, 0x01,
+    0x24, 0x8f, 0x3f, 0xe7, 0x84, 0x86, 0x0f, 0x78, 0x35, 0x2a, 0x13, 0x58, 0x58, 0x56, 0x25, 0x86,
+    0x85, 0x55, 0x97, 0x1c, 0x6d, 0x94, 0xf0, 0xa5, 0x27, 0x54, 0xe6, 0x75, 0x57, 0x20, 0xfa, 0x49,
+    0x8d, 0x87, 0xf3, 0x31, 0x27, 0x98, 0xea, 0x68, 0x10, 0x67, 0xfc, 0xd6, 0xce, 0x4f, 0xe8, 0x00,
+    0x14, 0x41, 0xe0, 0xa7, 0x8f, 0x29, 0x22, 0x68, 0xcf, 0x6e, 0x3c, 0xb7, 0x6f, 0x87, 0xef, 0xde,
+    0x4f, 0xc5, 0xea, 0xd1, 0xff, 0x1e, 0x2e, 0x2d, 0xb8, 0x2c, 0xdb, 0xd7, 0xc5, 0x91, 0x90, 0x7a,
+    0xff, 0xfc, 0x7c, 0x3e, 0x9f, 0xd7, 0x67, 0x7f, 0x5d, 0x35, 0x87, 0x67, 0xcf, 0x71, 0x1c, 0xfa,
+    0xf0, 0xc2, 0x62, 0x2a, 0x7a, 0x5d, 0xb8, 0xde, 0xc2, 0xe2, 0x91, 0xc4, 0xaf, 0xdf, 0x72, 0x7c,
+    0xfe, 0x54, 0xbd, 0xbf, 0x2e, 0x1c, 0xea, 0xfd, 0x10, 0x70, 0xde, 0xe2, 0xd1, 0xff, 0x0b, 0x90,
+    0xad, 0x11, 0x39, 0x5a, 0x59, 0x5e, 0x14, 0xaf, 0x8b, 0x47, 0x0f, 0xec, 0xec, 0x2f, 0xac, 0xf4,
+    0x75, 0xf1, 0x63, 0x64, 0xed, 0xfe, 0xe6, 0x5a, 0xc1, 0xd1, 0x75, 0xbe, 0x2c, 0x9e, 0xf9, 0x93,
+    0x94, 0x3e, 0x5c, 0x7d, 0x5c, 0xca, 0x62, 0xd9, 0x0d, 0x06, 0x7d, 0x10, 0xaa, 0x0b, 0x71, 0xa9,
+    0x7c, 0x5b, 0x57, 0xbd, 0x4a, 0x1b, 0xca, 0x0b, 0x33, 0x95, 0x95, 0x40, 0x36, 0xc0, 0xcd, 0x60,
+    0x40, 0xbb, 0xe1, 0x2e, 0xc5, 0xa3, 0x2b, 0xe9, 0x9a, 0x96, 0xfa, 0x5c, 0x5d, 0xe5, 0xfc, 0x29,
+    0xe1, 0x53, 0xfb, 0xac, 0x4a, 0xba, 0xb6, 0xf7, 0x05, 0xfe, 0x09, 0x54, 0x58, 0x75, 0x84, 0xe6,
+    0x99, 0xde, 0x16, 0xb2, 0xe1, 0xf6, 0x7d, 0xa6, 0x99, 0xfa, 0x65, 0x72, 0xc4, 0xc9, 0x67, 0xc8,
+    0x07, 0x1f, 0x7f, 0x1b, 0x5d, 0x8a, 0x47, 0x47, 0x9f, 0x7b, 0x3c, 0x33, 0x2b, 0xd7, 0x2c, 0x0d,
+    0xd1, 0x77, 0xc4, 0x45, 0x6d, 0x53, 0xa7, 0xef, 0x73, 0xae, 0x70, 0x2f, 0x4f, 0x0e, 0x25, 0x39,
+    0xa0, 0x49, 0x55, 0x43, 0x24, 0x89, 0xd8, 0x65, 0x06, 0xb7, 0xdb, 0xa2, 0x22, 0x73, 0x79, 0x6d,
+    0x74, 0xf8, 0x70, 0x74, 0xf8, 0xc1, 0xab, 0xb7, 0x3c, 0x5b, 0xa9, 0xa9, 0x26, 0xbc, 0x11, 0x19,
+    0xea, 0xbe, 0x7d, 0x6a, 0x90, 0xd9, 0x73, 0x1d, 0x9d, 0x3f, 0xf6, 0xdc, 0x3e, 0xcb, 0x9b, 0x96,
+    0xd8, 0xc9, 0x31, 0x2f, 0xd2, 0xc9, 0x1a, 0x46, 0xf8, 0x01, 0xb8, 0xfd, 0x81, 0xae, 0xf9, 0x44,
+    0xca, 0x51, 0xcf, 0x3c, 0x4b, 0x8e, 0x92, 0xd0, 0x14, 0xec, 0x99, 0xf3, 0x99, 0x51, 0x16, 0x9a,
+    0x25, 0x31, 0x33, 0xc0, 0x44, 0x4b, 0x22, 0xba, 0xa6, 0x8b, 0x22, 0x83, 0xa6, 0xb8, 0x41, 0xaa,
+    0x37, 0xdc, 0x64, 0x05, 0x2d, 0x07, 0xc7, 0x3c, 0x4d, 0x71, 0x39, 0x2d, 0x11, 0x54, 0x5b, 0xdb,
+    0xb1, 0x40, 0x58, 0xe2, 0xef, 0xda, 0xd9, 0x2e, 0x65, 0x36, 0xa0, 0x5e, 0xa1, 0x94, 0xd5, 0xa2,
+    0x51, 0xa8, 0x68, 0x10, 0x6a, 0x48, 0xb2, 0x59, 0x81, 0xe1, 0x23, 0x2a, 0xf2, 0x43, 0x69, 0x03,
+    0xa3, 0x27, 0x60, 0xa3, 0x0f, 0x83, 0x03, 0xaa, 0x7b, 0x9e, 0x94, 0x14, 0x1b, 0x4d, 0x53, 0x6c,
+    0x24, 0xfb, 0x91, 0xe7, 0x7a, 0xa1, 0xb7, 0xbb, 0xb3, 0xe2, 0x62, 0x3f, 0xf3, 0xb2, 0x94, 0x57,
+    0xdc, 0x38, 0x4e, 0x71, 0x16, 0xf7, 0x15, 0x77, 0x00, 0x0c, 0xa2, 0xb4, 0x8c, 0x2e, 0xe2, 0xb9,
+    0xbb, 0x28, 0xf3, 0x15, 0x51, 0xf3, 0x84, 0xa9, 0x5d, 0x2e, 0x5d, 0xc1, 0xbd, 0x52, 0xfe, 0xb3,
+    0x6b, 0x49, 0x9e, 0x5d, 0x6c, 0x5a, 0xbd, 0xe1, 0xd6, 0xf8, 0x05, 0x5d, 0x03, 0x6a, 0x6f, 0x00,
+    0x87, 0x08, 0xcf, 0x19, 0xf6, 0x13, 0xcf, 0xca, 0xba, 0xe5, 0x6a, 0x35, 0xa6, 0xd5, 0xb8, 0x03,
+    0x19, 0xca, 0xf9, 0x2a, 0x11, 0x4c, 0x57, 0xfe, 0x01, 0x80, 0x22, 0xb4, 0x2f, 0xf6, 0xec, 0x03,
+    0x4b, 0xc9, 0x3d, 0xd7, 0xab, 0x8c, 0x6e, 0x61, 0x3d, 0xcb, 0x48, 0x85, 0x88, 0x5d, 0xd3, 0xaa,
+    0x0e, 0x8e, 0xe7, 0xb5, 0xd7, 0x33, 0x50, 0x5f, 0xa1, 0x08, 0xaa, 0xed, 0x23, 0x6c, 0x50, 0xd0,
+    0x4d, 0xfa, 0x54, 0xa8, 0xc0, 0x1c, 0x77, 0x39, 0xea, 0x6b, 0x4f, 0x89, 0xbd, 0x51, 0xc8, 0x31,
+    0xec, 0x25, 0xb6, 0x05, 0xba, 0xf8, 0xef, 0x4f, 0x0e, 0xf7, 0xf6, 0x98, 0x94, 0x80, 0xf1, 0xc0,
+    0x20, 0x29, 0x6a, 0x2e, 0x93, 0xd0, 0x9b, 0xd5, 0xa3, 0xeb, 0xc4, 0xbb, 0xad, 0xcb, 0xf5, 0xe8,
+    0x84, 0xbb, 0x28, 0xda, 0xf5, 0x7a, 0x54, 0x6a, 0xb7, 0xf0, 0x22, 0x59, 0x57, 0xa1, 0x06, 0xb4,
+    0x04, 0x0f, 0x0d, 0x3e, 0x55, 0x8c, 0x5b, 0x25, 0x43, 0xe2, 0x2c, 0x80, 0x3f, 0x53, 0xf3, 0x0c,
+    0x9b, 0xd0, 0x78, 0x54, 0x41, 0x82, 0xd1, 0x62, 0x1a, 0x17, 0xde, 0x1f, 0xb0, 0xd8, 0xc8, 0x97,
+    0x00, 0x0e, 0x4a, 0xe2, 0xbb, 0x5e, 0x41, 0xfe, 0x7c, 0xc2, 0x69, 0x8e, 0xac, 0xa7, 0x23, 0xcd,
+    0x4d, 0x90, 0x97, 0xe8, 0x7f, 0x4b, 0x90, 0x55, 0x92, 0x7c, 0xcf, 0x6e, 0x4e, 0xe5, 0x4f, 0x13,
+    0x2f, 0xf2, 0x22, 0x4a, 0x62, 0x9e, 0x88, 0x30, 0x77, 0xbf, 0xde, 0x6c, 0x6d, 0x1b, 0x44, 0x5e,
+    0x72, 0x3a, 0x80, 0x46, 0x93, 0x04, 0xb7, 0xed, 0x74, 0x2f, 0x6e, 0xd4, 0x59, 0x5d, 0x8b, 0x00,
+    0x35, 0xd4, 0x26, 0x5a, 0x19, 0x6d, 0x96, 0x1b, 0xc6, 0xe0, 0x87, 0x6d, 0x70, 0xd3, 0x54, 0xcd,
+    0x57, 0x1a, 0xf4, 0xab, 0x37, 0x49, 0xf1, 0x5b, 0x9e, 0x60, 0x3b, 0x2f, 0xb3, 0x4a, 0xab, 0xae,
+    0x7e, 0x16, 0x64, 0xd1, 0xad, 0xea, 0x1a, 0x19, 0x2a, 0xd2, 0x4c, 0xdd, 0xa2, 0xf0, 0xd6, 0x8e,
+    0x1b, 0x8c, 0x20, 0x9f, 0xb1, 0xff, 0x6c, 0x7a, 0x47, 0x63, 0xa3, 0x25, 0x4d, 0x55, 0x1e, 0x14,
+    0xa8, 0xdf, 0x83, 0x95, 0x75, 0x06, 0x1e, 0x52, 0x35, 0x17, 0xb0, 0x79, 0x8b, 0x89, 0x3d, 0x16,
+    0x3c, 0xb9, 0xc8, 0xf2, 0x2e, 0xa0, 0xc7, 0x50, 0xd2, 0x2d, 0xc1, 0x39, 0xbb, 0x63, 0x2e, 0xf9,
+    0x29, 0x2a, 0x0f, 0xf0, 0xc4, 0x17, 0x08, 0x02, 0x4d, 0x1b, 0x18, 0x2a, 0x85, 0x67, 0xc4, 0x0c,
+    0x19, 0xc6, 0x1e, 0xf6, 0xcc, 0x6a, 0xd7, 0xbb, 0x34, 0x79, 0x8f, 0xa3, 0x27, 0x89, 0xd9, 0xfb,
+    0xaa, 0xac, 0x37, 0x23, 0x76, 0x31, 0x51, 0xaa, 0xa7, 0xad, 0xd1, 0xdd, 0xa8, 0x81, 0x86, 0x10,
+    0xa7, 0x34, 0x17, 0x3c, 0x33, 0xbe, 0x26, 0x65, 0xa8, 0xaf, 0xcb, 0xf7, 0xc1, 0x7f, 0x22, 0x7b,
+    0x7c, 0x43, 0xc2, 0xe0, 0xd2, 0x9a, 0x13, 0x46, 0xbc, 0x73, 0x13, 0x37, 0x11, 0x81, 0x7e, 0xaa,
+    0x52, 0xa4, 0x74, 0x84, 0x5c, 0xbe, 0x11, 0xbb, 0x67, 0xf9, 0x3b, 0x06, 0x07, 0xfe, 0x02, 0x8e,
+    0x9b, 0xe2, 0x77, 0x96, 0x91, 0x41, 0x90, 0x02, 0x67, 0x84, 0x55, 0xec, 0x1e, 0xf3, 0x29, 0xf9,
+    0x5a, 0x6a, 0xe3, 0x1f, 0x95, 0x96, 0xc0, 0x54, 0x90, 0xc2, 0xe5, 0x88, 0xc7, 0xec, 0xcb, 0x7e,
+    0xe8, 0xa5, 0x39, 0x6b, 0x12, 0x0e, 0xd0, 0xe9, 0xf4, 0xe6, 0x1a, 0x98, 0x45, 0x31, 0xf8, 0x6b,
+    0x47, 0xb0, 0xe0, 0x2b, 0xa4, 0xdb, 0x73, 0x56, 0xd9, 0xa5, 0x29, 0xef, 0x3d, 0xd9, 0x21, 0xad,
+    0x51, 0xf4, 0xb7, 0x5c, 0x9b, 0x7c, 0x67, 0x16, 0x3c, 0x4a, 0x53, 0x81, 0xc0, 0x91, 0xa7, 0x02,
+    0x3b, 0x26, 0xed, 0x3d, 0xb3, 0x06, 0x7f, 0x39, 0x96, 0xec, 0x41, 0xf6, 0x36, 0x69, 0xaa, 0xa2,
+    0x60, 0xbb, 0x33, 0xcb, 0x4b, 0x4a, 0xe0, 0xf9, 0xbb, 0x95, 0xed, 0xc4, 0xe1, 0x16, 0xc7, 0x8f,
+    0x8e, 0xe4, 0xfc, 0x3c, 0xf4, 0x1d, 0xc9, 0xf3, 0x13, 0xda, 0xb0, 0x52, 0x1b, 0xd3, 0x25, 0xf0,
+    0xb4, 0x0a, 0x84, 0x1e, 0xa2, 0x78, 0xe3, 0x6d, 0x9d, 0xab, 0x21, 0xf0, 0x5f, 0xf3, 0xfe, 0xeb,
+    0x3d, 0x15, 0x63, 0xbe, 0x2a, 0xa1, 0xd7, 0x38, 0xcd, 0x72, 0x7f, 0x47, 0x00, 0xff, 0x9f, 0xb8,
+    0x3f, 0xa3, 0xa6, 0xa4, 0xd9, 0x39, 0x46, 0xa5, 0x69, 0x5e, 0x85, 0x33, 0x3f, 0xd9, 0x98, 0x73,
+    0x6d, 0xb8, 0xc3, 0x4e, 0x7c, 0x23, 0xd7, 0xf2, 0xdc, 0xd6, 0x4f, 0xa0, 0xa8, 0xbd, 0xad, 0xd1,
+    0x86, 0x0f, 0x3b, 0x0f, 0x3c, 0x13, 0x1b, 0xc4, 0xa2, 0x70, 0x6d, 0x9c, 0xb2, 0xad, 0x23, 0x13,
+    0xa7, 0x5a, 0x71, 0xda, 0x6c, 0xfd, 0xd0, 0xc9, 0xd8, 0xa3, 0x75, 0x53, 0x1d, 0xa0, 0x30, 0xb5,
+    0xb6, 0x3c, 0x88, 0x53, 0x62, 0x5f, 0x8f, 0xd2, 0x07, 0x1c, 0xe2, 0x0d, 0x9e, 0x11, 0x48, 0xef,
+    0xc4, 0x7a, 0xee, 0x02, 0xcd, 0xab, 0x87, 0x7c, 0x3e, 0x70, 0x11, 0x23, 0xba, 0xff, 0x5c, 0xba,
+    0xd1, 0xd1, 0xe9, 0xce, 0xf9, 0x3a, 0x90, 0xff, 0x6d, 0xcd, 0xcd, 0xd5, 0x86, 0x2e, 0x98, 0xce,
+    0x9d, 0x98, 0x16, 0x59, 0xe6, 0xb7, 0x30, 0x6a, 0xf1, 0x90, 0x55, 0x24, 0x00, 0x5c, 0x37, 0xd0,
+    0x88, 0xdf, 0x0f, 0xc1, 0xef, 0x95, 0xf2, 0x7f, 0x58, 0xee, 0xae, 0x84, 0x8c, 0xac, 0x8b, 0xaa,
+    0x46, 0x49, 0x4e, 0x2e, 0xa2, 0xf1, 0x51, 0xa5, 0x1f, 0x8a, 0x9a, 0x78, 0x08, 0x34, 0xb4, 0xde,
+    0x69, 0x0f, 0x81, 0xe5, 0x50, 0x5c, 0xe0, 0x54, 0x7d, 0x2e, 0x1c, 0x79, 0x2a, 0x2b, 0x8a, 0x15,
+    0xc1, 0xf3, 0x70, 0x3a, 0x9d, 0x11, 0x65, 0x79, 0x81, 0xd9, 0x7c, 0x48, 0x19, 0x55, 0xa8, 0xb1,
+    0x9a, 0xa2, 0xf6, 0x08, 0xd4, 0x1f, 0x92, 0x38, 0x0d, 0xb1, 0x6b, 0xd6, 0x90, 0x12, 0x17, 0x9a,
+    0x2e, 0xd4, 0x74, 0xb0, 0xcb, 0x50, 0x16, 0x9b, 0x19, 0x19, 0xab, 0xb8, 0x79, 0xc0, 0x65, 0x44,
+    0xb4, 0x54, 0x1d, 0x88, 0xc0, 0x46, 0x17, 0x1b, 0x83, 0x7f, 0x9e, 0x10, 0x61, 0x40, 0xbb, 0x4f,
+    0x18, 0xbe, 0x48, 0x18, 0x57, 0x7a, 0xeb, 0x59, 0xb7, 0xca, 0xc2, 0x6c, 0x93, 0x09, 0xb7, 0xc2,
+    0x5b, 0x9c, 0x64, 0xc1, 0x64, 0xa0, 0x30, 0x94, 0x4b, 0x67, 0x66, 0x02, 0x95, 0x3a, 0xe9, 0x56,
+    0xc0, 0x51, 0x8d, 0xc9, 0x71, 0xa6, 0x72, 0xff, 0xfc, 0xc4, 0xb9, 0x0a, 0xfe, 0xe6, 0x76, 0x38,
+    0xfa, 0xd3, 0x61, 0xfd, 0x0c, 0x2c, 0xed, 0x47, 0x13, 0x3d, 0xa5, 0x04, 0x71, 0x8f, 0xb2, 0x99,
+    0xad, 0xf4, 0x69, 0xbb, 0xb6, 0xf5, 0x64, 0x41, 0x3f, 0x6a, 0xbb, 0x85, 0x5f, 0xa3, 0x09, 0x19,
+    0x48, 0x79, 0x5d, 0xa1, 0x4c, 0x44, 0x44, 0xbb, 0xa2, 0x4f, 0x44, 0x4c, 0xa9, 0x56, 0xdc, 0xe3,
+    0x78, 0x28, 0x18, 0xad, 0xd1, 0xfb, 0xd1, 0x8d, 0x21, 0xb8, 0xc6, 0xc8, 0x1a, 0xbf, 0x03, 0xae,
+    0x28, 0x04, 0x38, 0x1b, 0x89, 0x0f, 0x0e, 0xda, 0x77, 0x8b, 0xfa, 0xca, 0x43, 0x55, 0xa5, 0x33,
+    0x8b, 0xfc, 0x78, 0xeb, 0x4d, 0x1c, 0x58, 0x2c, 0x02, 0x28, 0x84, 0x1b, 0x40, 0x6c, 0x33, 0x0b,
+    0xfb, 0xb2, 0xa9, 0x2f, 0xac, 0xab, 0xaa, 0x99, 0x59, 0xd4, 0xf7, 0x9a, 0xd2, 0xa2, 0x22, 0xcf,
+    0xb0, 0x2d, 0x7c, 0x4f, 0x35, 0x92, 0xaf, 0xcf, 0x04, 0x36, 0x8e, 0x33, 0x39, 0x29, 0x99, 0x52,
+    0x92, 0xce, 0x75, 0x34, 0x7b, 0xcf, 0xce, 0x85, 0x83, 0x89, 0xe5, 0x53, 0x0c, 0xc5, 0xb6, 0x50,
+    0xf0, 0xdf, 0xa1, 0xc9, 0x21, 0x71, 0xd1, 0xdf, 0x36, 0x84, 0x44, 0x4d, 0xa1, 0x2c, 0x95, 0xaa,
+    0x3b, 0x95, 0x34, 0xf2, 0xb2, 0x86, 0xfe, 0x9b, 0xc5, 0x87, 0x1c, 0x16, 0x29, 0xfd, 0xa3, 0x8c,
+    0x94, 0xc4, 0x1d, 0x63, 0xff, 0xa8, 0xb2, 0xc4, 0xe2, 0x51, 0x8f, 0x55, 0x36, 0xd7, 0x4b, 0xf3,
+    0x06, 0x8b, 0x4c, 0xcf, 0x19, 0x13, 0xec, 0x98, 0x85, 0xb3, 0x4d, 0x51, 0xe1, 0x6a, 0x5a, 0x62,
+    0x3d, 0xbe, 0x84, 0xe3, 0xbb, 0xba, 0xc6, 0x4d, 0xc2, 0xea, 0xa5, 0x5e, 0x7f, 0x0a, 0x4c, 0x77,
+    0xb0, 0x5b, 0x1a, 0x7d, 0xec, 0xc0, 0x74, 0x1d, 0x9a, 0xf7, 0x7e, 0x43, 0x45, 0x37, 0xb5, 0xd0,
+    0xdc, 0xc8, 0x6e, 0xc6, 0xd8, 0x3d, 0x26, 0x99, 0x8e, 0xd0, 0x3d, 0xf9, 0x6c, 0x61, 0x3b, 0x0d,
+    0xd7, 0xb9, 0x63, 0xaa, 0xc0, 0x8c, 0x8d, 0x0c, 0xfb, 0x19, 0x31, 0x90, 0x09, 0x57, 0x84, 0x1c,
+    0x57, 0xac, 0xa6, 0x7d, 0xa6, 0x40, 0x1b, 0x33, 0xa4, 0xd5, 0x20, 0xbf, 0x03, 0x5a, 0xcd, 0xcf,
+    0xfd, 0xe6, 0x76, 0xe8, 0x93, 0xc1, 0x1d, 0xc4, 0x79, 0x72, 0xe0, 0xc4, 0xbd, 0x30, 0xf2, 0x71,
+    0x7c, 0x8b, 0xb8, 0x9c, 0x34, 0xee, 0xd8, 0x80, 0x27, 0x11, 0xbe, 0x41, 0xba, 0xdb, 0x6c, 0x9c,
+    0xe8, 0xd6, 0x06, 0x7d, 0x72, 0xb9, 0x83, 0x38, 0x4f, 0x36, 0x82, 0x38, 0xeb, 0x5b, 0x24, 0xe2,
+    0x2d, 0x41, 0xa4, 0xa3, 0x24, 0xd3, 0x03, 0x96, 0x03, 0x2a, 0x2f, 0x19, 0x66, 0x17, 0x07, 0xb5,
+    0xe3, 0x01, 0x35, 0x3f, 0xa1, 0xb8, 0x3d, 0xc7, 0x74, 0xcd, 0x6e, 0x7c, 0x25, 0x8e, 0x46, 0x66,
+    0xe6, 0x6c, 0xff, 0x90, 0xba, 0x19, 0xc2, 0xe1, 0x18, 0x0c, 0x4e, 0x14, 0x66, 0x41, 0x24, 0x2f,
+    0x35, 0x18, 0xf5, 0x21, 0x8d, 0x31, 0xca, 0xf0, 0xb8, 0xca, 0xc5, 0x81, 0x83, 0x32, 0x79, 0xd5,
+    0x8c, 0xb5, 0xa0, 0x5b, 0x4a, 0x37, 0x08, 0xe9, 0xfd, 0xcd, 0xb8, 0xd2, 0x60, 0x86, 0x61, 0x68,
+    0x35, 0xac, 0xda, 0xb9, 0xb1, 0xab, 0x56, 0x08, 0x92, 0xd7, 0x5a, 0xc4, 0x86, 0x6a, 0xa3, 0xe5,
+    0x69, 0x31, 0xab, 0xf6, 0x6e, 0xf3, 0xa8, 0x58, 0x39, 0xfb, 0xeb, 0x59, 0x9e, 0x74, 0x60, 0xa1,
+    0xce, 0xce, 0xd0, 0x7f, 0xe9, 0x95, 0x06, 0x1e, 0x45, 0x6d, 0xdb, 0x9d, 0x6a, 0x1a, 0xda, 0xe6,
+    0x54, 0x33, 0xc5, 0xac, 0x26, 0x94, 0x79, 0x8b, 0x71, 0x35, 0xed, 0x8a, 0xf9, 0x80, 0xb1, 0x75,
+    0x94, 0xb8, 0xb1, 0x95, 0x32, 0xa7, 0x38, 0x9b, 0x09, 0xd7, 0xf4, 0xe4, 0x83, 0x38, 0x84, 0x40,
+    0xd6, 0x44, 0xeb, 0xa4, 0xb3, 0x48, 0x8e, 0x58, 0x94, 0x41, 0x21, 0x13, 0xb8, 0xc7, 0x47, 0xf2,
+    0xba, 0x22, 0xd7, 0xf1, 0xd8, 0xf0, 0x86, 0x44, 0x51, 0x41, 0xaf, 0xc1, 0x1a, 0x5d, 0xae, 0xee,
+    0x3e, 0xd8, 0xb4, 0x69, 0x97, 0x3a, 0xe5, 0x15, 0x67, 0xd4, 0x09, 0x2a, 0x92, 0xa7, 0x27, 0xfa,
+    0x6a, 0xca, 0xd9, 0xb2, 0xf9, 0x0b, 0x21, 0x4b, 0xeb, 0xd9, 0xf2, 0xac, 0xef, 0xd8, 0x73, 0xcb,
+    0x97, 0x6f, 0x3d, 0x18, 0xb9, 0xd6, 0x95, 0x5d, 0x39, 0xcc, 0x54, 0x27, 0x4e, 0x81, 0x38, 0xef,
+    0xd0, 0xce, 0x2e, 0x5d, 0x3a, 0x68, 0xbb, 0x3a, 0x80, 0x84, 0x76, 0x48, 0xae, 0x08, 0xf2, 0xc8,
+    0x8f, 0xbf, 0x9e, 0x33, 0x36, 0x34, 0x57, 0xc6, 0xed, 0x66, 0x2d, 0xaf, 0x79, 0x09, 0x53, 0xda,
+    0x31, 0x3a, 0xb9, 0x63, 0x6c, 0xd8, 0xf8, 0x0d, 0xd6, 0xb7, 0xc3, 0x4b, 0x15, 0xc6, 0xe3, 0x09,
+    0xa1, 0xe3, 0xd9, 0x1d, 0xee, 0x3b, 0xdd, 0x50, 0x95, 0x15, 0x09, 0xcd, 0x6a, 0xca, 0xf2, 0xae,
+    0xee, 0x74, 0xe7, 0xb1, 0x19, 0x7d, 0x76, 0x1e, 0xd6, 0x5c, 0xc9, 0xc0, 0x33, 0xb8, 0x45, 0x6d,
+    0x78, 0x6f, 0x86, 0xd9, 0x88, 0xb3, 0x28, 0x1f, 0x06, 0x88, 0x23, 0x9d, 0x61, 0x28, 0x59, 0x66,
+    0x12, 0xe9, 0x9e, 0x44, 0x45, 0x3f, 0x05, 0xe6, 0x69, 0x46, 0x62, 0x6d, 0x6b, 0x84, 0xb2, 0xfd,
+    0xb4, 0x5a, 0x7e, 0xa5, 0xca, 0x61, 0x11, 0xf4, 0x7b, 0xff, 0xaa, 0xda, 0x24, 0xe5, 0x4e, 0xde,
+    0xf6, 0xd2, 0x4e, 0x19, 0xd8, 0xbb, 0x56, 0xda, 0x71, 0xb4, 0x61, 0x6e, 0xdc, 0x4f, 0x67, 0xc3,
+    0x47, 0xd3, 0x59, 0xc5, 0x6d, 0xd8, 0x3f, 0xbc, 0xa2, 0x35, 0x9b, 0x3f, 0x1a, 0xf9, 0xcd, 0x91,
+    0xe9, 0x3b, 0x57, 0x46, 0xd9, 0x83, 0xad, 0x90, 0xfd, 0xda, 0x79, 0xf7, 0xf4, 0xad, 0x07, 0xd3,
+    0xeb, 0x06, 0x2c, 0x37, 0x84, 0xc6, 0x23, 0xd4, 0xeb, 0x87, 0xf7, 0x3d, 0x77, 0xff, 0x06, 0x6f,
+    0x9c, 0xfb, 0xb8, 0x5d, 0x28, 0x00, 0x00,
+};
+
+// /scripts/main.js: 21301 bytes source, 17786 minified, 4025 gzipped
+static const uint8_t PORTAL_ASSET_MAIN_JS[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xed, 0x1c, 0xdb, 0x76, 0xdb, 0xc6,
+    0xf1, 0x9d, 0x5f, 0xb1, 0x76, 0xd2, 0x00, 0xb4, 0x44, 0x88, 0x94, 0x2c, 0xc7, 0x11, 0x25, 0xf5,
+    0x50, 0x14, 0x1d, 0xeb, 0x54, 0x94, 0x54, 0x49, 0x76, 0x9a, 0x26, 0xae, 0x02, 0x01, 0x2b, 0x12,
+    0xc7, 0x20, 0xc0, 0x00, 0x0b, 0x49, 0x8c, 0xad, 0x3e, 0xf7, 0xa1, 0x6f, 0x7d, 0xc8, 0x4b, 0xdb,
+    0xbf, 0xe8, 0x0f, 0x34, 0x7f, 0x92, 0x2f, 0xe9, 0xcc, 0x5e, 0x80, 0x05, 0x08, 0xf0, 0x22, 0x3b,
+    0xc9, 0x69, 0x9c, 0xa3, 0x63, 0x09, 0x97, 0x99, 0xd9, 0xb9, 0xed, 0x5c, 0x76, 0x17, 0xbe, 0x4a,
+    0x02, 0x87, 0x79, 0x61, 0x40, 0xe2, 0x61, 0x78, 0x73, 0x4a, 0x63, 0xca, 0xfa, 0xa1, 0x6b, 0xfb,
+    0x66, 0x9d, 0xbc, 0x21, 0x6e, 0xe8, 0x24, 0x23, 0x1a, 0x30, 0x6b, 0x40, 0x59, 0xcf, 0xa7, 0x78,
+    0xb9, 0x37, 0x39, 0x70, 0x4d, 0x23, 0x4a, 0xe1, 0x8c, 0xba, 0x15, 0xb3, 0x89, 0x4f, 0x2d, 0xd7,
+    0x8b, 0xc7, 0xbe, 0x3d, 0x21, 0x3b, 0xc4, 0xb8, 0xf4, 0x43, 0xe7, 0xb5, 0xd1, 0x26, 0x77, 0xb5,
+    0x2b, 0x45, 0x7c, 0xe8, 0xb9, 0xf4, 0xfd, 0x10, 0x0f, 0xc2, 0x80, 0x72, 0xda, 0x37, 0x5e, 0xe0,
+    0x86, 0x37, 0x56, 0x18, 0x38, 0xbe, 0xe7, 0xbc, 0x86, 0x57, 0x6a, 0x30, 0x93, 0x5e, 0x03, 0x2d,
+    0x1c, 0xe2, 0xda, 0x8e, 0xc8, 0x08, 0x09, 0xc1, 0xdb, 0x85, 0x86, 0x6b, 0x13, 0xef, 0x8a, 0x08,
+    0x7c, 0x8b, 0xd9, 0x11, 0x80, 0x92, 0x9d, 0x1d, 0x41, 0x02, 0xe9, 0xf1, 0x8b, 0x6a, 0x96, 0x74,
+    0x81, 0x63, 0x3b, 0xf0, 0x98, 0xf7, 0x1d, 0x7d, 0x16, 0x79, 0x34, 0x70, 0xfd, 0xc9, 0x91, 0x3d,
+    0xa2, 0xa6, 0x17, 0x8c, 0x13, 0x64, 0xac, 0xe6, 0x03, 0xe1, 0x30, 0x61, 0x70, 0x87, 0xf8, 0x46,
+    0xbb, 0x76, 0x15, 0x46, 0xc4, 0xc4, 0xa7, 0x1e, 0x3c, 0x68, 0x02, 0x1b, 0x64, 0x9b, 0x70, 0x68,
+    0xcb, 0xa7, 0xc1, 0x80, 0x0d, 0xc9, 0x27, 0x9f, 0x48, 0x04, 0xf5, 0x60, 0x9b, 0xac, 0x3f, 0x06,
+    0xb8, 0x95, 0x15, 0x45, 0xcf, 0x01, 0x4c, 0x81, 0xe2, 0x0c, 0xed, 0xa8, 0xc3, 0x4c, 0xaf, 0xde,
+    0xae, 0xa1, 0x38, 0x0e, 0xd9, 0x85, 0x41, 0x3a, 0x06, 0xd2, 0x70, 0xc8, 0x36, 0x5c, 0xff, 0xd9,
+    0x40, 0x24, 0x44, 0x70, 0x2c, 0x16, 0x1e, 0x86, 0x37, 0x34, 0xea, 0xda, 0x31, 0x35, 0x01, 0xe1,
+    0x8e, 0xa3, 0x48, 0x1c, 0x5b, 0xc3, 0xf9, 0x0e, 0x70, 0xde, 0xbe, 0x55, 0xd4, 0x9a, 0xda, 0x9b,
+    0xcf, 0xc4, 0x1b, 0x20, 0x07, 0xba, 0x32, 0x1a, 0x9c, 0xb6, 0x14, 0x6e, 0x05, 0x46, 0x40, 0x9a,
+    0x60, 0xad, 0xa1, 0xe7, 0x53, 0x62, 0xe6, 0x65, 0xd8, 0x25, 0x4d, 0x4d, 0x30, 0xc9, 0x76, 0xb3,
+    0x5e, 0x42, 0x68, 0x47, 0x01, 0xc5, 0xc9, 0x65, 0xcc, 0x22, 0x2f, 0x18, 0x98, 0x2d, 0xce, 0xed,
+    0xe2, 0x74, 0xf3, 0x20, 0x0d, 0xd2, 0x5a, 0x70, 0x9c, 0xe6, 0x2a, 0x99, 0x46, 0xc5, 0xa1, 0x23,
+    0xca, 0x92, 0x28, 0x90, 0x2f, 0xf1, 0xc1, 0x4c, 0xe3, 0x9f, 0x44, 0xf4, 0xda, 0xa3, 0x37, 0x26,
+    0xd7, 0x7c, 0x18, 0xc4, 0x4c, 0x18, 0x6b, 0x96, 0x67, 0x5e, 0x49, 0xf4, 0x00, 0xd0, 0xc1, 0x37,
+    0x25, 0xda, 0x58, 0x10, 0x5a, 0x14, 0xb1, 0x21, 0xe1, 0x0d, 0xe9, 0x0d, 0x0f, 0xc4, 0xb0, 0x60,
+    0xb0, 0x07, 0xf2, 0x4d, 0x9d, 0x08, 0x49, 0xda, 0x3a, 0x5f, 0x2f, 0x6d, 0x3f, 0xa1, 0xa9, 0x47,
+    0x5d, 0xe3, 0x9d, 0x7a, 0xaf, 0xa4, 0x73, 0xe1, 0x75, 0xb5, 0x9b, 0x73, 0x02, 0x72, 0xcc, 0xec,
+    0x81, 0xd2, 0x21, 0x6a, 0xbe, 0x89, 0xaa, 0x90, 0x3c, 0x58, 0x5e, 0x10, 0xd0, 0xe8, 0xf9, 0x79,
+    0xff, 0x50, 0x4e, 0x88, 0x3b, 0x42, 0xfd, 0x98, 0xf2, 0xe9, 0x98, 0x8e, 0xb7, 0x18, 0xf2, 0x76,
+    0x3c, 0xb6, 0xc1, 0x04, 0x38, 0x49, 0x77, 0x1e, 0x3a, 0xa1, 0x1f, 0x46, 0x5b, 0xe4, 0x23, 0x77,
+    0x63, 0xfd, 0x6a, 0xfd, 0xaa, 0xfd, 0x70, 0xf7, 0xc7, 0x7f, 0xfd, 0x9d, 0x1c, 0x04, 0x20, 0x8f,
+    0xe7, 0x6e, 0x91, 0xa3, 0x90, 0xf0, 0x2b, 0x82, 0x2e, 0x62, 0x3b, 0x8c, 0x46, 0x31, 0xe8, 0x62,
+    0x64, 0x7b, 0x01, 0x18, 0x7e, 0x7b, 0x0d, 0x09, 0xed, 0xe6, 0x79, 0xd1, 0x74, 0xf3, 0x60, 0x27,
+    0x13, 0xdf, 0x5d, 0x8e, 0x9b, 0xd6, 0x67, 0x9f, 0x3e, 0x71, 0xd7, 0x91, 0x9b, 0x7f, 0xfe, 0x83,
+    0x7c, 0x19, 0x26, 0x91, 0xf4, 0x85, 0x1b, 0xcf, 0xf7, 0xc9, 0x25, 0x25, 0x49, 0x0c, 0xca, 0xb5,
+    0x63, 0xe2, 0x02, 0x41, 0x87, 0x12, 0x34, 0xa3, 0x05, 0x5c, 0x03, 0x7f, 0x81, 0xed, 0xfb, 0x93,
+    0xf4, 0xfd, 0xb6, 0x13, 0xba, 0x54, 0x11, 0xbf, 0xb4, 0x9d, 0xd7, 0x83, 0x28, 0x4c, 0x02, 0x10,
+    0xec, 0xa3, 0xab, 0x4d, 0xfc, 0x69, 0x93, 0xb1, 0xed, 0xba, 0x20, 0xcb, 0x16, 0x59, 0x1f, 0xdf,
+    0x92, 0x27, 0xe3, 0xdb, 0x36, 0xb9, 0x0c, 0x23, 0x97, 0x46, 0x8d, 0xc8, 0x76, 0xbd, 0x24, 0xde,
+    0x22, 0x1b, 0xf8, 0xec, 0x2a, 0x0c, 0x58, 0xe3, 0xca, 0x1e, 0x79, 0xfe, 0x64, 0x0b, 0x82, 0x5c,
+    0x10, 0x02, 0xd3, 0x0e, 0x05, 0xfe, 0x0c, 0xb2, 0xa2, 0x99, 0x7b, 0x05, 0xc4, 0x59, 0xc3, 0x21,
+    0x77, 0x09, 0xc6, 0xab, 0xfe, 0x1f, 0xcf, 0xcf, 0x09, 0x0b, 0xc7, 0x9e, 0x13, 0xaf, 0x12, 0xf0,
+    0x3d, 0x8f, 0x4d, 0xc8, 0xc1, 0x3e, 0x5c, 0xdb, 0x81, 0x4b, 0x86, 0x61, 0xcc, 0x90, 0x6f, 0x62,
+    0xfe, 0xfc, 0x4c, 0x5a, 0x90, 0x7f, 0x6c, 0x5f, 0xb2, 0x5a, 0xb7, 0xa6, 0x0c, 0xb9, 0x8c, 0xa9,
+    0x36, 0x9e, 0x3e, 0xa5, 0x1b, 0x8e, 0x34, 0xd5, 0x4b, 0xee, 0x2c, 0x9a, 0x55, 0x88, 0x99, 0x33,
+    0xd9, 0xc2, 0x5a, 0xd9, 0x22, 0xbf, 0xb4, 0x56, 0x34, 0xa5, 0xc0, 0x4f, 0x1a, 0x49, 0x60, 0xcc,
+    0x1e, 0x66, 0xbf, 0x43, 0x2f, 0x66, 0x14, 0x74, 0x63, 0x1a, 0xfb, 0xc7, 0xfd, 0x2e, 0x8c, 0x81,
+    0xcf, 0x42, 0xdb, 0xa5, 0xae, 0xb1, 0x9a, 0x25, 0x5a, 0xf4, 0xfa, 0x99, 0xb1, 0x0e, 0xa8, 0xa7,
+    0x71, 0xeb, 0xe4, 0xf8, 0x8b, 0xde, 0xe9, 0x45, 0xf7, 0xf8, 0xe8, 0xec, 0xbc, 0x73, 0x74, 0x7e,
+    0x06, 0x1a, 0x7f, 0x53, 0xeb, 0x74, 0xcf, 0x0f, 0x5e, 0xf6, 0x2e, 0xfa, 0x9d, 0x2d, 0xd2, 0x6a,
+    0x36, 0x57, 0x6b, 0xfb, 0x07, 0x67, 0x27, 0x87, 0x9d, 0x2f, 0xf9, 0x83, 0x4d, 0xb8, 0x3f, 0x3b,
+    0xec, 0xf5, 0x4e, 0xf8, 0x5d, 0xd3, 0x6a, 0xae, 0xaf, 0xd6, 0x0e, 0xfa, 0x9d, 0xcf, 0x7b, 0x17,
+    0x2f, 0x4e, 0xf6, 0x3b, 0xe7, 0xbd, 0x8b, 0xb3, 0x5e, 0x77, 0x8b, 0x7c, 0xba, 0x5a, 0xeb, 0x9e,
+    0x76, 0x37, 0xd6, 0x2f, 0xba, 0xcf, 0x7b, 0xdd, 0x3f, 0x88, 0x67, 0xad, 0xda, 0x5d, 0x3b, 0x0b,
+    0xc6, 0xc9, 0xd8, 0xb5, 0x19, 0xed, 0x53, 0x3b, 0x4e, 0x22, 0xea, 0xf6, 0x62, 0xe6, 0x8d, 0xe0,
+    0xde, 0xbc, 0xb1, 0x5f, 0xd3, 0x64, 0x1c, 0x9f, 0xd0, 0x68, 0xdf, 0x9e, 0xac, 0x92, 0x4b, 0x9b,
+    0xc1, 0xf4, 0x9a, 0x74, 0x6d, 0x50, 0x1f, 0x98, 0x2c, 0x8b, 0xd2, 0x23, 0x89, 0x38, 0x2b, 0xde,
+    0x2a, 0x98, 0x06, 0xaa, 0x6c, 0x30, 0x49, 0x43, 0xad, 0x7a, 0x5e, 0x8c, 0xb0, 0xce, 0xc4, 0xf1,
+    0x69, 0xdf, 0x86, 0x48, 0x06, 0x56, 0x8e, 0x62, 0xfa, 0xcc, 0x0f, 0x6d, 0x66, 0x2a, 0x68, 0x0b,
+    0xf8, 0x85, 0x6c, 0x0c, 0x89, 0x4b, 0x82, 0xa5, 0x2a, 0xb4, 0x91, 0xe9, 0x33, 0xea, 0xcc, 0xc1,
+    0x53, 0x60, 0x29, 0x5e, 0xec, 0x53, 0x3a, 0xee, 0xdb, 0x73, 0xd0, 0x24, 0x54, 0x1e, 0xeb, 0x39,
+    0x44, 0xa7, 0x18, 0x10, 0xfb, 0x36, 0x1b, 0x5a, 0x23, 0xfb, 0x16, 0xd3, 0xe1, 0xfa, 0x63, 0xc8,
+    0x81, 0x39, 0xfd, 0x91, 0x47, 0x19, 0x6f, 0x6b, 0x64, 0xe3, 0x49, 0xb3, 0x99, 0x52, 0x71, 0x6d,
+    0x70, 0xcd, 0x13, 0x2c, 0x31, 0x80, 0x4a, 0x11, 0x29, 0x55, 0xc4, 0x8a, 0x3e, 0xda, 0x23, 0xc5,
+    0x70, 0x46, 0x63, 0x82, 0x3c, 0x68, 0xa4, 0x30, 0xc3, 0xff, 0x5e, 0x30, 0xc5, 0xe7, 0x8d, 0x59,
+    0xb0, 0x1f, 0x70, 0x91, 0x41, 0xd7, 0x09, 0xf8, 0x4f, 0xbb, 0x36, 0xdf, 0x7c, 0x38, 0x0e, 0xd4,
+    0x9c, 0x8c, 0xde, 0x32, 0xe9, 0xf3, 0x7c, 0x54, 0x18, 0x1c, 0xe6, 0x8f, 0xb8, 0x30, 0x71, 0x5e,
+    0x65, 0xa4, 0xa1, 0x7c, 0x7a, 0xe6, 0xdd, 0x52, 0x17, 0xaa, 0x11, 0x0e, 0x33, 0xea, 0x0c, 0xd7,
+    0x00, 0xae, 0x6e, 0xe4, 0xea, 0x01, 0x98, 0x77, 0x4e, 0xe2, 0x83, 0xd7, 0xed, 0x09, 0x2e, 0x0f,
+    0xbd, 0x2b, 0x6a, 0xaa, 0xba, 0x8d, 0x85, 0xcc, 0xf6, 0x79, 0x70, 0xbf, 0xe6, 0x85, 0x2a, 0x70,
+    0xca, 0x0b, 0xc1, 0x91, 0x3d, 0xa0, 0x5d, 0x90, 0x8d, 0x65, 0xcf, 0x86, 0x76, 0xbc, 0x97, 0x30,
+    0x16, 0x06, 0xc7, 0x81, 0x3f, 0x39, 0x40, 0x00, 0x2c, 0x7b, 0x6d, 0x88, 0x69, 0x4a, 0x53, 0x7b,
+    0x2f, 0xce, 0xcf, 0x8f, 0x8f, 0x2e, 0x8e, 0x8f, 0x0e, 0xbf, 0xbc, 0xe8, 0x9c, 0x9d, 0xbd, 0xe8,
+    0xf7, 0xf6, 0x2f, 0x0e, 0x8e, 0xce, 0x7b, 0xa7, 0x2f, 0x3b, 0x18, 0xe3, 0x36, 0x9a, 0x50, 0x5b,
+    0xae, 0xad, 0x91, 0x4d, 0x88, 0x44, 0xa8, 0x69, 0x2f, 0x20, 0x23, 0x2f, 0x48, 0x18, 0x8d, 0x79,
+    0xec, 0x72, 0x6c, 0x50, 0x66, 0x4c, 0xfd, 0x94, 0x61, 0x60, 0xbe, 0xb4, 0x34, 0x6d, 0x35, 0xd3,
+    0xd2, 0x53, 0x8c, 0x9b, 0x44, 0x20, 0x42, 0xa1, 0x9c, 0xf9, 0x36, 0x01, 0x51, 0xcf, 0xa8, 0x4f,
+    0x1d, 0x16, 0x46, 0xe6, 0x37, 0x3c, 0xc5, 0x7d, 0x85, 0xd1, 0x6f, 0xe7, 0xa1, 0x37, 0x1a, 0x5c,
+    0x00, 0xca, 0xc5, 0xc7, 0x6f, 0xbc, 0xbb, 0x87, 0xaf, 0xbe, 0xa9, 0x67, 0xa5, 0x07, 0x5b, 0x96,
+    0x0c, 0xa0, 0x68, 0x64, 0x70, 0xda, 0xa5, 0xbc, 0x40, 0x09, 0xa8, 0xae, 0x45, 0x05, 0x63, 0x41,
+    0x45, 0x37, 0x32, 0xeb, 0x5a, 0x99, 0x88, 0x12, 0x64, 0x9a, 0x5e, 0x59, 0x11, 0xe1, 0x50, 0x32,
+    0x13, 0x77, 0x95, 0x3e, 0x76, 0x74, 0x73, 0xec, 0x92, 0x56, 0xbb, 0x56, 0x62, 0xb5, 0x5f, 0xbd,
+    0xa2, 0xd2, 0xa1, 0xb9, 0xd0, 0x59, 0x85, 0xc8, 0xa6, 0x31, 0xdb, 0x05, 0x60, 0x01, 0xa7, 0xe3,
+    0x61, 0xe9, 0x6d, 0xc0, 0x1c, 0xde, 0x84, 0xc9, 0xc9, 0xa3, 0x12, 0x28, 0xd3, 0xcc, 0xc1, 0xa4,
+    0xc5, 0xa3, 0x22, 0x81, 0x65, 0x1f, 0xf2, 0x9a, 0x19, 0x06, 0xb9, 0xca, 0x5b, 0x02, 0x3a, 0x8e,
+    0x59, 0x73, 0xa0, 0x5d, 0x2b, 0x9d, 0x43, 0x2c, 0xc2, 0xf2, 0x36, 0x2d, 0x0f, 0xa6, 0x48, 0x2a,
+    0x1e, 0x84, 0x7b, 0x28, 0x07, 0x89, 0xe8, 0x15, 0x34, 0x8f, 0xc3, 0x53, 0x98, 0xd8, 0x45, 0x0f,
+    0xc1, 0xe8, 0x64, 0xe6, 0xc9, 0xac, 0x69, 0x10, 0x18, 0x91, 0x36, 0x85, 0x78, 0x3a, 0x91, 0x6d,
+    0x4c, 0x73, 0xad, 0x4c, 0xd5, 0xc5, 0xa0, 0xb6, 0x93, 0x69, 0xaa, 0x32, 0x98, 0x49, 0x9c, 0x86,
+    0x23, 0x91, 0x20, 0x9e, 0x71, 0xc3, 0xf0, 0x1e, 0xad, 0xb5, 0x0e, 0x01, 0x40, 0x0f, 0xcc, 0xdd,
+    0xa1, 0x1d, 0x0c, 0x68, 0xac, 0x6c, 0x59, 0x49, 0x95, 0x03, 0x37, 0x1c, 0x01, 0xad, 0x48, 0x16,
+    0x6c, 0xad, 0x13, 0x54, 0xd1, 0x3a, 0x4f, 0xbf, 0xd4, 0xe6, 0x53, 0x70, 0x29, 0xc1, 0x4b, 0x6e,
+    0x27, 0x28, 0x26, 0xe2, 0x78, 0x8a, 0x62, 0xbb, 0x56, 0x91, 0xd7, 0x73, 0x48, 0xd3, 0x79, 0x5d,
+    0x28, 0xbd, 0x40, 0x59, 0xf5, 0x13, 0x73, 0x95, 0x5a, 0x9a, 0x20, 0x8c, 0x1f, 0xff, 0xf6, 0x6f,
+    0xa3, 0x3d, 0x1f, 0x19, 0xaa, 0x33, 0x36, 0x2c, 0x41, 0x17, 0xee, 0xd8, 0x08, 0xc1, 0x1f, 0x71,
+    0x85, 0x01, 0x8a, 0xca, 0x20, 0x24, 0x76, 0xc2, 0x42, 0x90, 0xc7, 0x73, 0x94, 0x97, 0xad, 0x12,
+    0x78, 0x4a, 0x6f, 0xc7, 0x30, 0xbb, 0xa1, 0x18, 0x11, 0xc2, 0xc7, 0xf5, 0x59, 0xe3, 0x0a, 0x9b,
+    0x8d, 0x31, 0x4d, 0x4d, 0x0f, 0xda, 0xb4, 0x1e, 0x3f, 0xc5, 0x6c, 0x35, 0x8b, 0x80, 0xcc, 0xd6,
+    0x25, 0xc8, 0xb3, 0xb0, 0xa0, 0x8f, 0xf2, 0xae, 0x69, 0x03, 0xcc, 0x41, 0x4b, 0x30, 0x31, 0xdf,
+    0x60, 0x86, 0x9c, 0x45, 0x81, 0x67, 0xff, 0x0a, 0x02, 0x50, 0x7b, 0x0c, 0xa3, 0x78, 0x2e, 0x05,
+    0x66, 0xb3, 0x24, 0x6e, 0x5c, 0xda, 0xee, 0xa0, 0x84, 0x86, 0x08, 0x10, 0x04, 0x03, 0xc4, 0x12,
+    0x44, 0x1c, 0xdf, 0x8e, 0x63, 0xac, 0x6e, 0x91, 0x84, 0xfe, 0x8e, 0xc8, 0x1b, 0x7a, 0xeb, 0x50,
+    0x1f, 0x22, 0x26, 0x5b, 0xc4, 0x19, 0xc0, 0xa4, 0x89, 0xcf, 0x8a, 0x64, 0xf3, 0x6f, 0x89, 0x4e,
+    0x51, 0x35, 0xff, 0xe1, 0x00, 0xbd, 0x76, 0xcf, 0x8e, 0x66, 0x4d, 0x57, 0x05, 0x06, 0x0c, 0x46,
+    0x58, 0x8d, 0x6a, 0x68, 0x72, 0xf9, 0xea, 0xc6, 0x73, 0xb1, 0x93, 0x26, 0x06, 0xd4, 0xdd, 0xbf,
+    0x33, 0xf2, 0x10, 0xa5, 0x2c, 0xe9, 0x24, 0x4b, 0x18, 0x63, 0xde, 0x38, 0xde, 0xf7, 0xae, 0x67,
+    0x31, 0xa5, 0x28, 0x21, 0x68, 0xb6, 0x9c, 0x01, 0x77, 0xe7, 0x60, 0x9e, 0x59, 0x88, 0x00, 0xd2,
+    0x40, 0x13, 0x22, 0x92, 0x1c, 0xa7, 0x72, 0xd1, 0xb1, 0x26, 0xe9, 0xcd, 0x9d, 0x64, 0x37, 0x1e,
+    0xc8, 0x5f, 0x32, 0xa5, 0xb6, 0xc8, 0xbe, 0xe8, 0xef, 0x38, 0x28, 0x14, 0x48, 0x2e, 0x38, 0xa3,
+    0x28, 0x48, 0x2d, 0x28, 0x38, 0x6f, 0xbd, 0x51, 0x32, 0x52, 0x51, 0x85, 0xf8, 0x50, 0xc8, 0x11,
+    0x33, 0x83, 0x10, 0x48, 0x28, 0x18, 0x48, 0x12, 0x93, 0xbf, 0xae, 0x37, 0xff, 0xfb, 0x9f, 0x4e,
+    0xdd, 0x02, 0xb6, 0x54, 0x03, 0xa0, 0x72, 0x87, 0x98, 0x25, 0x50, 0x2f, 0x87, 0x81, 0x8b, 0xf5,
+    0xf0, 0x0b, 0x3e, 0x3a, 0x70, 0xba, 0x99, 0x86, 0x53, 0x21, 0x5b, 0x09, 0xc8, 0x7a, 0xea, 0x0d,
+    0x38, 0xb7, 0xf5, 0x37, 0x66, 0x05, 0xd9, 0x47, 0xc5, 0xee, 0xcb, 0x4a, 0x3b, 0x2f, 0x55, 0xaf,
+    0x43, 0xf9, 0x6a, 0x56, 0x0d, 0x39, 0x8d, 0x9e, 0x35, 0x6a, 0xc5, 0x7a, 0x5f, 0x70, 0x70, 0x0e,
+    0x93, 0xb7, 0x2f, 0x2b, 0xcb, 0x9d, 0x62, 0xbc, 0x9d, 0x26, 0x57, 0xec, 0xeb, 0xea, 0x40, 0xf5,
+    0x49, 0xb3, 0xb4, 0x11, 0xe1, 0xcd, 0x87, 0x39, 0x3d, 0x0a, 0x22, 0xd4, 0x45, 0x99, 0x9c, 0x6b,
+    0x39, 0x8a, 0x43, 0xe7, 0x75, 0xd6, 0x26, 0x58, 0x0e, 0x77, 0x38, 0x35, 0xf1, 0x8a, 0xd7, 0xc4,
+    0x9d, 0x61, 0x4d, 0x23, 0x02, 0x05, 0x40, 0xae, 0x3b, 0x29, 0x72, 0xaf, 0xba, 0x54, 0x41, 0xec,
+    0x8c, 0x3b, 0x82, 0x4e, 0x8b, 0x98, 0xa2, 0xda, 0xfe, 0xe1, 0x7b, 0xb8, 0x03, 0x96, 0xe0, 0x51,
+    0x3d, 0x9f, 0xe1, 0xb1, 0x21, 0xd8, 0x17, 0x4d, 0xce, 0xa2, 0x3d, 0x4d, 0x7b, 0x9a, 0x42, 0x9f,
+    0x27, 0x18, 0xae, 0xef, 0x02, 0x59, 0xb0, 0x51, 0xb3, 0xae, 0xf5, 0x2a, 0xed, 0x7b, 0xa6, 0xba,
+    0x22, 0x5d, 0xd5, 0x16, 0xbd, 0x4b, 0xfa, 0xeb, 0x8c, 0x21, 0xb4, 0xdc, 0xf2, 0xe4, 0x0d, 0x73,
+    0x07, 0xdb, 0xab, 0x69, 0x91, 0x78, 0x6b, 0x25, 0xf0, 0xef, 0x99, 0xf0, 0x4a, 0x5a, 0xb6, 0xf5,
+    0xb4, 0x65, 0xbb, 0x4f, 0x12, 0xcc, 0xf9, 0xd5, 0x3d, 0xd3, 0xe1, 0x94, 0x17, 0x4f, 0xb5, 0x93,
+    0xef, 0x94, 0x2c, 0x33, 0xa7, 0x2d, 0xd2, 0xfd, 0x2d, 0x85, 0x2e, 0x9d, 0x42, 0xf3, 0xc8, 0x10,
+    0x40, 0x1c, 0xa1, 0x0a, 0xb1, 0x30, 0xe2, 0x05, 0x26, 0x2e, 0x60, 0x95, 0xcf, 0x3c, 0x08, 0xae,
+    0x8f, 0x70, 0x7d, 0x6b, 0x66, 0x22, 0x2e, 0x52, 0x06, 0x33, 0x7d, 0x88, 0x79, 0x39, 0x9f, 0x7e,
+    0x71, 0xf2, 0xc5, 0x70, 0x29, 0x67, 0x1b, 0xee, 0x7d, 0xc4, 0xb1, 0x45, 0x3a, 0x31, 0xe4, 0x57,
+    0x2f, 0x18, 0x88, 0x68, 0x91, 0x0b, 0xf0, 0x7c, 0xd6, 0xd8, 0x41, 0x02, 0x0d, 0x97, 0x4c, 0xe8,
+    0x64, 0x0c, 0x81, 0x18, 0x9c, 0xdd, 0x02, 0xca, 0x69, 0x9e, 0x2e, 0xa4, 0xe8, 0xb2, 0x0c, 0x0d,
+    0xfd, 0x25, 0x5f, 0x59, 0x9c, 0xa5, 0x01, 0x27, 0x72, 0x36, 0xd6, 0x9d, 0x21, 0x05, 0x09, 0xc1,
+    0x0d, 0xf1, 0x2f, 0x75, 0xdb, 0x1f, 0x7a, 0xf3, 0x86, 0x29, 0x58, 0x44, 0x36, 0x95, 0xb3, 0xf5,
+    0xc5, 0x11, 0x4c, 0x85, 0x62, 0x7d, 0x84, 0x5f, 0x89, 0x6d, 0x4c, 0xbc, 0xd4, 0x57, 0x49, 0xb8,
+    0x2a, 0x2f, 0xc3, 0xdb, 0x59, 0x52, 0x21, 0xce, 0x05, 0x3a, 0x00, 0x5e, 0xa8, 0xad, 0x4e, 0x85,
+    0x87, 0x9b, 0x93, 0xf2, 0x5a, 0xd9, 0xa5, 0xae, 0x33, 0x25, 0x56, 0x7a, 0x10, 0x25, 0xc7, 0xa9,
+    0x68, 0x04, 0xf3, 0xcc, 0x03, 0x7f, 0x92, 0xab, 0xfc, 0xea, 0xe5, 0x4e, 0x0e, 0xee, 0x11, 0x31,
+    0x9f, 0x34, 0x61, 0xb6, 0x6b, 0xed, 0x7c, 0xbd, 0xb2, 0x47, 0x9d, 0xb3, 0xf6, 0x5c, 0x52, 0xc5,
+    0x34, 0x75, 0xb5, 0xe6, 0x8b, 0xab, 0xa6, 0x5c, 0xcc, 0x91, 0xee, 0x9a, 0x29, 0xf1, 0x2a, 0xf1,
+    0xfd, 0x17, 0x72, 0x0e, 0x68, 0x71, 0x4a, 0x37, 0xd9, 0x6a, 0x5e, 0xa6, 0xd4, 0x1b, 0xb8, 0x5f,
+    0x77, 0x51, 0x6f, 0xf1, 0xd4, 0xaa, 0x6d, 0x43, 0x27, 0xdc, 0xfe, 0x29, 0xca, 0xd9, 0x67, 0x29,
+    0xfd, 0x5f, 0xba, 0xa4, 0xcd, 0x17, 0x81, 0xba, 0x42, 0x1f, 0x95, 0x70, 0x5b, 0x94, 0x83, 0xdb,
+    0x83, 0x6b, 0x11, 0xe5, 0x28, 0x8e, 0x57, 0xd8, 0xb6, 0x58, 0x44, 0xa0, 0x22, 0x43, 0xba, 0x99,
+    0x1e, 0x95, 0x0c, 0xdb, 0xae, 0x95, 0x56, 0xe3, 0x79, 0x39, 0xe6, 0xd5, 0xe2, 0xa0, 0xc5, 0xfc,
+    0x38, 0x73, 0x04, 0x51, 0xb5, 0x7b, 0xba, 0x9a, 0xf6, 0x01, 0x79, 0x48, 0x71, 0x7f, 0xa3, 0xcc,
+    0x47, 0x4a, 0x4d, 0x52, 0x44, 0x5c, 0xb4, 0x41, 0xba, 0xbb, 0x47, 0x8b, 0x74, 0x9f, 0xce, 0xe6,
+    0x97, 0x6e, 0x57, 0x30, 0xf8, 0x89, 0x1a, 0x11, 0x8b, 0x86, 0x71, 0x18, 0x46, 0xc6, 0xaa, 0x7c,
+    0x20, 0xab, 0x14, 0xe3, 0xec, 0xf9, 0xf1, 0xe9, 0xb9, 0x21, 0xd7, 0xf7, 0x0a, 0x04, 0x77, 0x77,
+    0x48, 0xeb, 0x29, 0x2e, 0xf1, 0x69, 0x44, 0xb4, 0x5a, 0xa9, 0x40, 0xa9, 0xf7, 0xa7, 0x6e, 0xef,
+    0xf0, 0xb0, 0x77, 0x74, 0xce, 0xcf, 0x19, 0xa5, 0x7b, 0xff, 0x25, 0x44, 0x3f, 0x2b, 0xd0, 0x1c,
+    0x84, 0xa1, 0x3b, 0x45, 0xee, 0xf3, 0xe3, 0xe3, 0xfd, 0xb9, 0x94, 0x1e, 0x6f, 0xe6, 0x29, 0x61,
+    0x2d, 0x14, 0x81, 0xbf, 0x4c, 0x51, 0xeb, 0x1f, 0xef, 0xf7, 0x4e, 0xc1, 0x0b, 0x38, 0xc5, 0xdf,
+    0xba, 0x38, 0x6d, 0xe3, 0xed, 0x3e, 0x5d, 0x5c, 0x6e, 0xde, 0x7d, 0x68, 0x5d, 0x5c, 0xe6, 0x58,
+    0xef, 0xb1, 0x85, 0xe3, 0xe7, 0x0e, 0xf8, 0xe5, 0xfb, 0x6a, 0xe1, 0x74, 0x8a, 0xbf, 0xfe, 0x16,
+    0x6e, 0x5a, 0xda, 0x9f, 0xab, 0x85, 0xe3, 0x47, 0x16, 0xf4, 0x32, 0xf2, 0xbe, 0x3d, 0x5d, 0x2f,
+    0xb0, 0x2f, 0x7d, 0x4a, 0x44, 0xf7, 0x24, 0xda, 0x0e, 0xe2, 0x52, 0x46, 0xc5, 0x66, 0x38, 0xc3,
+    0x35, 0x57, 0x00, 0x75, 0xf3, 0xab, 0xa8, 0x97, 0x13, 0xb2, 0xd9, 0x78, 0xfa, 0xc3, 0xf7, 0x0f,
+    0xf2, 0x07, 0xae, 0x72, 0xdb, 0x63, 0x90, 0xda, 0xde, 0x85, 0x2f, 0xb8, 0x8c, 0x3d, 0x97, 0x2f,
+    0xcb, 0x39, 0x11, 0xd4, 0xe4, 0xd8, 0x41, 0x4a, 0xfa, 0x04, 0x63, 0x2d, 0xb2, 0xb6, 0xd9, 0x68,
+    0x35, 0xd3, 0x3d, 0xf1, 0x72, 0x56, 0xad, 0x3c, 0x87, 0x45, 0x77, 0xd9, 0xc6, 0x2c, 0xfb, 0x3e,
+    0xb8, 0x4c, 0x38, 0x83, 0x36, 0xf1, 0xf1, 0x20, 0x6a, 0x94, 0xb2, 0x00, 0x8d, 0x14, 0xf4, 0x12,
+    0x89, 0xa3, 0x73, 0x0f, 0xbf, 0xbf, 0x4d, 0x68, 0xe0, 0x4c, 0x2c, 0xfd, 0x94, 0x53, 0x25, 0x07,
+    0xe2, 0xc0, 0x2a, 0xdf, 0xc9, 0xc4, 0xc4, 0x7a, 0xed, 0xc5, 0x1e, 0x18, 0xec, 0xcc, 0x0f, 0x19,
+    0xe6, 0x9e, 0xd6, 0xd4, 0xe1, 0x99, 0xac, 0xa2, 0x84, 0x7e, 0xea, 0x8c, 0x61, 0x0b, 0xa3, 0xf5,
+    0x6a, 0x69, 0x71, 0x38, 0xa7, 0x61, 0xd3, 0x9b, 0xe5, 0x5c, 0xa3, 0xf1, 0x85, 0x1d, 0xe1, 0x81,
+    0xbb, 0xb9, 0xb8, 0x0d, 0x75, 0x3e, 0xa1, 0x71, 0x23, 0x30, 0x52, 0xaf, 0xcd, 0xf1, 0xa0, 0x9d,
+    0xb6, 0xd1, 0x1f, 0xa3, 0x02, 0xd0, 0x2f, 0xdd, 0xec, 0xcc, 0x04, 0x6f, 0x19, 0x35, 0x0e, 0xea,
+    0x39, 0x7e, 0x66, 0xe8, 0xad, 0xa0, 0x9f, 0x53, 0x3a, 0x0a, 0xaf, 0xa9, 0x58, 0xca, 0x88, 0xb9,
+    0x6a, 0x72, 0x67, 0x01, 0x5a, 0x15, 0x67, 0x01, 0x22, 0x81, 0xc6, 0x82, 0xd9, 0xc7, 0x93, 0x11,
+    0x88, 0x37, 0xba, 0xea, 0x40, 0x6f, 0x8a, 0x87, 0xa4, 0xd2, 0x9b, 0x99, 0x66, 0x46, 0xb4, 0x9c,
+    0x99, 0x77, 0x89, 0xb6, 0xcf, 0x0c, 0x41, 0x89, 0xbd, 0x14, 0x6f, 0x0f, 0x02, 0x97, 0xa2, 0x15,
+    0x73, 0xc0, 0x0d, 0xf4, 0x89, 0x0c, 0xf4, 0x74, 0x49, 0xbe, 0x8b, 0xe4, 0xa5, 0x18, 0x39, 0x52,
+    0xfc, 0x34, 0x8c, 0xfe, 0x60, 0x5a, 0x1c, 0x2f, 0xf0, 0xbd, 0x80, 0x36, 0xd4, 0xf4, 0x11, 0x3b,
+    0xf1, 0xa9, 0x25, 0x6c, 0xd7, 0xe5, 0xbb, 0xf9, 0xc8, 0x31, 0x37, 0xc1, 0xb4, 0xc8, 0x60, 0x89,
+    0x66, 0xf1, 0x28, 0x56, 0x0c, 0xaf, 0x66, 0x89, 0x81, 0xef, 0xb9, 0x10, 0x3a, 0x29, 0x29, 0x00,
+    0xbe, 0xe3, 0x47, 0xe0, 0xe0, 0x6f, 0xf5, 0x34, 0xd7, 0x11, 0x71, 0xd9, 0x61, 0xea, 0x00, 0x07,
+    0x47, 0xcf, 0x1f, 0xde, 0x30, 0xc4, 0xe1, 0x0d, 0x36, 0x19, 0xd3, 0x9d, 0x87, 0x41, 0x32, 0xba,
+    0xa4, 0xd1, 0xc3, 0x57, 0x46, 0x76, 0x20, 0x22, 0x3d, 0xb6, 0xf1, 0x20, 0x7f, 0xfa, 0x82, 0xcb,
+    0x9d, 0x7b, 0x82, 0x9c, 0x6c, 0x1a, 0xed, 0x52, 0x17, 0x10, 0xfa, 0x98, 0xb1, 0xed, 0xad, 0x74,
+    0x0a, 0xe6, 0xa8, 0x3e, 0x8a, 0x0f, 0xa4, 0x4b, 0x67, 0x81, 0x5a, 0xfd, 0x28, 0x0b, 0x1e, 0xa0,
+    0x85, 0xd2, 0x23, 0x51, 0xed, 0xbc, 0x4d, 0x85, 0x0f, 0x1d, 0x82, 0x5b, 0xcc, 0x31, 0x2d, 0x64,
+    0x86, 0x56, 0x6a, 0x59, 0xdc, 0x84, 0xe9, 0xda, 0x81, 0xa1, 0x26, 0x18, 0x46, 0x69, 0xbe, 0x9a,
+    0xd8, 0x12, 0xd6, 0x96, 0x98, 0xcb, 0xfb, 0xfe, 0xc2, 0xbe, 0x52, 0xe1, 0xf0, 0x0f, 0x84, 0xc3,
+    0xe4, 0x1d, 0x50, 0x3b, 0x10, 0x54, 0xe2, 0x08, 0x15, 0x87, 0x81, 0x8a, 0x03, 0x54, 0x9d, 0x0d,
+    0x5a, 0x84, 0xa2, 0x38, 0x17, 0x54, 0x41, 0x51, 0x3f, 0x26, 0x54, 0x2f, 0x1c, 0x12, 0x92, 0x27,
+    0xb5, 0x75, 0x97, 0xac, 0x93, 0x69, 0xef, 0x03, 0x90, 0xf2, 0x09, 0x22, 0xdd, 0x47, 0xd7, 0x76,
+    0xa3, 0xd1, 0x2e, 0x31, 0xae, 0x74, 0x53, 0xb9, 0x8e, 0xe0, 0xba, 0x73, 0x22, 0x4f, 0xce, 0x6b,
+    0x05, 0x3d, 0x81, 0x54, 0x97, 0xc8, 0xd5, 0x73, 0xf5, 0x3d, 0xbb, 0x72, 0xf6, 0x41, 0x00, 0x98,
+    0x7c, 0x9c, 0xfa, 0xb0, 0x3a, 0x5c, 0x5b, 0x92, 0x2a, 0xfe, 0xdf, 0x8e, 0x8d, 0x65, 0x86, 0x7f,
+    0x53, 0x4b, 0xbd, 0x63, 0xfa, 0x10, 0x31, 0x27, 0x5a, 0x3c, 0x39, 0x8c, 0xb4, 0xd8, 0xd0, 0x8b,
+    0xab, 0x8e, 0x9c, 0x2d, 0x19, 0xdf, 0xee, 0x65, 0x22, 0x14, 0x49, 0xd1, 0xab, 0x66, 0xbb, 0x0c,
+    0xbd, 0xae, 0x32, 0xd0, 0x3b, 0x9c, 0x9d, 0x5e, 0xa8, 0x4a, 0x58, 0x38, 0xea, 0x78, 0x5a, 0x5a,
+    0x42, 0xdd, 0x95, 0xcc, 0x3a, 0xfc, 0x66, 0x41, 0xcc, 0x3b, 0xa4, 0x5f, 0xa8, 0xfb, 0x3c, 0xa0,
+    0xd1, 0xaa, 0x2a, 0x17, 0x76, 0x7e, 0xfa, 0x49, 0x98, 0xa6, 0x93, 0xca, 0xd9, 0xd2, 0xbe, 0xd7,
+    0xf4, 0x2c, 0x54, 0xa9, 0x8b, 0x97, 0xa8, 0x69, 0x79, 0xc8, 0xf1, 0xea, 0x1a, 0x8d, 0x12, 0x5b,
+    0x8b, 0x3e, 0xa7, 0xda, 0x59, 0xaa, 0x36, 0x85, 0x96, 0xd8, 0x0b, 0xca, 0xad, 0x6d, 0x65, 0x27,
+    0xd5, 0x0b, 0x0f, 0xee, 0xcd, 0x5b, 0x71, 0x0b, 0x68, 0xc1, 0xed, 0x24, 0xc1, 0x95, 0x8e, 0x5c,
+    0xcf, 0x91, 0x5a, 0x7e, 0x5e, 0xfd, 0xbc, 0x7b, 0x45, 0xf5, 0x6c, 0xa7, 0x68, 0x79, 0xcd, 0xdd,
+    0xcd, 0x0c, 0x2d, 0x69, 0xfc, 0x67, 0xe1, 0x60, 0x00, 0x53, 0x89, 0xe1, 0x81, 0xbe, 0x83, 0x93,
+    0x67, 0x1e, 0xf5, 0xdd, 0x58, 0x6b, 0xa1, 0x62, 0xfe, 0xa2, 0x8f, 0xc7, 0x92, 0x66, 0x08, 0xe1,
+    0x8d, 0x2f, 0x70, 0x55, 0xf0, 0x42, 0x40, 0x67, 0x3d, 0x94, 0xb8, 0x17, 0x44, 0x67, 0x06, 0x0a,
+    0x0e, 0x77, 0x01, 0x64, 0xae, 0x38, 0xac, 0x32, 0x9d, 0x36, 0x3a, 0x46, 0x0d, 0x8d, 0x9a, 0x8a,
+    0xd2, 0x19, 0x44, 0xb6, 0x99, 0x06, 0x65, 0xaf, 0x06, 0x59, 0x9d, 0x52, 0xe7, 0xb3, 0x03, 0xa5,
+    0x25, 0xb6, 0xaf, 0x9e, 0xf8, 0xc8, 0x42, 0x1c, 0xc5, 0xad, 0xc4, 0x1a, 0x80, 0xa6, 0x6f, 0xec,
+    0xc9, 0x52, 0x38, 0x71, 0x72, 0x19, 0x50, 0xb6, 0x14, 0x8a, 0x1b, 0xc4, 0xad, 0x32, 0x84, 0xb4,
+    0xb7, 0x9e, 0x2d, 0xbc, 0x0c, 0x65, 0xcb, 0xca, 0x2e, 0xdb, 0xd2, 0xe5, 0x84, 0x9f, 0x87, 0x54,
+    0x26, 0xfd, 0x3c, 0x9c, 0x69, 0xf1, 0x25, 0x46, 0xa1, 0xe9, 0xe2, 0x5f, 0xcf, 0x01, 0x53, 0x07,
+    0x27, 0xd7, 0x8f, 0xb3, 0xaf, 0x5b, 0x65, 0xad, 0x31, 0x3e, 0xe1, 0x33, 0x02, 0xd3, 0xc4, 0xda,
+    0x5f, 0xcc, 0xaf, 0xdd, 0x37, 0xad, 0xd5, 0x8d, 0xbb, 0xaf, 0xad, 0xfa, 0x1b, 0xf8, 0x2d, 0x6e,
+    0x3e, 0x5e, 0x53, 0xdf, 0x24, 0x2a, 0x58, 0x8b, 0xd1, 0x98, 0x99, 0xda, 0x47, 0x87, 0x75, 0xd1,
+    0xe3, 0xf2, 0x2f, 0x2d, 0x53, 0x1e, 0xc4, 0x00, 0xa1, 0xc3, 0xa8, 0x48, 0x5c, 0xda, 0xf1, 0x73,
+    0x30, 0x81, 0xc7, 0x4c, 0xc3, 0x32, 0xea, 0xe5, 0x07, 0xf2, 0x1f, 0x17, 0xb2, 0x2b, 0x27, 0xa2,
+    0xef, 0xcd, 0x0b, 0xaa, 0x5f, 0x79, 0xaf, 0xe4, 0xec, 0x10, 0x00, 0xdb, 0x50, 0x8e, 0xbc, 0x7d,
+    0x2b, 0xa1, 0x77, 0xc9, 0xfa, 0xe6, 0x66, 0x19, 0x5f, 0xe9, 0x37, 0xa1, 0xd2, 0x59, 0xde, 0xa5,
+    0x36, 0xd0, 0xe7, 0xb6, 0x0a, 0x19, 0xc0, 0xe7, 0x57, 0x9a, 0xef, 0xac, 0x92, 0xd4, 0x23, 0xe0,
+    0x52, 0xda, 0x19, 0xae, 0xb8, 0xf5, 0xc4, 0xdf, 0x75, 0xe3, 0x55, 0xbb, 0x96, 0x27, 0x62, 0x81,
+    0x5a, 0x7a, 0xb6, 0x33, 0x34, 0xd3, 0xe1, 0x78, 0x38, 0x38, 0x70, 0xb5, 0x9d, 0x63, 0x7c, 0x30,
+    0x23, 0x94, 0x28, 0x04, 0xa1, 0x21, 0x7e, 0xc7, 0xcb, 0x19, 0xbc, 0xb8, 0x67, 0xf5, 0x57, 0x28,
+    0xfb, 0x72, 0x8e, 0x85, 0x60, 0xdc, 0x0f, 0x38, 0x3c, 0x54, 0x07, 0xdd, 0x24, 0x66, 0xe1, 0x88,
+    0x7f, 0x8d, 0x07, 0x09, 0xcf, 0x34, 0xe4, 0x07, 0x9d, 0x04, 0xa1, 0xb1, 0xbc, 0xc0, 0xc5, 0x54,
+    0xe0, 0x2b, 0x8c, 0x46, 0x36, 0xdb, 0x22, 0xb7, 0xb7, 0xb7, 0x96, 0xf6, 0x6f, 0x95, 0x50, 0x90,
+    0x1e, 0x0d, 0xce, 0x48, 0xb3, 0x81, 0x96, 0x44, 0x5f, 0xc9, 0x16, 0xcd, 0x2a, 0xc6, 0x30, 0x44,
+    0xc1, 0x97, 0xfe, 0x2e, 0x0f, 0xe9, 0x85, 0xb8, 0xef, 0xc5, 0x32, 0x2b, 0xe0, 0xca, 0xa0, 0x6c,
+    0xaf, 0x34, 0xeb, 0xe2, 0xa6, 0x8b, 0xd4, 0xeb, 0x22, 0x95, 0x80, 0xd8, 0xcc, 0x91, 0x53, 0x46,
+    0xc3, 0x55, 0x2d, 0xa5, 0x74, 0x3b, 0xb5, 0xb8, 0xe4, 0xa8, 0xaf, 0x97, 0x24, 0x18, 0xd2, 0xdd,
+    0xc3, 0x9d, 0x3a, 0x2f, 0x18, 0x74, 0x7d, 0x0f, 0x9e, 0x9c, 0x02, 0x0c, 0xf2, 0x2c, 0xd1, 0x11,
+    0xc5, 0x62, 0xe1, 0x18, 0xbc, 0x5d, 0x7e, 0x5c, 0x2f, 0xbe, 0x8f, 0xa4, 0xde, 0x60, 0xc8, 0x2b,
+    0x4a, 0x0e, 0x70, 0x19, 0x42, 0xd9, 0x35, 0x42, 0x4b, 0xe5, 0x5a, 0x1c, 0x2f, 0x3e, 0x73, 0xa2,
+    0xd0, 0xf7, 0xa9, 0x7b, 0x02, 0xad, 0xa4, 0x26, 0xf6, 0x4f, 0x28, 0x6f, 0xee, 0xd3, 0xa7, 0xfb,
+    0x0a, 0x2c, 0xe5, 0xd9, 0x2e, 0xc8, 0x23, 0x4a, 0xca, 0x3d, 0xdc, 0xda, 0xe0, 0x86, 0xf3, 0x7c,
+    0x74, 0x03, 0xfd, 0xdb, 0x0c, 0x77, 0x40, 0xab, 0xfb, 0x28, 0xc3, 0xba, 0xc2, 0xaf, 0xec, 0x60,
+    0xe4, 0x86, 0x12, 0x47, 0x6e, 0xa1, 0x48, 0x79, 0xf8, 0xdd, 0xd4, 0xa7, 0xd7, 0xca, 0x49, 0x30,
+    0xaa, 0x95, 0xfa, 0x4e, 0x06, 0x89, 0x6a, 0xe6, 0x60, 0x95, 0x7a, 0x57, 0xc1, 0x35, 0x25, 0xca,
+    0x1b, 0x2a, 0x8e, 0x88, 0x9b, 0x8d, 0x9c, 0x03, 0xb1, 0x23, 0x81, 0x73, 0xd5, 0x12, 0xab, 0x25,
+    0x50, 0x2c, 0x79, 0xae, 0x4b, 0xb1, 0x6a, 0x57, 0x5b, 0x96, 0xd3, 0xa0, 0x30, 0xc7, 0xf2, 0x70,
+    0x7a, 0xaf, 0xcb, 0xd9, 0x39, 0x0f, 0x25, 0x2b, 0xef, 0xc7, 0xfc, 0x39, 0xeb, 0xbf, 0xc9, 0x19,
+    0x59, 0x8c, 0x07, 0xa1, 0x3b, 0x7c, 0x89, 0xdf, 0x9c, 0x02, 0xb3, 0x74, 0x68, 0x5f, 0x7b, 0xf8,
+    0xf5, 0xae, 0x11, 0x8f, 0xc2, 0x90, 0x0d, 0x21, 0xf4, 0xf0, 0x6a, 0x04, 0x1e, 0xe0, 0xbe, 0x0c,
+    0x8d, 0x0c, 0x72, 0x57, 0xe4, 0x5a, 0x37, 0x37, 0x06, 0xa4, 0x65, 0x2c, 0xcd, 0x01, 0x1a, 0x3c,
+    0x8e, 0x19, 0xf5, 0xe2, 0x37, 0x8b, 0xcb, 0x48, 0x29, 0x46, 0x02, 0x2b, 0xe1, 0xc3, 0xcc, 0x44,
+    0xd3, 0xdf, 0x23, 0xea, 0x8f, 0x84, 0x20, 0x72, 0xc2, 0x4e, 0x07, 0x5f, 0xa1, 0x1e, 0x50, 0x41,
+    0xa9, 0x43, 0xc3, 0xc0, 0x95, 0x98, 0x10, 0x45, 0xbd, 0xef, 0xe8, 0x0c, 0xcc, 0x77, 0xc8, 0x6e,
+    0x15, 0xb3, 0x4b, 0x29, 0x2f, 0xbc, 0x8c, 0x69, 0x74, 0xcd, 0x4f, 0x3e, 0x05, 0xf4, 0x86, 0xf4,
+    0x13, 0xc6, 0xbf, 0x45, 0x3c, 0x96, 0x8f, 0xcd, 0xa2, 0xb5, 0xb2, 0x2d, 0x2f, 0xf9, 0x9f, 0x76,
+    0x2c, 0xa7, 0x77, 0x81, 0x85, 0x0a, 0x57, 0x03, 0x5b, 0xf2, 0x42, 0xbe, 0x5a, 0x85, 0x57, 0xe9,
+    0xff, 0x11, 0xb0, 0x6f, 0x33, 0x7b, 0x8b, 0xc7, 0x5a, 0x68, 0x0b, 0x86, 0x9e, 0xef, 0xa2, 0xd8,
+    0xea, 0x01, 0x64, 0x61, 0x16, 0x51, 0x2a, 0x6e, 0xa5, 0x9b, 0x4d, 0xfb, 0x16, 0x4f, 0x13, 0xff,
+    0x03, 0xe6, 0xd8, 0x56, 0xd7, 0x7a, 0x45, 0x00, 0x00,
+};
+
+// /scripts/ota.js: 4589 bytes source, 4189 minified, 1209 gzipped
+static const uint8_t PORTAL_ASSET_OTA_JS[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xd5, 0x57, 0xdb, 0x6e, 0xdb, 0x46,
+    0x10, 0x7d, 0xd7, 0x57, 0xac, 0x53, 0x34, 0x94, 0x1a, 0x67, 0x7d, 0x81, 0xdd, 0x16, 0x92, 0xe5,
+    0x22, 0xbe, 0xc1, 0x46, 0xe5, 0xa4, 0xb0, 0xad, 0x5e, 0x50, 0x14, 0xc6, 0x8a, 0x1c, 0x4a, 0x8c,
+    0xa9, 0x5d, 0x76, 0x77, 0x29, 0xd9, 0x6d, 0xfc, 0x15, 0x7d, 0xed, 0xd7, 0xf5, 0x4b, 0x3a, 0xb3,
+    0xbc, 0x84, 0x96, 0x2c, 0x4a, 0x8e, 0x83, 0x02, 0x7d, 0x13, 0xc9, 0x99, 0xb3, 0x33, 0x67, 0x67,
+    0xce, 0x8c, 0x26, 0x42, 0xb3, 0x34, 0x09, 0x84, 0x85, 0x37, 0xc6, 0x80, 0xed, 0xeb, 0x98, 0x75,
+    0x99, 0xe7, 0x75, 0x1a, 0x61, 0x2a, 0x7d, 0x1b, 0x29, 0xc9, 0xfc, 0x11, 0xf8, 0x37, 0x27, 0x4a,
+    0xf7, 0x9d, 0x95, 0x69, 0xb6, 0xd8, 0x9f, 0x8d, 0x40, 0xf9, 0xe9, 0x18, 0xa4, 0xe5, 0x43, 0xb0,
+    0xc7, 0x31, 0xd0, 0xcf, 0x83, 0xbb, 0xb3, 0xa0, 0xe9, 0x39, 0xe3, 0xcc, 0xf2, 0xc0, 0x4a, 0xaf,
+    0xc5, 0x83, 0xc8, 0x88, 0x41, 0x0c, 0x01, 0xa2, 0x5a, 0x9d, 0x42, 0x67, 0x89, 0x6b, 0x4f, 0x89,
+    0x20, 0x92, 0x43, 0x74, 0x34, 0xf6, 0x2e, 0x06, 0x72, 0x4f, 0x62, 0x71, 0x47, 0x31, 0x0d, 0x62,
+    0xe5, 0xdf, 0x78, 0x35, 0x00, 0x59, 0x1a, 0x17, 0x60, 0xd2, 0xd8, 0x9a, 0xc7, 0x10, 0xa4, 0x92,
+    0xe0, 0x2d, 0x8b, 0xe0, 0x58, 0x6b, 0xa5, 0x6b, 0xbc, 0x43, 0xb0, 0xfe, 0xa8, 0xe9, 0x6d, 0x28,
+    0x2b, 0x36, 0x9c, 0x83, 0xd7, 0x6a, 0x70, 0x3b, 0x02, 0xd9, 0x2c, 0x18, 0x6b, 0x6a, 0x30, 0x89,
+    0x92, 0x06, 0x90, 0x29, 0xa6, 0xc1, 0xa6, 0x5a, 0xb2, 0xe2, 0x15, 0x7f, 0x6f, 0xd0, 0xa0, 0xd5,
+    0x61, 0xf7, 0x73, 0x5e, 0x18, 0xbc, 0x58, 0xce, 0x6d, 0x0d, 0x41, 0x2b, 0xa5, 0xb7, 0xe0, 0x6e,
+    0x42, 0x11, 0x1b, 0xbc, 0x9c, 0x28, 0x64, 0x2e, 0x0e, 0x6e, 0x52, 0xdf, 0x07, 0x63, 0xd8, 0xcb,
+    0x97, 0xcc, 0x3d, 0x87, 0x2a, 0x95, 0x01, 0x45, 0x37, 0xc1, 0x7a, 0x89, 0x64, 0xa8, 0x4e, 0xed,
+    0xd8, 0x55, 0xca, 0x9e, 0xb1, 0x5a, 0xc9, 0xe1, 0xfe, 0x61, 0xaa, 0x35, 0x9e, 0xc4, 0x7e, 0x04,
+    0x6d, 0x30, 0x9b, 0xf6, 0xde, 0x46, 0xfe, 0x81, 0x79, 0xec, 0x55, 0x86, 0xe1, 0x67, 0x26, 0xd7,
+    0x93, 0xcc, 0x04, 0x5f, 0x7b, 0x7b, 0x03, 0xbd, 0x8f, 0x21, 0x97, 0x80, 0xaf, 0x2a, 0x88, 0x3d,
+    0xaa, 0xb6, 0x5a, 0xc0, 0xd8, 0x59, 0xac, 0x8a, 0xe7, 0xea, 0xfb, 0x31, 0x18, 0x41, 0x1f, 0xae,
+    0xa5, 0x18, 0xc3, 0x32, 0x88, 0xcb, 0xe8, 0x0f, 0x98, 0x41, 0x38, 0x17, 0x76, 0xc4, 0x35, 0xb1,
+    0xd3, 0xac, 0x80, 0x19, 0x34, 0x64, 0x1b, 0x6c, 0x6b, 0x73, 0x7b, 0xa7, 0x45, 0xa0, 0xec, 0xfb,
+    0x83, 0x02, 0xb7, 0x60, 0x38, 0x32, 0xd7, 0x12, 0xa6, 0xa0, 0x89, 0xd4, 0x87, 0x87, 0x05, 0xd1,
+    0x84, 0xb9, 0xcb, 0xed, 0xbe, 0x18, 0x0b, 0x3d, 0x8c, 0xe4, 0x6b, 0xab, 0x92, 0x36, 0x82, 0x25,
+    0xb7, 0x1d, 0x96, 0x88, 0x80, 0xee, 0xbf, 0xcd, 0xbe, 0xa5, 0xa7, 0x81, 0xf0, 0x6f, 0x86, 0xee,
+    0xf4, 0x36, 0xfb, 0x22, 0xd8, 0x81, 0x20, 0x10, 0xf8, 0x52, 0xe9, 0x00, 0xf4, 0x6b, 0x8d, 0x85,
+    0x92, 0x9a, 0x36, 0xdb, 0x21, 0x43, 0x5f, 0xc5, 0x4a, 0xa3, 0xcd, 0xd6, 0xee, 0xee, 0x37, 0xdb,
+    0x3b, 0x9d, 0x17, 0xfb, 0x45, 0x4a, 0xff, 0xfc, 0xfd, 0x17, 0xcb, 0x6a, 0x82, 0xbd, 0x99, 0x88,
+    0x28, 0xa6, 0x82, 0x28, 0x33, 0xdc, 0xdb, 0xc0, 0x58, 0xf6, 0xeb, 0x6a, 0x2a, 0x92, 0xc6, 0x8a,
+    0x38, 0xae, 0x56, 0xd5, 0xc2, 0xc6, 0x9d, 0x93, 0x99, 0x0a, 0x61, 0xa9, 0x8e, 0x3b, 0x8d, 0x7b,
+    0x06, 0x58, 0x85, 0x9f, 0x8f, 0x8f, 0x2d, 0xf0, 0xc3, 0xad, 0x7a, 0x3e, 0x36, 0xfd, 0xdd, 0x9d,
+    0xaf, 0x37, 0x67, 0xf8, 0xf8, 0x45, 0xa5, 0x4c, 0x68, 0x40, 0x5d, 0x64, 0x56, 0x51, 0x94, 0x9f,
+    0x9b, 0x91, 0xbc, 0x53, 0xef, 0x97, 0x69, 0xd9, 0x19, 0xf2, 0x80, 0xfe, 0x91, 0x94, 0xa0, 0x4f,
+    0xaf, 0xce, 0x7b, 0xe8, 0x5b, 0x50, 0xf3, 0x1c, 0x1d, 0x2c, 0x2e, 0xa4, 0xe4, 0x7b, 0x05, 0x45,
+    0xbc, 0x82, 0x5b, 0x5b, 0x84, 0x42, 0xbf, 0x8b, 0xeb, 0x03, 0xfa, 0xc8, 0x3e, 0x7c, 0x60, 0x5e,
+    0x5f, 0xde, 0x48, 0x35, 0x95, 0xcc, 0xbd, 0xf9, 0x74, 0x99, 0x2d, 0x83, 0x6b, 0x90, 0x44, 0xfa,
+    0x82, 0xd4, 0xb6, 0xd4, 0x48, 0x87, 0xfd, 0xdf, 0x8a, 0xe4, 0xd3, 0xe7, 0x50, 0x2d, 0x69, 0xde,
+    0x5b, 0xb0, 0x53, 0xa5, 0x6f, 0x32, 0x9a, 0xda, 0x4e, 0x43, 0xdc, 0x4f, 0x3e, 0x46, 0xbd, 0x15,
+    0x43, 0x78, 0x3e, 0x71, 0x2d, 0x22, 0x6f, 0x1a, 0xc9, 0x40, 0x4d, 0x39, 0x76, 0xc7, 0xf1, 0x04,
+    0x01, 0x7a, 0x91, 0xb1, 0x80, 0x51, 0x34, 0xbd, 0xa3, 0x77, 0xe7, 0x87, 0x4a, 0x5a, 0x7a, 0x87,
+    0x2c, 0x41, 0xe0, 0xad, 0xb3, 0x92, 0x5e, 0x62, 0x76, 0x6e, 0xdc, 0x67, 0x88, 0xe5, 0x3a, 0xf0,
+    0xa0, 0xbe, 0x9d, 0x07, 0x49, 0xda, 0xda, 0xc3, 0xe6, 0xa6, 0xd7, 0x22, 0x06, 0x6d, 0x9b, 0xde,
+    0x5b, 0x95, 0xef, 0x17, 0xac, 0x7f, 0xd1, 0x63, 0xa2, 0xd0, 0x18, 0x0f, 0x31, 0xb3, 0xd9, 0x58,
+    0x89, 0x16, 0x33, 0x10, 0x74, 0x08, 0x1f, 0x69, 0x08, 0x29, 0x27, 0x37, 0x65, 0xf1, 0x3c, 0x9b,
+    0x9a, 0xef, 0x4a, 0xa1, 0xe8, 0x3a, 0xce, 0xa4, 0xaf, 0x02, 0xe8, 0x5f, 0x9c, 0x1d, 0xaa, 0x31,
+    0x4e, 0x56, 0x4c, 0xa7, 0x39, 0x13, 0x42, 0x6d, 0x7f, 0x21, 0x2e, 0xe6, 0x38, 0x46, 0x1e, 0xe7,
+    0x19, 0x32, 0xe9, 0x60, 0x1c, 0xd9, 0x2a, 0x2f, 0x34, 0xc9, 0x1b, 0xc0, 0x13, 0x0d, 0x64, 0x79,
+    0x04, 0xa1, 0xc0, 0xd6, 0x22, 0x66, 0x68, 0x1a, 0x86, 0x51, 0x8c, 0x8d, 0x9a, 0xa4, 0xae, 0x25,
+    0xea, 0x7b, 0xd2, 0xab, 0xb8, 0xd0, 0xd0, 0x2d, 0x3c, 0x39, 0xfd, 0x32, 0xbf, 0x6e, 0xfe, 0x96,
+    0xcd, 0x87, 0x35, 0x7a, 0xac, 0x50, 0xf8, 0x43, 0x0c, 0x02, 0xfb, 0xd4, 0x40, 0x0c, 0xbe, 0x65,
+    0x02, 0xfd, 0xf4, 0x78, 0x4a, 0x02, 0x45, 0x76, 0xfc, 0x21, 0x93, 0xa5, 0x3f, 0xa7, 0x81, 0xc6,
+    0x41, 0x06, 0xe6, 0xa7, 0xc8, 0xe2, 0xc2, 0xc2, 0x07, 0x11, 0x96, 0x73, 0x0d, 0xea, 0x44, 0xc4,
+    0x51, 0xc0, 0xc8, 0xac, 0xf6, 0x00, 0x17, 0x3f, 0x52, 0x77, 0x84, 0xdd, 0x8f, 0x39, 0xe0, 0x0c,
+    0x63, 0x27, 0xf9, 0x23, 0x31, 0x52, 0x7c, 0xe2, 0x22, 0x49, 0xf0, 0xf0, 0x32, 0xf3, 0x75, 0x87,
+    0x95, 0xe7, 0x7f, 0x3b, 0xd2, 0xb9, 0xeb, 0xcf, 0xe7, 0xbd, 0x53, 0x6b, 0x93, 0x0b, 0xf8, 0x3d,
+    0xc5, 0x51, 0x4e, 0x00, 0x35, 0x14, 0xc6, 0x58, 0xb0, 0x4f, 0xdd, 0x2a, 0x13, 0xad, 0x86, 0xb8,
+    0x7c, 0x99, 0x4b, 0x70, 0x57, 0xf9, 0x49, 0x0d, 0x9d, 0x15, 0xe0, 0x63, 0xcd, 0xdc, 0x77, 0x31,
+    0xa1, 0xd4, 0x70, 0xce, 0x11, 0x01, 0xf3, 0xe2, 0x59, 0x98, 0x8f, 0x94, 0x55, 0x11, 0xc9, 0x5c,
+    0x61, 0xd1, 0x95, 0x01, 0x8f, 0x41, 0x0e, 0xed, 0x88, 0xaa, 0x39, 0xb5, 0x94, 0x5b, 0xb1, 0x6c,
+    0x25, 0xa0, 0x7d, 0xc4, 0xa1, 0x0f, 0x31, 0x58, 0x2a, 0x9b, 0xca, 0xca, 0x41, 0x7e, 0xae, 0x8b,
+    0x71, 0xd9, 0x00, 0x6e, 0xb1, 0xaa, 0xb1, 0xf5, 0xbe, 0xc2, 0xd1, 0xb8, 0xd9, 0x5a, 0x81, 0x93,
+    0x03, 0xf1, 0x51, 0x48, 0xa6, 0x51, 0x60, 0x47, 0x08, 0x3e, 0x7b, 0x1c, 0x2e, 0x2f, 0x5f, 0x7a,
+    0x2b, 0x63, 0x55, 0xc9, 0x59, 0x80, 0x74, 0xef, 0xe4, 0x84, 0x98, 0x9a, 0xa7, 0x88, 0x72, 0x99,
+    0xd5, 0x23, 0x62, 0x87, 0xac, 0xb3, 0x4b, 0x60, 0xdd, 0x6e, 0x97, 0x6d, 0x63, 0x7a, 0x75, 0x33,
+    0x60, 0xd9, 0x7d, 0xe1, 0xf4, 0xcf, 0x62, 0x5a, 0x63, 0x27, 0xb1, 0x30, 0xa3, 0xf2, 0xfe, 0x56,
+    0x90, 0x8b, 0x27, 0x0f, 0x94, 0x7c, 0x93, 0x3e, 0xcf, 0xd4, 0xbd, 0xae, 0xfe, 0x50, 0xb7, 0xae,
+    0xa2, 0x31, 0xa8, 0xd4, 0x36, 0xab, 0x0c, 0xb0, 0x85, 0xe2, 0xe8, 0xe1, 0xdf, 0x88, 0x75, 0xba,
+    0x6c, 0x77, 0xdd, 0xcb, 0xa7, 0x39, 0x2c, 0x9a, 0x49, 0x97, 0xa0, 0x71, 0x89, 0xce, 0xff, 0xab,
+    0x60, 0x31, 0x55, 0x66, 0xd3, 0x47, 0xea, 0x3b, 0x4b, 0x80, 0x57, 0xc8, 0xf0, 0xa9, 0xbd, 0x9d,
+    0xff, 0x2b, 0x79, 0x4e, 0x73, 0x97, 0xab, 0xd6, 0xe2, 0xaa, 0xcb, 0x16, 0x96, 0x99, 0xb2, 0x7b,
+    0x3a, 0x89, 0x79, 0x6d, 0x85, 0x38, 0xe0, 0x20, 0xe0, 0x2c, 0x97, 0x57, 0xab, 0xef, 0x98, 0x18,
+    0x8a, 0x48, 0xd6, 0xd6, 0xd7, 0xff, 0x80, 0xc0, 0x9c, 0x3e, 0x85, 0xaa, 0x8e, 0xb3, 0xe3, 0xdd,
+    0xe5, 0x15, 0x32, 0xe6, 0xe6, 0xb3, 0x97, 0x7f, 0x31, 0x24, 0xf7, 0x85, 0xfc, 0x67, 0x5b, 0xc3,
+    0xbf, 0xbc, 0x96, 0x7e, 0xf5, 0x5d, 0x10, 0x00, 0x00,
+};
+
+// /scripts/ota-status.js: 3391 bytes source, 3017 minified, 865 gzipped
+static const uint8_t PORTAL_ASSET_OTA_STATUS_JS[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xcd, 0x56, 0x4b, 0x53, 0xdb, 0x30,
+    0x10, 0xbe, 0xe7, 0x57, 0x6c, 0x0f, 0x1d, 0x39, 0x03, 0x15, 0xf4, 0x75, 0x81, 0x09, 0x07, 0x5e,
+    0x33, 0x0c, 0x50, 0x18, 0x02, 0xe7, 0x8e, 0x62, 0x6f, 0x88, 0x8a, 0x22, 0xa5, 0x92, 0x1c, 0x37,
+    0x03, 0xf9, 0xef, 0x5d, 0xc9, 0x96, 0x81, 0xc0, 0x90, 0x36, 0x70, 0xe0, 0x90, 0x8c, 0xad, 0x7d,
+    0x68, 0x1f, 0xdf, 0xee, 0xe7, 0xa9, 0xb0, 0x50, 0x4e, 0x0a, 0xe1, 0xb1, 0xef, 0x85, 0xf5, 0x58,
+    0x40, 0x0f, 0x86, 0x42, 0x39, 0xdc, 0xee, 0x4c, 0x49, 0x34, 0xb1, 0xe6, 0xda, 0xa2, 0x73, 0x47,
+    0xda, 0xa3, 0x9d, 0x0a, 0x45, 0x52, 0x5d, 0x2a, 0x55, 0x0b, 0x87, 0x42, 0x2a, 0x2c, 0xce, 0x8d,
+    0x52, 0x8e, 0xce, 0x37, 0xb7, 0x3b, 0xc3, 0x52, 0xe7, 0x5e, 0x1a, 0xdd, 0x78, 0x3c, 0x6f, 0x8c,
+    0xb3, 0x2e, 0xdc, 0x76, 0x86, 0xe8, 0xf3, 0x51, 0xc6, 0x36, 0x8c, 0x17, 0x1b, 0xc9, 0x2b, 0xeb,
+    0x76, 0xb8, 0x1f, 0xa1, 0xce, 0x92, 0x61, 0x46, 0xa7, 0x13, 0xa3, 0x1d, 0x92, 0x05, 0x58, 0xf4,
+    0xa5, 0xd5, 0x90, 0x8e, 0xf8, 0x2f, 0x47, 0x0a, 0xdd, 0x6d, 0x98, 0x3f, 0xb1, 0xa2, 0xcb, 0x44,
+    0xbc, 0x63, 0x31, 0x20, 0x39, 0x84, 0x28, 0xe4, 0x52, 0xa7, 0x60, 0x82, 0x5e, 0xcc, 0x0c, 0x6d,
+    0x8e, 0xda, 0x93, 0x5e, 0x54, 0x68, 0x5e, 0xf7, 0xcc, 0x78, 0xa2, 0xd0, 0x37, 0xd9, 0xdf, 0x0c,
+    0x48, 0x7c, 0x2a, 0xfc, 0x88, 0x5b, 0x53, 0xea, 0xa2, 0x76, 0x35, 0x98, 0x79, 0x74, 0xfb, 0xa6,
+    0xd2, 0xca, 0x88, 0x82, 0xea, 0xb5, 0x01, 0x9f, 0x37, 0xbf, 0x7c, 0xeb, 0xd6, 0x16, 0x9e, 0xd2,
+    0x53, 0xc7, 0xcf, 0x99, 0x45, 0xc9, 0x6e, 0xb0, 0xbd, 0xb7, 0x28, 0x4c, 0x5e, 0x8e, 0xe9, 0x56,
+    0x7e, 0x8d, 0xfe, 0x40, 0x61, 0x78, 0xdc, 0x9d, 0x1d, 0x15, 0x19, 0x4b, 0x05, 0xda, 0x15, 0x96,
+    0x75, 0xb9, 0xf3, 0x33, 0x85, 0xbc, 0x92, 0x85, 0x1f, 0x91, 0xe3, 0x14, 0xf8, 0x1a, 0xb0, 0x8f,
+    0xec, 0x9f, 0x7d, 0x48, 0xad, 0xd1, 0x5e, 0xe2, 0x1f, 0xff, 0xd4, 0x43, 0x28, 0x52, 0x8a, 0x7b,
+    0x07, 0x36, 0x43, 0x81, 0x96, 0x3a, 0x0d, 0x9e, 0x16, 0xbc, 0x52, 0xb1, 0xc8, 0x21, 0x1c, 0xef,
+    0x52, 0x7e, 0x8c, 0x1e, 0x93, 0xcb, 0xfa, 0x90, 0xee, 0x99, 0x77, 0xe6, 0x80, 0x84, 0x2c, 0x68,
+    0xbb, 0xb2, 0x50, 0x74, 0xe8, 0xf5, 0x7a, 0x54, 0x9a, 0x18, 0x41, 0xae, 0x50, 0xd8, 0x84, 0xba,
+    0x6c, 0x11, 0x86, 0x2f, 0xd5, 0xce, 0x79, 0xe1, 0x4b, 0x77, 0x29, 0xbd, 0xc2, 0x85, 0x08, 0xd9,
+    0x91, 0x26, 0xa1, 0x52, 0x52, 0x5f, 0x73, 0xce, 0xd9, 0x52, 0x1f, 0xa7, 0x74, 0xa3, 0xb8, 0x7e,
+    0xe2, 0xe5, 0x50, 0xda, 0x71, 0x25, 0x2c, 0x42, 0xd1, 0x82, 0x80, 0xc3, 0xbd, 0x6b, 0x10, 0xba,
+    0x20, 0xd0, 0x0e, 0x8c, 0xf1, 0xcb, 0x2f, 0x7a, 0xa9, 0xd1, 0x8c, 0x4a, 0xb1, 0x62, 0x87, 0x93,
+    0x29, 0x95, 0x9c, 0x86, 0x25, 0x17, 0x61, 0xf4, 0xda, 0x69, 0x41, 0x6b, 0x8d, 0x5d, 0x18, 0x97,
+    0xb5, 0xb5, 0x1a, 0x07, 0x0f, 0x27, 0x68, 0xa7, 0x07, 0x5f, 0xff, 0xaf, 0x15, 0xbf, 0x4b, 0xb4,
+    0xb3, 0x3e, 0x2a, 0xcc, 0xbd, 0xb1, 0x19, 0xe3, 0x6e, 0x12, 0x83, 0x6a, 0x33, 0x2b, 0xa4, 0x9b,
+    0x28, 0x31, 0x0b, 0x01, 0x6a, 0xa3, 0x91, 0xad, 0xd6, 0xc5, 0x7d, 0x9c, 0xca, 0x9c, 0x50, 0xe4,
+    0xe0, 0x22, 0x55, 0x79, 0xe5, 0x5e, 0x5e, 0x8e, 0x10, 0x86, 0xa9, 0x9f, 0x23, 0xe1, 0x60, 0x80,
+    0xa8, 0x41, 0xd6, 0xcd, 0xa4, 0xe1, 0x76, 0x65, 0x9e, 0x93, 0xe5, 0x90, 0x76, 0xde, 0x8c, 0x43,
+    0xd0, 0x2e, 0xda, 0xdb, 0xb5, 0xa9, 0xde, 0x4b, 0x9f, 0x57, 0x99, 0x57, 0x96, 0xc6, 0xae, 0xc1,
+    0x49, 0xf8, 0xaf, 0xa4, 0x26, 0x50, 0x73, 0x51, 0x14, 0x07, 0x53, 0xf2, 0x71, 0x22, 0x9d, 0x47,
+    0xb2, 0xc8, 0xd8, 0xfe, 0xd9, 0xe9, 0x9e, 0xa1, 0x8e, 0xd3, 0x59, 0x04, 0x3c, 0x5b, 0x87, 0x16,
+    0x4f, 0x69, 0xa3, 0x96, 0x56, 0x9d, 0x0b, 0x2b, 0xc6, 0x61, 0xf7, 0x6a, 0xac, 0xe0, 0xea, 0xe2,
+    0xa4, 0x4f, 0xc8, 0xc9, 0x47, 0xf5, 0x69, 0xd6, 0x38, 0x57, 0x86, 0xf0, 0x48, 0x76, 0xdc, 0x45,
+    0x61, 0xb3, 0x38, 0x85, 0x73, 0xe8, 0xaf, 0x6c, 0x20, 0x98, 0xd6, 0x4f, 0xc8, 0x26, 0x63, 0x51,
+    0xf2, 0x93, 0x0e, 0x59, 0xb7, 0xc6, 0xe8, 0x87, 0xa4, 0xfb, 0xe2, 0xa6, 0x7a, 0x01, 0x40, 0x07,
+    0x61, 0x00, 0x56, 0x86, 0xcc, 0xa9, 0x74, 0x2e, 0x8c, 0x79, 0xcd, 0x71, 0x21, 0x4b, 0xf6, 0xaa,
+    0x11, 0xa8, 0x69, 0x2e, 0x54, 0x3f, 0x24, 0xf7, 0x88, 0x8b, 0xbb, 0x90, 0x84, 0x8b, 0x14, 0xed,
+    0x6d, 0x49, 0x1c, 0xf5, 0x0c, 0x3b, 0x53, 0x65, 0xda, 0x51, 0x7d, 0xcc, 0xc2, 0xeb, 0xf0, 0x9d,
+    0x56, 0x6b, 0xc3, 0xdc, 0xc6, 0x8e, 0xf7, 0x69, 0x03, 0x37, 0x9d, 0x3a, 0x6c, 0x5e, 0x89, 0x5d,
+    0x3b, 0x49, 0xc4, 0xc5, 0x64, 0x82, 0x44, 0x5e, 0x0f, 0xea, 0xbf, 0xde, 0x76, 0x29, 0xe8, 0x3d,
+    0xe0, 0xf3, 0x66, 0x5e, 0x48, 0xe1, 0x16, 0xc6, 0xe8, 0x47, 0xa6, 0xd8, 0x02, 0x76, 0x7e, 0xd6,
+    0xbf, 0xa4, 0x93, 0x81, 0x29, 0x66, 0x5b, 0xf7, 0x17, 0xce, 0xdf, 0x98, 0xf2, 0x5b, 0x2e, 0x69,
+    0x26, 0x75, 0x55, 0x4c, 0x24, 0x42, 0x7f, 0x2b, 0x6e, 0x90, 0x61, 0x95, 0x04, 0x98, 0xdc, 0x93,
+    0x44, 0x24, 0x86, 0x76, 0xb5, 0x3c, 0xda, 0x26, 0x95, 0x54, 0xaa, 0xd9, 0x25, 0x20, 0x4a, 0x6f,
+    0xc6, 0x34, 0x21, 0x39, 0xa9, 0xcd, 0xa0, 0xa2, 0xac, 0x21, 0x6f, 0x26, 0x35, 0xc4, 0xd5, 0x70,
+    0xe8, 0xab, 0xd6, 0x72, 0xcc, 0xe0, 0xd3, 0xc0, 0xfc, 0x59, 0x65, 0x33, 0x47, 0xfa, 0x78, 0x3e,
+    0xfd, 0xd8, 0x88, 0x28, 0x87, 0xbb, 0x3b, 0x60, 0x57, 0xfa, 0x86, 0x76, 0xa4, 0x06, 0x5c, 0x36,
+    0x6f, 0x51, 0xa1, 0x8f, 0xb1, 0xb3, 0xcf, 0x85, 0x34, 0xa0, 0x9d, 0x71, 0xb3, 0x94, 0xce, 0xde,
+    0x61, 0x41, 0xd8, 0x0f, 0xf4, 0x95, 0xb1, 0x37, 0x75, 0x09, 0xb6, 0xe2, 0x77, 0x51, 0x7c, 0xe4,
+    0xe3, 0x5a, 0xff, 0x2d, 0x8a, 0xd2, 0x8d, 0xbf, 0xbf, 0xd7, 0x59, 0x86, 0xb8, 0xc9, 0x0b, 0x00,
+    0x00,
+};
+
+static const PortalAsset PORTAL_ASSETS[] = {
+    { "/styles.css", "text/css", "\"b8fb9c6f\"", PORTAL_ASSET_STYLES_CSS, sizeof(PORTAL_ASSET_STYLES_CSS), 10333 },
+    { "/scripts/main.js", "application/javascript", "\"d756d8e6\"", PORTAL_ASSET_MAIN_JS, sizeof(PORTAL_ASSET_MAIN_JS), 17786 },
+    { "/scripts/ota.js", "application/javascript", "\"f57e96bc\"", PORTAL_ASSET_OTA_JS, sizeof(PORTAL_ASSET_OTA_JS), 4189 },
+    { "/scripts/ota-status.js", "application/javascript", "\"b88659d7\"", PORTAL_ASSET_OTA_STATUS_JS, sizeof(PORTAL_ASSET_OTA_STATUS_JS), 3017 },
+};
+
+#define PORTAL_ASSET_COUNT (sizeof(PORTAL_ASSETS) / sizeof(PORTAL_ASSETS[0]))
+
+#endif // CONFIG_PORTAL_ASSETS_H
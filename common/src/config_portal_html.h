@@ -8,7 +8,7 @@
 // Battery Life Estimator HTML Template
 // This is the static HTML structure for the battery life estimator widget
 // JavaScript will populate the dynamic values (battery life, power consumption, etc.)
-const char* CONFIG_PORTAL_BATTERY_ESTIMATOR_HTML = R"(
+const char CONFIG_PORTAL_BATTERY_ESTIMATOR_HTML[] = R"(
 <div class='battery-estimator'>
   <div class='battery-estimator-header'>
     <span style='font-size: 24px;'>🔋</span>
@@ -84,7 +84,7 @@ const char* CONFIG_PORTAL_BATTERY_ESTIMATOR_HTML = R"(
 
 // Factory Reset Modal HTML Template
 // This is the confirmation modal that appears when user clicks factory reset
-const char* CONFIG_PORTAL_RESET_MODAL_HTML = R"(
+const char CONFIG_PORTAL_RESET_MODAL_HTML[] = R"(
 <div id='resetModal' class='modal'>
   <div class='modal-content'>
     <h2 style='color: #dc2626; margin-bottom: 15px;'>⚠️ Confirm Factory Reset</h2>
@@ -100,14 +100,14 @@ const char* CONFIG_PORTAL_RESET_MODAL_HTML = R"(
 )";
 
 // Footer Template - use String.replace("%VERSION%", actual_version)
-const char* CONFIG_PORTAL_FOOTER_TEMPLATE = R"(
+const char CONFIG_PORTAL_FOOTER_TEMPLATE[] = R"(
 <div style='text-align: center; margin-top: 30px; padding-top: 20px; border-top: 1px solid #e0e0e0; color: #999; font-size: 12px;'>
   Inkplate Dashboard v%VERSION%
 </div>
 )";
 
 // OTA Page - Static HTML Content
-const char* CONFIG_PORTAL_OTA_CONTENT_HTML = R"(
+const char CONFIG_PORTAL_OTA_CONTENT_HTML[] = R"(
 <div class='warning-banner'>
 <strong>⚠️ Important:</strong> Do not power off the device during the update process. The device will restart automatically after a successful update.
 </div>
@@ -169,13 +169,13 @@ const char* CONFIG_PORTAL_OTA_CONTENT_HTML = R"(
 
 // Page Header Template - reusable HTML header for all portal pages
 // This reduces code duplication across different page generation functions
-const char* CONFIG_PORTAL_PAGE_HEADER_START = R"(<!DOCTYPE html><html><head>
+const char CONFIG_PORTAL_PAGE_HEADER_START[] = R"(<!DOCTYPE html><html><head>
 <meta charset='UTF-8'>
 <meta name='viewport' content='width=device-width, initial-scale=1.0'>
 )";
 
 // OTA Status Page - Custom CSS for spinner and status displays
-const char* CONFIG_PORTAL_OTA_STATUS_STYLES = R"(
+const char CONFIG_PORTAL_OTA_STATUS_STYLES[] = R"(
 <style>
 .spinner { border: 4px solid #f3f3f3; border-top: 4px solid #0066cc; border-radius: 50%; width: 40px; height: 40px; animation: spin 1s linear infinite; margin: 20px auto; }
 @keyframes spin { 0% { transform: rotate(0deg); } 100% { transform: rotate(360deg); } }
@@ -185,7 +185,7 @@ const char* CONFIG_PORTAL_OTA_STATUS_STYLES = R"(
 )";
 
 // VCOM Warning Section - Critical safety warning for VCOM management page
-const char* CONFIG_PORTAL_VCOM_WARNING_HTML = R"(
+const char CONFIG_PORTAL_VCOM_WARNING_HTML[] = R"(
 <div style='background: #fef2f2; border: 2px solid #fee2e2; border-radius: 8px; padding: 15px; color: #991b1b;'>
 <strong style='font-size: 16px;'>⚠️ Caution:</strong><br>
 Changing the VCOM value can permanently damage your e-ink display if set incorrectly. 
@@ -195,7 +195,7 @@ Only proceed if you know what you are doing!<br><br>
 )";
 
 // VCOM Test Pattern Section - Instructions for test pattern display
-const char* CONFIG_PORTAL_VCOM_TEST_PATTERN_HTML = R"(
+const char CONFIG_PORTAL_VCOM_TEST_PATTERN_HTML[] = R"(
 <div class='help-text'>
 Your device is now displaying a test pattern with 8 grayscale bars. 
 Compare the visual quality as you adjust VCOM values. Look for smooth gradients and good contrast.
@@ -203,7 +203,7 @@ Compare the visual quality as you adjust VCOM values. Look for smooth gradients
 )";
 
 // Floating Battery Badge HTML
-const char* CONFIG_PORTAL_BADGE_HTML = R"(
+const char CONFIG_PORTAL_BADGE_HTML[] = R"(
 <div class='floating-battery-badge hidden' onclick='scrollToBattery()'>
   <div class='badge-label'>Battery Life</div>
   <div class='badge-value'>-- days</div>
@@ -215,7 +215,7 @@ const char* CONFIG_PORTAL_BADGE_HTML = R"(
 // %MESSAGE% - main success message
 // %SUBMESSAGE% - secondary message
 // %REDIRECT_INFO% - redirect information (optional)
-const char* CONFIG_PORTAL_SUCCESS_PAGE_TEMPLATE = R"(
+const char CONFIG_PORTAL_SUCCESS_PAGE_TEMPLATE[] = R"(
 <div class='success'>
 <h1>✅ Success!</h1>
 <p style='margin-top: 15px;'>%MESSAGE%</p>
@@ -227,7 +227,7 @@ const char* CONFIG_PORTAL_SUCCESS_PAGE_TEMPLATE = R"(
 // Error Page Template - use with String.replace()
 // %ERROR% - error message to display
 // %REDIRECT_INFO% - redirect information (optional)
-const char* CONFIG_PORTAL_ERROR_PAGE_TEMPLATE = R"(
+const char CONFIG_PORTAL_ERROR_PAGE_TEMPLATE[] = R"(
 <div class='error'>
 <h1>❌ Error</h1>
 <p style='margin-top: 15px;'>%ERROR%</p>
@@ -236,7 +236,7 @@ const char* CONFIG_PORTAL_ERROR_PAGE_TEMPLATE = R"(
 )";
 
 // Factory Reset Success Template
-const char* CONFIG_PORTAL_FACTORY_RESET_SUCCESS = R"(
+const char CONFIG_PORTAL_FACTORY_RESET_SUCCESS[] = R"(
 <div class='success'>
 <h1>🔄 Factory Reset Complete</h1>
 <p style='margin-top: 15px;'>All configuration has been erased.</p>
@@ -246,7 +246,7 @@ const char* CONFIG_PORTAL_FACTORY_RESET_SUCCESS = R"(
 )";
 
 // Reboot Success Template
-const char* CONFIG_PORTAL_REBOOT_SUCCESS = R"(
+const char CONFIG_PORTAL_REBOOT_SUCCESS[] = R"(
 <div class='success'>
 <h1>🔄 Rebooting</h1>
 <p style='margin-top: 15px;'>The device is restarting now.</p>
@@ -256,7 +256,7 @@ const char* CONFIG_PORTAL_REBOOT_SUCCESS = R"(
 )";
 
 // OTA Status Page Content - HTML structure for firmware update progress page
-const char* CONFIG_PORTAL_OTA_STATUS_CONTENT_HTML = R"(
+const char CONFIG_PORTAL_OTA_STATUS_CONTENT_HTML[] = R"(
 <div class='status-box'>
 <div class='spinner'></div>
 <h2 id='statusTitle'>Downloading Firmware...</h2>
@@ -284,7 +284,7 @@ const char* CONFIG_PORTAL_OTA_STATUS_CONTENT_HTML = R"(
 )";
 
 // Firmware Update button
-const char* CONFIG_PORTAL_FIRMWARE_UPDATE_BUTTON = R"(
+const char CONFIG_PORTAL_FIRMWARE_UPDATE_BUTTON[] = R"(
 <div style='margin-top: 20px;'>
 <a href='/ota' style='display: block; text-decoration: none;'>
 <button type='button' class='btn-secondary'>⬆️ Firmware Update</button>
@@ -293,7 +293,7 @@ const char* CONFIG_PORTAL_FIRMWARE_UPDATE_BUTTON = R"(
 )";
 
 // Reboot button
-const char* CONFIG_PORTAL_REBOOT_BUTTON = R"(
+const char CONFIG_PORTAL_REBOOT_BUTTON[] = R"(
 <div style='margin-top: 10px;'>
 <form method='POST' action='/reboot' style='display: block;'>
 <button type='submit' class='btn-secondary' style='width: 100%;'>🔄 Reboot Device</button>
@@ -302,7 +302,7 @@ const char* CONFIG_PORTAL_REBOOT_BUTTON = R"(
 )";
 
 // Factory Reset & VCOM danger zone section start
-const char* CONFIG_PORTAL_DANGER_ZONE_START = R"(
+const char CONFIG_PORTAL_DANGER_ZONE_START[] = R"(
 <div class='factory-reset-section'>
 <div class='danger-zone'>
 <h2>⚠️ Danger Zone</h2>
@@ -311,13 +311,13 @@ const char* CONFIG_PORTAL_DANGER_ZONE_START = R"(
 )";
 
 // VCOM management button (only for non-Inkplate2 boards)
-const char* CONFIG_PORTAL_VCOM_BUTTON = R"(
+const char CONFIG_PORTAL_VCOM_BUTTON[] = R"(
 <p style='margin-top:20px;'>VCOM management allows you to view and adjust the display panel's VCOM voltage. This is an advanced feature for correcting image artifacts or ghosting. Use with caution.</p>
 <button class='btn-danger' style='width:100%; margin-top:10px;' onclick="window.location.href='/vcom'">⚠️ VCOM Management</button>
 )";
 
 // Factory Reset & VCOM danger zone section end
-const char* CONFIG_PORTAL_DANGER_ZONE_END = R"(
+const char CONFIG_PORTAL_DANGER_ZONE_END[] = R"(
 </div>
 </div>
 )";
@@ -330,4 +330,169 @@ const char* CONFIG_PORTAL_DANGER_ZONE_END = R"(
 #define SECTION_END() \
     "</div></div>"
 
+// ============================================================================
+// Configuration page templates
+// Streamed by renderConfigPage() (config_page.cpp); %NAME% placeholders are
+// filled from the stored configuration, see the comment above each template.
+// ============================================================================
+
+// %STYLES_URL%, %SUBTITLE%, %DEVICE_NAME%, %NETWORK_INFO%
+const char CONFIG_PAGE_HEAD_TEMPLATE[] = R"(<title>Inkplate Dashboard Setup</title><link rel='stylesheet' href='%STYLES_URL%'></head><body>
+<div class='container'><h1>📊 Inkplate Dashboard</h1><p class='subtitle'>%SUBTITLE%</p>
+<div class='device-info'><strong>Device:</strong> %DEVICE_NAME%<br>%NETWORK_INFO%</div>
+<form action='/submit' method='POST'>
+)";
+
+// %SSID_VALUE%, %PASSWORD_VALUE%, %PASSWORD_HINT% (attribute / hint when stored),
+// %FRIENDLY_NAME%, %FRIENDLY_NAME_HELP%, %NETWORK_SETTINGS% (CONFIG_MODE only)
+const char CONFIG_PAGE_WIFI_TEMPLATE[] = SECTION_START("📶", "WiFi Network") R"(
+<div class='form-group'><label for='ssid'>WiFi Network Name (SSID) *</label><input type='text' id='ssid' name='ssid' required placeholder='Enter your WiFi network name'%SSID_VALUE%></div>
+<div class='form-group'><label for='password'>WiFi Password</label><input type='password' id='password' name='password' placeholder='Enter WiFi password (leave empty if none)'%PASSWORD_VALUE%>%PASSWORD_HINT%</div>
+<div class='form-group'><label for='friendlyname'>Device Name (optional)</label><input type='text' id='friendlyname' name='friendlyname' placeholder='e.g., Living Room' value='%FRIENDLY_NAME%' maxlength='24' oninput='sanitizeFriendlyNamePreview()'>
+<div id='friendlyname-preview' style='font-size: 13px; margin-top: 5px; color: #666;'></div>
+<div class='help-text'>%FRIENDLY_NAME_HELP%</div></div>
+%NETWORK_SETTINGS%)" SECTION_END() "\n";
+
+const char CONFIG_PAGE_FRIENDLY_NAME_HELP_BOOT[] = "Set a friendly name now to access Step 2 via <code>yourname.local</code> (instead of IP address). "
+    "Rules: lowercase letters (a-z), digits (0-9), hyphens (-), max 24 characters. Leave empty to use MAC-based ID.";
+
+const char CONFIG_PAGE_FRIENDLY_NAME_HELP_CONFIG[] = "Optional user-friendly name for MQTT topics, Home Assistant, and network hostname (e.g., <code>kitchen.local</code>). "
+    "Rules: lowercase letters (a-z), digits (0-9), hyphens (-), max 24 characters. No leading/trailing hyphens. Leave empty to use MAC-based ID. "
+    "<strong>⚠️ Changing this creates a new device in Home Assistant</strong> (old entities will stop updating).";
+
+// %DHCP_CHECKED%, %STATIC_CHECKED%, %STATIC_FIELDS_STYLE%, %STATIC_IP%, %GATEWAY%, %SUBNET%, %DNS1%, %DNS2%
+const char CONFIG_PAGE_NETWORK_TEMPLATE[] = R"(<div class='form-group' style='margin-top: 20px; padding-top: 20px; border-top: 1px solid #e0e0e0;'>
+<label style='font-weight: bold; display: block; margin-bottom: 10px;'>🌐 Network Configuration</label>
+<div class='help-text' style='margin-bottom: 15px;'>Choose between automatic IP assignment (DHCP) or manual static IP configuration. Static IP can reduce wake time by 0.5-2 seconds per cycle.</div>
+<div style='margin-bottom: 15px;'>
+<label style='display: flex; align-items: center; gap: 8px; margin-bottom: 8px;'><input type='radio' name='ip_mode' value='dhcp' id='ip_mode_dhcp'%DHCP_CHECKED% onchange='toggleStaticIPFields()'><span>DHCP (Automatic) - Default</span></label>
+<label style='display: flex; align-items: center; gap: 8px;'><input type='radio' name='ip_mode' value='static' id='ip_mode_static'%STATIC_CHECKED% onchange='toggleStaticIPFields()'><span>Static IP (Manual)</span></label>
+</div>
+<div id='static_ip_fields'%STATIC_FIELDS_STYLE%>
+<div class='form-group'><label for='static_ip'>IP Address *</label><input type='text' id='static_ip' name='static_ip' placeholder='e.g., 192.168.1.100' value='%STATIC_IP%' pattern='^(\d{1,3}\.){3}\d{1,3}$'><div class='help-text'>Enter the static IP address for this device</div></div>
+<div class='form-group'><label for='gateway'>Gateway *</label><input type='text' id='gateway' name='gateway' placeholder='e.g., 192.168.1.1' value='%GATEWAY%' pattern='^(\d{1,3}\.){3}\d{1,3}$'><div class='help-text'>Usually your router's IP address</div></div>
+<div class='form-group'><label for='subnet'>Subnet Mask *</label><input type='text' id='subnet' name='subnet' placeholder='e.g., 255.255.255.0' value='%SUBNET%' pattern='^(\d{1,3}\.){3}\d{1,3}$'><div class='help-text'>Typically 255.255.255.0 for home networks</div></div>
+<div class='form-group'><label for='dns1'>Primary DNS *</label><input type='text' id='dns1' name='dns1' placeholder='e.g., 8.8.8.8' value='%DNS1%' pattern='^(\d{1,3}\.){3}\d{1,3}$'><div class='help-text'>Google DNS (8.8.8.8) or Cloudflare (1.1.1.1)</div></div>
+<div class='form-group'><label for='dns2'>Secondary DNS (Optional)</label><input type='text' id='dns2' name='dns2' placeholder='e.g., 8.8.4.4' value='%DNS2%' pattern='^(\d{1,3}\.){3}\d{1,3}$'><div class='help-text'>Backup DNS server (optional)</div></div>
+</div>
+</div>
+)";
+
+// %IMAGE_SLOTS%, %ADD_BUTTON_STYLE%, %PREFETCH_COUNT%, %PREFETCH_MAX%, %PREFETCH_MAX_HOURS%,
+// %TLS_FINGERPRINT%, %TIMEZONE%, %ROTATION_OPTIONS%, %PARTIAL_REFRESH%, %FRONTLIGHT%
+const char CONFIG_PAGE_IMAGES_TEMPLATE[] = SECTION_START("🖼️", "Dashboard Images") R"(
+<div class='help-text' style='margin-bottom: 15px;'>Fill 1 image for single image mode, or 2+ for automatic carousel rotation. Supported formats: PNG, JPEG (baseline encoding only, not progressive) or pre-dithered IKFB. Image must match your screen resolution. URLs ending in .tiles are tile manifests (see documentation).</div>
+%IMAGE_SLOTS%<button type='button' id='addImageBtn' onclick='addImageSlot()'%ADD_BUTTON_STYLE%>➕ Add Another Image (up to 10 total)</button>
+<div class='form-group'><label for='prefetch_count'>Prefetch Next Images (carousel)</label><input type='number' id='prefetch_count' name='prefetch_count' min='0' max='%PREFETCH_MAX%' value='%PREFETCH_COUNT%' placeholder='0'>
+<div class='help-text'>Downloads this many of the following carousel images ahead into flash, so the next timer wakes show them without connecting to WiFi (0 = off, up to %PREFETCH_MAX%). Cached images are checked for changes on the next online wake and are not shown once they are more than %PREFETCH_MAX_HOURS% hours old. Best for short intervals with images that change rarely.</div></div>
+<div class='form-group'><label for='tls_fp'>HTTPS Certificate Fingerprint (optional)</label><input type='text' id='tls_fp' name='tls_fp' placeholder='AB:CD:EF:...' value='%TLS_FINGERPRINT%'>
+<div class='help-text'>SHA-256 fingerprint of your image server's certificate. When set, HTTPS images are only loaded from a server presenting exactly this certificate. Leave empty to accept any certificate. Update it when the server certificate is renewed.</div></div>
+<div class='form-group'><label for='timezone'>Timezone Offset (UTC)</label><input type='number' id='timezone' name='timezone' min='-12' max='14' value='%TIMEZONE%' placeholder='0'>
+<div class='help-text'>Enter your timezone offset (range: -12 to +14). Keep in mind that Daylight Saving Time may apply in your region - you'll need to update this offset when DST changes.</div></div>
+<div class='form-group'><label for='rotation'>Screen Rotation</label><select id='rotation' name='rotation'>%ROTATION_OPTIONS%</select>
+<div class='help-text'>Select the orientation of your display. Important: Your images must be oriented to match this setting (e.g., for 90° portrait, provide a portrait-oriented image).</div></div>
+%PARTIAL_REFRESH%%FRONTLIGHT%)" SECTION_END() "\n";
+
+// Carousel rows - %SLOT% (0-based), %SLOT_NUMBER% (1-based), %SLOT_STYLE%, %URL%, %INTERVAL%, %STAY_CHECKED%
+const char CONFIG_PAGE_FIRST_IMAGE_SLOT_TEMPLATE[] = R"(<div class='image-slot' id='slot_%SLOT%'><label>Image %SLOT_NUMBER% URL *</label>
+<input type='text' name='img_url_%SLOT%' placeholder='https://example.com/image%SLOT_NUMBER%.png' value='%URL%' required>
+<label>Display for (minutes) *</label><input type='number' name='img_int_%SLOT%' min='0' placeholder='5' value='%INTERVAL%' required>
+<div class='help-text'>Set to 0 for button-only mode (no automatic refresh - wake by button press only)</div>
+<label style='display: flex; align-items: center; gap: 10px; margin-top: 10px;'><input type='checkbox' name='img_stay_%SLOT%'%STAY_CHECKED%>Stay on this image (advance on button press)</label></div>
+)";
+
+const char CONFIG_PAGE_IMAGE_SLOT_TEMPLATE[] = R"(<div class='image-slot' id='slot_%SLOT%'%SLOT_STYLE%><div style='display: flex; justify-content: space-between; align-items: center;'><label>Image %SLOT_NUMBER% URL</label>
+<button type='button' class='btn-remove' id='remove_%SLOT%' onclick='removeLastImageSlot()'>❌ Remove</button></div>
+<input type='text' name='img_url_%SLOT%' placeholder='https://example.com/image%SLOT_NUMBER%.png' value='%URL%'>
+<label>Display for (minutes)</label><input type='number' name='img_int_%SLOT%' min='0' placeholder='5' value='%INTERVAL%'>
+<div class='help-text'>Set to 0 for button-only mode (no automatic refresh - wake by button press only)</div>
+<label style='display: flex; align-items: center; gap: 10px; margin-top: 10px;'><input type='checkbox' name='img_stay_%SLOT%'%STAY_CHECKED%>Stay on this image (advance on button press)</label></div>
+)";
+
+// Boards with a grayscale panel (not Inkplate 2) - %PARTIAL_REFRESH_CHECKED%, %FULL_REFRESH_EVERY%, %DEFAULT_FULL_REFRESH_EVERY%
+const char CONFIG_PAGE_PARTIAL_REFRESH_TEMPLATE[] = R"(<div class='form-group checkbox-group'><label><input type='checkbox' name='partial_refresh' id='partial_refresh' %PARTIAL_REFRESH_CHECKED%> Partial refresh (black and white)</label>
+<div class='help-text'>Redraw only the parts of the screen that changed, without the full-screen flash. Images are shown in black and white (dithered) instead of grayscale. An unchanged image does not refresh the screen at all.</div></div>
+<div class='form-group'><label for='full_refresh_every'>Full Refresh Every (partial refreshes)</label><input type='number' id='full_refresh_every' name='full_refresh_every' min='0' max='100' value='%FULL_REFRESH_EVERY%' placeholder='%DEFAULT_FULL_REFRESH_EVERY%'>
+<div class='help-text'>Partial refreshes leave faint ghosting; a full refresh after this many partial ones clears it (default %DEFAULT_FULL_REFRESH_EVERY%, 0 = always full). Only used with partial refresh enabled.</div></div>
+)";
+
+// Boards with HAS_FRONTLIGHT - %FRONTLIGHT_DURATION%, %FRONTLIGHT_BRIGHTNESS%
+const char CONFIG_PAGE_FRONTLIGHT_TEMPLATE[] = R"(<div class='form-group'><label for='frontlight_duration'>Frontlight Duration (seconds)</label><input type='number' id='frontlight_duration' name='frontlight_duration' min='0' max='255' value='%FRONTLIGHT_DURATION%' placeholder='0'>
+<div class='help-text'>How long to keep the frontlight on during manual button refresh (0 = disabled, default). When set to 0, frontlight is never activated and device goes to sleep immediately after refresh.</div></div>
+<div class='form-group'><label for='frontlight_brightness'>Frontlight Brightness (0-63)</label><input type='number' id='frontlight_brightness' name='frontlight_brightness' min='0' max='63' value='%FRONTLIGHT_BRIGHTNESS%' placeholder='63'>
+<div class='help-text'>Brightness level when frontlight is active (0-63, where 63 is maximum brightness). Not used if duration is set to 0.</div></div>
+)";
+
+// %OVERLAY_ENABLED_CHECKED%, %OVERLAY_POSITION_OPTIONS%, %OVERLAY_SIZE_OPTIONS%, %OVERLAY_COLOR_OPTIONS%,
+// %BATTERY_ICON_CHECKED%, %BATTERY_PCT_CHECKED%, %UPDATE_TIME_CHECKED%, %CYCLE_TIME_CHECKED%
+const char CONFIG_PAGE_OVERLAY_TEMPLATE[] = SECTION_START("📊", "Status Overlay") R"(
+<div class='help-text' style='margin-bottom: 15px;'>Display battery and update status directly on your dashboard images</div>
+<div class='form-group checkbox-group'><label><input type='checkbox' name='overlay_enabled' id='overlay_enabled' %OVERLAY_ENABLED_CHECKED%> Enable status overlay</label>
+<div class='help-text'>Show battery, time, and cycle information on top of dashboard images</div></div>
+<div class='form-group'><label for='overlay_position'>Overlay Position</label><select id='overlay_position' name='overlay_position'>%OVERLAY_POSITION_OPTIONS%</select></div>
+<div class='form-group'><label for='overlay_size'>Overlay Size</label><select id='overlay_size' name='overlay_size'>%OVERLAY_SIZE_OPTIONS%</select></div>
+<div class='form-group'><label for='overlay_color'>Text Color</label><select id='overlay_color' name='overlay_color'>%OVERLAY_COLOR_OPTIONS%</select>
+<div class='help-text'>Choose color for best contrast with your dashboard image background</div></div>
+<div class='help-text' style='margin: 15px 0 10px 0; font-weight: bold;'>Display Options:</div>
+<div class='form-group checkbox-group'><label><input type='checkbox' name='overlay_battery_icon' id='overlay_battery_icon' %BATTERY_ICON_CHECKED%> Show battery icon</label>
+<div class='help-text'>Display battery icon filled to match current percentage</div></div>
+<div class='form-group checkbox-group'><label><input type='checkbox' name='overlay_battery_pct' id='overlay_battery_pct' %BATTERY_PCT_CHECKED%> Show battery percentage</label>
+<div class='help-text'>Display battery percentage as text (e.g., "85%")</div></div>
+<div class='form-group checkbox-group'><label><input type='checkbox' name='overlay_update_time' id='overlay_update_time' %UPDATE_TIME_CHECKED%> Show last update time</label>
+<div class='help-text'>Display time of last image update (e.g., "11:25")</div></div>
+<div class='form-group checkbox-group'><label><input type='checkbox' name='overlay_cycle_time' id='overlay_cycle_time' %CYCLE_TIME_CHECKED%> Show last cycle time</label>
+<div class='help-text'>Display loop duration in seconds (for debugging performance)</div></div>
+)" SECTION_END() "\n";
+
+// %MQTT_BROKER_VALUE%, %MQTT_USER_VALUE%, %MQTT_PASSWORD_VALUE%, %MQTT_PASSWORD_HINT%, %MQTT_BATCHED_CHECKED%
+const char CONFIG_PAGE_MQTT_TEMPLATE[] = SECTION_START("📡", "MQTT / Home Assistant") R"(
+<div class='help-text' style='margin-bottom: 15px;'>Configure MQTT to send battery voltage to Home Assistant (optional)</div>
+<div class='form-group'><label for='mqttbroker'>MQTT Broker URL</label><input type='text' id='mqttbroker' name='mqttbroker' placeholder='mqtt://broker.example.com:1883'%MQTT_BROKER_VALUE%>
+<div class='help-text'>Leave empty to disable MQTT reporting</div></div>
+<div class='form-group'><label for='mqttuser'>MQTT Username (optional)</label><input type='text' id='mqttuser' name='mqttuser' placeholder='username'%MQTT_USER_VALUE%></div>
+<div class='form-group'><label for='mqttpass'>MQTT Password (optional)</label><input type='password' id='mqttpass' name='mqttpass' placeholder='password'%MQTT_PASSWORD_VALUE%>%MQTT_PASSWORD_HINT%</div>
+<div class='form-group checkbox-group'><label><input type='checkbox' name='mqttbatched' id='mqttbatched' %MQTT_BATCHED_CHECKED%> Send all sensors in one message</label>
+<div class='help-text'>Publishes every sensor value as one JSON message on a single state topic instead of one message per sensor, which shortens the time the device stays awake. Home Assistant picks the values out automatically. Existing automations that read the per-sensor topics directly need to use the new topic.</div></div>
+)" SECTION_END() "\n";
+
+// %CRC32_CHECKED%, %CHANGE_DETECTION_OPTIONS%, %HOUR_GRID%, %BATTERY_ESTIMATOR%, %MEASURED_ENERGY%
+const char CONFIG_PAGE_SCHEDULING_TEMPLATE[] = SECTION_START("🕐", "Scheduling") R"(
+<div class='form-group'><label for='crc32check' style='display: flex; align-items: center; gap: 10px;'><input type='checkbox' id='crc32check' name='crc32check'%CRC32_CHECKED%> Enable change detection</label>
+<div class='help-text'>Skips image download & refresh when unchanged. Works in single image mode and carousel mode (for images with stay:true flag). Significantly extends battery life.</div></div>
+<div class='form-group'><label for='change_detection'>Change Detection Method</label><select id='change_detection' name='change_detection'>%CHANGE_DETECTION_OPTIONS%</select>
+<div class='help-text'>CRC32 requires a web server that generates .crc32 checksum files next to each image. HTTP validators work with any server that sends ETag or Last-Modified headers (most static file servers and CDNs) and save one request per wake.</div></div>
+<div class='form-group' style='margin-top: 20px;'><label style='font-size: 16px; margin-bottom: 5px;'>📅 Update Hours</label>
+<div class='help-text' style='margin-bottom: 15px;'>Select which hours the device should perform updates. Unchecked hours will be skipped to save battery.</div>
+<div style='display: grid; grid-template-columns: repeat(4, 1fr); gap: 10px; margin-bottom: 20px;'>
+%HOUR_GRID%</div>
+</div>
+%BATTERY_ESTIMATOR%%MEASURED_ENERGY%)" SECTION_END() "\n";
+
+// Hourly grid cell - %HOUR%, %HOUR_LABEL% (two digits), %NEXT_HOUR_LABEL%, %HOUR_CHECKED%
+const char CONFIG_PAGE_HOUR_TEMPLATE[] = R"(<label style='display: flex; align-items: center; gap: 8px; padding: 8px; background: #f5f5f5; border-radius: 4px; cursor: pointer;'><input type='checkbox' id='hour_%HOUR%' name='hour_%HOUR%' class='hour-checkbox'%HOUR_CHECKED%> <div style='line-height: 1.2;'><div>%HOUR_LABEL%:00</div><div style='font-size: 11px; color: #999; margin-top: 1px;'>to %NEXT_HOUR_LABEL%:00</div></div></label>
+)";
+
+// Shown once wakes were measured - %CYCLE_MAH_DATA%, %AWAKE_SEC_DATA%, %SLEEP_MA_DATA%,
+// %CYCLE_MAH%, %AWAKE_SEC%, %CYCLES%, %SAVED_SETTINGS%
+const char CONFIG_PAGE_MEASURED_ENERGY_TEMPLATE[] = R"(<div class='battery-estimator' id='measured-energy' data-cycle-mah='%CYCLE_MAH_DATA%' data-awake-sec='%AWAKE_SEC_DATA%' data-sleep-ma='%SLEEP_MA_DATA%'>
+<div class='battery-estimator-header'><span style='font-size: 24px;'>📈</span><h3>Measured on This Device</h3></div>
+<div class='battery-details'>
+<div class='battery-detail-item'><span class='battery-detail-label'>Charge Per Wake</span><span class='battery-detail-value'>%CYCLE_MAH% mAh</span></div>
+<div class='battery-detail-item'><span class='battery-detail-label'>Awake Per Wake</span><span class='battery-detail-value'>%AWAKE_SEC% s</span></div>
+<div class='battery-detail-item'><span class='battery-detail-label'>Wakes Averaged</span><span class='battery-detail-value'>%CYCLES%</span></div>
+%SAVED_SETTINGS%</div>
+<div style='font-size: 12px; color: #666; margin-top: 10px;'>With the settings above and the selected battery: <strong id='measured-days'>-</strong></div>
+<div style='font-size: 11px; color: #666; margin-top: 5px;'>Running average of the charge per wake (image updates and unchanged checks) from this board's typical currents and the measured phase times since the last power-on.</div>
+</div>
+)";
+
+// %SUBMIT_LABEL%, %DEVICE_ACTIONS% (CONFIG_MODE: update / reboot / danger zone)
+const char CONFIG_PAGE_FORM_END_TEMPLATE[] = R"(<button type='submit'>%SUBMIT_LABEL%</button></form>
+%DEVICE_ACTIONS%</div>
+)";
+
+// %RESET_MODAL%, %FOOTER%, %MAIN_JS_URL%, %BADGE%
+const char CONFIG_PAGE_TAIL_TEMPLATE[] = R"(%RESET_MODAL%%FOOTER%<script src='%MAIN_JS_URL%'></script>%BADGE%</body></html>
+)";
+
 #endif // CONFIG_PORTAL_HTML_H
@@ -16,6 +16,19 @@ const POWER_CONSTANTS = {
   CRC32_CHECK_SEC: 1
 };
 
+// Same projection as the device's battery life model, from its measured average per wake
+function updateMeasuredEstimate(wakeupsPerDay, batteryCapacity) {
+  const measured = document.getElementById('measured-energy');
+  if (!measured) return;
+  const cycleMah = parseFloat(measured.dataset.cycleMah);
+  const awakeSec = parseFloat(measured.dataset.awakeSec);
+  const sleepMa = parseFloat(measured.dataset.sleepMa);
+  const sleepHours = Math.max(0, 24 - wakeupsPerDay * awakeSec / 3600);
+  const dailyPower = wakeupsPerDay * cycleMah + sleepHours * sleepMa;
+  const days = dailyPower > 0 ? Math.round(batteryCapacity / dailyPower) : 0;
+  document.getElementById('measured-days').textContent = days + ' days (' + dailyPower.toFixed(1) + ' mAh/day)';
+}
+
 function calculateBatteryLife() {
   // Calculate average interval from image slots
   let totalInterval = 0;
@@ -64,6 +77,8 @@ function calculateBatteryLife() {
     const dailyChanges = dailyChangesValue === '' ? 5 : parseInt(dailyChangesValue);
     const buttonPresses = dailyChanges;
     
+    updateMeasuredEstimate(buttonPresses, batteryCapacity);
+    
     // If no button presses expected, truly unlimited battery life
     if (buttonPresses === 0) {
       document.getElementById('battery-days').textContent = '∞';
@@ -132,6 +147,7 @@ function calculateBatteryLife() {
   if (activeHours === 0) activeHours = 24;
   
   const wakeupsPerDay = activeHours * (60 / refreshRate);
+  updateMeasuredEstimate(wakeupsPerDay, batteryCapacity);
   let dailyPower = 0;
   let activeTimeMinutes = 0;
   
@@ -0,0 +1,49 @@
+#include <cycle_pipeline.h>
+
+CyclePipeline::CyclePipeline(PipelineTaskRunner* runner, uint32_t joinTimeoutMs)
+    : _runner(runner), _joinTimeoutMs(joinTimeoutMs),
+      _background(nullptr), _backgroundArg(nullptr), _backgroundMs(0) {
+}
+
+uint32_t CyclePipeline::now() {
+    return _runner != nullptr ? _runner->nowMs() : 0;
+}
+
+void CyclePipeline::backgroundEntry(void* arg) {
+    CyclePipeline* self = static_cast<CyclePipeline*>(arg);
+    uint32_t start = self->now();
+    self->_background(self->_backgroundArg);
+    self->_backgroundMs = self->now() - start;
+}
+
+PipelineResult CyclePipeline::run(PipelineStage foreground, void* foregroundArg,
+                                  PipelineStage background, void* backgroundArg) {
+    PipelineResult result = {};
+    _background = background;
+    _backgroundArg = backgroundArg;
+    _backgroundMs = 0;
+
+    uint32_t start = now();
+    result.overlapped = _runner != nullptr && background != nullptr &&
+                        _runner->start(backgroundEntry, this);
+
+    if (foreground != nullptr) {
+        foreground(foregroundArg);
+    }
+    result.foreground_ms = now() - start;
+
+    if (result.overlapped) {
+        result.timedOut = !_runner->join(_joinTimeoutMs);
+    } else if (background != nullptr) {
+        backgroundEntry(this);  // No task available - same order as the serial cycle
+    }
+
+    result.background_ms = result.timedOut ? 0 : _backgroundMs;
+    result.total_ms = now() - start;
+    return result;
+}
+
+uint32_t getPipelineSavedMs(const PipelineResult& result) {
+    uint32_t serialMs = result.foreground_ms + result.background_ms;
+    return serialMs > result.total_ms ? serialMs - result.total_ms : 0;
+}
@@ -0,0 +1,98 @@
+#ifndef CYCLE_PIPELINE_H
+#define CYCLE_PIPELINE_H
+
+#include <stdint.h>
+
+#define CYCLE_PIPELINE_JOIN_TIMEOUT_MS 15000    // Longest a background stage may outlast the foreground
+
+/**
+ * @brief Overlap two independent stages of the wake cycle
+ *
+ * Pure C++ with NO dependencies on Arduino/ESP32 APIs; the task layer is
+ * behind PipelineTaskRunner so the scheduling is testable on the host with a
+ * mocked runner.
+ *
+ * The panel refresh is CPU/IO-bound on the EPD driver while MQTT is
+ * network-bound, so the background stage (telemetry connect) runs on the
+ * other core while the foreground stage (refresh) runs on the caller's core.
+ * run() always joins before returning. When no background task can be
+ * started the stages simply run one after the other on the caller's core,
+ * foreground first - the same order as without the pipeline.
+ */
+
+/**
+ * @brief A stage of the pipeline
+ */
+typedef void (*PipelineStage)(void* arg);
+
+/**
+ * @brief Task layer: runs one stage in the background
+ */
+class PipelineTaskRunner {
+public:
+    virtual ~PipelineTaskRunner() {}
+
+    /**
+     * @brief Start the stage in the background (on the other core)
+     * @return false if no task could be created - the pipeline then runs it inline
+     */
+    virtual bool start(PipelineStage stage, void* arg) = 0;
+
+    /**
+     * @brief Wait for the stage started by start() to return
+     * @return false if it is still running after timeoutMs
+     */
+    virtual bool join(uint32_t timeoutMs) = 0;
+
+    /**
+     * @brief Monotonic clock in ms (millis() on the device)
+     */
+    virtual uint32_t nowMs() = 0;
+};
+
+/**
+ * @brief Outcome of one pipeline run
+ */
+struct PipelineResult {
+    bool overlapped;            // Background stage ran concurrently on the other core
+    bool timedOut;              // Background stage still running at the join - its state must not be touched
+    uint32_t foreground_ms;     // Foreground stage duration
+    uint32_t background_ms;     // Background stage duration (0 if timed out)
+    uint32_t total_ms;          // Wall time from start until both stages finished (or the join gave up)
+};
+
+class CyclePipeline {
+public:
+    /**
+     * @param runner Task layer, or nullptr to always run the stages serially
+     * @param joinTimeoutMs How long to wait for the background stage after the foreground finished
+     */
+    CyclePipeline(PipelineTaskRunner* runner, uint32_t joinTimeoutMs = CYCLE_PIPELINE_JOIN_TIMEOUT_MS);
+
+    /**
+     * @brief Run the foreground stage on this core while the background stage runs on the other
+     *
+     * Returns only after both stages finished (or the join timed out).
+     */
+    PipelineResult run(PipelineStage foreground, void* foregroundArg,
+                       PipelineStage background, void* backgroundArg);
+
+private:
+    PipelineTaskRunner* _runner;
+    uint32_t _joinTimeoutMs;
+
+    // Written by the background task, read after the join
+    PipelineStage _background;
+    void* _backgroundArg;
+    volatile uint32_t _backgroundMs;
+
+    static void backgroundEntry(void* arg);
+    uint32_t now();
+};
+
+/**
+ * @brief Time saved by overlapping: serial duration minus wall time
+ */
+uint32_t getPipelineSavedMs(const PipelineResult& result);
+
+#endif // CYCLE_PIPELINE_H
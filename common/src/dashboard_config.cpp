@@ -0,0 +1,124 @@
+#include <dashboard_config.h>
+
+static bool hasFlag(const ConfigBlob& blob, uint16_t flag) {
+    return (blob.settings.flags & flag) != 0;
+}
+
+static void setFlag(ConfigBlob& blob, uint16_t flag, bool enabled) {
+    if (enabled) {
+        blob.settings.flags |= flag;
+    } else {
+        blob.settings.flags &= ~flag;
+    }
+}
+
+void readDashboardConfig(const ConfigBlob& blob, DashboardConfig& config) {
+    const ConfigSettings& s = blob.settings;
+    config.isConfigured = hasFlag(blob, CONFIG_FLAG_CONFIGURED);
+    config.wifiSSID = getConfigString(blob, CONFIG_STR_WIFI_SSID);
+    config.wifiPassword = getConfigString(blob, CONFIG_STR_WIFI_PASSWORD);
+    config.friendlyName = getConfigString(blob, CONFIG_STR_FRIENDLY_NAME);
+    config.mqttBroker = getConfigString(blob, CONFIG_STR_MQTT_BROKER);
+    config.mqttUsername = getConfigString(blob, CONFIG_STR_MQTT_USERNAME);
+    config.mqttPassword = getConfigString(blob, CONFIG_STR_MQTT_PASSWORD);
+    config.mqttBatchedState = hasFlag(blob, CONFIG_FLAG_MQTT_BATCHED);
+    config.useCRC32Check = hasFlag(blob, CONFIG_FLAG_USE_CRC32);
+    config.changeDetection = s.changeDetection;
+    if (config.changeDetection > CHANGE_DETECTION_HTTP) {
+        config.changeDetection = CHANGE_DETECTION_CRC32;
+    }
+    config.tlsFingerprint = getConfigString(blob, CONFIG_STR_TLS_FINGERPRINT);
+    
+    // Hourly schedule (3 bytes for 24-bit bitmask)
+    config.updateHours[0] = s.updateHours[0];
+    config.updateHours[1] = s.updateHours[1];
+    config.updateHours[2] = s.updateHours[2];
+    
+    config.timezoneOffset = s.timezoneOffset;
+    config.screenRotation = s.screenRotation;
+    
+    // Partial refresh settings
+    config.partialRefresh = hasFlag(blob, CONFIG_FLAG_PARTIAL_REFRESH);
+    config.fullRefreshEvery = s.fullRefreshEvery;
+    
+    // Static IP configuration (defaults to DHCP)
+    config.useStaticIP = hasFlag(blob, CONFIG_FLAG_USE_STATIC_IP);
+    config.staticIP = getConfigString(blob, CONFIG_STR_STATIC_IP);
+    config.gateway = getConfigString(blob, CONFIG_STR_GATEWAY);
+    config.subnet = getConfigString(blob, CONFIG_STR_SUBNET);
+    config.primaryDNS = getConfigString(blob, CONFIG_STR_PRIMARY_DNS);
+    config.secondaryDNS = getConfigString(blob, CONFIG_STR_SECONDARY_DNS);
+    
+    // Carousel configuration (image count checked by isConfigBlobValid)
+    config.imageCount = s.imageCount;
+    for (uint8_t i = 0; i < MAX_IMAGE_SLOTS; i++) {
+        config.imageUrls[i] = getConfigString(blob, (ConfigStringId)(CONFIG_STR_IMAGE_URL + i));
+        config.imageIntervals[i] = s.imageIntervals[i];
+        config.imageStay[i] = (s.imageStayMask >> i) & 1;
+    }
+    config.prefetchCount = s.prefetchCount;
+    
+    // Frontlight configuration (only for boards with HAS_FRONTLIGHT)
+    config.frontlightDuration = s.frontlightDuration;
+    config.frontlightBrightness = s.frontlightBrightness;
+    
+    // Overlay configuration
+    config.overlayEnabled = hasFlag(blob, CONFIG_FLAG_OVERLAY_ENABLED);
+    config.overlayPosition = s.overlayPosition;
+    config.overlayShowBatteryIcon = hasFlag(blob, CONFIG_FLAG_OVERLAY_BATTERY_ICON);
+    config.overlayShowBatteryPercentage = hasFlag(blob, CONFIG_FLAG_OVERLAY_BATTERY_PCT);
+    config.overlayShowUpdateTime = hasFlag(blob, CONFIG_FLAG_OVERLAY_UPDATE_TIME);
+    config.overlayShowCycleTime = hasFlag(blob, CONFIG_FLAG_OVERLAY_CYCLE_TIME);
+    config.overlaySize = s.overlaySize;
+    config.overlayTextColor = s.overlayTextColor;
+}
+
+void writeDashboardConfig(const DashboardConfig& config, ConfigBlob& blob) {
+    // Every value fits: the strings have the capacity of the stored ones
+    const char* strings[CONFIG_STRING_COUNT] = {
+        config.wifiSSID.c_str(), config.wifiPassword.c_str(), config.friendlyName.c_str(),
+        config.mqttBroker.c_str(), config.mqttUsername.c_str(), config.mqttPassword.c_str(),
+        config.tlsFingerprint.c_str(), config.staticIP.c_str(), config.gateway.c_str(), config.subnet.c_str(),
+        config.primaryDNS.c_str(), config.secondaryDNS.c_str()
+    };
+    for (uint8_t i = 0; i < MAX_IMAGE_SLOTS; i++) {
+        strings[CONFIG_STR_IMAGE_URL + i] = i < config.imageCount ? config.imageUrls[i].c_str() : "";
+    }
+    
+    for (int id = 0; id < CONFIG_STRING_COUNT; id++) {
+        setConfigString(blob, (ConfigStringId)id, strings[id]);
+    }
+    
+    ConfigSettings& s = blob.settings;
+    setFlag(blob, CONFIG_FLAG_MQTT_BATCHED, config.mqttBatchedState);
+    setFlag(blob, CONFIG_FLAG_USE_CRC32, config.useCRC32Check);
+    setFlag(blob, CONFIG_FLAG_PARTIAL_REFRESH, config.partialRefresh);
+    setFlag(blob, CONFIG_FLAG_USE_STATIC_IP, config.useStaticIP);
+    setFlag(blob, CONFIG_FLAG_OVERLAY_ENABLED, config.overlayEnabled);
+    setFlag(blob, CONFIG_FLAG_OVERLAY_BATTERY_ICON, config.overlayShowBatteryIcon);
+    setFlag(blob, CONFIG_FLAG_OVERLAY_BATTERY_PCT, config.overlayShowBatteryPercentage);
+    setFlag(blob, CONFIG_FLAG_OVERLAY_UPDATE_TIME, config.overlayShowUpdateTime);
+    setFlag(blob, CONFIG_FLAG_OVERLAY_CYCLE_TIME, config.overlayShowCycleTime);
+    s.changeDetection = config.changeDetection;
+    s.updateHours[0] = config.updateHours[0];
+    s.updateHours[1] = config.updateHours[1];
+    s.updateHours[2] = config.updateHours[2];
+    s.timezoneOffset = config.timezoneOffset;
+    s.screenRotation = config.screenRotation;
+    s.fullRefreshEvery = config.fullRefreshEvery;
+    s.imageCount = config.imageCount;
+    s.prefetchCount = config.prefetchCount;
+    s.frontlightDuration = config.frontlightDuration;
+    s.frontlightBrightness = config.frontlightBrightness;
+    s.overlayPosition = config.overlayPosition;
+    s.overlaySize = config.overlaySize;
+    s.overlayTextColor = config.overlayTextColor;
+    s.imageStayMask = 0;
+    for (uint8_t i = 0; i < MAX_IMAGE_SLOTS; i++) {
+        bool used = i < config.imageCount;
+        s.imageIntervals[i] = used ? config.imageIntervals[i] : 0;
+        if (used && config.imageStay[i]) {
+            s.imageStayMask |= (1 << i);
+        }
+    }
+}
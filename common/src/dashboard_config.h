@@ -0,0 +1,130 @@
+#ifndef DASHBOARD_CONFIG_H
+#define DASHBOARD_CONFIG_H
+
+#include <stdint.h>
+#include <config_blob.h>
+#include <fixed_string.h>
+
+/**
+ * @brief Configuration as the modes use it
+ *
+ * Pure C++ with NO dependencies on Arduino/ESP32 APIs, making it fully
+ * testable with standard C++ unit testing frameworks.
+ *
+ * Strings have fixed capacity (the limits of the stored blob), so filling
+ * or copying a configuration never touches the heap. ConfigManager owns
+ * the one instance the firmware uses (getConfig()); everything else takes
+ * it by const reference.
+ */
+struct DashboardConfig {
+    FixedString<MAX_SSID_LENGTH> wifiSSID;
+    FixedString<MAX_WIFI_PASSWORD_LENGTH> wifiPassword;
+    FixedString<MAX_FRIENDLY_NAME_LENGTH> friendlyName;  // User-friendly device name (optional, for MQTT/HA/hostname)
+    FixedString<MAX_MQTT_BROKER_LENGTH> mqttBroker;  // MQTT broker URL (e.g., mqtt://broker.example.com:1883)
+    FixedString<MAX_MQTT_USERNAME_LENGTH> mqttUsername;
+    FixedString<MAX_MQTT_PASSWORD_LENGTH> mqttPassword;
+    bool mqttBatchedState;  // All sensor values in one JSON state message instead of one topic each
+    bool isConfigured;
+    bool useCRC32Check;  // Enable change detection (skip unchanged images)
+    uint8_t changeDetection;  // CHANGE_DETECTION_CRC32 or CHANGE_DETECTION_HTTP
+    FixedString<MAX_TLS_FINGERPRINT_LENGTH> tlsFingerprint;  // SHA-256 of the HTTPS server certificate ("AB:CD:..."), empty = not pinned
+    uint8_t updateHours[3];  // 24-bit bitmask: bit i = hour i enabled (0-23)
+    int timezoneOffset;  // Timezone offset in hours (-12 to +14)
+    uint8_t screenRotation;  // Screen rotation: 0, 1, 2, 3 (0°, 90°, 180°, 270°)
+    bool partialRefresh;  // Refresh only changed tiles (black/white mode, not on Inkplate 2)
+    uint8_t fullRefreshEvery;  // Full refresh after this many partial refreshes (0 = always full)
+    
+    // Static IP configuration
+    bool useStaticIP;       // Use static IP instead of DHCP
+    FixedString<MAX_IPV4_LENGTH> staticIP;        // Static IP address (e.g., "192.168.1.100")
+    FixedString<MAX_IPV4_LENGTH> gateway;         // Gateway address (e.g., "192.168.1.1")
+    FixedString<MAX_IPV4_LENGTH> subnet;          // Subnet mask (e.g., "255.255.255.0")
+    FixedString<MAX_IPV4_LENGTH> primaryDNS;      // Primary DNS server (e.g., "8.8.8.8")
+    FixedString<MAX_IPV4_LENGTH> secondaryDNS;    // Secondary DNS server (optional)
+    
+    // Carousel configuration
+    uint8_t imageCount;           // How many URLs provided (0-10)
+    FixedString<MAX_URL_LENGTH> imageUrls[MAX_IMAGE_SLOTS];  // Image URLs
+    int imageIntervals[MAX_IMAGE_SLOTS];  // Display duration per image in minutes
+    bool imageStay[MAX_IMAGE_SLOTS];      // Stay on image (don't auto-advance)
+    uint8_t prefetchCount;        // Next slots downloaded ahead and shown without WiFi (0 = off)
+    
+    // Frontlight configuration (only for boards with HAS_FRONTLIGHT)
+    uint8_t frontlightDuration;   // Duration in seconds (0 = disabled, default 0)
+    uint8_t frontlightBrightness; // Brightness level (0-63, default 63)
+    
+    // Overlay configuration (on-image status display)
+    bool overlayEnabled;               // Enable/disable overlay
+    uint8_t overlayPosition;           // 0=TL, 1=TR, 2=BL, 3=BR
+    bool overlayShowBatteryIcon;       // Show battery icon
+    bool overlayShowBatteryPercentage; // Show battery percentage text
+    bool overlayShowUpdateTime;        // Show last update time
+    bool overlayShowCycleTime;         // Show last cycle/loop time
+    uint8_t overlaySize;               // 0=Small, 1=Medium, 2=Large
+    uint8_t overlayTextColor;          // 0=Black, 1=Dark Gray, 2=Light Gray, 3=White
+    
+    // Constructor with defaults
+    DashboardConfig() :
+        mqttBatchedState(false),
+        isConfigured(false),
+        useCRC32Check(false),
+        changeDetection(CHANGE_DETECTION_CRC32),
+        timezoneOffset(0),
+        screenRotation(DEFAULT_SCREEN_ROTATION),
+        partialRefresh(false),
+        fullRefreshEvery(DEFAULT_FULL_REFRESH_EVERY),
+        useStaticIP(false),
+        imageCount(0),
+        prefetchCount(DEFAULT_PREFETCH_COUNT),
+        frontlightDuration(0),      // Default: disabled
+        frontlightBrightness(DEFAULT_FRONTLIGHT_BRIGHTNESS),
+        overlayEnabled(false),      // Default: disabled
+        overlayPosition(OVERLAY_POS_TOP_RIGHT),
+        overlayShowBatteryIcon(true),
+        overlayShowBatteryPercentage(true),
+        overlayShowUpdateTime(true),
+        overlayShowCycleTime(false),
+        overlaySize(OVERLAY_SIZE_MEDIUM),
+        overlayTextColor(OVERLAY_COLOR_BLACK) {
+        // Initialize all hours enabled by default (0xFF = all bits set)
+        updateHours[0] = 0xFF;  // Hours 0-7
+        updateHours[1] = 0xFF;  // Hours 8-15
+        updateHours[2] = 0xFF;  // Hours 16-23
+        
+        // Initialize carousel arrays
+        for (int i = 0; i < MAX_IMAGE_SLOTS; i++) {
+            imageIntervals[i] = 0;
+            imageStay[i] = false;
+        }
+    }
+    
+    // Helper methods
+    bool isCarouselMode() const {
+        return imageCount > 1;
+    }
+    
+    // Calculate average interval for battery estimates and fallbacks
+    int getAverageInterval() const {
+        if (imageCount == 0) return DEFAULT_INTERVAL_MINUTES;
+        int total = 0;
+        for (uint8_t i = 0; i < imageCount; i++) {
+            total += imageIntervals[i];
+        }
+        return total / imageCount;
+    }
+};
+
+/**
+ * @brief Fill a configuration from the stored blob (strings are copied, nothing allocated)
+ */
+void readDashboardConfig(const ConfigBlob& blob, DashboardConfig& config);
+
+/**
+ * @brief Store a configuration in the blob (seal it before saving)
+ *
+ * URLs of slots past imageCount are cleared. The configured flag is left
+ * as it is (saving a complete configuration sets it).
+ */
+void writeDashboardConfig(const DashboardConfig& config, ConfigBlob& blob);
+
+#endif // DASHBOARD_CONFIG_H
@@ -0,0 +1,61 @@
+#include <discovery_hash.h>
+#include <fnv1a.h>
+
+#define FIELD_SEPARATOR 0x1F            // ASCII unit separator, never part of a field
+
+const DiscoverySensor DISCOVERY_SENSORS[] = {
+    { "battery_voltage",         "Battery Voltage",           "voltage",         "V"   },
+    { "battery_percentage",      "Battery Percentage",        "battery",         "%"   },
+    { "loop_time",               "Loop Time",                 "duration",        "s"   },
+    { "wifi_signal",             "WiFi Signal",               "signal_strength", "dBm" },
+    { "last_log",                "Last Log",                  "",                ""    },
+    { "image_crc32",             "Image CRC32",               "",                ""    },
+    { "wifi_bssid",              "WiFi BSSID",                "",                ""    },
+    { "loop_time_wifi",          "Loop Time - WiFi",          "duration",        "s"   },
+    { "loop_time_wifi_early",    "Loop Time - WiFi Early",    "duration",        "s"   },
+    { "loop_time_ntp",           "Loop Time - NTP",           "duration",        "s"   },
+    { "loop_time_crc",           "Loop Time - CRC",           "duration",        "s"   },
+    { "loop_time_image",         "Loop Time - Image",         "duration",        "s"   },
+    { "loop_time_wifi_retries",  "Loop Time - WiFi Retries",  "",                ""    },
+    { "loop_time_crc_retries",   "Loop Time - CRC Retries",   "",                ""    },
+    { "loop_time_image_retries", "Loop Time - Image Retries", "",                ""    },
+    { "tls_full_handshakes",     "TLS Full Handshakes",       "",                ""    },
+    { "tls_resumed_handshakes",  "TLS Resumed Handshakes",    "",                ""    },
+    { "http_reused_connections", "HTTP Reused Connections",   "",                ""    },
+    { "wake_charge",             "Charge Per Wake",           "",                "mAh" },
+    { "battery_days_remaining",  "Battery Days Remaining",    "duration",        "d"   },
+};
+
+const size_t DISCOVERY_SENSOR_COUNT = sizeof(DISCOVERY_SENSORS) / sizeof(DISCOVERY_SENSORS[0]);
+
+static uint32_t hashField(uint32_t hash, const char* text) {
+    return fnv1aByte(fnv1aString(hash, text), FIELD_SEPARATOR);
+}
+
+uint32_t computeDiscoveryHash(const DiscoveryIdentity& identity, const DiscoverySensor* sensors, size_t count) {
+    uint32_t hash = FNV1A_OFFSET_BASIS;
+    hash = fnv1aByte(hash, DISCOVERY_FORMAT_VERSION);
+    hash = hashField(hash, identity.deviceId);
+    hash = hashField(hash, identity.deviceName);
+    hash = hashField(hash, identity.modelName);
+    hash = hashField(hash, identity.firmwareVersion);
+    hash = hashField(hash, identity.broker);
+    hash = fnv1aByte(hash, identity.batchedState ? 1 : 0);
+
+    for (size_t i = 0; sensors != nullptr && i < count; i++) {
+        hash = hashField(hash, sensors[i].type);
+        hash = hashField(hash, sensors[i].name);
+        hash = hashField(hash, sensors[i].deviceClass);
+        hash = hashField(hash, sensors[i].unit);
+    }
+
+    // Keep the "nothing stored" value free
+    return hash == DISCOVERY_HASH_NONE ? 1 : hash;
+}
+
+bool isDiscoveryPublishNeeded(uint32_t currentHash, uint32_t storedHash, bool forced) {
+    if (forced || storedHash == DISCOVERY_HASH_NONE) {
+        return true;
+    }
+    return currentHash != storedHash;
+}
@@ -0,0 +1,70 @@
+#ifndef DISCOVERY_HASH_H
+#define DISCOVERY_HASH_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Bump when the payload built by MQTTManager::publishSensorDiscovery() changes,
+// so every device republishes its discovery set once after the update
+#define DISCOVERY_FORMAT_VERSION 1
+#define DISCOVERY_HASH_NONE 0           // Nothing published yet (computeDiscoveryHash never returns it)
+
+/**
+ * @brief Home Assistant discovery change detection
+ *
+ * Pure C++ with NO dependencies on Arduino/ESP32 APIs, making it fully
+ * testable with standard C++ unit testing frameworks.
+ *
+ * The discovery messages are large retained config payloads that only
+ * change when the device identity, firmware, broker or sensor list does.
+ * A 32-bit FNV-1a hash over those inputs is stored in NVS once a set was
+ * published; later wakes only republish when the hash differs.
+ */
+
+/**
+ * @brief One Home Assistant sensor entity
+ */
+struct DiscoverySensor {
+    const char* type;           // Topic segment and unique_id suffix (e.g. "battery_voltage")
+    const char* name;           // Entity name shown in Home Assistant
+    const char* deviceClass;    // "" = none
+    const char* unit;           // "" = none
+};
+
+// Every sensor published by the telemetry session, in discovery order
+// (the first one carries the full device info)
+extern const DiscoverySensor DISCOVERY_SENSORS[];
+extern const size_t DISCOVERY_SENSOR_COUNT;
+
+/**
+ * @brief Inputs that end up in the discovery payloads besides the sensor list
+ */
+struct DiscoveryIdentity {
+    const char* deviceId;
+    const char* deviceName;
+    const char* modelName;
+    const char* firmwareVersion;
+    const char* broker;         // host:port - retained configs live on one broker
+    bool batchedState;          // State topic + value_template layout
+};
+
+/**
+ * @brief Hash the discovery set
+ *
+ * Null strings hash like empty ones; fields are separated so that moving
+ * characters between adjacent fields changes the hash.
+ *
+ * @return FNV-1a hash, never DISCOVERY_HASH_NONE
+ */
+uint32_t computeDiscoveryHash(const DiscoveryIdentity& identity, const DiscoverySensor* sensors, size_t count);
+
+/**
+ * @brief Decide whether the discovery set must be published
+ *
+ * @param currentHash computeDiscoveryHash() for this wake
+ * @param storedHash Hash of the last set published in full (DISCOVERY_HASH_NONE = never)
+ * @param forced Republish regardless (reset button, e.g. after the broker lost its retained messages)
+ */
+bool isDiscoveryPublishNeeded(uint32_t currentHash, uint32_t storedHash, bool forced);
+
+#endif // DISCOVERY_HASH_H
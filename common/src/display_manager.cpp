@@ -272,6 +272,7 @@ void DisplayManager::showVcomTestPattern() {
     Logger::line("Displaying test pattern with 8 grayscale bars");
     #endif
     
+    invalidatePanelState();
     _display->display();
     Logger::end();
 }
@@ -307,9 +308,36 @@ void DisplayManager::refresh(bool includeVersion) {
     if (includeVersion) {
         drawVersionLabel();
     }
+    invalidatePanelState();
     _display->display();
 }
 
+void DisplayManager::setTileHashGrid(TileHashGrid* grid) {
+    _tileHashGrid = grid;
+}
+
+TileHashGrid* DisplayManager::getTileHashGrid() {
+    return _tileHashGrid;
+}
+
+void DisplayManager::setTileManifestState(TileManifestState* state) {
+    _tileManifestState = state;
+}
+
+TileManifestState* DisplayManager::getTileManifestState() {
+    return _tileManifestState;
+}
+
+void DisplayManager::invalidatePanelState() {
+    // Another screen replaces the dashboard image on the panel
+    if (_tileHashGrid != nullptr) {
+        initTileHashGrid(*_tileHashGrid);
+    }
+    if (_tileManifestState != nullptr) {
+        initTileManifestState(*_tileManifestState);
+    }
+}
+
 void DisplayManager::showMessage(const char* message, int x, int y, const GFXfont* font) {
     _display->setFont(font);
     _display->setTextColor(BLACK);
@@ -2,6 +2,8 @@
 #define DISPLAY_MANAGER_H
 
 #include "Inkplate.h"
+#include "tile_diff.h"
+#include "tile_manifest.h"
 
 // Include font files (provides GFXfont objects referenced by board_config.h)
 #include <src/fonts/FreeSans7pt7b.h>
@@ -25,6 +27,14 @@ public:
     void enableRotation();   // Restore configured rotation
     void disableRotation();  // Set to 0 for performance
     
+    // Tile hashes of the image on the panel (RTC memory, used by partial refresh)
+    // Every refresh() of another screen invalidates them - the panel no longer shows that image
+    void setTileHashGrid(TileHashGrid* grid);
+    TileHashGrid* getTileHashGrid();
+    // Manifest tiles on the panel (RTC memory) - invalidated the same way
+    void setTileManifestState(TileManifestState* state);
+    TileManifestState* getTileManifestState();
+    
     // Helper to calculate font height in pixels for GFXfonts
     int getFontHeight(const GFXfont* font);
     
@@ -50,7 +60,10 @@ private:
     Inkplate* _display;
     uint8_t _configuredRotation = 0;  // The rotation configured by user
     uint8_t _currentRotation = 0;     // Current active rotation
+    TileHashGrid* _tileHashGrid = nullptr;
+    TileManifestState* _tileManifestState = nullptr;
     void drawVersionLabel();
+    void invalidatePanelState();
 };
 
 #endif // DISPLAY_MANAGER_H
@@ -0,0 +1,130 @@
+#include <energy_model.h>
+
+static uint32_t clampedSubtract(uint32_t value, uint32_t amount) {
+    return value > amount ? value - amount : 0;
+}
+
+CyclePhases buildCyclePhases(uint32_t bootMs, uint32_t loopMs,
+                             uint32_t wifiMs, uint32_t ntpMs, uint32_t crcMs, uint32_t imageMs,
+                             uint32_t tlsMs, uint32_t refreshMs) {
+    CyclePhases phases;
+    phases.boot_ms = bootMs;
+    phases.wifi_ms = wifiMs;
+
+    // TLS and refresh are measured inside the CRC32 / image phases
+    uint32_t httpMs = crcMs + imageMs;
+    phases.refresh_ms = refreshMs < imageMs ? refreshMs : imageMs;
+    httpMs -= phases.refresh_ms;
+    phases.tls_ms = tlsMs < httpMs ? tlsMs : httpMs;
+    phases.transfer_ms = httpMs - phases.tls_ms;
+
+    // Everything else in the loop (NTP, MQTT, logging) runs with WiFi on
+    uint32_t measuredMs = wifiMs + crcMs + imageMs;
+    phases.other_ms = clampedSubtract(loopMs, measuredMs);
+    if (phases.other_ms < ntpMs) {
+        phases.other_ms = ntpMs;
+    }
+    return phases;
+}
+
+uint32_t getCycleAwakeMs(const CyclePhases& phases) {
+    return phases.boot_ms + phases.wifi_ms + phases.tls_ms + phases.transfer_ms +
+           phases.refresh_ms + phases.other_ms;
+}
+
+float estimateCycleCharge(const PowerProfile& profile, const CyclePhases& phases) {
+    uint32_t wifiOnMs = phases.wifi_ms + phases.tls_ms + phases.transfer_ms + phases.other_ms;
+
+    // mA x ms -> mAh
+    float mAms = phases.boot_ms * profile.activeMa +
+                 wifiOnMs * profile.wifiMa +
+                 phases.refresh_ms * (profile.wifiMa + profile.displayMa);
+    return mAms / 3600000.0f;
+}
+
+float estimateSleepCharge(const PowerProfile& profile, float sleepSeconds) {
+    if (sleepSeconds <= 0) {
+        return 0;
+    }
+    return profile.sleepUa / 1000.0f * sleepSeconds / 3600.0f;
+}
+
+void updateEnergyStats(EnergyStats& stats, float cycleMah, float awakeSeconds) {
+    if (stats.cycles == 0) {
+        stats.avgCycleMah = cycleMah;  // First wake
+        stats.avgAwakeSeconds = awakeSeconds;
+    } else {
+        stats.avgCycleMah = ENERGY_SMOOTHING_ALPHA * cycleMah + (1.0f - ENERGY_SMOOTHING_ALPHA) * stats.avgCycleMah;
+        stats.avgAwakeSeconds = ENERGY_SMOOTHING_ALPHA * awakeSeconds +
+                                (1.0f - ENERGY_SMOOTHING_ALPHA) * stats.avgAwakeSeconds;
+    }
+    if (stats.cycles < UINT32_MAX) {
+        stats.cycles++;
+    }
+}
+
+static bool isHourEnabled(const uint8_t updateHours[3], int hour) {
+    return (updateHours[hour / 8] >> (hour % 8)) & 1;
+}
+
+float calculateWakesPerDay(const int intervals[], const bool stay[], uint8_t imageCount,
+                           const uint8_t updateHours[3]) {
+    if (imageCount == 0) {
+        return 0;
+    }
+
+    // Images shown in the steady state, starting from the first one
+    float cycleMinutes = 0;
+    uint8_t shown = 0;
+    for (uint8_t i = 0; i < imageCount; i++) {
+        if (intervals[i] <= 0) {
+            return 0;  // Button-only: the carousel stops here
+        }
+        if (imageCount > 1 && stay != nullptr && stay[i]) {
+            cycleMinutes = (float)intervals[i];  // Never leaves this image on timer wakes
+            shown = 1;
+            break;
+        }
+        cycleMinutes += (float)intervals[i];
+        shown++;
+    }
+    float wakesPerHour = shown * 60.0f / cycleMinutes;
+
+    int enabledHours = 0;
+    int disabledBlocks = 0;
+    for (int hour = 0; hour < 24; hour++) {
+        if (isHourEnabled(updateHours, hour)) {
+            enabledHours++;
+        } else if (isHourEnabled(updateHours, (hour + 23) % 24)) {
+            disabledBlocks++;  // The first wake after an enabled hour finds this one disabled
+        }
+    }
+    if (enabledHours == 0) {
+        return wakesPerHour * 24.0f;  // No schedule stored
+    }
+    return wakesPerHour * enabledHours + disabledBlocks;
+}
+
+BatteryProjection projectBatteryLife(const PowerProfile& profile, float cycleMah, float awakeSeconds,
+                                     float wakesPerDay, int batteryPercentage) {
+    BatteryProjection projection;
+    projection.wakesPerDay = wakesPerDay;
+
+    float awakePerDay = wakesPerDay * awakeSeconds;
+    if (awakePerDay > 86400.0f) {
+        awakePerDay = 86400.0f;
+    }
+    projection.mahPerDay = wakesPerDay * cycleMah + estimateSleepCharge(profile, 86400.0f - awakePerDay);
+
+    if (projection.mahPerDay <= 0) {
+        projection.daysFullBattery = 0;
+        projection.daysRemaining = 0;
+        return projection;
+    }
+
+    if (batteryPercentage < 0) batteryPercentage = 0;
+    if (batteryPercentage > 100) batteryPercentage = 100;
+    projection.daysFullBattery = profile.batteryMah / projection.mahPerDay;
+    projection.daysRemaining = projection.daysFullBattery * batteryPercentage / 100.0f;
+    return projection;
+}
@@ -0,0 +1,137 @@
+#ifndef ENERGY_MODEL_H
+#define ENERGY_MODEL_H
+
+#include <stdint.h>
+
+/**
+ * @brief Pure battery life model
+ *
+ * These functions contain NO dependencies on Arduino/ESP32 APIs,
+ * making them fully testable with standard C++ unit testing frameworks.
+ *
+ * Charge per wake = sum over phases of (phase time x phase current), using
+ * the measured phase times from LoopTimings and the typical currents of the
+ * board (POWER_* in board_config.h). Wakes per day follow from the carousel
+ * intervals and the hourly schedule, so the projection answers "how long
+ * will the battery last with this configuration".
+ */
+
+#define ENERGY_SMOOTHING_ALPHA 0.2f     // Weight of the newest wake in the running averages
+
+/**
+ * @brief Typical current draw of a board (from board_config.h)
+ */
+struct PowerProfile {
+    float activeMa;         // ESP32 awake, WiFi off (boot, config load)
+    float wifiMa;           // ESP32 awake, WiFi on (everything after the connect starts)
+    float displayMa;        // Added while the panel refreshes
+    float sleepUa;          // Deep sleep, whole board
+    float batteryMah;       // Nominal battery capacity
+};
+
+/**
+ * @brief Awake time of one wake cycle by phase (ms)
+ */
+struct CyclePhases {
+    uint32_t boot_ms;       // Reset until the cycle starts (WiFi off)
+    uint32_t wifi_ms;       // Association + DHCP
+    uint32_t tls_ms;        // TLS connect + handshakes
+    uint32_t transfer_ms;   // HTTP requests, download and streaming decode
+    uint32_t refresh_ms;    // Panel refresh (WiFi still on)
+    uint32_t other_ms;      // NTP, MQTT and bookkeeping (WiFi on)
+};
+
+/**
+ * @brief Running averages kept in RTC memory across wakes
+ *
+ * Averaging every wake (skipped checks and image updates alike) gives the
+ * real mix of cheap and expensive cycles for this device and content.
+ */
+struct EnergyStats {
+    float avgCycleMah;      // Average awake charge per wake
+    float avgAwakeSeconds;  // Average awake time per wake
+    uint32_t cycles;        // Wakes averaged (0 = no data yet)
+};
+
+/**
+ * @brief Battery life projection for a configuration
+ */
+struct BatteryProjection {
+    float wakesPerDay;      // Timer wakes per day (0 = button-only)
+    float mahPerDay;        // Awake + sleep charge per day
+    float daysFullBattery;  // Battery life from a full charge
+    float daysRemaining;    // Battery life from the current charge
+};
+
+/**
+ * @brief Split the measured loop timings into energy phases
+ *
+ * crc_ms and image_ms include the TLS time and image_ms includes the
+ * refresh, so those are subtracted; whatever the loop spent outside the
+ * measured phases is counted as other_ms. Inconsistent inputs are clamped
+ * so no phase goes negative.
+ *
+ * @param bootMs Time from reset until the cycle started
+ * @param loopMs Total cycle time (excluding boot)
+ * @param wifiMs, ntpMs, crcMs, imageMs, tlsMs, refreshMs LoopTimings fields
+ */
+CyclePhases buildCyclePhases(uint32_t bootMs, uint32_t loopMs,
+                             uint32_t wifiMs, uint32_t ntpMs, uint32_t crcMs, uint32_t imageMs,
+                             uint32_t tlsMs, uint32_t refreshMs);
+
+/**
+ * @brief Total awake time of a cycle in ms
+ */
+uint32_t getCycleAwakeMs(const CyclePhases& phases);
+
+/**
+ * @brief Estimate the charge drawn while awake
+ * @return Charge in mAh
+ */
+float estimateCycleCharge(const PowerProfile& profile, const CyclePhases& phases);
+
+/**
+ * @brief Estimate the charge drawn in deep sleep
+ * @return Charge in mAh
+ */
+float estimateSleepCharge(const PowerProfile& profile, float sleepSeconds);
+
+/**
+ * @brief Fold one wake into the running averages
+ */
+void updateEnergyStats(EnergyStats& stats, float cycleMah, float awakeSeconds);
+
+/**
+ * @brief Calculate timer wakes per day for a configuration
+ *
+ * Single image: one wake per interval. Carousel: the images are shown in
+ * turn, so the rate is set by the sum of their intervals - unless an image
+ * with stay:true is reached, which the carousel then never leaves. An
+ * interval of 0 (button-only) stops timer wakes altogether.
+ *
+ * With an hourly schedule, wakes only happen in enabled hours, plus one
+ * short wake at the start of each disabled block (it finds the hour
+ * disabled and goes back to sleep).
+ *
+ * @param intervals Interval per image in minutes
+ * @param stay stay:true flag per image (may be nullptr)
+ * @param imageCount Number of images (0 = nothing configured, returns 0)
+ * @param updateHours 24-bit enabled-hours bitmask
+ * @return Wakes per day (0 = button-only)
+ */
+float calculateWakesPerDay(const int intervals[], const bool stay[], uint8_t imageCount,
+                           const uint8_t updateHours[3]);
+
+/**
+ * @brief Project battery life from the average cycle charge
+ *
+ * @param profile Board power profile
+ * @param cycleMah Average awake charge per wake
+ * @param awakeSeconds Average awake time per wake
+ * @param wakesPerDay From calculateWakesPerDay()
+ * @param batteryPercentage Current charge (0-100)
+ */
+BatteryProjection projectBatteryLife(const PowerProfile& profile, float cycleMah, float awakeSeconds,
+                                     float wakesPerDay, int batteryPercentage);
+
+#endif // ENERGY_MODEL_H
@@ -0,0 +1,76 @@
+#ifndef FIXED_STRING_H
+#define FIXED_STRING_H
+
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief String with inline storage for up to Capacity characters
+ *
+ * Pure C++ with NO dependencies on Arduino/ESP32 APIs, making it fully
+ * testable with standard C++ unit testing frameworks.
+ *
+ * Used for configuration values instead of Arduino String: no heap
+ * allocation on construction, assignment or copy. Assigning a longer value
+ * keeps the first Capacity characters and reports it; the stored limits
+ * (getConfigStringLimit) are checked before values get this far.
+ */
+template <size_t Capacity>
+class FixedString {
+public:
+    FixedString() : _length(0) {
+        _data[0] = '\0';
+    }
+
+    FixedString(const char* value) : _length(0) {
+        assign(value);
+    }
+
+    /**
+     * @brief Replace the value
+     * @return false if it was truncated to Capacity characters
+     */
+    bool assign(const char* value, size_t length) {
+        bool fits = length <= Capacity;
+        _length = fits ? length : Capacity;
+        if (_length > 0) {
+            memmove(_data, value, _length);
+        }
+        _data[_length] = '\0';
+        return fits;
+    }
+
+    bool assign(const char* value) {
+        return value != nullptr ? assign(value, strlen(value)) : assign("", 0);
+    }
+
+    FixedString& operator=(const char* value) {
+        assign(value);
+        return *this;
+    }
+
+    // Any string type with c_str() and length() (Arduino String, std::string)
+    template <typename StringType>
+    FixedString& operator=(const StringType& value) {
+        assign(value.c_str(), value.length());
+        return *this;
+    }
+
+    const char* c_str() const { return _data; }
+    size_t length() const { return _length; }
+    bool isEmpty() const { return _length == 0; }
+    static size_t capacity() { return Capacity; }
+
+    bool equals(const char* value) const {
+        return value != nullptr && strcmp(_data, value) == 0;
+    }
+
+    bool operator==(const char* value) const { return equals(value); }
+    bool operator!=(const char* value) const { return !equals(value); }
+
+private:
+    size_t _length;
+    char _data[Capacity + 1];
+};
+
+#endif // FIXED_STRING_H
@@ -0,0 +1,50 @@
+#ifndef FNV1A_H
+#define FNV1A_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define FNV1A_OFFSET_BASIS 2166136261u  // Start value of a 32-bit FNV-1a hash
+#define FNV1A_PRIME 16777619u
+
+/**
+ * @brief 32-bit FNV-1a, the one hash the caches and change detection share
+ *
+ * Pure C++ with NO dependencies on Arduino/ESP32 APIs, making it fully
+ * testable with standard C++ unit testing frameworks.
+ *
+ * Hashes are built up in steps: start from FNV1A_OFFSET_BASIS and pass the
+ * result of one call into the next. Several of them are kept in RTC memory
+ * or NVS and compared across wakes (URL and network hashes, checksums), so
+ * the byte order fed in must not change.
+ */
+
+/**
+ * @brief Continue a hash with length bytes of data
+ */
+inline uint32_t fnv1a(uint32_t hash, const void* data, size_t length) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ bytes[i]) * FNV1A_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * @brief Continue a hash with one byte
+ */
+inline uint32_t fnv1aByte(uint32_t hash, uint8_t byte) {
+    return (hash ^ byte) * FNV1A_PRIME;
+}
+
+/**
+ * @brief Continue a hash with a terminated string (nullptr hashes like "")
+ */
+inline uint32_t fnv1aString(uint32_t hash, const char* text) {
+    for (const char* p = text; p != nullptr && *p != '\0'; p++) {
+        hash = fnv1aByte(hash, (uint8_t)*p);
+    }
+    return hash;
+}
+
+#endif // FNV1A_H
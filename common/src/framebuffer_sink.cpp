@@ -0,0 +1,216 @@
+#include <framebuffer_sink.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+// FramebufferSink
+// ============================================================================
+
+FramebufferSink::FramebufferSink(PixelRowWriter* writer, uint8_t bitsPerPixel, bool dither,
+                                 uint16_t screenWidth, uint16_t screenHeight,
+                                 int16_t originX, int16_t originY)
+    : _writer(writer),
+      _pixelFormat(bitsPerPixel >= 3 ? PIXEL_FORMAT_3BIT : bitsPerPixel == 2 ? PIXEL_FORMAT_TRICOLOR : PIXEL_FORMAT_1BIT),
+      _maxLevel(bitsPerPixel >= 3 ? 7 : 1), _dither(dither),
+      _screenWidth(screenWidth), _screenHeight(screenHeight),
+      _originX(originX), _originY(originY),
+      _width(0), _rowsWritten(0), _errorBuffer(nullptr),
+      _currentError(nullptr), _nextError(nullptr), _levels(nullptr) {
+}
+
+FramebufferSink::~FramebufferSink() {
+    release();
+}
+
+void FramebufferSink::release() {
+    free(_errorBuffer);
+    free(_levels);
+    _errorBuffer = nullptr;
+    _levels = nullptr;
+    _currentError = nullptr;
+    _nextError = nullptr;
+}
+
+size_t FramebufferSink::getMemoryUsage() const {
+    size_t total = 0;
+    if (_errorBuffer != nullptr) {
+        total += 2 * (_width + 2) * sizeof(int16_t);
+    }
+    if (_levels != nullptr) {
+        total += _width;
+    }
+    return total;
+}
+
+bool FramebufferSink::begin(uint16_t width, uint16_t height) {
+    (void)height;
+    release();
+    _width = width;
+    _rowsWritten = 0;
+
+    _levels = (uint8_t*)malloc(width);
+    if (_levels == nullptr) {
+        return false;
+    }
+    if (_dither) {
+        _errorBuffer = (int16_t*)calloc(2 * (width + 2), sizeof(int16_t));
+        if (_errorBuffer == nullptr) {
+            release();
+            return false;
+        }
+        // Guard cell at index -1 absorbs error diffused past the left edge
+        _currentError = _errorBuffer + 1;
+        _nextError = _errorBuffer + (width + 2) + 1;
+    }
+    return true;
+}
+
+void FramebufferSink::writeRow(uint16_t y, const uint8_t* gray, uint16_t width) {
+    if (_levels == nullptr || width > _width) {
+        return;
+    }
+    const uint8_t maxLevel = _maxLevel;
+
+    if (_dither) {
+        int16_t* cur = _currentError;
+        int16_t* next = _nextError;
+        for (uint16_t x = 0; x < width; x++) {
+            int value = gray[x] + cur[x];
+            if (value < 0) value = 0;
+            if (value > 255) value = 255;
+
+            uint8_t level = (uint8_t)((value * maxLevel + 127) / 255);
+            int error = value - level * 255 / maxLevel;
+            _levels[x] = level;
+
+            // Floyd-Steinberg: 7/16 right, 3/16 down-left, 5/16 down, 1/16 down-right
+            cur[x + 1] += (int16_t)(error * 7 / 16);
+            next[x - 1] += (int16_t)(error * 3 / 16);
+            next[x] += (int16_t)(error * 5 / 16);
+            next[x + 1] += (int16_t)(error / 16);
+        }
+        // This row's buffer becomes the (cleared) buffer for the row after next
+        memset(cur - 1, 0, (width + 2) * sizeof(int16_t));
+        _currentError = next;
+        _nextError = cur;
+    } else {
+        for (uint16_t x = 0; x < width; x++) {
+            _levels[x] = (uint8_t)((gray[x] * maxLevel + 127) / 255);
+        }
+    }
+    _rowsWritten++;
+    emit(y, _levels, width);
+}
+
+bool FramebufferSink::beginLevels(uint16_t width, uint16_t height, uint8_t format) {
+    (void)height;
+    if (format != _pixelFormat) {
+        return false;
+    }
+    // Rows are written as they arrive - no quantization buffers needed
+    release();
+    _width = width;
+    _rowsWritten = 0;
+    return true;
+}
+
+void FramebufferSink::writeLevelRow(uint16_t y, const uint8_t* levels, uint16_t width) {
+    if (width > _width) {
+        return;
+    }
+    _rowsWritten++;
+    emit(y, levels, width);
+}
+
+void FramebufferSink::emit(uint16_t y, const uint8_t* levels, uint16_t width) {
+    // Clip to the visible screen area
+    int32_t destY = (int32_t)_originY + y;
+    if (_writer == nullptr || destY < 0 || destY >= _screenHeight) {
+        return;
+    }
+    int32_t firstX = _originX < 0 ? -_originX : 0;
+    int32_t lastX = (int32_t)_screenWidth - _originX;
+    if (lastX > width) {
+        lastX = width;
+    }
+    if (lastX <= firstX) {
+        return;
+    }
+    _writer->writeLevels((int16_t)(_originX + firstX), (int16_t)destY,
+                         levels + firstX, (uint16_t)(lastX - firstX));
+}
+
+// ============================================================================
+// PackedFramebuffer
+// ============================================================================
+
+PackedFramebuffer::PackedFramebuffer(uint8_t* buffer, uint16_t width, uint16_t height, uint8_t bitsPerPixel)
+    : _buffer(buffer), _width(width), _height(height),
+      _bitsPerPixel(bitsPerPixel >= 3 ? 3 : bitsPerPixel == 2 ? 2 : 1), _stride(stride(width, bitsPerPixel)) {
+}
+
+size_t PackedFramebuffer::stride(uint16_t width, uint8_t bitsPerPixel) {
+    if (bitsPerPixel >= 3) {
+        return (width + 1) / 2;
+    }
+    return bitsPerPixel == 2 ? (width + 3) / 4 : (width + 7) / 8;
+}
+
+size_t PackedFramebuffer::bufferSize(uint16_t width, uint16_t height, uint8_t bitsPerPixel) {
+    return stride(width, bitsPerPixel) * height;
+}
+
+void PackedFramebuffer::clear(uint8_t level) {
+    uint8_t fill;
+    if (_bitsPerPixel == 3) {
+        fill = (uint8_t)(((level & 0x07) << 4) | (level & 0x07));
+    } else if (_bitsPerPixel == 2) {
+        fill = (uint8_t)((level & 0x03) * 0x55);
+    } else {
+        fill = level ? 0xFF : 0x00;
+    }
+    memset(_buffer, fill, _stride * _height);
+}
+
+void PackedFramebuffer::writeLevels(int16_t x, int16_t y, const uint8_t* levels, uint16_t count) {
+    if (y < 0 || y >= _height) {
+        return;
+    }
+    uint8_t* row = _buffer + (size_t)y * _stride;
+    for (uint16_t i = 0; i < count; i++) {
+        int32_t px = (int32_t)x + i;
+        if (px < 0 || px >= _width) {
+            continue;
+        }
+        if (_bitsPerPixel == 3) {
+            uint8_t& b = row[px >> 1];
+            if (px & 1) {
+                b = (uint8_t)((b & 0xF0) | (levels[i] & 0x07));
+            } else {
+                b = (uint8_t)((b & 0x0F) | ((levels[i] & 0x07) << 4));
+            }
+        } else if (_bitsPerPixel == 2) {
+            uint8_t shift = (uint8_t)(6 - 2 * (px & 3));
+            uint8_t& b = row[px >> 2];
+            b = (uint8_t)((b & ~(0x03 << shift)) | ((levels[i] & 0x03) << shift));
+        } else {
+            uint8_t mask = (uint8_t)(0x80 >> (px & 7));
+            if (levels[i]) {
+                row[px >> 3] |= mask;
+            } else {
+                row[px >> 3] &= (uint8_t)~mask;
+            }
+        }
+    }
+}
+
+uint8_t PackedFramebuffer::getLevel(uint16_t x, uint16_t y) const {
+    const uint8_t* row = _buffer + (size_t)y * _stride;
+    if (_bitsPerPixel == 3) {
+        return (x & 1) ? (row[x >> 1] & 0x07) : ((row[x >> 1] >> 4) & 0x07);
+    }
+    if (_bitsPerPixel == 2) {
+        return (row[x >> 2] >> (6 - 2 * (x & 3))) & 0x03;
+    }
+    return (row[x >> 3] >> (7 - (x & 7))) & 1;
+}
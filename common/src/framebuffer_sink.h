@@ -0,0 +1,123 @@
+#ifndef FRAMEBUFFER_SINK_H
+#define FRAMEBUFFER_SINK_H
+
+#include <image_decoder.h>
+
+/**
+ * @brief Row sink that quantizes decoded rows to display levels
+ *
+ * Pure C++ with NO dependencies on Arduino/ESP32 APIs.
+ *
+ * Converts 8-bit grayscale rows to the panel's levels (8 levels for 3-bit
+ * grayscale boards, 2 for 1-bit and tri-color) with optional Floyd-Steinberg
+ * dithering, then hands each quantized row to a PixelRowWriter. Only two
+ * error rows are kept, so the sink never needs the whole image.
+ *
+ * Levels are display-independent: 0 = black, maxLevel = white (tri-color
+ * adds 2 = red). The writer maps them to the panel's color values.
+ * Pre-quantized IKFB rows in the sink's own PixelFormat skip quantization.
+ */
+
+/**
+ * @brief Destination for quantized rows (the display, or a packed buffer in tests)
+ */
+class PixelRowWriter {
+public:
+    virtual ~PixelRowWriter() {}
+
+    /**
+     * @brief Write consecutive pixels of one row
+     * @param x Left-most destination column
+     * @param y Destination row
+     * @param levels One level per pixel (0 = black .. maxLevel = white, tri-color 2 = red)
+     * @param count Number of pixels
+     */
+    virtual void writeLevels(int16_t x, int16_t y, const uint8_t* levels, uint16_t count) = 0;
+};
+
+class FramebufferSink : public ImageRowSink {
+public:
+    /**
+     * @param writer Receives quantized rows
+     * @param bitsPerPixel 3 (8 gray levels), 1 (black/white) or 2 (tri-color:
+     *                     gray is dithered to black/white, red only from IKFB)
+     * @param dither true for Floyd-Steinberg error diffusion, false for nearest level
+     * @param screenWidth Visible width - pixels beyond it are clipped
+     * @param screenHeight Visible height - rows beyond it are clipped
+     * @param originX Destination column of the image's left edge
+     * @param originY Destination row of the image's top edge
+     */
+    FramebufferSink(PixelRowWriter* writer, uint8_t bitsPerPixel, bool dither,
+                    uint16_t screenWidth, uint16_t screenHeight,
+                    int16_t originX = 0, int16_t originY = 0);
+    ~FramebufferSink();
+
+    bool begin(uint16_t width, uint16_t height) override;
+    void writeRow(uint16_t y, const uint8_t* gray, uint16_t width) override;
+    bool beginLevels(uint16_t width, uint16_t height, uint8_t format) override;
+    void writeLevelRow(uint16_t y, const uint8_t* levels, uint16_t width) override;
+
+    uint8_t getMaxLevel() const { return _maxLevel; }
+    uint8_t getPixelFormat() const { return _pixelFormat; }
+    uint16_t getRowsWritten() const { return _rowsWritten; }
+
+    // Bytes of heap held (error rows + level row)
+    size_t getMemoryUsage() const;
+
+private:
+    PixelRowWriter* _writer;
+    uint8_t _pixelFormat;
+    uint8_t _maxLevel;
+    bool _dither;
+    uint16_t _screenWidth;
+    uint16_t _screenHeight;
+    int16_t _originX;
+    int16_t _originY;
+
+    uint16_t _width;
+    uint16_t _rowsWritten;
+    int16_t* _errorBuffer;      // Two rows of diffused error, one guard cell each side
+    int16_t* _currentError;
+    int16_t* _nextError;
+    uint8_t* _levels;
+
+    void release();
+    void emit(uint16_t y, const uint8_t* levels, uint16_t width);
+};
+
+/**
+ * @brief PixelRowWriter backed by a packed in-memory framebuffer
+ *
+ * Layout matches the Inkplate framebuffers: 3-bit images store two pixels per
+ * byte (even column in the high nibble), 1-bit images eight pixels per byte
+ * (MSB first), tri-color images four 2-bit pixels per byte (MSB first).
+ * Values are levels as produced by FramebufferSink - the same packing IKFB
+ * files use.
+ */
+class PackedFramebuffer : public PixelRowWriter {
+public:
+    /**
+     * @param buffer Caller-owned storage of at least bufferSize() bytes
+     */
+    PackedFramebuffer(uint8_t* buffer, uint16_t width, uint16_t height, uint8_t bitsPerPixel);
+
+    static size_t stride(uint16_t width, uint8_t bitsPerPixel);
+    static size_t bufferSize(uint16_t width, uint16_t height, uint8_t bitsPerPixel);
+
+    void clear(uint8_t level);
+    void writeLevels(int16_t x, int16_t y, const uint8_t* levels, uint16_t count) override;
+    uint8_t getLevel(uint16_t x, uint16_t y) const;
+
+    const uint8_t* data() const { return _buffer; }
+    uint16_t width() const { return _width; }
+    uint16_t height() const { return _height; }
+
+private:
+    uint8_t* _buffer;
+    uint16_t _width;
+    uint16_t _height;
+    uint8_t _bitsPerPixel;
+    size_t _stride;
+};
+
+#endif // FRAMEBUFFER_SINK_H
@@ -0,0 +1,40 @@
+#include "host_resolver.h"
+#include "logger.h"
+#include <WiFi.h>
+#include <time.h>
+
+static bool lookupDns(NetworkCache* cache, const char* host, IPAddress& ip) {
+    if (!WiFi.hostByName(host, ip) || (uint32_t)ip == 0) {
+        return false;
+    }
+    if (cache != nullptr) {
+        storeDnsCache(*cache, host, (uint32_t)ip, (uint32_t)time(nullptr));
+    }
+    return true;
+}
+
+bool resolveHost(NetworkCache* cache, const char* host, IPAddress& ip, bool* outFromCache) {
+    if (outFromCache) *outFromCache = false;
+    if (host == nullptr || host[0] == '\0') {
+        return false;
+    }
+    if (ip.fromString(host)) {
+        return true;
+    }
+
+    uint32_t cached;
+    if (cache != nullptr && lookupDnsCache(*cache, host, (uint32_t)time(nullptr), cached)) {
+        ip = IPAddress(cached);
+        if (outFromCache) *outFromCache = true;
+        return true;
+    }
+    return lookupDns(cache, host, ip);
+}
+
+bool refreshHost(NetworkCache* cache, const char* host, IPAddress& ip) {
+    if (cache != nullptr) {
+        invalidateDnsCache(*cache, host);
+    }
+    Logger::linef("Cached address of %s failed - resolving again", host);
+    return lookupDns(cache, host, ip);
+}
@@ -0,0 +1,19 @@
+#ifndef HOST_RESOLVER_H
+#define HOST_RESOLVER_H
+
+#include <Arduino.h>
+#include <IPAddress.h>
+#include "network_cache.h"
+
+// Resolve a host name through the RTC DNS cache (see network_cache.h),
+// falling back to WiFi.hostByName() and caching its result.
+// IP literals are parsed without a lookup.
+// cache: nullptr = always ask DNS
+// outFromCache: set to true when the address came from the cache
+bool resolveHost(NetworkCache* cache, const char* host, IPAddress& ip, bool* outFromCache = nullptr);
+
+// Connecting to a cached address failed: forget it and ask DNS again
+// Returns true if DNS answered with an address
+bool refreshHost(NetworkCache* cache, const char* host, IPAddress& ip);
+
+#endif // HOST_RESOLVER_H
@@ -0,0 +1,109 @@
+#include "http_connection.h"
+#include "logger.h"
+#include "host_resolver.h"
+
+// ============================================================================
+// EndpointClient
+// ============================================================================
+
+EndpointClient::EndpointClient() : _networkCache(nullptr) {
+    clearHttpEndpoint(_connectedEndpoint);
+}
+
+void EndpointClient::setNetworkCache(NetworkCache* cache) {
+    _networkCache = cache;
+}
+
+const HttpEndpoint& EndpointClient::getConnectedEndpoint() const {
+    return _connectedEndpoint;
+}
+
+int EndpointClient::connect(const char* host, uint16_t port) {
+    return connect(host, port, _timeout);
+}
+
+int EndpointClient::connect(const char* host, uint16_t port, int32_t timeout) {
+    setHttpEndpoint(_connectedEndpoint, host, port, false);
+
+    IPAddress ip;
+    bool fromCache = false;
+    if (!resolveHost(_networkCache, host, ip, &fromCache)) {
+        return 0;
+    }
+    int result = WiFiClient::connect(ip, port, timeout);
+    if (!result && fromCache && refreshHost(_networkCache, host, ip)) {
+        result = WiFiClient::connect(ip, port, timeout);
+    }
+    return result;
+}
+
+// ============================================================================
+// HttpConnection
+// ============================================================================
+
+HttpConnection::HttpConnection() {
+    _http.setReuse(true);
+}
+
+void HttpConnection::setTlsSessionCache(TlsSessionCache* cache) {
+    _secureClient.setSessionCache(cache);
+}
+
+void HttpConnection::setTlsFingerprint(const uint8_t* fingerprint) {
+    // An open connection was checked against the old pin
+    close();
+    _secureClient.setFingerprint(fingerprint);
+}
+
+void HttpConnection::setTlsStats(TlsStats* stats) {
+    _secureClient.setStats(stats);
+}
+
+void HttpConnection::setNetworkCache(NetworkCache* cache) {
+    _plainClient.setNetworkCache(cache);
+    _secureClient.setNetworkCache(cache);
+}
+
+HTTPClient& HttpConnection::begin(const String& url) {
+    HttpEndpoint requested;
+    parseHttpEndpoint(url.c_str(), requested);
+
+    WiFiClient& client = requested.secure ? (WiFiClient&)_secureClient : (WiFiClient&)_plainClient;
+    const HttpEndpoint& connected = requested.secure ? _secureClient.getConnectedEndpoint()
+                                                     : _plainClient.getConnectedEndpoint();
+
+    // Compared against the server the socket is actually connected to, so a
+    // connection left on a redirect target is not reused for the original host
+    bool reuse = client.connected() && isSameHttpEndpoint(connected, requested);
+    if (!reuse) {
+        close();
+    }
+
+    _stats.requests++;
+    if (reuse) {
+        _stats.reused++;
+        Logger::line("Reusing open connection");
+    }
+
+    _http.begin(client, url);
+    return _http;
+}
+
+HTTPClient& HttpConnection::getHttpClient() {
+    return _http;
+}
+
+void HttpConnection::end() {
+    // HTTPClient keeps the socket when the response allowed keep-alive
+    _http.end();
+}
+
+void HttpConnection::close() {
+    _http.end();
+    _plainClient.stop();
+    _secureClient.stop();
+}
+
+const HttpConnectionStats& HttpConnection::getStats() const {
+    return _stats;
+}
@@ -0,0 +1,84 @@
+#ifndef HTTP_CONNECTION_H
+#define HTTP_CONNECTION_H
+
+#include <Arduino.h>
+#include <WiFiClient.h>
+#include <HTTPClient.h>
+#include "tls_client.h"
+#include "http_endpoint.h"
+#include "network_cache.h"
+
+// Request counters for one wake cycle (reported in LoopTimings)
+struct HttpConnectionStats {
+    uint8_t requests;  // HTTP requests sent
+    uint8_t reused;    // Requests sent over an already open keep-alive connection
+
+    HttpConnectionStats() : requests(0), reused(0) {}
+};
+
+// WiFiClient that remembers which server it connected to (plain HTTP)
+// and resolves its name through the RTC DNS cache
+class EndpointClient : public WiFiClient {
+public:
+    EndpointClient();
+
+    // RTC DNS cache (nullptr = resolve every time)
+    void setNetworkCache(NetworkCache* cache);
+
+    const HttpEndpoint& getConnectedEndpoint() const;
+
+    int connect(const char* host, uint16_t port) override;
+    int connect(const char* host, uint16_t port, int32_t timeout) override;
+
+private:
+    HttpEndpoint _connectedEndpoint;
+    NetworkCache* _networkCache;
+};
+
+/**
+ * @brief One HTTP/1.1 keep-alive connection shared by all requests of a wake cycle
+ *
+ * The .crc32 sidecar (or conditional GET) and the image are usually on the
+ * same server. Instead of a new HTTPClient + TCP/TLS connection per request,
+ * begin() hands out the same HTTPClient and keeps the socket open between
+ * requests when the server allows it. A request to another server (or after
+ * a redirect to one) closes the old connection first.
+ */
+class HttpConnection {
+public:
+    HttpConnection();
+
+    // TLS settings for https:// requests (see ResumableTlsClient)
+    void setTlsSessionCache(TlsSessionCache* cache);
+    void setTlsFingerprint(const uint8_t* fingerprint);
+    void setTlsStats(TlsStats* stats);
+
+    // DNS cache for both clients (see network_cache.h)
+    void setNetworkCache(NetworkCache* cache);
+
+    // Start a request: returns the client to configure and send it with
+    // Reuses the open connection when it is to the same server
+    HTTPClient& begin(const String& url);
+
+    // Client of the current request
+    HTTPClient& getHttpClient();
+
+    // Finish a request whose response was fully read - the connection stays
+    // open for the next request if the server allows keep-alive
+    void end();
+
+    // Close the connection (after a failed or partly read request, or when
+    // no more requests follow)
+    void close();
+
+    const HttpConnectionStats& getStats() const;
+
+private:
+    // Clients must outlive _http (its destructor stops the active client)
+    EndpointClient _plainClient;
+    ResumableTlsClient _secureClient;
+    HTTPClient _http;
+    HttpConnectionStats _stats;
+};
+
+#endif // HTTP_CONNECTION_H
@@ -0,0 +1,114 @@
+#include <http_endpoint.h>
+#include <string.h>
+
+void clearHttpEndpoint(HttpEndpoint& endpoint) {
+    endpoint.secure = false;
+    endpoint.port = 0;
+    endpoint.host[0] = '\0';
+}
+
+bool setHttpEndpoint(HttpEndpoint& endpoint, const char* host, uint16_t port, bool secure) {
+    clearHttpEndpoint(endpoint);
+    if (host == nullptr) {
+        return false;
+    }
+    size_t length = strlen(host);
+    if (length == 0 || length >= HTTP_ENDPOINT_HOST_SIZE) {
+        return false;
+    }
+    memcpy(endpoint.host, host, length + 1);
+    endpoint.port = port;
+    endpoint.secure = secure;
+    return true;
+}
+
+bool parseHttpEndpoint(const char* url, HttpEndpoint& endpoint) {
+    clearHttpEndpoint(endpoint);
+    if (url == nullptr) {
+        return false;
+    }
+
+    bool secure;
+    const char* p;
+    if (strncmp(url, "https://", 8) == 0) {
+        secure = true;
+        p = url + 8;
+    } else if (strncmp(url, "http://", 7) == 0) {
+        secure = false;
+        p = url + 7;
+    } else {
+        return false;
+    }
+
+    // Authority ends at the path, query or fragment
+    const char* end = p;
+    while (*end != '\0' && *end != '/' && *end != '?' && *end != '#') {
+        end++;
+    }
+    // Skip credentials (user:pass@)
+    for (const char* q = end; q > p; q--) {
+        if (q[-1] == '@') {
+            p = q;
+            break;
+        }
+    }
+
+    const char* colon = nullptr;
+    for (const char* q = p; q < end; q++) {
+        if (*q == ':') {
+            colon = q;
+            break;
+        }
+    }
+
+    const char* hostEnd = colon != nullptr ? colon : end;
+    size_t hostLength = (size_t)(hostEnd - p);
+    if (hostLength == 0 || hostLength >= HTTP_ENDPOINT_HOST_SIZE) {
+        return false;
+    }
+
+    uint32_t port = secure ? 443 : 80;
+    if (colon != nullptr) {
+        if (colon + 1 == end) {
+            return false;
+        }
+        port = 0;
+        for (const char* q = colon + 1; q < end; q++) {
+            if (*q < '0' || *q > '9') {
+                return false;
+            }
+            port = port * 10 + (uint32_t)(*q - '0');
+            if (port > 65535) {
+                return false;
+            }
+        }
+        if (port == 0) {
+            return false;
+        }
+    }
+
+    memcpy(endpoint.host, p, hostLength);
+    endpoint.host[hostLength] = '\0';
+    endpoint.port = (uint16_t)port;
+    endpoint.secure = secure;
+    return true;
+}
+
+bool isSameHttpEndpoint(const HttpEndpoint& a, const HttpEndpoint& b) {
+    if (a.host[0] == '\0' || a.secure != b.secure || a.port != b.port) {
+        return false;
+    }
+    for (size_t i = 0; i < HTTP_ENDPOINT_HOST_SIZE; i++) {
+        char ca = a.host[i];
+        char cb = b.host[i];
+        if (ca >= 'A' && ca <= 'Z') ca = (char)(ca - 'A' + 'a');
+        if (cb >= 'A' && cb <= 'Z') cb = (char)(cb - 'A' + 'a');
+        if (ca != cb) {
+            return false;
+        }
+        if (ca == '\0') {
+            return true;
+        }
+    }
+    return true;
+}
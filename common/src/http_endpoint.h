@@ -0,0 +1,50 @@
+#ifndef HTTP_ENDPOINT_H
+#define HTTP_ENDPOINT_H
+
+#include <stdint.h>
+
+#define HTTP_ENDPOINT_HOST_SIZE 64  // Max host name length + 1
+
+/**
+ * @brief Scheme, host and port of an HTTP(S) URL
+ *
+ * A keep-alive connection may only be reused for a request to the same
+ * endpoint; this is what the connection is compared by.
+ */
+struct HttpEndpoint {
+    bool secure;                          // https://
+    uint16_t port;                        // Explicit port, or 80 / 443
+    char host[HTTP_ENDPOINT_HOST_SIZE];   // Host name as written in the URL (empty = none)
+};
+
+/**
+ * @brief Pure endpoint functions
+ *
+ * These functions contain NO dependencies on Arduino/ESP32 APIs,
+ * making them fully testable with standard C++ unit testing frameworks.
+ */
+
+/**
+ * @brief Clear an endpoint (matches nothing)
+ */
+void clearHttpEndpoint(HttpEndpoint& endpoint);
+
+/**
+ * @brief Set an endpoint from its parts
+ * @return false if the host is empty or too long (endpoint is cleared)
+ */
+bool setHttpEndpoint(HttpEndpoint& endpoint, const char* host, uint16_t port, bool secure);
+
+/**
+ * @brief Parse http://[user:pass@]host[:port][/path] or https://...
+ * @return false if the URL is not http(s), has no host, an invalid port or a too long host
+ */
+bool parseHttpEndpoint(const char* url, HttpEndpoint& endpoint);
+
+/**
+ * @brief Check whether two endpoints are the same server (host compared case-insensitively)
+ * An empty endpoint never matches.
+ */
+bool isSameHttpEndpoint(const HttpEndpoint& a, const HttpEndpoint& b);
+
+#endif // HTTP_ENDPOINT_H
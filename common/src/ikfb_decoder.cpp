@@ -0,0 +1,279 @@
+#include <ikfb_decoder.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const uint8_t IKFB_MAGIC[4] = { 'I', 'K', 'F', 'B' };
+
+static uint16_t readLittleEndian16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+IkfbStreamDecoder::IkfbStreamDecoder()
+    : _sink(nullptr), _state(STATE_HEADER), _error(nullptr), _headerFill(0),
+      _format(0), _compression(0), _rotation(0), _width(0), _height(0), _native(false),
+      _rowBuffer(nullptr), _packedRow(nullptr), _levelRow(nullptr),
+      _rowBytes(0), _rowFill(0), _y(0), _literalRemaining(0), _repeatCount(0) {
+}
+
+IkfbStreamDecoder::~IkfbStreamDecoder() {
+    end();
+}
+
+void IkfbStreamDecoder::begin(ImageRowSink* sink) {
+    end();
+    _sink = sink;
+    _state = STATE_HEADER;
+    _error = nullptr;
+    _headerFill = 0;
+    _format = 0;
+    _compression = 0;
+    _rotation = 0;
+    _width = 0;
+    _height = 0;
+    _native = false;
+    _rowBytes = 0;
+    _rowFill = 0;
+    _y = 0;
+    _literalRemaining = 0;
+    _repeatCount = 0;
+}
+
+void IkfbStreamDecoder::end() {
+    free(_rowBuffer);
+    _rowBuffer = nullptr;
+    _packedRow = nullptr;
+    _levelRow = nullptr;
+}
+
+size_t IkfbStreamDecoder::getMemoryUsage() const {
+    return _rowBuffer != nullptr ? _rowBytes + _width : 0;
+}
+
+size_t IkfbStreamDecoder::rowBytes(uint16_t width, uint8_t pixelFormat) {
+    switch (pixelFormat) {
+        case PIXEL_FORMAT_3BIT:     return ((size_t)width + 1) / 2;
+        case PIXEL_FORMAT_TRICOLOR: return ((size_t)width + 3) / 4;
+        default:                    return ((size_t)width + 7) / 8;
+    }
+}
+
+DecodeStatus IkfbStreamDecoder::status() const {
+    switch (_state) {
+        case STATE_DONE:        return DECODE_DONE;
+        case STATE_UNSUPPORTED: return DECODE_UNSUPPORTED;
+        case STATE_ERROR:       return DECODE_ERROR;
+        default:                return DECODE_OK;
+    }
+}
+
+DecodeStatus IkfbStreamDecoder::fail(const char* message) {
+    _state = STATE_ERROR;
+    _error = message;
+    return DECODE_ERROR;
+}
+
+DecodeStatus IkfbStreamDecoder::unsupported(const char* message) {
+    _state = STATE_UNSUPPORTED;
+    _error = message;
+    return DECODE_UNSUPPORTED;
+}
+
+DecodeStatus IkfbStreamDecoder::feed(const uint8_t* data, size_t length) {
+    size_t pos = 0;
+
+    while (pos < length && _state < STATE_DONE) {
+        if (_state == STATE_HEADER) {
+            while (pos < length && _headerFill < IKFB_HEADER_SIZE) {
+                _header[_headerFill++] = data[pos++];
+            }
+            if (_headerFill == IKFB_HEADER_SIZE && startImage()) {
+                _state = STATE_PIXELS;
+            }
+            continue;
+        }
+
+        if (_compression == IKFB_COMPRESSION_NONE) {
+            size_t take = _rowBytes - _rowFill;
+            if (take > length - pos) {
+                take = length - pos;
+            }
+            storeBytes(data + pos, take);
+            pos += take;
+        } else if (_literalRemaining > 0) {
+            size_t take = _literalRemaining;
+            if (take > length - pos) {
+                take = length - pos;
+            }
+            if (take > _rowBytes - _rowFill) {
+                take = _rowBytes - _rowFill;  // Rest of the run goes to the next row
+            }
+            storeBytes(data + pos, take);
+            pos += take;
+            _literalRemaining -= (uint16_t)take;
+        } else if (_repeatCount > 0) {
+            uint16_t count = _repeatCount;
+            _repeatCount = 0;
+            repeatByte(data[pos++], count);
+        } else {
+            uint8_t control = data[pos++];
+            if (control < 128) {
+                _literalRemaining = (uint16_t)(control + 1);
+            } else if (control > 128) {
+                _repeatCount = (uint16_t)(257 - control);
+            }
+            // 128 is a no-op
+        }
+    }
+    if (_state == STATE_DONE && (_literalRemaining > 0 || _repeatCount > 0)) {
+        return fail("IKFB run extends past the last row");
+    }
+    return status();
+}
+
+bool IkfbStreamDecoder::startImage() {
+    if (memcmp(_header, IKFB_MAGIC, 4) != 0) {
+        fail("Not an IKFB file");
+        return false;
+    }
+    if (_header[4] != IKFB_VERSION) {
+        unsupported("Unsupported IKFB version");
+        return false;
+    }
+    _format = _header[5];
+    _compression = _header[6];
+    _rotation = _header[7];
+    _width = readLittleEndian16(_header + 8);
+    _height = readLittleEndian16(_header + 10);
+
+    if (_format != PIXEL_FORMAT_1BIT && _format != PIXEL_FORMAT_TRICOLOR && _format != PIXEL_FORMAT_3BIT) {
+        unsupported("Unsupported IKFB pixel format");
+        return false;
+    }
+    if (_compression != IKFB_COMPRESSION_NONE && _compression != IKFB_COMPRESSION_RLE) {
+        unsupported("Unsupported IKFB compression");
+        return false;
+    }
+    if (_rotation > 3 || _width == 0 || _height == 0) {
+        fail("Invalid IKFB header");
+        return false;
+    }
+
+    _rowBytes = rowBytes(_width, _format);
+    _rowBuffer = (uint8_t*)malloc(_rowBytes + _width);
+    if (_rowBuffer == nullptr) {
+        fail("Out of memory for IKFB rows");
+        return false;
+    }
+    _packedRow = _rowBuffer;
+    _levelRow = _rowBuffer + _rowBytes;
+
+    if (_sink != nullptr) {
+        _native = _sink->beginLevels(_width, _height, _format);
+        if (!_native && !_sink->begin(_width, _height)) {
+            fail("Image sink rejected dimensions");
+            return false;
+        }
+    }
+    return true;
+}
+
+void IkfbStreamDecoder::storeBytes(const uint8_t* data, size_t length) {
+    memcpy(_packedRow + _rowFill, data, length);
+    _rowFill += length;
+    if (_rowFill == _rowBytes) {
+        emitRow();
+    }
+}
+
+void IkfbStreamDecoder::repeatByte(uint8_t value, size_t count) {
+    while (count > 0 && _state == STATE_PIXELS) {
+        size_t take = _rowBytes - _rowFill;
+        if (take > count) {
+            take = count;
+        }
+        memset(_packedRow + _rowFill, value, take);
+        _rowFill += take;
+        count -= take;
+        if (_rowFill == _rowBytes) {
+            emitRow();
+        }
+    }
+    if (count > 0) {
+        fail("IKFB run extends past the last row");
+    }
+}
+
+void IkfbStreamDecoder::emitRow() {
+    const uint8_t* packed = _packedRow;
+    uint8_t* levels = _levelRow;
+    const uint16_t width = _width;
+
+    switch (_format) {
+        case PIXEL_FORMAT_3BIT:
+            for (uint16_t x = 0; x < width; x++) {
+                uint8_t b = packed[x >> 1];
+                levels[x] = (x & 1) ? (b & 0x07) : ((b >> 4) & 0x07);
+            }
+            break;
+        case PIXEL_FORMAT_TRICOLOR:
+            for (uint16_t x = 0; x < width; x++) {
+                uint8_t value = (packed[x >> 2] >> (6 - 2 * (x & 3))) & 0x03;
+                levels[x] = value > 2 ? 1 : value;  // 3 is undefined - treat as white
+            }
+            break;
+        default:
+            for (uint16_t x = 0; x < width; x++) {
+                levels[x] = (packed[x >> 3] >> (7 - (x & 7))) & 1;
+            }
+            break;
+    }
+
+    if (_sink != nullptr) {
+        if (_native) {
+            _sink->writeLevelRow(_y, levels, width);
+        } else {
+            // Expand to gray so any sink can quantize it (red becomes mid gray)
+            for (uint16_t x = 0; x < width; x++) {
+                uint8_t level = levels[x];
+                if (_format == PIXEL_FORMAT_3BIT) {
+                    levels[x] = (uint8_t)(level * 255 / 7);
+                } else if (_format == PIXEL_FORMAT_TRICOLOR && level == 2) {
+                    levels[x] = 128;
+                } else {
+                    levels[x] = level ? 255 : 0;
+                }
+            }
+            _sink->writeRow(_y, levels, width);
+        }
+    }
+
+    _rowFill = 0;
+    if (++_y == _height) {
+        _state = STATE_DONE;
+    }
+}
+
+bool isIkfbUrl(const char* url) {
+    if (url == nullptr) {
+        return false;
+    }
+    const char* end = url;
+    while (*end != '\0' && *end != '?' && *end != '#') {
+        end++;
+    }
+    size_t extLen = strlen(IKFB_EXTENSION);
+    if ((size_t)(end - url) < extLen) {
+        return false;
+    }
+    const char* ext = end - extLen;
+    for (size_t i = 0; i < extLen; i++) {
+        char c = ext[i];
+        if (c >= 'A' && c <= 'Z') {
+            c = c - 'A' + 'a';
+        }
+        if (c != IKFB_EXTENSION[i]) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,134 @@
+#ifndef IKFB_DECODER_H
+#define IKFB_DECODER_H
+
+#include <image_decoder.h>
+
+#define IKFB_HEADER_SIZE 16
+#define IKFB_VERSION 1
+#define IKFB_EXTENSION ".ikfb"          // Only used to route Inkplate 2 downloads
+
+enum IkfbCompression {
+    IKFB_COMPRESSION_NONE = 0,
+    IKFB_COMPRESSION_RLE = 1            // PackBits over the packed row bytes
+};
+
+/**
+ * @brief Incremental decoder for IKFB, the pre-quantized native image format
+ *
+ * Pure C++ with NO dependencies on Arduino/ESP32 APIs.
+ *
+ * IKFB files carry pixels already quantized (and dithered) by the server in
+ * the panel's own levels, so decoding is just unpacking bits. Layout:
+ *
+ *   offset  size  field
+ *   0       4     magic "IKFB"
+ *   4       1     version (1)
+ *   5       1     pixel format (PixelFormat: 1 = 1-bit, 2 = tri-color, 3 = 3-bit)
+ *   6       1     compression (IkfbCompression)
+ *   7       1     rotation the image was rendered for (0-3, Inkplate setRotation)
+ *   8       2     width, little endian
+ *   10      2     height, little endian
+ *   12      4     reserved (0)
+ *   16            packed rows, top to bottom, each padded to a whole byte
+ *
+ * Row packing matches PackedFramebuffer: 3-bit stores two pixels per byte
+ * (even column in the high nibble), 1-bit eight pixels per byte MSB first
+ * (1 = white), tri-color four 2-bit pixels per byte MSB first
+ * (0 = black, 1 = white, 2 = red). RLE uses PackBits: a control byte n < 128
+ * copies n + 1 literal bytes, n > 128 repeats the next byte 257 - n times;
+ * runs may cross row boundaries.
+ *
+ * Rows go to ImageRowSink::writeLevelRow() unchanged when the sink accepts
+ * the pixel format, otherwise they are expanded to gray for writeRow().
+ *
+ * Memory: one packed row + one level row.
+ */
+class IkfbStreamDecoder {
+public:
+    IkfbStreamDecoder();
+    ~IkfbStreamDecoder();
+
+    /**
+     * @brief Reset state for a new image
+     * @param sink Receives decoded rows (must outlive decoding)
+     */
+    void begin(ImageRowSink* sink);
+
+    /**
+     * @brief Release all buffers
+     */
+    void end();
+
+    /**
+     * @brief Decode the next chunk of the file
+     * @return DECODE_OK, DECODE_DONE, DECODE_UNSUPPORTED or DECODE_ERROR
+     */
+    DecodeStatus feed(const uint8_t* data, size_t length);
+
+    const char* getError() const { return _error; }
+    uint16_t getWidth() const { return _width; }
+    uint16_t getHeight() const { return _height; }
+    uint8_t getPixelFormat() const { return _format; }
+    uint8_t getRotation() const { return _rotation; }
+
+    // true if rows bypassed the sink's quantizer
+    bool isNativeOutput() const { return _native; }
+
+    // Bytes of heap currently held (row buffers)
+    size_t getMemoryUsage() const;
+
+    /**
+     * @brief Packed bytes per row for a pixel format
+     */
+    static size_t rowBytes(uint16_t width, uint8_t pixelFormat);
+
+private:
+    enum State {
+        STATE_HEADER,
+        STATE_PIXELS,
+        STATE_DONE,
+        STATE_UNSUPPORTED,
+        STATE_ERROR
+    };
+
+    ImageRowSink* _sink;
+    State _state;
+    const char* _error;
+
+    uint8_t _header[IKFB_HEADER_SIZE];
+    uint8_t _headerFill;
+    uint8_t _format;
+    uint8_t _compression;
+    uint8_t _rotation;
+    uint16_t _width;
+    uint16_t _height;
+    bool _native;
+
+    // Row assembly
+    uint8_t* _rowBuffer;        // packed row | level row
+    uint8_t* _packedRow;
+    uint8_t* _levelRow;
+    size_t _rowBytes;
+    size_t _rowFill;
+    uint16_t _y;
+
+    // PackBits state
+    uint16_t _literalRemaining;
+    uint16_t _repeatCount;      // > 0 while waiting for the byte to repeat
+
+    DecodeStatus status() const;
+    DecodeStatus fail(const char* message);
+    DecodeStatus unsupported(const char* message);
+
+    bool startImage();
+    void storeBytes(const uint8_t* data, size_t length);
+    void repeatByte(uint8_t value, size_t count);
+    void emitRow();
+};
+
+/**
+ * @brief Check whether an image URL points to an IKFB file (path ends in ".ikfb")
+ */
+bool isIkfbUrl(const char* url);
+
+#endif // IKFB_DECODER_H
@@ -0,0 +1,189 @@
+#include <image_cache.h>
+#include <clock_sync.h>
+#include <fnv1a.h>
+#include <string.h>
+
+#define SECONDS_PER_DAY 86400
+
+static uint32_t indexChecksum(const ImageCacheIndex& index) {
+    return fnv1a(FNV1A_OFFSET_BASIS, &index, offsetof(ImageCacheIndex, checksum));
+}
+
+static bool isCached(const ImageCacheIndex& index, uint8_t slot) {
+    return slot < IMAGE_SLOT_COUNT && index.entries[slot].size > 0;
+}
+
+static uint32_t bytesWrittenToday(const ImageCacheIndex& index, uint32_t now) {
+    return index.writeDay == now / SECONDS_PER_DAY ? index.bytesWritten : 0;
+}
+
+void initImageCacheIndex(ImageCacheIndex& index) {
+    memset(&index, 0, sizeof(index));
+    index.magic = IMAGE_CACHE_MAGIC;
+    index.version = IMAGE_CACHE_VERSION;
+}
+
+bool isImageCacheIndexValid(const ImageCacheIndex& index) {
+    if (index.magic != IMAGE_CACHE_MAGIC || index.version != IMAGE_CACHE_VERSION) {
+        return false;
+    }
+    uint32_t total = 0;
+    for (int i = 0; i < IMAGE_SLOT_COUNT; i++) {
+        if (index.entries[i].size > IMAGE_CACHE_MAX_BYTES) {
+            return false;
+        }
+        total += index.entries[i].size;
+    }
+    return total <= IMAGE_CACHE_MAX_BYTES;
+}
+
+bool loadImageCacheIndex(ImageCacheStorage& storage, ImageCacheIndex& index) {
+    ImageCacheIndex loaded;
+    if (storage.read(IMAGE_CACHE_INDEX_PATH, (uint8_t*)&loaded, sizeof(loaded)) == sizeof(loaded) &&
+        loaded.checksum == indexChecksum(loaded) && isImageCacheIndexValid(loaded)) {
+        index = loaded;
+        return true;
+    }
+    initImageCacheIndex(index);
+    return false;
+}
+
+bool saveImageCacheIndex(ImageCacheStorage& storage, const ImageCacheIndex& index) {
+    ImageCacheIndex sealed = index;
+    sealed.checksum = indexChecksum(sealed);
+    return storage.write(IMAGE_CACHE_INDEX_TEMP_PATH, (const uint8_t*)&sealed, sizeof(sealed)) &&
+           storage.rename(IMAGE_CACHE_INDEX_TEMP_PATH, IMAGE_CACHE_INDEX_PATH);
+}
+
+uint32_t imageCacheValidatorHash(const char* etag, const char* lastModified) {
+    size_t etagLength = etag != nullptr ? strlen(etag) : 0;
+    size_t lastModifiedLength = lastModified != nullptr ? strlen(lastModified) : 0;
+    if (etagLength == 0 && lastModifiedLength == 0) {
+        return 0;
+    }
+    // The separator keeps "ab" + "" apart from "a" + "b"
+    uint32_t hash = fnv1a(FNV1A_OFFSET_BASIS, etag, etagLength);
+    hash = fnv1aByte(hash, '\n');
+    hash = fnv1a(hash, lastModified, lastModifiedLength);
+    return hash == 0 ? 1 : hash;
+}
+
+const ImageCacheEntry* findImageCacheEntry(const ImageCacheIndex& index, uint8_t slot) {
+    return isCached(index, slot) ? &index.entries[slot] : nullptr;
+}
+
+uint32_t getImageCacheBytes(const ImageCacheIndex& index) {
+    uint32_t total = 0;
+    for (int i = 0; i < IMAGE_SLOT_COUNT; i++) {
+        total += index.entries[i].size;
+    }
+    return total;
+}
+
+ImageCacheWriteDecision decideImageCacheWrite(const ImageCacheIndex& index, uint8_t slot, uint32_t urlHash,
+                                              uint32_t crc32, uint32_t validatorHash, uint32_t size,
+                                              uint32_t reservedBytes, uint32_t now) {
+    if (slot >= IMAGE_SLOT_COUNT) {
+        return { false, false, "No slot" };
+    }
+    if (now < CLOCK_MIN_VALID_TIME) {
+        return { false, false, "Clock not set - write limits unknown" };
+    }
+    const ImageCacheEntry* entry = findImageCacheEntry(index, slot);
+    if (entry != nullptr && entry->urlHash == urlHash) {
+        if ((crc32 != 0 && crc32 == entry->crc32) || (validatorHash != 0 && validatorHash == entry->validatorHash)) {
+            return { false, true, "Cached copy is current" };
+        }
+        if (now >= entry->storedAt && now - entry->storedAt < IMAGE_CACHE_MIN_REWRITE_SECONDS) {
+            return { false, false, "Cached copy replaced less than an hour ago" };
+        }
+    }
+    if (bytesWrittenToday(index, now) + size > IMAGE_CACHE_DAILY_WRITE_BYTES) {
+        return { false, false, "Daily flash write budget used up" };
+    }
+    if (reservedBytes >= IMAGE_CACHE_MAX_BYTES || size > IMAGE_CACHE_MAX_BYTES - reservedBytes) {
+        return { false, false, "Too large for the flash budget" };
+    }
+    return { true, false, "Copying download to flash" };
+}
+
+uint8_t makeImageCacheRoom(ImageCacheIndex& index, uint8_t slot, uint32_t size, uint32_t reservedBytes,
+                           uint8_t* outRemoved) {
+    uint8_t removed = 0;
+    if (isCached(index, slot)) {
+        outRemoved[removed++] = slot;
+        memset(&index.entries[slot], 0, sizeof(ImageCacheEntry));
+    }
+    uint32_t needed = reservedBytes + size;
+    while (getImageCacheBytes(index) + needed > IMAGE_CACHE_MAX_BYTES) {
+        int oldest = -1;
+        for (int i = 0; i < IMAGE_SLOT_COUNT; i++) {
+            if (index.entries[i].size > 0 &&
+                (oldest < 0 || index.entries[i].validatedAt < index.entries[oldest].validatedAt)) {
+                oldest = i;
+            }
+        }
+        if (oldest < 0) {
+            break;  // Nothing left to evict - the caller's write limit catches the rest
+        }
+        outRemoved[removed++] = (uint8_t)oldest;
+        memset(&index.entries[oldest], 0, sizeof(ImageCacheEntry));
+    }
+    return removed;
+}
+
+void recordImageCacheStored(ImageCacheIndex& index, uint8_t slot, uint32_t urlHash, uint32_t crc32,
+                            uint32_t validatorHash, uint32_t size, uint32_t now) {
+    if (slot >= IMAGE_SLOT_COUNT) {
+        return;
+    }
+    ImageCacheEntry& entry = index.entries[slot];
+    entry.urlHash = urlHash;
+    entry.crc32 = crc32;
+    entry.validatorHash = validatorHash;
+    entry.size = size;
+    entry.storedAt = now;
+    entry.validatedAt = now;
+    index.bytesWritten = bytesWrittenToday(index, now) + size;
+    index.writeDay = now / SECONDS_PER_DAY;
+}
+
+void recordImageCacheValidated(ImageCacheIndex& index, uint8_t slot, uint32_t urlHash, uint32_t crc32,
+                               uint32_t validatorHash, uint32_t now) {
+    if (!isCached(index, slot)) {
+        return;
+    }
+    ImageCacheEntry& entry = index.entries[slot];
+    bool sameContent = (crc32 != 0 && crc32 == entry.crc32) ||
+                       (validatorHash != 0 && validatorHash == entry.validatorHash);
+    if (entry.urlHash == urlHash && sameContent && now > entry.validatedAt) {
+        entry.validatedAt = now;
+    }
+}
+
+void removeImageCacheEntry(ImageCacheIndex& index, uint8_t slot) {
+    if (slot < IMAGE_SLOT_COUNT) {
+        memset(&index.entries[slot], 0, sizeof(ImageCacheEntry));
+    }
+}
+
+ImageCacheDisplayDecision decideImageCacheDisplay(const ImageCacheIndex& index, uint8_t slot, uint32_t urlHash,
+                                                  uint8_t displayedSlot, uint32_t maxAgeSeconds, uint32_t now) {
+    const ImageCacheEntry* entry = findImageCacheEntry(index, slot);
+    if (entry == nullptr) {
+        return { IMAGE_CACHE_MISS, "Slot not cached" };
+    }
+    if (entry->urlHash != urlHash) {
+        return { IMAGE_CACHE_MISS, "Cached file is from a different URL" };
+    }
+    if (now < CLOCK_MIN_VALID_TIME || now < entry->validatedAt) {
+        return { IMAGE_CACHE_MISS, "Clock not set - cache age unknown" };
+    }
+    if (now - entry->validatedAt > maxAgeSeconds) {
+        return { IMAGE_CACHE_MISS, "Cached file too old" };
+    }
+    if (slot == displayedSlot) {
+        return { IMAGE_CACHE_ON_SCREEN, "Slot already on screen" };
+    }
+    return { IMAGE_CACHE_SHOW, "Drawing cached image" };
+}
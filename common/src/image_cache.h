@@ -0,0 +1,210 @@
+#ifndef IMAGE_CACHE_H
+#define IMAGE_CACHE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <image_slot_table.h>
+
+// Layout version - bump when the structs change so stale index files are discarded
+#define IMAGE_CACHE_VERSION 1
+#define IMAGE_CACHE_MAGIC 0x43494B49                    // "IKIC"
+#define IMAGE_CACHE_DIR "/cache"
+#define IMAGE_CACHE_INDEX_PATH "/cache/index"
+#define IMAGE_CACHE_INDEX_TEMP_PATH "/cache/index.tmp"  // Written first, renamed over the index
+#define IMAGE_CACHE_MAX_BYTES (160u * 1024u)            // Flash budget, shared with the prefetch files
+#define IMAGE_CACHE_MIN_REWRITE_SECONDS 3600            // A slot's file is replaced at most once an hour
+#define IMAGE_CACHE_DAILY_WRITE_BYTES (512u * 1024u)    // Flash written per UTC day
+#define IMAGE_CACHE_REDISPLAY_MAX_AGE_SECONDS 21600     // 6 hours - button wakes show older copies only after the download
+#define IMAGE_CACHE_MAX_STALE_SECONDS 86400             // 24 hours - oldest copy shown instead of an error screen
+
+/**
+ * @brief Last successfully displayed image per carousel slot, kept in flash
+ *
+ * Pure C++ with NO dependencies on Arduino/ESP32 APIs, making it fully
+ * testable with standard C++ unit testing frameworks.
+ *
+ * Every downloaded image that was displayed is copied to flash as it streams
+ * in (the bytes as downloaded plus the HTTP validators). The copy lets the
+ * device redraw a slot without the network: button wakes show it at once and
+ * then revalidate it, and a download that keeps failing shows the last good
+ * image instead of the error screen.
+ *
+ * Flash wear: a slot's file is only rewritten when its content changed, at
+ * most once per IMAGE_CACHE_MIN_REWRITE_SECONDS, and all files together at
+ * most IMAGE_CACHE_DAILY_WRITE_BYTES per day. Revalidations only update the
+ * copy of the index in RTC memory; the index file is written when a file is
+ * stored or evicted, so it survives a cold boot.
+ *
+ * Times are the ESP32 system clock (Unix seconds), see clock_sync.h.
+ */
+
+/**
+ * @brief One cached image file
+ */
+struct ImageCacheEntry {
+    uint32_t urlHash;           // prefetchUrlHash() of the URL the file was downloaded from
+    uint32_t crc32;             // CRC32 from the .crc32 file (0 = unknown)
+    uint32_t validatorHash;     // imageCacheValidatorHash() of the ETag / Last-Modified (0 = none)
+    uint32_t size;              // File size in bytes (validators + image), 0 = slot not cached
+    uint32_t storedAt;          // Time the file was written
+    uint32_t validatedAt;       // Time of the download or the last confirmation it is current
+};
+
+struct ImageCacheIndex {
+    uint32_t magic;                             // IMAGE_CACHE_MAGIC
+    uint8_t version;                            // IMAGE_CACHE_VERSION (0 after a cold boot = invalid)
+    uint8_t reserved[3];
+    uint32_t writeDay;                          // UTC day (time / 86400) of bytesWritten
+    uint32_t bytesWritten;                      // Flash bytes written to files that day
+    ImageCacheEntry entries[IMAGE_SLOT_COUNT];  // By slot
+    uint32_t checksum;                          // FNV-1a of the fields above (set when saved)
+};
+
+/**
+ * @brief Decision structure for copying a download into the cache
+ */
+struct ImageCacheWriteDecision {
+    bool write;                 // Copy the download to flash
+    bool current;               // The cached file already has this content (revalidated instead)
+    const char* reason;         // Human-readable reason for this decision
+};
+
+enum ImageCacheLookup {
+    IMAGE_CACHE_MISS,           // Not cached (or from another URL, too old, clock not set)
+    IMAGE_CACHE_ON_SCREEN,      // The panel already shows this slot - nothing to draw
+    IMAGE_CACHE_SHOW            // Draw the cached file
+};
+
+/**
+ * @brief Decision structure for drawing a slot from the cache
+ */
+struct ImageCacheDisplayDecision {
+    ImageCacheLookup lookup;
+    const char* reason;         // Human-readable reason for this decision
+};
+
+/**
+ * @brief Flash access used to load and save the index (LittleFS on the device, files in tests)
+ */
+class ImageCacheStorage {
+public:
+    virtual ~ImageCacheStorage() {}
+
+    // Read up to size bytes of a file - returns the bytes read, 0 if it does not exist
+    virtual size_t read(const char* path, uint8_t* buffer, size_t size) = 0;
+
+    // Create or replace a file
+    virtual bool write(const char* path, const uint8_t* data, size_t size) = 0;
+
+    // Rename a file, replacing the destination
+    virtual bool rename(const char* from, const char* to) = 0;
+
+    virtual bool remove(const char* path) = 0;
+};
+
+/**
+ * @brief Reset to "nothing cached"
+ */
+void initImageCacheIndex(ImageCacheIndex& index);
+
+/**
+ * @brief Check an index read from RTC memory (magic, version, entries within the budget)
+ * @return false if it must be loaded from flash again
+ */
+bool isImageCacheIndexValid(const ImageCacheIndex& index);
+
+/**
+ * @brief Load the index file
+ * @return false if it is missing, truncated, from another layout or corrupt (index re-initialized)
+ */
+bool loadImageCacheIndex(ImageCacheStorage& storage, ImageCacheIndex& index);
+
+/**
+ * @brief Save the index file (temporary file renamed over the old one, so a
+ *        power loss leaves either the old or the new index)
+ */
+bool saveImageCacheIndex(ImageCacheStorage& storage, const ImageCacheIndex& index);
+
+/**
+ * @brief FNV-1a of the HTTP validators a file was downloaded with
+ * @return 0 if both are empty (nothing to compare)
+ */
+uint32_t imageCacheValidatorHash(const char* etag, const char* lastModified);
+
+/**
+ * @brief The cached file of a slot
+ * @return nullptr if the slot is not cached
+ */
+const ImageCacheEntry* findImageCacheEntry(const ImageCacheIndex& index, uint8_t slot);
+
+/**
+ * @brief Bytes used by all cached files
+ */
+uint32_t getImageCacheBytes(const ImageCacheIndex& index);
+
+/**
+ * @brief Decide whether a download that is about to be displayed is copied to flash
+ *
+ * Not written: content the file already has (same URL and CRC32 or
+ * validators - the caller records a revalidation instead), a file replaced
+ * less than IMAGE_CACHE_MIN_REWRITE_SECONDS ago, a day whose write budget is
+ * used up, an image larger than the space the prefetch files leave, or an
+ * unset clock (the limits need the time).
+ *
+ * @param size Expected file size (validators + Content-Length), 0 = unknown
+ * @param reservedBytes Flash held by the prefetch files
+ * @param now Current system time
+ * @return ImageCacheWriteDecision with write flag and reason
+ */
+ImageCacheWriteDecision decideImageCacheWrite(const ImageCacheIndex& index, uint8_t slot, uint32_t urlHash,
+                                              uint32_t crc32, uint32_t validatorHash, uint32_t size,
+                                              uint32_t reservedBytes, uint32_t now);
+
+/**
+ * @brief Evict the least recently validated files until size more bytes fit
+ *
+ * The slot's own file is evicted too (it is about to be replaced). Pass
+ * IMAGE_SLOT_NONE and size 0 to shrink the cache to make room for prefetch
+ * files.
+ *
+ * @param reservedBytes Flash held by the prefetch files
+ * @param outRemoved Receives the evicted slots, whose files must be deleted (IMAGE_SLOT_COUNT entries)
+ * @return Number of evicted slots
+ */
+uint8_t makeImageCacheRoom(ImageCacheIndex& index, uint8_t slot, uint32_t size, uint32_t reservedBytes,
+                           uint8_t* outRemoved);
+
+/**
+ * @brief Record a file written for a slot (counts it against the daily write budget)
+ */
+void recordImageCacheStored(ImageCacheIndex& index, uint8_t slot, uint32_t urlHash, uint32_t crc32,
+                            uint32_t validatorHash, uint32_t size, uint32_t now);
+
+/**
+ * @brief Record that the server confirmed a slot's cached content
+ *
+ * Only applies when the confirmed CRC32 or validators are the ones of the
+ * cached file. Changes the index in RTC memory only - no flash write.
+ */
+void recordImageCacheValidated(ImageCacheIndex& index, uint8_t slot, uint32_t urlHash, uint32_t crc32,
+                               uint32_t validatorHash, uint32_t now);
+
+/**
+ * @brief Forget a slot's file (unreadable or undecodable)
+ */
+void removeImageCacheEntry(ImageCacheIndex& index, uint8_t slot);
+
+/**
+ * @brief Decide whether a slot can be drawn from the cache
+ *
+ * @param urlHash prefetchUrlHash() of the slot's configured URL
+ * @param displayedSlot Slot on the panel (IMAGE_SLOT_NONE = unknown)
+ * @param maxAgeSeconds Oldest confirmation accepted (IMAGE_CACHE_REDISPLAY_MAX_AGE_SECONDS
+ *                      or IMAGE_CACHE_MAX_STALE_SECONDS)
+ * @param now Current system time
+ * @return ImageCacheDisplayDecision with lookup result and reason
+ */
+ImageCacheDisplayDecision decideImageCacheDisplay(const ImageCacheIndex& index, uint8_t slot, uint32_t urlHash,
+                                                  uint8_t displayedSlot, uint32_t maxAgeSeconds, uint32_t now);
+
+#endif // IMAGE_CACHE_H
@@ -0,0 +1,101 @@
+#ifndef IMAGE_DECODER_H
+#define IMAGE_DECODER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Streaming image decoding - types shared by all decoders
+ *
+ * Pure C++ with NO dependencies on Arduino/ESP32 APIs, so the decoders are
+ * compiled unchanged into the host test suite.
+ *
+ * Images are decoded incrementally as bytes arrive from the network: the
+ * caller feeds arbitrary chunks, decoded rows are pushed to an ImageRowSink
+ * as 8-bit grayscale (0 = black, 255 = white), or as panel levels for
+ * pre-quantized IKFB images. Nothing proportional to the file size is ever
+ * buffered; memory is bounded by one decode window (32 KB DEFLATE window for
+ * PNG, one MCU row for JPEG, one packed row for IKFB).
+ *
+ * See StreamingImageDecoder for the format-detecting entry point.
+ */
+
+enum ImageFormat {
+    IMAGE_FORMAT_UNKNOWN = 0,
+    IMAGE_FORMAT_PNG,
+    IMAGE_FORMAT_JPEG,
+    IMAGE_FORMAT_IKFB    // Pre-quantized native format (see ikfb_decoder.h)
+};
+
+/**
+ * @brief Panel level sets for pre-quantized rows
+ */
+enum PixelFormat {
+    PIXEL_FORMAT_1BIT = 1,      // 0 = black, 1 = white
+    PIXEL_FORMAT_TRICOLOR = 2,  // 0 = black, 1 = white, 2 = red (Inkplate 2)
+    PIXEL_FORMAT_3BIT = 3       // 0 = black .. 7 = white
+};
+
+enum DecodeStatus {
+    DECODE_OK,           // Chunk consumed, more data expected
+    DECODE_DONE,         // Every row has been delivered; further input is ignored
+    DECODE_UNSUPPORTED,  // Valid image using a feature the streaming decoder lacks
+    DECODE_ERROR         // Corrupt data, unknown format or out of memory
+};
+
+/**
+ * @brief Receives decoded rows, top to bottom
+ */
+class ImageRowSink {
+public:
+    virtual ~ImageRowSink() {}
+
+    /**
+     * @brief Called once the dimensions are known, before the first row
+     * @return false to abort decoding (e.g. out of memory)
+     */
+    virtual bool begin(uint16_t width, uint16_t height) = 0;
+
+    /**
+     * @brief One decoded row
+     * @param y Row index (0-based, strictly increasing)
+     * @param gray Luminance per pixel, 0 = black, 255 = white
+     * @param width Number of pixels in the row
+     */
+    virtual void writeRow(uint16_t y, const uint8_t* gray, uint16_t width) = 0;
+
+    /**
+     * @brief Called instead of begin() for images that are already quantized
+     * @param format PixelFormat of the rows
+     * @return true if the sink takes these levels unchanged via writeLevelRow();
+     *         false makes the decoder expand them to gray and call begin()
+     */
+    virtual bool beginLevels(uint16_t width, uint16_t height, uint8_t format) {
+        (void)width; (void)height; (void)format;
+        return false;
+    }
+
+    /**
+     * @brief One pre-quantized row (only after beginLevels() returned true)
+     * @param levels One level per pixel in the accepted PixelFormat
+     */
+    virtual void writeLevelRow(uint16_t y, const uint8_t* levels, uint16_t width) {
+        (void)y; (void)levels; (void)width;
+    }
+};
+
+/**
+ * @brief Convert RGB to luminance using the Inkplate library weights
+ */
+inline uint8_t rgbToGray(uint8_t r, uint8_t g, uint8_t b) {
+    return (uint8_t)((54 * r + 183 * g + 19 * b) >> 8);
+}
+
+/**
+ * @brief Composite a gray value with alpha onto a white background
+ */
+inline uint8_t compositeOnWhite(uint8_t gray, uint8_t alpha) {
+    return (uint8_t)((gray * alpha + 255 * (255 - alpha) + 127) / 255);
+}
+
+#endif // IMAGE_DECODER_H
@@ -1,14 +1,239 @@
 #include "image_manager.h"
 #include "logger.h"
+#include "streaming_image_decoder.h"
+#include "framebuffer_sink.h"
 #include <HTTPClient.h>
-#include <WiFiClientSecure.h>
+#include <LittleFS.h>
+
+namespace {
+
+// Writes quantized rows into the Inkplate framebuffer
+class InkplatePixelWriter : public PixelRowWriter {
+public:
+    InkplatePixelWriter(Inkplate* display, uint8_t bitsPerPixel)
+        : _display(display), _threeBit(bitsPerPixel == 3) {}
+
+    void writeLevels(int16_t x, int16_t y, const uint8_t* levels, uint16_t count) override {
+        for (uint16_t i = 0; i < count; i++) {
+#ifdef DISPLAY_MODE_INKPLATE2
+            // Tri-color: 0 = black, 1 = white, 2 = red
+            uint8_t color = levels[i] == 2 ? INKPLATE2_RED : (levels[i] ? INKPLATE2_WHITE : INKPLATE2_BLACK);
+#else
+            // 3-bit: level is the gray value (0 black .. 7 white); 1-bit: 0 = black
+            uint8_t color = _threeBit ? levels[i] : (levels[i] ? WHITE : BLACK);
+#endif
+            _display->drawPixel(x + i, y, color);
+        }
+    }
+
+private:
+    Inkplate* _display;
+    bool _threeBit;
+};
+
+// Adapts HTTPClient::writeToStream() to the streaming decoder: every chunk the
+// HTTP client reads (chunked or not) is decoded and drawn before the next read.
+// Optionally copies the bytes to a flash file (image cache) up to a limit.
+class DecoderStream : public Stream {
+public:
+    DecoderStream(StreamingImageDecoder* decoder, File* copy = nullptr, size_t copyLimit = 0)
+        : _decoder(decoder), _copy(copy), _copyLimit(copyLimit), _copied(0), _copyFailed(false) {}
+
+    size_t write(uint8_t b) override {
+        return write(&b, 1);
+    }
+
+    size_t write(const uint8_t* buffer, size_t size) override {
+        DecodeStatus status = _decoder->getStatus();
+        if (status == DECODE_OK) {
+            status = _decoder->feed(buffer, size);
+        }
+        if (_copy != nullptr && !_copyFailed) {
+            // A full or failing flash only loses the copy, never the download
+            if (_copied + size > _copyLimit || _copy->write(buffer, size) != size) {
+                _copyFailed = true;
+            } else {
+                _copied += size;
+            }
+        }
+        // Bytes after the last row (PNG IEND, JPEG EOI) are accepted and ignored;
+        // returning 0 on failure makes HTTPClient abort the transfer
+        return (status == DECODE_OK || status == DECODE_DONE) ? size : 0;
+    }
+
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+
+    size_t getCopiedBytes() const { return _copyFailed ? 0 : _copied; }
+
+private:
+    StreamingImageDecoder* _decoder;
+    File* _copy;
+    size_t _copyLimit;
+    size_t _copied;
+    bool _copyFailed;
+};
+
+// Collects a small response body (tile manifest) into a fixed buffer
+class BufferStream : public Stream {
+public:
+    BufferStream(char* buffer, size_t capacity) : _buffer(buffer), _capacity(capacity), _length(0) {}
+
+    size_t write(uint8_t b) override {
+        return write(&b, 1);
+    }
+
+    size_t write(const uint8_t* buffer, size_t size) override {
+        if (_length + size > _capacity) {
+            return 0;  // Too large - makes HTTPClient abort the transfer
+        }
+        memcpy(_buffer + _length, buffer, size);
+        _length += size;
+        return size;
+    }
+
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+
+    size_t length() const { return _length; }
+
+private:
+    char* _buffer;
+    size_t _capacity;
+    size_t _length;
+};
+
+// Writes a response body to a flash file, up to a byte limit (the prefetch budget)
+class FileLimitStream : public Stream {
+public:
+    FileLimitStream(File* file, size_t limit) : _file(file), _limit(limit), _length(0) {}
+
+    size_t write(uint8_t b) override {
+        return write(&b, 1);
+    }
+
+    size_t write(const uint8_t* buffer, size_t size) override {
+        if (_length + size > _limit) {
+            return 0;  // Over budget - makes HTTPClient abort the transfer
+        }
+        size_t written = _file->write(buffer, size);
+        _length += written;
+        return written;
+    }
+
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+
+private:
+    File* _file;
+    size_t _limit;
+    size_t _length;
+};
+
+// Start of every prefetch and image cache file, followed by the ETag, the
+// Last-Modified value (lengths below, not terminated) and the image exactly as downloaded
+#define CACHED_IMAGE_MAGIC 0x46504B49  // "IKPF"
+
+struct CachedImageHeader {
+    uint32_t magic;
+    uint8_t etagLength;
+    uint8_t lastModifiedLength;
+    uint16_t reserved;
+};
+
+// Returns the bytes written, 0 on failure
+size_t writeCachedImageHeader(File& file, const ConditionalRequest& validators) {
+    // Validators that do not fit are dropped: the next online wake downloads unconditionally
+    CachedImageHeader header = { CACHED_IMAGE_MAGIC, 0, 0, 0 };
+    header.etagLength = validators.etag.length() <= 0xFF ? validators.etag.length() : 0;
+    header.lastModifiedLength = validators.lastModified.length() <= 0xFF ? validators.lastModified.length() : 0;
+    bool written = file.write((const uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+                   file.write((const uint8_t*)validators.etag.c_str(), header.etagLength) == header.etagLength &&
+                   file.write((const uint8_t*)validators.lastModified.c_str(), header.lastModifiedLength) ==
+                       header.lastModifiedLength;
+    return written ? sizeof(header) + header.etagLength + header.lastModifiedLength : 0;
+}
+
+bool readCachedImageHeader(File& file, ConditionalRequest& validators) {
+    CachedImageHeader header;
+    char text[0x100];
+    if (file.read((uint8_t*)&header, sizeof(header)) != sizeof(header) || header.magic != CACHED_IMAGE_MAGIC) {
+        return false;
+    }
+    if (file.read((uint8_t*)text, header.etagLength) != header.etagLength) {
+        return false;
+    }
+    text[header.etagLength] = '\0';
+    validators.etag = text;
+    if (file.read((uint8_t*)text, header.lastModifiedLength) != header.lastModifiedLength) {
+        return false;
+    }
+    text[header.lastModifiedLength] = '\0';
+    validators.lastModified = text;
+    return true;
+}
+
+// Image cache index file on LittleFS
+class LittleFSCacheStorage : public ImageCacheStorage {
+public:
+    size_t read(const char* path, uint8_t* buffer, size_t size) override {
+        File file = LittleFS.open(path, "r");
+        if (!file) {
+            return 0;
+        }
+        size_t length = file.read(buffer, size);
+        file.close();
+        return length;
+    }
+
+    bool write(const char* path, const uint8_t* data, size_t size) override {
+        File file = LittleFS.open(path, "w");
+        if (!file) {
+            return false;
+        }
+        bool written = file.write(data, size) == size;
+        file.close();
+        return written;
+    }
+
+    bool rename(const char* from, const char* to) override {
+        return LittleFS.rename(from, to);
+    }
+
+    bool remove(const char* path) override {
+        return LittleFS.remove(path);
+    }
+};
+
+}  // namespace
 
 ImageManager::ImageManager(Inkplate* display, DisplayManager* displayManager) {
     _display = display;
     _displayManager = displayManager;
     _configManager = nullptr;
     _overlayManager = nullptr;
+    _clockManager = nullptr;
     _lastError = "";
+    _tlsPinned = false;
+    _lastRefreshMs = 0;
+    _partialRefresh = false;
+    _fullRefreshEvery = 0;
+    _deferRefresh = false;
+    _refreshPending = false;
+    _manifestDrawn = false;
+    _manifestUnchanged = false;
+    _manifestUrlHash = 0;
+    _manifestRegionCount = 0;
+    _prefetchIndex = nullptr;
+    _flashMounted = false;
+    _imageCache = nullptr;
+    _cacheSlot = IMAGE_SLOT_NONE;
+    _cacheCRC32 = 0;
+    _cacheCopyPending = false;
+    _connection.setTlsStats(&_tlsStats);
 }
 
 void ImageManager::setConfigManager(ConfigManager* configManager) {
@@ -19,6 +244,76 @@ void ImageManager::setOverlayManager(OverlayManager* overlayManager) {
     _overlayManager = overlayManager;
 }
 
+void ImageManager::setClockManager(ClockManager* clockManager) {
+    _clockManager = clockManager;
+}
+
+void ImageManager::setPrefetchIndex(PrefetchIndex* index) {
+    _prefetchIndex = index;
+    if (_prefetchIndex != nullptr && !isPrefetchIndexValid(*_prefetchIndex)) {
+        initPrefetchIndex(*_prefetchIndex);
+    }
+}
+
+void ImageManager::setTlsSessionCache(TlsSessionCache* cache) {
+    _connection.setTlsSessionCache(cache);
+}
+
+void ImageManager::setNetworkCache(NetworkCache* cache) {
+    _connection.setNetworkCache(cache);
+}
+
+bool ImageManager::setTlsFingerprint(const char* fingerprint) {
+    _tlsPinned = false;
+    bool valid = true;
+    if (fingerprint[0] != '\0') {
+        _tlsPinned = parseCertFingerprint(fingerprint, _tlsFingerprint);
+        if (!_tlsPinned) {
+            Logger::message("TLS", "Invalid certificate fingerprint - pinning disabled");
+            valid = false;
+        }
+    }
+    _connection.setTlsFingerprint(_tlsPinned ? _tlsFingerprint : nullptr);
+    return valid;
+}
+
+const TlsStats& ImageManager::getTlsStats() const {
+    return _tlsStats;
+}
+
+const HttpConnectionStats& ImageManager::getConnectionStats() const {
+    return _connection.getStats();
+}
+
+uint32_t ImageManager::getLastRefreshMs() const {
+    return _lastRefreshMs;
+}
+
+void ImageManager::setDeferRefresh(bool defer) {
+    _deferRefresh = defer;
+}
+
+bool ImageManager::hasPendingRefresh() const {
+    return _refreshPending;
+}
+
+void ImageManager::completePendingRefresh() {
+    if (!_refreshPending) {
+        return;
+    }
+    _refreshPending = false;
+    refreshDisplay();
+}
+
+void ImageManager::closeConnection() {
+    _connection.close();
+}
+
+void ImageManager::setPartialRefresh(bool enabled, uint8_t fullRefreshEvery) {
+    _partialRefresh = enabled;
+    _fullRefreshEvery = fullRefreshEvery;
+}
+
 bool ImageManager::isHttps(const char* url) {
     return (strncmp(url, "https://", 8) == 0);
 }
@@ -55,22 +350,13 @@ uint32_t ImageManager::parseHexCRC32(const String& hexStr) {
     return result;
 }
 
-bool ImageManager::checkCRC32Changed(const char* url, uint32_t* outNewCRC32, uint8_t* outRetryCount) {
-    if (!_configManager) {
-        Logger::message("CRC32 Check", "ConfigManager not set - cannot check CRC32");
-        if (outRetryCount) *outRetryCount = 0;
-        return true;  // Fallback to download
-    }
-    
+bool ImageManager::checkCRC32Changed(const char* url, uint32_t storedCRC32, uint32_t* outNewCRC32, uint8_t* outRetryCount) {
     Logger::begin("Checking CRC32 for changes");
     
     // Construct CRC32 URL
     String crc32Url = String(url) + ".crc32";
     Logger::line("CRC32 URL: " + crc32Url);
     
-    // Determine if HTTPS or HTTP
-    bool useHttps = isHttps(crc32Url.c_str());
-    
     // Progressive timeout strategy: {300ms, 700ms, 1500ms}
     // Total max time: 300 + 100 + 700 + 100 + 1500 = 2700ms (~2.7s)
     const int crcTimeouts[] = {300, 700, 1500};  // Progressive timeouts (ms)
@@ -82,21 +368,15 @@ bool ImageManager::checkCRC32Changed(const char* url, uint32_t* outNewCRC32, uin
     String crc32Content = "";
     
     // Try with progressive timeouts and deadline enforcement
+    // The connection stays open after a successful fetch for the image request
     for (int attempt = 0; attempt < maxRetries; attempt++) {
-        HTTPClient http;
-        WiFiClient client;
-        WiFiClientSecure secureClient;
-        
-        if (useHttps) {
-            secureClient.setInsecure();
-            http.begin(secureClient, crc32Url);
-        } else {
-            http.begin(client, crc32Url);
-        }
+        HTTPClient& http = _connection.begin(crc32Url);
         
         // Set progressive timeout (for connection/inactivity)
         http.setTimeout(crcTimeouts[attempt]);
         http.setUserAgent("InkplateDashboard/1.0");
+        const char* dateHeader[] = {"Date"};
+        http.collectHeaders(dateHeader, 1);
         
         Logger::linef("CRC32 attempt %d/%d", attempt + 1, maxRetries);
         
@@ -106,13 +386,16 @@ bool ImageManager::checkCRC32Changed(const char* url, uint32_t* outNewCRC32, uin
         
         // Send GET request
         httpCode = http.GET();
+        if (httpCode > 0) {
+            applyServerDate(http);
+        }
         
         unsigned long elapsed = millis() - startTime;
         
         // Force timeout if we exceeded our deadline, even if request "succeeded"
         if (elapsed > deadline) {
             Logger::linef("Deadline exceeded (%lums)", elapsed);
-            http.end();
+            _connection.close();  // Response may be partly read
             httpCode = -1;  // Force retry
             
             // If this attempt failed and not the last attempt, increment retry count and delay
@@ -126,19 +409,18 @@ bool ImageManager::checkCRC32Changed(const char* url, uint32_t* outNewCRC32, uin
         if (httpCode == HTTP_CODE_OK) {
             // Read CRC32 content
             crc32Content = http.getString();
-            http.end();
+            _connection.end();
             
             if (crc32Content.length() > 0) {
                 Logger::linef("CRC32 fetched (%lums)", elapsed);
                 break;  // Success - exit loop without incrementing retry count
             } else {
                 Logger::line("CRC32 file empty");
-                http.end();
                 httpCode = -1;  // Treat as failure
             }
         } else {
             Logger::linef("CRC32 fetch failed (code: %d)", httpCode);
-            http.end();
+            _connection.close();
         }
         
         // If this attempt failed and not the last attempt, increment retry count and delay
@@ -167,8 +449,6 @@ bool ImageManager::checkCRC32Changed(const char* url, uint32_t* outNewCRC32, uin
     uint32_t newCRC32 = parseHexCRC32(crc32Content);
     Logger::linef("New: 0x%08X", newCRC32);
     
-    // Get stored CRC32
-    uint32_t storedCRC32 = _configManager->getLastCRC32();
     Logger::linef("Stored: 0x%08X", storedCRC32);
     
     // Return the new CRC32 value if caller requested it
@@ -182,26 +462,17 @@ bool ImageManager::checkCRC32Changed(const char* url, uint32_t* outNewCRC32, uin
         return false;  // No change, skip download
     } else {
         Logger::end("CHANGED - Downloading");
-        // NOTE: Deferred - CRC32 is NOT saved here, caller must call saveCRC32()
-        // after confirming successful image display
+        // NOTE: Deferred - CRC32 is NOT saved here, caller records it in the
+        // slot table after confirming successful image display
         return true;  // Changed, proceed with download
     }
 }
 
-void ImageManager::saveCRC32(uint32_t crc32Value) {
-    if (!_configManager) {
-        Logger::line("ConfigManager not set - cannot save CRC32");
-        return;
-    }
-    
-    Logger::linef("CRC32 updated: 0x%08X", crc32Value);
-    _configManager->setLastCRC32(crc32Value);
-}
-
 bool ImageManager::downloadAndDisplay(const char* url,
                                      float batteryVoltage,
                                      const char* updateTimeStr,
-                                     unsigned long cycleTimeMs) {
+                                     unsigned long cycleTimeMs,
+                                     ConditionalRequest* conditional) {
     _lastError = "";
     
     Logger::begin("Starting image download");
@@ -216,37 +487,46 @@ bool ImageManager::downloadAndDisplay(const char* url,
     
     showDownloadProgress("Downloading and rendering image...");
     
-    // Use the InkPlate library's drawImage function
-    // The library supports PNG and JPEG (baseline DCT with Huffman coding, not progressive)
-    // This method handles the HTTP(S) download internally
     bool success = false;
     
     // Draw image at rotation 0 (images should be pre-rotated by user)
     _displayManager->disableRotation();
     
-    // Draw the image directly from URL
-    // The InkPlate library's drawImage method downloads and renders in one operation
-    if (_display->drawImage(url, 0, 0, true, false)) {
-        Logger::line("Image downloaded and displayed successfully!");
-        
-        // Enable configured rotation before rendering overlay
-        // This ensures overlay always uses the user's configured rotation
-        _displayManager->enableRotation();
-        
-        // Render overlay if overlay manager is configured
-        if (_overlayManager != nullptr && _configManager != nullptr) {
-            DashboardConfig config;
-            if (_configManager->loadConfig(config)) {
-                _overlayManager->renderOverlay(config, batteryVoltage, updateTimeStr, cycleTimeMs);
-            }
+    _manifestDrawn = false;
+    _manifestUnchanged = false;
+    _manifestRegionCount = 0;
+    
+    // Decode while downloading - rows are drawn as the bytes arrive (and copied
+    // to the image cache when a slot was set)
+    _cacheCopyPending = _cacheSlot != IMAGE_SLOT_NONE && _imageCache != nullptr && canCacheFile(url);
+    bool rendered = renderImage(url, conditional);
+    _cacheCopyPending = false;
+    _cacheSlot = IMAGE_SLOT_NONE;
+    
+    // The image is the last request of the cycle - free the socket (and TLS
+    // buffers) before the display refresh and MQTT
+    _connection.close();
+    
+    if (rendered) {
+        if (conditional != nullptr && conditional->notModified) {
+            // Nothing was drawn - the panel keeps showing the current image
+            _displayManager->enableRotation();
+            Logger::end("Image not modified (HTTP 304) - keeping current screen");
+            return true;
+        }
+        if (_manifestUnchanged) {
+            _displayManager->enableRotation();
+            Logger::end("No tiles changed - keeping current screen");
+            return true;
         }
         
-        // Actually refresh the e-ink display to show the new image
-        _display->display();
-        
+        Logger::line("Image downloaded and displayed successfully!");
+        finishFrame(batteryVoltage, updateTimeStr, cycleTimeMs);
         success = true;
     } else {
-        showError("Failed to download or draw image (check URL, format: PNG or baseline JPEG, size must match screen)");
+        if (_lastError.length() == 0) {
+            showError("Failed to download or draw image (check URL, format: PNG or baseline JPEG, size must match screen)");
+        }
         success = false;
     }
     
@@ -259,6 +539,795 @@ bool ImageManager::downloadAndDisplay(const char* url,
     return success;
 }
 
+void ImageManager::finishFrame(float batteryVoltage, const char* updateTimeStr, unsigned long cycleTimeMs) {
+    // Enable configured rotation before rendering overlay
+    // This ensures overlay always uses the user's configured rotation
+    _displayManager->enableRotation();
+    
+    // Render overlay if overlay manager is configured
+    if (_overlayManager != nullptr && _configManager != nullptr) {
+        const DashboardConfig& config = _configManager->getConfig();
+        if (config.isConfigured) {
+            _overlayManager->renderOverlay(config, batteryVoltage, updateTimeStr, cycleTimeMs);
+        }
+    }
+    
+    // Actually refresh the e-ink display to show the new image
+    if (_deferRefresh) {
+        _refreshPending = true;  // Caller refreshes via completePendingRefresh()
+    } else {
+        refreshDisplay();
+    }
+}
+
+void ImageManager::refreshDisplay() {
+    unsigned long refreshStart = millis();
+    TileHashGrid* stored = _displayManager->getTileHashGrid();
+    bool tracked = false;
+#ifndef DISPLAY_MODE_INKPLATE2
+    if (_partialRefresh && stored != nullptr && _display->getDisplayMode() == INKPLATE_1BIT) {
+        // Hash the raw panel buffer (native orientation, 1 bit per pixel)
+        static TileHashGrid current;
+        if (computeTileHashes(_display->DMemoryNew, E_INK_WIDTH / 8, E_INK_WIDTH, E_INK_HEIGHT, 1, current)) {
+            tracked = true;
+            if (_manifestRegionCount > 0) {
+                // Only the changed manifest tiles were drawn - the rest of the
+                // buffer is blank, so the diff is taken from the manifest
+                Logger::linef("Partial refresh of %u changed tile(s)", _manifestRegionCount);
+                partialRefreshRegions(_manifestRegions, _manifestRegionCount);
+                commitTileHashRegions(*stored, current, _manifestRegions, _manifestRegionCount);
+            } else {
+                TileDiff diff;
+                diffTileHashes(*stored, current, diff);
+                RefreshDecision decision = decideRefresh(*stored, diff, _fullRefreshEvery);
+                Logger::linef("%s - %u/%u tiles changed", decision.reason, diff.changedTiles, diff.totalTiles);
+                
+                if (decision.kind == REFRESH_PARTIAL) {
+                    partialRefreshRegions(diff.regions, diff.regionCount);
+                } else if (decision.kind == REFRESH_FULL) {
+                    _display->display();
+                }
+                commitTileHashGrid(*stored, current, decision.kind);
+            }
+        }
+    }
+#endif
+    if (!tracked) {
+        // Full refresh without tracking - the stored hashes no longer describe the panel
+        if (stored != nullptr) {
+            initTileHashGrid(*stored);
+        }
+        _display->display();
+    }
+    
+    // Remember which manifest tiles are on the panel (a plain image clears it)
+    TileManifestState* manifestState = _displayManager->getTileManifestState();
+    if (manifestState != nullptr) {
+        if (_manifestDrawn) {
+            recordTileManifestState(*manifestState, _manifest, _manifestUrlHash);
+        } else {
+            initTileManifestState(*manifestState);
+        }
+    }
+    _lastRefreshMs = millis() - refreshStart;
+}
+
+#ifndef DISPLAY_MODE_INKPLATE2
+void ImageManager::partialRefreshRegions(const TileRegion* regions, uint8_t count) {
+    // The previous frame is gone after deep sleep, so the library's "previous"
+    // buffer is rebuilt from the new frame with the regions inverted: only
+    // those pixels are driven. Regions must be byte-aligned (x multiple of 8).
+    const size_t stride = E_INK_WIDTH / 8;
+    memcpy(_display->_partial, _display->DMemoryNew, stride * E_INK_HEIGHT);
+    for (uint8_t r = 0; r < count; r++) {
+        const TileRegion& region = regions[r];
+        size_t first = region.x / 8;
+        size_t last = (region.x + region.width + 7) / 8;
+        for (uint16_t y = region.y; y < region.y + region.height; y++) {
+            uint8_t* row = _display->_partial + (size_t)y * stride;
+            for (size_t i = first; i < last; i++) {
+                row[i] = ~row[i];
+            }
+        }
+    }
+    _display->partialUpdate(true);  // Forced: the library blocks partial updates after wake
+}
+#endif
+
+bool ImageManager::renderImage(const char* url, ConditionalRequest* conditional) {
+    if (isTileManifestUrl(url)) {
+        return renderTileManifest(url, conditional);
+    }
+#ifndef DISPLAY_MODE_INKPLATE2
+    bool unsupported = false;
+    if (streamImageToDisplay(url, conditional, &unsupported)) {
+        return true;
+    }
+    if (!unsupported) {
+        return false;
+    }
+    Logger::line("Falling back to library decoder");
+#else
+    if (isIkfbUrl(url)) {
+        // The library cannot decode IKFB; the streaming path draws red as well
+        bool unsupported = false;
+        return streamImageToDisplay(url, conditional, &unsupported);
+    }
+    // The library decoder cannot send request headers, so the conditional
+    // request runs first and the library download only happens on a 200
+    if (conditional != nullptr) {
+        int httpCode = beginImageRequest(url, conditional);
+        _connection.close();  // The library opens its own connection
+        if (conditional->notModified) {
+            return true;
+        }
+        if (httpCode != HTTP_CODE_OK) {
+            showError((String("Failed to download image (HTTP ") + String(httpCode) + ")").c_str());
+            return false;
+        }
+    }
+#endif
+    // Inkplate 2 uses the library for PNG/JPEG: its tri-color panel needs the
+    // library's red handling, and its 212x104 images are tiny anyway
+    return _display->drawImage(url, 0, 0, true, false);
+}
+
+int ImageManager::beginImageRequest(const char* url, ConditionalRequest* conditional) {
+    HTTPClient& http = _connection.begin(url);
+    http.setTimeout(IMAGE_STREAM_TIMEOUT_MS);
+    http.setUserAgent("InkplateDashboard/1.0");
+    http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
+    
+    if (conditional != nullptr) {
+        conditional->notModified = false;
+        if (conditional->etag.length() > 0) {
+            http.addHeader("If-None-Match", conditional->etag);
+        }
+        if (conditional->lastModified.length() > 0) {
+            http.addHeader("If-Modified-Since", conditional->lastModified);
+        }
+    }
+    const char* responseHeaders[] = {"ETag", "Last-Modified", "Date"};
+    http.collectHeaders(responseHeaders, 3);
+    
+    int httpCode = http.GET();
+    if (httpCode > 0) {
+        applyServerDate(http);
+    }
+    
+    if (conditional != nullptr) {
+        if (httpCode == HTTP_CODE_NOT_MODIFIED) {
+            // Stored validators are still current - keep them as they are
+            conditional->notModified = true;
+            Logger::line("HTTP 304 Not Modified");
+        } else if (httpCode == HTTP_CODE_OK) {
+            conditional->etag = http.header("ETag");
+            conditional->lastModified = http.header("Last-Modified");
+            if (conditional->etag.length() == 0 && conditional->lastModified.length() == 0) {
+                Logger::line("Warning: server sent no ETag or Last-Modified - change detection unavailable");
+            }
+        }
+    }
+    
+    return httpCode;
+}
+
+void ImageManager::applyServerDate(HTTPClient& http) {
+    if (_clockManager != nullptr && http.hasHeader("Date")) {
+        _clockManager->syncFromHttpDate(http.header("Date").c_str());
+    }
+}
+
+bool ImageManager::streamImageToDisplay(const char* url, ConditionalRequest* conditional, bool* outUnsupported,
+                                        int16_t originX, int16_t originY) {
+    *outUnsupported = false;
+    
+    unsigned long startTime = millis();
+    int httpCode = beginImageRequest(url, conditional);
+    HTTPClient& http = _connection.getHttpClient();
+    if (conditional != nullptr && conditional->notModified) {
+        _connection.end();
+        return true;
+    }
+    if (httpCode != HTTP_CODE_OK) {
+        _connection.close();
+        showError((String("Failed to download image (HTTP ") + String(httpCode) + ")").c_str());
+        return false;
+    }
+    
+#ifdef DISPLAY_MODE_INKPLATE2
+    uint8_t bitsPerPixel = 2;  // Tri-color (red only from IKFB images)
+#else
+    uint8_t bitsPerPixel = _display->getDisplayMode() == INKPLATE_3BIT ? 3 : 1;
+#endif
+    InkplatePixelWriter writer(_display, bitsPerPixel);
+    FramebufferSink sink(&writer, bitsPerPixel, true, _display->width(), _display->height(), originX, originY);
+    StreamingImageDecoder decoder(&sink);
+    
+    // Image cache copy, when the write policy allows one
+    File copy;
+    size_t copyLimit = 0;
+    size_t copyHeaderBytes = 0;
+    if (_cacheCopyPending) {
+        _cacheCopyPending = false;
+        copyHeaderBytes = beginCacheCopy(url, http, copy, copyLimit);
+    }
+    DecoderStream stream(&decoder, copyHeaderBytes > 0 ? &copy : nullptr, copyLimit);
+    
+    int contentLength = http.getSize();  // -1 = chunked
+    int bodyBytes = http.writeToStream(&stream);
+    DecodeStatus status = decoder.finish();
+    if (copyHeaderBytes > 0) {
+        bool complete = status == DECODE_DONE && bodyBytes > 0 &&
+                        (contentLength < 0 || (size_t)contentLength == stream.getCopiedBytes());
+        finishCacheCopy(url, http, copy, copyHeaderBytes, stream.getCopiedBytes(), complete);
+    }
+    if (status == DECODE_DONE) {
+        _connection.end();
+    } else {
+        _connection.close();  // Body may be partly unread
+    }
+    
+    Logger::linef("Streamed %u bytes (%s %ux%u) in %lums, decoder peak %u bytes",
+                  (unsigned)decoder.getBytesFed(),
+                  decoder.getFormat() == IMAGE_FORMAT_PNG ? "PNG" :
+                  decoder.getFormat() == IMAGE_FORMAT_JPEG ? "JPEG" :
+                  decoder.getFormat() == IMAGE_FORMAT_IKFB ? "IKFB" : "unknown",
+                  decoder.getWidth(), decoder.getHeight(),
+                  millis() - startTime,
+                  (unsigned)(decoder.getPeakMemoryUsage() + sink.getMemoryUsage()));
+    
+    if (status == DECODE_UNSUPPORTED) {
+        *outUnsupported = true;
+        Logger::line(String("Streaming decoder: ") + decoder.getError());
+        return false;
+    }
+    if (decoder.getRotation() >= 0 && decoder.getRotation() != _display->getRotation()) {
+        Logger::linef("Warning: IKFB image was rendered for rotation %d, screen uses %d",
+                      decoder.getRotation(), _display->getRotation());
+    }
+    if (status != DECODE_DONE) {
+        showError((String("Image decode failed: ") + (decoder.getError() ? decoder.getError() : "unknown error")).c_str());
+        return false;
+    }
+    return true;
+}
+
+bool ImageManager::renderTileManifest(const char* url, ConditionalRequest* conditional) {
+    int httpCode = beginImageRequest(url, conditional);
+    HTTPClient& http = _connection.getHttpClient();
+    if (conditional != nullptr && conditional->notModified) {
+        _connection.end();
+        return true;
+    }
+    if (httpCode != HTTP_CODE_OK) {
+        _connection.close();
+        showError((String("Failed to download tile manifest (HTTP ") + String(httpCode) + ")").c_str());
+        return false;
+    }
+    
+    char* text = (char*)malloc(TILE_MANIFEST_MAX_SIZE + 1);
+    if (text == nullptr) {
+        _connection.close();
+        showError("Out of memory for tile manifest");
+        return false;
+    }
+    BufferStream stream(text, TILE_MANIFEST_MAX_SIZE);
+    int written = http.writeToStream(&stream);
+    text[stream.length()] = '\0';
+    if (written < 0) {
+        _connection.close();
+        free(text);
+        showError(written == HTTPC_ERROR_STREAM_WRITE ? "Tile manifest too large" : "Failed to read tile manifest");
+        return false;
+    }
+    _connection.end();
+    
+    const char* parseError = nullptr;
+    if (!parseTileManifest(text, _manifest, &parseError)) {
+        free(text);
+        showError((String("Invalid tile manifest: ") + parseError).c_str());
+        return false;
+    }
+    if (_manifest.width != _display->width() || _manifest.height != _display->height()) {
+        free(text);
+        showError((String("Tile manifest size ") + _manifest.width + "x" + _manifest.height +
+                   " does not match the screen").c_str());
+        return false;
+    }
+    
+    // Download only the changed tiles when the panel still shows this manifest
+    // and they can be refreshed on their own; otherwise compose the whole frame
+    _manifestUrlHash = tileManifestUrlHash(url);
+    bool changed[TILE_MANIFEST_MAX_TILES];
+    uint8_t changedCount = TILE_MANIFEST_MAX_TILES;
+    TileManifestState* state = _displayManager->getTileManifestState();
+    if (state != nullptr && canDrawTilesIncrementally()) {
+        changedCount = planTileManifestUpdate(*state, _manifest, _manifestUrlHash, changed);
+        uint32_t changedArea = 0;
+        for (uint8_t i = 0; i < _manifest.tileCount; i++) {
+            if (changed[i]) {
+                changedArea += (uint32_t)_manifest.tiles[i].width * _manifest.tiles[i].height;
+            }
+        }
+        if (changedArea * 100 > (uint32_t)_manifest.width * _manifest.height * TILE_PARTIAL_MAX_CHANGED_PERCENT) {
+            changedCount = TILE_MANIFEST_MAX_TILES;  // Large change - full frame and full refresh
+        }
+    }
+    bool incremental = changedCount < _manifest.tileCount;
+    Logger::linef("Tile manifest: %u tiles, %u to download", _manifest.tileCount,
+                  incremental ? changedCount : _manifest.tileCount);
+    
+    if (incremental && changedCount == 0) {
+        free(text);
+        _manifestUnchanged = true;
+        return true;
+    }
+    
+    bool success = true;
+    char tileUrl[TILE_MANIFEST_URL_SIZE];
+    for (uint8_t i = 0; i < _manifest.tileCount && success; i++) {
+        if (incremental && !changed[i]) {
+            continue;
+        }
+        const ManifestTile& tile = _manifest.tiles[i];
+        if (!resolveTileUrl(url, tile.url, tileUrl, sizeof(tileUrl))) {
+            showError("Tile URL too long");
+            success = false;
+            break;
+        }
+        success = drawTile(tileUrl, tile.x, tile.y);
+        if (success && incremental) {
+            TileRegion& region = _manifestRegions[_manifestRegionCount++];
+            region.x = tile.x;
+            region.y = tile.y;
+            region.width = tile.width;
+            region.height = tile.height;
+        }
+    }
+    free(text);  // Tile URLs point into the text - not used after this
+    
+    if (!success) {
+        _manifestRegionCount = 0;
+        if (_lastError.length() == 0) {
+            showError("Failed to download or draw a dashboard tile");
+        }
+        return false;
+    }
+    _manifestDrawn = true;
+    return true;
+}
+
+bool ImageManager::drawTile(const char* url, int16_t x, int16_t y) {
+    Logger::line("Tile: " + String(url));
+#ifndef DISPLAY_MODE_INKPLATE2
+    bool unsupported = false;
+    if (streamImageToDisplay(url, nullptr, &unsupported, x, y)) {
+        return true;
+    }
+    if (!unsupported) {
+        return false;
+    }
+    Logger::line("Falling back to library decoder");
+#endif
+    _connection.close();  // The library opens its own connection
+    return _display->drawImage(url, x, y, true, false);
+}
+
+bool ImageManager::canDrawTilesIncrementally() {
+#ifndef DISPLAY_MODE_INKPLATE2
+    TileHashGrid* grid = _displayManager->getTileHashGrid();
+    if (!_partialRefresh || grid == nullptr || _display->getDisplayMode() != INKPLATE_1BIT ||
+        !isTileHashGridValid(*grid) || grid->partialCount >= _fullRefreshEvery) {
+        return false;
+    }
+    // The overlay is drawn over tiles that are not downloaded again
+    if (_overlayManager != nullptr && _configManager != nullptr && _configManager->getConfig().overlayEnabled) {
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+uint8_t ImageManager::prefetchImages(const DashboardConfig& config, uint8_t currentIndex) {
+    if (_prefetchIndex == nullptr) {
+        return 0;
+    }
+    
+    // Slots the next timer wakes advance to, without the ones that cannot be cached
+    uint8_t planned[PREFETCH_MAX_ENTRIES];
+    uint8_t slots[PREFETCH_MAX_ENTRIES];
+    uint32_t urlHashes[PREFETCH_MAX_ENTRIES];
+    uint8_t plannedCount = planPrefetchSlots(config.imageStay, config.imageCount, currentIndex,
+                                             config.prefetchCount, planned);
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < plannedCount; i++) {
+        const char* url = config.imageUrls[planned[i]].c_str();
+        if (canCacheFile(url)) {
+            slots[count] = planned[i];
+            urlHashes[count++] = prefetchUrlHash(url);
+        }
+    }
+    if (count == 0 && !hasPrefetchedImages(*_prefetchIndex)) {
+        return 0;  // Prefetch off and nothing to clean up - leave the flash alone
+    }
+    
+    Logger::begin("Prefetching carousel images");
+    if (!mountFlashStore()) {
+        Logger::end("Flash filesystem unavailable - prefetch skipped");
+        return 0;
+    }
+    
+    // Evict files of slots that are not coming up (or whose URL changed), and
+    // orphans of an index lost on cold boot
+    uint8_t removed[PREFETCH_MAX_ENTRIES];
+    uint8_t removedCount = retainPrefetchEntries(*_prefetchIndex, slots, urlHashes, count, removed);
+    for (uint8_t i = 0; i < removedCount; i++) {
+        LittleFS.remove(prefetchPath(removed[i]));
+    }
+    for (uint8_t slot = 0; slot < IMAGE_SLOT_COUNT; slot++) {
+        if (findPrefetchEntry(*_prefetchIndex, slot) == nullptr && LittleFS.exists(prefetchPath(slot))) {
+            LittleFS.remove(prefetchPath(slot));
+        }
+    }
+    
+    uint8_t cached = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        if (prefetchSlot(slots[i], config.imageUrls[slots[i]].c_str(), urlHashes[i])) {
+            cached++;
+        }
+    }
+    _connection.close();
+    Logger::end((String(cached) + " of " + String(count) + " image(s) cached for the next wakes").c_str());
+    return cached;
+}
+
+bool ImageManager::prefetchSlot(uint8_t slot, const char* url, uint32_t urlHash) {
+    Logger::linef("Image %u: %s", slot + 1, url);
+    String path = prefetchPath(slot);
+    
+    // A cached file is revalidated with the validators it was downloaded with
+    ConditionalRequest conditional;
+    if (findPrefetchEntry(*_prefetchIndex, slot) != nullptr) {
+        File file = LittleFS.open(path, "r");
+        if (!file || !readCachedImageHeader(file, conditional)) {
+            removePrefetchEntry(*_prefetchIndex, slot);
+            conditional = ConditionalRequest();
+        }
+        file.close();
+    }
+    
+    int httpCode = beginImageRequest(url, &conditional);
+    uint32_t now = (uint32_t)time(nullptr);
+    if (conditional.notModified) {
+        _connection.end();
+        recordPrefetchValidated(*_prefetchIndex, slot, now);
+        return true;  // No flash write
+    }
+    if (httpCode != HTTP_CODE_OK) {
+        _connection.close();
+        Logger::linef("Download failed (HTTP %d)", httpCode);
+        return false;
+    }
+    
+    // The file is rewritten in place: forget it first, so an interrupted write is never shown
+    removePrefetchEntry(*_prefetchIndex, slot);
+    HTTPClient& http = _connection.getHttpClient();
+    uint32_t budget = getPrefetchBudget(*_prefetchIndex, slot);
+    uint32_t headerBytes = sizeof(CachedImageHeader) + conditional.etag.length() + conditional.lastModified.length();
+    int contentLength = http.getSize();  // -1 = chunked
+    if (headerBytes >= budget || (contentLength > 0 && headerBytes + (uint32_t)contentLength > budget)) {
+        _connection.close();
+        LittleFS.remove(path);
+        Logger::linef("Too large for the cache (%u bytes left)", (unsigned)budget);
+        return false;
+    }
+    
+    // Prefetch files come first: the image cache gives up the flash they need
+    if (loadImageCache()) {
+        uint32_t incoming = contentLength > 0 ? headerBytes + (uint32_t)contentLength : budget;
+        uint8_t removed[IMAGE_SLOT_COUNT];
+        uint8_t removedCount = makeImageCacheRoom(*_imageCache, IMAGE_SLOT_NONE, 0,
+                                                  getPrefetchBytes() + incoming, removed);
+        evictCachedImages(removed, removedCount);
+    }
+    
+    unsigned long startTime = millis();
+    File file = LittleFS.open(path, "w");
+    headerBytes = file ? writeCachedImageHeader(file, conditional) : 0;
+    int bodyBytes = -1;
+    if (headerBytes > 0) {
+        FileLimitStream stream(&file, budget - headerBytes);
+        bodyBytes = http.writeToStream(&stream);
+    }
+    file.close();
+    if (bodyBytes <= 0 || (contentLength > 0 && bodyBytes != contentLength)) {
+        _connection.close();
+        LittleFS.remove(path);
+        Logger::linef("Not cached (%s)", headerBytes == 0 ? "flash write failed" :
+                                         bodyBytes == HTTPC_ERROR_STREAM_WRITE ? "over the flash budget or write failed" :
+                                         "download incomplete");
+        return false;
+    }
+    _connection.end();
+    
+    recordPrefetchStored(*_prefetchIndex, slot, urlHash, headerBytes + bodyBytes, now);
+    Logger::linef("Cached %d bytes in %lums", bodyBytes, millis() - startTime);
+    return true;
+}
+
+bool ImageManager::displayPrefetched(uint8_t slot, float batteryVoltage, const char* updateTimeStr,
+                                     unsigned long cycleTimeMs, ConditionalRequest* validators) {
+    _lastError = "";
+    if (_prefetchIndex == nullptr || findPrefetchEntry(*_prefetchIndex, slot) == nullptr) {
+        return false;
+    }
+    
+    Logger::begin("Displaying prefetched image");
+    if (!mountFlashStore()) {
+        showError("Flash filesystem unavailable");
+        Logger::end();
+        return false;
+    }
+    if (!drawCachedFile(prefetchPath(slot), validators)) {
+        removePrefetchEntry(*_prefetchIndex, slot);
+        Logger::end();
+        return false;
+    }
+    
+    finishFrame(batteryVoltage, updateTimeStr, cycleTimeMs);
+    Logger::end("Image display complete!");
+    return true;
+}
+
+void ImageManager::setImageCacheIndex(ImageCacheIndex* index) {
+    // Not re-initialized here: an invalid RTC copy is reloaded from the index file on first use
+    _imageCache = index;
+}
+
+void ImageManager::setCacheSlot(uint8_t slot, uint32_t crc32) {
+    _cacheSlot = slot;
+    _cacheCRC32 = crc32;
+}
+
+ImageCacheDisplayDecision ImageManager::checkImageCache(uint8_t slot, const char* url, uint8_t displayedSlot,
+                                                        uint32_t maxAgeSeconds) {
+    if (!loadImageCache()) {
+        return { IMAGE_CACHE_MISS, "Image cache unavailable" };
+    }
+    return decideImageCacheDisplay(*_imageCache, slot, prefetchUrlHash(url), displayedSlot, maxAgeSeconds,
+                                   (uint32_t)time(nullptr));
+}
+
+bool ImageManager::displayCached(uint8_t slot, float batteryVoltage, const char* updateTimeStr,
+                                 unsigned long cycleTimeMs, ConditionalRequest* validators, uint32_t* outCRC32) {
+    // _lastError is kept: after a failed download it still describes the failure
+    if (!loadImageCache() || findImageCacheEntry(*_imageCache, slot) == nullptr) {
+        return false;
+    }
+    
+    Logger::begin("Displaying cached image");
+    uint32_t crc32 = findImageCacheEntry(*_imageCache, slot)->crc32;
+    if (!mountFlashStore() || !drawCachedFile(imageCachePath(slot), validators)) {
+        evictCachedImages(&slot, 1);
+        Logger::end();
+        return false;
+    }
+    if (outCRC32 != nullptr) {
+        *outCRC32 = crc32;
+    }
+    
+    finishFrame(batteryVoltage, updateTimeStr, cycleTimeMs);
+    Logger::end("Image display complete!");
+    return true;
+}
+
+void ImageManager::confirmCachedImage(uint8_t slot, const char* url, uint32_t crc32,
+                                      const ConditionalRequest* validators) {
+    // Only the RTC copy: not worth mounting the flash (or writing it) for a timestamp
+    if (_imageCache == nullptr || !isImageCacheIndexValid(*_imageCache)) {
+        return;
+    }
+    uint32_t validatorHash = validators != nullptr
+                             ? imageCacheValidatorHash(validators->etag.c_str(), validators->lastModified.c_str())
+                             : 0;
+    recordImageCacheValidated(*_imageCache, slot, prefetchUrlHash(url), crc32, validatorHash,
+                              (uint32_t)time(nullptr));
+}
+
+bool ImageManager::drawCachedFile(const String& path, ConditionalRequest* validators) {
+    unsigned long startTime = millis();
+    File file = LittleFS.open(path, "r");
+    uint8_t* buffer = (uint8_t*)malloc(FLASH_READ_CHUNK);
+    if (!file || buffer == nullptr || !readCachedImageHeader(file, *validators)) {
+        file.close();
+        free(buffer);
+        showError("Cached image unreadable");
+        return false;
+    }
+    
+    // Same streaming decode as a download, fed from flash
+    _displayManager->disableRotation();
+    _manifestDrawn = false;
+    _manifestUnchanged = false;
+    _manifestRegionCount = 0;
+    
+#ifdef DISPLAY_MODE_INKPLATE2
+    uint8_t bitsPerPixel = 2;  // Tri-color (red only from IKFB images)
+#else
+    uint8_t bitsPerPixel = _display->getDisplayMode() == INKPLATE_3BIT ? 3 : 1;
+#endif
+    InkplatePixelWriter writer(_display, bitsPerPixel);
+    FramebufferSink sink(&writer, bitsPerPixel, true, _display->width(), _display->height(), 0, 0);
+    StreamingImageDecoder decoder(&sink);
+    
+    DecodeStatus status = DECODE_OK;
+    while (status == DECODE_OK && file.available() > 0) {
+        size_t length = file.read(buffer, FLASH_READ_CHUNK);
+        if (length == 0) {
+            break;
+        }
+        status = decoder.feed(buffer, length);
+    }
+    status = decoder.finish();
+    file.close();
+    free(buffer);
+    
+    Logger::linef("Read %u bytes from flash and decoded in %lums",
+                  (unsigned)decoder.getBytesFed(), millis() - startTime);
+    
+    if (status != DECODE_DONE) {
+        _displayManager->enableRotation();
+        showError((String("Cached image decode failed: ") + (decoder.getError() ? decoder.getError() : "unknown error")).c_str());
+        return false;
+    }
+    return true;
+}
+
+bool ImageManager::mountFlashStore() {
+    if (_flashMounted) {
+        return true;
+    }
+    // Data partition of the min_spiffs scheme, formatted on first use
+    if (!LittleFS.begin(true)) {
+        return false;
+    }
+    if (!LittleFS.exists(PREFETCH_DIR)) {
+        LittleFS.mkdir(PREFETCH_DIR);
+    }
+    if (!LittleFS.exists(IMAGE_CACHE_DIR)) {
+        LittleFS.mkdir(IMAGE_CACHE_DIR);
+    }
+    _flashMounted = true;
+    return true;
+}
+
+bool ImageManager::canCacheFile(const char* url) {
+    if (isTileManifestUrl(url)) {
+        return false;  // Drawn from several requests
+    }
+#ifdef DISPLAY_MODE_INKPLATE2
+    return isIkfbUrl(url);  // PNG / JPEG go through the library decoder, which only reads URLs
+#else
+    return true;
+#endif
+}
+
+String ImageManager::prefetchPath(uint8_t slot) {
+    return String(PREFETCH_DIR) + "/" + String(slot);
+}
+
+uint32_t ImageManager::getPrefetchBytes() {
+    if (_prefetchIndex == nullptr) {
+        return 0;
+    }
+    return PREFETCH_MAX_BYTES - getPrefetchBudget(*_prefetchIndex, PREFETCH_SLOT_NONE);
+}
+
+bool ImageManager::loadImageCache() {
+    if (_imageCache == nullptr) {
+        return false;
+    }
+    if (isImageCacheIndexValid(*_imageCache)) {
+        return true;
+    }
+    // Cold boot: the RTC copy is gone, the index file is not
+    if (!mountFlashStore()) {
+        return false;
+    }
+    LittleFSCacheStorage storage;
+    if (loadImageCacheIndex(storage, *_imageCache)) {
+        Logger::messagef("Image Cache", "Index loaded from flash (%u bytes cached)",
+                         (unsigned)getImageCacheBytes(*_imageCache));
+    }
+    return true;
+}
+
+void ImageManager::saveImageCache() {
+    LittleFSCacheStorage storage;
+    if (!saveImageCacheIndex(storage, *_imageCache)) {
+        Logger::line("Image cache index not saved");
+    }
+}
+
+void ImageManager::evictCachedImages(const uint8_t* slots, uint8_t count) {
+    if (count == 0) {
+        return;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        removeImageCacheEntry(*_imageCache, slots[i]);
+        LittleFS.remove(imageCachePath(slots[i]));
+    }
+    saveImageCache();
+}
+
+size_t ImageManager::beginCacheCopy(const char* url, HTTPClient& http, File& file, size_t& outLimit) {
+    if (!loadImageCache()) {
+        return 0;
+    }
+    ConditionalRequest validators;
+    validators.etag = http.header("ETag");
+    validators.lastModified = http.header("Last-Modified");
+    uint32_t validatorHash = imageCacheValidatorHash(validators.etag.c_str(), validators.lastModified.c_str());
+    uint32_t headerBytes = sizeof(CachedImageHeader) + validators.etag.length() + validators.lastModified.length();
+    int contentLength = http.getSize();  // -1 = chunked
+    uint32_t size = contentLength > 0 ? headerBytes + (uint32_t)contentLength : 0;
+    uint32_t now = (uint32_t)time(nullptr);
+    uint32_t urlHash = prefetchUrlHash(url);
+    
+    ImageCacheWriteDecision decision = decideImageCacheWrite(*_imageCache, _cacheSlot, urlHash, _cacheCRC32,
+                                                             validatorHash, size, getPrefetchBytes(), now);
+    Logger::linef("Image cache: %s", decision.reason);
+    if (decision.current) {
+        recordImageCacheValidated(*_imageCache, _cacheSlot, urlHash, _cacheCRC32, validatorHash, now);
+    }
+    if (!decision.write || !mountFlashStore()) {
+        return 0;
+    }
+    
+    // The slot's old file goes first (and with it the entry), then the least recently used
+    uint8_t removed[IMAGE_SLOT_COUNT];
+    uint8_t removedCount = makeImageCacheRoom(*_imageCache, _cacheSlot, size, getPrefetchBytes(), removed);
+    evictCachedImages(removed, removedCount);
+    for (uint8_t slot = 0; slot < IMAGE_SLOT_COUNT; slot++) {
+        if (findImageCacheEntry(*_imageCache, slot) == nullptr && LittleFS.exists(imageCachePath(slot))) {
+            LittleFS.remove(imageCachePath(slot));  // Orphan of an interrupted write
+        }
+    }
+    
+    file = LittleFS.open(imageCachePath(_cacheSlot), "w");
+    size_t written = file ? writeCachedImageHeader(file, validators) : 0;
+    if (written == 0) {
+        file.close();
+        LittleFS.remove(imageCachePath(_cacheSlot));
+        return 0;
+    }
+    uint32_t used = getPrefetchBytes() + getImageCacheBytes(*_imageCache) + written;
+    outLimit = used < IMAGE_CACHE_MAX_BYTES ? IMAGE_CACHE_MAX_BYTES - used : 0;
+    return written;
+}
+
+void ImageManager::finishCacheCopy(const char* url, HTTPClient& http, File& file, size_t headerBytes,
+                                   size_t bodyBytes, bool complete) {
+    file.close();
+    if (!complete || bodyBytes == 0) {
+        LittleFS.remove(imageCachePath(_cacheSlot));
+        Logger::line("Image cache: copy incomplete - discarded");
+        return;
+    }
+    uint32_t validatorHash = imageCacheValidatorHash(http.header("ETag").c_str(), http.header("Last-Modified").c_str());
+    recordImageCacheStored(*_imageCache, _cacheSlot, prefetchUrlHash(url), _cacheCRC32, validatorHash,
+                           headerBytes + bodyBytes, (uint32_t)time(nullptr));
+    saveImageCache();
+    Logger::linef("Image cache: %u bytes stored for image %u", (unsigned)(headerBytes + bodyBytes), _cacheSlot + 1);
+}
+
+String ImageManager::imageCachePath(uint8_t slot) {
+    return String(IMAGE_CACHE_DIR) + "/" + String(slot);
+}
+
 const char* ImageManager::getLastError() {
     return _lastError.c_str();
 }
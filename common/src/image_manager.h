@@ -5,37 +5,140 @@
 #include "display_manager.h"
 #include "config_manager.h"
 #include "overlay_manager.h"
+#include "http_connection.h"
+#include "tile_manifest.h"
+#include "clock_manager.h"
+#include "prefetch_cache.h"
+#include "image_cache.h"
+#include <HTTPClient.h>
+#include <FS.h>
+
+// Streaming download settings
+#define IMAGE_STREAM_TIMEOUT_MS 10000  // HTTP timeout while waiting for/reading the image body
+
+// Carousel prefetch and image cache files on the LittleFS data partition (one per slot)
+#define PREFETCH_DIR "/prefetch"
+#define FLASH_READ_CHUNK 4096          // Bytes read from flash per decoder feed
+
+// HTTP validators for conditional GET change detection
+// In: stored validators to send (empty = unconditional request)
+// Out: validators from a 200 response, or notModified = true on 304
+struct ConditionalRequest {
+    String etag;          // ETag header (sent as If-None-Match)
+    String lastModified;  // Last-Modified header (sent as If-Modified-Since)
+    bool notModified;     // Server answered 304 - nothing was drawn
+    
+    ConditionalRequest() : etag(""), lastModified(""), notModified(false) {}
+};
 
 class ImageManager {
 public:
     ImageManager(Inkplate* display, DisplayManager* displayManager);
     
-    // Set config manager for CRC32 storage
+    // Set config manager (overlay configuration)
     void setConfigManager(ConfigManager* configManager);
     
     // Set overlay manager for status overlay rendering
     void setOverlayManager(OverlayManager* overlayManager);
     
+    // Set clock manager (the server's Date header can stand in for NTP)
+    void setClockManager(ClockManager* clockManager);
+    
+    // Set TLS session cache (RTC memory) so HTTPS requests resume the previous session
+    void setTlsSessionCache(TlsSessionCache* cache);
+    
+    // Set DNS cache (RTC memory) so image hosts are not resolved on every wake
+    void setNetworkCache(NetworkCache* cache);
+    
+    // Pin the HTTPS server certificate by SHA-256 fingerprint (empty = no pinning)
+    // Returns false if the fingerprint cannot be parsed (pinning stays disabled)
+    bool setTlsFingerprint(const char* fingerprint);
+    
+    // TLS handshake counters since boot (one wake cycle)
+    const TlsStats& getTlsStats() const;
+    
+    // HTTP request / keep-alive reuse counters since boot (one wake cycle)
+    const HttpConnectionStats& getConnectionStats() const;
+    
+    // Duration of the last panel refresh in ms (0 = no refresh yet this cycle)
+    uint32_t getLastRefreshMs() const;
+    
+    // Deferred refresh: downloadAndDisplay() only draws the frame and leaves the
+    // panel refresh to completePendingRefresh(), so it can overlap other work
+    void setDeferRefresh(bool defer);
+    bool hasPendingRefresh() const;
+    void completePendingRefresh();
+    
+    // Close the keep-alive connection (when no more image requests follow this cycle)
+    void closeConnection();
+    
+    // Partial refresh: redraw only the tiles that changed since the image on the panel
+    // (black/white 1-bit mode; full refresh after fullRefreshEvery partial ones)
+    void setPartialRefresh(bool enabled, uint8_t fullRefreshEvery);
+    
     // Check if image has changed based on CRC32
+    // storedCRC32 is the CRC32 of the slot's last shown image (0 = unknown, never matches)
     // Returns true if changed or check failed (should download)
     // Returns false if unchanged (skip download)
     // If outNewCRC32 is provided, outputs the new CRC32 value fetched from server
     // If outRetryCount is provided, outputs the number of retry attempts made (0-2)
-    // Note: Does NOT save the CRC32 - caller must call saveCRC32() after successful display
-    bool checkCRC32Changed(const char* url, uint32_t* outNewCRC32 = nullptr, uint8_t* outRetryCount = nullptr);
-    
-    // Save CRC32 value (deferred until after successful image display)
-    void saveCRC32(uint32_t crc32Value);
+    // Note: Does NOT save the CRC32 - caller records it in the slot table after successful display
+    bool checkCRC32Changed(const char* url, uint32_t storedCRC32, uint32_t* outNewCRC32 = nullptr, uint8_t* outRetryCount = nullptr);
     
     // Download and display image from URL
     // Optional parameters for overlay rendering:
     //   batteryVoltage: battery voltage in volts (0.0 if not available)
     //   updateTimeStr: last update time string (empty if not tracking)
     //   cycleTimeMs: last cycle/loop time in milliseconds (0 if not tracking)
+    //   conditional: send/collect HTTP validators; returns true with
+    //                conditional->notModified set when the server answers 304
     bool downloadAndDisplay(const char* url, 
                            float batteryVoltage = 0.0,
                            const char* updateTimeStr = "",
-                           unsigned long cycleTimeMs = 0);
+                           unsigned long cycleTimeMs = 0,
+                           ConditionalRequest* conditional = nullptr);
+    
+    // Set the carousel prefetch index (RTC memory); re-initialized when invalid
+    void setPrefetchIndex(PrefetchIndex* index);
+    
+    // Download the images of the next carousel slots into flash while WiFi is up
+    // (cached files are revalidated with a conditional GET) and evict the rest.
+    // Returns the number of slots cached for the next wakes
+    uint8_t prefetchImages(const DashboardConfig& config, uint8_t currentIndex);
+    
+    // Draw a slot's cached image with the overlay and refresh the panel - no network
+    // validators: receives the ETag / Last-Modified the file was downloaded with
+    // Returns false (and evicts the file) if it cannot be decoded
+    bool displayPrefetched(uint8_t slot,
+                           float batteryVoltage,
+                           const char* updateTimeStr,
+                           unsigned long cycleTimeMs,
+                           ConditionalRequest* validators);
+    
+    // Set the image cache index (RTC memory); loaded from flash when invalid (cold boot)
+    void setImageCacheIndex(ImageCacheIndex* index);
+    
+    // The next downloadAndDisplay() copies the image into the slot's cache file when
+    // the write policy allows it (IMAGE_SLOT_NONE = no copy)
+    // crc32: CRC32 from the .crc32 file (0 = unknown)
+    void setCacheSlot(uint8_t slot, uint32_t crc32);
+    
+    // Whether a slot's cached image can be drawn (loads the index from flash after a cold boot)
+    ImageCacheDisplayDecision checkImageCache(uint8_t slot, const char* url, uint8_t displayedSlot,
+                                              uint32_t maxAgeSeconds);
+    
+    // Draw a slot's cached image with the overlay and refresh the panel - no network
+    // validators / outCRC32: what the file was downloaded with
+    // Returns false (and evicts the file) if it cannot be decoded
+    bool displayCached(uint8_t slot,
+                       float batteryVoltage,
+                       const char* updateTimeStr,
+                       unsigned long cycleTimeMs,
+                       ConditionalRequest* validators,
+                       uint32_t* outCRC32);
+    
+    // The server confirmed a slot's content (CRC32 match or HTTP 304) - RTC memory only
+    void confirmCachedImage(uint8_t slot, const char* url, uint32_t crc32, const ConditionalRequest* validators);
     
     // Get last error message
     const char* getLastError();
@@ -45,13 +148,82 @@ private:
     DisplayManager* _displayManager;
     ConfigManager* _configManager;
     OverlayManager* _overlayManager;
+    ClockManager* _clockManager;
     String _lastError;
+    uint8_t _tlsFingerprint[TLS_FINGERPRINT_SIZE];
+    bool _tlsPinned;
+    TlsStats _tlsStats;
+    uint32_t _lastRefreshMs;
+    HttpConnection _connection;  // Shared by the change check and the image download
+    bool _partialRefresh;
+    uint8_t _fullRefreshEvery;
+    bool _deferRefresh;
+    bool _refreshPending;     // Frame drawn, waiting for completePendingRefresh()
+    
+    // Tile manifest of the current download (see renderTileManifest)
+    TileManifest _manifest;
+    bool _manifestDrawn;             // A manifest frame was composed in the framebuffer
+    bool _manifestUnchanged;         // No tile changed - nothing drawn, keep the panel
+    uint32_t _manifestUrlHash;
+    uint8_t _manifestRegionCount;    // Tiles drawn for a partial refresh (0 = whole frame drawn)
+    TileRegion _manifestRegions[TILE_MANIFEST_MAX_TILES];
+    
+    // Carousel prefetch (see prefetch_cache.h)
+    PrefetchIndex* _prefetchIndex;   // RTC memory, may be null (prefetch off)
+    bool _flashMounted;              // LittleFS mounted this wake
+    
+    // Image cache (see image_cache.h)
+    ImageCacheIndex* _imageCache;    // RTC memory copy of the index file, may be null
+    uint8_t _cacheSlot;              // Slot of the pending download (IMAGE_SLOT_NONE = no copy)
+    uint32_t _cacheCRC32;
+    bool _cacheCopyPending;          // The next streamed image is the one to copy
     
     // Helper functions
     bool isHttps(const char* url);
     void showDownloadProgress(const char* message);
     void showError(const char* error);
     uint32_t parseHexCRC32(const String& hexStr);
+    
+    // Image rendering
+    // renderImage() streams PNG/JPEG/IKFB straight into the framebuffer and falls back to
+    // Inkplate::drawImage() for formats the streaming decoder does not handle
+    bool renderImage(const char* url, ConditionalRequest* conditional);
+    bool streamImageToDisplay(const char* url, ConditionalRequest* conditional, bool* outUnsupported,
+                              int16_t originX = 0, int16_t originY = 0);
+    int beginImageRequest(const char* url, ConditionalRequest* conditional);
+    void applyServerDate(HTTPClient& http);  // Date header of the last response to the clock
+    
+    // Tile manifest URLs (*.tiles): fetch the manifest and draw its tiles - only
+    // the changed ones when the panel shows the previous frame of this manifest
+    bool renderTileManifest(const char* url, ConditionalRequest* conditional);
+    bool drawTile(const char* url, int16_t x, int16_t y);
+    bool canDrawTilesIncrementally();
+    
+    // Overlay and panel refresh (or deferred refresh) of a completely drawn image
+    void finishFrame(float batteryVoltage, const char* updateTimeStr, unsigned long cycleTimeMs);
+    
+    // Refresh the panel with the drawn frame (partial, full or not at all)
+    void refreshDisplay();
+    
+    // Flash files (prefetch and image cache)
+    bool mountFlashStore();
+    bool canCacheFile(const char* url);  // Drawn from one file by the streaming decoder
+    bool drawCachedFile(const String& path, ConditionalRequest* validators);
+    bool prefetchSlot(uint8_t slot, const char* url, uint32_t urlHash);
+    String prefetchPath(uint8_t slot);
+    uint32_t getPrefetchBytes();
+    
+    // Image cache files: the copy is written while the image streams in
+    bool loadImageCache();
+    void saveImageCache();
+    void evictCachedImages(const uint8_t* slots, uint8_t count);
+    size_t beginCacheCopy(const char* url, HTTPClient& http, File& file, size_t& outLimit);
+    void finishCacheCopy(const char* url, HTTPClient& http, File& file, size_t headerBytes, size_t bodyBytes,
+                         bool complete);
+    String imageCachePath(uint8_t slot);
+#ifndef DISPLAY_MODE_INKPLATE2
+    void partialRefreshRegions(const TileRegion* regions, uint8_t count);
+#endif
 };
 
 #endif // IMAGE_MANAGER_H
@@ -0,0 +1,67 @@
+#include <image_slot_table.h>
+#include <string.h>
+
+void initImageSlotTable(ImageSlotTable& table) {
+    memset(&table, 0, sizeof(table));
+    table.version = IMAGE_SLOT_TABLE_VERSION;
+    table.displayedSlot = IMAGE_SLOT_NONE;
+}
+
+bool isImageSlotTableValid(const ImageSlotTable& table) {
+    if (table.version != IMAGE_SLOT_TABLE_VERSION) {
+        return false;
+    }
+    if (table.displayedSlot != IMAGE_SLOT_NONE && table.displayedSlot >= IMAGE_SLOT_COUNT) {
+        return false;
+    }
+    // No bits beyond the last slot
+    return (table.knownMask >> IMAGE_SLOT_COUNT) == 0;
+}
+
+uint32_t getSlotCRC32(const ImageSlotTable& table, uint8_t slot) {
+    if (slot >= IMAGE_SLOT_COUNT || !(table.knownMask & (1u << slot))) {
+        return 0;
+    }
+    return table.crc32[slot];
+}
+
+bool isSlotUnchanged(const ImageSlotTable& table, uint8_t slot, uint32_t newCRC32) {
+    if (newCRC32 == 0) {
+        return false;
+    }
+    return getSlotCRC32(table, slot) == newCRC32;
+}
+
+void recordSlotDisplayed(ImageSlotTable& table, uint8_t slot, uint32_t crc32) {
+    if (slot >= IMAGE_SLOT_COUNT) {
+        return;
+    }
+    table.displayedSlot = slot;
+    if (crc32 != 0) {
+        table.crc32[slot] = crc32;
+        table.knownMask |= (uint16_t)(1u << slot);
+    } else {
+        invalidateSlot(table, slot);
+    }
+}
+
+void invalidateSlot(ImageSlotTable& table, uint8_t slot) {
+    if (slot >= IMAGE_SLOT_COUNT) {
+        return;
+    }
+    table.crc32[slot] = 0;
+    table.knownMask &= (uint16_t)~(1u << slot);
+}
+
+void clearDisplayedSlot(ImageSlotTable& table) {
+    table.displayedSlot = IMAGE_SLOT_NONE;
+}
+
+void pruneImageSlots(ImageSlotTable& table, uint8_t imageCount) {
+    for (uint8_t slot = imageCount; slot < IMAGE_SLOT_COUNT; slot++) {
+        invalidateSlot(table, slot);
+    }
+    if (table.displayedSlot != IMAGE_SLOT_NONE && table.displayedSlot >= imageCount) {
+        clearDisplayedSlot(table);
+    }
+}
@@ -0,0 +1,77 @@
+#ifndef IMAGE_SLOT_TABLE_H
+#define IMAGE_SLOT_TABLE_H
+
+#include <stdint.h>
+
+// Layout version - bump when the struct changes so stale NVS blobs are discarded
+#define IMAGE_SLOT_TABLE_VERSION 1
+#define IMAGE_SLOT_COUNT 10     // Must match MAX_IMAGE_SLOTS
+#define IMAGE_SLOT_NONE 0xFF    // No slot / screen content unknown
+
+/**
+ * @brief Per-slot change detection state (persisted as one 44-byte NVS blob)
+ *
+ * Tracks the CRC32 of the image last shown for every carousel slot and which
+ * slot is currently on the panel. A download can only be skipped when the
+ * target slot is on screen AND its content is unchanged.
+ */
+struct ImageSlotTable {
+    uint8_t version;                    // IMAGE_SLOT_TABLE_VERSION
+    uint8_t displayedSlot;              // Slot whose image is on the panel (IMAGE_SLOT_NONE = unknown)
+    uint16_t knownMask;                 // Bit i set = crc32[i] is the CRC32 of slot i's last shown image
+    uint32_t crc32[IMAGE_SLOT_COUNT];   // CRC32 per slot (only meaningful when the mask bit is set)
+};
+
+/**
+ * @brief Pure slot table functions
+ *
+ * These functions contain NO dependencies on Arduino/ESP32 APIs,
+ * making them fully testable with standard C++ unit testing frameworks.
+ */
+
+/**
+ * @brief Reset table to "nothing known, nothing on screen"
+ */
+void initImageSlotTable(ImageSlotTable& table);
+
+/**
+ * @brief Check a table loaded from storage (version and field ranges)
+ * @return false if the table must be re-initialized
+ */
+bool isImageSlotTableValid(const ImageSlotTable& table);
+
+/**
+ * @brief Get the stored CRC32 for a slot
+ * @return Stored CRC32, or 0 if unknown (0 never matches, see isSlotUnchanged)
+ */
+uint32_t getSlotCRC32(const ImageSlotTable& table, uint8_t slot);
+
+/**
+ * @brief Check whether a freshly fetched CRC32 matches the slot's last shown image
+ * @param newCRC32 CRC32 fetched from the server (0 = unavailable, never matches)
+ */
+bool isSlotUnchanged(const ImageSlotTable& table, uint8_t slot, uint32_t newCRC32);
+
+/**
+ * @brief Record a successful display of a slot
+ * @param crc32 CRC32 of the displayed image (0 = unknown, slot stays unmatched)
+ */
+void recordSlotDisplayed(ImageSlotTable& table, uint8_t slot, uint32_t crc32);
+
+/**
+ * @brief Forget a slot's CRC32 (e.g. after a failed download) so the next check downloads
+ */
+void invalidateSlot(ImageSlotTable& table, uint8_t slot);
+
+/**
+ * @brief Mark the screen content as unknown (error screen or other UI replaced the image)
+ */
+void clearDisplayedSlot(ImageSlotTable& table);
+
+/**
+ * @brief Drop state for slots that are no longer configured
+ * @param imageCount Number of configured images (slots >= imageCount are cleared)
+ */
+void pruneImageSlots(ImageSlotTable& table, uint8_t imageCount);
+
+#endif // IMAGE_SLOT_TABLE_H
@@ -0,0 +1,505 @@
+#include <inflate_stream.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define WINDOW_MASK (INFLATE_WINDOW_SIZE - 1)
+#define FAST_BITS 9
+#define FAST_MASK ((1 << FAST_BITS) - 1)
+#define MAX_CODE_BITS 15
+
+// Hand decoded bytes to the consumer once this much is pending. Must stay
+// below window size minus one maximum match so nothing unflushed is overwritten.
+#define FLUSH_THRESHOLD 16384
+
+static const uint16_t LENGTH_BASE[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const uint8_t LENGTH_EXTRA[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+static const uint16_t DIST_BASE[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+static const uint8_t DIST_EXTRA[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+static const uint8_t CODE_LENGTH_ORDER[19] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+InflateStream::InflateStream()
+    : _window(nullptr), _totalOut(0), _flushed(0), _output(nullptr), _context(nullptr),
+      _state(STATE_BLOCK_HEADER), _lastBlock(false), _error(nullptr),
+      _bitBuf(0), _bitCount(0), _in(nullptr), _inLen(0), _inPos(0), _final(false),
+      _storedRemaining(0), _hlit(0), _hdist(0), _hclen(0), _lengthIndex(0),
+      _lencode(nullptr), _distcode(nullptr) {
+}
+
+InflateStream::~InflateStream() {
+    end();
+}
+
+bool InflateStream::begin(OutputCallback output, void* context) {
+    end();
+
+    _window = (uint8_t*)malloc(INFLATE_WINDOW_SIZE);
+    _lencode = (Huffman*)malloc(sizeof(Huffman));
+    _distcode = (Huffman*)malloc(sizeof(Huffman));
+    if (_window == nullptr || _lencode == nullptr || _distcode == nullptr) {
+        end();
+        _state = STATE_ERROR;
+        _error = "Out of memory for inflate window";
+        return false;
+    }
+
+    _output = output;
+    _context = context;
+    _totalOut = 0;
+    _flushed = 0;
+    _state = STATE_BLOCK_HEADER;
+    _lastBlock = false;
+    _error = nullptr;
+    _bitBuf = 0;
+    _bitCount = 0;
+    return true;
+}
+
+void InflateStream::end() {
+    free(_window);
+    free(_lencode);
+    free(_distcode);
+    _window = nullptr;
+    _lencode = nullptr;
+    _distcode = nullptr;
+}
+
+size_t InflateStream::getMemoryUsage() const {
+    if (_window == nullptr) {
+        return 0;
+    }
+    return INFLATE_WINDOW_SIZE + 2 * sizeof(Huffman);
+}
+
+InflateStatus InflateStream::feed(const uint8_t* data, size_t length, bool final) {
+    if (_state == STATE_DONE) {
+        return INFLATE_DONE;
+    }
+    if (_state == STATE_ERROR || _window == nullptr) {
+        return INFLATE_ERROR;
+    }
+
+    _in = data;
+    _inLen = length;
+    _inPos = 0;
+    _final = final;
+
+    for (;;) {
+        bool progressed = false;
+        switch (_state) {
+            case STATE_BLOCK_HEADER:      progressed = stepBlockHeader(); break;
+            case STATE_STORED_HEADER:     progressed = stepStoredHeader(); break;
+            case STATE_STORED_COPY:       progressed = stepStoredCopy(); break;
+            case STATE_DYNAMIC_HEADER:    progressed = stepDynamicHeader(); break;
+            case STATE_CODE_LENGTH_CODES: progressed = stepCodeLengthCodes(); break;
+            case STATE_CODE_LENGTHS:      progressed = stepCodeLengths(); break;
+            case STATE_CODES:             progressed = stepCodes(); break;
+            case STATE_DONE:
+                flushOutput(true);
+                return INFLATE_DONE;
+            case STATE_ERROR:
+                return INFLATE_ERROR;
+        }
+
+        if (!progressed) {
+            if (_state == STATE_ERROR) {
+                return INFLATE_ERROR;
+            }
+            // Stalled: every input byte is already in the bit buffer
+            if (_final) {
+                fail("Truncated deflate stream");
+                return INFLATE_ERROR;
+            }
+            flushOutput(true);
+            return INFLATE_NEED_MORE;
+        }
+    }
+}
+
+// ============================================================================
+// Bit input
+// ============================================================================
+
+void InflateStream::refill() {
+    while (_bitCount <= 56 && _inPos < _inLen) {
+        _bitBuf |= (uint64_t)_in[_inPos++] << _bitCount;
+        _bitCount += 8;
+    }
+}
+
+bool InflateStream::have(uint8_t count) {
+    if (_bitCount < count) {
+        refill();
+    }
+    return _bitCount >= count;
+}
+
+uint32_t InflateStream::bits(uint8_t count) {
+    uint32_t value = (uint32_t)(_bitBuf & ((1ULL << count) - 1));
+    _bitBuf >>= count;
+    _bitCount -= count;
+    return value;
+}
+
+// Returns the decoded symbol, -1 if more bits are needed, -2 for an invalid code
+int InflateStream::decodeSymbol(const Huffman* h) {
+    uint16_t entry = h->fast[_bitBuf & FAST_MASK];
+    if (entry != 0) {
+        uint8_t len = entry >> FAST_BITS;
+        if (len > _bitCount) {
+            return -1;
+        }
+        _bitBuf >>= len;
+        _bitCount -= len;
+        return entry & FAST_MASK;
+    }
+
+    // Slow path for long codes (canonical decode one bit at a time)
+    int code = 0;
+    int first = 0;
+    int index = 0;
+    for (uint8_t len = 1; len <= MAX_CODE_BITS; len++) {
+        if (len > _bitCount) {
+            return -1;
+        }
+        code |= (int)((_bitBuf >> (len - 1)) & 1);
+        int count = h->count[len];
+        if (code - count < first) {
+            _bitBuf >>= len;
+            _bitCount -= len;
+            return h->symbol[index + (code - first)];
+        }
+        index += count;
+        first += count;
+        first <<= 1;
+        code <<= 1;
+    }
+    return -2;
+}
+
+bool InflateStream::buildHuffman(Huffman* h, const uint8_t* lengths, uint16_t n) {
+    memset(h->count, 0, sizeof(h->count));
+    for (uint16_t sym = 0; sym < n; sym++) {
+        h->count[lengths[sym]]++;
+    }
+
+    // Reject over-subscribed codes (incomplete codes are tolerated)
+    int left = 1;
+    for (uint8_t len = 1; len <= MAX_CODE_BITS; len++) {
+        left <<= 1;
+        left -= h->count[len];
+        if (left < 0) {
+            return false;
+        }
+    }
+
+    uint16_t offs[MAX_CODE_BITS + 1];
+    uint16_t nextCode[MAX_CODE_BITS + 1];
+    offs[1] = 0;
+    nextCode[1] = 0;
+    for (uint8_t len = 1; len < MAX_CODE_BITS; len++) {
+        offs[len + 1] = offs[len] + h->count[len];
+        nextCode[len + 1] = (nextCode[len] + h->count[len]) << 1;
+    }
+
+    memset(h->fast, 0, sizeof(h->fast));
+    for (uint16_t sym = 0; sym < n; sym++) {
+        uint8_t len = lengths[sym];
+        if (len == 0) {
+            continue;
+        }
+        h->symbol[offs[len]++] = sym;
+
+        uint16_t code = nextCode[len]++;
+        if (len <= FAST_BITS) {
+            // DEFLATE packs Huffman codes MSB-first into an LSB-first stream
+            uint16_t reversed = 0;
+            for (uint8_t i = 0; i < len; i++) {
+                reversed = (reversed << 1) | ((code >> i) & 1);
+            }
+            uint16_t entry = (uint16_t)((len << FAST_BITS) | sym);
+            for (uint16_t i = reversed; i <= FAST_MASK; i += (1 << len)) {
+                h->fast[i] = entry;
+            }
+        }
+    }
+    return true;
+}
+
+void InflateStream::buildFixedTables() {
+    uint16_t sym = 0;
+    for (; sym < 144; sym++) _lengths[sym] = 8;
+    for (; sym < 256; sym++) _lengths[sym] = 9;
+    for (; sym < 280; sym++) _lengths[sym] = 7;
+    for (; sym < 288; sym++) _lengths[sym] = 8;
+    buildHuffman(_lencode, _lengths, 288);
+
+    for (sym = 0; sym < 30; sym++) _lengths[sym] = 5;
+    buildHuffman(_distcode, _lengths, 30);
+}
+
+// ============================================================================
+// Output window
+// ============================================================================
+
+inline void InflateStream::putByte(uint8_t b) {
+    _window[_totalOut & WINDOW_MASK] = b;
+    _totalOut++;
+}
+
+void InflateStream::flushOutput(bool force) {
+    uint32_t pending = _totalOut - _flushed;
+    if (pending == 0 || (!force && pending < FLUSH_THRESHOLD)) {
+        return;
+    }
+
+    uint32_t start = _flushed & WINDOW_MASK;
+    uint32_t firstPart = INFLATE_WINDOW_SIZE - start;
+    if (firstPart > pending) {
+        firstPart = pending;
+    }
+    if (_output != nullptr) {
+        _output(_context, _window + start, firstPart);
+        if (pending > firstPart) {
+            _output(_context, _window, pending - firstPart);
+        }
+    }
+    _flushed = _totalOut;
+}
+
+bool InflateStream::fail(const char* message) {
+    _state = STATE_ERROR;
+    _error = message;
+    return false;
+}
+
+// ============================================================================
+// Decoder states
+// ============================================================================
+
+bool InflateStream::stepBlockHeader() {
+    if (!have(3)) {
+        return false;
+    }
+    _lastBlock = bits(1) != 0;
+    uint32_t type = bits(2);
+
+    switch (type) {
+        case 0:
+            _state = STATE_STORED_HEADER;
+            return true;
+        case 1:
+            buildFixedTables();
+            _state = STATE_CODES;
+            return true;
+        case 2:
+            _state = STATE_DYNAMIC_HEADER;
+            return true;
+        default:
+            return fail("Invalid deflate block type");
+    }
+}
+
+bool InflateStream::stepStoredHeader() {
+    // Stored blocks start on a byte boundary
+    bits(_bitCount & 7);
+    if (!have(32)) {
+        return false;
+    }
+    uint16_t len = (uint16_t)bits(16);
+    uint16_t nlen = (uint16_t)bits(16);
+    if (len != (uint16_t)~nlen) {
+        return fail("Stored block length mismatch");
+    }
+    _storedRemaining = len;
+    _state = STATE_STORED_COPY;
+    return true;
+}
+
+bool InflateStream::stepStoredCopy() {
+    // Drain whole bytes already pulled into the bit buffer, then copy directly
+    while (_storedRemaining > 0 && _bitCount >= 8) {
+        putByte((uint8_t)bits(8));
+        _storedRemaining--;
+        flushOutput(false);
+    }
+    while (_storedRemaining > 0 && _inPos < _inLen) {
+        putByte(_in[_inPos++]);
+        _storedRemaining--;
+        flushOutput(false);
+    }
+    if (_storedRemaining > 0) {
+        return false;
+    }
+    _state = _lastBlock ? STATE_DONE : STATE_BLOCK_HEADER;
+    return true;
+}
+
+bool InflateStream::stepDynamicHeader() {
+    if (!have(14)) {
+        return false;
+    }
+    _hlit = (uint16_t)bits(5) + 257;
+    _hdist = (uint16_t)bits(5) + 1;
+    _hclen = (uint16_t)bits(4) + 4;
+    if (_hlit > 286 || _hdist > 30) {
+        return fail("Invalid dynamic block header");
+    }
+    memset(_lengths, 0, 19);
+    _lengthIndex = 0;
+    _state = STATE_CODE_LENGTH_CODES;
+    return true;
+}
+
+bool InflateStream::stepCodeLengthCodes() {
+    while (_lengthIndex < _hclen) {
+        if (!have(3)) {
+            return false;
+        }
+        _lengths[CODE_LENGTH_ORDER[_lengthIndex++]] = (uint8_t)bits(3);
+    }
+
+    // The code length alphabet temporarily lives in the literal table
+    if (!buildHuffman(_lencode, _lengths, 19)) {
+        return fail("Invalid code length code");
+    }
+    _lengthIndex = 0;
+    _state = STATE_CODE_LENGTHS;
+    return true;
+}
+
+bool InflateStream::stepCodeLengths() {
+    uint16_t total = _hlit + _hdist;
+
+    while (_lengthIndex < total) {
+        refill();
+        uint64_t savedBuf = _bitBuf;
+        uint8_t savedCount = _bitCount;
+
+        int sym = decodeSymbol(_lencode);
+        if (sym == -2) {
+            return fail("Invalid code length symbol");
+        }
+        if (sym < 0) {
+            return false;
+        }
+
+        if (sym < 16) {
+            _lengths[_lengthIndex++] = (uint8_t)sym;
+            continue;
+        }
+
+        uint8_t value = 0;
+        uint16_t repeat;
+        uint8_t extra = (sym == 16) ? 2 : (sym == 17) ? 3 : 7;
+        if (_bitCount < extra) {
+            _bitBuf = savedBuf;
+            _bitCount = savedCount;
+            return false;
+        }
+        if (sym == 16) {
+            if (_lengthIndex == 0) {
+                return fail("Repeat with no previous length");
+            }
+            value = _lengths[_lengthIndex - 1];
+            repeat = 3 + (uint16_t)bits(2);
+        } else if (sym == 17) {
+            repeat = 3 + (uint16_t)bits(3);
+        } else {
+            repeat = 11 + (uint16_t)bits(7);
+        }
+
+        if (_lengthIndex + repeat > total) {
+            return fail("Too many code lengths");
+        }
+        while (repeat--) {
+            _lengths[_lengthIndex++] = value;
+        }
+    }
+
+    if (_lengths[256] == 0) {
+        return fail("Missing end-of-block code");
+    }
+    if (!buildHuffman(_lencode, _lengths, _hlit) ||
+        !buildHuffman(_distcode, _lengths + _hlit, _hdist)) {
+        return fail("Invalid literal/length or distance code");
+    }
+    _state = STATE_CODES;
+    return true;
+}
+
+bool InflateStream::stepCodes() {
+    for (;;) {
+        // One refill covers a whole literal or length/distance pair
+        refill();
+        uint64_t savedBuf = _bitBuf;
+        uint8_t savedCount = _bitCount;
+
+        int sym = decodeSymbol(_lencode);
+        if (sym == -2) {
+            return fail("Invalid literal/length code");
+        }
+        if (sym < 0) {
+            return false;
+        }
+
+        if (sym < 256) {
+            putByte((uint8_t)sym);
+            flushOutput(false);
+            continue;
+        }
+
+        if (sym == 256) {
+            _state = _lastBlock ? STATE_DONE : STATE_BLOCK_HEADER;
+            return true;
+        }
+
+        sym -= 257;
+        if (sym >= 29) {
+            return fail("Invalid length symbol");
+        }
+        if (_bitCount < LENGTH_EXTRA[sym]) {
+            _bitBuf = savedBuf;
+            _bitCount = savedCount;
+            return false;
+        }
+        uint16_t len = LENGTH_BASE[sym] + (uint16_t)bits(LENGTH_EXTRA[sym]);
+
+        int dsym = decodeSymbol(_distcode);
+        if (dsym == -2) {
+            return fail("Invalid distance code");
+        }
+        if (dsym >= 30) {
+            return fail("Invalid distance symbol");
+        }
+        if (dsym < 0 || _bitCount < DIST_EXTRA[dsym]) {
+            _bitBuf = savedBuf;
+            _bitCount = savedCount;
+            return false;
+        }
+        uint32_t dist = DIST_BASE[dsym] + bits(DIST_EXTRA[dsym]);
+        if (dist > _totalOut) {
+            return fail("Distance too far back");
+        }
+
+        // Byte-by-byte copy handles overlapping matches (dist < len)
+        uint32_t from = _totalOut - dist;
+        for (uint16_t i = 0; i < len; i++) {
+            putByte(_window[(from + i) & WINDOW_MASK]);
+        }
+        flushOutput(false);
+    }
+}
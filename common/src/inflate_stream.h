@@ -0,0 +1,138 @@
+#ifndef INFLATE_STREAM_H
+#define INFLATE_STREAM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Incremental raw DEFLATE (RFC 1951) decompressor
+ *
+ * Pure C++ with NO dependencies on Arduino/ESP32 APIs, so the same code runs
+ * on the device and in the host test suite.
+ *
+ * Compressed bytes can be fed in arbitrary chunk sizes (down to a single
+ * byte); decompressed output is delivered through a callback as soon as it is
+ * available. Memory is bounded by the 32 KB DEFLATE window plus ~3 KB of
+ * Huffman tables, independent of the size of the compressed stream.
+ *
+ * The zlib wrapper (2-byte header, Adler-32 trailer) is NOT handled here -
+ * callers strip it (see PngStreamDecoder).
+ */
+
+#define INFLATE_WINDOW_SIZE 32768
+
+enum InflateStatus {
+    INFLATE_NEED_MORE,   // All input consumed, stream not finished yet
+    INFLATE_DONE,        // Final block decoded (trailing input is ignored)
+    INFLATE_ERROR        // Corrupt stream, truncated input or out of memory
+};
+
+class InflateStream {
+public:
+    // Receives decompressed bytes in stream order
+    typedef void (*OutputCallback)(void* context, const uint8_t* data, size_t length);
+
+    InflateStream();
+    ~InflateStream();
+
+    /**
+     * @brief Allocate the window and reset state
+     * @return false if the window could not be allocated
+     */
+    bool begin(OutputCallback output, void* context);
+
+    /**
+     * @brief Release the window
+     */
+    void end();
+
+    /**
+     * @brief Decompress a chunk of raw DEFLATE data
+     *
+     * @param data Compressed bytes
+     * @param length Number of bytes
+     * @param final True if no more input will follow (truncation becomes an error)
+     * @return INFLATE_NEED_MORE, INFLATE_DONE or INFLATE_ERROR
+     */
+    InflateStatus feed(const uint8_t* data, size_t length, bool final = false);
+
+    bool isDone() const { return _state == STATE_DONE; }
+    const char* getError() const { return _error; }
+
+    // Total decompressed bytes produced so far
+    uint32_t getTotalOut() const { return _totalOut; }
+
+    // Bytes of heap held by this decoder
+    size_t getMemoryUsage() const;
+
+private:
+    enum State {
+        STATE_BLOCK_HEADER,
+        STATE_STORED_HEADER,
+        STATE_STORED_COPY,
+        STATE_DYNAMIC_HEADER,
+        STATE_CODE_LENGTH_CODES,
+        STATE_CODE_LENGTHS,
+        STATE_CODES,
+        STATE_DONE,
+        STATE_ERROR
+    };
+
+    // Canonical Huffman table with a 9-bit direct lookup for short codes
+    struct Huffman {
+        uint16_t count[16];     // Number of codes of each length
+        uint16_t symbol[288];   // Symbols ordered by code
+        uint16_t fast[512];     // (length << 9) | symbol for codes <= 9 bits, 0 = slow path
+    };
+
+    uint8_t* _window;
+    uint32_t _totalOut;         // Bytes written to the window (position = _totalOut & mask)
+    uint32_t _flushed;          // Bytes already handed to the output callback
+    OutputCallback _output;
+    void* _context;
+
+    State _state;
+    bool _lastBlock;
+    const char* _error;
+
+    // Bit buffer (LSB-first, as DEFLATE requires)
+    uint64_t _bitBuf;
+    uint8_t _bitCount;
+    const uint8_t* _in;
+    size_t _inLen;
+    size_t _inPos;
+    bool _final;
+
+    // Stored block progress
+    uint16_t _storedRemaining;
+
+    // Dynamic block header progress
+    uint16_t _hlit;
+    uint16_t _hdist;
+    uint16_t _hclen;
+    uint16_t _lengthIndex;
+    uint8_t _lengths[320];
+
+    Huffman* _lencode;
+    Huffman* _distcode;
+
+    void refill();
+    bool have(uint8_t bits);
+    uint32_t bits(uint8_t count);
+    int decodeSymbol(const Huffman* h);
+    bool buildHuffman(Huffman* h, const uint8_t* lengths, uint16_t n);
+    void buildFixedTables();
+    void putByte(uint8_t b);
+    void flushOutput(bool force);
+    bool fail(const char* message);
+
+    bool stepBlockHeader();
+    bool stepStoredHeader();
+    bool stepStoredCopy();
+    bool stepDynamicHeader();
+    bool stepCodeLengthCodes();
+    bool stepCodeLengths();
+    bool stepCodes();
+};
+
+#endif // INFLATE_STREAM_H
@@ -0,0 +1,971 @@
+#include <jpeg_decoder.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define JPEG_MAX_WIDTH 8192
+
+// Zigzag index -> natural (row-major) coefficient index
+static const uint8_t ZIGZAG[64] = {
+     0,  1,  8, 16,  9,  2,  3, 10,
+    17, 24, 32, 25, 18, 11,  4,  5,
+    12, 19, 26, 33, 40, 48, 41, 34,
+    27, 20, 13,  6,  7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36,
+    29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46,
+    53, 60, 61, 54, 47, 55, 62, 63
+};
+
+static uint16_t readBigEndian16(const uint8_t* p) {
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+// ============================================================================
+// Inverse DCT - accurate integer algorithm from libjpeg (jidctint.c)
+// ============================================================================
+
+#define CONST_BITS 13
+#define PASS1_BITS 2
+
+#define FIX_0_298631336 ((int32_t)2446)
+#define FIX_0_390180644 ((int32_t)3196)
+#define FIX_0_541196100 ((int32_t)4433)
+#define FIX_0_765366865 ((int32_t)6270)
+#define FIX_0_899976223 ((int32_t)7373)
+#define FIX_1_175875602 ((int32_t)9633)
+#define FIX_1_501321110 ((int32_t)12299)
+#define FIX_1_847759065 ((int32_t)15137)
+#define FIX_1_961570560 ((int32_t)16069)
+#define FIX_2_053119869 ((int32_t)16819)
+#define FIX_2_562915447 ((int32_t)20995)
+#define FIX_3_072711026 ((int32_t)25172)
+
+#define DESCALE(x, n) (((x) + ((int32_t)1 << ((n) - 1))) >> (n))
+
+static inline uint8_t clampSample(int32_t value) {
+    value += 128;
+    return (uint8_t)(value < 0 ? 0 : value > 255 ? 255 : value);
+}
+
+static void inverseDCT(const int16_t* coef, const uint16_t* qt, uint8_t* out, uint16_t stride) {
+    int32_t workspace[64];
+
+    // Pass 1: columns from input into workspace
+    for (int col = 0; col < 8; col++) {
+        const int16_t* in = coef + col;
+        const uint16_t* q = qt + col;
+        int32_t* ws = workspace + col;
+
+        if (in[8] == 0 && in[16] == 0 && in[24] == 0 && in[32] == 0 &&
+            in[40] == 0 && in[48] == 0 && in[56] == 0) {
+            // AC terms all zero: column is constant
+            int32_t dc = ((int32_t)in[0] * q[0]) << PASS1_BITS;
+            for (int i = 0; i < 8; i++) {
+                ws[i * 8] = dc;
+            }
+            continue;
+        }
+
+        // Even part
+        int32_t z2 = (int32_t)in[16] * q[16];
+        int32_t z3 = (int32_t)in[48] * q[48];
+        int32_t z1 = (z2 + z3) * FIX_0_541196100;
+        int32_t tmp2 = z1 + z3 * (-FIX_1_847759065);
+        int32_t tmp3 = z1 + z2 * FIX_0_765366865;
+
+        z2 = (int32_t)in[0] * q[0];
+        z3 = (int32_t)in[32] * q[32];
+        int32_t tmp0 = (z2 + z3) << CONST_BITS;
+        int32_t tmp1 = (z2 - z3) << CONST_BITS;
+
+        int32_t tmp10 = tmp0 + tmp3;
+        int32_t tmp13 = tmp0 - tmp3;
+        int32_t tmp11 = tmp1 + tmp2;
+        int32_t tmp12 = tmp1 - tmp2;
+
+        // Odd part
+        tmp0 = (int32_t)in[56] * q[56];
+        tmp1 = (int32_t)in[40] * q[40];
+        tmp2 = (int32_t)in[24] * q[24];
+        tmp3 = (int32_t)in[8] * q[8];
+
+        z1 = tmp0 + tmp3;
+        z2 = tmp1 + tmp2;
+        z3 = tmp0 + tmp2;
+        int32_t z4 = tmp1 + tmp3;
+        int32_t z5 = (z3 + z4) * FIX_1_175875602;
+
+        tmp0 = tmp0 * FIX_0_298631336;
+        tmp1 = tmp1 * FIX_2_053119869;
+        tmp2 = tmp2 * FIX_3_072711026;
+        tmp3 = tmp3 * FIX_1_501321110;
+        z1 = z1 * (-FIX_0_899976223);
+        z2 = z2 * (-FIX_2_562915447);
+        z3 = z3 * (-FIX_1_961570560);
+        z4 = z4 * (-FIX_0_390180644);
+
+        z3 += z5;
+        z4 += z5;
+
+        tmp0 += z1 + z3;
+        tmp1 += z2 + z4;
+        tmp2 += z2 + z3;
+        tmp3 += z1 + z4;
+
+        ws[0]  = DESCALE(tmp10 + tmp3, CONST_BITS - PASS1_BITS);
+        ws[56] = DESCALE(tmp10 - tmp3, CONST_BITS - PASS1_BITS);
+        ws[8]  = DESCALE(tmp11 + tmp2, CONST_BITS - PASS1_BITS);
+        ws[48] = DESCALE(tmp11 - tmp2, CONST_BITS - PASS1_BITS);
+        ws[16] = DESCALE(tmp12 + tmp1, CONST_BITS - PASS1_BITS);
+        ws[40] = DESCALE(tmp12 - tmp1, CONST_BITS - PASS1_BITS);
+        ws[24] = DESCALE(tmp13 + tmp0, CONST_BITS - PASS1_BITS);
+        ws[32] = DESCALE(tmp13 - tmp0, CONST_BITS - PASS1_BITS);
+    }
+
+    // Pass 2: rows from workspace to output samples
+    for (int row = 0; row < 8; row++) {
+        const int32_t* ws = workspace + row * 8;
+        uint8_t* o = out + row * stride;
+
+        int32_t z2 = ws[2];
+        int32_t z3 = ws[6];
+        int32_t z1 = (z2 + z3) * FIX_0_541196100;
+        int32_t tmp2 = z1 + z3 * (-FIX_1_847759065);
+        int32_t tmp3 = z1 + z2 * FIX_0_765366865;
+
+        int32_t tmp0 = (ws[0] + ws[4]) << CONST_BITS;
+        int32_t tmp1 = (ws[0] - ws[4]) << CONST_BITS;
+
+        int32_t tmp10 = tmp0 + tmp3;
+        int32_t tmp13 = tmp0 - tmp3;
+        int32_t tmp11 = tmp1 + tmp2;
+        int32_t tmp12 = tmp1 - tmp2;
+
+        tmp0 = ws[7];
+        tmp1 = ws[5];
+        tmp2 = ws[3];
+        tmp3 = ws[1];
+
+        z1 = tmp0 + tmp3;
+        z2 = tmp1 + tmp2;
+        z3 = tmp0 + tmp2;
+        int32_t z4 = tmp1 + tmp3;
+        int32_t z5 = (z3 + z4) * FIX_1_175875602;
+
+        tmp0 = tmp0 * FIX_0_298631336;
+        tmp1 = tmp1 * FIX_2_053119869;
+        tmp2 = tmp2 * FIX_3_072711026;
+        tmp3 = tmp3 * FIX_1_501321110;
+        z1 = z1 * (-FIX_0_899976223);
+        z2 = z2 * (-FIX_2_562915447);
+        z3 = z3 * (-FIX_1_961570560);
+        z4 = z4 * (-FIX_0_390180644);
+
+        z3 += z5;
+        z4 += z5;
+
+        tmp0 += z1 + z3;
+        tmp1 += z2 + z4;
+        tmp2 += z2 + z3;
+        tmp3 += z1 + z4;
+
+        const int shift = CONST_BITS + PASS1_BITS + 3;
+        o[0] = clampSample(DESCALE(tmp10 + tmp3, shift));
+        o[7] = clampSample(DESCALE(tmp10 - tmp3, shift));
+        o[1] = clampSample(DESCALE(tmp11 + tmp2, shift));
+        o[6] = clampSample(DESCALE(tmp11 - tmp2, shift));
+        o[2] = clampSample(DESCALE(tmp12 + tmp1, shift));
+        o[5] = clampSample(DESCALE(tmp12 - tmp1, shift));
+        o[3] = clampSample(DESCALE(tmp13 + tmp0, shift));
+        o[4] = clampSample(DESCALE(tmp13 - tmp0, shift));
+    }
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+JpegStreamDecoder::JpegStreamDecoder()
+    : _sink(nullptr), _state(STATE_MARKER), _error(nullptr), _in(nullptr), _band(nullptr) {
+    for (int i = 0; i < 4; i++) {
+        _dcTables[i] = nullptr;
+        _acTables[i] = nullptr;
+    }
+    begin(nullptr);
+}
+
+JpegStreamDecoder::~JpegStreamDecoder() {
+    end();
+}
+
+void JpegStreamDecoder::begin(ImageRowSink* sink) {
+    end();
+    _sink = sink;
+    _state = STATE_MARKER;
+    _error = nullptr;
+    _inLen = 0;
+    _inPos = 0;
+    _marker = 0;
+    _segmentLength = 0;
+    _skipRemaining = 0;
+    _seenFrame = false;
+    _width = 0;
+    _height = 0;
+    _componentCount = 0;
+    _hmax = 1;
+    _vmax = 1;
+    memset(_qtDefined, 0, sizeof(_qtDefined));
+    _restartInterval = 0;
+    _scanCount = 0;
+    _mcusX = 0;
+    _mcuTotal = 0;
+    _mcuIndex = 0;
+    _bitBuf = 0;
+    _bitCount = 0;
+    _markerHit = false;
+    _underflow = false;
+    _bandWidth = 0;
+    _bandHeight = 0;
+    _scanBandHeight = 0;
+}
+
+void JpegStreamDecoder::end() {
+    free(_in);
+    free(_band);
+    _in = nullptr;
+    _band = nullptr;
+    for (int i = 0; i < 4; i++) {
+        free(_dcTables[i]);
+        free(_acTables[i]);
+        _dcTables[i] = nullptr;
+        _acTables[i] = nullptr;
+    }
+}
+
+size_t JpegStreamDecoder::getMemoryUsage() const {
+    size_t total = 0;
+    if (_in != nullptr) {
+        total += JPEG_INPUT_BUFFER_SIZE;
+    }
+    if (_band != nullptr) {
+        total += (size_t)_bandWidth * _bandHeight;
+    }
+    for (int i = 0; i < 4; i++) {
+        if (_dcTables[i] != nullptr) total += sizeof(HuffTable);
+        if (_acTables[i] != nullptr) total += sizeof(HuffTable);
+    }
+    return total;
+}
+
+DecodeStatus JpegStreamDecoder::status() const {
+    switch (_state) {
+        case STATE_DONE:        return DECODE_DONE;
+        case STATE_UNSUPPORTED: return DECODE_UNSUPPORTED;
+        case STATE_ERROR:       return DECODE_ERROR;
+        default:                return DECODE_OK;
+    }
+}
+
+DecodeStatus JpegStreamDecoder::fail(const char* message) {
+    _state = STATE_ERROR;
+    _error = message;
+    return DECODE_ERROR;
+}
+
+DecodeStatus JpegStreamDecoder::unsupported(const char* message) {
+    _state = STATE_UNSUPPORTED;
+    _error = message;
+    return DECODE_UNSUPPORTED;
+}
+
+DecodeStatus JpegStreamDecoder::feed(const uint8_t* data, size_t length) {
+    if (_state >= STATE_DONE) {
+        return status();
+    }
+    if (_in == nullptr) {
+        _in = (uint8_t*)malloc(JPEG_INPUT_BUFFER_SIZE);
+        if (_in == nullptr) {
+            return fail("Out of memory for JPEG input buffer");
+        }
+    }
+
+    size_t pos = 0;
+    while (_state < STATE_DONE) {
+        // Keep unconsumed bytes at the front of the buffer
+        if (_inPos > 0) {
+            memmove(_in, _in + _inPos, _inLen - _inPos);
+            _inLen -= _inPos;
+            _inPos = 0;
+        }
+
+        size_t take = length - pos;
+        if (take > JPEG_INPUT_BUFFER_SIZE - _inLen) {
+            take = JPEG_INPUT_BUFFER_SIZE - _inLen;
+        }
+        memcpy(_in + _inLen, data + pos, take);
+        _inLen += take;
+        pos += take;
+
+        process();
+
+        if (pos >= length) {
+            break;
+        }
+        if (_inPos == 0 && _inLen == JPEG_INPUT_BUFFER_SIZE && _state < STATE_DONE) {
+            return fail("JPEG segment exceeds input buffer");
+        }
+    }
+    return status();
+}
+
+// ============================================================================
+// Marker and segment parsing
+// ============================================================================
+
+void JpegStreamDecoder::process() {
+    for (;;) {
+        size_t available = _inLen - _inPos;
+
+        switch (_state) {
+            case STATE_MARKER: {
+                while (_inPos < _inLen && _in[_inPos] != 0xFF) {
+                    _inPos++;
+                }
+                // Any number of 0xFF fill bytes may precede a marker
+                while (_inPos + 1 < _inLen && _in[_inPos + 1] == 0xFF) {
+                    _inPos++;
+                }
+                if (_inPos + 1 >= _inLen) {
+                    return;
+                }
+                uint8_t marker = _in[_inPos + 1];
+                _inPos += 2;
+                handleMarker(marker);
+                break;
+            }
+
+            case STATE_SEGMENT_LENGTH: {
+                if (available < 2) {
+                    return;
+                }
+                uint16_t length = readBigEndian16(_in + _inPos);
+                _inPos += 2;
+                if (length < 2) {
+                    fail("Invalid JPEG segment length");
+                    return;
+                }
+                _segmentLength = length - 2;
+                switch (_marker) {
+                    case 0xC0: case 0xC1: case 0xC4: case 0xDB: case 0xDD: case 0xDA:
+                        _state = STATE_SEGMENT;
+                        break;
+                    default:
+                        _skipRemaining = _segmentLength;
+                        _state = STATE_SKIP_SEGMENT;
+                        break;
+                }
+                break;
+            }
+
+            case STATE_SEGMENT:
+                if (available < _segmentLength) {
+                    return;
+                }
+                _state = STATE_MARKER;
+                parseSegment(_in + _inPos, _segmentLength);
+                _inPos += _segmentLength;
+                break;
+
+            case STATE_SKIP_SEGMENT: {
+                size_t skip = available < _skipRemaining ? available : _skipRemaining;
+                _inPos += skip;
+                _skipRemaining -= (uint16_t)skip;
+                if (_skipRemaining > 0) {
+                    return;
+                }
+                _state = STATE_MARKER;
+                break;
+            }
+
+            case STATE_SCAN:
+                decodeScan();
+                if (_state == STATE_SCAN) {
+                    return;
+                }
+                break;
+
+            case STATE_SKIP_SCAN:
+                skipScan();
+                if (_state == STATE_SKIP_SCAN) {
+                    return;
+                }
+                break;
+
+            default:
+                return;
+        }
+    }
+}
+
+void JpegStreamDecoder::handleMarker(uint8_t marker) {
+    switch (marker) {
+        case 0xD8:  // SOI
+        case 0x01:  // TEM
+        case 0xD0: case 0xD1: case 0xD2: case 0xD3:
+        case 0xD4: case 0xD5: case 0xD6: case 0xD7:
+            break;
+
+        case 0xD9:  // EOI
+            fail("JPEG ended before all rows were decoded");
+            break;
+
+        case 0xC2: case 0xC3: case 0xC5: case 0xC6: case 0xC7:
+        case 0xC9: case 0xCA: case 0xCB: case 0xCD: case 0xCE: case 0xCF:
+            unsupported("Progressive, lossless or arithmetic JPEG not supported");
+            break;
+
+        default:
+            _marker = marker;
+            _state = STATE_SEGMENT_LENGTH;
+            break;
+    }
+}
+
+void JpegStreamDecoder::parseSegment(const uint8_t* data, uint16_t length) {
+    switch (_marker) {
+        case 0xC0:
+        case 0xC1:
+            parseFrame(data, length);
+            break;
+        case 0xC4:
+            parseHuffmanTables(data, length);
+            break;
+        case 0xDB:
+            parseQuantTables(data, length);
+            break;
+        case 0xDD:
+            if (length < 2) {
+                fail("Invalid DRI segment");
+                return;
+            }
+            _restartInterval = readBigEndian16(data);
+            break;
+        case 0xDA:
+            parseScan(data, length);
+            break;
+        default:
+            break;
+    }
+}
+
+bool JpegStreamDecoder::parseFrame(const uint8_t* data, uint16_t length) {
+    if (_seenFrame) {
+        fail("Multiple JPEG frames");
+        return false;
+    }
+    if (length < 6) {
+        fail("Invalid SOF segment");
+        return false;
+    }
+    if (data[0] != 8) {
+        unsupported("12-bit JPEG not supported");
+        return false;
+    }
+
+    _height = readBigEndian16(data + 1);
+    _width = readBigEndian16(data + 3);
+    _componentCount = data[5];
+
+    if (_height == 0) {
+        unsupported("JPEG with DNL height not supported");
+        return false;
+    }
+    if (_width == 0 || _width > JPEG_MAX_WIDTH) {
+        fail("Unsupported JPEG dimensions");
+        return false;
+    }
+    if (_componentCount == 4) {
+        unsupported("CMYK JPEG not supported");
+        return false;
+    }
+    if ((_componentCount != 1 && _componentCount != 3) || length < 6 + 3 * _componentCount) {
+        fail("Invalid JPEG component count");
+        return false;
+    }
+
+    _hmax = 1;
+    _vmax = 1;
+    for (uint8_t i = 0; i < _componentCount; i++) {
+        Component& c = _components[i];
+        c.id = data[6 + 3 * i];
+        c.h = data[7 + 3 * i] >> 4;
+        c.v = data[7 + 3 * i] & 0x0F;
+        c.tq = data[8 + 3 * i];
+        c.td = 0;
+        c.ta = 0;
+        c.dcPred = 0;
+        if (c.h < 1 || c.h > 4 || c.v < 1 || c.v > 4 || c.tq > 3) {
+            fail("Invalid JPEG component");
+            return false;
+        }
+        if (c.h > _hmax) _hmax = c.h;
+        if (c.v > _vmax) _vmax = c.v;
+    }
+
+    if (_components[0].h != _hmax || _components[0].v != _vmax) {
+        unsupported("Subsampled JPEG luminance not supported");
+        return false;
+    }
+
+    uint16_t mcuWidth = 8 * _hmax;
+    _bandWidth = (uint16_t)(((_width + mcuWidth - 1) / mcuWidth) * mcuWidth);
+    _bandHeight = (uint8_t)(8 * _vmax);
+    _band = (uint8_t*)malloc((size_t)_bandWidth * _bandHeight);
+    if (_band == nullptr) {
+        fail("Out of memory for JPEG MCU row");
+        return false;
+    }
+
+    _seenFrame = true;
+    if (_sink != nullptr && !_sink->begin(_width, _height)) {
+        fail("Image sink rejected dimensions");
+        return false;
+    }
+    return true;
+}
+
+bool JpegStreamDecoder::parseHuffmanTables(const uint8_t* data, uint16_t length) {
+    uint16_t pos = 0;
+    while (pos < length) {
+        uint8_t tc = data[pos] >> 4;
+        uint8_t th = data[pos] & 0x0F;
+        pos++;
+        if (tc > 1 || th > 3 || pos + 16 > length) {
+            fail("Invalid DHT segment");
+            return false;
+        }
+
+        const uint8_t* counts = data + pos;
+        pos += 16;
+        uint16_t total = 0;
+        for (int i = 0; i < 16; i++) {
+            total += counts[i];
+        }
+        if (total > 256 || pos + total > length) {
+            fail("Invalid DHT segment");
+            return false;
+        }
+
+        HuffTable*& slot = tc == 0 ? _dcTables[th] : _acTables[th];
+        if (slot == nullptr) {
+            slot = (HuffTable*)malloc(sizeof(HuffTable));
+            if (slot == nullptr) {
+                fail("Out of memory for Huffman table");
+                return false;
+            }
+        }
+        HuffTable* t = slot;
+        memcpy(t->values, data + pos, total);
+        pos += total;
+
+        // Canonical code assignment (JPEG Annex C)
+        memset(t->fast, 0, sizeof(t->fast));
+        uint32_t code = 0;
+        uint16_t index = 0;
+        for (uint8_t len = 1; len <= 16; len++) {
+            uint8_t n = counts[len - 1];
+            if (n == 0) {
+                t->maxcode[len] = -1;
+                t->valptr[len] = 0;
+                t->mincode[len] = 0;
+            } else {
+                t->valptr[len] = index;
+                t->mincode[len] = (uint16_t)code;
+                for (uint8_t i = 0; i < n; i++) {
+                    if (len <= 9) {
+                        uint16_t entry = (uint16_t)((len << 8) | t->values[index]);
+                        uint16_t first = (uint16_t)(code << (9 - len));
+                        uint16_t fill = (uint16_t)(1 << (9 - len));
+                        for (uint16_t j = 0; j < fill; j++) {
+                            t->fast[first + j] = entry;
+                        }
+                    }
+                    code++;
+                    index++;
+                }
+                t->maxcode[len] = (int32_t)code - 1;
+            }
+            if (code > (1UL << len)) {
+                fail("Invalid Huffman table");
+                return false;
+            }
+            code <<= 1;
+        }
+    }
+    return true;
+}
+
+bool JpegStreamDecoder::parseQuantTables(const uint8_t* data, uint16_t length) {
+    uint16_t pos = 0;
+    while (pos < length) {
+        uint8_t precision = data[pos] >> 4;
+        uint8_t tq = data[pos] & 0x0F;
+        pos++;
+        uint16_t needed = precision ? 128 : 64;
+        if (tq > 3 || precision > 1 || pos + needed > length) {
+            fail("Invalid DQT segment");
+            return false;
+        }
+        for (int k = 0; k < 64; k++) {
+            uint16_t value = precision ? readBigEndian16(data + pos + 2 * k) : data[pos + k];
+            _qt[tq][ZIGZAG[k]] = value;
+        }
+        _qtDefined[tq] = true;
+        pos += needed;
+    }
+    return true;
+}
+
+bool JpegStreamDecoder::parseScan(const uint8_t* data, uint16_t length) {
+    if (!_seenFrame) {
+        fail("JPEG scan before frame header");
+        return false;
+    }
+    uint8_t count = length > 0 ? data[0] : 0;
+    if (count < 1 || count > _componentCount || length < 1 + 2 * count + 3) {
+        fail("Invalid SOS segment");
+        return false;
+    }
+
+    bool hasLuma = false;
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t id = data[1 + 2 * i];
+        uint8_t tables = data[2 + 2 * i];
+        uint8_t index = 0xFF;
+        for (uint8_t c = 0; c < _componentCount; c++) {
+            if (_components[c].id == id) {
+                index = c;
+            }
+        }
+        if (index == 0xFF || (tables >> 4) > 3 || (tables & 0x0F) > 3) {
+            fail("Invalid SOS component");
+            return false;
+        }
+        _scanComponents[i] = index;
+        _components[index].td = tables >> 4;
+        _components[index].ta = tables & 0x0F;
+        _components[index].dcPred = 0;
+        if (index == 0) {
+            hasLuma = true;
+        }
+    }
+    _scanCount = count;
+
+    if (!hasLuma) {
+        // Chroma-only scan: nothing to render, skip its entropy-coded data
+        _state = STATE_SKIP_SCAN;
+        return true;
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        const Component& c = _components[_scanComponents[i]];
+        if (_dcTables[c.td] == nullptr || _acTables[c.ta] == nullptr) {
+            fail("JPEG Huffman table missing");
+            return false;
+        }
+    }
+    if (!_qtDefined[_components[0].tq]) {
+        fail("JPEG quantization table missing");
+        return false;
+    }
+
+    uint32_t mcuRows;
+    if (count == 1) {
+        // Non-interleaved scan: one block per MCU, no padding to the MCU grid
+        _mcusX = (uint16_t)((_width + 7) / 8);
+        mcuRows = (_height + 7) / 8;
+        _scanBandHeight = 8;
+    } else {
+        uint16_t mcuWidth = 8 * _hmax;
+        uint16_t mcuHeight = 8 * _vmax;
+        _mcusX = (uint16_t)((_width + mcuWidth - 1) / mcuWidth);
+        mcuRows = (_height + mcuHeight - 1) / mcuHeight;
+        _scanBandHeight = (uint8_t)mcuHeight;
+    }
+    _mcuTotal = (uint32_t)_mcusX * mcuRows;
+    _mcuIndex = 0;
+    _bitBuf = 0;
+    _bitCount = 0;
+    _markerHit = false;
+    _state = STATE_SCAN;
+    return true;
+}
+
+// ============================================================================
+// Entropy-coded data
+// ============================================================================
+
+uint8_t JpegStreamDecoder::nextByte() {
+    if (_markerHit) {
+        return 0;
+    }
+    if (_inPos >= _inLen) {
+        _underflow = true;
+        return 0;
+    }
+    uint8_t b = _in[_inPos];
+    if (b != 0xFF) {
+        _inPos++;
+        return b;
+    }
+    if (_inPos + 1 >= _inLen) {
+        _underflow = true;
+        return 0;
+    }
+    if (_in[_inPos + 1] == 0x00) {
+        _inPos += 2;
+        return 0xFF;
+    }
+    // Marker: leave it in place, the rest of the segment decodes as zeros
+    _markerHit = true;
+    return 0;
+}
+
+void JpegStreamDecoder::fillBits() {
+    while (_bitCount <= 24) {
+        _bitBuf = (_bitBuf << 8) | nextByte();
+        _bitCount += 8;
+    }
+}
+
+uint32_t JpegStreamDecoder::getBits(uint8_t count) {
+    if (_bitCount < count) {
+        fillBits();
+    }
+    _bitCount -= count;
+    return (_bitBuf >> _bitCount) & ((1UL << count) - 1);
+}
+
+int JpegStreamDecoder::decodeHuffman(const HuffTable* table) {
+    if (_bitCount < 16) {
+        fillBits();
+    }
+
+    uint16_t entry = table->fast[(_bitBuf >> (_bitCount - 9)) & 0x1FF];
+    if (entry != 0) {
+        _bitCount -= entry >> 8;
+        return entry & 0xFF;
+    }
+
+    uint32_t code16 = (_bitBuf >> (_bitCount - 16)) & 0xFFFF;
+    for (uint8_t len = 10; len <= 16; len++) {
+        int32_t code = (int32_t)(code16 >> (16 - len));
+        if (code <= table->maxcode[len]) {
+            _bitCount -= len;
+            return table->values[table->valptr[len] + code - table->mincode[len]];
+        }
+    }
+    return -1;
+}
+
+int JpegStreamDecoder::receiveExtend(uint8_t size) {
+    int value = (int)getBits(size);
+    if (value < (1 << (size - 1))) {
+        value -= (1 << size) - 1;
+    }
+    return value;
+}
+
+bool JpegStreamDecoder::decodeBlock(Component& component, int16_t* coef) {
+    const HuffTable* dc = _dcTables[component.td];
+    const HuffTable* ac = _acTables[component.ta];
+
+    int s = decodeHuffman(dc);
+    if (s < 0 || s > 11) {
+        return false;
+    }
+    if (s > 0) {
+        component.dcPred = (int16_t)(component.dcPred + receiveExtend((uint8_t)s));
+    }
+
+    if (coef != nullptr) {
+        memset(coef, 0, 64 * sizeof(int16_t));
+        coef[0] = component.dcPred;
+    }
+
+    for (int k = 1; k < 64;) {
+        int rs = decodeHuffman(ac);
+        if (rs < 0) {
+            return false;
+        }
+        int run = rs >> 4;
+        int size = rs & 0x0F;
+
+        if (size == 0) {
+            if (run != 15) {
+                break;  // End of block
+            }
+            k += 16;
+            continue;
+        }
+
+        k += run;
+        if (k > 63) {
+            return false;
+        }
+        int value = receiveExtend((uint8_t)size);
+        if (coef != nullptr) {
+            coef[ZIGZAG[k]] = (int16_t)value;
+        }
+        k++;
+    }
+    return true;
+}
+
+bool JpegStreamDecoder::decodeMCU() {
+    int16_t coef[64];
+    uint16_t mcuX = (uint16_t)(_mcuIndex % _mcusX);
+    const uint16_t* qt = _qt[_components[0].tq];
+
+    if (_scanCount == 1) {
+        if (!decodeBlock(_components[0], coef)) {
+            return false;
+        }
+        inverseDCT(coef, qt, _band + mcuX * 8, _bandWidth);
+        return true;
+    }
+
+    for (uint8_t i = 0; i < _scanCount; i++) {
+        uint8_t index = _scanComponents[i];
+        Component& c = _components[index];
+        for (uint8_t by = 0; by < c.v; by++) {
+            for (uint8_t bx = 0; bx < c.h; bx++) {
+                if (index != 0) {
+                    // Chroma: decode to stay in sync, never transformed
+                    if (!decodeBlock(c, nullptr)) {
+                        return false;
+                    }
+                    continue;
+                }
+                if (!decodeBlock(c, coef)) {
+                    return false;
+                }
+                uint8_t* out = _band + (by * 8) * _bandWidth + (mcuX * c.h + bx) * 8;
+                inverseDCT(coef, qt, out, _bandWidth);
+            }
+        }
+    }
+    return true;
+}
+
+bool JpegStreamDecoder::processRestart() {
+    _bitBuf = 0;
+    _bitCount = 0;
+    _markerHit = false;
+
+    for (;;) {
+        while (_inPos < _inLen && _in[_inPos] != 0xFF) {
+            _inPos++;
+        }
+        if (_inPos + 1 >= _inLen) {
+            _underflow = true;
+            return false;
+        }
+        uint8_t next = _in[_inPos + 1];
+        if (next == 0x00 || next == 0xFF) {
+            _inPos++;
+            continue;
+        }
+        if (next >= 0xD0 && next <= 0xD7) {
+            _inPos += 2;
+        } else {
+            // Unexpected marker: remaining MCUs decode as zeros
+            _markerHit = true;
+        }
+        break;
+    }
+
+    for (uint8_t i = 0; i < _componentCount; i++) {
+        _components[i].dcPred = 0;
+    }
+    return true;
+}
+
+void JpegStreamDecoder::decodeScan() {
+    while (_mcuIndex < _mcuTotal) {
+        // Each MCU is decoded as a transaction: if its bytes have not all
+        // arrived yet, roll back and retry when the next chunk is fed.
+        size_t savedPos = _inPos;
+        uint32_t savedBuf = _bitBuf;
+        uint8_t savedCount = _bitCount;
+        bool savedMarker = _markerHit;
+        int16_t savedPred[3];
+        for (uint8_t i = 0; i < _componentCount; i++) {
+            savedPred[i] = _components[i].dcPred;
+        }
+
+        _underflow = false;
+        bool ok = true;
+        if (_restartInterval != 0 && _mcuIndex > 0 && _mcuIndex % _restartInterval == 0) {
+            ok = processRestart();
+        }
+        if (ok) {
+            ok = decodeMCU();
+        }
+
+        if (_underflow) {
+            _inPos = savedPos;
+            _bitBuf = savedBuf;
+            _bitCount = savedCount;
+            _markerHit = savedMarker;
+            for (uint8_t i = 0; i < _componentCount; i++) {
+                _components[i].dcPred = savedPred[i];
+            }
+            return;
+        }
+        if (!ok) {
+            fail("Corrupt JPEG data");
+            return;
+        }
+
+        _mcuIndex++;
+        if (_mcuIndex % _mcusX == 0) {
+            emitBand(_mcuIndex / _mcusX - 1);
+        }
+    }
+
+    // Luminance complete - any remaining chroma scans are irrelevant
+    _state = STATE_DONE;
+}
+
+void JpegStreamDecoder::skipScan() {
+    while (_inPos + 1 < _inLen) {
+        if (_in[_inPos] != 0xFF) {
+            _inPos++;
+            continue;
+        }
+        uint8_t next = _in[_inPos + 1];
+        if (next == 0x00 || (next >= 0xD0 && next <= 0xD7)) {
+            _inPos += 2;
+        } else if (next == 0xFF) {
+            _inPos++;
+        } else {
+            _state = STATE_MARKER;
+            return;
+        }
+    }
+}
+
+void JpegStreamDecoder::emitBand(uint32_t mcuRow) {
+    if (_sink == nullptr) {
+        return;
+    }
+    uint32_t y0 = mcuRow * _scanBandHeight;
+    for (uint8_t i = 0; i < _scanBandHeight; i++) {
+        uint32_t y = y0 + i;
+        if (y >= _height) {
+            break;
+        }
+        _sink->writeRow((uint16_t)y, _band + i * _bandWidth, _width);
+    }
+}
@@ -0,0 +1,158 @@
+#ifndef JPEG_DECODER_H
+#define JPEG_DECODER_H
+
+#include <image_decoder.h>
+
+// Bytes of undecoded input held at once. Must fit the largest header segment
+// the decoder parses (DHT) and one worst-case MCU of entropy-coded data.
+#define JPEG_INPUT_BUFFER_SIZE 4096
+
+/**
+ * @brief Incremental baseline JPEG decoder producing grayscale rows
+ *
+ * Pure C++ with NO dependencies on Arduino/ESP32 APIs.
+ *
+ * Supports baseline and extended sequential Huffman JPEGs (SOF0/SOF1, 8-bit)
+ * with any chroma subsampling, interleaved or per-component scans, and
+ * restart intervals. Only luminance is needed for e-paper, so chroma blocks
+ * are entropy-decoded (to stay in sync) but never transformed. The IDCT is
+ * the accurate integer algorithm used by libjpeg (JDCT_ISLOW), so output is
+ * identical to libjpeg's grayscale decode.
+ *
+ * Progressive, arithmetic-coded, 12-bit and CMYK images are reported as
+ * DECODE_UNSUPPORTED so the caller can fall back.
+ *
+ * Memory: input buffer (4 KB) + one MCU row of luminance + Huffman tables.
+ */
+class JpegStreamDecoder {
+public:
+    JpegStreamDecoder();
+    ~JpegStreamDecoder();
+
+    /**
+     * @brief Reset state for a new image
+     * @param sink Receives decoded rows (must outlive decoding)
+     */
+    void begin(ImageRowSink* sink);
+
+    /**
+     * @brief Release all buffers
+     */
+    void end();
+
+    /**
+     * @brief Decode the next chunk of the file
+     * @return DECODE_OK, DECODE_DONE, DECODE_UNSUPPORTED or DECODE_ERROR
+     */
+    DecodeStatus feed(const uint8_t* data, size_t length);
+
+    const char* getError() const { return _error; }
+    uint16_t getWidth() const { return _width; }
+    uint16_t getHeight() const { return _height; }
+
+    // Bytes of heap currently held (input buffer, MCU row, Huffman tables)
+    size_t getMemoryUsage() const;
+
+private:
+    enum State {
+        STATE_MARKER,
+        STATE_SEGMENT_LENGTH,
+        STATE_SEGMENT,
+        STATE_SKIP_SEGMENT,
+        STATE_SCAN,
+        STATE_SKIP_SCAN,
+        STATE_DONE,
+        STATE_UNSUPPORTED,
+        STATE_ERROR
+    };
+
+    struct HuffTable {
+        uint16_t fast[512];     // (length << 8) | value for codes <= 9 bits, 0 = slow path
+        int32_t maxcode[17];    // Largest code of each length, -1 if none
+        int32_t valptr[17];     // Index of the first value of each length
+        uint16_t mincode[17];   // Smallest code of each length
+        uint8_t values[256];
+    };
+
+    struct Component {
+        uint8_t id;
+        uint8_t h;
+        uint8_t v;
+        uint8_t tq;             // Quantization table
+        uint8_t td;             // DC Huffman table (current scan)
+        uint8_t ta;             // AC Huffman table (current scan)
+        int16_t dcPred;
+    };
+
+    ImageRowSink* _sink;
+    State _state;
+    const char* _error;
+
+    // Input buffering
+    uint8_t* _in;
+    size_t _inLen;
+    size_t _inPos;
+    uint8_t _marker;
+    uint16_t _segmentLength;
+    uint16_t _skipRemaining;
+
+    // Frame
+    bool _seenFrame;
+    uint16_t _width;
+    uint16_t _height;
+    uint8_t _componentCount;
+    Component _components[3];
+    uint8_t _hmax;
+    uint8_t _vmax;
+    uint16_t _qt[4][64];        // Natural order
+    bool _qtDefined[4];
+    HuffTable* _dcTables[4];
+    HuffTable* _acTables[4];
+    uint16_t _restartInterval;
+
+    // Current scan
+    uint8_t _scanCount;
+    uint8_t _scanComponents[3];
+    uint16_t _mcusX;
+    uint32_t _mcuTotal;
+    uint32_t _mcuIndex;
+
+    // Entropy decoder (MSB-first)
+    uint32_t _bitBuf;
+    uint8_t _bitCount;
+    bool _markerHit;
+    bool _underflow;
+
+    // One MCU row of luminance
+    uint8_t* _band;
+    uint16_t _bandWidth;
+    uint8_t _bandHeight;
+    uint8_t _scanBandHeight;
+
+    DecodeStatus status() const;
+    DecodeStatus fail(const char* message);
+    DecodeStatus unsupported(const char* message);
+
+    void process();
+    void handleMarker(uint8_t marker);
+    void parseSegment(const uint8_t* data, uint16_t length);
+    bool parseFrame(const uint8_t* data, uint16_t length);
+    bool parseHuffmanTables(const uint8_t* data, uint16_t length);
+    bool parseQuantTables(const uint8_t* data, uint16_t length);
+    bool parseScan(const uint8_t* data, uint16_t length);
+
+    void decodeScan();
+    void skipScan();
+    bool processRestart();
+    bool decodeMCU();
+    bool decodeBlock(Component& component, int16_t* coef);
+    void emitBand(uint32_t mcuRow);
+
+    uint8_t nextByte();
+    void fillBits();
+    uint32_t getBits(uint8_t count);
+    int decodeHuffman(const HuffTable* table);
+    int receiveExtend(uint8_t size);
+};
+
+#endif // JPEG_DECODER_H
@@ -19,11 +19,13 @@ bool ConfigModeController::begin(float batteryVoltage) {
     // Store battery voltage for use in UI screens
     this->batteryVoltage = batteryVoltage;
     
-    DashboardConfig config;
+    // Config mode screens replace the dashboard image - the next timer wake must not skip its download
+    configManager->clearDisplayedImageSlot();
+    
     hasPartialConfig = configManager->hasWiFiConfig() && !configManager->isFullyConfigured();
     
     // For partial config, we may not have a full config to load
-    if (!hasPartialConfig && !configManager->loadConfig(config)) {
+    if (!hasPartialConfig && !configManager->loadConfig()) {
         Logger::message("Config Mode Error", "Failed to load config");
         uiError->showConfigLoadError();
         delay(3000);
@@ -33,12 +35,8 @@ bool ConfigModeController::begin(float batteryVoltage) {
         return false;
     }
     
-    // For partial config, get WiFi credentials directly
-    if (hasPartialConfig) {
-        config.wifiSSID = configManager->getWiFiSSID();
-        config.wifiPassword = configManager->getWiFiPassword();
-        // No need to set refreshRate anymore
-    }
+    // Holds the WiFi credentials for partial config as well
+    const DashboardConfig& config = configManager->getConfig();
     
     // Show config mode message (skip on slow displays to reduce screen updates)
 #if DISPLAY_FAST_REFRESH
@@ -106,10 +104,9 @@ bool ConfigModeController::startConfigPortalWithWiFi(const String& localIP) {
         delay(3000);
         
         // Load average interval for sleep
-        DashboardConfig config;
         uint16_t sleepMinutes = DEFAULT_INTERVAL_MINUTES;
-        if (configManager->loadConfig(config)) {
-            sleepMinutes = config.getAverageInterval();
+        if (configManager->loadConfig()) {
+            sleepMinutes = configManager->getConfig().getAverageInterval();
         }
         
         powerManager->prepareForSleep();
@@ -148,10 +145,9 @@ bool ConfigModeController::startConfigPortalWithAP() {
             delay(3000);
             
             // Load average interval for sleep, with minimum 5 minute fallback
-            DashboardConfig config;
             uint16_t sleepMinutes = DEFAULT_INTERVAL_MINUTES;
-            if (configManager->loadConfig(config)) {
-                uint16_t avgInterval = config.getAverageInterval();
+            if (configManager->loadConfig()) {
+                uint16_t avgInterval = configManager->getConfig().getAverageInterval();
                 sleepMinutes = (avgInterval > 0) ? avgInterval : 5;
             }
             
@@ -165,10 +161,9 @@ bool ConfigModeController::startConfigPortalWithAP() {
         delay(3000);
         
         // Load average interval for sleep, with minimum 5 minute fallback
-        DashboardConfig config;
         uint16_t sleepMinutes = DEFAULT_INTERVAL_MINUTES;
-        if (configManager->loadConfig(config)) {
-            uint16_t avgInterval = config.getAverageInterval();
+        if (configManager->loadConfig()) {
+            uint16_t avgInterval = configManager->getConfig().getAverageInterval();
             sleepMinutes = (avgInterval > 0) ? avgInterval : 5;
         }
         
@@ -48,12 +48,17 @@ CRC32Decision determineCRC32Action(const DashboardConfig& config,
                                    uint8_t currentIndex) {
     CRC32Decision decision;
     decision.shouldCheck = false;
+    decision.strategy = CHANGE_STRATEGY_NONE;
     decision.reason = "CRC32 disabled in config";
     
     if (!config.useCRC32Check) {
         return decision;
     }
     
+    decision.strategy = (config.changeDetection == CHANGE_DETECTION_HTTP)
+                        ? CHANGE_STRATEGY_CONDITIONAL_GET
+                        : CHANGE_STRATEGY_CRC32;
+    
     // CRC32 enabled - decide if we should check for skip optimization
     // (we always fetch the CRC32 value when enabled, for saving)
     
@@ -90,6 +95,38 @@ CRC32Decision determineCRC32Action(const DashboardConfig& config,
     return decision;
 }
 
+SkipDecision determineUnchangedSkip(const DashboardConfig& config,
+                                    WakeupReason wakeReason,
+                                    uint8_t targetIndex,
+                                    uint8_t displayedSlot) {
+    SkipDecision decision;
+    decision.allowSkip = false;
+    
+    if (!config.useCRC32Check) {
+        decision.reason = "Change detection disabled";
+        return decision;
+    }
+    
+    if (wakeReason != WAKEUP_TIMER) {
+        decision.reason = "Manual wake (always refresh)";
+        return decision;
+    }
+    
+    if (displayedSlot == IMAGE_SLOT_NONE) {
+        decision.reason = "Screen content unknown (always download)";
+        return decision;
+    }
+    
+    if (targetIndex != displayedSlot) {
+        decision.reason = "Target image not on screen (always download)";
+        return decision;
+    }
+    
+    decision.allowSkip = true;
+    decision.reason = "Target image on screen (skip if unchanged)";
+    return decision;
+}
+
 SleepDecision determineSleepDuration(const DashboardConfig& config, 
                                      time_t currentTime, 
                                      uint8_t currentIndex, 
@@ -169,7 +206,8 @@ float calculateSleepMinutesToNextEnabledHour(time_t currentTime, int timezoneOff
  */
 NormalModeDecisions orchestrateNormalModeDecisions(const DashboardConfig& config,
                                                     WakeupReason wakeReason,
-                                                    uint8_t currentIndex) {
+                                                    uint8_t currentIndex,
+                                                    uint8_t displayedSlot) {
     NormalModeDecisions result;
     
     // Preserve original index for CRC32 decision
@@ -189,5 +227,8 @@ NormalModeDecisions orchestrateNormalModeDecisions(const DashboardConfig& config
     result.crc32Action = determineCRC32Action(config, wakeReason, originalIndex);
     result.indexForCRC32 = originalIndex;
     
+    // Step 4: Skip decision - compares against the slot that will be DISPLAYED
+    result.unchangedSkip = determineUnchangedSkip(config, wakeReason, finalIndex, displayedSlot);
+    
     return result;
 }
@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include <time.h>
+#include <image_slot_table.h>
 
 // Include config types - path resolution depends on build context:
 // - Arduino: Uses "../config_manager.h" (real headers) via angle brackets from --build-property
@@ -23,11 +24,29 @@ struct ImageTargetDecision {
     const char* reason;         // Human-readable reason for this decision
 };
 
+/**
+ * @brief How image changes are detected
+ */
+enum ChangeDetectionStrategy {
+    CHANGE_STRATEGY_NONE,             // Change detection disabled - always download
+    CHANGE_STRATEGY_CRC32,            // Fetch <url>.crc32 sidecar, then download if changed
+    CHANGE_STRATEGY_CONDITIONAL_GET   // Single GET with If-None-Match / If-Modified-Since (304 = unchanged)
+};
+
 /**
  * @brief Decision structure for CRC32 check behavior
  */
 struct CRC32Decision {
     bool shouldCheck;           // Check CRC32 and potentially skip download (always fetch when enabled)
+    ChangeDetectionStrategy strategy;  // How to detect changes (validators are always collected when enabled)
+    const char* reason;         // Human-readable reason for this decision
+};
+
+/**
+ * @brief Decision structure for skipping an unchanged image
+ */
+struct SkipDecision {
+    bool allowSkip;             // Skip download + refresh if the target slot's content is unchanged
     const char* reason;         // Human-readable reason for this decision
 };
 
@@ -63,6 +82,10 @@ ImageTargetDecision determineImageTarget(const DashboardConfig& config,
 /**
  * @brief Determine whether to check CRC32 for download optimization
  * 
+ * The strategy follows config.changeDetection. For CHANGE_STRATEGY_CONDITIONAL_GET,
+ * shouldCheck means "send the stored validators"; when false the request is
+ * unconditional but the response validators are still saved.
+ * 
  * @param config Dashboard configuration
  * @param wakeReason Why the device woke up (timer, button, etc.)
  * @param currentIndex Current carousel position (0-9)
@@ -72,6 +95,24 @@ CRC32Decision determineCRC32Action(const DashboardConfig& config,
                                    WakeupReason wakeReason, 
                                    uint8_t currentIndex);
 
+/**
+ * @brief Determine whether the download may be skipped when the target is unchanged
+ * 
+ * Skipping is only safe when the target slot's image is what the panel is
+ * showing right now - otherwise the screen would keep a different image.
+ * Manual wakes always refresh.
+ * 
+ * @param config Dashboard configuration
+ * @param wakeReason Why the device woke up (timer, button, etc.)
+ * @param targetIndex Slot that will be displayed (after any carousel advance)
+ * @param displayedSlot Slot currently on the panel (IMAGE_SLOT_NONE = unknown)
+ * @return SkipDecision with allowSkip flag and reason
+ */
+SkipDecision determineUnchangedSkip(const DashboardConfig& config,
+                                    WakeupReason wakeReason,
+                                    uint8_t targetIndex,
+                                    uint8_t displayedSlot);
+
 /**
  * @brief Determine how long to sleep until next wake
  * 
@@ -109,6 +150,7 @@ struct NormalModeDecisions {
     CRC32Decision crc32Action;
     uint8_t finalIndex;          // Final index to use (after potential advance)
     uint8_t indexForCRC32;       // Index that should be used for CRC32 check
+    SkipDecision unchangedSkip;  // Whether an unchanged target may skip download (uses finalIndex)
 };
 
 /**
@@ -124,10 +166,12 @@ struct NormalModeDecisions {
  * @param config Dashboard configuration
  * @param wakeReason Why the device woke up
  * @param currentIndex Current carousel position (0-9)
- * @return NormalModeDecisions with all three decisions
+ * @param displayedSlot Slot currently on the panel (IMAGE_SLOT_NONE = unknown, never skips)
+ * @return NormalModeDecisions with all decisions
  */
 NormalModeDecisions orchestrateNormalModeDecisions(const DashboardConfig& config,
                                                     WakeupReason wakeReason,
-                                                    uint8_t currentIndex);
+                                                    uint8_t currentIndex,
+                                                    uint8_t displayedSlot = IMAGE_SLOT_NONE);
 
 #endif // DECISION_LOGIC_H
@@ -2,17 +2,49 @@
 #include <src/modes/decision_logic.h>
 #include <WiFi.h>
 #include <src/frontlight_manager.h>
+#include <src/pipeline_task.h>
 
 // Error retry interval: how long to wait before retrying after image download failure
 // This prevents indefinite sleep when configured interval is 0 (button-only mode)
 const float ERROR_RETRY_INTERVAL_MINUTES = 1.0;
 
+// Overlay update time: current local time as HH:MM (empty when the overlay does not show it)
+static void formatUpdateTime(const DashboardConfig& config, char* out, size_t size) {
+    out[0] = '\0';
+    if (config.overlayEnabled && config.overlayShowUpdateTime) {
+        // Apply timezone offset (convert hours to seconds)
+        time_t currentTime = time(nullptr) + config.timezoneOffset * 3600;
+        struct tm* timeInfo = gmtime(&currentTime);  // Use gmtime since we already applied offset
+        strftime(out, size, "%H:%M", timeInfo);
+    }
+}
+
 NormalModeController::NormalModeController(Inkplate* disp, ConfigManager* config, WiFiManager* wifi,
                                            ImageManager* image, PowerManager* power, MQTTManager* mqtt,
-                                           UIStatus* uiStatus, UIError* uiError, uint8_t* stateIndex)
+                                           ClockManager* clock, UIStatus* uiStatus, UIError* uiError, uint8_t* stateIndex)
     : display(disp), configManager(config), wifiManager(wifi),
-      imageManager(image), powerManager(power), mqttManager(mqtt),
-      uiStatus(uiStatus), uiError(uiError), imageStateIndex(stateIndex) {
+      imageManager(image), powerManager(power), mqttManager(mqtt), clockManager(clock),
+      uiStatus(uiStatus), uiError(uiError), imageStateIndex(stateIndex),
+      energyStats(nullptr), wakesPerDay(0), telemetryBusy(false),
+      telemetryBacklog(nullptr), telemetryDeferred(false), prefetchIndex(nullptr) {
+}
+
+void NormalModeController::setEnergyStats(EnergyStats* stats) {
+    energyStats = stats;
+}
+
+void NormalModeController::setTelemetryBacklog(TelemetryBacklog* backlog) {
+    telemetryBacklog = backlog;
+    if (telemetryBacklog != nullptr && !isTelemetryBacklogValid(*telemetryBacklog)) {
+        initTelemetryBacklog(*telemetryBacklog);
+    }
+}
+
+void NormalModeController::setPrefetchIndex(PrefetchIndex* index) {
+    prefetchIndex = index;
+    if (prefetchIndex != nullptr && !isPrefetchIndexValid(*prefetchIndex)) {
+        initPrefetchIndex(*prefetchIndex);
+    }
 }
 
 void NormalModeController::execute(float batteryVoltage, int batteryPercentage) {
@@ -23,6 +55,10 @@ void NormalModeController::execute(float batteryVoltage, int batteryPercentage)
      * HIGH-LEVEL FLOW:
      * 1. Load config → 2. WiFi connect → 3. NTP sync → 4. Hourly check → 
      * 5. Image target → 6. CRC32 check → 7. Download → 8. Handle result → 9. Sleep
+     * (Carousel timer wakes whose target was prefetched: 1. Load config → display
+     *  from flash → sleep, no WiFi. Online wakes fetch the next slots after step 8.
+     *  Button wakes with change detection draw the target's cached image before
+     *  step 2 and then revalidate it: unchanged = skip, like a timer wake.)
      * 
      * KEY DECISION POINTS:
      * - Mode: Single or Carousel
@@ -30,6 +66,7 @@ void NormalModeController::execute(float batteryVoltage, int batteryPercentage)
      * - Stay: stay, advance [carousel only]
      * - CRC32: crc32on, crc32off
      * - CRC32 Result: crc32match, crc32changed [when enabled]
+     *   (HTTP conditional GET strategy: 304 = crc32match, 200 = crc32changed + download in one request)
      * - Download: downloadok, downloadfail
      * - Retry: retry0, retry1, retry2 [on failure]
      * 
@@ -77,6 +114,7 @@ void NormalModeController::execute(float batteryVoltage, int batteryPercentage)
      * 
      * ERROR RETRY LOGIC:
      * - Single image: 3 attempts (retry0→retry1→retry2), 20s between retries
+     * - Error screen only if the image cache has no recent copy of the slot
      * - Carousel first image (idx=0): same as single image
      * - Carousel other images: skip to next immediately (20s sleep)
      * 
@@ -93,10 +131,19 @@ void NormalModeController::execute(float batteryVoltage, int batteryPercentage)
     LoopTimings timings;
     uint32_t timerStart;
     
-    DashboardConfig config;
-    if (!loadConfiguration(config)) {
+    if (!loadConfiguration()) {
         return;
     }
+    const DashboardConfig& config = configManager->getConfig();
+    wakesPerDay = calculateWakesPerDay(config.imageIntervals, config.imageStay, config.imageCount, config.updateHours);
+    imageManager->setTlsFingerprint(config.tlsFingerprint.c_str());
+#ifndef DISPLAY_MODE_INKPLATE2
+    if (config.partialRefresh) {
+        // The library only supports partial updates in black/white mode
+        display->selectDisplayMode(INKPLATE_1BIT);
+    }
+#endif
+    imageManager->setPartialRefresh(config.partialRefresh, config.fullRefreshEvery);
     
     // Capture image retry count from RTC memory (only for single image mode)
     if (config.imageCount == 1) {
@@ -108,8 +155,8 @@ void NormalModeController::execute(float batteryVoltage, int batteryPercentage)
     // Collect telemetry data early (use passed battery values for consistency)
     String deviceId = wifiManager->getDeviceIdentifier();
     String deviceName;
-    if (config.friendlyName.length() > 0) {
-        deviceName = config.friendlyName;
+    if (!config.friendlyName.isEmpty()) {
+        deviceName = config.friendlyName.c_str();
     } else {
         String deviceNameSuffix = deviceId;
         if (deviceNameSuffix.startsWith("inkplate-")) {
@@ -119,48 +166,53 @@ void NormalModeController::execute(float batteryVoltage, int batteryPercentage)
     }
     WakeupReason wakeReason = powerManager->getWakeupReason();
     
-    // Connect to WiFi (measure timing)
-    timerStart = millis();
-    if (!wifiManager->connectToWiFi(&timings.wifi_retry_count)) {
-        handleWiFiFailure(config, loopStartTime);
+    // Carousel timer wake whose target image is in the prefetch cache: no WiFi at all
+    if (displayPrefetchedImage(config, wakeReason, loopStartTime, batteryVoltage, batteryPercentage)) {
         return;
     }
+    
+    // Button wake: show the target's cached image right away, the online part revalidates it
+    bool cachedRedisplay = redisplayCachedImage(config, wakeReason, loopStartTime, batteryVoltage);
+    
+    // Low battery: timer wakes skip MQTT and keep their telemetry for a later wake
+    telemetryDeferred = telemetryBacklog != nullptr &&
+                        shouldDeferTelemetry(*telemetryBacklog, batteryVoltage, batteryPercentage,
+                                             wakeReason != WAKEUP_TIMER);
+    
+    // Connect to WiFi (measure timing) - timer wakes already started association in setup()
+    timerStart = millis();
+    bool wifiConnected = wifiManager->connectToWiFi(&timings.wifi_retry_count);
     timings.wifi_ms = millis() - timerStart;
+    timings.wifi_early_ms = wifiManager->getEarlyConnectMs();
+    if (!wifiConnected) {
+        handleWiFiFailure(config, loopStartTime, batteryVoltage, batteryPercentage, timings);
+        return;
+    }
     
     int wifiRSSI = WiFi.RSSI();
     String wifiBSSID = WiFi.BSSIDstr();
     
-    // NTP sync (skip if all hours enabled for optimization)
+    // NTP sync (skip if all hours enabled, or while the clock is known to be accurate enough)
     bool allHoursEnabled = ConfigManager::areAllHoursEnabled(config.updateHours);
-    time_t now;
     
+    Logger::begin("NTP Time Sync");
     if (allHoursEnabled) {
-        Logger::begin("NTP Time Sync");
         Logger::line("Skipped - all 24 hours enabled");
-        Logger::end();
-        now = time(nullptr);
+        timings.ntp_ms = 0;
+    } else if (!clockManager->isSyncNeeded()) {
+        Logger::linef("Skipped - estimated clock error %lus", (unsigned long)clockManager->getEstimatedError());
         timings.ntp_ms = 0;
     } else {
         timerStart = millis();
-        configTime(0, 0, "pool.ntp.org", "time.nist.gov");
-        
-        Logger::begin("NTP Time Sync");
-        now = time(nullptr);
-        int ntpRetries = 0;
-        while (now < 24 * 3600 && ntpRetries < 70) {
-            delay(100);
-            now = time(nullptr);
-            ntpRetries++;
-        }
-        
-        if (now < 24 * 3600) {
-            Logger::line("WARNING: NTP sync timeout, using last known time");
-        } else {
+        if (clockManager->syncWithNtp()) {
             Logger::line("Time synced via NTP");
+        } else {
+            Logger::line("WARNING: NTP sync timeout, using last known time");
         }
-        Logger::end();
         timings.ntp_ms = millis() - timerStart;
     }
+    Logger::end();
+    time_t now = time(nullptr);
     
     // Hourly schedule check (only enforce on timer wake)
     struct tm* timeinfo = localtime(&now);
@@ -202,7 +254,10 @@ void NormalModeController::execute(float batteryVoltage, int batteryPercentage)
     
     // DECISION ORCHESTRATION: Use tested orchestration function to ensure correct behavior
     uint8_t currentIndex = *imageStateIndex % config.imageCount;
-    NormalModeDecisions decisions = orchestrateNormalModeDecisions(config, wakeReason, currentIndex);
+    ImageSlotTable slotTable;
+    configManager->getImageSlotTable(slotTable);
+    pruneImageSlots(slotTable, config.imageCount);
+    NormalModeDecisions decisions = orchestrateNormalModeDecisions(config, wakeReason, currentIndex, slotTable.displayedSlot);
     
     Logger::begin(config.isCarouselMode() ? "Carousel Mode" : "Single Image Mode");
     Logger::linef("Decision: %s", decisions.imageTarget.reason);
@@ -216,7 +271,7 @@ void NormalModeController::execute(float batteryVoltage, int batteryPercentage)
         currentIndex = decisions.finalIndex;
     }
     
-    String currentImageUrl = config.imageUrls[currentIndex];
+    const char* currentImageUrl = config.imageUrls[currentIndex].c_str();
     int currentInterval = config.imageIntervals[currentIndex];
     
     if (currentInterval < 0) {
@@ -224,7 +279,7 @@ void NormalModeController::execute(float batteryVoltage, int batteryPercentage)
         currentInterval = DEFAULT_INTERVAL_MINUTES;
     }
     
-    Logger::line("URL: " + currentImageUrl);
+    Logger::linef("URL: %s", currentImageUrl);
     if (currentInterval == 0) {
         Logger::line("Button-only wake mode (interval = 0)");
     } else {
@@ -237,20 +292,45 @@ void NormalModeController::execute(float batteryVoltage, int batteryPercentage)
     
     Logger::begin("CRC32 Check Decision");
     Logger::linef("Decision: %s", crc32Decision.reason);
+    if (crc32Decision.strategy == CHANGE_STRATEGY_CONDITIONAL_GET) {
+        Logger::line("Strategy: HTTP conditional GET (ETag / Last-Modified)");
+    }
+    Logger::linef("Skip: %s", decisions.unchangedSkip.reason);
+    if (cachedRedisplay) {
+        Logger::line("Cached image on screen - revalidating (skip if unchanged)");
+    }
     Logger::end();
     
+    // Skipping is decided per slot: only when the target slot is on screen
+    // and unchanged since it was shown (works for every carousel slot).
+    // A button wake that drew the cached image is on screen by now as well.
+    bool allowSkip = decisions.unchangedSkip.allowSkip || cachedRedisplay;
     uint32_t newCRC32 = 0;
     bool crc32Matched = false;
     
-    if (config.useCRC32Check) {
-        // Always fetch CRC32 when enabled (for saving to storage)
+    // Conditional GET: change check and download are a single request, so there
+    // is no separate CRC32 phase - stored validators are only sent when skipping is allowed
+    bool useConditionalGet = (crc32Decision.strategy == CHANGE_STRATEGY_CONDITIONAL_GET);
+    ConditionalRequest conditional;
+    if (useConditionalGet && allowSkip) {
+        configManager->getImageValidators(currentIndex, conditional.etag, conditional.lastModified);
+    }
+    
+    if (crc32Decision.strategy == CHANGE_STRATEGY_CRC32) {
+        // Always fetch CRC32 when enabled (for saving to the slot table)
         timerStart = millis();
-        bool shouldDownload = imageManager->checkCRC32Changed(currentImageUrl.c_str(), &newCRC32, &timings.crc_retry_count);
+        bool shouldDownload = imageManager->checkCRC32Changed(currentImageUrl, getSlotCRC32(slotTable, currentIndex),
+                                                              &newCRC32, &timings.crc_retry_count);
         timings.crc_ms = millis() - timerStart;
+        captureConnectionStats(timings);
         crc32Matched = !shouldDownload;
         
-        // Only skip download if we're checking AND it matched
-        if (crc32Decision.shouldCheck && wakeReason == WAKEUP_TIMER && crc32Matched) {
+        // Only skip download if the target is on screen AND it matched
+        if (allowSkip && crc32Matched) {
+            // No image request follows - release the kept-alive connection
+            imageManager->closeConnection();
+            imageManager->confirmCachedImage(currentIndex, currentImageUrl, newCRC32, nullptr);
+            
             // CRC32 matched on timer wake - skip download and sleep
             float loopTimeSeconds = (millis() - loopStartTime) / 1000.0;
             unsigned long loopTimeMs = millis() - loopStartTime;
@@ -270,29 +350,56 @@ void NormalModeController::execute(float batteryVoltage, int batteryPercentage)
     
     // Download and display image
     // Prepare overlay parameters (if overlay is enabled)
-    char updateTimeStr[16] = "";
-    if (config.overlayEnabled && config.overlayShowUpdateTime) {
-        // Format current time as HH:MM with timezone offset applied
-        time_t currentTime = time(nullptr);
-        // Apply timezone offset (convert hours to seconds)
-        currentTime += (config.timezoneOffset * 3600);
-        struct tm* timeInfo = gmtime(&currentTime);  // Use gmtime since we already applied offset
-        strftime(updateTimeStr, sizeof(updateTimeStr), "%H:%M", timeInfo);
-    }
+    char updateTimeStr[16];
+    formatUpdateTime(config, updateTimeStr, sizeof(updateTimeStr));
     
     unsigned long cycleTimeMs = (config.overlayEnabled && config.overlayShowCycleTime) 
                                 ? (millis() - loopStartTime) : 0;
     
+    // The panel refresh of a new image runs in handleImageSuccess(), overlapped with the MQTT connect
+    imageManager->setDeferRefresh(true);
+    imageManager->setCacheSlot(currentIndex, crc32Decision.strategy == CHANGE_STRATEGY_CRC32 ? newCRC32 : 0);
+    
     timerStart = millis();
-    bool success = imageManager->downloadAndDisplay(currentImageUrl.c_str(), 
+    bool success = imageManager->downloadAndDisplay(currentImageUrl, 
                                                     batteryVoltage,
                                                     updateTimeStr,
-                                                    cycleTimeMs);
-    timings.image_ms = millis() - timerStart;
+                                                    cycleTimeMs,
+                                                    useConditionalGet ? &conditional : nullptr);
+    timings.image_ms = millis() - timerStart;  // Refresh time is added once it has run
+    captureConnectionStats(timings);
+    
+    if (success && useConditionalGet) {
+        if (conditional.notModified) {
+            // 304 on timer wake - same outcome as a CRC32 match, without the extra request
+            imageManager->confirmCachedImage(currentIndex, currentImageUrl, 0, &conditional);
+            float loopTimeSeconds = (millis() - loopStartTime) / 1000.0;
+            unsigned long loopTimeMs = millis() - loopStartTime;
+            
+            publishMQTTTelemetry(deviceId, deviceName, wakeReason, batteryVoltage, batteryPercentage, wifiRSSI, loopTimeSeconds,
+                               configManager->getLastCRC32(), wifiBSSID, timings, "Image unchanged (HTTP 304)", "info");
+            
+            powerManager->disableWatchdog();
+            powerManager->prepareForSleep();
+            
+            SleepDecision sleepDecision = determineSleepDuration(config, now, currentIndex, true);
+            powerManager->enterDeepSleep(sleepDecision.sleepSeconds, loopTimeMs / 1000.0f);
+            return;
+        }
+        // Deferred like CRC32: validators are only stored after a successful display
+        configManager->setImageValidators(currentIndex, conditional.etag, conditional.lastModified);
+    }
+    
+    if (success) {
+        // Record what is on screen now (CRC32 unknown for the conditional GET strategy)
+        recordSlotDisplayed(slotTable, currentIndex,
+                            crc32Decision.strategy == CHANGE_STRATEGY_CRC32 ? newCRC32 : 0);
+        configManager->setImageSlotTable(slotTable);
+    }
     
     // DECISION POINT 3: Handle result (success or failure)
     if (success) {
-        handleImageSuccess(config, newCRC32, crc32Decision.shouldCheck, crc32Matched, loopStartTime, now, 
+        handleImageSuccess(config, crc32Decision.shouldCheck, crc32Matched, loopStartTime, now, 
                           deviceId, deviceName, wakeReason, batteryVoltage, batteryPercentage, wifiRSSI, wifiBSSID, timings);
     } else {
         handleImageFailure(config, loopStartTime, now, deviceId, deviceName, wakeReason, 
@@ -300,8 +407,8 @@ void NormalModeController::execute(float batteryVoltage, int batteryPercentage)
     }
 }
 
-bool NormalModeController::loadConfiguration(DashboardConfig& config) {
-    if (configManager->loadConfig(config)) {
+bool NormalModeController::loadConfiguration() {
+    if (configManager->loadConfig()) {
         return true;
     }
     
@@ -338,31 +445,361 @@ int NormalModeController::calculateSleepUntilNextEnabledHour(uint8_t currentHour
     return -1;
 }
 
+void NormalModeController::captureConnectionStats(LoopTimings& timings) {
+    const TlsStats& tls = imageManager->getTlsStats();
+    timings.tls_full_count = tls.fullHandshakes;
+    timings.tls_resumed_count = tls.resumedHandshakes;
+    timings.tls_ms = tls.handshakeMs;
+    
+    const HttpConnectionStats& http = imageManager->getConnectionStats();
+    timings.http_request_count = http.requests;
+    timings.http_reused_count = http.reused;
+}
+
 void NormalModeController::publishMQTTTelemetry(const String& deviceId, const String& deviceName, 
                                                 WakeupReason wakeReason, float batteryVoltage, 
                                                 int batteryPercentage, int wifiRSSI, float loopTimeSeconds,
                                                 uint32_t imageCRC32, const String& wifiBSSID, 
                                                 const LoopTimings& timings, const char* message, const char* severity) {
-    if (mqttManager->begin() && mqttManager->isConfigured()) {
-        mqttManager->publishAllTelemetry(deviceId, deviceName, BOARD_NAME, wakeReason,
+    float cycleChargeMah = -1;
+    BatteryProjection projection = updateEnergyModel(loopTimeSeconds, batteryPercentage, timings, &cycleChargeMah);
+    float batteryDays = (batteryVoltage > 0 && projection.daysFullBattery > 0) ? projection.daysRemaining : -1;
+    
+    if (telemetryBusy) {
+        Logger::message("MQTT", "Connect still running on the other core - telemetry kept in backlog");
+        recordTelemetryBacklog(batteryVoltage, batteryPercentage, wifiRSSI, loopTimeSeconds, timings, severity);
+        return;
+    }
+    
+    // begin() already ran if the connection was opened during the panel refresh
+    bool ready = mqttManager->isConfigured() || mqttManager->begin();
+    if (ready && mqttManager->isConfigured()) {
+        if (telemetryDeferred) {
+            Logger::messagef("MQTT", "Low battery (%d%%) - telemetry deferred to backlog", batteryPercentage);
+            recordTelemetryBacklog(batteryVoltage, batteryPercentage, wifiRSSI, loopTimeSeconds, timings, severity);
+            return;
+        }
+        
+        // A successful session also flushes the backlog
+        bool published = mqttManager->publishAllTelemetry(deviceId, deviceName, BOARD_NAME, wakeReason,
                                         batteryVoltage, batteryPercentage, wifiRSSI, loopTimeSeconds, imageCRC32, 
                                         message, severity, wifiBSSID,
                                         timings.wifiSeconds(), timings.ntpSeconds(), 
                                         timings.crcSeconds(), timings.imageSeconds(),
-                                        timings.wifi_retry_count, timings.crc_retry_count, timings.image_retry_count);
+                                        timings.wifi_retry_count, timings.crc_retry_count, timings.image_retry_count,
+                                        timings.tls_full_count, timings.tls_resumed_count, timings.http_reused_count,
+                                        cycleChargeMah, batteryDays, timings.wifiEarlySeconds());
+        if (!published) {
+            recordTelemetryBacklog(batteryVoltage, batteryPercentage, wifiRSSI, loopTimeSeconds, timings, severity);
+        }
     }
 }
 
-void NormalModeController::handleImageSuccess(const DashboardConfig& config, uint32_t newCRC32,
+void NormalModeController::recordTelemetryBacklog(float batteryVoltage, int batteryPercentage, int wifiRSSI,
+                                                  float loopTimeSeconds, const LoopTimings& timings,
+                                                  const char* severity) {
+    if (telemetryBacklog == nullptr) {
+        return;
+    }
+    
+    TelemetryRecord record;
+    time_t now = time(nullptr);
+    record.timestamp = now > 24 * 3600 ? (uint32_t)now : 0;  // 0 = clock never set
+    record.loopMs = (uint32_t)(loopTimeSeconds * 1000.0f);
+    record.wifiMs = timings.wifi_ms;
+    record.ntpMs = timings.ntp_ms;
+    record.crcMs = timings.crc_ms;
+    record.imageMs = timings.image_ms;
+    record.batteryMillivolts = batteryVoltage > 0 ? (uint16_t)(batteryVoltage * 1000.0f + 0.5f) : 0;
+    record.batteryPercentage = batteryVoltage > 0 ? (int8_t)batteryPercentage : -1;
+    record.wifiRSSI = (int8_t)constrain(wifiRSSI, -128, 0);
+    record.wifiRetries = timings.wifi_retry_count;
+    record.crcRetries = timings.crc_retry_count;
+    record.imageRetries = timings.image_retry_count;
+    if (severity != nullptr && strcmp(severity, "error") == 0) {
+        record.result = TELEMETRY_RESULT_ERROR;
+    } else if (severity != nullptr && strcmp(severity, "warning") == 0) {
+        record.result = TELEMETRY_RESULT_WARNING;
+    } else {
+        record.result = timings.display_ms > 0 ? TELEMETRY_RESULT_DISPLAYED : TELEMETRY_RESULT_UNCHANGED;
+    }
+    
+    bool dropped = pushTelemetryRecord(*telemetryBacklog, record);
+    Logger::messagef("Telemetry Backlog", "Wake recorded (%u/%u)%s", (unsigned)telemetryBacklog->count,
+                     (unsigned)TELEMETRY_BACKLOG_CAPACITY, dropped ? ", oldest dropped" : "");
+}
+
+BatteryProjection NormalModeController::updateEnergyModel(float loopTimeSeconds, int batteryPercentage,
+                                                          const LoopTimings& timings, float* outCycleMah) {
+    BatteryProjection projection = {};
+    if (energyStats == nullptr) {
+        return projection;
+    }
+    
+    // Time before execute() started (reset, setup, config load) is the boot phase
+    uint32_t loopMs = (uint32_t)(loopTimeSeconds * 1000.0f);
+    uint32_t nowMs = millis();
+    uint32_t bootMs = nowMs > loopMs ? nowMs - loopMs : 0;
+    
+    // An early WiFi start ran the radio during the boot phase: count that time as WiFi
+    uint32_t earlyMs = timings.wifi_early_ms < bootMs ? timings.wifi_early_ms : bootMs;
+    CyclePhases phases = buildCyclePhases(bootMs - earlyMs, loopMs + earlyMs, timings.wifi_ms + earlyMs,
+                                          timings.ntp_ms, timings.crc_ms, timings.image_ms, timings.tls_ms,
+                                          timings.display_ms);
+    PowerProfile profile = PowerManager::getPowerProfile();
+    float cycleMah = estimateCycleCharge(profile, phases);
+    updateEnergyStats(*energyStats, cycleMah, getCycleAwakeMs(phases) / 1000.0f);
+    projection = projectBatteryLife(profile, energyStats->avgCycleMah, energyStats->avgAwakeSeconds,
+                                    wakesPerDay, batteryPercentage);
+    
+    Logger::begin("Battery Life Model");
+    Logger::linef("This wake: %.3f mAh (%u ms awake, %u ms refresh)", cycleMah,
+                  (unsigned)getCycleAwakeMs(phases), (unsigned)phases.refresh_ms);
+    Logger::linef("Average: %.3f mAh over %u wakes, %.1f wakes/day", energyStats->avgCycleMah,
+                  (unsigned)energyStats->cycles, wakesPerDay);
+    Logger::linef("%.1f mAh/day, %.0f days from full, %.0f days remaining", projection.mahPerDay,
+                  projection.daysFullBattery, projection.daysRemaining);
+    Logger::end();
+    
+    if (outCycleMah != nullptr) {
+        *outCycleMah = cycleMah;
+    }
+    return projection;
+}
+
+namespace {
+
+struct TelemetryOpenArgs {
+    MQTTManager* mqtt;
+    const String* deviceId;
+    const String* deviceName;
+    WakeupReason wakeReason;
+};
+
+void refreshStage(void* arg) {
+    static_cast<ImageManager*>(arg)->completePendingRefresh();
+}
+
+void telemetryOpenStage(void* arg) {
+    TelemetryOpenArgs* args = static_cast<TelemetryOpenArgs*>(arg);
+    args->mqtt->openTelemetry(*args->deviceId, *args->deviceName, BOARD_NAME, args->wakeReason);
+}
+
+}  // namespace
+
+void NormalModeController::refreshWithTelemetry(const String& deviceId, const String& deviceName,
+                                                WakeupReason wakeReason, LoopTimings& timings) {
+    if (!imageManager->hasPendingRefresh()) {
+        return;
+    }
+    
+    // The refresh is CPU/IO-bound on the EPD driver and the MQTT connect is
+    // network-bound: open the broker connection on the other core meanwhile.
+    // The state messages are sent afterwards so they carry the final timings.
+    // Static: a connect that outlasts the join timeout still references them
+    static FreeRTOSTaskRunner runner;
+    static CyclePipeline pipeline(&runner);
+    static TelemetryOpenArgs args;
+    args = { mqttManager, &deviceId, &deviceName, wakeReason };
+    bool overlap = !telemetryDeferred && mqttManager->begin() && mqttManager->isConfigured();
+    
+    PipelineResult result = pipeline.run(refreshStage, imageManager,
+                                         overlap ? telemetryOpenStage : nullptr, &args);
+    telemetryBusy = result.timedOut;
+    
+    timings.display_ms = imageManager->getLastRefreshMs();
+    timings.image_ms += result.foreground_ms;  // Keeps image_ms including the refresh
+    
+    if (result.overlapped) {
+        Logger::messagef("Cycle Pipeline", "Refresh %u ms, MQTT connect %u ms on the other core - saved %u ms%s",
+                         (unsigned)result.foreground_ms, (unsigned)result.background_ms,
+                         (unsigned)getPipelineSavedMs(result), result.timedOut ? " (connect timed out)" : "");
+    }
+}
+
+bool NormalModeController::displayPrefetchedImage(const DashboardConfig& config, WakeupReason wakeReason,
+                                                  unsigned long loopStartTime, float batteryVoltage,
+                                                  int batteryPercentage) {
+    if (prefetchIndex == nullptr || wakeReason != WAKEUP_TIMER || !config.isCarouselMode() ||
+        !hasPrefetchedImages(*prefetchIndex)) {
+        return false;
+    }
+    
+    // Disabled hours are left to the online path (it sleeps until the next enabled hour)
+    time_t now = time(nullptr);
+    if (!ConfigManager::areAllHoursEnabled(config.updateHours)) {
+        struct tm* timeinfo = localtime(&now);
+        int currentHour = ConfigManager::applyTimezoneOffset(timeinfo->tm_hour, config.timezoneOffset);
+        if (!ConfigManager::isHourEnabledInBitmask(currentHour, config.updateHours)) {
+            return false;
+        }
+    }
+    
+    // Same target as the online path would pick
+    uint8_t currentIndex = *imageStateIndex % config.imageCount;
+    ImageSlotTable slotTable;
+    configManager->getImageSlotTable(slotTable);
+    pruneImageSlots(slotTable, config.imageCount);
+    NormalModeDecisions decisions = orchestrateNormalModeDecisions(config, wakeReason, currentIndex, slotTable.displayedSlot);
+    uint8_t targetIndex = decisions.imageTarget.shouldAdvance ? decisions.finalIndex : currentIndex;
+    PrefetchDisplayDecision decision = decidePrefetchDisplay(*prefetchIndex, targetIndex,
+                                                             prefetchUrlHash(config.imageUrls[targetIndex].c_str()),
+                                                             slotTable.displayedSlot, (uint32_t)now);
+    
+    Logger::begin("Prefetch Cache");
+    Logger::linef("Target image: %d of %d", targetIndex + 1, config.imageCount);
+    Logger::linef("Decision: %s", decision.reason);
+    Logger::end();
+    if (!decision.useCache) {
+        return false;
+    }
+    
+    char updateTimeStr[16];
+    formatUpdateTime(config, updateTimeStr, sizeof(updateTimeStr));
+    unsigned long cycleTimeMs = (config.overlayEnabled && config.overlayShowCycleTime)
+                                ? (millis() - loopStartTime) : 0;
+    
+    LoopTimings timings;
+    ConditionalRequest validators;
+    unsigned long timerStart = millis();
+    bool success = imageManager->displayPrefetched(targetIndex, batteryVoltage, updateTimeStr, cycleTimeMs, &validators);
+    timings.image_ms = millis() - timerStart;
+    timings.display_ms = imageManager->getLastRefreshMs();
+    if (!success) {
+        Logger::message("Prefetch Cache", "Cached image unusable - connecting to WiFi");
+        return false;
+    }
+    
+    // The panel now shows the cached download: its validators describe the slot
+    // (CRC32 of the file unknown - the CRC32 strategy downloads it again when it stays)
+    *imageStateIndex = targetIndex;
+    recordSlotDisplayed(slotTable, targetIndex, 0);
+    configManager->setImageSlotTable(slotTable);
+    if (decisions.crc32Action.strategy == CHANGE_STRATEGY_CONDITIONAL_GET) {
+        configManager->setImageValidators(targetIndex, validators.etag, validators.lastModified);
+    }
+    
+    // No broker this wake: battery model and telemetry backlog (published by the next online wake)
+    float loopTimeSeconds = (millis() - loopStartTime) / 1000.0;
+    updateEnergyModel(loopTimeSeconds, batteryPercentage, timings, nullptr);
+    if (configManager->getMQTTBroker().length() > 0) {
+        recordTelemetryBacklog(batteryVoltage, batteryPercentage, 0, loopTimeSeconds, timings, "info");
+    }
+    
+    powerManager->disableWatchdog();
+    powerManager->prepareForSleep();
+    unsigned long loopTimeMs = millis() - loopStartTime;
+    SleepDecision sleepDecision = determineSleepDuration(config, now, targetIndex, false);
+    powerManager->enterDeepSleep(sleepDecision.sleepSeconds, loopTimeMs / 1000.0f);
+    return true;
+}
+
+bool NormalModeController::redisplayCachedImage(const DashboardConfig& config, WakeupReason wakeReason,
+                                                unsigned long loopStartTime, float batteryVoltage) {
+    // Only worth a refresh when the online part can confirm it and skip the download
+    if (wakeReason != WAKEUP_BUTTON || !config.useCRC32Check || config.imageCount == 0) {
+        return false;
+    }
+    
+    // Same target as the online path will pick (state is left alone, execute() advances it)
+    uint8_t currentIndex = *imageStateIndex % config.imageCount;
+    ImageSlotTable slotTable;
+    configManager->getImageSlotTable(slotTable);
+    pruneImageSlots(slotTable, config.imageCount);
+    NormalModeDecisions decisions = orchestrateNormalModeDecisions(config, wakeReason, currentIndex, slotTable.displayedSlot);
+    uint8_t targetIndex = decisions.imageTarget.shouldAdvance ? decisions.finalIndex : currentIndex;
+    ImageCacheDisplayDecision decision = imageManager->checkImageCache(targetIndex, config.imageUrls[targetIndex].c_str(),
+                                                                       slotTable.displayedSlot,
+                                                                       IMAGE_CACHE_REDISPLAY_MAX_AGE_SECONDS);
+    
+    Logger::begin("Image Cache");
+    Logger::linef("Target image: %d of %d", targetIndex + 1, config.imageCount);
+    Logger::linef("Decision: %s", decision.reason);
+    Logger::end();
+    if (decision.lookup != IMAGE_CACHE_SHOW) {
+        return false;
+    }
+    
+    char updateTimeStr[16];
+    formatUpdateTime(config, updateTimeStr, sizeof(updateTimeStr));
+    unsigned long cycleTimeMs = (config.overlayEnabled && config.overlayShowCycleTime)
+                                ? (millis() - loopStartTime) : 0;
+    
+    ConditionalRequest validators;
+    uint32_t cachedCRC32 = 0;
+    if (!imageManager->displayCached(targetIndex, batteryVoltage, updateTimeStr, cycleTimeMs, &validators, &cachedCRC32)) {
+        Logger::message("Image Cache", "Cached image unusable - downloading");
+        return false;
+    }
+    
+    // The panel shows the cached file: its CRC32 / validators are what the server is asked about
+    recordSlotDisplayed(slotTable, targetIndex, cachedCRC32);
+    configManager->setImageSlotTable(slotTable);
+    if (decisions.crc32Action.strategy == CHANGE_STRATEGY_CONDITIONAL_GET) {
+        configManager->setImageValidators(targetIndex, validators.etag, validators.lastModified);
+    }
+    
+    #if defined(HAS_FRONTLIGHT) && HAS_FRONTLIGHT == true
+    if (config.frontlightDuration > 0) {
+        extern FrontlightManager frontlightManager;
+        unsigned long durationMs = config.frontlightDuration * 1000UL;
+        frontlightManager.turnOn(config.frontlightBrightness, durationMs);
+    }
+    #endif
+    return true;
+}
+
+bool NormalModeController::recoverFromImageCache(const DashboardConfig& config, uint8_t slot,
+                                                 unsigned long loopStartTime, float batteryVoltage) {
+    ImageSlotTable slotTable;
+    configManager->getImageSlotTable(slotTable);
+    ImageCacheDisplayDecision decision = imageManager->checkImageCache(slot, config.imageUrls[slot].c_str(),
+                                                                       slotTable.displayedSlot,
+                                                                       IMAGE_CACHE_MAX_STALE_SECONDS);
+    Logger::messagef("Image Cache", "Last good image: %s", decision.reason);
+    if (decision.lookup == IMAGE_CACHE_ON_SCREEN) {
+        return true;  // Still on the panel - keep it instead of the error screen
+    }
+    if (decision.lookup != IMAGE_CACHE_SHOW) {
+        return false;
+    }
+    
+    char updateTimeStr[16];
+    formatUpdateTime(config, updateTimeStr, sizeof(updateTimeStr));
+    unsigned long cycleTimeMs = (config.overlayEnabled && config.overlayShowCycleTime)
+                                ? (millis() - loopStartTime) : 0;
+    
+    // The failed download left the refresh deferred - this one runs right away
+    imageManager->setDeferRefresh(false);
+    ConditionalRequest validators;
+    if (!imageManager->displayCached(slot, batteryVoltage, updateTimeStr, cycleTimeMs, &validators, nullptr)) {
+        return false;
+    }
+    // CRC32 / validators are cleared by the caller, so the next wake downloads it again
+    recordSlotDisplayed(slotTable, slot, 0);
+    configManager->setImageSlotTable(slotTable);
+    return true;
+}
+
+void NormalModeController::prefetchNextImages(const DashboardConfig& config, LoopTimings& timings) {
+    if (prefetchIndex == nullptr) {
+        return;
+    }
+    // Also runs with prefetch off or in single image mode: plans nothing and evicts what is cached
+    unsigned long timerStart = millis();
+    uint8_t currentIndex = config.imageCount > 0 ? *imageStateIndex % config.imageCount : 0;
+    imageManager->prefetchImages(config, currentIndex);
+    timings.image_ms += millis() - timerStart;
+    captureConnectionStats(timings);
+}
+
+void NormalModeController::handleImageSuccess(const DashboardConfig& config,
                                               bool crc32WasChecked, bool crc32Matched,
                                               unsigned long loopStartTime, time_t currentTime, const String& deviceId,
                                               const String& deviceName, WakeupReason wakeReason,
                                               float batteryVoltage, int batteryPercentage, int wifiRSSI,
-                                              const String& wifiBSSID, const LoopTimings& timings) {
-    // Save CRC32 if it changed
-    if (config.useCRC32Check && crc32WasChecked && !crc32Matched && newCRC32 != 0) {
-        imageManager->saveCRC32(newCRC32);
-    }
+                                              const String& wifiBSSID, LoopTimings timings) {
+    refreshWithTelemetry(deviceId, deviceName, wakeReason, timings);
     
     // Handle carousel vs single image mode
     if (config.isCarouselMode()) {
@@ -383,6 +820,10 @@ void NormalModeController::handleImageSuccess(const DashboardConfig& config, uin
         publishMQTTTelemetry(deviceId, deviceName, wakeReason, batteryVoltage, batteryPercentage, wifiRSSI, loopTimeSeconds,
                            configManager->getLastCRC32(), wifiBSSID, timings, "Carousel image displayed successfully", "info");
         
+        // WiFi is still up: fetch what the next timer wakes will show. Runs after the
+        // publish, as the session opened during the refresh would time out meanwhile
+        prefetchNextImages(config, timings);
+        
         powerManager->disableWatchdog();
         powerManager->prepareForSleep();
         unsigned long loopTimeMs = millis() - loopStartTime;
@@ -415,6 +856,10 @@ void NormalModeController::handleImageSuccess(const DashboardConfig& config, uin
         publishMQTTTelemetry(deviceId, deviceName, wakeReason, batteryVoltage, batteryPercentage, wifiRSSI, loopTimeSeconds,
                            configManager->getLastCRC32(), wifiBSSID, timings, logMessage, "info");
         
+        // WiFi is still up: fetch what the next timer wakes will show. Runs after the
+        // publish, as the session opened during the refresh would time out meanwhile
+        prefetchNextImages(config, timings);
+        
         powerManager->disableWatchdog();
         powerManager->prepareForSleep();
         unsigned long loopTimeMs = millis() - loopStartTime;
@@ -431,6 +876,9 @@ void NormalModeController::handleImageFailure(const DashboardConfig& config,
                                               const String& wifiBSSID, const LoopTimings& timings) {
     uint8_t currentIndex = *imageStateIndex % config.imageCount;
     
+    // A reused lease or cached address may be stale: DHCP and DNS afresh next wake
+    wifiManager->invalidateNetworkCache();
+    
     // Carousel mode: check if first image (special retry logic) or other image (skip to next)
     if (config.isCarouselMode()) {
         if (currentIndex == 0) {
@@ -439,8 +887,8 @@ void NormalModeController::handleImageFailure(const DashboardConfig& config,
                 (*imageStateIndex)++;
                 Logger::messagef("Carousel Error", "First image failed, retry attempt %d of 2", *imageStateIndex);
                 
-                // Clear stored CRC32 to force download on next retry
-                configManager->setLastCRC32(0);
+                // Clear stored CRC32 / validators to force download on next retry
+                invalidateImageSlot(currentIndex, false);
                 
                 powerManager->disableWatchdog();
                 powerManager->prepareForSleep();
@@ -451,16 +899,22 @@ void NormalModeController::handleImageFailure(const DashboardConfig& config,
                 Logger::message("Carousel Error", "First image failed after retries, moving to next");
                 
                 *imageStateIndex = 1;  // Move to second image
-                String currentImageUrl = config.imageUrls[currentIndex];
-                uiError->showImageError(currentImageUrl.c_str(), imageManager->getLastError());
+                String imageError = imageManager->getLastError();
+                bool recovered = recoverFromImageCache(config, currentIndex, loopStartTime, batteryVoltage);
+                if (!recovered) {
+                    uiError->showImageError(config.imageUrls[currentIndex].c_str(), imageError.c_str());
+                }
                 
                 float loopTimeSeconds = (millis() - loopStartTime) / 1000.0;
-                String errorMessage = "First carousel image failed: " + String(imageManager->getLastError());
+                String errorMessage = "First carousel image failed: " + imageError;
+                if (recovered) {
+                    errorMessage += " - showing last good image";
+                }
                 publishMQTTTelemetry(deviceId, deviceName, wakeReason, batteryVoltage, batteryPercentage, wifiRSSI, loopTimeSeconds,
                                    configManager->getLastCRC32(), wifiBSSID, timings, errorMessage.c_str(), "error");
                 
-                // Clear stored CRC32
-                configManager->setLastCRC32(0);
+                // Clear stored CRC32 / validators (and the screen, unless the cached image is on it)
+                invalidateImageSlot(currentIndex, !recovered);
                 
                 delay(3000);
                 powerManager->disableWatchdog();
@@ -489,8 +943,8 @@ void NormalModeController::handleImageFailure(const DashboardConfig& config,
         if (*imageStateIndex < 2) {
             (*imageStateIndex)++;
             
-            // Clear stored CRC32 to force download on next retry
-            configManager->setLastCRC32(0);
+            // Clear stored CRC32 / validators to force download on next retry
+            invalidateImageSlot(currentIndex, false);
             
             powerManager->disableWatchdog();
             powerManager->prepareForSleep();
@@ -498,16 +952,23 @@ void NormalModeController::handleImageFailure(const DashboardConfig& config,
             powerManager->enterDeepSleep(20.0f, loopTimeMs / 1000.0f);
         } else {
             *imageStateIndex = 0;
-            String firstUrl = (config.imageCount > 0) ? config.imageUrls[0] : "";
-            uiError->showImageError(firstUrl.c_str(), imageManager->getLastError());
+            String imageError = imageManager->getLastError();
+            bool recovered = recoverFromImageCache(config, currentIndex, loopStartTime, batteryVoltage);
+            if (!recovered) {
+                uiError->showImageError(config.imageUrls[0].c_str(), imageError.c_str());
+            }
             
             float loopTimeSeconds = (millis() - loopStartTime) / 1000.0;
-            String errorMessage = "Image download failed: " + String(imageManager->getLastError());
+            String errorMessage = "Image download failed: " + imageError;
+            if (recovered) {
+                errorMessage += " - showing last good image";
+            }
             publishMQTTTelemetry(deviceId, deviceName, wakeReason, batteryVoltage, batteryPercentage, wifiRSSI, loopTimeSeconds,
                                configManager->getLastCRC32(), wifiBSSID, timings, errorMessage.c_str(), "error");
             
-            // Clear stored CRC32 to force download on next retry
-            configManager->setLastCRC32(0);
+            // Clear stored CRC32 / validators to force download on next retry
+            // (and the screen, unless the cached image is on it)
+            invalidateImageSlot(currentIndex, !recovered);
             
             delay(3000);
             
@@ -520,11 +981,27 @@ void NormalModeController::handleImageFailure(const DashboardConfig& config,
     }
 }
 
-void NormalModeController::handleWiFiFailure(const DashboardConfig& config, unsigned long loopStartTime) {
+void NormalModeController::invalidateImageSlot(uint8_t slot, bool screenReplaced) {
+    ImageSlotTable slotTable;
+    configManager->getImageSlotTable(slotTable);
+    invalidateSlot(slotTable, slot);
+    if (screenReplaced) {
+        clearDisplayedSlot(slotTable);
+    }
+    configManager->setImageSlotTable(slotTable);
+    configManager->clearImageValidators(slot);
+}
+
+void NormalModeController::handleWiFiFailure(const DashboardConfig& config, unsigned long loopStartTime,
+                                             float batteryVoltage, int batteryPercentage, const LoopTimings& timings) {
     uiError->showWiFiError(config.wifiSSID.c_str(), wifiManager->getStatusString().c_str());
+    configManager->clearDisplayedImageSlot();
     delay(3000);
     powerManager->disableWatchdog();
     powerManager->prepareForSleep();
     unsigned long loopTimeMs = millis() - loopStartTime;
+    if (configManager->getMQTTBroker().length() > 0) {
+        recordTelemetryBacklog(batteryVoltage, batteryPercentage, 0, loopTimeMs / 1000.0f, timings, "error");
+    }
     powerManager->enterDeepSleep(ERROR_RETRY_INTERVAL_MINUTES * 60.0f, loopTimeMs / 1000.0f);  // Convert minutes to seconds, ms to s
 }
@@ -7,16 +7,22 @@
 #include <src/image_manager.h>
 #include <src/power_manager.h>
 #include <src/mqtt_manager.h>
+#include <src/clock_manager.h>
 #include <src/ui/ui_status.h>
 #include <src/ui/ui_error.h>
 #include <src/logger.h>
 #include <src/modes/decision_logic.h>
+#include <src/energy_model.h>
+#include <src/cycle_pipeline.h>
+#include <src/telemetry_backlog.h>
+#include <src/prefetch_cache.h>
 
 /**
  * @brief Structure to hold loop timing breakdown measurements
  */
 struct LoopTimings {
     uint32_t wifi_ms = 0;
+    uint32_t wifi_early_ms = 0;     // Association started in setup() before the wait (not in wifi_ms)
     uint32_t ntp_ms = 0;
     uint32_t crc_ms = 0;
     uint32_t image_ms = 0;
@@ -26,8 +32,20 @@ struct LoopTimings {
     uint8_t crc_retry_count = 0;    // CRC32 check retries (0-2)
     uint8_t image_retry_count = 0;  // Image download retries (0-2, cross-sleep)
     
+    // HTTPS handshakes this cycle (resumed = abbreviated handshake from the RTC session cache)
+    uint8_t tls_full_count = 0;
+    uint8_t tls_resumed_count = 0;
+    uint32_t tls_ms = 0;            // Total connect + handshake time (included in crc_ms / image_ms)
+    
+    // HTTP requests this cycle and how many reused an open keep-alive connection
+    uint8_t http_request_count = 0;
+    uint8_t http_reused_count = 0;
+    
+    uint32_t display_ms = 0;        // Panel refresh (included in image_ms)
+    
     // Convert to seconds for MQTT publishing
     float wifiSeconds() const { return wifi_ms / 1000.0; }
+    float wifiEarlySeconds() const { return wifi_early_ms / 1000.0; }
     float ntpSeconds() const { return ntp_ms / 1000.0; }
     float crcSeconds() const { return crc_ms / 1000.0; }
     float imageSeconds() const { return image_ms / 1000.0; }
@@ -38,17 +56,18 @@ struct LoopTimings {
  * 
  * This controller manages the normal operation cycle:
  * - Connect to WiFi
+ * - Sync the clock (only when its estimated error is too large)
  * - Publish MQTT telemetry
  * - Check CRC32 (if enabled)
- * - Download and display image
- * - Handle retry mechanism
+ * - Download and display image (copied to the flash image cache)
+ * - Handle retry mechanism (last good image from the cache instead of the error screen)
  * - Enter deep sleep
  */
 class NormalModeController {
 public:
     NormalModeController(Inkplate* display, ConfigManager* config, WiFiManager* wifi,
                         ImageManager* image, PowerManager* power, MQTTManager* mqtt,
-                        UIStatus* uiStatus, UIError* uiError, uint8_t* stateIndex);
+                        ClockManager* clock, UIStatus* uiStatus, UIError* uiError, uint8_t* stateIndex);
     
     /**
      * @brief Execute normal update cycle
@@ -57,6 +76,25 @@ public:
      */
     void execute(float batteryVoltage, int batteryPercentage);
     
+    /**
+     * @brief Set the battery life averages (RTC memory) updated by every reported wake
+     */
+    void setEnergyStats(EnergyStats* stats);
+    
+    /**
+     * @brief Set the offline telemetry backlog (RTC memory) for wakes that could not publish
+     *
+     * Re-initialized when its contents are invalid (cold boot, layout change).
+     */
+    void setTelemetryBacklog(TelemetryBacklog* backlog);
+    
+    /**
+     * @brief Set the carousel prefetch index (RTC memory) - timer wakes show cached slots without WiFi
+     *
+     * Re-initialized when its contents are invalid (cold boot, layout change).
+     */
+    void setPrefetchIndex(PrefetchIndex* index);
+    
 private:
     Inkplate* display;
     ConfigManager* configManager;
@@ -64,17 +102,39 @@ private:
     ImageManager* imageManager;
     PowerManager* powerManager;
     MQTTManager* mqttManager;
+    ClockManager* clockManager;
     UIStatus* uiStatus;
     UIError* uiError;
     uint8_t* imageStateIndex;  // Pointer to RTC memory (carousel position or retry state)
+    EnergyStats* energyStats;  // Pointer to RTC memory (battery life averages, may be null)
+    float wakesPerDay;         // Timer wakes per day for the loaded configuration
+    bool telemetryBusy;        // MQTT connect outlasted the refresh and is still running on the other core
+    TelemetryBacklog* telemetryBacklog;  // Pointer to RTC memory (wakes not yet published, may be null)
+    bool telemetryDeferred;    // Low battery: this wake only records to the backlog
+    PrefetchIndex* prefetchIndex;  // Pointer to RTC memory (carousel images cached in flash, may be null)
     
     // Helper methods
-    bool loadConfiguration(DashboardConfig& config);
+    bool loadConfiguration();
     int calculateSleepUntilNextEnabledHour(uint8_t currentHour, const uint8_t updateHours[3]);
     void publishMQTTTelemetry(const String& deviceId, const String& deviceName, WakeupReason wakeReason, float batteryVoltage, int batteryPercentage, int wifiRSSI, float loopTimeSeconds, uint32_t imageCRC32, const String& wifiBSSID, const LoopTimings& timings, const char* message = nullptr, const char* severity = nullptr);
-    void handleImageSuccess(const DashboardConfig& config, uint32_t newCRC32, bool crc32WasChecked, bool crc32Matched, unsigned long loopStartTime, time_t currentTime, const String& deviceId, const String& deviceName, WakeupReason wakeReason, float batteryVoltage, int batteryPercentage, int wifiRSSI, const String& wifiBSSID, const LoopTimings& timings);
+    void handleImageSuccess(const DashboardConfig& config, bool crc32WasChecked, bool crc32Matched, unsigned long loopStartTime, time_t currentTime, const String& deviceId, const String& deviceName, WakeupReason wakeReason, float batteryVoltage, int batteryPercentage, int wifiRSSI, const String& wifiBSSID, LoopTimings timings);
     void handleImageFailure(const DashboardConfig& config, unsigned long loopStartTime, time_t currentTime, const String& deviceId, const String& deviceName, WakeupReason wakeReason, float batteryVoltage, int batteryPercentage, int wifiRSSI, const String& wifiBSSID, const LoopTimings& timings);
-    void handleWiFiFailure(const DashboardConfig& config, unsigned long loopStartTime);
+    void handleWiFiFailure(const DashboardConfig& config, unsigned long loopStartTime, float batteryVoltage, int batteryPercentage, const LoopTimings& timings);
+    void recordTelemetryBacklog(float batteryVoltage, int batteryPercentage, int wifiRSSI, float loopTimeSeconds,
+                                const LoopTimings& timings, const char* severity);  // Keep this wake for the next publish
+    void invalidateImageSlot(uint8_t slot, bool screenReplaced);  // Forget slot CRC32/validators after a failure
+    bool displayPrefetchedImage(const DashboardConfig& config, WakeupReason wakeReason, unsigned long loopStartTime,
+                                float batteryVoltage, int batteryPercentage);  // Offline wake from the prefetch cache
+    void prefetchNextImages(const DashboardConfig& config, LoopTimings& timings);  // Fetch the next slots while WiFi is up
+    bool redisplayCachedImage(const DashboardConfig& config, WakeupReason wakeReason, unsigned long loopStartTime,
+                              float batteryVoltage);  // Button wake: cached target at once, revalidated online
+    bool recoverFromImageCache(const DashboardConfig& config, uint8_t slot, unsigned long loopStartTime,
+                               float batteryVoltage);  // Last good image instead of the error screen
+    void captureConnectionStats(LoopTimings& timings);  // Copy TLS / keep-alive counters from the image manager
+    void refreshWithTelemetry(const String& deviceId, const String& deviceName, WakeupReason wakeReason,
+                              LoopTimings& timings);  // Panel refresh overlapped with the MQTT connect
+    BatteryProjection updateEnergyModel(float loopTimeSeconds, int batteryPercentage,
+                                        const LoopTimings& timings, float* outCycleMah);  // Fold this wake into the battery life model
 };
 
 #endif // NORMAL_MODE_CONTROLLER_H
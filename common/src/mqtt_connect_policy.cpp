@@ -0,0 +1,83 @@
+#include <mqtt_connect_policy.h>
+#include <string.h>
+
+#define TIMEOUT_LATENCY_FACTOR 3        // Socket timeout = slowest recent connect x 3
+
+void initMqttConnectStats(MqttConnectStats& stats) {
+    memset(&stats, 0, sizeof(stats));
+    stats.version = MQTT_CONNECT_STATS_VERSION;
+}
+
+bool isMqttConnectStatsValid(const MqttConnectStats& stats) {
+    return stats.version == MQTT_CONNECT_STATS_VERSION &&
+           stats.historyCount <= MQTT_CONNECT_HISTORY &&
+           stats.historyNext < MQTT_CONNECT_HISTORY &&
+           stats.skipRemaining <= MQTT_BACKOFF_MAX_SKIP;
+}
+
+uint32_t getMqttConnectLatencyEstimate(const MqttConnectStats& stats) {
+    uint32_t slowest = 0;
+    for (uint8_t i = 0; i < stats.historyCount && i < MQTT_CONNECT_HISTORY; i++) {
+        if (stats.latencyMs[i] > slowest) {
+            slowest = stats.latencyMs[i];
+        }
+    }
+    return slowest;
+}
+
+MqttConnectPlan planMqttConnect(const MqttConnectStats& stats, bool userWake) {
+    MqttConnectPlan plan;
+    plan.skip = !userWake && stats.skipRemaining > 0;
+    plan.budgetMs = MQTT_CYCLE_BUDGET_MS;
+
+    // Broker was down last time: one probe, unless the user is waiting for it
+    plan.attempts = (stats.failureStreak > 0 && !userWake) ? 1 : MQTT_CONNECT_MAX_ATTEMPTS;
+
+    uint32_t expectedMs = getMqttConnectLatencyEstimate(stats);
+    if (expectedMs == 0) {
+        plan.socketTimeoutS = MQTT_CONNECT_DEFAULT_TIMEOUT_S;
+        plan.retryDelayMs = MQTT_CONNECT_RETRY_DELAY_MS;
+    } else {
+        uint32_t timeoutS = (expectedMs * TIMEOUT_LATENCY_FACTOR + 999) / 1000;
+        plan.socketTimeoutS = (uint8_t)(timeoutS > MQTT_CONNECT_MAX_TIMEOUT_S ? MQTT_CONNECT_MAX_TIMEOUT_S : timeoutS);
+        // A fast broker recovers from a dropped packet quickly
+        uint32_t delayMs = expectedMs < MQTT_CONNECT_MIN_RETRY_DELAY_MS ? MQTT_CONNECT_MIN_RETRY_DELAY_MS : expectedMs;
+        plan.retryDelayMs = (uint16_t)(delayMs > MQTT_CONNECT_RETRY_DELAY_MS ? MQTT_CONNECT_RETRY_DELAY_MS : delayMs);
+    }
+    return plan;
+}
+
+bool canStartMqttAttempt(const MqttConnectPlan& plan, uint32_t spentMs) {
+    // An attempt can take the whole socket timeout
+    return spentMs + (uint32_t)plan.socketTimeoutS * 1000 <= plan.budgetMs;
+}
+
+void recordMqttConnectSuccess(MqttConnectStats& stats, uint32_t latencyMs) {
+    stats.failureStreak = 0;
+    stats.skipRemaining = 0;
+    stats.latencyMs[stats.historyNext] = (uint16_t)(latencyMs > 0xFFFF ? 0xFFFF : latencyMs);
+    stats.historyNext = (stats.historyNext + 1) % MQTT_CONNECT_HISTORY;
+    if (stats.historyCount < MQTT_CONNECT_HISTORY) {
+        stats.historyCount++;
+    }
+}
+
+void recordMqttConnectFailure(MqttConnectStats& stats) {
+    if (stats.failureStreak < 0xFF) {
+        stats.failureStreak++;
+    }
+    // First failure may be a blip: try again next wake. Then skip 1, 2, 4 ... wakes
+    if (stats.failureStreak < 2) {
+        stats.skipRemaining = 0;
+        return;
+    }
+    uint8_t shift = stats.failureStreak - 2;
+    uint32_t skip = shift >= 6 ? MQTT_BACKOFF_MAX_SKIP : (1u << shift);
+    stats.skipRemaining = (uint8_t)(skip > MQTT_BACKOFF_MAX_SKIP ? MQTT_BACKOFF_MAX_SKIP : skip);
+}
+
+void recordMqttConnectSkipped(MqttConnectStats& stats) {
+    if (stats.skipRemaining > 0) {
+        stats.skipRemaining--;
+    }
+}
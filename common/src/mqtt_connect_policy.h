@@ -0,0 +1,101 @@
+#ifndef MQTT_CONNECT_POLICY_H
+#define MQTT_CONNECT_POLICY_H
+
+#include <stdint.h>
+
+// Layout version - bump when the struct changes so stale RTC contents are discarded
+#define MQTT_CONNECT_STATS_VERSION 1
+#define MQTT_CONNECT_HISTORY 4              // Recent successful connect latencies kept
+#define MQTT_CONNECT_MAX_ATTEMPTS 3         // Attempts while the broker is known to be up
+#define MQTT_CONNECT_DEFAULT_TIMEOUT_S 2    // Socket timeout without history (PubSubClient uses whole seconds)
+#define MQTT_CONNECT_MAX_TIMEOUT_S 4
+#define MQTT_CONNECT_RETRY_DELAY_MS 1000    // Delay between attempts without history
+#define MQTT_CONNECT_MIN_RETRY_DELAY_MS 250
+#define MQTT_CYCLE_BUDGET_MS 5000           // Connect time allowed per wake, all attempts together
+#define MQTT_BACKOFF_MAX_SKIP 32            // Most wakes skipped after repeated failures
+
+/**
+ * @brief Adaptive MQTT connect policy
+ *
+ * Pure C++ with NO dependencies on Arduino/ESP32 APIs, making it fully
+ * testable with standard C++ unit testing frameworks.
+ *
+ * A fixed 3 x (2 s timeout + 1 s delay) costs up to 8 s of radio-on time on
+ * every wake while the broker is down. Instead, the connect outcome of each
+ * wake is kept in RTC memory and drives the next one:
+ * - Timeout and retry delay follow the slowest recent successful connect
+ * - After a failed wake only one probe attempt is made
+ * - From the second failed wake in a row the broker is skipped for 1, 2, 4 ...
+ *   (at most MQTT_BACKOFF_MAX_SKIP) timer wakes; user wakes always try
+ * - All attempts of one wake share MQTT_CYCLE_BUDGET_MS
+ */
+
+/**
+ * @brief Connect history kept in RTC memory across deep sleep
+ */
+struct MqttConnectStats {
+    uint8_t version;                    // MQTT_CONNECT_STATS_VERSION (0 after a cold boot = invalid)
+    uint8_t failureStreak;              // Consecutive wakes whose connect failed (saturates)
+    uint8_t skipRemaining;              // Timer wakes left to skip the broker
+    uint8_t historyCount;               // Latencies stored (0..MQTT_CONNECT_HISTORY)
+    uint8_t historyNext;                // Slot for the next latency
+    uint8_t reserved;
+    uint16_t latencyMs[MQTT_CONNECT_HISTORY];  // Recent successful connect times
+};
+
+/**
+ * @brief How to connect this wake
+ */
+struct MqttConnectPlan {
+    bool skip;                  // Do not contact the broker (back-off)
+    uint8_t attempts;           // Connect attempts
+    uint8_t socketTimeoutS;     // PubSubClient socket timeout
+    uint16_t retryDelayMs;      // Delay between attempts
+    uint32_t budgetMs;          // Connect time allowed this wake
+};
+
+/**
+ * @brief Reset to "no history, broker assumed up"
+ */
+void initMqttConnectStats(MqttConnectStats& stats);
+
+/**
+ * @brief Check stats read from RTC memory (version and ranges)
+ * @return false if they must be re-initialized
+ */
+bool isMqttConnectStatsValid(const MqttConnectStats& stats);
+
+/**
+ * @brief Slowest recent successful connect
+ * @return Milliseconds, 0 if there is no history
+ */
+uint32_t getMqttConnectLatencyEstimate(const MqttConnectStats& stats);
+
+/**
+ * @brief Plan this wake's connect
+ * @param userWake Button / reset / first boot - never skipped, full attempts
+ */
+MqttConnectPlan planMqttConnect(const MqttConnectStats& stats, bool userWake);
+
+/**
+ * @brief Check whether another attempt fits the wake's budget
+ * @param spentMs Connect time already spent this wake
+ */
+bool canStartMqttAttempt(const MqttConnectPlan& plan, uint32_t spentMs);
+
+/**
+ * @brief Record a successful connect (clears the failure streak and back-off)
+ */
+void recordMqttConnectSuccess(MqttConnectStats& stats, uint32_t latencyMs);
+
+/**
+ * @brief Record a wake whose connect failed and schedule the back-off
+ */
+void recordMqttConnectFailure(MqttConnectStats& stats);
+
+/**
+ * @brief Record a wake that skipped the broker per the plan
+ */
+void recordMqttConnectSkipped(MqttConnectStats& stats);
+
+#endif // MQTT_CONNECT_POLICY_H
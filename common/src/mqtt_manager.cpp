@@ -1,6 +1,7 @@
 #include "mqtt_manager.h"
 #include "version.h"
 #include "logger.h"
+#include "host_resolver.h"
 #include <WiFi.h>
 
 // Helper function to get concise MQTT state description
@@ -20,7 +21,9 @@ static const char* getMQTTStateDesc(int state) {
 }
 
 MQTTManager::MQTTManager(ConfigManager* configManager)
-    : _configManager(configManager), _mqttClient(nullptr), _port(1883), _isConfigured(false) {
+    : _configManager(configManager), _mqttClient(nullptr), _port(1883), _isConfigured(false), _telemetryOpen(false), _batchedState(false),
+      _pendingDiscoveryHash(DISCOVERY_HASH_NONE), _backlog(nullptr), _backlogSent(false),
+      _connectStats(nullptr), _connectSpentMs(0), _connectGaveUp(false), _networkCache(nullptr) {
 }
 
 MQTTManager::~MQTTManager() {
@@ -38,6 +41,11 @@ bool MQTTManager::begin() {
     _broker = _configManager->getMQTTBroker();
     _username = _configManager->getMQTTUsername();
     _password = _configManager->getMQTTPassword();
+    _batchedState = _configManager->getMQTTBatchedState();
+    
+    // New session: the connect budget starts over
+    _connectSpentMs = 0;
+    _connectGaveUp = false;
     
     // Check if MQTT is configured
     if (_broker.length() == 0) {
@@ -55,16 +63,16 @@ bool MQTTManager::begin() {
         return false;
     }
     
-    Logger::linef("%s:%d (user: %s)", host.c_str(), _port, 
-        _username.length() > 0 ? _username.c_str() : "none");
+    Logger::linef("%s:%d (user: %s%s)", host.c_str(), _port, 
+        _username.length() > 0 ? _username.c_str() : "none", _batchedState ? ", batched state" : "");
     
     // Create MQTT client
     if (_mqttClient == nullptr) {
         _mqttClient = new PubSubClient(_wifiClient);
     }
     
-    // Set buffer size for Home Assistant discovery messages
-    _mqttClient->setBufferSize(MQTT_MAX_PACKET_SIZE);
+    // Set buffer size for Home Assistant discovery messages (and the batched state document)
+    _mqttClient->setBufferSize(_batchedState ? MQTT_BATCHED_PACKET_SIZE : MQTT_MAX_PACKET_SIZE);
     
     _mqttClient->setServer(host.c_str(), _port);
     // Reduced timeouts for faster connection and publish cycles
@@ -77,7 +85,7 @@ bool MQTTManager::begin() {
     return true;
 }
 
-bool MQTTManager::connect() {
+bool MQTTManager::connect(bool userWake) {
     if (!_isConfigured) {
         Logger::message("MQTT Connection", "MQTT not configured - skipping connection");
         return true;  // Not an error
@@ -89,6 +97,28 @@ bool MQTTManager::connect() {
         return false;
     }
     
+    if (_connectGaveUp) {
+        // openTelemetry() on the other core already failed - don't spend the budget twice
+        return false;
+    }
+    
+    // Without RTC history (e.g. config mode) plan as for a fresh boot
+    MqttConnectStats freshStats;
+    if (_connectStats == nullptr) {
+        initMqttConnectStats(freshStats);
+    }
+    MqttConnectStats& stats = _connectStats != nullptr ? *_connectStats : freshStats;
+    MqttConnectPlan plan = planMqttConnect(stats, userWake);
+    
+    if (plan.skip) {
+        _lastError = "Broker backed off after " + String(stats.failureStreak) + " failed wakes, " +
+                     String(stats.skipRemaining) + " wakes left";
+        Logger::message("MQTT Connect", "Skipped: " + _lastError);
+        recordMqttConnectSkipped(stats);
+        _connectGaveUp = true;
+        return false;
+    }
+    
     Logger::begin("MQTT Connect");
     
     // Parse broker URL again to get host and port
@@ -100,43 +130,70 @@ bool MQTTManager::connect() {
         return false;
     }
     
-    Logger::linef("%s:%d", host.c_str(), port);
+    uint32_t budgetLeftMs = _connectSpentMs < plan.budgetMs ? plan.budgetMs - _connectSpentMs : 0;
+    Logger::linef("%s:%d (timeout %us, budget %lu ms)", host.c_str(), port,
+                  (unsigned)plan.socketTimeoutS, (unsigned long)budgetLeftMs);
     
     // Generate unique client ID based on chip ID
     String clientId = "inkplate-" + String((uint32_t)ESP.getEfuseMac(), HEX);
     
-    // Set server again (ensure it's set correctly)
-    _mqttClient->setServer(host.c_str(), port);
-    // Reduced timeouts for faster connection and publish cycles
+    // Set server again, by address when the name is cached (saves the DNS round trip)
+    IPAddress brokerIP;
+    bool brokerCached = false;
+    if (resolveHost(_networkCache, host.c_str(), brokerIP, &brokerCached)) {
+        _mqttClient->setServer(brokerIP, port);
+    } else {
+        _mqttClient->setServer(host.c_str(), port);
+    }
     _mqttClient->setKeepAlive(5);     // Reduced from 15s to 5s
-    _mqttClient->setSocketTimeout(2);  // Reduced from 10s to 2s
+    _mqttClient->setSocketTimeout(plan.socketTimeoutS);  // Learned from recent connects
     
-    // Attempt connection with retries
-    const int maxRetries = 3;
+    // Attempt connection with retries, all within this wake's budget
     bool connected = false;
+    int attempt = 0;
     
-    for (int attempt = 1; attempt <= maxRetries && !connected; attempt++) {
-        Logger::linef("Attempt %d/%d", attempt, maxRetries);
+    while (attempt < plan.attempts && !connected && canStartMqttAttempt(plan, _connectSpentMs)) {
+        attempt++;
+        Logger::linef("Attempt %d/%d", attempt, plan.attempts);
         
+        unsigned long attemptStart = millis();
         if (_username.length() > 0) {
             connected = _mqttClient->connect(clientId.c_str(), _username.c_str(), _password.c_str());
         } else {
             connected = _mqttClient->connect(clientId.c_str());
         }
+        unsigned long attemptMs = millis() - attemptStart;
+        _connectSpentMs += attemptMs;
+        
+        if (connected) {
+            recordMqttConnectSuccess(stats, attemptMs);
+            break;
+        }
+        
+        int state = _mqttClient->state();
+        Logger::linef("Attempt %d failed after %lu ms (state: %d)", attempt, attemptMs, state);
         
-        if (!connected) {
-            int state = _mqttClient->state();
-            Logger::linef("Attempt %d failed (state: %d)", attempt, state);
-            
-            // Show concise error description
-            const char* error = getMQTTStateDesc(state);
-            if (error) {
-                Logger::linef("  %s", error);
+        // Network-level failure on a cached address: retry with a fresh lookup
+        if (brokerCached && (state == MQTT_CONNECT_FAILED || state == MQTT_CONNECTION_TIMEOUT)) {
+            brokerCached = false;
+            if (refreshHost(_networkCache, host.c_str(), brokerIP)) {
+                _mqttClient->setServer(brokerIP, port);
             }
-            
-            if (attempt < maxRetries) {
-                delay(1000);  // Wait 1 second before retry
+        }
+        
+        // Show concise error description
+        const char* error = getMQTTStateDesc(state);
+        if (error) {
+            Logger::linef("  %s", error);
+        }
+        
+        if (attempt < plan.attempts) {
+            if (!canStartMqttAttempt(plan, _connectSpentMs + plan.retryDelayMs)) {
+                Logger::line("Connect budget used up");
+                break;
             }
+            delay(plan.retryDelayMs);
+            _connectSpentMs += plan.retryDelayMs;
         }
     }
     
@@ -144,7 +201,12 @@ bool MQTTManager::connect() {
         Logger::end("MQTT connected successfully!");
         return true;
     } else {
-        _lastError = "Connection failed after " + String(maxRetries) + " attempts, state: " + String(_mqttClient->state());
+        recordMqttConnectFailure(stats);
+        _connectGaveUp = true;
+        _lastError = "Connection failed after " + String(attempt) + " attempts, state: " + String(_mqttClient->state());
+        if (stats.skipRemaining > 0) {
+            _lastError += ", skipping the next " + String(stats.skipRemaining) + " timer wakes";
+        }
         Logger::end("Failed: " + _lastError);
         return false;
     }
@@ -154,6 +216,24 @@ void MQTTManager::disconnect() {
     if (_mqttClient != nullptr && _mqttClient->connected()) {
         _mqttClient->disconnect();
     }
+    _telemetryOpen = false;
+    _pendingDiscoveryHash = DISCOVERY_HASH_NONE;
+    _backlogSent = false;
+}
+
+void MQTTManager::setTelemetryBacklog(TelemetryBacklog* backlog) {
+    _backlog = backlog;
+}
+
+void MQTTManager::setNetworkCache(NetworkCache* cache) {
+    _networkCache = cache;
+}
+
+void MQTTManager::setConnectStats(MqttConnectStats* stats) {
+    _connectStats = stats;
+    if (_connectStats != nullptr && !isMqttConnectStatsValid(*_connectStats)) {
+        initMqttConnectStats(*_connectStats);  // Cold boot or layout change
+    }
 }
 
 bool MQTTManager::publishDiscovery(const String& deviceId, const String& deviceName, const String& modelName) {
@@ -382,6 +462,17 @@ bool MQTTManager::publishLastLog(const String& deviceId, const String& message,
     
     Logger::begin("Publishing last log to MQTT");
     
+    if (_batchedState) {
+        // Not retained - the retained document of the last wake keeps the other values
+        TelemetryState state;
+        initTelemetryState(state);
+        state.lastLog = message.c_str();
+        state.lastLogSeverity = severity.c_str();
+        bool published = publishBatchedState(deviceId, state, false);
+        Logger::end(published ? "Last log published successfully" : "ERROR: Failed to publish last log");
+        return published;
+    }
+    
     String stateTopic = getStateTopic(deviceId, "last_log");
     
     // Format: [SEVERITY] Message
@@ -499,10 +590,53 @@ String MQTTManager::getStateTopic(const String& deviceId, const String& sensorTy
     return "homeassistant/sensor/" + deviceId + "/" + sensorType + "/state";
 }
 
+String MQTTManager::getBatchedStateTopic(const String& deviceId) {
+    // Batched state topic format:
+    // homeassistant/sensor/[device_id]/state
+    return "homeassistant/sensor/" + deviceId + "/" + TELEMETRY_STATE_TOPIC;
+}
+
+bool MQTTManager::publishBatchedState(const String& deviceId, const TelemetryState& state, bool retained) {
+    char payload[TELEMETRY_PAYLOAD_SIZE];
+    size_t length = serializeTelemetryState(state, payload, sizeof(payload));
+    if (length == 0) {
+        _lastError = "State document too large";
+        Logger::line("ERROR: " + _lastError);
+        return false;
+    }
+    
+    String stateTopic = getBatchedStateTopic(deviceId);
+    Logger::linef("%s (%u bytes)", stateTopic.c_str(), (unsigned)length);
+    return _mqttClient->publish(stateTopic.c_str(), (const uint8_t*)payload, length, retained);
+}
+
+bool MQTTManager::publishBacklog(const String& deviceId) {
+    if (_backlog == nullptr || _backlog->count == 0) {
+        return true;
+    }
+    
+    // Static: too large for the stack, and only ever used from the main task
+    static char payload[TELEMETRY_BACKLOG_DOCUMENT_SIZE];
+    size_t length = serializeTelemetryBacklog(*_backlog, payload, sizeof(payload));
+    if (length == 0) {
+        _lastError = "Backlog document too large";
+        Logger::line("ERROR: " + _lastError);
+        return false;
+    }
+    
+    // Grow the packet buffer for this one message; begin() sets the normal size again next wake
+    _mqttClient->setBufferSize(MQTT_BACKLOG_PACKET_SIZE);
+    String topic = "homeassistant/sensor/" + deviceId + "/" + TELEMETRY_BACKLOG_TOPIC;
+    _backlogSent = _mqttClient->publish(topic.c_str(), (const uint8_t*)payload, length, false);
+    Logger::linef("Backlog: %u wakes, %u dropped (%u bytes)%s", (unsigned)_backlog->count,
+                  (unsigned)_backlog->dropped, (unsigned)length, _backlogSent ? "" : " - FAILED");
+    return _backlogSent;
+}
+
 bool MQTTManager::publishSensorDiscovery(const String& discoveryTopic, const String& deviceId, const String& sensorType,
                                          const String& name, const String& deviceClass, const String& unit,
                                          const String& deviceName, const String& modelName, bool includeFullDevice) {
-    String stateTopic = getStateTopic(deviceId, sensorType);
+    String stateTopic = _batchedState ? getBatchedStateTopic(deviceId) : getStateTopic(deviceId, sensorType);
     
     String payload = "{";
     payload += "\"name\":\"" + name + "\",";
@@ -534,7 +668,14 @@ bool MQTTManager::publishSensorDiscovery(const String& discoveryTopic, const Str
         payload += "\"force_update\":true,";
     }
     
-    payload += "\"value_template\":\"{{ value }}\",";
+    if (_batchedState) {
+        // Pick this sensor's key out of the shared state document
+        char valueTemplate[160];
+        formatTelemetryValueTemplate(sensorType.c_str(), valueTemplate, sizeof(valueTemplate));
+        payload += "\"value_template\":\"" + String(valueTemplate) + "\",";
+    } else {
+        payload += "\"value_template\":\"{{ value }}\",";
+    }
     payload += buildDeviceInfoJSON(deviceId, deviceName, modelName, includeFullDevice);
     payload += "}";
     
@@ -559,37 +700,42 @@ String MQTTManager::buildDeviceInfoJSON(const String& deviceId, const String& de
     return json;
 }
 
-bool MQTTManager::shouldPublishDiscovery(WakeupReason wakeReason) {
-    // Only publish discovery on:
-    // - WAKEUP_FIRST_BOOT: Initial setup, ensures HA entities are created
-    // - WAKEUP_RESET_BUTTON: Hardware reset, may indicate config/firmware change
-    //
-    // DO NOT publish on:
-    // - WAKEUP_TIMER: Normal refresh cycle (most common)
-    // - WAKEUP_BUTTON: Manual refresh, no config change
+uint32_t MQTTManager::getDiscoveryHash(const String& deviceId, const String& deviceName, const String& modelName) {
+    String broker = _broker + ":" + String(_port);
+    
+    DiscoveryIdentity identity;
+    identity.deviceId = deviceId.c_str();
+    identity.deviceName = deviceName.c_str();
+    identity.modelName = modelName.c_str();
+    identity.firmwareVersion = FIRMWARE_VERSION;
+    identity.broker = broker.c_str();
+    identity.batchedState = _batchedState;
+    return computeDiscoveryHash(identity, DISCOVERY_SENSORS, DISCOVERY_SENSOR_COUNT);
+}
+
+bool MQTTManager::shouldPublishDiscovery(WakeupReason wakeReason, uint32_t discoveryHash) {
+    // Publish discovery only when the retained configs on the broker are missing or stale:
+    // - Nothing published yet, or the device name, model, firmware, broker, state layout
+    //   or sensor list changed since the last set (hash stored in NVS)
+    // - WAKEUP_RESET_BUTTON: Hardware reset, manual way to restore lost retained messages
     //
-    // This significantly reduces MQTT traffic and retained message count
-    return (wakeReason == WAKEUP_FIRST_BOOT || wakeReason == WAKEUP_RESET_BUTTON);
+    // First boots (power-on, restart after a portal save) and button wakes with an
+    // unchanged set skip the ~20 large retained messages
+    uint32_t storedHash = _configManager->getMQTTDiscoveryHash();
+    return isDiscoveryPublishNeeded(discoveryHash, storedHash, wakeReason == WAKEUP_RESET_BUTTON);
 }
 
-bool MQTTManager::publishAllTelemetry(const String& deviceId, const String& deviceName, const String& modelName,
-                                      WakeupReason wakeReason, float batteryVoltage, int batteryPercentage,
-                                      int wifiRSSI, float loopTimeSeconds, uint32_t imageCRC32,
-                                      const String& lastLogMessage, const String& lastLogSeverity,
-                                      const String& wifiBSSID,
-                                      float wifiTimeSeconds, float ntpTimeSeconds, 
-                                      float crcTimeSeconds, float imageTimeSeconds,
-                                      uint8_t wifiRetryCount, uint8_t crcRetryCount, uint8_t imageRetryCount) {
+bool MQTTManager::openTelemetry(const String& deviceId, const String& deviceName, const String& modelName,
+                                WakeupReason wakeReason) {
     if (!_isConfigured) {
-        Logger::message("MQTT", "MQTT not configured - skipping");
         return true;  // Not an error
     }
     
-    Logger::begin("Publishing All Telemetry to MQTT");
+    Logger::begin("MQTT Telemetry Session");
     Logger::line("Connecting to MQTT broker...");
     
-    // Connect to MQTT
-    if (!connect()) {
+    // Connect to MQTT (timer wakes may back off from a broker that keeps failing)
+    if (!connect(wakeReason != WAKEUP_TIMER)) {
         Logger::line("ERROR: Failed to connect to MQTT broker");
         Logger::line("Error: " + _lastError);
         Logger::end();
@@ -598,83 +744,99 @@ bool MQTTManager::publishAllTelemetry(const String& deviceId, const String& devi
     
     Logger::line("Connected successfully");
     
-    int publishCount = 0;
-    
-    // Publish discovery messages (conditionally based on wake reason)
-    if (shouldPublishDiscovery(wakeReason)) {
+    // Publish discovery messages only when the set changed since it was last published
+    uint32_t discoveryHash = getDiscoveryHash(deviceId, deviceName, modelName);
+    if (shouldPublishDiscovery(wakeReason, discoveryHash)) {
         Logger::line("Publishing discovery messages...");
         
-        // Battery voltage sensor discovery
-        publishSensorDiscovery(getDiscoveryTopic(deviceId, "battery_voltage"), deviceId, "battery_voltage",
-                              "Battery Voltage", "voltage", "V", deviceName, modelName, true);
-        publishCount++;
-        
-        // Battery percentage sensor discovery
-        publishSensorDiscovery(getDiscoveryTopic(deviceId, "battery_percentage"), deviceId, "battery_percentage",
-                              "Battery Percentage", "battery", "%", deviceName, modelName, false);
-        publishCount++;
-        
-        // Loop time sensor discovery
-        publishSensorDiscovery(getDiscoveryTopic(deviceId, "loop_time"), deviceId, "loop_time",
-                              "Loop Time", "duration", "s", deviceName, modelName, false);
-        publishCount++;
-        
-        // WiFi signal sensor discovery
-        publishSensorDiscovery(getDiscoveryTopic(deviceId, "wifi_signal"), deviceId, "wifi_signal",
-                              "WiFi Signal", "signal_strength", "dBm", deviceName, modelName, false);
-        publishCount++;
-        
-        // Last log sensor discovery
-        publishSensorDiscovery(getDiscoveryTopic(deviceId, "last_log"), deviceId, "last_log",
-                              "Last Log", "", "", deviceName, modelName, false);
-        publishCount++;
-        
-        // Image CRC32 sensor discovery
-        publishSensorDiscovery(getDiscoveryTopic(deviceId, "image_crc32"), deviceId, "image_crc32",
-                              "Image CRC32", "", "", deviceName, modelName, false);
-        publishCount++;
-        
-        // WiFi BSSID sensor discovery
-        publishSensorDiscovery(getDiscoveryTopic(deviceId, "wifi_bssid"), deviceId, "wifi_bssid",
-                              "WiFi BSSID", "", "", deviceName, modelName, false);
-        publishCount++;
-        
-        // Loop time breakdown sensor discoveries
-        publishSensorDiscovery(getDiscoveryTopic(deviceId, "loop_time_wifi"), deviceId, "loop_time_wifi",
-                              "Loop Time - WiFi", "duration", "s", deviceName, modelName, false);
-        publishCount++;
-        
-        publishSensorDiscovery(getDiscoveryTopic(deviceId, "loop_time_ntp"), deviceId, "loop_time_ntp",
-                              "Loop Time - NTP", "duration", "s", deviceName, modelName, false);
-        publishCount++;
-        
-        publishSensorDiscovery(getDiscoveryTopic(deviceId, "loop_time_crc"), deviceId, "loop_time_crc",
-                              "Loop Time - CRC", "duration", "s", deviceName, modelName, false);
-        publishCount++;
-        
-        publishSensorDiscovery(getDiscoveryTopic(deviceId, "loop_time_image"), deviceId, "loop_time_image",
-                              "Loop Time - Image", "duration", "s", deviceName, modelName, false);
-        publishCount++;
-        
-        // Retry count sensor discoveries
-        publishSensorDiscovery(getDiscoveryTopic(deviceId, "loop_time_wifi_retries"), deviceId, "loop_time_wifi_retries",
-                              "Loop Time - WiFi Retries", "", "", deviceName, modelName, false);
-        publishCount++;
-        
-        publishSensorDiscovery(getDiscoveryTopic(deviceId, "loop_time_crc_retries"), deviceId, "loop_time_crc_retries",
-                              "Loop Time - CRC Retries", "", "", deviceName, modelName, false);
-        publishCount++;
-        
-        publishSensorDiscovery(getDiscoveryTopic(deviceId, "loop_time_image_retries"), deviceId, "loop_time_image_retries",
-                              "Loop Time - Image Retries", "", "", deviceName, modelName, false);
-        publishCount++;
+        int publishCount = 0;
+        bool allPublished = true;
+        for (size_t i = 0; i < DISCOVERY_SENSOR_COUNT; i++) {
+            const DiscoverySensor& sensor = DISCOVERY_SENSORS[i];
+            // First sensor carries the full device info, the rest only the identifiers
+            if (publishSensorDiscovery(getDiscoveryTopic(deviceId, sensor.type), deviceId, sensor.type,
+                                       sensor.name, sensor.deviceClass, sensor.unit, deviceName, modelName, i == 0)) {
+                publishCount++;
+            } else {
+                allPublished = false;
+            }
+        }
         
+        // Stored once the messages were flushed on a live connection (flushAndDisconnect)
+        _pendingDiscoveryHash = allPublished ? discoveryHash : DISCOVERY_HASH_NONE;
         Logger::linef("Published %d discovery messages", publishCount);
-        publishCount = 0;  // Reset for state messages
     } else {
-        Logger::line("Skipping discovery (normal wake cycle)");
+        Logger::line("Skipping discovery (unchanged)");
     }
     
+    _telemetryOpen = true;
+    Logger::end();
+    return true;
+}
+
+bool MQTTManager::publishAllTelemetry(const String& deviceId, const String& deviceName, const String& modelName,
+                                      WakeupReason wakeReason, float batteryVoltage, int batteryPercentage,
+                                      int wifiRSSI, float loopTimeSeconds, uint32_t imageCRC32,
+                                      const String& lastLogMessage, const String& lastLogSeverity,
+                                      const String& wifiBSSID,
+                                      float wifiTimeSeconds, float ntpTimeSeconds, 
+                                      float crcTimeSeconds, float imageTimeSeconds,
+                                      uint8_t wifiRetryCount, uint8_t crcRetryCount, uint8_t imageRetryCount,
+                                      uint8_t tlsFullCount, uint8_t tlsResumedCount,
+                                      uint8_t httpReusedCount,
+                                      float cycleChargeMah, float batteryDaysRemaining,
+                                      float wifiEarlySeconds) {
+    if (!_isConfigured) {
+        Logger::message("MQTT", "MQTT not configured - skipping");
+        return true;  // Not an error
+    }
+    
+    Logger::begin("Publishing All Telemetry to MQTT");
+    
+    // Connect and publish discovery, unless openTelemetry() already did
+    // while the panel was refreshing
+    bool alreadyOpen = _telemetryOpen && _mqttClient->connected();
+    if (!alreadyOpen && !openTelemetry(deviceId, deviceName, modelName, wakeReason)) {
+        Logger::end();
+        return false;
+    }
+    
+    if (_batchedState) {
+        TelemetryState state;
+        initTelemetryState(state);
+        state.batteryVoltage = batteryVoltage;
+        state.batteryPercentage = batteryPercentage;
+        state.hasWifiRSSI = true;
+        state.wifiRSSI = wifiRSSI;
+        state.loopTimeSeconds = loopTimeSeconds;
+        state.lastLog = lastLogMessage.c_str();
+        state.lastLogSeverity = lastLogSeverity.c_str();
+        state.hasImageCRC32 = true;
+        state.imageCRC32 = imageCRC32;
+        state.wifiBSSID = wifiBSSID.c_str();
+        state.wifiSeconds = wifiTimeSeconds;
+        state.wifiEarlySeconds = wifiEarlySeconds;
+        state.ntpSeconds = ntpTimeSeconds;
+        state.crcSeconds = crcTimeSeconds;
+        state.imageSeconds = imageTimeSeconds;
+        state.wifiRetries = wifiRetryCount;
+        state.crcRetries = crcRetryCount;
+        state.imageRetries = imageRetryCount;
+        state.tlsFullHandshakes = tlsFullCount;
+        state.tlsResumedHandshakes = tlsResumedCount;
+        state.httpReusedConnections = httpReusedCount;
+        state.cycleChargeMah = cycleChargeMah;
+        state.batteryDaysRemaining = batteryDaysRemaining;
+        
+        bool published = publishBatchedState(deviceId, state, true);
+        publishBacklog(deviceId);
+        flushAndDisconnect();
+        Logger::end(published ? "All telemetry published (batched)" : "ERROR: Failed to publish state document");
+        return published;
+    }
+    
+    int publishCount = 0;
+    
     // Publish battery voltage state
     if (batteryVoltage > 0.0) {
         String stateTopic = getStateTopic(deviceId, "battery_voltage");
@@ -759,6 +921,14 @@ bool MQTTManager::publishAllTelemetry(const String& deviceId, const String& devi
         publishCount++;
     }
     
+    if (wifiEarlySeconds >= 0) {
+        String stateTopic = getStateTopic(deviceId, "loop_time_wifi_early");
+        String payload = String(wifiEarlySeconds, 2);
+        _mqttClient->publish(stateTopic.c_str(), payload.c_str(), true);
+        Logger::line("Loop Time - WiFi Early: " + payload + " s");
+        publishCount++;
+    }
+    
     if (ntpTimeSeconds >= 0) {
         String stateTopic = getStateTopic(deviceId, "loop_time_ntp");
         String payload = String(ntpTimeSeconds, 2);
@@ -808,8 +978,59 @@ bool MQTTManager::publishAllTelemetry(const String& deviceId, const String& devi
         publishCount++;
     }
     
+    // Publish TLS handshake counts (255 means skip)
+    if (tlsFullCount != 255) {
+        String stateTopic = getStateTopic(deviceId, "tls_full_handshakes");
+        String payload = String(tlsFullCount);
+        _mqttClient->publish(stateTopic.c_str(), payload.c_str(), true);
+        Logger::line("TLS Full Handshakes: " + payload);
+        publishCount++;
+    }
+    
+    if (tlsResumedCount != 255) {
+        String stateTopic = getStateTopic(deviceId, "tls_resumed_handshakes");
+        String payload = String(tlsResumedCount);
+        _mqttClient->publish(stateTopic.c_str(), payload.c_str(), true);
+        Logger::line("TLS Resumed Handshakes: " + payload);
+        publishCount++;
+    }
+    
+    if (httpReusedCount != 255) {
+        String stateTopic = getStateTopic(deviceId, "http_reused_connections");
+        String payload = String(httpReusedCount);
+        _mqttClient->publish(stateTopic.c_str(), payload.c_str(), true);
+        Logger::line("HTTP Reused Connections: " + payload);
+        publishCount++;
+    }
+    
+    // Publish battery life model (negative means skip)
+    if (cycleChargeMah >= 0) {
+        String stateTopic = getStateTopic(deviceId, "wake_charge");
+        String payload = String(cycleChargeMah, 3);
+        _mqttClient->publish(stateTopic.c_str(), payload.c_str(), true);
+        Logger::line("Charge Per Wake: " + payload + " mAh");
+        publishCount++;
+    }
+    
+    if (batteryDaysRemaining >= 0) {
+        String stateTopic = getStateTopic(deviceId, "battery_days_remaining");
+        String payload = String(batteryDaysRemaining, 0);
+        _mqttClient->publish(stateTopic.c_str(), payload.c_str(), true);
+        Logger::line("Battery Days Remaining: " + payload);
+        publishCount++;
+    }
+    
     Logger::linef("Published %d state messages", publishCount);
     
+    publishBacklog(deviceId);
+    flushAndDisconnect();
+    
+    Logger::end("All telemetry published");
+    
+    return true;
+}
+
+void MQTTManager::flushAndDisconnect() {
     // Give MQTT client time to transmit all queued messages
     // PubSubClient needs loop() calls to actually send queued data
     // 20-30ms is typically sufficient for transmission
@@ -818,10 +1039,17 @@ bool MQTTManager::publishAllTelemetry(const String& deviceId, const String& devi
         delay(10);
     }
     
-    // Disconnect
-    disconnect();
+    // Forget the backlog once it went out on a live connection (kept for the next wake otherwise)
+    if (_backlogSent && _backlog != nullptr && _mqttClient->connected()) {
+        clearTelemetryBacklog(*_backlog);
+    }
     
-    Logger::end("All telemetry published");
+    // Remember the discovery set once it went out on a live connection
+    // (QoS 0 has no acknowledgement; a dropped connection republishes next wake)
+    if (_pendingDiscoveryHash != DISCOVERY_HASH_NONE && _mqttClient->connected()) {
+        _configManager->setMQTTDiscoveryHash(_pendingDiscoveryHash);
+    }
     
-    return true;
+    // Disconnect
+    disconnect();
 }
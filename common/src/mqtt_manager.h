@@ -6,9 +6,16 @@
 #include <WiFiClient.h>
 #include "config_manager.h"
 #include "power_manager.h"  // For WakeupReason enum
+#include "telemetry_payload.h"
+#include "discovery_hash.h"
+#include "telemetry_backlog.h"
+#include "mqtt_connect_policy.h"
+#include "network_cache.h"
 
 // Increase MQTT buffer size for Home Assistant discovery messages
 #define MQTT_MAX_PACKET_SIZE 512
+#define MQTT_BATCHED_PACKET_SIZE (TELEMETRY_PAYLOAD_SIZE + 128)  // State document + topic and header
+#define MQTT_BACKLOG_PACKET_SIZE (TELEMETRY_BACKLOG_DOCUMENT_SIZE + 128)  // Only while a backlog is sent
 
 class MQTTManager {
 public:
@@ -19,8 +26,10 @@ public:
     bool begin();
     
     // Connect to MQTT broker
+    // Attempts, timeouts and back-off follow the connect history (see mqtt_connect_policy.h)
+    // userWake: false on timer wakes - the broker may be skipped and fewer attempts are made
     // Returns true if connected or connection not needed (no broker configured)
-    bool connect();
+    bool connect(bool userWake = true);
     
     // Disconnect from MQTT broker
     void disconnect();
@@ -31,6 +40,21 @@ public:
     // modelName: board model name (e.g., "Inkplate 5 V2")
     bool publishDiscovery(const String& deviceId, const String& deviceName, const String& modelName);
     
+    // Connect and publish discovery ahead of publishAllTelemetry()
+    // Lets the network-bound part of the telemetry run while the panel refreshes;
+    // publishAllTelemetry() then only sends the state messages on the open connection
+    bool openTelemetry(const String& deviceId, const String& deviceName, const String& modelName,
+                       WakeupReason wakeReason);
+    
+    // Set the offline telemetry backlog (RTC memory); publishAllTelemetry() sends and clears it
+    void setTelemetryBacklog(TelemetryBacklog* backlog);
+    
+    // Set the connect history (RTC memory) that drives connect() across wakes
+    void setConnectStats(MqttConnectStats* stats);
+    
+    // Set the DNS cache (RTC memory) so the broker name is not resolved on every wake
+    void setNetworkCache(NetworkCache* cache);
+    
     // Publish battery voltage to Home Assistant
     // deviceId: unique device identifier (must match discovery)
     // voltage: battery voltage in volts
@@ -63,11 +87,11 @@ public:
     bool publishImageCRC32(const String& deviceId, uint32_t crc32);
     
     // Publish all telemetry in a single MQTT session (optimized for battery-powered devices)
-    // This method connects, publishes discovery (conditionally) + all state messages, then disconnects
+    // This method connects, publishes discovery (conditionally) + all state messages + the backlog, then disconnects
     // deviceId: unique device identifier
     // deviceName: human-readable device name
     // modelName: board model name (e.g., "Inkplate 5 V2")
-    // wakeReason: reason for waking (determines if discovery is published)
+    // wakeReason: reason for waking (reset button forces a discovery republish)
     // batteryVoltage: battery voltage in volts (0.0 to skip)
     // batteryPercentage: battery percentage (0-100, -1 to skip)
     // wifiRSSI: WiFi signal strength in dBm
@@ -85,6 +109,11 @@ public:
     // wifiRetryCount: WiFi connection retries (0-4)
     // crcRetryCount: CRC32 check retries (0-2)
     // imageRetryCount: Image download retries (0-2)
+    // TLS handshake counts (255 to skip):
+    // tlsFullCount: full HTTPS handshakes this cycle
+    // tlsResumedCount: resumed HTTPS handshakes this cycle
+    // httpReusedCount: HTTP requests that reused the open keep-alive connection
+    // wifiEarlySeconds: association that ran during setup() before the wait (-1 to skip)
     bool publishAllTelemetry(const String& deviceId, const String& deviceName, const String& modelName,
                              WakeupReason wakeReason, float batteryVoltage, int batteryPercentage,
                              int wifiRSSI, float loopTimeSeconds, uint32_t imageCRC32 = 0,
@@ -92,7 +121,11 @@ public:
                              const String& wifiBSSID = "",
                              float wifiTimeSeconds = 0, float ntpTimeSeconds = 0, 
                              float crcTimeSeconds = 0, float imageTimeSeconds = 0,
-                             uint8_t wifiRetryCount = 255, uint8_t crcRetryCount = 255, uint8_t imageRetryCount = 255);
+                             uint8_t wifiRetryCount = 255, uint8_t crcRetryCount = 255, uint8_t imageRetryCount = 255,
+                             uint8_t tlsFullCount = 255, uint8_t tlsResumedCount = 255,
+                             uint8_t httpReusedCount = 255,
+                             float cycleChargeMah = -1, float batteryDaysRemaining = -1,
+                             float wifiEarlySeconds = -1);
     
     // Check if MQTT is configured
     bool isConfigured();
@@ -110,6 +143,15 @@ private:
     int _port;
     String _lastError;
     bool _isConfigured;
+    bool _telemetryOpen;  // openTelemetry() connected and published discovery
+    bool _batchedState;   // One JSON state message on the device state topic (see telemetry_payload.h)
+    uint32_t _pendingDiscoveryHash;  // Discovery set published this session, saved in flushAndDisconnect()
+    TelemetryBacklog* _backlog;      // Wakes not yet published (RTC memory, may be null)
+    bool _backlogSent;               // Backlog published this session, cleared in flushAndDisconnect()
+    MqttConnectStats* _connectStats; // Connect history (RTC memory, may be null)
+    uint32_t _connectSpentMs;        // Connect time spent since begin(), checked against the budget
+    bool _connectGaveUp;             // Connect failed or was skipped since begin() - not retried this wake
+    NetworkCache* _networkCache;     // Resolved broker address (RTC memory, may be null)
     
     // Parse broker URL to extract host and port
     bool parseBrokerURL(const String& url, String& host, int& port);
@@ -117,12 +159,25 @@ private:
     // Generate MQTT topics
     String getDiscoveryTopic(const String& deviceId, const String& sensorType);
     String getStateTopic(const String& deviceId, const String& sensorType);
+    String getBatchedStateTopic(const String& deviceId);
+    
+    // Publish the serialized state document (batched mode)
+    bool publishBatchedState(const String& deviceId, const TelemetryState& state, bool retained);
+    
+    // Publish the backlog of earlier wakes as one document (no-op when empty)
+    bool publishBacklog(const String& deviceId);
+    
+    // Let PubSubClient transmit the queued messages, then disconnect
+    void flushAndDisconnect();
     
     // Build device info JSON (reduces code duplication)
     String buildDeviceInfoJSON(const String& deviceId, const String& deviceName, const String& modelName, bool full);
     
-    // Determine if discovery should be published based on wake reason
-    bool shouldPublishDiscovery(WakeupReason wakeReason);
+    // Hash of the discovery set this device would publish (see discovery_hash.h)
+    uint32_t getDiscoveryHash(const String& deviceId, const String& deviceName, const String& modelName);
+    
+    // Determine if discovery should be published (set changed since last published, or reset button)
+    bool shouldPublishDiscovery(WakeupReason wakeReason, uint32_t discoveryHash);
     
     // Helper methods to publish sensor discovery (reduces code duplication)
     bool publishSensorDiscovery(const String& discoveryTopic, const String& deviceId, const String& sensorType,
@@ -0,0 +1,139 @@
+#include <network_cache.h>
+#include <fnv1a.h>
+#include <string.h>
+#include <ctype.h>
+
+// Seconds since 'at', or false if the clock moved backwards
+static bool getAge(uint32_t at, uint32_t now, uint32_t& age) {
+    if (now < at) {
+        return false;
+    }
+    age = now - at;
+    return true;
+}
+
+static bool isSameHost(const char* a, const char* b) {
+    for (; *a != '\0' && *b != '\0'; a++, b++) {
+        if (tolower((unsigned char)*a) != tolower((unsigned char)*b)) {
+            return false;
+        }
+    }
+    return *a == *b;
+}
+
+static int findDnsEntry(const NetworkCache& cache, const char* host) {
+    for (int i = 0; i < DNS_CACHE_ENTRIES; i++) {
+        if (cache.dns[i].host[0] != '\0' && isSameHost(cache.dns[i].host, host)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void initNetworkCache(NetworkCache& cache) {
+    memset(&cache, 0, sizeof(cache));
+    cache.version = NETWORK_CACHE_VERSION;
+}
+
+bool isNetworkCacheValid(const NetworkCache& cache) {
+    if (cache.version != NETWORK_CACHE_VERSION) {
+        return false;
+    }
+    for (int i = 0; i < DNS_CACHE_ENTRIES; i++) {
+        if (memchr(cache.dns[i].host, '\0', DNS_CACHE_HOST_SIZE) == nullptr) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t networkCacheHash(const char* name) {
+    uint32_t hash = fnv1aString(FNV1A_OFFSET_BASIS, name);
+    return hash == 0 ? 1 : hash;
+}
+
+void storeDhcpLease(NetworkCache& cache, const DhcpLeaseCache& lease, uint32_t leaseSeconds,
+                    uint32_t networkHash, const uint8_t* bssid, uint32_t now) {
+    if (lease.ip == 0 || bssid == nullptr) {
+        invalidateDhcpLease(cache);
+        return;
+    }
+    cache.lease = lease;
+    cache.lease.obtainedAt = now;
+    cache.lease.leaseSeconds = leaseSeconds > 0 ? leaseSeconds : DHCP_LEASE_DEFAULT_SECONDS;
+    cache.lease.networkHash = networkHash;
+    memcpy(cache.lease.bssid, bssid, sizeof(cache.lease.bssid));
+}
+
+const DhcpLeaseCache* getReusableDhcpLease(const NetworkCache& cache, uint32_t networkHash,
+                                           const uint8_t* bssid, uint32_t now) {
+    const DhcpLeaseCache& lease = cache.lease;
+    if (lease.ip == 0 || lease.networkHash != networkHash || bssid == nullptr ||
+        memcmp(lease.bssid, bssid, sizeof(lease.bssid)) != 0) {
+        return nullptr;
+    }
+    uint32_t age;
+    if (!getAge(lease.obtainedAt, now, age) || age >= lease.leaseSeconds / 2) {
+        return nullptr;  // Past T1: let DHCP renew it
+    }
+    return &lease;
+}
+
+void invalidateDhcpLease(NetworkCache& cache) {
+    memset(&cache.lease, 0, sizeof(cache.lease));
+}
+
+bool lookupDnsCache(const NetworkCache& cache, const char* host, uint32_t now, uint32_t& outIp) {
+    if (host == nullptr) {
+        return false;
+    }
+    int index = findDnsEntry(cache, host);
+    if (index < 0) {
+        return false;
+    }
+    uint32_t age;
+    if (!getAge(cache.dns[index].resolvedAt, now, age) || age >= DNS_CACHE_TTL_SECONDS) {
+        return false;
+    }
+    outIp = cache.dns[index].ip;
+    return true;
+}
+
+bool storeDnsCache(NetworkCache& cache, const char* host, uint32_t ip, uint32_t now) {
+    if (host == nullptr || host[0] == '\0' || ip == 0 || strlen(host) >= DNS_CACHE_HOST_SIZE) {
+        return false;
+    }
+
+    int index = findDnsEntry(cache, host);
+    for (int i = 0; index < 0 && i < DNS_CACHE_ENTRIES; i++) {
+        if (cache.dns[i].host[0] == '\0') {
+            index = i;
+        }
+    }
+    if (index < 0) {
+        // Replace the entry resolved longest ago
+        index = 0;
+        for (int i = 1; i < DNS_CACHE_ENTRIES; i++) {
+            if (cache.dns[i].resolvedAt < cache.dns[index].resolvedAt) {
+                index = i;
+            }
+        }
+    }
+
+    DnsCacheEntry& entry = cache.dns[index];
+    memset(entry.host, 0, sizeof(entry.host));
+    strcpy(entry.host, host);
+    entry.ip = ip;
+    entry.resolvedAt = now;
+    return true;
+}
+
+void invalidateDnsCache(NetworkCache& cache, const char* host) {
+    if (host == nullptr) {
+        return;
+    }
+    int index = findDnsEntry(cache, host);
+    if (index >= 0) {
+        memset(&cache.dns[index], 0, sizeof(cache.dns[index]));
+    }
+}
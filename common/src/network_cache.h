@@ -0,0 +1,123 @@
+#ifndef NETWORK_CACHE_H
+#define NETWORK_CACHE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Layout version - bump when the structs change so stale RTC contents are discarded
+#define NETWORK_CACHE_VERSION 1
+#define DNS_CACHE_ENTRIES 4                 // Image host(s), .crc32 host, MQTT broker
+#define DNS_CACHE_HOST_SIZE 64              // Longer names are resolved every wake
+#define DNS_CACHE_TTL_SECONDS 3600          // lwIP does not expose the record TTL
+#define DHCP_LEASE_DEFAULT_SECONDS 3600     // When the server's lease time is unknown
+
+/**
+ * @brief DHCP lease and DNS results kept in RTC memory across deep sleep
+ *
+ * Pure C++ with NO dependencies on Arduino/ESP32 APIs, making it fully
+ * testable with standard C++ unit testing frameworks.
+ *
+ * A timer wake that locks onto the same access point reuses the last DHCP
+ * lease as a static configuration until the lease is half over (T1, when a
+ * DHCP client would renew), skipping the DISCOVER/OFFER/REQUEST/ACK
+ * exchange. Host names resolved by the HTTP and MQTT clients are cached for
+ * DNS_CACHE_TTL_SECONDS. Anything that fails to connect with cached data is
+ * invalidated so the next attempt goes through DHCP / DNS again.
+ *
+ * Times are the ESP32 system clock, which keeps running in deep sleep; a
+ * clock that moved backwards (or jumped on the first NTP sync) expires the
+ * entries.
+ *
+ * IPv4 addresses are stored as the 32-bit value of IPAddress (network order).
+ */
+
+/**
+ * @brief Last DHCP lease
+ */
+struct DhcpLeaseCache {
+    uint32_t ip;                // 0 = no lease
+    uint32_t gateway;
+    uint32_t subnet;
+    uint32_t dns1;
+    uint32_t dns2;
+    uint32_t obtainedAt;        // System time (s) when the lease was obtained
+    uint32_t leaseSeconds;      // Lease time offered by the server
+    uint32_t networkHash;       // networkCacheHash() of the SSID
+    uint8_t bssid[6];           // Access point the lease was obtained through
+    uint8_t reserved[2];
+};
+
+/**
+ * @brief One resolved host name
+ */
+struct DnsCacheEntry {
+    char host[DNS_CACHE_HOST_SIZE];     // Empty = free slot
+    uint32_t ip;
+    uint32_t resolvedAt;                // System time (s)
+};
+
+struct NetworkCache {
+    uint8_t version;            // NETWORK_CACHE_VERSION (0 after a cold boot = invalid)
+    uint8_t reserved[3];
+    DhcpLeaseCache lease;
+    DnsCacheEntry dns[DNS_CACHE_ENTRIES];
+};
+
+/**
+ * @brief Reset to "no lease, nothing resolved"
+ */
+void initNetworkCache(NetworkCache& cache);
+
+/**
+ * @brief Check a cache read from RTC memory
+ * @return false if it must be re-initialized
+ */
+bool isNetworkCacheValid(const NetworkCache& cache);
+
+/**
+ * @brief FNV-1a of a network name (SSID), never 0
+ */
+uint32_t networkCacheHash(const char* name);
+
+/**
+ * @brief Remember the lease obtained by DHCP
+ * @param leaseSeconds Server lease time, 0 = unknown (DHCP_LEASE_DEFAULT_SECONDS)
+ */
+void storeDhcpLease(NetworkCache& cache, const DhcpLeaseCache& lease, uint32_t leaseSeconds,
+                    uint32_t networkHash, const uint8_t* bssid, uint32_t now);
+
+/**
+ * @brief Find a lease that can be applied as a static configuration
+ *
+ * Same SSID and access point, clock not moved backwards, and less than half
+ * the lease time elapsed.
+ *
+ * @return nullptr if DHCP must run
+ */
+const DhcpLeaseCache* getReusableDhcpLease(const NetworkCache& cache, uint32_t networkHash,
+                                           const uint8_t* bssid, uint32_t now);
+
+/**
+ * @brief Forget the lease (connect with it failed)
+ */
+void invalidateDhcpLease(NetworkCache& cache);
+
+/**
+ * @brief Look up a host name (case-insensitive)
+ * @param outIp Receives the address on a hit
+ * @return false if not cached or expired
+ */
+bool lookupDnsCache(const NetworkCache& cache, const char* host, uint32_t now, uint32_t& outIp);
+
+/**
+ * @brief Remember a resolved host, replacing its old entry, a free slot or the oldest entry
+ * @return false if the name does not fit DNS_CACHE_HOST_SIZE or the address is 0
+ */
+bool storeDnsCache(NetworkCache& cache, const char* host, uint32_t ip, uint32_t now);
+
+/**
+ * @brief Forget a host (connect to the cached address failed)
+ */
+void invalidateDnsCache(NetworkCache& cache, const char* host);
+
+#endif // NETWORK_CACHE_H
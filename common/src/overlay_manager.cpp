@@ -140,6 +140,12 @@ void OverlayManager::renderOverlay(const DashboardConfig& config,
     } else {
         textColor = 0;  // Black
     }
+#ifndef DISPLAY_MODE_INKPLATE2
+    if (_display->getDisplayMode() == INKPLATE_1BIT) {
+        // Partial refresh mode draws black/white only
+        textColor = textColor >= 4 ? WHITE : BLACK;
+    }
+#endif
     
     // Build overlay text string
     String overlayText = "";
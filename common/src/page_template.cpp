@@ -0,0 +1,107 @@
+#include <page_template.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+TemplateWriter::TemplateWriter(char* buffer, size_t size, FlushCallback flush, void* context)
+    : _buffer(buffer), _size(size), _used(0), _total(0), _flushes(0), _flush(flush), _context(context) {
+}
+
+void TemplateWriter::write(const char* text) {
+    if (text != nullptr) {
+        write(text, strlen(text));
+    }
+}
+
+void TemplateWriter::write(const char* data, size_t length) {
+    _total += length;
+    while (length > 0) {
+        if (_used == _size) {
+            flush();
+        }
+        size_t room = _size - _used;
+        size_t count = length < room ? length : room;
+        memcpy(_buffer + _used, data, count);
+        _used += count;
+        data += count;
+        length -= count;
+    }
+}
+
+void TemplateWriter::writeEscaped(const char* text) {
+    if (text == nullptr) {
+        return;
+    }
+    const char* start = text;
+    for (const char* p = text; *p != '\0'; p++) {
+        const char* entity;
+        switch (*p) {
+            case '&': entity = "&amp;"; break;
+            case '<': entity = "&lt;"; break;
+            case '>': entity = "&gt;"; break;
+            case '"': entity = "&quot;"; break;
+            case '\'': entity = "&#39;"; break;
+            default: continue;
+        }
+        write(start, p - start);
+        write(entity);
+        start = p + 1;
+    }
+    write(start);
+}
+
+void TemplateWriter::writef(const char* format, ...) {
+    char text[64];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    if (length > 0) {
+        write(text, (size_t)length < sizeof(text) ? (size_t)length : sizeof(text) - 1);
+    }
+}
+
+void TemplateWriter::flush() {
+    if (_used == 0) {
+        return;
+    }
+    if (_flush != nullptr) {
+        _flush(_context, _buffer, _used);
+    }
+    _used = 0;
+    _flushes++;
+}
+
+static bool isNameChar(char c) {
+    return (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+void renderTemplate(TemplateWriter& out, const char* text, TemplateCallback callback, void* context) {
+    if (text == nullptr) {
+        return;
+    }
+    const char* literal = text;
+    const char* p = text;
+    while ((p = strchr(p, '%')) != nullptr) {
+        const char* name = p + 1;
+        const char* end = name;
+        while (isNameChar(*end)) {
+            end++;
+        }
+        if (*end != '%' || end == name) {
+            p++;  // Plain %
+            continue;
+        }
+        out.write(literal, p - literal);
+        if (callback == nullptr || !callback(context, out, name, end - name)) {
+            out.write(p, end + 1 - p);
+        }
+        p = end + 1;
+        literal = p;
+    }
+    out.write(literal);
+}
+
+bool isTemplateName(const char* name, size_t length, const char* expected) {
+    return strncmp(name, expected, length) == 0 && expected[length] == '\0';
+}
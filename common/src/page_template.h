@@ -0,0 +1,88 @@
+#ifndef PAGE_TEMPLATE_H
+#define PAGE_TEMPLATE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Buffered output for streamed pages
+ *
+ * Pure C++ with NO dependencies on Arduino/ESP32 APIs, making it fully
+ * testable with standard C++ unit testing frameworks.
+ *
+ * Collects output in a caller-provided buffer and hands it to the flush
+ * callback whenever the buffer is full (on the device: one chunk of a
+ * chunked HTTP response). Memory use is the buffer, whatever the page size;
+ * nothing is allocated.
+ */
+class TemplateWriter {
+public:
+    // Receives the buffered output in order
+    typedef void (*FlushCallback)(void* context, const char* data, size_t length);
+
+    TemplateWriter(char* buffer, size_t size, FlushCallback flush, void* context);
+
+    void write(const char* text);
+    void write(const char* data, size_t length);
+
+    /**
+     * @brief Write text for an HTML attribute value or element content
+     * & < > " ' are written as character references
+     */
+    void writeEscaped(const char* text);
+
+    /**
+     * @brief printf-style write (up to 63 characters per call)
+     */
+    void writef(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+    /**
+     * @brief Pass the buffered output to the flush callback
+     */
+    void flush();
+
+    size_t getTotalWritten() const { return _total; }
+    uint32_t getFlushCount() const { return _flushes; }
+
+private:
+    char* _buffer;
+    size_t _size;
+    size_t _used;
+    size_t _total;
+    uint32_t _flushes;
+    FlushCallback _flush;
+    void* _context;
+};
+
+/**
+ * @brief Writes the value of one placeholder
+ *
+ * @param context Caller context passed to renderTemplate()
+ * @param out Writer to append the value to
+ * @param name Placeholder name (not terminated)
+ * @param length Length of name
+ * @return false if the name is unknown (the placeholder is written as is)
+ */
+typedef bool (*TemplateCallback)(void* context, TemplateWriter& out, const char* name, size_t length);
+
+/**
+ * @brief Stream a template, substituting %NAME% placeholders
+ *
+ * A placeholder is % followed by upper case letters, digits or _ and a
+ * closing %; any other % (e.g. "width: 100%") is copied. Text between
+ * placeholders is written straight from the template, which may live in
+ * flash. Callbacks may render nested templates.
+ *
+ * @param out Writer
+ * @param text Template (terminated)
+ * @param callback Placeholder values
+ * @param context Passed to callback
+ */
+void renderTemplate(TemplateWriter& out, const char* text, TemplateCallback callback, void* context);
+
+/**
+ * @brief Compare a placeholder name from a TemplateCallback
+ */
+bool isTemplateName(const char* name, size_t length, const char* expected);
+
+#endif // PAGE_TEMPLATE_H
@@ -0,0 +1,61 @@
+#include "pipeline_task.h"
+#include "logger.h"
+
+FreeRTOSTaskRunner::FreeRTOSTaskRunner()
+    : _stage(nullptr), _arg(nullptr), _done(nullptr), _running(false) {
+}
+
+FreeRTOSTaskRunner::~FreeRTOSTaskRunner() {
+    // A timed-out task still gives the semaphore when it finishes - keep it alive
+    // (the device goes to deep sleep right after a timeout anyway)
+    if (_done != nullptr && !_running) {
+        vSemaphoreDelete(_done);
+    }
+}
+
+void FreeRTOSTaskRunner::taskEntry(void* param) {
+    FreeRTOSTaskRunner* self = static_cast<FreeRTOSTaskRunner*>(param);
+    self->_stage(self->_arg);
+    xSemaphoreGive(self->_done);
+    vTaskDelete(NULL);
+}
+
+bool FreeRTOSTaskRunner::start(PipelineStage stage, void* arg) {
+    if (_running) {
+        return false;  // One background stage at a time
+    }
+    if (_done == nullptr) {
+        _done = xSemaphoreCreateBinary();
+        if (_done == nullptr) {
+            return false;
+        }
+    }
+    
+    _stage = stage;
+    _arg = arg;
+    
+    BaseType_t otherCore = xPortGetCoreID() == 0 ? 1 : 0;
+    BaseType_t created = xTaskCreatePinnedToCore(taskEntry, "cycle_bg", PIPELINE_TASK_STACK_SIZE, this,
+                                                 PIPELINE_TASK_PRIORITY, NULL, otherCore);
+    if (created != pdPASS) {
+        Logger::message("Cycle Pipeline", "Could not create background task - running serially");
+        return false;
+    }
+    _running = true;
+    return true;
+}
+
+bool FreeRTOSTaskRunner::join(uint32_t timeoutMs) {
+    if (!_running) {
+        return true;
+    }
+    if (xSemaphoreTake(_done, pdMS_TO_TICKS(timeoutMs)) != pdTRUE) {
+        return false;  // Still running - stays marked as running
+    }
+    _running = false;
+    return true;
+}
+
+uint32_t FreeRTOSTaskRunner::nowMs() {
+    return millis();
+}
@@ -0,0 +1,38 @@
+#ifndef PIPELINE_TASK_H
+#define PIPELINE_TASK_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include "cycle_pipeline.h"
+
+#define PIPELINE_TASK_STACK_SIZE 8192   // MQTT connect + discovery (String building, lwIP calls)
+#define PIPELINE_TASK_PRIORITY 1        // Same as the Arduino loop task
+
+/**
+ * @brief FreeRTOS task layer for CyclePipeline
+ *
+ * Runs the background stage in a task pinned to the core the caller is NOT
+ * running on (core 0 for the Arduino loop, where the WiFi stack already
+ * lives) and signals completion through a binary semaphore.
+ */
+class FreeRTOSTaskRunner : public PipelineTaskRunner {
+public:
+    FreeRTOSTaskRunner();
+    ~FreeRTOSTaskRunner();
+    
+    bool start(PipelineStage stage, void* arg) override;
+    bool join(uint32_t timeoutMs) override;
+    uint32_t nowMs() override;
+    
+private:
+    PipelineStage _stage;
+    void* _arg;
+    SemaphoreHandle_t _done;
+    bool _running;
+    
+    static void taskEntry(void* param);
+};
+
+#endif // PIPELINE_TASK_H
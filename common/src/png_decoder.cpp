@@ -0,0 +1,546 @@
+#include <png_decoder.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PNG_MAX_WIDTH 8192
+
+#define CHUNK_IHDR 0x49484452UL
+#define CHUNK_PLTE 0x504C5445UL
+#define CHUNK_tRNS 0x74524E53UL
+#define CHUNK_IDAT 0x49444154UL
+#define CHUNK_IEND 0x49454E44UL
+
+static const uint8_t PNG_SIGNATURE[8] = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A };
+
+static uint32_t readBigEndian32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+PngStreamDecoder::PngStreamDecoder()
+    : _sink(nullptr), _state(STATE_SIGNATURE), _error(nullptr),
+      _palette(nullptr), _paletteAlpha(nullptr), _rowBuffer(nullptr) {
+    begin(nullptr);
+}
+
+PngStreamDecoder::~PngStreamDecoder() {
+    end();
+}
+
+void PngStreamDecoder::begin(ImageRowSink* sink) {
+    end();
+    _sink = sink;
+    _state = STATE_SIGNATURE;
+    _error = nullptr;
+    _headerFill = 0;
+    _chunkLength = 0;
+    _chunkRemaining = 0;
+    _chunkType = 0;
+    _chunkOffset = 0;
+    _seenHeader = false;
+    _width = 0;
+    _height = 0;
+    _bitDepth = 0;
+    _colorType = 0;
+    _channels = 0;
+    _paletteSize = 0;
+    _trnsLength = 0;
+    _zlibHeaderFill = 0;
+    _zlibCMF = 0;
+    _prevRow = nullptr;
+    _curRow = nullptr;
+    _grayRow = nullptr;
+    _rowBytes = 0;
+    _filterBpp = 1;
+    _rowFill = 0;
+    _filterType = 0;
+    _y = 0;
+}
+
+void PngStreamDecoder::end() {
+    _inflate.end();
+    free(_rowBuffer);
+    free(_palette);
+    free(_paletteAlpha);
+    _rowBuffer = nullptr;
+    _palette = nullptr;
+    _paletteAlpha = nullptr;
+}
+
+size_t PngStreamDecoder::getMemoryUsage() const {
+    size_t total = _inflate.getMemoryUsage();
+    if (_rowBuffer != nullptr) {
+        total += 2 * _rowBytes + _width;
+    }
+    if (_palette != nullptr) {
+        total += 512;
+    }
+    return total;
+}
+
+DecodeStatus PngStreamDecoder::status() const {
+    switch (_state) {
+        case STATE_DONE:        return DECODE_DONE;
+        case STATE_UNSUPPORTED: return DECODE_UNSUPPORTED;
+        case STATE_ERROR:       return DECODE_ERROR;
+        default:                return DECODE_OK;
+    }
+}
+
+DecodeStatus PngStreamDecoder::fail(const char* message) {
+    _state = STATE_ERROR;
+    _error = message;
+    return DECODE_ERROR;
+}
+
+DecodeStatus PngStreamDecoder::unsupported(const char* message) {
+    _state = STATE_UNSUPPORTED;
+    _error = message;
+    return DECODE_UNSUPPORTED;
+}
+
+DecodeStatus PngStreamDecoder::feed(const uint8_t* data, size_t length) {
+    size_t pos = 0;
+
+    while (pos < length && _state < STATE_DONE) {
+        switch (_state) {
+            case STATE_SIGNATURE:
+                while (pos < length && _headerFill < 8) {
+                    _header[_headerFill++] = data[pos++];
+                }
+                if (_headerFill == 8) {
+                    if (memcmp(_header, PNG_SIGNATURE, 8) != 0) {
+                        return fail("Not a PNG file");
+                    }
+                    _headerFill = 0;
+                    _state = STATE_CHUNK_HEADER;
+                }
+                break;
+
+            case STATE_CHUNK_HEADER:
+                while (pos < length && _headerFill < 8) {
+                    _header[_headerFill++] = data[pos++];
+                }
+                if (_headerFill == 8) {
+                    _chunkLength = readBigEndian32(_header);
+                    _chunkType = readBigEndian32(_header + 4);
+                    _chunkRemaining = _chunkLength;
+                    _chunkOffset = 0;
+                    _headerFill = 0;
+
+                    if (_chunkLength > 0x7FFFFFFFUL) {
+                        return fail("Invalid PNG chunk length");
+                    }
+                    if (!_seenHeader && _chunkType != CHUNK_IHDR) {
+                        return fail("PNG missing IHDR");
+                    }
+                    if (_chunkType == CHUNK_IHDR && _chunkLength != 13) {
+                        return fail("Invalid IHDR length");
+                    }
+                    if (_chunkType == CHUNK_IEND) {
+                        // Image data ended before all rows were produced
+                        _inflate.feed(nullptr, 0, true);
+                        if (_state < STATE_DONE) {
+                            return fail("PNG image data truncated");
+                        }
+                        return status();
+                    }
+                    _state = _chunkLength > 0 ? STATE_CHUNK_DATA : STATE_CHUNK_CRC;
+                }
+                break;
+
+            case STATE_CHUNK_DATA: {
+                size_t take = length - pos;
+                if (take > _chunkRemaining) {
+                    take = _chunkRemaining;
+                }
+                consumeChunkData(data + pos, take);
+                pos += take;
+                _chunkRemaining -= take;
+                _chunkOffset += take;
+                if (_chunkRemaining == 0 && _state == STATE_CHUNK_DATA) {
+                    if (_chunkType == CHUNK_IHDR && !parseHeader()) {
+                        break;
+                    }
+                    _state = STATE_CHUNK_CRC;
+                }
+                break;
+            }
+
+            case STATE_CHUNK_CRC:
+                // CRCs are not verified: the transport is already checksummed and
+                // corrupt image data still fails in inflate.
+                while (pos < length && _headerFill < 4) {
+                    _headerFill++;
+                    pos++;
+                }
+                if (_headerFill == 4) {
+                    _headerFill = 0;
+                    _state = STATE_CHUNK_HEADER;
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    return status();
+}
+
+void PngStreamDecoder::consumeChunkData(const uint8_t* data, size_t length) {
+    switch (_chunkType) {
+        case CHUNK_IHDR:
+            memcpy(_header + _chunkOffset, data, length);
+            break;
+
+        case CHUNK_PLTE:
+            if (_palette == nullptr) {
+                _palette = (uint8_t*)malloc(256);
+                _paletteAlpha = (uint8_t*)malloc(256);
+                if (_palette == nullptr || _paletteAlpha == nullptr) {
+                    fail("Out of memory for PNG palette");
+                    return;
+                }
+                memset(_palette, 255, 256);
+                memset(_paletteAlpha, 255, 256);
+            }
+            for (size_t i = 0; i < length; i++) {
+                uint32_t offset = _chunkOffset + i;
+                _paletteRGB[offset % 3] = data[i];
+                if (offset % 3 == 2 && offset / 3 < 256) {
+                    _palette[offset / 3] = rgbToGray(_paletteRGB[0], _paletteRGB[1], _paletteRGB[2]);
+                    _paletteSize = (uint16_t)(offset / 3 + 1);
+                }
+            }
+            break;
+
+        case CHUNK_tRNS:
+            for (size_t i = 0; i < length; i++) {
+                uint32_t offset = _chunkOffset + i;
+                if (_colorType == 3) {
+                    if (_paletteAlpha != nullptr && offset < 256) {
+                        _paletteAlpha[offset] = data[i];
+                    }
+                } else if (offset < sizeof(_trns)) {
+                    _trns[offset] = data[i];
+                    _trnsLength = (uint8_t)(offset + 1);
+                }
+            }
+            break;
+
+        case CHUNK_IDAT:
+            consumeIDAT(data, length);
+            break;
+
+        default:
+            // Ancillary chunks (gAMA, pHYs, tEXt, ...) are skipped
+            break;
+    }
+}
+
+bool PngStreamDecoder::parseHeader() {
+    _width = readBigEndian32(_header);
+    _height = readBigEndian32(_header + 4);
+    _bitDepth = _header[8];
+    _colorType = _header[9];
+    uint8_t compression = _header[10];
+    uint8_t filter = _header[11];
+    uint8_t interlace = _header[12];
+    _seenHeader = true;
+
+    if (_width == 0 || _height == 0 || _width > PNG_MAX_WIDTH || _height > 0xFFFF) {
+        fail("Unsupported PNG dimensions");
+        return false;
+    }
+    if (compression != 0 || filter != 0 || interlace > 1) {
+        fail("Invalid PNG header");
+        return false;
+    }
+
+    bool validDepth = false;
+    switch (_colorType) {
+        case 0:
+            _channels = 1;
+            validDepth = _bitDepth == 1 || _bitDepth == 2 || _bitDepth == 4 || _bitDepth == 8 || _bitDepth == 16;
+            break;
+        case 2:
+            _channels = 3;
+            validDepth = _bitDepth == 8 || _bitDepth == 16;
+            break;
+        case 3:
+            _channels = 1;
+            validDepth = _bitDepth == 1 || _bitDepth == 2 || _bitDepth == 4 || _bitDepth == 8;
+            break;
+        case 4:
+            _channels = 2;
+            validDepth = _bitDepth == 8 || _bitDepth == 16;
+            break;
+        case 6:
+            _channels = 4;
+            validDepth = _bitDepth == 8 || _bitDepth == 16;
+            break;
+        default:
+            break;
+    }
+    if (!validDepth) {
+        fail("Invalid PNG color type or bit depth");
+        return false;
+    }
+
+    if (interlace == 1) {
+        // Adam7 passes cannot be turned into top-to-bottom rows without
+        // buffering the entire image
+        unsupported("Interlaced PNG not supported for streaming");
+        return false;
+    }
+    return true;
+}
+
+bool PngStreamDecoder::startImage() {
+    uint32_t bitsPerPixel = (uint32_t)_channels * _bitDepth;
+    _rowBytes = (_width * bitsPerPixel + 7) / 8;
+    _filterBpp = (uint8_t)(bitsPerPixel >= 8 ? bitsPerPixel / 8 : 1);
+
+    _rowBuffer = (uint8_t*)malloc(2 * _rowBytes + _width);
+    if (_rowBuffer == nullptr) {
+        fail("Out of memory for PNG rows");
+        return false;
+    }
+    _prevRow = _rowBuffer;
+    _curRow = _rowBuffer + _rowBytes;
+    _grayRow = _rowBuffer + 2 * _rowBytes;
+    memset(_prevRow, 0, _rowBytes);
+
+    if (!_inflate.begin(onInflated, this)) {
+        fail(_inflate.getError());
+        return false;
+    }
+
+    if (_colorType == 3) {
+        if (_palette == nullptr) {
+            fail("PNG palette missing");
+            return false;
+        }
+        preparePalette();
+    }
+
+    if (_sink != nullptr && !_sink->begin((uint16_t)_width, (uint16_t)_height)) {
+        fail("Image sink rejected dimensions");
+        return false;
+    }
+    return true;
+}
+
+void PngStreamDecoder::preparePalette() {
+    // Fold tRNS alpha into the palette once instead of per pixel
+    for (uint16_t i = 0; i < 256; i++) {
+        _palette[i] = compositeOnWhite(_palette[i], _paletteAlpha[i]);
+    }
+}
+
+void PngStreamDecoder::consumeIDAT(const uint8_t* data, size_t length) {
+    size_t pos = 0;
+
+    // Strip the 2-byte zlib header on the first IDAT bytes
+    while (_zlibHeaderFill < 2 && pos < length) {
+        if (_zlibHeaderFill == 0) {
+            if (!startImage()) {
+                return;
+            }
+            _zlibCMF = data[pos];
+        } else {
+            uint8_t flg = data[pos];
+            if ((_zlibCMF & 0x0F) != 8 || ((_zlibCMF << 8) | flg) % 31 != 0 || (flg & 0x20)) {
+                fail("Invalid zlib header in PNG");
+                return;
+            }
+        }
+        _zlibHeaderFill++;
+        pos++;
+    }
+
+    if (pos < length) {
+        // Trailing Adler-32 after the final deflate block is ignored
+        InflateStatus result = _inflate.feed(data + pos, length - pos);
+        if (result == INFLATE_ERROR && _state < STATE_DONE) {
+            fail(_inflate.getError());
+        }
+    }
+}
+
+void PngStreamDecoder::onInflated(void* context, const uint8_t* data, size_t length) {
+    static_cast<PngStreamDecoder*>(context)->consumeScanlines(data, length);
+}
+
+void PngStreamDecoder::consumeScanlines(const uint8_t* data, size_t length) {
+    size_t pos = 0;
+    while (pos < length && _state < STATE_DONE) {
+        if (_rowFill == 0) {
+            _filterType = data[pos++];
+            if (_filterType > 4) {
+                fail("Invalid PNG filter type");
+                return;
+            }
+            _rowFill = 1;
+            continue;
+        }
+
+        size_t need = _rowBytes - (_rowFill - 1);
+        size_t take = length - pos;
+        if (take > need) {
+            take = need;
+        }
+        memcpy(_curRow + (_rowFill - 1), data + pos, take);
+        pos += take;
+        _rowFill += take;
+
+        if (_rowFill - 1 == _rowBytes) {
+            unfilterRow();
+            emitRow();
+
+            uint8_t* swap = _prevRow;
+            _prevRow = _curRow;
+            _curRow = swap;
+            _rowFill = 0;
+
+            if (++_y == _height) {
+                _state = STATE_DONE;
+            }
+        }
+    }
+}
+
+void PngStreamDecoder::unfilterRow() {
+    uint8_t* cur = _curRow;
+    const uint8_t* prev = _prevRow;
+    uint32_t n = _rowBytes;
+    uint8_t bpp = _filterBpp;
+
+    switch (_filterType) {
+        case 1:  // Sub
+            for (uint32_t i = bpp; i < n; i++) {
+                cur[i] = (uint8_t)(cur[i] + cur[i - bpp]);
+            }
+            break;
+        case 2:  // Up
+            for (uint32_t i = 0; i < n; i++) {
+                cur[i] = (uint8_t)(cur[i] + prev[i]);
+            }
+            break;
+        case 3:  // Average
+            for (uint32_t i = 0; i < n; i++) {
+                uint8_t left = i >= bpp ? cur[i - bpp] : 0;
+                cur[i] = (uint8_t)(cur[i] + ((left + prev[i]) >> 1));
+            }
+            break;
+        case 4:  // Paeth
+            for (uint32_t i = 0; i < n; i++) {
+                int a = i >= bpp ? cur[i - bpp] : 0;
+                int b = prev[i];
+                int c = i >= bpp ? prev[i - bpp] : 0;
+                int p = a + b - c;
+                int pa = abs(p - a);
+                int pb = abs(p - b);
+                int pc = abs(p - c);
+                int predictor = (pa <= pb && pa <= pc) ? a : (pb <= pc) ? b : c;
+                cur[i] = (uint8_t)(cur[i] + predictor);
+            }
+            break;
+        default:  // None
+            break;
+    }
+}
+
+void PngStreamDecoder::emitRow() {
+    const uint8_t* src = _curRow;
+    uint8_t* out = _grayRow;
+    uint32_t w = _width;
+
+    switch (_colorType) {
+        case 0: {  // Grayscale
+            bool hasKey = _trnsLength >= 2;
+            uint16_t key = (uint16_t)((_trns[0] << 8) | _trns[1]);
+            if (_bitDepth == 16) {
+                for (uint32_t x = 0; x < w; x++) {
+                    uint16_t sample = (uint16_t)((src[2 * x] << 8) | src[2 * x + 1]);
+                    out[x] = (hasKey && sample == key) ? 255 : src[2 * x];
+                }
+            } else if (_bitDepth == 8) {
+                for (uint32_t x = 0; x < w; x++) {
+                    out[x] = (hasKey && src[x] == key) ? 255 : src[x];
+                }
+            } else {
+                uint8_t depth = _bitDepth;
+                uint8_t mask = (uint8_t)((1 << depth) - 1);
+                uint8_t scale = (uint8_t)(255 / mask);
+                for (uint32_t x = 0; x < w; x++) {
+                    uint32_t bit = x * depth;
+                    uint8_t sample = (src[bit >> 3] >> (8 - depth - (bit & 7))) & mask;
+                    out[x] = (hasKey && sample == key) ? 255 : (uint8_t)(sample * scale);
+                }
+            }
+            break;
+        }
+
+        case 2: {  // RGB
+            bool hasKey = _trnsLength >= 6;
+            if (_bitDepth == 16) {
+                for (uint32_t x = 0; x < w; x++) {
+                    const uint8_t* p = src + 6 * x;
+                    bool transparent = hasKey && memcmp(p, _trns, 6) == 0;
+                    out[x] = transparent ? 255 : rgbToGray(p[0], p[2], p[4]);
+                }
+            } else {
+                for (uint32_t x = 0; x < w; x++) {
+                    const uint8_t* p = src + 3 * x;
+                    bool transparent = hasKey && p[0] == _trns[1] && p[1] == _trns[3] && p[2] == _trns[5];
+                    out[x] = transparent ? 255 : rgbToGray(p[0], p[1], p[2]);
+                }
+            }
+            break;
+        }
+
+        case 3: {  // Palette
+            if (_bitDepth == 8) {
+                for (uint32_t x = 0; x < w; x++) {
+                    out[x] = _palette[src[x]];
+                }
+            } else {
+                uint8_t depth = _bitDepth;
+                uint8_t mask = (uint8_t)((1 << depth) - 1);
+                for (uint32_t x = 0; x < w; x++) {
+                    uint32_t bit = x * depth;
+                    out[x] = _palette[(src[bit >> 3] >> (8 - depth - (bit & 7))) & mask];
+                }
+            }
+            break;
+        }
+
+        case 4: {  // Gray + alpha
+            uint8_t step = _bitDepth == 16 ? 4 : 2;
+            uint8_t alphaOffset = _bitDepth == 16 ? 2 : 1;
+            for (uint32_t x = 0; x < w; x++) {
+                const uint8_t* p = src + step * x;
+                out[x] = compositeOnWhite(p[0], p[alphaOffset]);
+            }
+            break;
+        }
+
+        case 6: {  // RGBA
+            uint8_t step = _bitDepth == 16 ? 8 : 4;
+            uint8_t channel = _bitDepth == 16 ? 2 : 1;
+            for (uint32_t x = 0; x < w; x++) {
+                const uint8_t* p = src + step * x;
+                out[x] = compositeOnWhite(rgbToGray(p[0], p[channel], p[2 * channel]), p[3 * channel]);
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    if (_sink != nullptr) {
+        _sink->writeRow((uint16_t)_y, out, (uint16_t)w);
+    }
+}
@@ -0,0 +1,120 @@
+#ifndef PNG_DECODER_H
+#define PNG_DECODER_H
+
+#include <image_decoder.h>
+#include <inflate_stream.h>
+
+/**
+ * @brief Incremental PNG decoder producing grayscale rows
+ *
+ * Pure C++ with NO dependencies on Arduino/ESP32 APIs.
+ *
+ * Supports every non-interlaced PNG: grayscale, RGB, palette, gray+alpha and
+ * RGBA at all legal bit depths, including tRNS transparency. Transparent
+ * pixels are composited onto white (the e-paper background). Interlaced
+ * (Adam7) images need the whole image in memory and are reported as
+ * DECODE_UNSUPPORTED so the caller can fall back.
+ *
+ * Memory: inflate window (~35 KB) + two scanlines + one gray row.
+ */
+class PngStreamDecoder {
+public:
+    PngStreamDecoder();
+    ~PngStreamDecoder();
+
+    /**
+     * @brief Reset state for a new image
+     * @param sink Receives decoded rows (must outlive decoding)
+     */
+    void begin(ImageRowSink* sink);
+
+    /**
+     * @brief Release all buffers
+     */
+    void end();
+
+    /**
+     * @brief Decode the next chunk of the file
+     * @return DECODE_OK, DECODE_DONE, DECODE_UNSUPPORTED or DECODE_ERROR
+     */
+    DecodeStatus feed(const uint8_t* data, size_t length);
+
+    const char* getError() const { return _error; }
+    uint16_t getWidth() const { return (uint16_t)_width; }
+    uint16_t getHeight() const { return (uint16_t)_height; }
+
+    // Bytes of heap currently held (inflate window + row buffers)
+    size_t getMemoryUsage() const;
+
+private:
+    enum State {
+        STATE_SIGNATURE,
+        STATE_CHUNK_HEADER,
+        STATE_CHUNK_DATA,
+        STATE_CHUNK_CRC,
+        STATE_DONE,
+        STATE_UNSUPPORTED,
+        STATE_ERROR
+    };
+
+    ImageRowSink* _sink;
+    InflateStream _inflate;
+    State _state;
+    const char* _error;
+
+    // Chunk framing
+    uint8_t _header[13];        // Signature, chunk header or IHDR payload
+    uint8_t _headerFill;
+    uint32_t _chunkLength;
+    uint32_t _chunkRemaining;
+    uint32_t _chunkType;
+    uint32_t _chunkOffset;
+    bool _seenHeader;
+
+    // IHDR
+    uint32_t _width;
+    uint32_t _height;
+    uint8_t _bitDepth;
+    uint8_t _colorType;
+    uint8_t _channels;
+
+    // Palette and transparency
+    uint8_t _paletteRGB[3];
+    uint8_t* _palette;          // 256 composited gray values (palette images only)
+    uint8_t* _paletteAlpha;     // 256 alpha values (palette images only)
+    uint16_t _paletteSize;
+    uint8_t _trns[6];
+    uint8_t _trnsLength;
+
+    // zlib wrapper
+    uint8_t _zlibHeaderFill;
+    uint8_t _zlibCMF;
+
+    // Scanline reconstruction
+    uint8_t* _rowBuffer;        // prev row | current row | gray output
+    uint8_t* _prevRow;
+    uint8_t* _curRow;
+    uint8_t* _grayRow;
+    uint32_t _rowBytes;
+    uint8_t _filterBpp;
+    uint32_t _rowFill;          // 0 = expecting filter byte
+    uint8_t _filterType;
+    uint32_t _y;
+
+    DecodeStatus status() const;
+    DecodeStatus fail(const char* message);
+    DecodeStatus unsupported(const char* message);
+
+    bool parseHeader();
+    void consumeChunkData(const uint8_t* data, size_t length);
+    void consumeIDAT(const uint8_t* data, size_t length);
+    bool startImage();
+    void preparePalette();
+
+    static void onInflated(void* context, const uint8_t* data, size_t length);
+    void consumeScanlines(const uint8_t* data, size_t length);
+    void unfilterRow();
+    void emitRow();
+};
+
+#endif // PNG_DECODER_H
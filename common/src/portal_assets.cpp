@@ -0,0 +1,51 @@
+#include <portal_assets.h>
+#include <string.h>
+
+static bool isListSpace(char c) {
+    return c == ' ' || c == '\t';
+}
+
+bool portalETagMatches(const char* ifNoneMatch, const char* etag) {
+    if (ifNoneMatch == nullptr || etag == nullptr || etag[0] == '\0') {
+        return false;
+    }
+    size_t etagLength = strlen(etag);
+    const char* p = ifNoneMatch;
+    while (*p != '\0') {
+        while (isListSpace(*p) || *p == ',') {
+            p++;
+        }
+        if (*p == '\0') {
+            break;
+        }
+        if (*p == '*') {
+            return true;
+        }
+        if (p[0] == 'W' && p[1] == '/') {
+            p += 2;  // Weak comparison
+        }
+
+        // Tag runs to the closing quote (commas may appear inside quotes)
+        const char* start = p;
+        if (*p == '"') {
+            p++;
+            while (*p != '\0' && *p != '"') {
+                p++;
+            }
+            if (*p == '"') {
+                p++;
+            }
+        } else {
+            while (*p != '\0' && *p != ',' && !isListSpace(*p)) {
+                p++;
+            }
+        }
+        if ((size_t)(p - start) == etagLength && strncmp(start, etag, etagLength) == 0) {
+            return true;
+        }
+        while (*p != '\0' && *p != ',') {
+            p++;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,47 @@
+#ifndef PORTAL_ASSETS_H
+#define PORTAL_ASSETS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Asset URLs carry ?v=<etag> (see config_portal_assets.h), so a browser may
+// keep them for a year: a firmware with other assets links other URLs
+#define PORTAL_ASSET_CACHE_CONTROL "public, max-age=31536000, immutable"
+
+/**
+ * @brief One pre-compressed config portal asset (stylesheet or script)
+ *
+ * Instances are generated by scripts/generate_portal_assets.py from
+ * config_portal_css.h / config_portal_js.h: the source is minified and
+ * gzipped at build time and stored in flash, so a request is answered with
+ * the stored bytes and no heap copy.
+ */
+struct PortalAsset {
+    const char* path;          // Request path, e.g. "/styles.css"
+    const char* contentType;   // MIME type of the uncompressed content
+    const char* etag;          // Quoted strong ETag: CRC32 of the uncompressed content
+    const uint8_t* data;       // gzip stream (in flash)
+    size_t length;             // Bytes of gzip stream
+    size_t originalLength;     // Bytes of the minified, uncompressed content
+};
+
+/**
+ * @brief Pure asset function
+ *
+ * This function contains NO dependencies on Arduino/ESP32 APIs,
+ * making them fully testable with standard C++ unit testing frameworks.
+ */
+
+/**
+ * @brief Check an If-None-Match request header against an ETag
+ *
+ * Accepts "*", a single tag or a comma-separated list; weak tags (W/"...")
+ * match their strong counterpart, as RFC 9110 asks for If-None-Match.
+ *
+ * @param ifNoneMatch Header value (nullptr or empty = not sent)
+ * @param etag Quoted ETag of the asset
+ * @return true if the browser's copy is current (answer 304 Not Modified)
+ */
+bool portalETagMatches(const char* ifNoneMatch, const char* etag);
+
+#endif // PORTAL_ASSETS_H
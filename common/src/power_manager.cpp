@@ -38,7 +38,11 @@ static Preferences prefs;
 #include "../../../boards/inkplate10/board_config.h"
 #endif
 
-PowerManager::PowerManager() : _buttonPin(0), _wakeupReason(WAKEUP_FIRST_BOOT) {
+PowerManager::PowerManager() : _buttonPin(0), _wakeupReason(WAKEUP_FIRST_BOOT), _clockManager(nullptr) {
+}
+
+void PowerManager::setClockManager(ClockManager* clockManager) {
+    _clockManager = clockManager;
 }
 
 void PowerManager::begin(uint8_t buttonPin) {
@@ -267,13 +271,19 @@ void PowerManager::enterDeepSleep(float durationSeconds, float loopTimeSeconds)
     // Configure wake sources based on refresh interval
     // If interval is 0, only button wake is enabled (button-only mode)
     bool buttonOnlyMode = (durationSeconds == 0.0);
+    uint64_t sleepDuration = 0;
     
     if (!buttonOnlyMode) {
         // Use standalone function for testable sleep calculation
-        uint64_t sleepDuration = calculateAdjustedSleepDuration(durationSeconds, loopTimeSeconds);
+        sleepDuration = calculateAdjustedSleepDuration(durationSeconds, loopTimeSeconds);
         esp_sleep_enable_timer_wakeup(sleepDuration);
     }
     
+    // Keep the requested sleep in RTC memory (wake time estimate if the clock is lost)
+    if (_clockManager != nullptr) {
+        _clockManager->recordSleep((uint32_t)(sleepDuration / 1000000ULL));
+    }
+    
     // Re-configure button wake source (if available)
     // Must be set again because esp_sleep_enable_* doesn't accumulate
     #if defined(HAS_BUTTON) && HAS_BUTTON == true
@@ -404,6 +414,33 @@ void PowerManager::markDeviceRunning() {
     prefs.end();
 }
 
+// Default power model (can be overridden per board in board_config.h)
+#ifndef POWER_ACTIVE_MA
+#define POWER_ACTIVE_MA 45
+#endif
+#ifndef POWER_WIFI_MA
+#define POWER_WIFI_MA 110
+#endif
+#ifndef POWER_DISPLAY_MA
+#define POWER_DISPLAY_MA 50
+#endif
+#ifndef POWER_SLEEP_UA
+#define POWER_SLEEP_UA 20
+#endif
+#ifndef BATTERY_CAPACITY_MAH
+#define BATTERY_CAPACITY_MAH 1200
+#endif
+
+PowerProfile PowerManager::getPowerProfile() {
+    PowerProfile profile;
+    profile.activeMa = POWER_ACTIVE_MA;
+    profile.wifiMa = POWER_WIFI_MA;
+    profile.displayMa = POWER_DISPLAY_MA;
+    profile.sleepUa = POWER_SLEEP_UA;
+    profile.batteryMah = BATTERY_CAPACITY_MAH;
+    return profile;
+}
+
 // Watchdog timer implementation
 #include <esp_task_wdt.h>
 
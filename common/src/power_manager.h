@@ -3,6 +3,8 @@
 
 #include <Arduino.h>
 #include "config.h"
+#include "energy_model.h"
+#include "clock_manager.h"
 
 // Wake up reasons
 enum WakeupReason {
@@ -27,6 +29,9 @@ public:
     // Initialize power management (configure wake sources)
     void begin(uint8_t buttonPin);
     
+    // Set clock manager (enterDeepSleep() records the requested sleep for the next wake)
+    void setClockManager(ClockManager* clockManager);
+    
     // Get the reason for waking up
     WakeupReason getWakeupReason();
     
@@ -64,6 +69,10 @@ public:
     // Returns percentage (0-100), rounded to 5% increments
     static int calculateBatteryPercentage(float voltage);
     
+    // Typical current draw of this board for the battery life model
+    // Uses POWER_* and BATTERY_CAPACITY_MAH from board_config.h
+    static PowerProfile getPowerProfile();
+    
     // Mark that device is now running (for reset button detection)
     // This sets a flag in NVS that persists across resets
     // Should be called once when device enters normal operation
@@ -81,6 +90,7 @@ public:
 private:
     uint8_t _buttonPin;
     WakeupReason _wakeupReason;
+    ClockManager* _clockManager;
     
     // Detect wakeup reason from ESP32
     WakeupReason detectWakeupReason();
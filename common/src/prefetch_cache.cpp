@@ -0,0 +1,173 @@
+#include <prefetch_cache.h>
+#include <clock_sync.h>
+#include <image_slot_table.h>
+#include <fnv1a.h>
+#include <string.h>
+
+static int findEntry(const PrefetchIndex& index, uint8_t slot) {
+    for (int i = 0; i < PREFETCH_MAX_ENTRIES; i++) {
+        if (index.entries[i].slot == slot) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void clearEntry(PrefetchEntry& entry) {
+    memset(&entry, 0, sizeof(entry));
+    entry.slot = PREFETCH_SLOT_NONE;
+}
+
+void initPrefetchIndex(PrefetchIndex& index) {
+    memset(&index, 0, sizeof(index));
+    index.version = PREFETCH_INDEX_VERSION;
+    for (int i = 0; i < PREFETCH_MAX_ENTRIES; i++) {
+        clearEntry(index.entries[i]);
+    }
+}
+
+bool isPrefetchIndexValid(const PrefetchIndex& index) {
+    if (index.version != PREFETCH_INDEX_VERSION) {
+        return false;
+    }
+    for (int i = 0; i < PREFETCH_MAX_ENTRIES; i++) {
+        uint8_t slot = index.entries[i].slot;
+        if (slot == PREFETCH_SLOT_NONE) {
+            continue;
+        }
+        if (slot >= IMAGE_SLOT_COUNT || findEntry(index, slot) != i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t prefetchUrlHash(const char* url) {
+    uint32_t hash = fnv1aString(FNV1A_OFFSET_BASIS, url);
+    return hash == 0 ? 1 : hash;
+}
+
+const PrefetchEntry* findPrefetchEntry(const PrefetchIndex& index, uint8_t slot) {
+    if (slot == PREFETCH_SLOT_NONE) {
+        return nullptr;
+    }
+    int i = findEntry(index, slot);
+    return i >= 0 ? &index.entries[i] : nullptr;
+}
+
+bool hasPrefetchedImages(const PrefetchIndex& index) {
+    for (int i = 0; i < PREFETCH_MAX_ENTRIES; i++) {
+        if (index.entries[i].slot != PREFETCH_SLOT_NONE) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint8_t planPrefetchSlots(const bool* imageStay, uint8_t imageCount, uint8_t currentIndex,
+                          uint8_t depth, uint8_t* outSlots) {
+    if (imageCount < 2 || currentIndex >= imageCount) {
+        return 0;
+    }
+    if (depth > PREFETCH_MAX_ENTRIES) {
+        depth = PREFETCH_MAX_ENTRIES;
+    }
+    uint8_t count = 0;
+    uint8_t slot = currentIndex;
+    while (count < depth && !imageStay[slot]) {
+        slot = (slot + 1) % imageCount;
+        if (slot == currentIndex) {
+            break;  // Wrapped: the slot on screen is displayed online again
+        }
+        outSlots[count++] = slot;
+    }
+    return count;
+}
+
+uint8_t retainPrefetchEntries(PrefetchIndex& index, const uint8_t* slots, const uint32_t* urlHashes,
+                              uint8_t count, uint8_t* outRemoved) {
+    uint8_t removed = 0;
+    for (int i = 0; i < PREFETCH_MAX_ENTRIES; i++) {
+        PrefetchEntry& entry = index.entries[i];
+        if (entry.slot == PREFETCH_SLOT_NONE) {
+            continue;
+        }
+        bool keep = false;
+        for (uint8_t j = 0; j < count; j++) {
+            if (slots[j] == entry.slot && urlHashes[j] == entry.urlHash) {
+                keep = true;
+                break;
+            }
+        }
+        if (!keep) {
+            outRemoved[removed++] = entry.slot;
+            clearEntry(entry);
+        }
+    }
+    return removed;
+}
+
+uint32_t getPrefetchBudget(const PrefetchIndex& index, uint8_t slot) {
+    uint32_t used = 0;
+    for (int i = 0; i < PREFETCH_MAX_ENTRIES; i++) {
+        const PrefetchEntry& entry = index.entries[i];
+        if (entry.slot != PREFETCH_SLOT_NONE && entry.slot != slot) {
+            used += entry.size;
+        }
+    }
+    return used < PREFETCH_MAX_BYTES ? PREFETCH_MAX_BYTES - used : 0;
+}
+
+bool recordPrefetchStored(PrefetchIndex& index, uint8_t slot, uint32_t urlHash, uint32_t size, uint32_t now) {
+    if (slot >= IMAGE_SLOT_COUNT) {
+        return false;
+    }
+    int i = findEntry(index, slot);
+    if (i < 0) {
+        i = findEntry(index, PREFETCH_SLOT_NONE);
+    }
+    if (i < 0) {
+        return false;
+    }
+    PrefetchEntry& entry = index.entries[i];
+    entry.slot = slot;
+    entry.urlHash = urlHash;
+    entry.size = size;
+    entry.validatedAt = now;
+    return true;
+}
+
+void recordPrefetchValidated(PrefetchIndex& index, uint8_t slot, uint32_t now) {
+    int i = findEntry(index, slot);
+    if (i >= 0 && slot != PREFETCH_SLOT_NONE) {
+        index.entries[i].validatedAt = now;
+    }
+}
+
+void removePrefetchEntry(PrefetchIndex& index, uint8_t slot) {
+    int i = findEntry(index, slot);
+    if (i >= 0 && slot != PREFETCH_SLOT_NONE) {
+        clearEntry(index.entries[i]);
+    }
+}
+
+PrefetchDisplayDecision decidePrefetchDisplay(const PrefetchIndex& index, uint8_t slot, uint32_t urlHash,
+                                              uint8_t displayedSlot, uint32_t now) {
+    const PrefetchEntry* entry = findPrefetchEntry(index, slot);
+    if (entry == nullptr) {
+        return { false, "Target slot not cached" };
+    }
+    if (entry->urlHash != urlHash) {
+        return { false, "Cached file is from a different URL" };
+    }
+    if (slot == displayedSlot) {
+        return { false, "Target slot already on screen - checking the server" };
+    }
+    if (now < CLOCK_MIN_VALID_TIME || now < entry->validatedAt) {
+        return { false, "Clock not set - cache age unknown" };
+    }
+    if (now - entry->validatedAt > PREFETCH_MAX_AGE_SECONDS) {
+        return { false, "Cached file too old - revalidating online" };
+    }
+    return { true, "Displaying prefetched image without WiFi" };
+}
@@ -0,0 +1,153 @@
+#ifndef PREFETCH_CACHE_H
+#define PREFETCH_CACHE_H
+
+#include <stdint.h>
+
+// Layout version - bump when the structs change so stale RTC contents are discarded
+#define PREFETCH_INDEX_VERSION 1
+#define PREFETCH_MAX_ENTRIES 4                  // Most carousel slots fetched ahead (portal limit)
+#define PREFETCH_MAX_BYTES (160u * 1024u)       // Flash budget (190 KB data partition), the image cache gets what is left
+#define PREFETCH_MAX_AGE_SECONDS 21600          // 6 hours - older files are not shown without revalidation
+#define PREFETCH_SLOT_NONE 0xFF                 // Free entry
+
+/**
+ * @brief Carousel images fetched ahead and shown on later wakes without WiFi
+ *
+ * Pure C++ with NO dependencies on Arduino/ESP32 APIs, making it fully
+ * testable with standard C++ unit testing frameworks.
+ *
+ * An online carousel wake downloads the images of the next slots the timer
+ * will advance to into flash (one file per slot, the downloaded bytes as
+ * they are plus the HTTP validators). The following timer wakes display
+ * those files and go back to sleep without bringing up WiFi. The next online
+ * wake revalidates the cached files with conditional GETs, so only changed
+ * images are downloaded - and written to flash - again.
+ *
+ * This index lives in RTC memory: it says which file belongs to which slot
+ * and URL, how large it is and when the server last confirmed it. The files
+ * survive a cold boot, the index does not - a zeroed index simply makes the
+ * next online wake fetch everything again.
+ *
+ * Times are the ESP32 system clock (Unix seconds), see clock_sync.h.
+ */
+
+/**
+ * @brief One cached image file
+ */
+struct PrefetchEntry {
+    uint8_t slot;               // Carousel slot, PREFETCH_SLOT_NONE = free entry
+    uint8_t reserved[3];
+    uint32_t urlHash;           // prefetchUrlHash() of the URL the file was downloaded from
+    uint32_t size;              // File size in bytes (validators + image)
+    uint32_t validatedAt;       // Time of the download or the last 304 for it
+};
+
+struct PrefetchIndex {
+    uint8_t version;            // PREFETCH_INDEX_VERSION (0 after a cold boot = invalid)
+    uint8_t reserved[3];
+    PrefetchEntry entries[PREFETCH_MAX_ENTRIES];
+};
+
+/**
+ * @brief Decision structure for showing a cached image instead of going online
+ */
+struct PrefetchDisplayDecision {
+    bool useCache;              // Display the cached file, skip WiFi for this wake
+    const char* reason;         // Human-readable reason for this decision
+};
+
+/**
+ * @brief Reset to "nothing cached"
+ */
+void initPrefetchIndex(PrefetchIndex& index);
+
+/**
+ * @brief Check an index read from RTC memory (version, slot numbers, no duplicates)
+ * @return false if it must be re-initialized
+ */
+bool isPrefetchIndexValid(const PrefetchIndex& index);
+
+/**
+ * @brief FNV-1a of an image URL, never 0
+ */
+uint32_t prefetchUrlHash(const char* url);
+
+/**
+ * @brief Find the cached file of a slot
+ * @return nullptr if the slot is not cached
+ */
+const PrefetchEntry* findPrefetchEntry(const PrefetchIndex& index, uint8_t slot);
+
+/**
+ * @brief True if any slot is cached (a timer wake may then get by without WiFi)
+ */
+bool hasPrefetchedImages(const PrefetchIndex& index);
+
+/**
+ * @brief Slots the next timer wakes will display, in that order
+ *
+ * Follows determineImageTarget(): timer wakes advance past slots without the
+ * stay flag. The walk ends after a stay slot (the carousel remains there),
+ * before it wraps around to the slot on screen now, or after depth slots.
+ *
+ * @param imageStay Stay flag per slot
+ * @param imageCount Configured images (fewer than 2 = no carousel, nothing planned)
+ * @param currentIndex Slot displayed by this wake
+ * @param depth Slots to fetch ahead (capped at PREFETCH_MAX_ENTRIES)
+ * @param outSlots Receives the slots (PREFETCH_MAX_ENTRIES entries)
+ * @return Number of slots written to outSlots
+ */
+uint8_t planPrefetchSlots(const bool* imageStay, uint8_t imageCount, uint8_t currentIndex,
+                          uint8_t depth, uint8_t* outSlots);
+
+/**
+ * @brief Evict every entry that is not planned, or was fetched from another URL
+ *
+ * @param slots Planned slots (from planPrefetchSlots)
+ * @param urlHashes prefetchUrlHash() of each planned slot's current URL
+ * @param count Number of planned slots
+ * @param outRemoved Receives the evicted slots, whose files must be deleted (PREFETCH_MAX_ENTRIES entries)
+ * @return Number of evicted slots
+ */
+uint8_t retainPrefetchEntries(PrefetchIndex& index, const uint8_t* slots, const uint32_t* urlHashes,
+                              uint8_t count, uint8_t* outRemoved);
+
+/**
+ * @brief Bytes a slot's file may use: the budget left by the other entries
+ */
+uint32_t getPrefetchBudget(const PrefetchIndex& index, uint8_t slot);
+
+/**
+ * @brief Record a file written for a slot (replaces the slot's entry or takes a free one)
+ * @return false if no entry is free (call retainPrefetchEntries() first)
+ */
+bool recordPrefetchStored(PrefetchIndex& index, uint8_t slot, uint32_t urlHash, uint32_t size, uint32_t now);
+
+/**
+ * @brief Record that the server confirmed a cached file (HTTP 304)
+ */
+void recordPrefetchValidated(PrefetchIndex& index, uint8_t slot, uint32_t now);
+
+/**
+ * @brief Forget a slot's file (download failed, file unreadable or already deleted)
+ */
+void removePrefetchEntry(PrefetchIndex& index, uint8_t slot);
+
+/**
+ * @brief Decide whether a timer wake can display a slot from the cache
+ *
+ * The file must exist for the slot's current URL, and have been confirmed by
+ * the server less than PREFETCH_MAX_AGE_SECONDS ago by a clock that is set.
+ * A slot that is already on screen is never shown from the cache: the panel
+ * has it, only an online wake can tell whether it changed.
+ *
+ * @param slot Target slot of this wake (after the carousel advance)
+ * @param urlHash prefetchUrlHash() of the slot's configured URL
+ * @param displayedSlot Slot on the panel (IMAGE_SLOT_NONE = unknown)
+ * @param now Current system time
+ * @return PrefetchDisplayDecision with useCache flag and reason
+ */
+PrefetchDisplayDecision decidePrefetchDisplay(const PrefetchIndex& index, uint8_t slot, uint32_t urlHash,
+                                              uint8_t displayedSlot, uint32_t now);
+
+#endif // PREFETCH_CACHE_H
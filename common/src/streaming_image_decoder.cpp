@@ -0,0 +1,137 @@
+#include <streaming_image_decoder.h>
+#include <string.h>
+
+ImageFormat detectImageFormat(const uint8_t* data, size_t length) {
+    static const uint8_t PNG_MAGIC[8] = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A };
+
+    if (length >= 8 && memcmp(data, PNG_MAGIC, 8) == 0) {
+        return IMAGE_FORMAT_PNG;
+    }
+    if (length >= 3 && data[0] == 0xFF && data[1] == 0xD8 && data[2] == 0xFF) {
+        return IMAGE_FORMAT_JPEG;
+    }
+    if (length >= 4 && memcmp(data, "IKFB", 4) == 0) {
+        return IMAGE_FORMAT_IKFB;
+    }
+    return IMAGE_FORMAT_UNKNOWN;
+}
+
+StreamingImageDecoder::StreamingImageDecoder(ImageRowSink* sink)
+    : _sink(sink), _format(IMAGE_FORMAT_UNKNOWN), _status(DECODE_OK), _error(nullptr),
+      _magicFill(0), _bytesFed(0), _peakMemory(0) {
+}
+
+uint16_t StreamingImageDecoder::getWidth() const {
+    switch (_format) {
+        case IMAGE_FORMAT_PNG:  return _png.getWidth();
+        case IMAGE_FORMAT_JPEG: return _jpeg.getWidth();
+        case IMAGE_FORMAT_IKFB: return _ikfb.getWidth();
+        default:                return 0;
+    }
+}
+
+uint16_t StreamingImageDecoder::getHeight() const {
+    switch (_format) {
+        case IMAGE_FORMAT_PNG:  return _png.getHeight();
+        case IMAGE_FORMAT_JPEG: return _jpeg.getHeight();
+        case IMAGE_FORMAT_IKFB: return _ikfb.getHeight();
+        default:                return 0;
+    }
+}
+
+int8_t StreamingImageDecoder::getRotation() const {
+    return _format == IMAGE_FORMAT_IKFB && _ikfb.getWidth() > 0 ? (int8_t)_ikfb.getRotation() : -1;
+}
+
+DecodeStatus StreamingImageDecoder::feed(const uint8_t* data, size_t length) {
+    if (_status != DECODE_OK) {
+        return _status;
+    }
+    _bytesFed += length;
+
+    if (_format != IMAGE_FORMAT_UNKNOWN) {
+        return dispatch(data, length);
+    }
+
+    // Collect enough bytes to recognize the format
+    size_t take = sizeof(_magic) - _magicFill;
+    if (take > length) {
+        take = length;
+    }
+    memcpy(_magic + _magicFill, data, take);
+    _magicFill += take;
+    if (_magicFill < sizeof(_magic)) {
+        return _status;
+    }
+
+    _format = detectImageFormat(_magic, _magicFill);
+    switch (_format) {
+        case IMAGE_FORMAT_PNG:
+            _png.begin(_sink);
+            break;
+        case IMAGE_FORMAT_JPEG:
+            _jpeg.begin(_sink);
+            break;
+        case IMAGE_FORMAT_IKFB:
+            _ikfb.begin(_sink);
+            break;
+        default:
+            _status = DECODE_UNSUPPORTED;
+            _error = "Unrecognized image format";
+            return _status;
+    }
+
+    // Replay the sniffed bytes, then continue with the rest of this chunk
+    if (dispatch(_magic, _magicFill) != DECODE_OK || take == length) {
+        return _status;
+    }
+    return dispatch(data + take, length - take);
+}
+
+DecodeStatus StreamingImageDecoder::dispatch(const uint8_t* data, size_t length) {
+    DecodeStatus status;
+    if (_format == IMAGE_FORMAT_PNG) {
+        status = _png.feed(data, length);
+        size_t memory = _png.getMemoryUsage();
+        if (memory > _peakMemory) _peakMemory = memory;
+    } else if (_format == IMAGE_FORMAT_JPEG) {
+        status = _jpeg.feed(data, length);
+        size_t memory = _jpeg.getMemoryUsage();
+        if (memory > _peakMemory) _peakMemory = memory;
+    } else {
+        status = _ikfb.feed(data, length);
+        size_t memory = _ikfb.getMemoryUsage();
+        if (memory > _peakMemory) _peakMemory = memory;
+    }
+    updateStatus(status);
+    return _status;
+}
+
+void StreamingImageDecoder::updateStatus(DecodeStatus status) {
+    _status = status;
+    if (status == DECODE_OK) {
+        return;
+    }
+    if (status != DECODE_DONE) {
+        _error = _format == IMAGE_FORMAT_PNG ? _png.getError()
+               : _format == IMAGE_FORMAT_JPEG ? _jpeg.getError()
+               : _ikfb.getError();
+    }
+    // Free decode buffers as soon as the outcome is known
+    _png.end();
+    _jpeg.end();
+    _ikfb.end();
+}
+
+DecodeStatus StreamingImageDecoder::finish() {
+    if (_status == DECODE_OK) {
+        _status = DECODE_ERROR;
+        _error = _format == IMAGE_FORMAT_UNKNOWN && _magicFill < sizeof(_magic)
+            ? "Image too short"
+            : "Image data truncated";
+    }
+    _png.end();
+    _jpeg.end();
+    _ikfb.end();
+    return _status;
+}
@@ -0,0 +1,82 @@
+#ifndef STREAMING_IMAGE_DECODER_H
+#define STREAMING_IMAGE_DECODER_H
+
+#include <image_decoder.h>
+#include <png_decoder.h>
+#include <jpeg_decoder.h>
+#include <ikfb_decoder.h>
+
+/**
+ * @brief Identify an image format from its leading magic bytes
+ * @param data First bytes of the file (8 bytes are enough for every format)
+ * @param length Number of bytes available
+ * @return Detected format, IMAGE_FORMAT_UNKNOWN if not recognized
+ */
+ImageFormat detectImageFormat(const uint8_t* data, size_t length);
+
+/**
+ * @brief Format-detecting front-end for the streaming decoders
+ *
+ * Pure C++ with NO dependencies on Arduino/ESP32 APIs.
+ *
+ * Sniffs the first bytes of the stream, routes everything to the PNG, JPEG or
+ * IKFB decoder and keeps simple statistics. Formats the streaming decoders do not
+ * handle (BMP, interlaced PNG, progressive JPEG, ...) end in
+ * DECODE_UNSUPPORTED so the caller can fall back to another decode path.
+ *
+ * Usage:
+ *   StreamingImageDecoder decoder(&sink);
+ *   while (data arrives) {
+ *       if (decoder.feed(buf, len) != DECODE_OK) break;
+ *   }
+ *   decoder.finish();   // DECODE_DONE if the image was complete
+ */
+class StreamingImageDecoder {
+public:
+    explicit StreamingImageDecoder(ImageRowSink* sink);
+
+    /**
+     * @brief Decode the next chunk of the file (any size, including 1 byte)
+     * @return DECODE_OK while more data is expected, otherwise the final status
+     */
+    DecodeStatus feed(const uint8_t* data, size_t length);
+
+    /**
+     * @brief Signal end of input and release decoder buffers
+     * @return DECODE_DONE if every row was produced, otherwise the failure status
+     */
+    DecodeStatus finish();
+
+    ImageFormat getFormat() const { return _format; }
+    DecodeStatus getStatus() const { return _status; }
+    const char* getError() const { return _error; }
+    uint16_t getWidth() const;
+    uint16_t getHeight() const;
+
+    // Rotation an IKFB image was rendered for, -1 for other formats
+    int8_t getRotation() const;
+
+    // Total bytes passed to feed()
+    uint32_t getBytesFed() const { return _bytesFed; }
+
+    // Highest decoder heap usage observed (excludes the sink)
+    size_t getPeakMemoryUsage() const { return _peakMemory; }
+
+private:
+    ImageRowSink* _sink;
+    PngStreamDecoder _png;
+    JpegStreamDecoder _jpeg;
+    IkfbStreamDecoder _ikfb;
+    ImageFormat _format;
+    DecodeStatus _status;
+    const char* _error;
+    uint8_t _magic[8];
+    uint8_t _magicFill;
+    uint32_t _bytesFed;
+    size_t _peakMemory;
+
+    DecodeStatus dispatch(const uint8_t* data, size_t length);
+    void updateStatus(DecodeStatus status);
+};
+
+#endif // STREAMING_IMAGE_DECODER_H
@@ -0,0 +1,171 @@
+#include <telemetry_backlog.h>
+#include <stdio.h>
+#include <string.h>
+
+#define DURATION_UNIT_MS 10             // Packed duration resolution
+#define MAX_WIFI_RETRIES 15             // 4 bits
+#define MAX_HTTP_RETRIES 3              // 2 bits each for CRC32 / image
+
+static void writeLittleEndian16(uint8_t* p, uint16_t value) {
+    p[0] = (uint8_t)(value & 0xFF);
+    p[1] = (uint8_t)(value >> 8);
+}
+
+static void writeLittleEndian32(uint8_t* p, uint32_t value) {
+    writeLittleEndian16(p, (uint16_t)(value & 0xFFFF));
+    writeLittleEndian16(p + 2, (uint16_t)(value >> 16));
+}
+
+static uint16_t readLittleEndian16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t readLittleEndian32(const uint8_t* p) {
+    return (uint32_t)readLittleEndian16(p) | ((uint32_t)readLittleEndian16(p + 2) << 16);
+}
+
+// Nearest 10 ms step, saturating at 655.35 s
+static uint16_t packDuration(uint32_t ms) {
+    uint32_t units = (ms + DURATION_UNIT_MS / 2) / DURATION_UNIT_MS;
+    return units > 0xFFFF ? 0xFFFF : (uint16_t)units;
+}
+
+static uint8_t clampCount(uint8_t value, uint8_t max) {
+    return value > max ? max : value;
+}
+
+static const char* getResultName(uint8_t result) {
+    switch (result) {
+        case TELEMETRY_RESULT_UNCHANGED: return "unchanged";
+        case TELEMETRY_RESULT_DISPLAYED: return "displayed";
+        case TELEMETRY_RESULT_WARNING: return "warning";
+        case TELEMETRY_RESULT_ERROR: return "error";
+        default: return "unknown";
+    }
+}
+
+void packTelemetryRecord(const TelemetryRecord& record, uint8_t* out) {
+    writeLittleEndian32(out, record.timestamp);
+    writeLittleEndian16(out + 4, packDuration(record.loopMs));
+    writeLittleEndian16(out + 6, packDuration(record.wifiMs));
+    writeLittleEndian16(out + 8, packDuration(record.ntpMs));
+    writeLittleEndian16(out + 10, packDuration(record.crcMs));
+    writeLittleEndian16(out + 12, packDuration(record.imageMs));
+    writeLittleEndian16(out + 14, record.batteryMillivolts);
+    out[16] = (uint8_t)record.batteryPercentage;
+    out[17] = (uint8_t)record.wifiRSSI;
+    out[18] = (uint8_t)((clampCount(record.wifiRetries, MAX_WIFI_RETRIES) << 4) |
+                        (clampCount(record.crcRetries, MAX_HTTP_RETRIES) << 2) |
+                        clampCount(record.imageRetries, MAX_HTTP_RETRIES));
+    out[19] = record.result;
+}
+
+void unpackTelemetryRecord(const uint8_t* in, TelemetryRecord& record) {
+    record.timestamp = readLittleEndian32(in);
+    record.loopMs = (uint32_t)readLittleEndian16(in + 4) * DURATION_UNIT_MS;
+    record.wifiMs = (uint32_t)readLittleEndian16(in + 6) * DURATION_UNIT_MS;
+    record.ntpMs = (uint32_t)readLittleEndian16(in + 8) * DURATION_UNIT_MS;
+    record.crcMs = (uint32_t)readLittleEndian16(in + 10) * DURATION_UNIT_MS;
+    record.imageMs = (uint32_t)readLittleEndian16(in + 12) * DURATION_UNIT_MS;
+    record.batteryMillivolts = readLittleEndian16(in + 14);
+    record.batteryPercentage = (int8_t)in[16];
+    record.wifiRSSI = (int8_t)in[17];
+    record.wifiRetries = in[18] >> 4;
+    record.crcRetries = (in[18] >> 2) & 0x03;
+    record.imageRetries = in[18] & 0x03;
+    record.result = in[19];
+}
+
+void initTelemetryBacklog(TelemetryBacklog& backlog) {
+    memset(&backlog, 0, sizeof(backlog));
+    backlog.version = TELEMETRY_BACKLOG_VERSION;
+}
+
+bool isTelemetryBacklogValid(const TelemetryBacklog& backlog) {
+    return backlog.version == TELEMETRY_BACKLOG_VERSION &&
+           backlog.head < TELEMETRY_BACKLOG_CAPACITY &&
+           backlog.count <= TELEMETRY_BACKLOG_CAPACITY;
+}
+
+bool pushTelemetryRecord(TelemetryBacklog& backlog, const TelemetryRecord& record) {
+    bool dropped = false;
+    if (backlog.count == TELEMETRY_BACKLOG_CAPACITY) {
+        // Overwrite the oldest
+        backlog.head = (backlog.head + 1) % TELEMETRY_BACKLOG_CAPACITY;
+        backlog.count--;
+        if (backlog.dropped < 0xFFFF) {
+            backlog.dropped++;
+        }
+        dropped = true;
+    }
+    uint8_t slot = (backlog.head + backlog.count) % TELEMETRY_BACKLOG_CAPACITY;
+    packTelemetryRecord(record, backlog.records[slot]);
+    backlog.count++;
+    return dropped;
+}
+
+bool getTelemetryRecord(const TelemetryBacklog& backlog, uint8_t index, TelemetryRecord& record) {
+    if (index >= backlog.count) {
+        return false;
+    }
+    unpackTelemetryRecord(backlog.records[(backlog.head + index) % TELEMETRY_BACKLOG_CAPACITY], record);
+    return true;
+}
+
+void clearTelemetryBacklog(TelemetryBacklog& backlog) {
+    backlog.head = 0;
+    backlog.count = 0;
+    backlog.dropped = 0;
+}
+
+bool shouldDeferTelemetry(const TelemetryBacklog& backlog, float batteryVoltage, int batteryPercentage,
+                          bool userWake) {
+    if (userWake || batteryVoltage <= 0 || batteryPercentage < 0 ||
+        batteryPercentage >= TELEMETRY_LOW_BATTERY_PERCENT) {
+        return false;
+    }
+    // This wake's record would fill the ring: publish and flush instead
+    return backlog.count + 1 < TELEMETRY_BACKLOG_CAPACITY;
+}
+
+size_t serializeTelemetryBacklog(const TelemetryBacklog& backlog, char* buffer, size_t size) {
+    if (buffer == nullptr || size == 0) {
+        return 0;
+    }
+    buffer[0] = '\0';
+
+    size_t length = 0;
+    int written = snprintf(buffer, size, "{\"dropped\":%u,\"records\":[", (unsigned)backlog.dropped);
+    if (written < 0 || (size_t)written >= size) {
+        buffer[0] = '\0';
+        return 0;
+    }
+    length = written;
+
+    for (uint8_t i = 0; i < backlog.count; i++) {
+        TelemetryRecord r;
+        getTelemetryRecord(backlog, i, r);
+        written = snprintf(buffer + length, size - length,
+                           "%s{\"t\":%lu,\"loop\":%.2f,\"wifi\":%.2f,\"ntp\":%.2f,\"crc\":%.2f,\"image\":%.2f,"
+                           "\"mv\":%u,\"pct\":%d,\"rssi\":%d,\"retries\":[%u,%u,%u],\"result\":\"%s\"}",
+                           i == 0 ? "" : ",", (unsigned long)r.timestamp,
+                           r.loopMs / 1000.0, r.wifiMs / 1000.0, r.ntpMs / 1000.0, r.crcMs / 1000.0, r.imageMs / 1000.0,
+                           (unsigned)r.batteryMillivolts, (int)r.batteryPercentage, (int)r.wifiRSSI,
+                           (unsigned)r.wifiRetries, (unsigned)r.crcRetries, (unsigned)r.imageRetries,
+                           getResultName(r.result));
+        if (written < 0 || (size_t)written >= size - length) {
+            buffer[0] = '\0';
+            return 0;
+        }
+        length += written;
+    }
+
+    if (length + 2 >= size) {
+        buffer[0] = '\0';
+        return 0;
+    }
+    buffer[length++] = ']';
+    buffer[length++] = '}';
+    buffer[length] = '\0';
+    return length;
+}
@@ -0,0 +1,136 @@
+#ifndef TELEMETRY_BACKLOG_H
+#define TELEMETRY_BACKLOG_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Layout version - bump when the record layout changes so stale RTC contents are discarded
+#define TELEMETRY_BACKLOG_VERSION 1
+#define TELEMETRY_BACKLOG_CAPACITY 16       // Wakes kept while MQTT is unreachable or deferred
+#define TELEMETRY_RECORD_SIZE 20            // Packed bytes per wake
+#define TELEMETRY_BACKLOG_DOCUMENT_SIZE 2560  // Every record with the widest values
+#define TELEMETRY_BACKLOG_TOPIC "backlog"   // homeassistant/sensor/[device_id]/backlog
+#define TELEMETRY_LOW_BATTERY_PERCENT 15    // Timer wakes below this defer telemetry to the backlog
+
+/**
+ * @brief Offline telemetry backlog (kept in RTC memory across deep sleep)
+ *
+ * Pure C++ with NO dependencies on Arduino/ESP32 APIs, making it fully
+ * testable with standard C++ unit testing frameworks.
+ *
+ * A wake whose telemetry could not be published (broker unreachable,
+ * connect still running, or deferred on low battery) is packed into a
+ * 20-byte record in a ring buffer. The next wake that reaches the broker
+ * sends the whole backlog as one JSON document and clears it. When the ring
+ * is full the oldest record is overwritten and counted as dropped.
+ */
+
+/**
+ * @brief Outcome of a wake, stored with its record
+ */
+enum TelemetryResult {
+    TELEMETRY_RESULT_UNCHANGED = 0,     // Nothing refreshed (CRC32 / HTTP 304 match)
+    TELEMETRY_RESULT_DISPLAYED = 1,     // New image on the panel
+    TELEMETRY_RESULT_WARNING = 2,       // e.g. carousel image skipped
+    TELEMETRY_RESULT_ERROR = 3          // Download failed
+};
+
+/**
+ * @brief One wake, unpacked
+ *
+ * Durations are stored with 10 ms resolution up to 655.35 s, retries
+ * clamped to 15 (WiFi) and 3 (CRC32, image).
+ */
+struct TelemetryRecord {
+    uint32_t timestamp;         // Unix time, 0 = clock not set
+    uint32_t loopMs;            // Total cycle time
+    uint32_t wifiMs;            // LoopTimings breakdown
+    uint32_t ntpMs;
+    uint32_t crcMs;
+    uint32_t imageMs;
+    uint16_t batteryMillivolts; // 0 = no battery
+    int8_t batteryPercentage;   // -1 = unknown
+    int8_t wifiRSSI;            // dBm
+    uint8_t wifiRetries;
+    uint8_t crcRetries;
+    uint8_t imageRetries;
+    uint8_t result;             // TelemetryResult
+};
+
+/**
+ * @brief Ring buffer of packed records
+ */
+struct TelemetryBacklog {
+    uint8_t version;            // TELEMETRY_BACKLOG_VERSION (0 after a cold boot = invalid)
+    uint8_t head;               // Index of the oldest record
+    uint8_t count;              // Records stored
+    uint8_t reserved;
+    uint16_t dropped;           // Records overwritten since the last flush (saturates)
+    uint8_t records[TELEMETRY_BACKLOG_CAPACITY][TELEMETRY_RECORD_SIZE];
+};
+
+/**
+ * @brief Pack a record into TELEMETRY_RECORD_SIZE bytes (little-endian)
+ */
+void packTelemetryRecord(const TelemetryRecord& record, uint8_t* out);
+
+/**
+ * @brief Unpack a record written by packTelemetryRecord()
+ */
+void unpackTelemetryRecord(const uint8_t* in, TelemetryRecord& record);
+
+/**
+ * @brief Reset to an empty backlog
+ */
+void initTelemetryBacklog(TelemetryBacklog& backlog);
+
+/**
+ * @brief Check a backlog read from RTC memory (version and ranges)
+ * @return false if it must be re-initialized
+ */
+bool isTelemetryBacklogValid(const TelemetryBacklog& backlog);
+
+/**
+ * @brief Append a wake, overwriting the oldest record when full
+ * @return true if a record was dropped to make room
+ */
+bool pushTelemetryRecord(TelemetryBacklog& backlog, const TelemetryRecord& record);
+
+/**
+ * @brief Read a record, 0 = oldest
+ * @return false if index >= count
+ */
+bool getTelemetryRecord(const TelemetryBacklog& backlog, uint8_t index, TelemetryRecord& record);
+
+/**
+ * @brief Forget every record and the dropped count after a flush
+ */
+void clearTelemetryBacklog(TelemetryBacklog& backlog);
+
+/**
+ * @brief Decide whether this wake skips MQTT and only records to the backlog
+ *
+ * Timer wakes on a low battery defer, until the ring would be full - then
+ * the wake publishes and flushes everything, so Home Assistant still sees
+ * the battery draining every TELEMETRY_BACKLOG_CAPACITY wakes.
+ *
+ * @param batteryVoltage Volts, <= 0 = no battery (USB powered, never deferred)
+ * @param userWake Button / reset / first boot - the user is looking, always publish
+ */
+bool shouldDeferTelemetry(const TelemetryBacklog& backlog, float batteryVoltage, int batteryPercentage,
+                          bool userWake);
+
+/**
+ * @brief Serialize the backlog as one JSON document, oldest record first
+ *
+ * {"dropped":0,"records":[{"t":1760000000,"loop":6.23,"wifi":1.50,"ntp":0.00,
+ *  "crc":0.31,"image":3.90,"mv":3987,"pct":85,"rssi":-61,"retries":[0,0,0],
+ *  "result":"displayed"}]}
+ *
+ * @param buffer Output, NUL-terminated on success
+ * @param size Buffer size (TELEMETRY_BACKLOG_DOCUMENT_SIZE fits a full backlog)
+ * @return Document length without the terminator, 0 if it did not fit
+ */
+size_t serializeTelemetryBacklog(const TelemetryBacklog& backlog, char* buffer, size_t size);
+
+#endif // TELEMETRY_BACKLOG_H
@@ -0,0 +1,210 @@
+#include <telemetry_payload.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace {
+
+// Appends into a fixed buffer; once something does not fit, everything after it is dropped
+struct JsonWriter {
+    char* buffer;
+    size_t size;
+    size_t length;
+    bool overflow;
+    bool empty;
+};
+
+void appendf(JsonWriter& w, const char* format, ...) {
+    if (w.overflow) {
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(w.buffer + w.length, w.size - w.length, format, args);
+    va_end(args);
+    if (written < 0 || (size_t)written >= w.size - w.length) {
+        w.overflow = true;
+        return;
+    }
+    w.length += written;
+}
+
+void appendChar(JsonWriter& w, char c) {
+    if (w.overflow) {
+        return;
+    }
+    if (w.length + 1 >= w.size) {
+        w.overflow = true;
+        return;
+    }
+    w.buffer[w.length++] = c;
+    w.buffer[w.length] = '\0';
+}
+
+void appendKey(JsonWriter& w, const char* key) {
+    appendf(w, w.empty ? "\"%s\":" : ",\"%s\":", key);
+    w.empty = false;
+}
+
+// JSON string contents: quotes, backslashes and control characters escaped.
+// Stops before maxOutput escaped bytes, without splitting a UTF-8 sequence.
+void appendEscaped(JsonWriter& w, const char* text, size_t maxOutput) {
+    size_t start = w.length;
+    size_t boundary = w.length;  // Output length before the current UTF-8 sequence
+    for (size_t i = 0; text[i] != '\0' && !w.overflow; i++) {
+        unsigned char c = (unsigned char)text[i];
+        size_t needed = (c == '"' || c == '\\') ? 2 : (c < 0x20 ? 6 : 1);
+        if (w.length - start + needed > maxOutput) {
+            if ((c & 0xC0) == 0x80) {
+                w.length = boundary;  // Drop the incomplete sequence
+                w.buffer[w.length] = '\0';
+            }
+            return;
+        }
+        if ((c & 0xC0) != 0x80) {
+            boundary = w.length;
+        }
+        if (needed == 2) {
+            appendChar(w, '\\');
+            appendChar(w, (char)c);
+        } else if (needed == 6) {
+            appendf(w, "\\u%04x", c);
+        } else {
+            appendChar(w, (char)c);
+        }
+    }
+}
+
+void appendFloat(JsonWriter& w, const char* key, float value, int decimals) {
+    appendKey(w, key);
+    appendf(w, "%.*f", decimals, (double)value);
+}
+
+void appendInt(JsonWriter& w, const char* key, int value) {
+    appendKey(w, key);
+    appendf(w, "%d", value);
+}
+
+void appendCounter(JsonWriter& w, const char* key, uint8_t value) {
+    if (value != 255) {
+        appendInt(w, key, value);
+    }
+}
+
+void appendDuration(JsonWriter& w, const char* key, float seconds) {
+    if (seconds >= 0) {
+        appendFloat(w, key, seconds, 2);
+    }
+}
+
+}  // namespace
+
+void initTelemetryState(TelemetryState& state) {
+    state.batteryVoltage = 0;
+    state.batteryPercentage = -1;
+    state.hasWifiRSSI = false;
+    state.wifiRSSI = 0;
+    state.loopTimeSeconds = -1;
+    state.lastLog = nullptr;
+    state.lastLogSeverity = nullptr;
+    state.hasImageCRC32 = false;
+    state.imageCRC32 = 0;
+    state.wifiBSSID = nullptr;
+    state.wifiSeconds = -1;
+    state.wifiEarlySeconds = -1;
+    state.ntpSeconds = -1;
+    state.crcSeconds = -1;
+    state.imageSeconds = -1;
+    state.wifiRetries = 255;
+    state.crcRetries = 255;
+    state.imageRetries = 255;
+    state.tlsFullHandshakes = 255;
+    state.tlsResumedHandshakes = 255;
+    state.httpReusedConnections = 255;
+    state.cycleChargeMah = -1;
+    state.batteryDaysRemaining = -1;
+}
+
+size_t serializeTelemetryState(const TelemetryState& state, char* buffer, size_t size) {
+    if (buffer == nullptr || size == 0) {
+        return 0;
+    }
+    JsonWriter w = { buffer, size, 0, false, true };
+    buffer[0] = '\0';
+    appendChar(w, '{');
+
+    // Same order and formatting as the per-topic state messages
+    if (state.batteryVoltage > 0) {
+        appendFloat(w, "battery_voltage", state.batteryVoltage, 3);
+    }
+    if (state.batteryPercentage >= 0) {
+        appendInt(w, "battery_percentage", state.batteryPercentage);
+    }
+    if (state.hasWifiRSSI) {
+        appendInt(w, "wifi_signal", state.wifiRSSI);
+    }
+    if (state.loopTimeSeconds >= 0) {
+        appendFloat(w, "loop_time", state.loopTimeSeconds, 2);
+    }
+    if (state.lastLog != nullptr && state.lastLog[0] != '\0') {
+        appendKey(w, "last_log");
+        appendChar(w, '"');
+        appendChar(w, '[');
+        const char* severity = state.lastLogSeverity != nullptr ? state.lastLogSeverity : "info";
+        for (size_t i = 0; severity[i] != '\0' && i < 16; i++) {
+            char c = severity[i];
+            appendChar(w, (c >= 'a' && c <= 'z') ? (char)(c - 'a' + 'A') : c);
+        }
+        appendChar(w, ']');
+        appendChar(w, ' ');
+        appendEscaped(w, state.lastLog, TELEMETRY_LOG_MAX_LENGTH);
+        appendChar(w, '"');
+    }
+    if (state.hasImageCRC32) {
+        appendKey(w, "image_crc32");
+        appendf(w, "\"0x%08X\"", (unsigned)state.imageCRC32);
+    }
+    if (state.wifiBSSID != nullptr && state.wifiBSSID[0] != '\0') {
+        appendKey(w, "wifi_bssid");
+        appendChar(w, '"');
+        appendEscaped(w, state.wifiBSSID, 32);
+        appendChar(w, '"');
+    }
+    appendDuration(w, "loop_time_wifi", state.wifiSeconds);
+    appendDuration(w, "loop_time_wifi_early", state.wifiEarlySeconds);
+    appendDuration(w, "loop_time_ntp", state.ntpSeconds);
+    appendDuration(w, "loop_time_crc", state.crcSeconds);
+    appendDuration(w, "loop_time_image", state.imageSeconds);
+    appendCounter(w, "loop_time_wifi_retries", state.wifiRetries);
+    appendCounter(w, "loop_time_crc_retries", state.crcRetries);
+    appendCounter(w, "loop_time_image_retries", state.imageRetries);
+    appendCounter(w, "tls_full_handshakes", state.tlsFullHandshakes);
+    appendCounter(w, "tls_resumed_handshakes", state.tlsResumedHandshakes);
+    appendCounter(w, "http_reused_connections", state.httpReusedConnections);
+    if (state.cycleChargeMah >= 0) {
+        appendFloat(w, "wake_charge", state.cycleChargeMah, 3);
+    }
+    if (state.batteryDaysRemaining >= 0) {
+        appendFloat(w, "battery_days_remaining", state.batteryDaysRemaining, 0);
+    }
+
+    appendChar(w, '}');
+    if (w.overflow) {
+        buffer[0] = '\0';
+        return 0;
+    }
+    return w.length;
+}
+
+size_t formatTelemetryValueTemplate(const char* key, char* buffer, size_t size) {
+    if (buffer == nullptr || size == 0) {
+        return 0;
+    }
+    int written = snprintf(buffer, size, "{{ value_json.%s if value_json.%s is defined else this.state }}",
+                           key, key);
+    if (written < 0 || (size_t)written >= size) {
+        buffer[0] = '\0';
+        return 0;
+    }
+    return (size_t)written;
+}
@@ -0,0 +1,79 @@
+#ifndef TELEMETRY_PAYLOAD_H
+#define TELEMETRY_PAYLOAD_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define TELEMETRY_PAYLOAD_SIZE 768          // Every field present with a 160 character log message
+#define TELEMETRY_LOG_MAX_LENGTH 160        // Last log message bytes after JSON escaping, longer ones are cut
+#define TELEMETRY_STATE_TOPIC "state"       // homeassistant/sensor/[device_id]/state
+
+/**
+ * @brief Batched MQTT telemetry: every sensor value in one JSON state document
+ *
+ * Pure C++ with NO dependencies on Arduino/ESP32 APIs, making it fully
+ * testable with standard C++ unit testing frameworks.
+ *
+ * Instead of one retained publish per sensor, the values are serialized
+ * once into a fixed-size buffer (no String concatenation) and published on
+ * a single state topic. Home Assistant discovery points every sensor at
+ * that topic with a value_template selecting its key. The keys are the
+ * sensor types of the per-topic mode (battery_voltage, loop_time, ...), and
+ * the values are formatted the same way, so both modes report identical
+ * states.
+ *
+ * Fields marked as absent are left out of the document; the discovery
+ * template keeps the sensor's previous state for them, just like a skipped
+ * per-topic publish does.
+ */
+struct TelemetryState {
+    float batteryVoltage;           // V, <= 0 = absent
+    int batteryPercentage;          // %, < 0 = absent
+    bool hasWifiRSSI;
+    int wifiRSSI;                   // dBm
+    float loopTimeSeconds;          // < 0 = absent
+    const char* lastLog;            // nullptr / empty = absent
+    const char* lastLogSeverity;    // "info", "warning", "error" (upper-cased in the state)
+    bool hasImageCRC32;
+    uint32_t imageCRC32;            // Reported as "0xHHHHHHHH"
+    const char* wifiBSSID;          // nullptr / empty = absent
+    float wifiSeconds;              // Loop time breakdown, < 0 = absent
+    float wifiEarlySeconds;         // Association during setup(), before the WiFi wait
+    float ntpSeconds;
+    float crcSeconds;
+    float imageSeconds;
+    uint8_t wifiRetries;            // Retry / connection counters, 255 = absent
+    uint8_t crcRetries;
+    uint8_t imageRetries;
+    uint8_t tlsFullHandshakes;
+    uint8_t tlsResumedHandshakes;
+    uint8_t httpReusedConnections;
+    float cycleChargeMah;           // < 0 = absent
+    float batteryDaysRemaining;     // < 0 = absent
+};
+
+/**
+ * @brief Reset every field to absent
+ */
+void initTelemetryState(TelemetryState& state);
+
+/**
+ * @brief Serialize the present fields as one JSON object
+ *
+ * @param buffer Output, NUL-terminated on success
+ * @param size Buffer size (TELEMETRY_PAYLOAD_SIZE fits every field)
+ * @return Document length without the terminator, 0 if it did not fit
+ */
+size_t serializeTelemetryState(const TelemetryState& state, char* buffer, size_t size);
+
+/**
+ * @brief Write the Home Assistant value_template for one sensor key
+ *
+ * Selects the key from the state document and keeps the previous state
+ * when the key is absent.
+ *
+ * @return Template length, 0 if it did not fit
+ */
+size_t formatTelemetryValueTemplate(const char* key, char* buffer, size_t size);
+
+#endif // TELEMETRY_PAYLOAD_H
@@ -0,0 +1,233 @@
+#include <tile_diff.h>
+#include <fnv1a.h>
+#include <string.h>
+
+void initTileHashGrid(TileHashGrid& grid) {
+    grid.version = 0;
+    grid.cols = 0;
+    grid.rows = 0;
+    grid.partialCount = 0;
+    grid.width = 0;
+    grid.height = 0;
+}
+
+bool isTileHashGridValid(const TileHashGrid& grid) {
+    if (grid.version != TILE_GRID_VERSION || grid.cols == 0 || grid.rows == 0) {
+        return false;
+    }
+    if ((uint32_t)grid.cols * grid.rows > TILE_GRID_MAX_TILES) {
+        return false;
+    }
+    return grid.cols == (grid.width + TILE_SIZE - 1) / TILE_SIZE &&
+           grid.rows == (grid.height + TILE_SIZE - 1) / TILE_SIZE;
+}
+
+bool computeTileHashes(const uint8_t* buffer, size_t stride, uint16_t width, uint16_t height,
+                       uint8_t bitsPerPixel, TileHashGrid& grid) {
+    initTileHashGrid(grid);
+    uint32_t cols = (width + TILE_SIZE - 1) / TILE_SIZE;
+    uint32_t rows = (height + TILE_SIZE - 1) / TILE_SIZE;
+    if (buffer == nullptr || cols == 0 || rows == 0 || cols > 255 || rows > 255 ||
+        cols * rows > TILE_GRID_MAX_TILES || (bitsPerPixel != 1 && bitsPerPixel != 4)) {
+        return false;
+    }
+
+    const size_t tileBytes = TILE_SIZE * bitsPerPixel / 8;
+    const size_t rowBytes = ((size_t)width * bitsPerPixel + 7) / 8;
+    uint32_t acc[255];
+
+    for (uint32_t tileRow = 0; tileRow < rows; tileRow++) {
+        // FNV-1a per tile, fed one pixel row at a time so the buffer is read sequentially
+        for (uint32_t c = 0; c < cols; c++) {
+            acc[c] = FNV1A_OFFSET_BASIS;
+        }
+        uint32_t yEnd = (tileRow + 1) * TILE_SIZE;
+        if (yEnd > height) {
+            yEnd = height;
+        }
+        for (uint32_t y = tileRow * TILE_SIZE; y < yEnd; y++) {
+            const uint8_t* row = buffer + (size_t)y * stride;
+            for (uint32_t c = 0; c < cols; c++) {
+                size_t start = c * tileBytes;
+                size_t end = start + tileBytes;
+                if (end > rowBytes) {
+                    end = rowBytes;
+                }
+                acc[c] = fnv1a(acc[c], row + start, end - start);
+            }
+        }
+        for (uint32_t c = 0; c < cols; c++) {
+            grid.hashes[tileRow * cols + c] = (uint16_t)((acc[c] >> 16) ^ (acc[c] & 0xFFFF));
+        }
+    }
+
+    grid.cols = (uint8_t)cols;
+    grid.rows = (uint8_t)rows;
+    grid.width = width;
+    grid.height = height;
+    grid.version = TILE_GRID_VERSION;
+    return true;
+}
+
+static void setRegion(TileRegion& region, uint32_t c0, uint32_t c1, uint32_t r0, uint32_t r1,
+                      uint16_t width, uint16_t height) {
+    uint32_t x = c0 * TILE_SIZE;
+    uint32_t y = r0 * TILE_SIZE;
+    uint32_t xEnd = (c1 + 1) * TILE_SIZE;
+    uint32_t yEnd = (r1 + 1) * TILE_SIZE;
+    if (xEnd > width) xEnd = width;
+    if (yEnd > height) yEnd = height;
+    region.x = (uint16_t)x;
+    region.y = (uint16_t)y;
+    region.width = (uint16_t)(xEnd - x);
+    region.height = (uint16_t)(yEnd - y);
+}
+
+void diffTileHashes(const TileHashGrid& previous, const TileHashGrid& current, TileDiff& diff) {
+    diff.changedTiles = 0;
+    diff.totalTiles = (uint16_t)(current.cols * current.rows);
+    diff.regionsOverflow = false;
+    diff.regionCount = 0;
+    diff.comparable = isTileHashGridValid(previous) && isTileHashGridValid(current) &&
+                      previous.width == current.width && previous.height == current.height;
+
+    if (!isTileHashGridValid(current)) {
+        diff.totalTiles = 0;
+        return;
+    }
+    if (!diff.comparable) {
+        // Nothing to compare against - the whole frame is new
+        diff.changedTiles = diff.totalTiles;
+        diff.regionCount = 1;
+        setRegion(diff.regions[0], 0, current.cols - 1, 0, current.rows - 1, current.width, current.height);
+        return;
+    }
+
+    // Regions in tile units while merging (spans c0..c1, rows r0..r1)
+    uint8_t c0s[TILE_REGION_MAX], c1s[TILE_REGION_MAX], r0s[TILE_REGION_MAX], r1s[TILE_REGION_MAX];
+    const uint32_t cols = current.cols;
+    uint32_t minCol = cols, maxCol = 0, minRow = current.rows, maxRow = 0;
+
+    for (uint32_t r = 0; r < current.rows; r++) {
+        const uint16_t* prevRow = previous.hashes + r * cols;
+        const uint16_t* curRow = current.hashes + r * cols;
+        uint32_t c = 0;
+        while (c < cols) {
+            if (prevRow[c] == curRow[c]) {
+                c++;
+                continue;
+            }
+            uint32_t start = c;
+            while (c < cols && prevRow[c] != curRow[c]) {
+                c++;
+            }
+            uint32_t end = c - 1;
+            diff.changedTiles += (uint16_t)(end - start + 1);
+            if (start < minCol) minCol = start;
+            if (end > maxCol) maxCol = end;
+            if (r < minRow) minRow = r;
+            maxRow = r;
+
+            // Extend a rectangle ending on the row above with the same span
+            bool merged = false;
+            for (uint8_t k = 0; k < diff.regionCount; k++) {
+                if (c0s[k] == start && c1s[k] == end && (uint32_t)r1s[k] + 1 == r) {
+                    r1s[k] = (uint8_t)r;
+                    merged = true;
+                    break;
+                }
+            }
+            if (!merged) {
+                if (diff.regionCount < TILE_REGION_MAX) {
+                    uint8_t k = diff.regionCount++;
+                    c0s[k] = (uint8_t)start;
+                    c1s[k] = (uint8_t)end;
+                    r0s[k] = (uint8_t)r;
+                    r1s[k] = (uint8_t)r;
+                } else {
+                    diff.regionsOverflow = true;
+                }
+            }
+        }
+    }
+
+    if (diff.regionsOverflow) {
+        // Too scattered to list - one bounding box covering every changed tile
+        diff.regionCount = 1;
+        setRegion(diff.regions[0], minCol, maxCol, minRow, maxRow, current.width, current.height);
+        return;
+    }
+    for (uint8_t k = 0; k < diff.regionCount; k++) {
+        setRegion(diff.regions[k], c0s[k], c1s[k], r0s[k], r1s[k], current.width, current.height);
+    }
+}
+
+// Pixels a partial refresh would drive
+static uint32_t regionArea(const TileDiff& diff) {
+    uint32_t area = 0;
+    for (uint8_t k = 0; k < diff.regionCount; k++) {
+        area += (uint32_t)diff.regions[k].width * diff.regions[k].height;
+    }
+    return area;
+}
+
+RefreshDecision decideRefresh(const TileHashGrid& previous, const TileDiff& diff,
+                              uint8_t fullRefreshEvery) {
+    RefreshDecision decision;
+    decision.kind = REFRESH_FULL;
+
+    if (!diff.comparable) {
+        decision.reason = "Screen content unknown (full refresh)";
+    } else if (diff.changedTiles == 0) {
+        decision.kind = REFRESH_NONE;
+        decision.reason = "Frame unchanged (no refresh)";
+    } else if (fullRefreshEvery == 0 || previous.partialCount >= fullRefreshEvery) {
+        decision.reason = "Periodic full refresh (clears ghosting)";
+    } else if (regionArea(diff) * 100 > (uint32_t)previous.width * previous.height * TILE_PARTIAL_MAX_CHANGED_PERCENT) {
+        decision.reason = "Most of the frame changed (full refresh)";
+    } else {
+        decision.kind = REFRESH_PARTIAL;
+        decision.reason = "Only some tiles changed (partial refresh)";
+    }
+    return decision;
+}
+
+void commitTileHashGrid(TileHashGrid& stored, const TileHashGrid& current, RefreshKind kind) {
+    uint8_t partialCount = stored.partialCount;
+    if (&stored != &current) {
+        memcpy(&stored, &current, sizeof(TileHashGrid));
+    }
+    if (kind == REFRESH_FULL) {
+        stored.partialCount = 0;
+    } else if (kind == REFRESH_PARTIAL) {
+        stored.partialCount = partialCount < 255 ? (uint8_t)(partialCount + 1) : 255;
+    } else {
+        stored.partialCount = partialCount;
+    }
+}
+
+void commitTileHashRegions(TileHashGrid& stored, const TileHashGrid& current,
+                           const TileRegion* regions, uint8_t regionCount) {
+    if (!isTileHashGridValid(stored) || !isTileHashGridValid(current) ||
+        stored.width != current.width || stored.height != current.height) {
+        return;
+    }
+    for (uint8_t k = 0; k < regionCount; k++) {
+        const TileRegion& region = regions[k];
+        if (region.width == 0 || region.height == 0) {
+            continue;
+        }
+        uint32_t c0 = region.x / TILE_SIZE;
+        uint32_t c1 = (region.x + region.width - 1) / TILE_SIZE;
+        uint32_t r0 = region.y / TILE_SIZE;
+        uint32_t r1 = (region.y + region.height - 1) / TILE_SIZE;
+        if (c1 >= stored.cols) c1 = stored.cols - 1;
+        if (r1 >= stored.rows) r1 = stored.rows - 1;
+        for (uint32_t r = r0; r <= r1; r++) {
+            for (uint32_t c = c0; c <= c1; c++) {
+                stored.hashes[r * stored.cols + c] = current.hashes[r * stored.cols + c];
+            }
+        }
+    }
+    stored.partialCount = stored.partialCount < 255 ? (uint8_t)(stored.partialCount + 1) : 255;
+}
@@ -0,0 +1,119 @@
+#ifndef TILE_DIFF_H
+#define TILE_DIFF_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Layout version - bump when the struct or hash changes so stale RTC grids are discarded
+#define TILE_GRID_VERSION 1
+#define TILE_SIZE 32                        // Tile side in pixels (multiple of 8: tiles are byte-aligned in 1-bit buffers)
+#define TILE_GRID_MAX_TILES 1024            // 1280x720 -> 40x23, 1200x825 -> 38x26, 1024x758 -> 32x24
+#define TILE_REGION_MAX 16                  // Changed rectangles tracked per frame
+#define TILE_PARTIAL_MAX_CHANGED_PERCENT 60 // Changed-region area above which a full refresh looks better and costs about the same
+
+/**
+ * @brief Per-tile hashes of the frame currently on the panel (kept in RTC memory)
+ *
+ * 16-bit hash per 32x32 tile: ~2KB for the largest panel. A hash collision
+ * leaves one tile stale until the next periodic full refresh.
+ */
+struct TileHashGrid {
+    uint8_t version;                        // TILE_GRID_VERSION (0 = no frame known)
+    uint8_t cols;                           // Tiles per row
+    uint8_t rows;                           // Tile rows
+    uint8_t partialCount;                   // Partial refreshes since the last full refresh
+    uint16_t width;                         // Frame size the hashes were computed for
+    uint16_t height;
+    uint16_t hashes[TILE_GRID_MAX_TILES];   // Row-major, cols * rows used
+};
+
+// Changed area in pixels (tile-aligned, clipped to the frame)
+struct TileRegion {
+    uint16_t x;
+    uint16_t y;
+    uint16_t width;
+    uint16_t height;
+};
+
+// Result of comparing two grids
+struct TileDiff {
+    uint16_t changedTiles;
+    uint16_t totalTiles;
+    bool comparable;                        // Same geometry (otherwise every tile counts as changed)
+    bool regionsOverflow;                   // More than TILE_REGION_MAX rectangles needed (regions[0] is the bounding box)
+    uint8_t regionCount;
+    TileRegion regions[TILE_REGION_MAX];
+};
+
+enum RefreshKind {
+    REFRESH_NONE,       // Frame identical to the panel - no refresh at all
+    REFRESH_PARTIAL,    // Drive only the changed regions
+    REFRESH_FULL        // Full-panel refresh (flashing, clears ghosting)
+};
+
+struct RefreshDecision {
+    RefreshKind kind;
+    const char* reason;
+};
+
+/**
+ * @brief Pure tile diff functions
+ *
+ * These functions contain NO dependencies on Arduino/ESP32 APIs,
+ * making them fully testable with standard C++ unit testing frameworks.
+ */
+
+/**
+ * @brief Reset grid to "no frame known" (forces the next refresh to be full)
+ */
+void initTileHashGrid(TileHashGrid& grid);
+
+/**
+ * @brief Check a grid loaded from RTC memory (version and geometry)
+ */
+bool isTileHashGridValid(const TileHashGrid& grid);
+
+/**
+ * @brief Hash every tile of a packed framebuffer
+ * @param buffer Row-major frame, stride bytes per row
+ * @param bitsPerPixel Storage bits per pixel: 1 (8 px/byte) or 4 (2 px/byte)
+ * @return false if the frame needs more than TILE_GRID_MAX_TILES tiles (grid left invalid)
+ */
+bool computeTileHashes(const uint8_t* buffer, size_t stride, uint16_t width, uint16_t height,
+                       uint8_t bitsPerPixel, TileHashGrid& grid);
+
+/**
+ * @brief Compare the panel's grid with a new frame's grid and collect changed rectangles
+ *
+ * Horizontally adjacent changed tiles form a run; runs with the same span on
+ * consecutive tile rows are merged into one rectangle. If that needs more
+ * than TILE_REGION_MAX rectangles, a single bounding box is reported instead.
+ */
+void diffTileHashes(const TileHashGrid& previous, const TileHashGrid& current, TileDiff& diff);
+
+/**
+ * @brief Decide how to refresh the panel for a new frame
+ * @param previous Grid of the frame on the panel (invalid if anything else was drawn since)
+ * @param fullRefreshEvery Full refresh after this many partial refreshes (0 = always full)
+ */
+RefreshDecision decideRefresh(const TileHashGrid& previous, const TileDiff& diff,
+                              uint8_t fullRefreshEvery);
+
+/**
+ * @brief Store the new frame's grid as the panel's grid after a refresh
+ * Counts partial refreshes; a full refresh resets the count, no refresh keeps it.
+ */
+void commitTileHashGrid(TileHashGrid& stored, const TileHashGrid& current, RefreshKind kind);
+
+/**
+ * @brief Update the panel's grid after a partial refresh of known regions only
+ *
+ * For frames where only the given regions were drawn (the rest of the buffer
+ * is not the panel content): hashes of tiles touching a region are taken from
+ * current, all others are kept. Counts as one partial refresh. Does nothing
+ * if the grids do not have the same geometry.
+ */
+void commitTileHashRegions(TileHashGrid& stored, const TileHashGrid& current,
+                           const TileRegion* regions, uint8_t regionCount);
+
+#endif // TILE_DIFF_H
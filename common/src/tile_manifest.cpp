@@ -0,0 +1,336 @@
+#include <tile_manifest.h>
+#include <fnv1a.h>
+#include <string.h>
+
+static const char* pathEnd(const char* url) {
+    const char* end = url;
+    while (*end != '\0' && *end != '?' && *end != '#') {
+        end++;
+    }
+    return end;
+}
+
+bool isTileManifestUrl(const char* url) {
+    if (url == nullptr) {
+        return false;
+    }
+    const char* end = pathEnd(url);
+    size_t extLen = strlen(TILE_MANIFEST_EXTENSION);
+    if ((size_t)(end - url) < extLen) {
+        return false;
+    }
+    const char* ext = end - extLen;
+    for (size_t i = 0; i < extLen; i++) {
+        char c = ext[i];
+        if (c >= 'A' && c <= 'Z') {
+            c = c - 'A' + 'a';
+        }
+        if (c != TILE_MANIFEST_EXTENSION[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// Parsing
+// ============================================================================
+
+static bool isSpace(char c) {
+    return c == ' ' || c == '\t';
+}
+
+// Next whitespace-separated token; returns nullptr at end of line
+static char* nextToken(char** cursor) {
+    char* p = *cursor;
+    while (isSpace(*p)) {
+        p++;
+    }
+    if (*p == '\0') {
+        *cursor = p;
+        return nullptr;
+    }
+    char* start = p;
+    while (*p != '\0' && !isSpace(*p)) {
+        p++;
+    }
+    if (*p != '\0') {
+        *p++ = '\0';
+    }
+    *cursor = p;
+    return start;
+}
+
+static bool parseUint16(const char* token, uint16_t* out) {
+    if (token == nullptr || *token == '\0') {
+        return false;
+    }
+    uint32_t value = 0;
+    for (const char* p = token; *p != '\0'; p++) {
+        if (*p < '0' || *p > '9') {
+            return false;
+        }
+        value = value * 10 + (uint32_t)(*p - '0');
+        if (value > 0xFFFF) {
+            return false;
+        }
+    }
+    *out = (uint16_t)value;
+    return true;
+}
+
+static bool parseHex32(const char* token, uint32_t* out) {
+    if (token == nullptr) {
+        return false;
+    }
+    if (token[0] == '0' && (token[1] == 'x' || token[1] == 'X')) {
+        token += 2;
+    }
+    size_t len = strlen(token);
+    if (len == 0 || len > 8) {
+        return false;
+    }
+    uint32_t value = 0;
+    for (size_t i = 0; i < len; i++) {
+        char c = token[i];
+        uint32_t digit;
+        if (c >= '0' && c <= '9') digit = c - '0';
+        else if (c >= 'a' && c <= 'f') digit = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') digit = c - 'A' + 10;
+        else return false;
+        value = (value << 4) | digit;
+    }
+    *out = value;
+    return true;
+}
+
+static bool fail(const char** outError, const char* error) {
+    if (outError != nullptr) {
+        *outError = error;
+    }
+    return false;
+}
+
+static bool tilesOverlap(const ManifestTile& a, const ManifestTile& b) {
+    return a.x < b.x + b.width && b.x < a.x + a.width &&
+           a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+bool parseTileManifest(char* text, TileManifest& manifest, const char** outError) {
+    manifest.width = 0;
+    manifest.height = 0;
+    manifest.tileCount = 0;
+    if (text == nullptr) {
+        return fail(outError, "Empty manifest");
+    }
+
+    bool headerSeen = false;
+    char* line = text;
+    while (line != nullptr && *line != '\0') {
+        // Split off the line and strip CR / trailing blanks
+        char* next = strchr(line, '\n');
+        if (next != nullptr) {
+            *next++ = '\0';
+        }
+        size_t len = strlen(line);
+        while (len > 0 && (line[len - 1] == '\r' || isSpace(line[len - 1]))) {
+            line[--len] = '\0';
+        }
+        while (isSpace(*line)) {
+            line++;
+        }
+
+        if (*line == '\0' || *line == '#') {
+            line = next;
+            continue;
+        }
+
+        if (!headerSeen) {
+            if (strcmp(line, TILE_MANIFEST_HEADER) != 0) {
+                return fail(outError, "Missing 'inkplate-tiles 1' header");
+            }
+            headerSeen = true;
+            line = next;
+            continue;
+        }
+
+        char* cursor = line;
+        char* keyword = nextToken(&cursor);
+        if (strcmp(keyword, "size") == 0) {
+            if (!parseUint16(nextToken(&cursor), &manifest.width) ||
+                !parseUint16(nextToken(&cursor), &manifest.height) ||
+                nextToken(&cursor) != nullptr ||
+                manifest.width == 0 || manifest.height == 0) {
+                return fail(outError, "Invalid size line");
+            }
+        } else if (strcmp(keyword, "tile") == 0) {
+            if (manifest.width == 0) {
+                return fail(outError, "Tile before size line");
+            }
+            if (manifest.tileCount >= TILE_MANIFEST_MAX_TILES) {
+                return fail(outError, "Too many tiles");
+            }
+            ManifestTile& tile = manifest.tiles[manifest.tileCount];
+            if (!parseUint16(nextToken(&cursor), &tile.x) ||
+                !parseUint16(nextToken(&cursor), &tile.y) ||
+                !parseUint16(nextToken(&cursor), &tile.width) ||
+                !parseUint16(nextToken(&cursor), &tile.height) ||
+                !parseHex32(nextToken(&cursor), &tile.crc32)) {
+                return fail(outError, "Invalid tile line");
+            }
+            tile.url = nextToken(&cursor);
+            if (tile.url == nullptr || nextToken(&cursor) != nullptr) {
+                return fail(outError, "Tile line needs exactly one URL");
+            }
+            if (tile.width == 0 || tile.height == 0 ||
+                (uint32_t)tile.x + tile.width > manifest.width ||
+                (uint32_t)tile.y + tile.height > manifest.height) {
+                return fail(outError, "Tile outside the frame");
+            }
+            if (tile.x % 8 != 0 || (tile.width % 8 != 0 && tile.x + tile.width != manifest.width)) {
+                return fail(outError, "Tile x and width must be multiples of 8");
+            }
+            for (uint8_t i = 0; i < manifest.tileCount; i++) {
+                if (tilesOverlap(manifest.tiles[i], tile)) {
+                    return fail(outError, "Tiles overlap");
+                }
+            }
+            manifest.tileCount++;
+        } else {
+            return fail(outError, "Unknown manifest line");
+        }
+        line = next;
+    }
+
+    if (!headerSeen) {
+        return fail(outError, "Missing 'inkplate-tiles 1' header");
+    }
+    if (manifest.width == 0) {
+        return fail(outError, "Missing size line");
+    }
+    if (manifest.tileCount == 0) {
+        return fail(outError, "Manifest lists no tiles");
+    }
+    return true;
+}
+
+// ============================================================================
+// URL resolution
+// ============================================================================
+
+static bool appendSpan(char* out, size_t outSize, size_t* pos, const char* src, size_t len) {
+    if (*pos + len >= outSize) {
+        return false;
+    }
+    memcpy(out + *pos, src, len);
+    *pos += len;
+    out[*pos] = '\0';
+    return true;
+}
+
+bool resolveTileUrl(const char* manifestUrl, const char* tileUrl, char* out, size_t outSize) {
+    if (manifestUrl == nullptr || tileUrl == nullptr || out == nullptr || outSize == 0) {
+        return false;
+    }
+    out[0] = '\0';
+    size_t pos = 0;
+
+    if (strstr(tileUrl, "://") != nullptr) {
+        return appendSpan(out, outSize, &pos, tileUrl, strlen(tileUrl));
+    }
+
+    const char* scheme = strstr(manifestUrl, "://");
+    if (scheme == nullptr) {
+        return false;
+    }
+    const char* authorityEnd = scheme + 3;
+    while (*authorityEnd != '\0' && *authorityEnd != '/' && *authorityEnd != '?' && *authorityEnd != '#') {
+        authorityEnd++;
+    }
+
+    if (tileUrl[0] == '/') {
+        // Host-relative
+        return appendSpan(out, outSize, &pos, manifestUrl, authorityEnd - manifestUrl) &&
+               appendSpan(out, outSize, &pos, tileUrl, strlen(tileUrl));
+    }
+
+    // Relative to the manifest's directory (query and fragment dropped)
+    const char* end = pathEnd(manifestUrl);
+    const char* lastSlash = nullptr;
+    for (const char* p = authorityEnd; p < end; p++) {
+        if (*p == '/') {
+            lastSlash = p;
+        }
+    }
+    if (lastSlash == nullptr) {
+        return appendSpan(out, outSize, &pos, manifestUrl, authorityEnd - manifestUrl) &&
+               appendSpan(out, outSize, &pos, "/", 1) &&
+               appendSpan(out, outSize, &pos, tileUrl, strlen(tileUrl));
+    }
+    return appendSpan(out, outSize, &pos, manifestUrl, lastSlash + 1 - manifestUrl) &&
+           appendSpan(out, outSize, &pos, tileUrl, strlen(tileUrl));
+}
+
+// ============================================================================
+// Panel state
+// ============================================================================
+
+static uint32_t fnv1aU16(uint32_t hash, uint16_t value) {
+    uint8_t bytes[2] = {(uint8_t)(value & 0xFF), (uint8_t)(value >> 8)};
+    return fnv1a(hash, bytes, 2);
+}
+
+static uint32_t layoutHash(const TileManifest& manifest) {
+    uint32_t hash = FNV1A_OFFSET_BASIS;
+    hash = fnv1aU16(hash, manifest.width);
+    hash = fnv1aU16(hash, manifest.height);
+    hash = fnv1aU16(hash, manifest.tileCount);
+    for (uint8_t i = 0; i < manifest.tileCount; i++) {
+        const ManifestTile& tile = manifest.tiles[i];
+        hash = fnv1aU16(hash, tile.x);
+        hash = fnv1aU16(hash, tile.y);
+        hash = fnv1aU16(hash, tile.width);
+        hash = fnv1aU16(hash, tile.height);
+    }
+    return hash;
+}
+
+void initTileManifestState(TileManifestState& state) {
+    state.magic = 0;
+    state.urlHash = 0;
+    state.layoutHash = 0;
+    state.tileCount = 0;
+}
+
+uint32_t tileManifestUrlHash(const char* url) {
+    if (url == nullptr) {
+        return 0;
+    }
+    return fnv1aString(FNV1A_OFFSET_BASIS, url);
+}
+
+uint8_t planTileManifestUpdate(const TileManifestState& state, const TileManifest& manifest,
+                               uint32_t urlHash, bool* changed) {
+    bool comparable = state.magic == TILE_MANIFEST_STATE_MAGIC &&
+                      state.urlHash == urlHash &&
+                      state.tileCount == manifest.tileCount &&
+                      state.layoutHash == layoutHash(manifest);
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < manifest.tileCount; i++) {
+        changed[i] = !comparable || state.crc32[i] != manifest.tiles[i].crc32;
+        if (changed[i]) {
+            count++;
+        }
+    }
+    return count;
+}
+
+void recordTileManifestState(TileManifestState& state, const TileManifest& manifest, uint32_t urlHash) {
+    state.urlHash = urlHash;
+    state.layoutHash = layoutHash(manifest);
+    state.tileCount = manifest.tileCount;
+    for (uint8_t i = 0; i < manifest.tileCount; i++) {
+        state.crc32[i] = manifest.tiles[i].crc32;
+    }
+    state.magic = TILE_MANIFEST_STATE_MAGIC;
+}
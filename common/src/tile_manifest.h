@@ -0,0 +1,110 @@
+#ifndef TILE_MANIFEST_H
+#define TILE_MANIFEST_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define TILE_MANIFEST_HEADER "inkplate-tiles 1"    // First line of every manifest (format version 1)
+#define TILE_MANIFEST_EXTENSION ".tiles"            // Image URLs ending in this are manifests
+#define TILE_MANIFEST_MAX_TILES 64
+#define TILE_MANIFEST_MAX_SIZE 8192                 // Manifest text limit (64 tiles with ~100 char URLs)
+#define TILE_MANIFEST_URL_SIZE 512                  // Resolved tile URL buffer
+#define TILE_MANIFEST_STATE_MAGIC 0x544D4631        // "TMF1" - bump when TileManifestState changes
+
+/**
+ * @brief Tile manifest: the dashboard split into independently downloadable tiles
+ *
+ * Text format (one entry per line, '#' starts a comment line):
+ *
+ *   inkplate-tiles 1
+ *   size 1200 820
+ *   tile 0 0 400 410 8f3a1c22 tiles/0_0.png
+ *   tile 400 0 400 410 0b9e77d1 tiles/0_1.png
+ *
+ * tile <x> <y> <width> <height> <crc32 of the tile file> <url>. URLs are
+ * absolute, host-relative ("/...") or relative to the manifest. Tiles may
+ * not overlap, and x / width must be multiples of 8 (or reach the right
+ * edge) so a tile covers whole bytes of the 1-bit framebuffer.
+ */
+struct ManifestTile {
+    uint16_t x;
+    uint16_t y;
+    uint16_t width;
+    uint16_t height;
+    uint32_t crc32;
+    const char* url;    // Points into the parsed manifest text
+};
+
+struct TileManifest {
+    uint16_t width;
+    uint16_t height;
+    uint8_t tileCount;
+    ManifestTile tiles[TILE_MANIFEST_MAX_TILES];
+};
+
+/**
+ * @brief Tiles of the manifest frame currently on the panel (kept in RTC memory)
+ *
+ * Only tile CRC32s are kept; a layout hash detects a changed tile grid.
+ */
+struct TileManifestState {
+    uint32_t magic;                             // TILE_MANIFEST_STATE_MAGIC when valid
+    uint32_t urlHash;                           // Manifest URL the tiles came from
+    uint32_t layoutHash;                        // Frame size + tile rectangles
+    uint8_t tileCount;
+    uint32_t crc32[TILE_MANIFEST_MAX_TILES];
+};
+
+/**
+ * @brief Pure tile manifest functions
+ *
+ * These functions contain NO dependencies on Arduino/ESP32 APIs,
+ * making them fully testable with standard C++ unit testing frameworks.
+ */
+
+/**
+ * @brief Check whether an image URL points to a tile manifest (path ends in ".tiles")
+ */
+bool isTileManifestUrl(const char* url);
+
+/**
+ * @brief Parse manifest text in place (line ends are overwritten, tile URLs point into text)
+ * @param text NUL-terminated manifest text
+ * @param outError Set to a short reason on failure (may be nullptr)
+ * @return false if the manifest is malformed (manifest contents undefined)
+ */
+bool parseTileManifest(char* text, TileManifest& manifest, const char** outError);
+
+/**
+ * @brief Resolve a tile URL against the manifest URL
+ * @return false if the result does not fit in outSize
+ */
+bool resolveTileUrl(const char* manifestUrl, const char* tileUrl, char* out, size_t outSize);
+
+/**
+ * @brief Reset state to "no manifest frame on the panel"
+ */
+void initTileManifestState(TileManifestState& state);
+
+/**
+ * @brief Hash identifying a manifest URL in TileManifestState
+ */
+uint32_t tileManifestUrlHash(const char* url);
+
+/**
+ * @brief Mark the tiles that must be downloaded
+ *
+ * Only tiles whose CRC32 differs from the frame on the panel are marked when
+ * the state holds the same manifest URL and layout; otherwise every tile is.
+ * @param changed Output, one flag per manifest tile
+ * @return Number of marked tiles
+ */
+uint8_t planTileManifestUpdate(const TileManifestState& state, const TileManifest& manifest,
+                               uint32_t urlHash, bool* changed);
+
+/**
+ * @brief Remember the manifest frame now on the panel
+ */
+void recordTileManifestState(TileManifestState& state, const TileManifest& manifest, uint32_t urlHash);
+
+#endif // TILE_MANIFEST_H
@@ -0,0 +1,254 @@
+#include "tls_client.h"
+#include "logger.h"
+#include "host_resolver.h"
+#include <WiFi.h>
+#include <time.h>
+#include <lwip/sockets.h>
+#include <mbedtls/net_sockets.h>
+#include <mbedtls/sha256.h>
+#include <mbedtls/version.h>
+
+#define TLS_MIN_VALID_TIME 1600000000  // Anything earlier means NTP has not set the clock
+
+static uint32_t currentUnixTime() {
+    time_t now = time(nullptr);
+    return now > TLS_MIN_VALID_TIME ? (uint32_t)now : 0;
+}
+
+ResumableTlsClient::ResumableTlsClient()
+    : _cache(nullptr), _fingerprint(nullptr), _stats(nullptr), _networkCache(nullptr) {
+    clearHttpEndpoint(_connectedEndpoint);
+    // Only used by the IPAddress overloads, which keep the stock behavior
+    setInsecure();
+}
+
+void ResumableTlsClient::setSessionCache(TlsSessionCache* cache) {
+    _cache = cache;
+}
+
+void ResumableTlsClient::setFingerprint(const uint8_t* fingerprint) {
+    _fingerprint = fingerprint;
+}
+
+void ResumableTlsClient::setStats(TlsStats* stats) {
+    _stats = stats;
+}
+
+void ResumableTlsClient::setNetworkCache(NetworkCache* cache) {
+    _networkCache = cache;
+}
+
+const HttpEndpoint& ResumableTlsClient::getConnectedEndpoint() const {
+    return _connectedEndpoint;
+}
+
+int ResumableTlsClient::connect(const char* host, uint16_t port) {
+    return connect(host, port, _timeout);
+}
+
+bool ResumableTlsClient::openSocket(IPAddress ip, uint16_t port, int32_t timeout) {
+    int fd = lwip_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (fd < 0) {
+        return false;
+    }
+    sslclient->socket = fd;
+
+    struct sockaddr_in serverAddr;
+    memset(&serverAddr, 0, sizeof(serverAddr));
+    serverAddr.sin_family = AF_INET;
+    serverAddr.sin_addr.s_addr = (uint32_t)ip;
+    serverAddr.sin_port = htons(port);
+
+    // Non-blocking connect so the timeout applies (same as the stock client)
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    int res = lwip_connect(fd, (struct sockaddr*)&serverAddr, sizeof(serverAddr));
+    if (res < 0 && errno != EINPROGRESS) {
+        return false;
+    }
+
+    fd_set writeSet;
+    FD_ZERO(&writeSet);
+    FD_SET(fd, &writeSet);
+    struct timeval tv;
+    tv.tv_sec = timeout / 1000;
+    tv.tv_usec = (timeout % 1000) * 1000;
+    if (select(fd + 1, nullptr, &writeSet, nullptr, timeout < 0 ? nullptr : &tv) <= 0) {
+        return false;
+    }
+
+    int sockErr = 0;
+    socklen_t len = sizeof(sockErr);
+    if (getsockopt(fd, SOL_SOCKET, SO_ERROR, &sockErr, &len) < 0 || sockErr != 0) {
+        return false;
+    }
+
+    int enable = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+    return true;
+}
+
+bool ResumableTlsClient::verifyFingerprint(bool resumed) {
+    if (_fingerprint == nullptr) {
+        return true;
+    }
+
+    const mbedtls_x509_crt* peer = mbedtls_ssl_get_peer_cert(&sslclient->ssl_ctx);
+    if (peer == nullptr) {
+        // Resumed sessions may not carry the certificate; the cache key includes
+        // the pin, so the session was created by a handshake that passed this check
+        return resumed;
+    }
+
+    uint8_t digest[TLS_FINGERPRINT_SIZE];
+    // mbedtls_sha256_ret() is the 2.x name (arduino-esp32 2.x); 3.x only has mbedtls_sha256()
+#if MBEDTLS_VERSION_NUMBER >= 0x03000000
+    mbedtls_sha256(peer->raw.p, peer->raw.len, digest, 0);
+#else
+    mbedtls_sha256_ret(peer->raw.p, peer->raw.len, digest, 0);
+#endif
+    if (memcmp(digest, _fingerprint, TLS_FINGERPRINT_SIZE) != 0) {
+        char text[TLS_FINGERPRINT_TEXT_SIZE];
+        formatCertFingerprint(digest, text);
+        Logger::line("TLS certificate fingerprint mismatch!");
+        Logger::line(String("Server: ") + text);
+        return false;
+    }
+    return true;
+}
+
+int ResumableTlsClient::connect(const char* host, uint16_t port, int32_t timeout) {
+    IPAddress ip;
+    bool fromCache = false;
+    if (!resolveHost(_networkCache, host, ip, &fromCache)) {
+        return 0;
+    }
+
+    // Release any previous connection (also resets the mbedTLS contexts)
+    stop();
+    setHttpEndpoint(_connectedEndpoint, host, port, true);
+
+    unsigned long startTime = millis();
+    uint32_t hostHash = tlsSessionHostHash(host, port, _fingerprint);
+    uint32_t now = currentUnixTime();
+
+    if (!openSocket(ip, port, timeout)) {
+        // The cached address may be stale: one more try with a fresh lookup
+        stop();
+        if (!fromCache || !refreshHost(_networkCache, host, ip) || !openSocket(ip, port, timeout)) {
+            stop();
+            return 0;
+        }
+    }
+
+    // Same context setup as the stock client, plus a session to resume
+    static const char* pers = "esp32-tls";
+    mbedtls_entropy_init(&sslclient->entropy_ctx);
+    int ret = mbedtls_ctr_drbg_seed(&sslclient->drbg_ctx, mbedtls_entropy_func, &sslclient->entropy_ctx,
+                                    (const unsigned char*)pers, strlen(pers));
+    if (ret == 0) {
+        ret = mbedtls_ssl_config_defaults(&sslclient->ssl_conf, MBEDTLS_SSL_IS_CLIENT,
+                                          MBEDTLS_SSL_TRANSPORT_STREAM, MBEDTLS_SSL_PRESET_DEFAULT);
+    }
+    if (ret != 0) {
+        stop();
+        return 0;
+    }
+    // The chain is not validated (no CA store); the optional pin is checked after the handshake
+    mbedtls_ssl_conf_authmode(&sslclient->ssl_conf, MBEDTLS_SSL_VERIFY_NONE);
+    mbedtls_ssl_conf_rng(&sslclient->ssl_conf, mbedtls_ctr_drbg_random, &sslclient->drbg_ctx);
+
+    if (mbedtls_ssl_setup(&sslclient->ssl_ctx, &sslclient->ssl_conf) != 0 ||
+        mbedtls_ssl_set_hostname(&sslclient->ssl_ctx, host) != 0) {
+        stop();
+        return 0;
+    }
+
+    // Offer the cached session; the server either resumes it or silently
+    // falls back to a full handshake
+    unsigned char offeredId[32];
+    size_t offeredIdLen = 0;
+    size_t sessionLength = 0;
+    const uint8_t* cached = _cache != nullptr ? findTlsSession(*_cache, hostHash, now, &sessionLength) : nullptr;
+    if (cached != nullptr) {
+        mbedtls_ssl_session session;
+        mbedtls_ssl_session_init(&session);
+        if (mbedtls_ssl_session_load(&session, cached, sessionLength) == 0 &&
+            mbedtls_ssl_set_session(&sslclient->ssl_ctx, &session) == 0) {
+            offeredIdLen = session.id_len;
+            memcpy(offeredId, session.id, offeredIdLen);
+        }
+        mbedtls_ssl_session_free(&session);
+    }
+
+    mbedtls_ssl_set_bio(&sslclient->ssl_ctx, &sslclient->socket, mbedtls_net_send, mbedtls_net_recv, nullptr);
+
+    while ((ret = mbedtls_ssl_handshake(&sslclient->ssl_ctx)) != 0) {
+        if ((ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) ||
+            millis() - startTime > sslclient->handshake_timeout) {
+            Logger::linef("TLS handshake failed (-0x%04X)", -ret);
+            if (cached != nullptr) {
+                // Do not offer the same session again if it is what the server choked on
+                initTlsSessionCache(*_cache);
+            }
+            stop();
+            return 0;
+        }
+        vTaskDelay(2);
+    }
+
+    // A resumed handshake echoes the offered session ID (also for tickets, RFC 5077)
+    bool resumed = false;
+    mbedtls_ssl_session session;
+    mbedtls_ssl_session_init(&session);
+    bool haveSession = (mbedtls_ssl_get_session(&sslclient->ssl_ctx, &session) == 0);
+    if (haveSession) {
+        resumed = offeredIdLen > 0 && session.id_len == offeredIdLen &&
+                  memcmp(session.id, offeredId, offeredIdLen) == 0;
+    }
+
+    if (!verifyFingerprint(resumed)) {
+        mbedtls_ssl_session_free(&session);
+        if (_cache != nullptr) {
+            initTlsSessionCache(*_cache);
+        }
+        stop();
+        return 0;
+    }
+
+    // Keep the (possibly renewed) session for the next request or wake
+    if (_cache != nullptr && haveSession) {
+        static uint8_t buffer[TLS_SESSION_MAX_SIZE];
+        size_t length = 0;
+#if defined(MBEDTLS_X509_CRT_PARSE_C) && defined(MBEDTLS_SSL_KEEP_PEER_CERTIFICATE)
+        // Saved without the peer certificate (often over 2KB with the chain): the
+        // cache key includes the pin, and a resumed handshake is not checked again
+        mbedtls_x509_crt* peerCert = session.peer_cert;
+        session.peer_cert = nullptr;
+#endif
+        ret = mbedtls_ssl_session_save(&session, buffer, sizeof(buffer), &length);
+#if defined(MBEDTLS_X509_CRT_PARSE_C) && defined(MBEDTLS_SSL_KEEP_PEER_CERTIFICATE)
+        session.peer_cert = peerCert;  // Freed with the session
+#endif
+        if (ret == 0) {
+            storeTlsSession(*_cache, hostHash, buffer, length, now);
+        } else {
+            initTlsSessionCache(*_cache);
+            Logger::linef("TLS session not cached: %u bytes, at most %d", (unsigned)length, TLS_SESSION_MAX_SIZE);
+        }
+    }
+    mbedtls_ssl_session_free(&session);
+
+    unsigned long elapsed = millis() - startTime;
+    if (_stats != nullptr) {
+        if (resumed) {
+            _stats->resumedHandshakes++;
+        } else {
+            _stats->fullHandshakes++;
+        }
+        _stats->handshakeMs += elapsed;
+    }
+    Logger::linef("TLS %s handshake (%lums)", resumed ? "resumed" : "full", elapsed);
+
+    _connected = true;
+    return 1;
+}
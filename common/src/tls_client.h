@@ -0,0 +1,62 @@
+#ifndef TLS_CLIENT_H
+#define TLS_CLIENT_H
+
+#include <Arduino.h>
+#include <WiFiClientSecure.h>
+#include "tls_session_cache.h"
+#include "http_endpoint.h"
+#include "network_cache.h"
+
+// Handshake counters for one wake cycle (reported in LoopTimings)
+struct TlsStats {
+    uint8_t fullHandshakes;     // Full handshake (certificate + key exchange)
+    uint8_t resumedHandshakes;  // Abbreviated handshake from a cached session
+    uint32_t handshakeMs;       // Total time spent connecting + handshaking
+
+    TlsStats() : fullHandshakes(0), resumedHandshakes(0), handshakeMs(0) {}
+};
+
+/**
+ * @brief WiFiClientSecure that resumes TLS sessions and optionally pins the server certificate
+ *
+ * The stock client always runs a full handshake and has no hook to offer a
+ * saved session, so connect(host, port) performs the handshake itself on the
+ * client's mbedTLS context: it offers the session from the RTC cache, stores
+ * the resulting session back, and compares the certificate SHA-256 against
+ * the pin instead of validating the chain. Everything after connect
+ * (read/write/stop) is the unchanged WiFiClientSecure code.
+ *
+ * Without a pin the connection is unauthenticated, same as setInsecure().
+ */
+class ResumableTlsClient : public WiFiClientSecure {
+public:
+    ResumableTlsClient();
+
+    // RTC session cache (nullptr = no resumption)
+    void setSessionCache(TlsSessionCache* cache);
+    // Pinned certificate SHA-256 (nullptr = no pinning)
+    void setFingerprint(const uint8_t* fingerprint);
+    // Handshake counters to update (nullptr = not tracked)
+    void setStats(TlsStats* stats);
+    // RTC DNS cache (nullptr = resolve every time)
+    void setNetworkCache(NetworkCache* cache);
+
+    // Server of the current (or last) connection - may differ from the
+    // requested URL after a redirect, so keep-alive reuse checks use this
+    const HttpEndpoint& getConnectedEndpoint() const;
+
+    int connect(const char* host, uint16_t port) override;
+    int connect(const char* host, uint16_t port, int32_t timeout) override;
+
+private:
+    TlsSessionCache* _cache;
+    const uint8_t* _fingerprint;
+    TlsStats* _stats;
+    NetworkCache* _networkCache;
+    HttpEndpoint _connectedEndpoint;
+
+    bool openSocket(IPAddress ip, uint16_t port, int32_t timeout);
+    bool verifyFingerprint(bool resumed);
+};
+
+#endif // TLS_CLIENT_H
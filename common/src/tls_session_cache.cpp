@@ -0,0 +1,106 @@
+#include <tls_session_cache.h>
+#include <fnv1a.h>
+#include <string.h>
+
+void initTlsSessionCache(TlsSessionCache& cache) {
+    cache.magic = 0;
+    cache.hostHash = 0;
+    cache.savedAt = 0;
+    cache.length = 0;
+}
+
+uint32_t tlsSessionHostHash(const char* host, uint16_t port, const uint8_t* fingerprint) {
+    // FNV-1a - collisions only cost a rejected resumption (full handshake)
+    uint32_t hash = FNV1A_OFFSET_BASIS;
+    for (const char* p = host; p != nullptr && *p != '\0'; p++) {
+        char c = *p;
+        if (c >= 'A' && c <= 'Z') {
+            c = (char)(c - 'A' + 'a');
+        }
+        hash = fnv1aByte(hash, (uint8_t)c);
+    }
+    hash = fnv1aByte(hash, (uint8_t)(port >> 8));
+    hash = fnv1aByte(hash, (uint8_t)(port & 0xFF));
+    if (fingerprint != nullptr) {
+        hash = fnv1a(hash, fingerprint, TLS_FINGERPRINT_SIZE);
+    }
+    return hash;
+}
+
+bool storeTlsSession(TlsSessionCache& cache, uint32_t hostHash, const uint8_t* data, size_t length, uint32_t now) {
+    initTlsSessionCache(cache);
+    if (data == nullptr || length == 0 || length > TLS_SESSION_MAX_SIZE) {
+        return false;
+    }
+    memcpy(cache.data, data, length);
+    cache.length = (uint16_t)length;
+    cache.hostHash = hostHash;
+    cache.savedAt = now;
+    cache.magic = TLS_SESSION_CACHE_MAGIC;
+    return true;
+}
+
+const uint8_t* findTlsSession(const TlsSessionCache& cache, uint32_t hostHash, uint32_t now, size_t* outLength) {
+    if (cache.magic != TLS_SESSION_CACHE_MAGIC || cache.length == 0 ||
+        cache.length > TLS_SESSION_MAX_SIZE || cache.hostHash != hostHash) {
+        return nullptr;
+    }
+    // Only check the age when both timestamps are real; a clock that went
+    // backwards means we cannot tell, so treat it as expired
+    if (now != 0 && cache.savedAt != 0) {
+        if (now < cache.savedAt || now - cache.savedAt > TLS_SESSION_MAX_AGE_SECONDS) {
+            return nullptr;
+        }
+    }
+    if (outLength != nullptr) {
+        *outLength = cache.length;
+    }
+    return cache.data;
+}
+
+static int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+bool parseCertFingerprint(const char* text, uint8_t out[TLS_FINGERPRINT_SIZE]) {
+    if (text == nullptr) {
+        return false;
+    }
+    int nibbles = 0;
+    for (const char* p = text; *p != '\0'; p++) {
+        if (*p == ':' || *p == ' ' || *p == '-') {
+            // Separators only allowed between bytes
+            if (nibbles % 2 != 0) {
+                return false;
+            }
+            continue;
+        }
+        int value = hexValue(*p);
+        if (value < 0 || nibbles >= TLS_FINGERPRINT_SIZE * 2) {
+            return false;
+        }
+        if (nibbles % 2 == 0) {
+            out[nibbles / 2] = (uint8_t)(value << 4);
+        } else {
+            out[nibbles / 2] |= (uint8_t)value;
+        }
+        nibbles++;
+    }
+    return nibbles == TLS_FINGERPRINT_SIZE * 2;
+}
+
+void formatCertFingerprint(const uint8_t fingerprint[TLS_FINGERPRINT_SIZE], char out[TLS_FINGERPRINT_TEXT_SIZE]) {
+    static const char digits[] = "0123456789ABCDEF";
+    char* p = out;
+    for (int i = 0; i < TLS_FINGERPRINT_SIZE; i++) {
+        if (i > 0) {
+            *p++ = ':';
+        }
+        *p++ = digits[fingerprint[i] >> 4];
+        *p++ = digits[fingerprint[i] & 0x0F];
+    }
+    *p = '\0';
+}
@@ -0,0 +1,80 @@
+#ifndef TLS_SESSION_CACHE_H
+#define TLS_SESSION_CACHE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define TLS_SESSION_CACHE_MAGIC 0x544C5332     // "TLS2" - bump when the layout changes
+#define TLS_SESSION_MAX_SIZE 1024               // Serialized mbedTLS session (ID or ticket, saved without the peer certificate)
+#define TLS_SESSION_MAX_AGE_SECONDS 43200       // 12 hours - servers rarely honor tickets longer
+#define TLS_FINGERPRINT_SIZE 32                 // SHA-256 of the server certificate (DER)
+#define TLS_FINGERPRINT_TEXT_SIZE 96            // "AA:BB:...:FF" (95 chars) + terminator
+
+/**
+ * @brief One cached TLS session, kept in RTC memory across deep sleep
+ *
+ * Holds the serialized session (session ID and/or ticket) of the last HTTPS
+ * server the device talked to. Offering it on the next connect lets the
+ * server resume with an abbreviated handshake: no certificate chain, no key
+ * exchange, one round trip less. The image and its .crc32 sidecar usually
+ * live on the same host, so a single entry covers both requests of a cycle.
+ */
+struct TlsSessionCache {
+    uint32_t magic;                       // TLS_SESSION_CACHE_MAGIC (anything else = empty, e.g. cold boot)
+    uint32_t hostHash;                    // tlsSessionHostHash() of the server the session belongs to
+    uint32_t savedAt;                     // Unix time when stored (0 = clock was not set)
+    uint16_t length;                      // Bytes used in data
+    uint8_t data[TLS_SESSION_MAX_SIZE];   // Output of mbedtls_ssl_session_save()
+};
+
+/**
+ * @brief Pure TLS session cache and fingerprint functions
+ *
+ * These functions contain NO dependencies on Arduino/ESP32 APIs,
+ * making them fully testable with standard C++ unit testing frameworks.
+ */
+
+/**
+ * @brief Reset cache to empty
+ */
+void initTlsSessionCache(TlsSessionCache& cache);
+
+/**
+ * @brief Key identifying a server (host name case-insensitive, port, and pin)
+ * @param fingerprint Pinned certificate SHA-256, or nullptr when not pinning.
+ *                    Part of the key so a session from an unpinned connection is
+ *                    never resumed once a pin is configured (and vice versa).
+ */
+uint32_t tlsSessionHostHash(const char* host, uint16_t port, const uint8_t* fingerprint);
+
+/**
+ * @brief Store a session, replacing the previous one
+ * @param now Current Unix time (0 if unknown)
+ * @return false if the session does not fit (cache is left empty)
+ */
+bool storeTlsSession(TlsSessionCache& cache, uint32_t hostHash, const uint8_t* data, size_t length, uint32_t now);
+
+/**
+ * @brief Find a session to offer for a server
+ * @param now Current Unix time (0 if unknown - age is then not checked)
+ * @param outLength Receives the session length
+ * @return Serialized session, or nullptr if none matches or it expired
+ */
+const uint8_t* findTlsSession(const TlsSessionCache& cache, uint32_t hostHash, uint32_t now, size_t* outLength);
+
+/**
+ * @brief Parse a certificate fingerprint as shown by browsers or openssl
+ *
+ * Accepts 64 hex digits, optionally separated by ':', ' ' or '-'
+ * (e.g. "AB:CD:..." or "abcd..."). Case-insensitive.
+ *
+ * @return false if the text is not exactly 32 bytes of hex
+ */
+bool parseCertFingerprint(const char* text, uint8_t out[TLS_FINGERPRINT_SIZE]);
+
+/**
+ * @brief Format a fingerprint as upper-case "AB:CD:..." (canonical form stored in config)
+ */
+void formatCertFingerprint(const uint8_t fingerprint[TLS_FINGERPRINT_SIZE], char out[TLS_FINGERPRINT_TEXT_SIZE]);
+
+#endif // TLS_SESSION_CACHE_H
@@ -1,8 +1,28 @@
 #include "wifi_manager.h"
 #include "logger.h"
+#include <time.h>
+#include <esp_netif.h>
+#include <esp_netif_net_stack.h>
+#include <lwip/dhcp.h>
+
+// Lease time offered by the DHCP server (0 if unknown)
+static uint32_t getDhcpLeaseSeconds() {
+    esp_netif_t* netif = esp_netif_get_handle_from_ifkey("WIFI_STA_DEF");
+    if (netif == nullptr) {
+        return 0;
+    }
+    struct netif* lwipNetif = (struct netif*)esp_netif_get_netif_impl(netif);
+    if (lwipNetif == nullptr) {
+        return 0;
+    }
+    struct dhcp* dhcp = netif_dhcp_data(lwipNetif);
+    return dhcp != nullptr ? dhcp->offered_t0_lease : 0;
+}
 
 WiFiManager::WiFiManager(ConfigManager* configManager) 
-    : _configManager(configManager), _powerManager(nullptr), _apActive(false), _mdnsActive(false), _dnsServer(nullptr) {
+    : _configManager(configManager), _powerManager(nullptr), _apActive(false), _mdnsActive(false), _dnsServer(nullptr),
+      _networkCache(nullptr), _connectPending(false), _connectLocked(false), _leaseApplied(false),
+      _useDhcp(true), _saveChannel(false), _connectStartMs(0), _earlyConnectMs(0) {
     _apName = String(AP_SSID_PREFIX) + generateDeviceID();
 }
 
@@ -10,6 +30,50 @@ void WiFiManager::setPowerManager(PowerManager* powerManager) {
     _powerManager = powerManager;
 }
 
+void WiFiManager::setNetworkCache(NetworkCache* cache) {
+    _networkCache = cache;
+    if (_networkCache != nullptr && !isNetworkCacheValid(*_networkCache)) {
+        initNetworkCache(*_networkCache);  // Cold boot or layout change
+    }
+}
+
+void WiFiManager::invalidateNetworkCache() {
+    if (_networkCache != nullptr) {
+        initNetworkCache(*_networkCache);
+    }
+}
+
+bool WiFiManager::applyCachedLease(const String& ssid, const uint8_t* bssid) {
+    if (_networkCache == nullptr) {
+        return false;
+    }
+    const DhcpLeaseCache* lease = getReusableDhcpLease(*_networkCache, networkCacheHash(ssid.c_str()), bssid,
+                                                       (uint32_t)time(nullptr));
+    if (lease == nullptr) {
+        return false;
+    }
+    if (!WiFi.config(IPAddress(lease->ip), IPAddress(lease->gateway), IPAddress(lease->subnet),
+                     IPAddress(lease->dns1), IPAddress(lease->dns2))) {
+        return false;
+    }
+    Logger::linef("Reusing DHCP lease %s", IPAddress(lease->ip).toString().c_str());
+    return true;
+}
+
+void WiFiManager::saveDhcpLease(const String& ssid) {
+    if (_networkCache == nullptr) {
+        return;
+    }
+    DhcpLeaseCache lease = {};
+    lease.ip = (uint32_t)WiFi.localIP();
+    lease.gateway = (uint32_t)WiFi.gatewayIP();
+    lease.subnet = (uint32_t)WiFi.subnetMask();
+    lease.dns1 = (uint32_t)WiFi.dnsIP(0);
+    lease.dns2 = (uint32_t)WiFi.dnsIP(1);
+    storeDhcpLease(*_networkCache, lease, getDhcpLeaseSeconds(), networkCacheHash(ssid.c_str()), WiFi.BSSID(),
+                   (uint32_t)time(nullptr));
+}
+
 WiFiManager::~WiFiManager() {
     if (_apActive) {
         stopAccessPoint();  // This already deletes _dnsServer
@@ -123,12 +187,16 @@ bool WiFiManager::isAPActive() {
     return _apActive;
 }
 
-bool WiFiManager::connectToWiFi(const String& ssid, const String& password, uint8_t* outRetryCount, bool disableAutoReconnect) {
-    Logger::begin("Connecting to WiFi");
+bool WiFiManager::beginConnect(const String& ssid, const String& password, bool disableAutoReconnect) {
+    Logger::begin("Starting WiFi");
     Logger::line("SSID: " + ssid);
     
-    // Initialize retry count
-    uint8_t retryCount = 0;
+    _connectPending = false;
+    _earlyConnectMs = 0;
+    
+    // Kept in RAM for the full scan fallback in awaitConnection()
+    _connectSSID = ssid;
+    _connectPassword = password;
     
     // Stop AP mode if active
     if (_apActive) {
@@ -148,7 +216,9 @@ bool WiFiManager::connectToWiFi(const String& ssid, const String& password, uint
     WiFi.setAutoReconnect(!disableAutoReconnect);
     
     // Check if static IP is configured
+    _useDhcp = true;
     if (_configManager && _configManager->getUseStaticIP()) {
+        _useDhcp = false;
         String staticIP = _configManager->getStaticIP();
         String gateway = _configManager->getGateway();
         String subnet = _configManager->getSubnet();
@@ -158,7 +228,6 @@ bool WiFiManager::connectToWiFi(const String& ssid, const String& password, uint
         if (!configureStaticIP(staticIP, gateway, subnet, dns1, dns2)) {
             Logger::line("Failed to configure static IP, connection aborted");
             Logger::end();
-            if (outRetryCount) *outRetryCount = retryCount;
             return false;
         }
     } else {
@@ -166,8 +235,9 @@ bool WiFiManager::connectToWiFi(const String& ssid, const String& password, uint
     }
     
     // Determine connection strategy based on wake reason
-    bool useChannelLock = false;
-    bool shouldSaveChannel = false;
+    _connectLocked = false;
+    _saveChannel = false;
+    _leaseApplied = false;
     WakeupReason wakeReason = WAKEUP_FIRST_BOOT;
     
     if (_powerManager) {
@@ -175,11 +245,11 @@ bool WiFiManager::connectToWiFi(const String& ssid, const String& password, uint
         
         // Use channel lock only for timer wakeups (optimization for regular updates)
         if (wakeReason == WAKEUP_TIMER && _configManager && _configManager->hasWiFiChannelLock()) {
-            useChannelLock = true;
+            _connectLocked = true;
             Logger::line("Using channel lock (timer wake)");
         } else {
             // For boot, reset, or button wakeups, do full scan and save new channel/BSSID
-            shouldSaveChannel = true;
+            _saveChannel = true;
             const char* wakeReasonStr = 
                 wakeReason == WAKEUP_FIRST_BOOT ? "first boot" :
                 wakeReason == WAKEUP_RESET_BUTTON ? "reset" :
@@ -188,27 +258,84 @@ bool WiFiManager::connectToWiFi(const String& ssid, const String& password, uint
         }
     } else {
         Logger::line("Full scan (no PowerManager)");
-        shouldSaveChannel = true;
+        _saveChannel = true;
     }
     
-    // Try connection with channel lock (fast path)
-    if (useChannelLock) {
+    if (_connectLocked) {
+        // Fast path: the channel and AP of the last connection
         uint8_t channel = _configManager->getWiFiChannel();
         uint8_t bssid[6];
         _configManager->getWiFiBSSID(bssid);
         
         Logger::linef("Channel %d locked connection", channel);
+        // Same AP as last time: skip DHCP with the lease it handed out
+        _leaseApplied = _useDhcp && applyCachedLease(ssid, bssid);
         WiFi.begin(ssid.c_str(), password.c_str(), channel, bssid);
-        
-        // Wait with shorter timeout for channel-locked connection
-        unsigned long startTime = millis();
-        while (WiFi.status() != WL_CONNECTED && millis() - startTime < 2000) {
+    } else {
+        // Full scan connection (slower but more reliable)
+        Logger::line("Scanning...");
+        WiFi.begin(ssid.c_str(), password.c_str());
+    }
+    
+    _connectStartMs = millis();
+    _connectPending = true;
+    Logger::end();
+    return true;
+}
+
+bool WiFiManager::beginConnect(bool disableAutoReconnect) {
+    if (!_configManager) {
+        Logger::message("WiFi Connection", "ConfigManager not set");
+        return false;
+    }
+    
+    String ssid = _configManager->getWiFiSSID();
+    String password = _configManager->getWiFiPassword();
+    
+    if (ssid.length() == 0) {
+        Logger::message("WiFi Connection", "No WiFi credentials stored");
+        return false;
+    }
+    
+    return beginConnect(ssid, password, disableAutoReconnect);
+}
+
+bool WiFiManager::awaitConnection(uint8_t* outRetryCount) {
+    if (!_connectPending) {
+        Logger::message("WiFi Connection", "No connection started");
+        if (outRetryCount) *outRetryCount = 0;
+        return false;
+    }
+    _connectPending = false;
+    
+    // Association ran this long before anyone waited for it
+    _earlyConnectMs = millis() - _connectStartMs;
+    
+    Logger::begin("Connecting to WiFi");
+    if (_earlyConnectMs > 0) {
+        Logger::linef("Started %lums earlier", (unsigned long)_earlyConnectMs);
+    }
+    
+    // Initialize retry count
+    uint8_t retryCount = 0;
+    const String& ssid = _connectSSID;
+    const String& password = _connectPassword;
+    
+    // Deadlines count from WiFi.begin(), so an early start shortens the wait
+    unsigned long startTime = _connectStartMs;
+    
+    // Wait for the channel-locked connection
+    if (_connectLocked) {
+        while (WiFi.status() != WL_CONNECTED && millis() - startTime < WIFI_CHANNEL_LOCK_TIMEOUT_MS) {
             delay(10);  // Reduced polling interval for faster response
         }
         
         if (WiFi.status() == WL_CONNECTED) {
             WiFi.setSleep(false);
             Logger::linef("Connected! IP: %s, RSSI: %d dBm", WiFi.localIP().toString().c_str(), WiFi.RSSI());
+            if (_useDhcp && !_leaseApplied) {
+                saveDhcpLease(ssid);
+            }
             Logger::end();
             if (outRetryCount) *outRetryCount = retryCount;  // 0 retries for channel lock success
             return true;
@@ -218,19 +345,23 @@ bool WiFiManager::connectToWiFi(const String& ssid, const String& password, uint
         // This counts as the first retry (fallback to full scan)
         Logger::line("Lock failed - falling back to full scan");
         WiFi.disconnect();
+        if (_leaseApplied) {
+            // Back to DHCP for the full scan
+            invalidateDhcpLease(*_networkCache);
+            WiFi.config(INADDR_NONE, INADDR_NONE, INADDR_NONE);
+        }
         delay(100);
-        shouldSaveChannel = true;  // Save new channel after successful full scan
+        _saveChannel = true;  // Save new channel after successful full scan
+        
+        Logger::line("Scanning...");
+        WiFi.begin(ssid.c_str(), password.c_str());
+        startTime = millis();
     }
     
     // Full scan connection (slower but more reliable)
     // Optimized timeouts: 3s per attempt (down from 5s), 300ms retry delay (down from 1s)
     // Max retries: 4 (up from 3) to compensate for shorter timeout
     // Total max time: 3s + 0.3s + 3s + 0.3s + 3s + 0.3s + 3s + 0.3s + 3s = 16.2s (vs 23s previously)
-    Logger::line("Scanning...");
-    WiFi.begin(ssid.c_str(), password.c_str());
-    
-    // Wait for connection with optimized timeout
-    unsigned long startTime = millis();
     int fullScanRetries = 0;  // Track full scan retry attempts
     const int maxRetries = 4;  // Increased from 3 to 4
     const unsigned long timeout = 3000;  // Reduced from 5000ms to 3000ms
@@ -252,7 +383,7 @@ bool WiFiManager::connectToWiFi(const String& ssid, const String& password, uint
     // - If channel lock was used and failed: 1 for the fallback + full scan timeout retries
     // - If no channel lock: only full scan timeout retries
     // fullScanRetries is incremented each time we timeout in the full scan loop
-    if (useChannelLock) {
+    if (_connectLocked) {
         retryCount = 1 + fullScanRetries;  // Channel lock fallback (1) + full scan timeouts
     } else {
         retryCount = fullScanRetries;  // Only full scan timeout retries
@@ -267,8 +398,12 @@ bool WiFiManager::connectToWiFi(const String& ssid, const String& password, uint
             Logger::linef("mDNS: http://%s", getMDNSHostname().c_str());
         }
         
+        if (_useDhcp) {
+            saveDhcpLease(ssid);
+        }
+        
         // Save channel and BSSID for future fast connections
-        if (shouldSaveChannel && _configManager) {
+        if (_saveChannel && _configManager) {
             uint8_t channel = WiFi.channel();
             uint8_t* bssid = WiFi.BSSID();
             if (channel > 0 && bssid != nullptr) {
@@ -288,23 +423,34 @@ bool WiFiManager::connectToWiFi(const String& ssid, const String& password, uint
     }
 }
 
-bool WiFiManager::connectToWiFi(uint8_t* outRetryCount, bool disableAutoReconnect) {
-    if (!_configManager) {
-        Logger::message("WiFi Connection", "ConfigManager not set");
+bool WiFiManager::isConnectPending() {
+    return _connectPending;
+}
+
+uint32_t WiFiManager::getEarlyConnectMs() {
+    return _earlyConnectMs;
+}
+
+bool WiFiManager::connectToWiFi(const String& ssid, const String& password, uint8_t* outRetryCount, bool disableAutoReconnect) {
+    if (!beginConnect(ssid, password, disableAutoReconnect)) {
         if (outRetryCount) *outRetryCount = 0;
         return false;
     }
+    return awaitConnection(outRetryCount);
+}
+
+bool WiFiManager::connectToWiFi(uint8_t* outRetryCount, bool disableAutoReconnect) {
+    if (_connectPending) {
+        // Started early by beginConnect(): only the auto-reconnect choice is left to apply
+        WiFi.setAutoReconnect(!disableAutoReconnect);
+        return awaitConnection(outRetryCount);
+    }
     
-    String ssid = _configManager->getWiFiSSID();
-    String password = _configManager->getWiFiPassword();
-    
-    if (ssid.length() == 0) {
-        Logger::message("WiFi Connection", "No WiFi credentials stored");
+    if (!beginConnect(disableAutoReconnect)) {
         if (outRetryCount) *outRetryCount = 0;
         return false;
     }
-    
-    return connectToWiFi(ssid, password, outRetryCount, disableAutoReconnect);
+    return awaitConnection(outRetryCount);
 }
 
 void WiFiManager::disconnect() {
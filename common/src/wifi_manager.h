@@ -8,6 +8,7 @@
 #include <DNSServer.h>
 #include "config_manager.h"
 #include "power_manager.h"
+#include "network_cache.h"
 
 // Access Point configuration
 #define AP_SSID_PREFIX "inkplate-dashb-"
@@ -16,6 +17,7 @@
 
 // WiFi Client configuration
 #define WIFI_CONNECT_TIMEOUT_MS 10000  // 10 seconds timeout for WiFi connection
+#define WIFI_CHANNEL_LOCK_TIMEOUT_MS 2000  // Channel-locked attempt, counted from WiFi.begin()
 #define WIFI_MAX_RETRIES 3
 
 class WiFiManager {
@@ -32,7 +34,15 @@ public:
     
     // WiFi Client Mode
     bool connectToWiFi(const String& ssid, const String& password, uint8_t* outRetryCount = nullptr, bool disableAutoReconnect = false);
-    bool connectToWiFi(uint8_t* outRetryCount = nullptr, bool disableAutoReconnect = false);  // Uses stored credentials
+    bool connectToWiFi(uint8_t* outRetryCount = nullptr, bool disableAutoReconnect = false);  // Uses stored credentials (awaits an early start)
+    
+    // Non-blocking connect: start association now, wait for it with awaitConnection() later,
+    // so it runs while the display powers up and the configuration is loaded
+    bool beginConnect(const String& ssid, const String& password, bool disableAutoReconnect = false);
+    bool beginConnect(bool disableAutoReconnect = false);  // Uses stored credentials
+    bool awaitConnection(uint8_t* outRetryCount = nullptr);  // Channel lock deadline, then full scan retries
+    bool isConnectPending();
+    uint32_t getEarlyConnectMs();  // How long the last association ran before it was awaited
     void disconnect();
     bool isConnected();
     String getLocalIP();
@@ -48,6 +58,12 @@ public:
     // Power management integration
     void setPowerManager(PowerManager* powerManager);
     
+    // DHCP lease and DNS cache (RTC memory); timer wakes with channel lock reuse the lease
+    void setNetworkCache(NetworkCache* cache);
+    
+    // Forget the cached lease and host addresses (e.g. after a failed download)
+    void invalidateNetworkCache();
+    
     // Device identification
     String generateDeviceID();  // Generate MAC-based ID (e.g., "AABBCC")
     String getDeviceIdentifier();  // Get friendly name if set, else "inkplate-XXXXXX"
@@ -67,6 +83,24 @@ private:
     bool _apActive;
     bool _mdnsActive;
     DNSServer* _dnsServer;  // DNS server for captive portal
+    NetworkCache* _networkCache;  // Last DHCP lease + resolved hosts (RTC memory, may be null)
+    
+    // Connection started by beginConnect(), not yet awaited
+    bool _connectPending;
+    bool _connectLocked;          // Started on the saved channel/BSSID
+    bool _leaseApplied;           // Cached DHCP lease applied as a static configuration
+    bool _useDhcp;
+    bool _saveChannel;            // Remember channel/BSSID after a full scan
+    unsigned long _connectStartMs;
+    uint32_t _earlyConnectMs;
+    String _connectSSID;          // Credentials read once, reused by the full scan fallback
+    String _connectPassword;
+    
+    // Apply the cached lease as a static configuration (same SSID and AP, before T1)
+    bool applyCachedLease(const String& ssid, const uint8_t* bssid);
+    
+    // Remember the lease DHCP just handed out
+    void saveDhcpLease(const String& ssid);
 };
 
 #endif // WIFI_MANAGER_H
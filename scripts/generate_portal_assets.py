@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+"""
+Minify and gzip the config portal stylesheet and scripts into flash arrays.
+
+The sources stay readable in common/src/config_portal_css.h and
+common/src/config_portal_js.h; this script writes
+common/src/config_portal_assets.h with one gzip stream per served file, its
+ETag (CRC32 of the minified content) and a versioned URL for the pages to
+link. build.sh / build.ps1 run it before compiling:
+
+    python3 scripts/generate_portal_assets.py           regenerate if out of date
+    python3 scripts/generate_portal_assets.py --check   fail if out of date
+    python3 scripts/generate_portal_assets.py --force   regenerate even if up to date
+
+"Out of date" means an ETag differs from the sources. The gzip bytes depend
+on the local zlib build, so the header is not rewritten just because this
+machine would compress the same content differently; a build then leaves
+the committed file alone.
+
+Minification is line based and conservative: leading/trailing whitespace,
+empty lines, whole-line // comments (scripts) and /* */ comments
+(stylesheet) are removed; line breaks stay so script semantics do not change.
+The host test (test/unit/test_portal_assets.cpp) inflates every array and
+compares it with the sources minified the same way.
+"""
+
+import argparse
+import gzip
+import os
+import re
+import sys
+import zlib
+
+ROOT = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+SRC = os.path.join(ROOT, "common", "src")
+OUTPUT = os.path.join(SRC, "config_portal_assets.h")
+
+# (symbol, path, content type, source file, raw strings joined with "\n")
+ASSETS = [
+    ("STYLES_CSS", "/styles.css", "text/css", "config_portal_css.h",
+     ["CONFIG_PORTAL_CSS"]),
+    ("MAIN_JS", "/scripts/main.js", "application/javascript", "config_portal_js.h",
+     ["CONFIG_PORTAL_MODAL_SCRIPT", "CONFIG_PORTAL_FRIENDLY_NAME_SCRIPT",
+      "CONFIG_PORTAL_BATTERY_CALC_SCRIPT", "CONFIG_PORTAL_BADGE_SCRIPT"]),
+    ("OTA_JS", "/scripts/ota.js", "application/javascript", "config_portal_js.h",
+     ["CONFIG_PORTAL_OTA_SCRIPT"]),
+    ("OTA_STATUS_JS", "/scripts/ota-status.js", "application/javascript", "config_portal_js.h",
+     ["CONFIG_PORTAL_OTA_STATUS_SCRIPT"]),
+]
+
+
+def raw_string(source, name):
+    """Body of  const char* NAME = R"( ... )";"""
+    match = re.search(r'const char\* ' + name + r' = R"\((.*?)\)";', source, re.DOTALL)
+    if match is None:
+        sys.exit("%s not found in the portal sources" % name)
+    return match.group(1)
+
+
+def minify(text, content_type):
+    if content_type == "text/css":
+        text = re.sub(r"/\*.*?\*/", "", text, flags=re.DOTALL)
+    lines = []
+    for line in text.split("\n"):
+        line = line.strip(" \t\r")
+        if not line or (content_type != "text/css" and line.startswith("//")):
+            continue
+        lines.append(line)
+    return "\n".join(lines)
+
+
+def build_assets():
+    sources = {}
+    result = []
+    for symbol, path, content_type, filename, names in ASSETS:
+        if filename not in sources:
+            with open(os.path.join(SRC, filename), encoding="utf-8") as f:
+                sources[filename] = f.read()
+        text = "\n".join(raw_string(sources[filename], name) for name in names)
+        content = minify(text, content_type).encode("utf-8")
+        etag = "%08x" % (zlib.crc32(content) & 0xFFFFFFFF)
+        data = gzip.compress(content, compresslevel=9, mtime=0)
+        result.append((symbol, path, content_type, content, etag, data, len(text.encode("utf-8"))))
+    return result
+
+
+def stale_assets(assets):
+    """Paths whose ETag in config_portal_assets.h differs from the sources."""
+    # Compare ETags, not bytes: another zlib build may compress differently
+    try:
+        with open(OUTPUT, encoding="utf-8") as f:
+            current = f.read()
+    except OSError:
+        current = ""
+    return [path for symbol, path, _, _, etag, _, _ in assets
+            if ('#define PORTAL_%s_URL "%s?v=%s"' % (symbol, path, etag)) not in current]
+
+
+def c_array(data):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    return "\n".join(lines)
+
+
+def render(assets):
+    out = []
+    out.append("// Config Portal assets - GENERATED by scripts/generate_portal_assets.py, do not edit")
+    out.append("// Minified + gzipped from config_portal_css.h and config_portal_js.h; run the script")
+    out.append("// after changing them (build.sh does when they changed, the host tests catch stale data).")
+    out.append("")
+    out.append("#ifndef CONFIG_PORTAL_ASSETS_H")
+    out.append("#define CONFIG_PORTAL_ASSETS_H")
+    out.append("")
+    out.append("#include <portal_assets.h>")
+    out.append("")
+    out.append("#ifndef PROGMEM")
+    out.append("#define PROGMEM")
+    out.append("#endif")
+    out.append("")
+    for symbol, path, _, _, etag, _, _ in assets:
+        out.append('#define PORTAL_%s_URL "%s?v=%s"' % (symbol, path, etag))
+    out.append("")
+    for symbol, path, _, content, _, data, original in assets:
+        out.append("// %s: %d bytes source, %d minified, %d gzipped" % (path, original, len(content), len(data)))
+        out.append("static const uint8_t PORTAL_ASSET_%s[] PROGMEM = {" % symbol)
+        out.append(c_array(data))
+        out.append("};")
+        out.append("")
+    out.append("static const PortalAsset PORTAL_ASSETS[] = {")
+    for symbol, path, content_type, content, etag, _, _ in assets:
+        out.append('    { "%s", "%s", "\\"%s\\"", PORTAL_ASSET_%s, sizeof(PORTAL_ASSET_%s), %d },'
+                   % (path, content_type, etag, symbol, symbol, len(content)))
+    out.append("};")
+    out.append("")
+    out.append("#define PORTAL_ASSET_COUNT (sizeof(PORTAL_ASSETS) / sizeof(PORTAL_ASSETS[0]))")
+    out.append("")
+    out.append("#endif // CONFIG_PORTAL_ASSETS_H")
+    out.append("")
+    return "\n".join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().split("\n")[0])
+    parser.add_argument("--check", action="store_true",
+                        help="exit with status 1 if config_portal_assets.h does not match the sources")
+    parser.add_argument("--force", action="store_true",
+                        help="rewrite config_portal_assets.h even if its ETags match the sources")
+    args = parser.parse_args()
+
+    assets = build_assets()
+    stale = stale_assets(assets)
+    if args.check:
+        if stale:
+            print("config_portal_assets.h is out of date (%s): run scripts/generate_portal_assets.py"
+                  % ", ".join(stale))
+            return 1
+        print("config_portal_assets.h is up to date")
+        return 0
+
+    if not stale and not args.force:
+        print("config_portal_assets.h is up to date")
+        return 0
+    with open(OUTPUT, "w", encoding="utf-8", newline="\n") as f:
+        f.write(render(assets))
+    for _, path, _, content, _, data, original in assets:
+        print("%-24s %6d -> %6d -> %6d bytes" % (path, original, len(content), len(data)))
+    print("Wrote %s" % os.path.relpath(OUTPUT, ROOT))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
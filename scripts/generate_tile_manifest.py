@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+"""
+Split a dashboard image into tiles and write a tile manifest for the device.
+
+The device downloads <name>.tiles, compares each tile's CRC32 with the frame on
+screen and fetches only the tiles that changed (see "Tile Manifests" in
+docs/user/USING.md). Run this every time the dashboard image is regenerated:
+
+    python3 scripts/generate_tile_manifest.py dashboard.png /var/www/dash
+
+writes
+
+    /var/www/dash/dashboard.tiles         manifest (point the device here)
+    /var/www/dash/dashboard.tiles.crc32   checksum of the manifest (CRC32 change detection)
+    /var/www/dash/dashboard_tiles/*.png   one grayscale PNG per tile
+
+Tile files whose content did not change are left untouched, and the manifest is
+replaced atomically after all tiles are written, so a device never sees a
+manifest that refers to tiles that are not there yet.
+
+Requires Pillow (pip install pillow).
+"""
+
+import argparse
+import io
+import os
+import sys
+import zlib
+
+try:
+    from PIL import Image
+except ImportError:
+    sys.exit("Pillow is required: pip install pillow")
+
+MANIFEST_HEADER = "inkplate-tiles 1"
+MAX_TILES = 64  # TILE_MANIFEST_MAX_TILES in common/src/tile_manifest.h
+
+
+def tile_edges(size, count, align):
+    """Split size into count spans; inner edges rounded up to a multiple of align."""
+    step = -(-size // count)
+    step = -(-step // align) * align
+    edges = list(range(0, size, step)) + [size]
+    return list(zip(edges[:-1], edges[1:]))
+
+
+def encode_png(image):
+    buffer = io.BytesIO()
+    # Fixed settings keep the bytes (and CRC32) identical for identical pixels
+    image.save(buffer, format="PNG", optimize=False, compress_level=9)
+    return buffer.getvalue()
+
+
+def write_if_changed(path, data):
+    if os.path.exists(path):
+        with open(path, "rb") as f:
+            if f.read() == data:
+                return False
+    tmp = path + ".tmp"
+    with open(tmp, "wb") as f:
+        f.write(data)
+    os.replace(tmp, path)
+    return True
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate an Inkplate dashboard tile manifest")
+    parser.add_argument("image", help="Dashboard image (any format Pillow reads), must match the screen size")
+    parser.add_argument("output_dir", help="Directory served by the web server")
+    parser.add_argument("--name", help="Manifest name (default: image file name without extension)")
+    parser.add_argument("--grid", default="6x4",
+                        help="Tile columns x rows (default 6x4; at most %d tiles)" % MAX_TILES)
+    args = parser.parse_args()
+
+    try:
+        cols, rows = (int(v) for v in args.grid.lower().split("x"))
+    except ValueError:
+        sys.exit("--grid must look like 6x4")
+    if cols < 1 or rows < 1 or cols * rows > MAX_TILES:
+        sys.exit("--grid must have between 1 and %d tiles" % MAX_TILES)
+
+    name = args.name or os.path.splitext(os.path.basename(args.image))[0]
+    tile_dir_name = name + "_tiles"
+    tile_dir = os.path.join(args.output_dir, tile_dir_name)
+    os.makedirs(tile_dir, exist_ok=True)
+
+    image = Image.open(args.image).convert("L")
+    width, height = image.size
+
+    lines = [MANIFEST_HEADER, "size %d %d" % (width, height)]
+    written = 0
+    # Tile x and width must be multiples of 8 (whole bytes of the 1-bit framebuffer)
+    for row, (y0, y1) in enumerate(tile_edges(height, rows, 1)):
+        for col, (x0, x1) in enumerate(tile_edges(width, cols, 8)):
+            data = encode_png(image.crop((x0, y0, x1, y1)))
+            file_name = "r%d_c%d.png" % (row, col)
+            if write_if_changed(os.path.join(tile_dir, file_name), data):
+                written += 1
+            crc = zlib.crc32(data) & 0xFFFFFFFF
+            lines.append("tile %d %d %d %d %08x %s/%s" % (x0, y0, x1 - x0, y1 - y0, crc, tile_dir_name, file_name))
+
+    manifest = ("\n".join(lines) + "\n").encode("ascii")
+    manifest_path = os.path.join(args.output_dir, name + ".tiles")
+    changed = write_if_changed(manifest_path, manifest)
+    write_if_changed(manifest_path + ".crc32", ("%08x\n" % (zlib.crc32(manifest) & 0xFFFFFFFF)).encode("ascii"))
+
+    print("%s: %dx%d, %d tiles, %d tile file(s) updated, manifest %s"
+          % (manifest_path, width, height, len(lines) - 2, written, "updated" if changed else "unchanged"))
+
+
+if __name__ == "__main__":
+    main()
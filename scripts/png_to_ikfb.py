@@ -0,0 +1,128 @@
+#!/usr/bin/env python3
+"""
+Convert a dashboard image to IKFB, the device's pre-quantized native format.
+
+IKFB pixels are already in the panel's levels, so the device only unpacks
+bits instead of decoding PNG/JPEG and dithering (see "Native IKFB Images" in
+docs/user/USING.md and common/src/ikfb_decoder.h for the layout):
+
+    python3 scripts/png_to_ikfb.py dashboard.png /var/www/dash/dashboard.ikfb
+    python3 scripts/png_to_ikfb.py dashboard.png dash.ikfb --format 1bit
+    python3 scripts/png_to_ikfb.py weather.png weather.ikfb --format tricolor
+
+Formats: 3bit (Inkplate 10 / 5 V2 / 6 Flick, 8 gray levels), 1bit (black and
+white - boards with partial refresh enabled) and tricolor (Inkplate 2 black,
+white and red). The image must already have the screen's size for the
+configured rotation. The output is replaced atomically.
+
+Requires Pillow (pip install pillow).
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+try:
+    from PIL import Image
+except ImportError:
+    sys.exit("Pillow is required: pip install pillow")
+
+# PixelFormat in common/src/image_decoder.h -> (packed bits per pixel, palette)
+FORMATS = {
+    "1bit": (1, 1, [(0, 0, 0), (255, 255, 255)]),
+    "tricolor": (2, 2, [(0, 0, 0), (255, 255, 255), (255, 0, 0)]),
+    "3bit": (3, 4, [(v * 255 // 7,) * 3 for v in range(8)]),
+}
+
+
+def packbits(data):
+    """PackBits: n < 128 copies n + 1 literal bytes, n > 128 repeats the next byte 257 - n times."""
+    out = bytearray()
+    i = 0
+    n = len(data)
+    while i < n:
+        run = 1
+        while i + run < n and run < 128 and data[i + run] == data[i]:
+            run += 1
+        if run >= 3:
+            out += bytes([257 - run, data[i]])
+            i += run
+            continue
+        start = i
+        i += 1
+        while i < n and i - start < 128 and not (i + 2 < n and data[i] == data[i + 1] == data[i + 2]):
+            i += 1
+        out.append(i - start - 1)
+        out += data[start:i]
+    return bytes(out)
+
+
+def pack_row(levels, depth):
+    out = bytearray()
+    acc = 0
+    nbits = 0
+    for v in levels:
+        acc = (acc << depth) | v
+        nbits += depth
+        if nbits == 8:
+            out.append(acc)
+            acc = 0
+            nbits = 0
+    if nbits:
+        out.append(acc << (8 - nbits))
+    return out
+
+
+def quantize(image, palette, dither):
+    """Map every pixel to a palette index, which is the panel level."""
+    palette_image = Image.new("P", (1, 1))
+    flat = [c for color in palette for c in color]
+    # Pad with copies of black; Pillow may return a padding index for black pixels
+    palette_image.putpalette(flat + flat[:3] * (256 - len(palette)))
+    method = Image.Dither.FLOYDSTEINBERG if dither else Image.Dither.NONE
+    return image.convert("RGB").quantize(palette=palette_image, dither=method)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert an image to the Inkplate IKFB format")
+    parser.add_argument("image", help="Source image (any format Pillow reads), at the screen's size")
+    parser.add_argument("output", help="Output .ikfb file")
+    parser.add_argument("--format", choices=sorted(FORMATS), default="3bit",
+                        help="Panel pixel format (default 3bit)")
+    parser.add_argument("--no-dither", action="store_true",
+                        help="Nearest level instead of Floyd-Steinberg (smaller files for flat UIs)")
+    parser.add_argument("--no-rle", action="store_true", help="Store rows uncompressed")
+    parser.add_argument("--rotation", type=int, choices=range(4), default=0,
+                        help="Screen rotation the image was rendered for (default 0)")
+    args = parser.parse_args()
+
+    pixel_format, depth, palette = FORMATS[args.format]
+    image = Image.open(args.image)
+    width, height = image.size
+    if width > 0xFFFF or height > 0xFFFF:
+        sys.exit("Image too large")
+
+    indexed = quantize(image, palette, not args.no_dither)
+    # Map padding indices back to level 0
+    levels = indexed.tobytes().translate(bytes(i if i < len(palette) else 0 for i in range(256)))
+    packed = bytearray()
+    for y in range(height):
+        packed += pack_row(levels[y * width:(y + 1) * width], depth)
+
+    rle = not args.no_rle
+    payload = packbits(bytes(packed)) if rle else bytes(packed)
+    header = b"IKFB" + struct.pack("<BBBBHHI", 1, pixel_format, 1 if rle else 0, args.rotation, width, height, 0)
+
+    tmp = args.output + ".tmp"
+    with open(tmp, "wb") as f:
+        f.write(header + payload)
+    os.replace(tmp, args.output)
+
+    print("%s: %dx%d %s, %d bytes (%d packed%s)"
+          % (args.output, width, height, args.format, len(header) + len(payload), len(packed),
+             ", RLE" if rle else ""))
+
+
+if __name__ == "__main__":
+    main()
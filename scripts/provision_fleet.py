@@ -0,0 +1,166 @@
+#!/usr/bin/env python3
+"""
+Push one configuration to many dashboards through the portal's JSON API.
+
+Every device in config mode (or in WiFi setup, reached over its access
+point) serves GET/PUT /api/config and GET /api/status. This script sends the
+same document to a list of devices in parallel:
+
+    python3 scripts/provision_fleet.py config.json hosts.txt
+    python3 scripts/provision_fleet.py config.json hosts.txt --set timezone_offset=1
+    python3 scripts/provision_fleet.py --status hosts.txt
+
+config.json holds the settings to change, e.g. a document saved with
+curl http://kitchen.local/api/config. Keys left out keep the value stored on
+the device; "images" and "update_hours" replace the whole list. Passwords are
+never returned by GET - add "wifi_password" / "mqtt_password" to set them.
+
+hosts.txt has one device per line (IP address or mDNS name), optionally
+followed by key=value settings for that device only:
+
+    # host              per-device settings
+    192.168.1.41        friendly_name=kitchen
+    hallway.local       friendly_name=hallway screen_rotation=1
+
+Values are read as JSON when they parse (1, true, "text", [8,9]) and as a
+string otherwise.
+
+Over the setup access point any document is accepted. In config mode the
+device only takes a PUT with the API token it was given during setup: add
+"api_token" (16-64 characters) to the document sent over the access point,
+then pass the same token with --token, or in INKPLATE_API_TOKEN, for later
+changes over the network. A device restarts with the new configuration after it
+answers; the script exits non-zero if any device rejected it or could not be
+reached.
+"""
+
+import argparse
+import json
+import os
+import sys
+import urllib.error
+import urllib.request
+from concurrent.futures import ThreadPoolExecutor
+
+
+def parse_value(text):
+    try:
+        return json.loads(text)
+    except ValueError:
+        return text
+
+
+def parse_setting(text):
+    key, sep, value = text.partition("=")
+    if not sep or not key:
+        raise ValueError("expected key=value, got %r" % text)
+    return key, parse_value(value)
+
+
+def read_hosts(path):
+    hosts = []
+    with open(path, encoding="utf-8") as f:
+        for number, line in enumerate(f, 1):
+            fields = line.split("#", 1)[0].split()
+            if not fields:
+                continue
+            try:
+                overrides = dict(parse_setting(field) for field in fields[1:])
+            except ValueError as e:
+                sys.exit("%s:%d: %s" % (path, number, e))
+            hosts.append((fields[0], overrides))
+    return hosts
+
+
+def base_url(host):
+    return host.rstrip("/") if "://" in host else "http://" + host
+
+
+def request(host, method, path, document, timeout, token=None):
+    data = json.dumps(document).encode("utf-8") if document is not None else None
+    req = urllib.request.Request(base_url(host) + path, data=data, method=method)
+    if data is not None:
+        req.add_header("Content-Type", "application/json")
+    if token:
+        req.add_header("Authorization", "Bearer " + token)
+    try:
+        with urllib.request.urlopen(req, timeout=timeout) as response:
+            return True, json.loads(response.read().decode("utf-8"))
+    except urllib.error.HTTPError as e:
+        # The portal answers {"error": "..."} for rejected documents
+        try:
+            return False, "HTTP %d: %s" % (e.code, json.loads(e.read().decode("utf-8"))["error"])
+        except (ValueError, KeyError):
+            return False, "HTTP %d" % e.code
+    except (urllib.error.URLError, OSError) as e:
+        return False, str(getattr(e, "reason", e))
+    except ValueError:
+        return False, "invalid JSON response"
+
+
+def push(host, document, timeout, token):
+    ok, result = request(host, "PUT", "/api/config", document, timeout, token)
+    return ok, "saved, restarting" if ok else result
+
+
+def status(host, timeout):
+    ok, result = request(host, "GET", "/api/status", None, timeout)
+    if not ok:
+        return False, result
+    return True, "%s %s, %s mode, %s, %s, %s" % (
+        result.get("board", "?"), result.get("firmware_version", "?"), result.get("mode", "?"),
+        result.get("device_id", "?"), "configured" if result.get("configured") else "not configured",
+        "API token set" if result.get("api_token_set") else "no API token")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Configure Inkplate dashboards through /api/config")
+    parser.add_argument("config", nargs="?", help="JSON document with the settings to apply")
+    parser.add_argument("hosts", help="File with one host per line, optionally followed by key=value settings")
+    parser.add_argument("--set", action="append", default=[], metavar="KEY=VALUE",
+                        help="Setting applied to every device (repeatable)")
+    parser.add_argument("--status", action="store_true", help="Only query GET /api/status")
+    parser.add_argument("--jobs", type=int, default=8, help="Devices contacted at once (default 8)")
+    parser.add_argument("--timeout", type=float, default=15, help="Seconds per request (default 15)")
+    parser.add_argument("--token", default=os.environ.get("INKPLATE_API_TOKEN"),
+                        help="API token for devices in config mode (default: $INKPLATE_API_TOKEN)")
+    args = parser.parse_args()
+
+    hosts = read_hosts(args.hosts)
+    if not hosts:
+        sys.exit("%s: no hosts" % args.hosts)
+
+    if args.status:
+        jobs = [(host, lambda host=host: status(host, args.timeout)) for host, _ in hosts]
+    else:
+        if args.config is None:
+            sys.exit("A configuration document is required (or use --status)")
+        with open(args.config, encoding="utf-8") as f:
+            try:
+                document = json.load(f)
+            except ValueError as e:
+                sys.exit("%s: %s" % (args.config, e))
+        if not isinstance(document, dict):
+            sys.exit("%s: expected a JSON object" % args.config)
+        try:
+            document.update(parse_setting(text) for text in args.set)
+        except ValueError as e:
+            sys.exit("--set: %s" % e)
+        jobs = [(host, lambda host=host, overrides=overrides:
+                 push(host, dict(document, **overrides), args.timeout, args.token))
+                for host, overrides in hosts]
+
+    failed = 0
+    with ThreadPoolExecutor(max_workers=max(1, args.jobs)) as pool:
+        futures = [(host, pool.submit(job)) for host, job in jobs]
+        for host, future in futures:
+            ok, message = future.result()
+            print("%-24s %s %s" % (host, "OK  " if ok else "FAIL", message))
+            failed += 0 if ok else 1
+
+    print("%d of %d device(s) %s" % (len(jobs) - failed, len(jobs), "answered" if args.status else "configured"))
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,91 @@
+/**
+ * Configuration load benchmark (host)
+ *
+ * Loads a typical two-image configuration the three ways the firmware can:
+ * the key-per-field layout of earlier firmware (one NVS lookup per setting,
+ * as migrateLegacyConfig reads it), the single PREF_CONFIG_BLOB entry, and
+ * the RTC memory copy used on timer wakes. Reports NVS lookups per load,
+ * stored bytes and the time per load; the map-backed store has no flash
+ * latency, so on the device the lookup count is what dominates.
+ *
+ * Not part of ctest - run manually:
+ *   ./test/build/config_blob_bench [iterations]
+ */
+
+#include <config_blob.h>
+#include <map_preferences.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+static void storeLegacyConfig(MapPreferences& prefs) {
+    prefs.putUChar(PREF_CONFIG_VERSION, 2);
+    prefs.putBool(PREF_CONFIGURED, true);
+    prefs.putString(PREF_WIFI_SSID, "HomeNet");
+    prefs.putString(PREF_WIFI_PASS, "correct-horse-battery");
+    prefs.putString(PREF_FRIENDLY_NAME, "kitchen");
+    prefs.putString(PREF_MQTT_BROKER, "mqtt://192.168.1.10:1883");
+    prefs.putString(PREF_MQTT_USER, "homeassistant");
+    prefs.putString(PREF_MQTT_PASS, "mqtt-password");
+    prefs.putBool(PREF_USE_CRC32, true);
+    prefs.putUChar(PREF_CHANGE_DETECTION, CHANGE_DETECTION_HTTP);
+    prefs.putInt(PREF_TIMEZONE_OFFSET, 1);
+    prefs.putBool(PREF_OVERLAY_ENABLED, true);
+    prefs.putUChar(PREF_IMAGE_COUNT, 2);
+    prefs.putString("img_url_0", "https://ha.example.com/local/dashboard.png");
+    prefs.putInt("img_int_0", 15);
+    prefs.putString("img_url_1", "https://ha.example.com/local/calendar.png");
+    prefs.putInt("img_int_1", 60);
+}
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 100000;
+    if (iterations <= 0) {
+        iterations = 100000;
+    }
+
+    MapPreferences legacy;
+    storeLegacyConfig(legacy);
+    size_t legacyKeys = legacy.keyCount();
+
+    MapPreferences stored;
+    ConfigBlob blob;
+    migrateLegacyConfig(legacy, blob);
+    saveConfigBlob(stored, blob);
+    ConfigCache cache;
+    updateConfigCache(cache, blob);
+
+    // Key per field
+    legacy.lookups = 0;
+    size_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        sink += migrateLegacyConfig(legacy, blob) ? blob.size : 0;
+    }
+    double legacyNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+    double legacyLookups = (double)legacy.lookups / iterations;
+
+    // Single blob from NVS
+    stored.lookups = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        sink += loadConfigBlob(stored, blob) == CONFIG_LOAD_BLOB ? blob.size : 0;
+    }
+    double blobNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+    double blobLookups = (double)stored.lookups / iterations;
+
+    // RTC copy (timer wake)
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        sink += restoreConfigCache(cache, blob) ? blob.size : 0;
+    }
+    double rtcNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+    printf("Configuration load, %d iterations\n\n", iterations);
+    printf("%-16s %12s %10s %12s\n", "source", "NVS lookups", "entries", "load ns/op");
+    printf("%-16s %12.0f %10zu %12.0f\n", "key per field", legacyLookups, legacyKeys, legacyNs);
+    printf("%-16s %12.0f %10d %12.0f\n", "config blob", blobLookups, 1, blobNs);
+    printf("%-16s %12d %10s %12.0f\n", "RTC copy", 0, "-", rtcNs);
+    printf("\nBlob: %u bytes stored (RTC copy holds up to %d)\n", (unsigned)blob.size, CONFIG_CACHE_BYTES);
+    return sink == 0 ? 1 : 0;
+}
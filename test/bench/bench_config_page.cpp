@@ -0,0 +1,856 @@
+/**
+ * Configuration page benchmark (host)
+ *
+ * Serves the CONFIG_MODE page of a typical two-image configuration the two
+ * ways the firmware has: the earlier generator, which built each section in
+ * a reserved 4 KB String and sent it as one chunk, and renderConfigPage(),
+ * which streams the config_portal_html.h templates through the 1 KB
+ * CONFIG_PAGE_BUFFER_SIZE buffer. Reports peak heap in use while the page is
+ * generated, heap allocations, chunks sent and the time until the last byte
+ * reaches the sink (the WebServer's sendContent on the device).
+ *
+ * The earlier generator is kept below verbatim apart from its inputs (read
+ * from ConfigPageContext); Arduino String is modeled with std::string, like
+ * bench_telemetry_payload does.
+ *
+ * Not part of ctest - run manually:
+ *   ./test/build/config_page_bench [iterations]
+ */
+
+#include <config_page.h>
+#include <config_portal_html.h>
+#include <config_portal_assets.h>
+#include <prefetch_cache.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+
+// ============================================================================
+// Heap accounting
+// ============================================================================
+
+static size_t g_heapInUse = 0;
+static size_t g_heapPeak = 0;
+static size_t g_heapAllocations = 0;
+
+void* operator new(size_t size) {
+    // Size is kept in front of the block so delete can account for it
+    size_t* block = static_cast<size_t*>(malloc(size + sizeof(size_t)));
+    if (block == nullptr) {
+        throw std::bad_alloc();
+    }
+    *block = size;
+    g_heapInUse += size;
+    g_heapAllocations++;
+    if (g_heapInUse > g_heapPeak) {
+        g_heapPeak = g_heapInUse;
+    }
+    return block + 1;
+}
+
+void operator delete(void* memory) noexcept {
+    if (memory != nullptr) {
+        size_t* block = static_cast<size_t*>(memory) - 1;
+        g_heapInUse -= *block;
+        free(block);
+    }
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    operator delete(memory);
+}
+
+static void resetHeapPeak() {
+    g_heapPeak = g_heapInUse;
+    g_heapAllocations = 0;
+}
+
+// ============================================================================
+// Earlier generator
+// ============================================================================
+
+// The parts of Arduino String the generator uses
+class LegacyString : public std::string {
+public:
+    LegacyString() {}
+    LegacyString(const char* text) : std::string(text) {}
+    LegacyString(const std::string& text) : std::string(text) {}
+    LegacyString(int value) : std::string(std::to_string(value)) {}
+    LegacyString(unsigned int value) : std::string(std::to_string(value)) {}
+    LegacyString(float value, int decimals) {
+        char text[32];
+        snprintf(text, sizeof(text), "%.*f", decimals, (double)value);
+        assign(text);
+    }
+
+    void replace(const char* find, const std::string& with) {
+        size_t length = strlen(find);
+        for (size_t pos = this->find(find); pos != npos; pos = this->find(find, pos + with.size())) {
+            std::string::replace(pos, length, with);
+        }
+    }
+};
+
+// Stands in for WebServer::sendContent
+struct LegacySink {
+    size_t bytes;
+    size_t chunks;
+
+    void send(const std::string& chunk) {
+        bytes += chunk.size();
+        chunks++;
+    }
+};
+
+static LegacyString legacyMeasuredEnergyHTML(const ConfigPageContext& page, const DashboardConfig& config, bool hasConfig) {
+    if (page.energyStats == nullptr || page.energyStats->cycles == 0) {
+        return "";  // No wakes measured since the last cold boot
+    }
+    
+    PowerProfile profile = page.powerProfile;
+    LegacyString html = "<div class='battery-estimator' id='measured-energy'";
+    html += " data-cycle-mah='" + LegacyString(page.energyStats->avgCycleMah, 4) + "'";
+    html += " data-awake-sec='" + LegacyString(page.energyStats->avgAwakeSeconds, 2) + "'";
+    html += " data-sleep-ma='" + LegacyString(profile.sleepUa / 1000.0f, 4) + "'>";
+    html += "<div class='battery-estimator-header'><span style='font-size: 24px;'>📈</span><h3>Measured on This Device</h3></div>";
+    html += "<div class='battery-details'>";
+    html += "<div class='battery-detail-item'><span class='battery-detail-label'>Charge Per Wake</span>";
+    html += "<span class='battery-detail-value'>" + LegacyString(page.energyStats->avgCycleMah, 3) + " mAh</span></div>";
+    html += "<div class='battery-detail-item'><span class='battery-detail-label'>Awake Per Wake</span>";
+    html += "<span class='battery-detail-value'>" + LegacyString(page.energyStats->avgAwakeSeconds, 1) + " s</span></div>";
+    html += "<div class='battery-detail-item'><span class='battery-detail-label'>Wakes Averaged</span>";
+    html += "<span class='battery-detail-value'>" + LegacyString(page.energyStats->cycles) + "</span></div>";
+    if (hasConfig) {
+        float wakesPerDay = calculateWakesPerDay(config.imageIntervals, config.imageStay, config.imageCount, config.updateHours);
+        BatteryProjection projection = projectBatteryLife(profile, page.energyStats->avgCycleMah, page.energyStats->avgAwakeSeconds,
+                                                          wakesPerDay, 100);
+        html += "<div class='battery-detail-item'><span class='battery-detail-label'>Saved Settings (" + LegacyString((int)profile.batteryMah) + " mAh)</span>";
+        html += "<span class='battery-detail-value'>" + LegacyString(projection.daysFullBattery, 0) + " days</span></div>";
+    }
+    html += "</div>";
+    html += "<div style='font-size: 12px; color: #666; margin-top: 10px;'>With the settings above and the selected battery: ";
+    html += "<strong id='measured-days'>-</strong></div>";
+    html += "<div style='font-size: 11px; color: #666; margin-top: 5px;'>Running average of the charge per wake (image updates and unchanged checks) "
+            "from this board's typical currents and the measured phase times since the last power-on.</div>";
+    html += "</div>";
+    return html;
+}
+
+static void generateLegacyPage(const ConfigPageContext& page, LegacySink& sink) {
+    // Load current configuration if available
+    bool hasConfig = page.hasConfig;
+    
+    // Also check for partial config (WiFi but no Image URL) - for Step 2
+    // (the stored WiFi credentials and friendly name from Step 1 are in currentConfig)
+    bool hasPartialConfig = page.hasPartialConfig;
+    const DashboardConfig& currentConfig = *page.config;
+    
+    // Use chunked sending to reduce peak memory from 36KB to ~4KB
+    LegacyString chunk;
+    chunk.reserve(4096);  // 4KB chunks
+    
+    chunk = CONFIG_PORTAL_PAGE_HEADER_START;
+    chunk += "<title>Inkplate Dashboard Setup</title>";
+    chunk += "<link rel='stylesheet' href='" PORTAL_STYLES_CSS_URL "'>";
+    chunk += "</head><body>";
+    chunk += "<div class='container'>";
+    chunk += "<h1>📊 Inkplate Dashboard</h1>";
+    
+    // Different subtitle based on mode
+    if (!page.configMode) {
+        chunk += "<p class='subtitle'>Step 1: Connect to WiFi</p>";
+    } else if (hasConfig) {
+        chunk += "<p class='subtitle'>Update your dashboard configuration</p>";
+    } else {
+        chunk += "<p class='subtitle'>Step 2: Configure your dashboard</p>";
+    }
+    
+    chunk += "<div class='device-info'>";
+    chunk += "<strong>Device:</strong> " + LegacyString(page.deviceName) + "<br>";
+    
+    // Show appropriate IP address and mDNS hostname
+    if (page.connected) {
+        LegacyString mdnsHostname = LegacyString(page.hostname);
+        chunk += "<strong>IP:</strong> " + LegacyString(page.ipAddress) + "<br>";
+        
+        // Show mDNS hostname if available
+        if (mdnsHostname.length() > 0) {
+            chunk += "<strong>Hostname:</strong> <a href='http://" + mdnsHostname + "' target='_blank'>" + mdnsHostname + "</a><br>";
+        }
+        
+        // Show WiFi optimization info
+        if (page.channelLocked) {
+            uint8_t channel = page.channel;
+            uint8_t bssid[6];
+            memcpy(bssid, page.bssid, sizeof(bssid));
+            char bssidStr[18];
+            snprintf(bssidStr, sizeof(bssidStr), "%02X:%02X:%02X:%02X:%02X:%02X",
+                    bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5]);
+            chunk += "<strong>WiFi Optimization:</strong> Active ✓<br>";
+            chunk += "<small>Channel " + LegacyString(channel) + ", BSSID " + LegacyString(bssidStr) + "</small>";
+        } else {
+            chunk += "<strong>WiFi Optimization:</strong> Will activate on next power cycle";
+        }
+    } else {
+        LegacyString mdnsHostname = LegacyString(page.hostname);
+        chunk += "<strong>IP:</strong> " + LegacyString(page.ipAddress) + "<br>";
+        
+        // Show mDNS hostname if available
+        if (mdnsHostname.length() > 0) {
+            chunk += "<strong>Hostname:</strong> <a href='http://" + mdnsHostname + "' target='_blank'>" + mdnsHostname + "</a>";
+        }
+    }
+    chunk += "</div>";
+    
+    chunk += "<form action='/submit' method='POST'>";
+    sink.send(chunk);  // Send header chunk
+    
+    // WiFi Network Section
+    chunk = "";  // Clear for next section
+    chunk += SECTION_START("📶", "WiFi Network");
+    
+    // WiFi SSID - always shown
+    chunk += "<div class='form-group'>";
+    chunk += "<label for='ssid'>WiFi Network Name (SSID) *</label>";
+    if (hasConfig || hasPartialConfig) {
+        chunk += "<input type='text' id='ssid' name='ssid' required placeholder='Enter your WiFi network name' value='";
+        chunk += currentConfig.wifiSSID.c_str();
+        chunk += "'>";
+    } else {
+        chunk += "<input type='text' id='ssid' name='ssid' required placeholder='Enter your WiFi network name'>";
+    }
+    chunk += "</div>";
+    
+    // WiFi Password - always shown
+    chunk += "<div class='form-group'>";
+    chunk += "<label for='password'>WiFi Password</label>";
+    if ((hasConfig || hasPartialConfig) && currentConfig.wifiPassword.length() > 0) {
+        chunk += "<input type='password' id='password' name='password' placeholder='Enter WiFi password (leave empty if none)' value='";
+        chunk += currentConfig.wifiPassword.c_str();
+        chunk += "'>";
+        chunk += "<div class='help-text'>Password is set. Leave empty to keep current password.</div>";
+    } else {
+        chunk += "<input type='password' id='password' name='password' placeholder='Enter WiFi password (leave empty if none)'>";
+    }
+    chunk += "</div>";
+    
+    // Friendly Name (Device Name) - optional, shown in both modes
+    chunk += "<div class='form-group'>";
+    chunk += "<label for='friendlyname'>Device Name (optional)</label>";
+    LegacyString currentFriendlyName = (hasConfig || hasPartialConfig) ? currentConfig.friendlyName.c_str() : "";
+    chunk += "<input type='text' id='friendlyname' name='friendlyname' placeholder='e.g., Living Room' value='" + currentFriendlyName + "' maxlength='24' oninput='sanitizeFriendlyNamePreview()'>";
+    chunk += "<div id='friendlyname-preview' style='font-size: 13px; margin-top: 5px; color: #666;'></div>";
+    chunk += "<div class='help-text'>";
+    if (!page.configMode) {
+        chunk += "Set a friendly name now to access Step 2 via <code>yourname.local</code> (instead of IP address). ";
+        chunk += "Rules: lowercase letters (a-z), digits (0-9), hyphens (-), max 24 characters. ";
+        chunk += "Leave empty to use MAC-based ID.";
+    } else {
+        chunk += "Optional user-friendly name for MQTT topics, Home Assistant, and network hostname (e.g., <code>kitchen.local</code>). ";
+        chunk += "Rules: lowercase letters (a-z), digits (0-9), hyphens (-), max 24 characters. ";
+        chunk += "No leading/trailing hyphens. Leave empty to use MAC-based ID. ";
+        chunk += "<strong>⚠️ Changing this creates a new device in Home Assistant</strong> (old entities will stop updating).";
+    }
+    chunk += "</div>";
+    chunk += "</div>";
+    
+    // IP config only shown in CONFIG_MODE
+    if (page.configMode) {
+        // Network Settings (Static IP)
+        chunk += "<div class='form-group' style='margin-top: 20px; padding-top: 20px; border-top: 1px solid #e0e0e0;'>";
+        chunk += "<label style='font-weight: bold; display: block; margin-bottom: 10px;'>🌐 Network Configuration</label>";
+        chunk += "<div class='help-text' style='margin-bottom: 15px;'>Choose between automatic IP assignment (DHCP) or manual static IP configuration. Static IP can reduce wake time by 0.5-2 seconds per cycle.</div>";
+        
+        bool useStaticIP = (hasConfig || hasPartialConfig) && currentConfig.useStaticIP;
+    
+    chunk += "<div style='margin-bottom: 15px;'>";
+    chunk += "<label style='display: flex; align-items: center; gap: 8px; margin-bottom: 8px;'>";
+    chunk += "<input type='radio' name='ip_mode' value='dhcp' id='ip_mode_dhcp'" + LegacyString(!useStaticIP ? " checked" : "") + " onchange='toggleStaticIPFields()'>";
+    chunk += "<span>DHCP (Automatic) - Default</span>";
+    chunk += "</label>";
+    chunk += "<label style='display: flex; align-items: center; gap: 8px;'>";
+    chunk += "<input type='radio' name='ip_mode' value='static' id='ip_mode_static'" + LegacyString(useStaticIP ? " checked" : "") + " onchange='toggleStaticIPFields()'>";
+    chunk += "<span>Static IP (Manual)</span>";
+    chunk += "</label>";
+    chunk += "</div>";
+    
+    // Static IP fields container
+    LegacyString staticDisplay = useStaticIP ? "" : " style='display:none;'";
+    chunk += "<div id='static_ip_fields'" + staticDisplay + ">";
+    
+    // Static IP Address
+    chunk += "<div class='form-group'>";
+    chunk += "<label for='static_ip'>IP Address *</label>";
+    LegacyString staticIPValue = (hasConfig || hasPartialConfig) ? currentConfig.staticIP.c_str() : "";
+    chunk += "<input type='text' id='static_ip' name='static_ip' placeholder='e.g., 192.168.1.100' value='" + staticIPValue + "' pattern='^(\\d{1,3}\\.){3}\\d{1,3}$'>";
+    chunk += "<div class='help-text'>Enter the static IP address for this device</div>";
+    chunk += "</div>";
+    
+    // Gateway
+    chunk += "<div class='form-group'>";
+    chunk += "<label for='gateway'>Gateway *</label>";
+    LegacyString gatewayValue = (hasConfig || hasPartialConfig) ? currentConfig.gateway.c_str() : "";
+    chunk += "<input type='text' id='gateway' name='gateway' placeholder='e.g., 192.168.1.1' value='" + gatewayValue + "' pattern='^(\\d{1,3}\\.){3}\\d{1,3}$'>";
+    chunk += "<div class='help-text'>Usually your router's IP address</div>";
+    chunk += "</div>";
+    
+    // Subnet Mask
+    chunk += "<div class='form-group'>";
+    chunk += "<label for='subnet'>Subnet Mask *</label>";
+    LegacyString subnetValue = (hasConfig || hasPartialConfig) && !currentConfig.subnet.isEmpty() ? currentConfig.subnet.c_str() : "255.255.255.0";
+    chunk += "<input type='text' id='subnet' name='subnet' placeholder='e.g., 255.255.255.0' value='" + subnetValue + "' pattern='^(\\d{1,3}\\.){3}\\d{1,3}$'>";
+    chunk += "<div class='help-text'>Typically 255.255.255.0 for home networks</div>";
+    chunk += "</div>";
+    
+    // Primary DNS
+    chunk += "<div class='form-group'>";
+    chunk += "<label for='dns1'>Primary DNS *</label>";
+    LegacyString dns1Value = (hasConfig || hasPartialConfig) && !currentConfig.primaryDNS.isEmpty() ? currentConfig.primaryDNS.c_str() : "8.8.8.8";
+    chunk += "<input type='text' id='dns1' name='dns1' placeholder='e.g., 8.8.8.8' value='" + dns1Value + "' pattern='^(\\d{1,3}\\.){3}\\d{1,3}$'>";
+    chunk += "<div class='help-text'>Google DNS (8.8.8.8) or Cloudflare (1.1.1.1)</div>";
+    chunk += "</div>";
+    
+    // Secondary DNS (optional)
+    chunk += "<div class='form-group'>";
+    chunk += "<label for='dns2'>Secondary DNS (Optional)</label>";
+    LegacyString dns2Value = (hasConfig || hasPartialConfig) ? currentConfig.secondaryDNS.c_str() : "";
+    chunk += "<input type='text' id='dns2' name='dns2' placeholder='e.g., 8.8.4.4' value='" + dns2Value + "' pattern='^(\\d{1,3}\\.){3}\\d{1,3}$'>";
+    chunk += "<div class='help-text'>Backup DNS server (optional)</div>";
+    chunk += "</div>";
+    
+        chunk += "</div>"; // End static_ip_fields
+        chunk += "</div>"; // End form-group
+    } // End CONFIG_MODE check for friendly name and IP config
+    
+    chunk += SECTION_END();
+    sink.send(chunk);  // Send WiFi section
+    
+    // Dashboard Image Section - only shown in CONFIG_MODE
+    if (page.configMode) {
+        chunk = "";  // Clear for images section
+        chunk += SECTION_START("🖼️", "Dashboard Images");
+        chunk += "<div class='help-text' style='margin-bottom: 15px;'>Fill 1 image for single image mode, or 2+ for automatic carousel rotation. Supported formats: PNG, JPEG (baseline encoding only, not progressive) or pre-dithered IKFB. Image must match your screen resolution. URLs ending in .tiles are tile manifests (see documentation).</div>";
+        
+        // Get existing image configuration if available
+        uint8_t existingCount = hasConfig ? currentConfig.imageCount : 0;
+        
+        // Always show first image slot
+        for (uint8_t i = 0; i < 1; i++) {
+            LegacyString imageNum = LegacyString(i + 1);
+            bool hasExisting = (i < existingCount);
+            LegacyString existingUrl = hasExisting ? currentConfig.imageUrls[i].c_str() : "";
+            int existingInterval = hasExisting ? currentConfig.imageIntervals[i] : DEFAULT_INTERVAL_MINUTES;
+            bool existingStay = hasExisting ? currentConfig.imageStay[i] : false;
+            
+            chunk += "<div class='image-slot' id='slot_" + LegacyString(i) + "'>";
+            chunk += "<label>Image " + imageNum + " URL *</label>";
+            chunk += "<input type='text' name='img_url_" + LegacyString(i) + "' placeholder='https://example.com/image" + imageNum + ".png' value='" + existingUrl + "' required>";
+            chunk += "<label>Display for (minutes) *</label>";
+            chunk += "<input type='number' name='img_int_" + LegacyString(i) + "' min='0' placeholder='5' value='" + LegacyString(existingInterval) + "' required>";
+            chunk += "<div class='help-text'>Set to 0 for button-only mode (no automatic refresh - wake by button press only)</div>";
+            chunk += "<label style='display: flex; align-items: center; gap: 10px; margin-top: 10px;'>";
+            chunk += "<input type='checkbox' name='img_stay_" + LegacyString(i) + "'";
+            if (existingStay) chunk += " checked";
+            chunk += ">";
+            chunk += "Stay on this image (advance on button press)";
+            chunk += "</label>";
+            chunk += "</div>";
+        }
+        
+        // Add remaining slots (2-10) if they have data
+        for (uint8_t i = 1; i < MAX_IMAGE_SLOTS; i++) {
+            bool hasExisting = (i < existingCount);
+            LegacyString existingUrl = hasExisting ? currentConfig.imageUrls[i].c_str() : "";
+            int existingInterval = hasExisting ? currentConfig.imageIntervals[i] : DEFAULT_INTERVAL_MINUTES;
+            bool existingStay = hasExisting ? currentConfig.imageStay[i] : false;
+            LegacyString displayStyle = hasExisting ? "" : " style='display:none;'";
+            
+            chunk += "<div class='image-slot' id='slot_" + LegacyString(i) + "'" + displayStyle + ">";
+            chunk += "<div style='display: flex; justify-content: space-between; align-items: center;'>";
+            chunk += "<label>Image " + LegacyString(i + 1) + " URL</label>";
+            chunk += "<button type='button' class='btn-remove' id='remove_" + LegacyString(i) + "' onclick='removeLastImageSlot()'>❌ Remove</button>";
+            chunk += "</div>";
+            chunk += "<input type='text' name='img_url_" + LegacyString(i) + "' placeholder='https://example.com/image" + LegacyString(i + 1) + ".png' value='" + existingUrl + "'>";
+            chunk += "<label>Display for (minutes)</label>";
+            chunk += "<input type='number' name='img_int_" + LegacyString(i) + "' min='0' placeholder='5' value='" + LegacyString(existingInterval) + "'>";
+            chunk += "<div class='help-text'>Set to 0 for button-only mode (no automatic refresh - wake by button press only)</div>";
+            chunk += "<label style='display: flex; align-items: center; gap: 10px; margin-top: 10px;'>";
+            chunk += "<input type='checkbox' name='img_stay_" + LegacyString(i) + "'";
+            if (existingStay) chunk += " checked";
+            chunk += ">";
+            chunk += "Stay on this image (advance on button press)";
+            chunk += "</label>";
+            chunk += "</div>";
+        }
+        
+        // Add button to show more slots (hidden when all 10 are visible)
+        LegacyString visibleSlots = LegacyString(existingCount > 1 ? existingCount : 1);
+        LegacyString buttonDisplay = existingCount >= MAX_IMAGE_SLOTS ? " style='display:none;'" : "";
+        chunk += "<button type='button' id='addImageBtn' onclick='addImageSlot()'" + buttonDisplay + ">➕ Add Another Image (up to 10 total)</button>";
+        
+        // Carousel prefetch
+        chunk += "<div class='form-group'>";
+        chunk += "<label for='prefetch_count'>Prefetch Next Images (carousel)</label>";
+        uint8_t currentPrefetchCount = hasConfig ? currentConfig.prefetchCount : DEFAULT_PREFETCH_COUNT;
+        chunk += "<input type='number' id='prefetch_count' name='prefetch_count' min='0' max='" + LegacyString(PREFETCH_MAX_ENTRIES) + "' value='" + LegacyString(currentPrefetchCount) + "' placeholder='0'>";
+        chunk += "<div class='help-text'>Downloads this many of the following carousel images ahead into flash, so the next timer wakes show them without connecting to WiFi (0 = off, up to " + LegacyString(PREFETCH_MAX_ENTRIES) + "). Cached images are checked for changes on the next online wake and are not shown once they are more than " + LegacyString(PREFETCH_MAX_AGE_SECONDS / 3600) + " hours old. Best for short intervals with images that change rarely.</div>";
+        chunk += "</div>";
+        
+        // HTTPS certificate pinning
+        chunk += "<div class='form-group'>";
+        chunk += "<label for='tls_fp'>HTTPS Certificate Fingerprint (optional)</label>";
+        LegacyString currentFingerprint = hasConfig ? currentConfig.tlsFingerprint.c_str() : "";
+        chunk += "<input type='text' id='tls_fp' name='tls_fp' placeholder='AB:CD:EF:...' value='" + currentFingerprint + "'>";
+        chunk += "<div class='help-text'>SHA-256 fingerprint of your image server's certificate. When set, HTTPS images are only loaded from a server presenting exactly this certificate. Leave empty to accept any certificate. Update it when the server certificate is renewed.</div>";
+        chunk += "</div>";
+        
+        // Timezone Offset
+        chunk += "<div class='form-group'>";
+        chunk += "<label for='timezone'>Timezone Offset (UTC)</label>";
+        if (hasConfig) {
+            chunk += "<input type='number' id='timezone' name='timezone' min='-12' max='14' value='" + LegacyString(currentConfig.timezoneOffset) + "' placeholder='0'>";
+        } else {
+            chunk += "<input type='number' id='timezone' name='timezone' min='-12' max='14' value='0' placeholder='0'>";
+        }
+        chunk += "<div class='help-text'>Enter your timezone offset (range: -12 to +14). Keep in mind that Daylight Saving Time may apply in your region - you'll need to update this offset when DST changes.</div>";
+        chunk += "</div>";
+        
+        // Screen Rotation
+        chunk += "<div class='form-group'>";
+        chunk += "<label for='rotation'>Screen Rotation</label>";
+        chunk += "<select id='rotation' name='rotation'>";
+        uint8_t currentRotation = hasConfig ? currentConfig.screenRotation : 0;
+        chunk += "<option value='0'" + LegacyString(currentRotation == 0 ? " selected" : "") + ">0° (Landscape)</option>";
+        chunk += "<option value='1'" + LegacyString(currentRotation == 1 ? " selected" : "") + ">90° (Portrait)</option>";
+        chunk += "<option value='2'" + LegacyString(currentRotation == 2 ? " selected" : "") + ">180° (Inverted Landscape)</option>";
+        chunk += "<option value='3'" + LegacyString(currentRotation == 3 ? " selected" : "") + ">270° (Portrait Inverted)</option>";
+        chunk += "</select>";
+        chunk += "<div class='help-text'>Select the orientation of your display. Important: Your images must be oriented to match this setting (e.g., for 90° portrait, provide a portrait-oriented image).</div>";
+        chunk += "</div>";
+        
+        // Partial refresh (not available on Inkplate 2 - tri-color panel)
+        if (page.partialRefreshAvailable) {
+            chunk += "<div class='form-group checkbox-group'>";
+            chunk += "<label>";
+            bool partialRefresh = hasConfig ? currentConfig.partialRefresh : false;
+            chunk += "<input type='checkbox' name='partial_refresh' id='partial_refresh' ";
+            if (partialRefresh) chunk += "checked ";
+            chunk += ">";
+            chunk += " Partial refresh (black and white)";
+            chunk += "</label>";
+            chunk += "<div class='help-text'>Redraw only the parts of the screen that changed, without the full-screen flash. Images are shown in black and white (dithered) instead of grayscale. An unchanged image does not refresh the screen at all.</div>";
+            chunk += "</div>";
+        
+            chunk += "<div class='form-group'>";
+            chunk += "<label for='full_refresh_every'>Full Refresh Every (partial refreshes)</label>";
+            uint8_t currentFullRefreshEvery = hasConfig ? currentConfig.fullRefreshEvery : DEFAULT_FULL_REFRESH_EVERY;
+            chunk += "<input type='number' id='full_refresh_every' name='full_refresh_every' min='0' max='100' value='" + LegacyString(currentFullRefreshEvery) + "' placeholder='" + LegacyString(DEFAULT_FULL_REFRESH_EVERY) + "'>";
+            chunk += "<div class='help-text'>Partial refreshes leave faint ghosting; a full refresh after this many partial ones clears it (default " + LegacyString(DEFAULT_FULL_REFRESH_EVERY) + ", 0 = always full). Only used with partial refresh enabled.</div>";
+            chunk += "</div>";
+        }
+        
+        // Frontlight configuration (only for boards with HAS_FRONTLIGHT)
+        if (page.frontlightAvailable) {
+            chunk += "<div class='form-group'>";
+            chunk += "<label for='frontlight_duration'>Frontlight Duration (seconds)</label>";
+            uint8_t currentDuration = hasConfig ? currentConfig.frontlightDuration : 0;
+            chunk += "<input type='number' id='frontlight_duration' name='frontlight_duration' min='0' max='255' value='" + LegacyString(currentDuration) + "' placeholder='0'>";
+            chunk += "<div class='help-text'>How long to keep the frontlight on during manual button refresh (0 = disabled, default). When set to 0, frontlight is never activated and device goes to sleep immediately after refresh.</div>";
+            chunk += "</div>";
+        
+            chunk += "<div class='form-group'>";
+            chunk += "<label for='frontlight_brightness'>Frontlight Brightness (0-63)</label>";
+            uint8_t currentBrightness = hasConfig ? currentConfig.frontlightBrightness : 63;
+            chunk += "<input type='number' id='frontlight_brightness' name='frontlight_brightness' min='0' max='63' value='" + LegacyString(currentBrightness) + "' placeholder='63'>";
+            chunk += "<div class='help-text'>Brightness level when frontlight is active (0-63, where 63 is maximum brightness). Not used if duration is set to 0.</div>";
+            chunk += "</div>";
+        }
+        
+        chunk += SECTION_END();
+        sink.send(chunk);  // Send display settings section
+        
+        // Overlay Section
+        chunk = "";  // Clear for overlay section
+        chunk += SECTION_START("📊", "Status Overlay");
+        chunk += "<div class='help-text' style='margin-bottom: 15px;'>Display battery and update status directly on your dashboard images</div>";
+        
+        // Overlay Enable/Disable
+        chunk += "<div class='form-group checkbox-group'>";
+        chunk += "<label>";
+        bool overlayEnabled = hasConfig ? currentConfig.overlayEnabled : false;
+        chunk += "<input type='checkbox' name='overlay_enabled' id='overlay_enabled' ";
+        if (overlayEnabled) chunk += "checked ";
+        chunk += ">";
+        chunk += " Enable status overlay";
+        chunk += "</label>";
+        chunk += "<div class='help-text'>Show battery, time, and cycle information on top of dashboard images</div>";
+        chunk += "</div>";
+        
+        // Overlay Position
+        chunk += "<div class='form-group'>";
+        chunk += "<label for='overlay_position'>Overlay Position</label>";
+        uint8_t overlayPosition = hasConfig ? currentConfig.overlayPosition : OVERLAY_POS_TOP_RIGHT;
+        chunk += "<select id='overlay_position' name='overlay_position'>";
+        chunk += "<option value='0'"; if (overlayPosition == OVERLAY_POS_TOP_LEFT) chunk += " selected"; chunk += ">Top Left</option>";
+        chunk += "<option value='1'"; if (overlayPosition == OVERLAY_POS_TOP_RIGHT) chunk += " selected"; chunk += ">Top Right</option>";
+        chunk += "<option value='2'"; if (overlayPosition == OVERLAY_POS_BOTTOM_LEFT) chunk += " selected"; chunk += ">Bottom Left</option>";
+        chunk += "<option value='3'"; if (overlayPosition == OVERLAY_POS_BOTTOM_RIGHT) chunk += " selected"; chunk += ">Bottom Right</option>";
+        chunk += "</select>";
+        chunk += "</div>";
+        
+        // Overlay Size
+        chunk += "<div class='form-group'>";
+        chunk += "<label for='overlay_size'>Overlay Size</label>";
+        uint8_t overlaySize = hasConfig ? currentConfig.overlaySize : OVERLAY_SIZE_MEDIUM;
+        chunk += "<select id='overlay_size' name='overlay_size'>";
+        chunk += "<option value='0'"; if (overlaySize == OVERLAY_SIZE_SMALL) chunk += " selected"; chunk += ">Small</option>";
+        chunk += "<option value='1'"; if (overlaySize == OVERLAY_SIZE_MEDIUM) chunk += " selected"; chunk += ">Medium (Default)</option>";
+        chunk += "<option value='2'"; if (overlaySize == OVERLAY_SIZE_LARGE) chunk += " selected"; chunk += ">Large</option>";
+        chunk += "</select>";
+        chunk += "</div>";
+        
+        // Overlay Color
+        chunk += "<div class='form-group'>";
+        chunk += "<label for='overlay_color'>Text Color</label>";
+        uint8_t overlayColor = hasConfig ? currentConfig.overlayTextColor : OVERLAY_COLOR_BLACK;
+        chunk += "<select id='overlay_color' name='overlay_color'>";
+        chunk += "<option value='0'"; if (overlayColor == OVERLAY_COLOR_BLACK) chunk += " selected"; chunk += ">Black (Default)</option>";
+        chunk += "<option value='1'"; if (overlayColor == OVERLAY_COLOR_DARK_GRAY) chunk += " selected"; chunk += ">Dark Gray</option>";
+        chunk += "<option value='2'"; if (overlayColor == OVERLAY_COLOR_LIGHT_GRAY) chunk += " selected"; chunk += ">Light Gray</option>";
+        chunk += "<option value='3'"; if (overlayColor == OVERLAY_COLOR_WHITE) chunk += " selected"; chunk += ">White</option>";
+        chunk += "</select>";
+        chunk += "<div class='help-text'>Choose color for best contrast with your dashboard image background</div>";
+        chunk += "</div>";
+        
+        // Overlay Content Options
+        chunk += "<div class='help-text' style='margin: 15px 0 10px 0; font-weight: bold;'>Display Options:</div>";
+        
+        // Battery Icon
+        chunk += "<div class='form-group checkbox-group'>";
+        chunk += "<label>";
+        bool showBatteryIcon = hasConfig ? currentConfig.overlayShowBatteryIcon : true;
+        chunk += "<input type='checkbox' name='overlay_battery_icon' id='overlay_battery_icon' ";
+        if (showBatteryIcon) chunk += "checked ";
+        chunk += ">";
+        chunk += " Show battery icon";
+        chunk += "</label>";
+        chunk += "<div class='help-text'>Display battery icon filled to match current percentage</div>";
+        chunk += "</div>";
+        
+        // Battery Percentage
+        chunk += "<div class='form-group checkbox-group'>";
+        chunk += "<label>";
+        bool showBatteryPct = hasConfig ? currentConfig.overlayShowBatteryPercentage : true;
+        chunk += "<input type='checkbox' name='overlay_battery_pct' id='overlay_battery_pct' ";
+        if (showBatteryPct) chunk += "checked ";
+        chunk += ">";
+        chunk += " Show battery percentage";
+        chunk += "</label>";
+        chunk += "<div class='help-text'>Display battery percentage as text (e.g., \"85%\")</div>";
+        chunk += "</div>";
+        
+        // Update Time
+        chunk += "<div class='form-group checkbox-group'>";
+        chunk += "<label>";
+        bool showUpdateTime = hasConfig ? currentConfig.overlayShowUpdateTime : true;
+        chunk += "<input type='checkbox' name='overlay_update_time' id='overlay_update_time' ";
+        if (showUpdateTime) chunk += "checked ";
+        chunk += ">";
+        chunk += " Show last update time";
+        chunk += "</label>";
+        chunk += "<div class='help-text'>Display time of last image update (e.g., \"11:25\")</div>";
+        chunk += "</div>";
+        
+        // Cycle Time
+        chunk += "<div class='form-group checkbox-group'>";
+        chunk += "<label>";
+        bool showCycleTime = hasConfig ? currentConfig.overlayShowCycleTime : false;
+        chunk += "<input type='checkbox' name='overlay_cycle_time' id='overlay_cycle_time' ";
+        if (showCycleTime) chunk += "checked ";
+        chunk += ">";
+        chunk += " Show last cycle time";
+        chunk += "</label>";
+        chunk += "<div class='help-text'>Display loop duration in seconds (for debugging performance)</div>";
+        chunk += "</div>";
+        
+        chunk += SECTION_END();
+        sink.send(chunk);  // Send overlay section
+        
+        // MQTT Section
+        chunk = "";  // Clear for MQTT section
+        chunk += SECTION_START("📡", "MQTT / Home Assistant");
+        chunk += "<div class='help-text' style='margin-bottom: 15px;'>Configure MQTT to send battery voltage to Home Assistant (optional)</div>";
+        
+        // MQTT Broker URL
+        chunk += "<div class='form-group'>";
+        chunk += "<label for='mqttbroker'>MQTT Broker URL</label>";
+        if (hasConfig) {
+            chunk += "<input type='text' id='mqttbroker' name='mqttbroker' placeholder='mqtt://broker.example.com:1883' value='";
+            chunk += currentConfig.mqttBroker.c_str();
+            chunk += "'>";
+        } else {
+            chunk += "<input type='text' id='mqttbroker' name='mqttbroker' placeholder='mqtt://broker.example.com:1883'>";
+        }
+        chunk += "<div class='help-text'>Leave empty to disable MQTT reporting</div>";
+        chunk += "</div>";
+        
+        // MQTT Username
+        chunk += "<div class='form-group'>";
+        chunk += "<label for='mqttuser'>MQTT Username (optional)</label>";
+        if (hasConfig) {
+            chunk += "<input type='text' id='mqttuser' name='mqttuser' placeholder='username' value='";
+            chunk += currentConfig.mqttUsername.c_str();
+            chunk += "'>";
+        } else {
+            chunk += "<input type='text' id='mqttuser' name='mqttuser' placeholder='username'>";
+        }
+        chunk += "</div>";
+        
+        // MQTT Password
+        chunk += "<div class='form-group'>";
+        chunk += "<label for='mqttpass'>MQTT Password (optional)</label>";
+        if (hasConfig && currentConfig.mqttPassword.length() > 0) {
+            chunk += "<input type='password' id='mqttpass' name='mqttpass' placeholder='password' value='";
+            chunk += currentConfig.mqttPassword.c_str();
+            chunk += "'>";
+            chunk += "<div class='help-text'>Password is set. Leave empty to keep current password.</div>";
+        } else {
+            chunk += "<input type='password' id='mqttpass' name='mqttpass' placeholder='password'>";
+        }
+        chunk += "</div>";
+        
+        // Batched state message
+        chunk += "<div class='form-group checkbox-group'>";
+        chunk += "<label>";
+        bool mqttBatched = hasConfig ? currentConfig.mqttBatchedState : false;
+        chunk += "<input type='checkbox' name='mqttbatched' id='mqttbatched' ";
+        if (mqttBatched) chunk += "checked ";
+        chunk += ">";
+        chunk += " Send all sensors in one message";
+        chunk += "</label>";
+        chunk += "<div class='help-text'>Publishes every sensor value as one JSON message on a single state topic instead of one message per sensor, which shortens the time the device stays awake. Home Assistant picks the values out automatically. Existing automations that read the per-sensor topics directly need to use the new topic.</div>";
+        chunk += "</div>";
+        chunk += SECTION_END();
+        sink.send(chunk);  // Send MQTT section
+        
+        // Scheduling Section
+        chunk = "";  // Clear for scheduling section
+        chunk += SECTION_START("🕐", "Scheduling");
+        
+        // CRC32 change detection toggle
+        chunk += "<div class='form-group'>";
+        chunk += "<label for='crc32check' style='display: flex; align-items: center; gap: 10px;'>";
+        chunk += "<input type='checkbox' id='crc32check' name='crc32check'";
+        if (hasConfig && currentConfig.useCRC32Check) {
+            chunk += " checked";
+        }
+        chunk += "> Enable change detection";
+        chunk += "</label>";
+        chunk += "<div class='help-text'>Skips image download & refresh when unchanged. Works in single image mode and carousel mode (for images with stay:true flag). Significantly extends battery life.</div>";
+        chunk += "</div>";
+        
+        // Change detection method
+        chunk += "<div class='form-group'>";
+        chunk += "<label for='change_detection'>Change Detection Method</label>";
+        chunk += "<select id='change_detection' name='change_detection'>";
+        uint8_t currentDetection = hasConfig ? currentConfig.changeDetection : CHANGE_DETECTION_CRC32;
+        chunk += "<option value='crc32'" + LegacyString(currentDetection == CHANGE_DETECTION_CRC32 ? " selected" : "") + ">CRC32 checksum file (image.png.crc32)</option>";
+        chunk += "<option value='http'" + LegacyString(currentDetection == CHANGE_DETECTION_HTTP ? " selected" : "") + ">HTTP ETag / Last-Modified (single request)</option>";
+        chunk += "</select>";
+        chunk += "<div class='help-text'>CRC32 requires a web server that generates .crc32 checksum files next to each image. HTTP validators work with any server that sends ETag or Last-Modified headers (most static file servers and CDNs) and save one request per wake.</div>";
+        chunk += "</div>";
+        
+        // Hourly Schedule - Update Hours
+        chunk += "<div class='form-group' style='margin-top: 20px;'>";
+        chunk += "<label style='font-size: 16px; margin-bottom: 5px;'>📅 Update Hours</label>";
+        chunk += "<div class='help-text' style='margin-bottom: 15px;'>Select which hours the device should perform updates. Unchecked hours will be skipped to save battery.</div>";
+        
+        // 24 checkboxes in a 4x6 grid (4 columns for better UI fit)
+        chunk += "<div style='display: grid; grid-template-columns: repeat(4, 1fr); gap: 10px; margin-bottom: 20px;'>";
+        for (int hour = 0; hour < 24; hour++) {
+            // Check if hour is enabled: use current config if available, otherwise default to enabled
+            bool isEnabled = hasConfig ? 
+                ((currentConfig.updateHours[hour / 8] >> (hour % 8)) & 1) : 
+                true;  // Default all enabled if no config
+            
+            int nextHour = (hour + 1) % 24;
+            
+            chunk += "<label style='display: flex; align-items: center; gap: 8px; padding: 8px; background: #f5f5f5; border-radius: 4px; cursor: pointer;'>";
+            chunk += "<input type='checkbox' id='hour_" + LegacyString(hour) + "' name='hour_" + LegacyString(hour) + "' class='hour-checkbox'";
+            if (isEnabled) {
+                chunk += " checked";
+            }
+            chunk += "> <div style='line-height: 1.2;'><div>" + LegacyString(hour < 10 ? "0" : "") + LegacyString(hour) + ":00</div>";
+            chunk += "<div style='font-size: 11px; color: #999; margin-top: 1px;'>to " + LegacyString(nextHour < 10 ? "0" : "") + LegacyString(nextHour) + ":00</div></div>";
+            chunk += "</label>";
+        }
+        chunk += "</div>";
+        chunk += "</div>";
+        
+        // Battery Life Estimator - placed after all power-impacting settings
+        chunk += CONFIG_PORTAL_BATTERY_ESTIMATOR_HTML;
+        chunk += legacyMeasuredEnergyHTML(page, currentConfig, hasConfig);
+        chunk += SECTION_END();
+        sink.send(chunk);  // Send scheduling section
+    }
+    
+    // Submit button - text varies by mode
+    chunk = "";  // Clear for footer
+    if (!page.configMode) {
+        chunk += "<button type='submit'>➡️ Next: Configure Dashboard</button>";
+    } else if (hasConfig) {
+        chunk += "<button type='submit'>🔄 Update Configuration</button>";
+    } else {
+        chunk += "<button type='submit'>💾 Save Configuration</button>";
+    }
+    chunk += "</form>";
+    
+    // OTA Update button - only shown in CONFIG_MODE
+    if (page.configMode) {
+        chunk += CONFIG_PORTAL_FIRMWARE_UPDATE_BUTTON;
+        chunk += CONFIG_PORTAL_REBOOT_BUTTON;
+    }
+    
+    // Factory Reset & VCOM Section - only show in CONFIG_MODE
+    if (page.configMode) {
+        chunk += CONFIG_PORTAL_DANGER_ZONE_START;
+        if (page.vcomAvailable) {
+            // VCOM management only available on boards with TPS65186 PMIC (not Inkplate 2)
+            chunk += CONFIG_PORTAL_VCOM_BUTTON;
+        }
+        chunk += CONFIG_PORTAL_DANGER_ZONE_END;
+    }
+    
+    chunk += "</div>";
+    
+    // Modal dialog for factory reset confirmation (only in CONFIG_MODE)
+    if (page.configMode) {
+        chunk += CONFIG_PORTAL_RESET_MODAL_HTML;
+    }
+    
+    // Footer with version
+    LegacyString footer = CONFIG_PORTAL_FOOTER_TEMPLATE;
+    footer.replace("%VERSION%", LegacyString(page.firmwareVersion));
+    chunk += footer;
+    
+    // Factory Reset Modal JavaScript - needed in CONFIG_MODE (for factory reset button in danger zone)
+    // Friendly Name Sanitization JavaScript - needed in both modes (friendly name field now in BOOT_MODE too)
+    // Battery Life Estimator JavaScript - only in CONFIG_MODE
+    // All scripts now served from /scripts/main.js
+    chunk += "<script src='" PORTAL_MAIN_JS_URL "'></script>";
+    
+    // Add floating badge HTML before closing body - only in CONFIG_MODE
+    if (page.configMode) {
+        chunk += CONFIG_PORTAL_BADGE_HTML;
+    }
+    
+    chunk += "</body></html>";
+    sink.send(chunk);  // Send final chunk
+}
+
+// ============================================================================
+// Benchmark
+// ============================================================================
+
+struct StreamSink {
+    size_t bytes;
+    size_t chunks;
+};
+
+static void countChunk(void* context, const char* data, size_t length) {
+    (void)data;
+    StreamSink* sink = static_cast<StreamSink*>(context);
+    sink->bytes += length;
+    sink->chunks++;
+}
+
+static DashboardConfig makeConfig() {
+    DashboardConfig config;
+    config.isConfigured = true;
+    config.wifiSSID = "HomeNet";
+    config.wifiPassword = "correct-horse-battery";
+    config.friendlyName = "kitchen";
+    config.imageCount = 2;
+    config.imageUrls[0] = "https://ha.example.com/local/dashboard.png";
+    config.imageIntervals[0] = 15;
+    config.imageUrls[1] = "https://ha.example.com/local/calendar.png";
+    config.imageIntervals[1] = 60;
+    config.mqttBroker = "mqtt://192.168.1.10:1883";
+    config.mqttUsername = "homeassistant";
+    config.mqttPassword = "mqtt-password";
+    config.useCRC32Check = true;
+    config.overlayEnabled = true;
+    return config;
+}
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 2000;
+    if (iterations <= 0) {
+        iterations = 2000;
+    }
+
+    DashboardConfig config = makeConfig();
+    EnergyStats stats = { 0.25f, 6.5f, 12 };
+    ConfigPageContext page = {};
+    page.configMode = true;
+    page.hasConfig = true;
+    page.config = &config;
+    page.deviceName = "inkplate-a1b2c3";
+    page.ipAddress = "192.168.1.42";
+    page.hostname = "kitchen.local";
+    page.connected = true;
+    page.channelLocked = true;
+    page.channel = 6;
+    page.partialRefreshAvailable = true;
+    page.vcomAvailable = true;
+    page.firmwareVersion = "1.2.3";
+    page.energyStats = &stats;
+    page.powerProfile = { 40.0f, 100.0f, 50.0f, 20.0f, 1200.0f };
+
+    // Earlier generator
+    LegacySink legacy = {};
+    resetHeapPeak();
+    size_t heapBefore = g_heapInUse;
+    generateLegacyPage(page, legacy);
+    size_t legacyPeak = g_heapPeak - heapBefore;
+    size_t legacyAllocations = g_heapAllocations;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        LegacySink sink = {};
+        generateLegacyPage(page, sink);
+    }
+    double legacyUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+    // Streamed templates
+    char buffer[CONFIG_PAGE_BUFFER_SIZE];
+    StreamSink streamed = {};
+    resetHeapPeak();
+    heapBefore = g_heapInUse;
+    {
+        TemplateWriter out(buffer, sizeof(buffer), countChunk, &streamed);
+        renderConfigPage(out, page);
+        out.flush();
+    }
+    size_t streamPeak = g_heapPeak - heapBefore;
+    size_t streamAllocations = g_heapAllocations;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        StreamSink sink = {};
+        TemplateWriter out(buffer, sizeof(buffer), countChunk, &sink);
+        renderConfigPage(out, page);
+        out.flush();
+    }
+    double streamUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+    printf("Configuration page (CONFIG_MODE, 2 images), %d iterations\n\n", iterations);
+    printf("%-18s %10s %8s %8s %12s %16s\n", "generator", "peak heap", "allocs", "chunks", "bytes", "last byte us/op");
+    printf("%-18s %10zu %8zu %8zu %12zu %16.1f\n", "String sections", legacyPeak, legacyAllocations,
+           legacy.chunks, legacy.bytes, legacyUs);
+    printf("%-18s %10zu %8zu %8zu %12zu %16.1f\n", "streamed template", streamPeak, streamAllocations,
+           streamed.chunks, streamed.bytes, streamUs);
+    printf("\nStreamed: %d byte stack buffer, no heap\n", CONFIG_PAGE_BUFFER_SIZE);
+    return streamed.bytes == 0 ? 1 : 0;
+}
@@ -0,0 +1,101 @@
+/**
+ * Image pipeline benchmark (host)
+ *
+ * Streams the 1200x820 dashboard fixtures through the real decoders and the
+ * dithering FramebufferSink in TCP-segment-sized chunks, as ImageManager does
+ * on the device, and reports throughput and peak decoder memory. The same
+ * dashboard as server-dithered IKFB (generate_image_fixtures.py) shows the
+ * decode cost the native format saves against the bytes it adds.
+ *
+ * Not part of ctest - run manually:
+ *   ./test/build/image_pipeline_bench [iterations]
+ *
+ * Host numbers are only useful relative to each other (e.g. before/after a
+ * decoder change); the ESP32 is roughly 20-40x slower per byte.
+ */
+
+#include <streaming_image_decoder.h>
+#include <framebuffer_sink.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#ifndef FIXTURES_DIR
+#define FIXTURES_DIR "fixtures/images"
+#endif
+
+#define TCP_CHUNK_SIZE 1460
+
+static std::vector<uint8_t> readFile(const std::string& name) {
+    std::vector<uint8_t> data;
+    std::string path = std::string(FIXTURES_DIR) + "/" + name;
+    FILE* f = fopen(path.c_str(), "rb");
+    if (f == nullptr) {
+        fprintf(stderr, "Missing fixture: %s\n", path.c_str());
+        exit(1);
+    }
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        data.insert(data.end(), buf, buf + n);
+    }
+    fclose(f);
+    return data;
+}
+
+static void bench(const char* name, uint8_t bitsPerPixel, int iterations) {
+    std::vector<uint8_t> file = readFile(name);
+    const uint16_t width = 1200;
+    const uint16_t height = 820;
+    std::vector<uint8_t> buffer(PackedFramebuffer::bufferSize(width, height, bitsPerPixel));
+
+    size_t peakDecoder = 0;
+    size_t sinkMemory = 0;
+    DecodeStatus status = DECODE_OK;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        PackedFramebuffer framebuffer(buffer.data(), width, height, bitsPerPixel);
+        FramebufferSink sink(&framebuffer, bitsPerPixel, true, width, height);
+        StreamingImageDecoder decoder(&sink);
+        for (size_t pos = 0; pos < file.size(); pos += TCP_CHUNK_SIZE) {
+            size_t n = file.size() - pos < TCP_CHUNK_SIZE ? file.size() - pos : TCP_CHUNK_SIZE;
+            if (decoder.feed(file.data() + pos, n) != DECODE_OK) {
+                break;
+            }
+        }
+        status = decoder.finish();
+        peakDecoder = decoder.getPeakMemoryUsage();
+        sinkMemory = sink.getMemoryUsage();
+    }
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    double perImage = elapsed / iterations;
+    printf("%-20s %d-bit  %7zu B  %8.2f ms/image  %7.1f MB/s in  %6.1f Mpx/s  decoder %6zu B  sink %5zu B  %s\n",
+           name, bitsPerPixel, file.size(), perImage,
+           file.size() / (perImage * 1000.0),
+           (double)width * height / (perImage * 1000.0),
+           peakDecoder, sinkMemory,
+           status == DECODE_DONE ? "ok" : "FAILED");
+}
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 20;
+    if (iterations < 1) {
+        iterations = 1;
+    }
+
+    printf("Streaming decode -> dither -> packed framebuffer, %d-byte chunks, %d iterations\n\n",
+           TCP_CHUNK_SIZE, iterations);
+    bench("dashboard.png", 3, iterations);
+    bench("dashboard.png", 1, iterations);
+    bench("dashboard.jpg", 3, iterations);
+    bench("dashboard.jpg", 1, iterations);
+    bench("dashboard.ikfb", 3, iterations);
+    bench("dashboard_1bit.ikfb", 1, iterations);
+    printf("\nA download-then-decode path buffers the whole file before decoding;\n"
+           "the streaming path holds only the decoder and sink memory shown above.\n");
+    return 0;
+}
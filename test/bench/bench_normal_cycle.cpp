@@ -0,0 +1,781 @@
+/**
+ * Normal-mode cycle benchmark (host)
+ *
+ * Replays the NormalModeController::execute() flow for the scenarios in
+ * integration/test_normal_mode_scenarios.cpp against simulated WiFi, HTTP,
+ * MQTT and display backends. Every backend advances a simulated clock by a
+ * configurable latency, so a run reports the awake time, bytes on the air
+ * and estimated energy of one wake cycle - and what that means for battery
+ * life when the cycle repeats at the configured interval.
+ *
+ * The decisions come from the real production code (decision_logic,
+ * image_slot_table, sleep_logic); only the I/O is simulated. The phase
+ * order mirrors execute() and must be kept in step with it:
+ *   boot (timer wakes start association here) -> WiFi -> NTP (unless all hours enabled or the
+ *   clock is accurate) -> hourly check -> decisions -> .crc32 / conditional GET -> download + decode ->
+ *   refresh (MQTT connect on the other core) -> prefetch of the next carousel slots -> MQTT states ->
+ *   deep sleep. Carousel timer wakes whose target was prefetched go boot -> flash read + decode ->
+ *   refresh -> deep sleep, without WiFi.
+ *
+ * Not part of ctest - run manually:
+ *   ./test/build/normal_cycle_bench [profile] [key=value ...]
+ *
+ *   profile    lan (default), wan-https or weak-wifi
+ *   key=value  override any latency / power parameter, e.g.
+ *              ./test/build/normal_cycle_bench wan-https tls_full_ms=2500 image_kb=120
+ *              ./test/build/normal_cycle_bench list     (print parameters)
+ *
+ * The numbers are a model, not a measurement: use them to compare firmware
+ * changes against each other, and calibrate the profile with the loop time
+ * sensors a real device publishes over MQTT.
+ */
+
+#include <modes/decision_logic.h>
+#include <image_slot_table.h>
+#include <discovery_hash.h>
+#include <telemetry_backlog.h>
+#include <mqtt_connect_policy.h>
+#include <network_cache.h>
+#include <clock_sync.h>
+#include <sleep_logic.h>
+#include <prefetch_cache.h>
+#include "test_helpers.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// =============================================================================
+// Latency and power profile
+// =============================================================================
+
+struct Profile {
+    const char* name;
+    // Device
+    uint32_t boot_ms;               // Reset to execute(): ROM boot, setup(), NVS config load
+    uint32_t display_full_ms;       // Full panel refresh (Inkplate 10, 3-bit)
+    uint32_t decode_ms_per_mpx;     // Streaming PNG decode + dither on the ESP32
+    // WiFi
+    uint32_t wifi_assoc_ms;         // Scan, association, WPA2 handshake
+    uint32_t dhcp_ms;
+    uint32_t network_cache;         // 1 = DHCP lease (timer wakes) and DNS results reused from RTC memory
+    uint32_t wifi_early_ms;         // Part of boot_ms after timer wakes start association (display init,
+                                    // battery read, config load), 0 = association starts in execute()
+    // Network
+    uint32_t rtt_ms;                // Round trip to the image server
+    uint32_t dns_ms;                // First lookup per wake (lwIP caches the rest)
+    uint32_t tls_full_ms;           // Full handshake incl. certificate processing
+    uint32_t tls_resumed_ms;        // Abbreviated handshake from the RTC session cache
+    uint32_t server_ms;             // Server think time per request
+    uint32_t throughput_kbps;       // Download throughput in KB/s
+    uint32_t ntp_ms;                // configTime() until SNTP reports the sync (100 ms polling)
+    uint32_t clock_sync;            // 1 = NTP only when the clock's estimated error requires it (clock_sync)
+    uint32_t https;                 // 1 = image server uses HTTPS
+    // MQTT
+    uint32_t mqtt;                  // 1 = broker configured
+    uint32_t mqtt_rtt_ms;           // Round trip to the broker
+    uint32_t pipeline;              // 1 = MQTT connect overlaps the refresh (CyclePipeline)
+    uint32_t mqtt_batched;          // 1 = one JSON state message instead of one per sensor
+    uint32_t discovery_changed;     // 1 = discovery set changed since last published (e.g. firmware update)
+    uint32_t battery_pct;           // Below TELEMETRY_LOW_BATTERY_PERCENT timer wakes defer MQTT to the backlog
+    uint32_t broker_down;           // Wakes in a row (incl. this one) the broker has been unreachable, 0 = up
+    // Content
+    uint32_t image_kb;              // Image file size
+    uint32_t image_kpx;             // Image pixels (thousands) - 1200x825 = 990
+    uint32_t prefetch;              // Carousel slots fetched ahead into flash (prefetchCount), 0 = off
+    // Power (ESP32 + panel, matches the portal's battery estimator where it overlaps)
+    uint32_t cpu_ma;                // Awake, radio off
+    uint32_t radio_ma;              // Awake, WiFi on
+    uint32_t display_ma;            // Extra while the panel refreshes
+    uint32_t sleep_ua;              // Deep sleep
+    uint32_t battery_mv;            // Nominal battery voltage for mJ figures
+    uint32_t battery_mah;           // Capacity for the battery life column
+};
+
+static const Profile PROFILES[] = {
+    // Local HTTP server, good signal
+    { "lan",       250, 1700, 1300,  1200,  300, 1, 150,   5,  15,    0,   0,  30, 400, 200, 1, 0, 1,  5, 1, 0, 0, 85, 0,  60, 990, 0, 40, 100, 50, 20, 3700, 1200 },
+    // Cloud HTTPS server with session resumption
+    { "wan-https", 250, 1700, 1300,  1200,  300, 1, 150,  40,  40, 1400, 150, 150, 150, 300, 1, 1, 1,  5, 1, 0, 0, 85, 0,  60, 990, 0, 40, 100, 50, 20, 3700, 1200 },
+    // Distant access point: slow association, retransmissions
+    { "weak-wifi", 250, 1700, 1300,  3500, 1500, 1, 150,  80,  80, 1800, 250, 150,  40, 600, 1, 1, 1, 20, 1, 0, 0, 85, 0,  60, 990, 0, 40, 100, 50, 20, 3700, 1200 },
+};
+
+struct Parameter {
+    const char* key;
+    uint32_t Profile::*field;
+};
+
+static const Parameter PARAMETERS[] = {
+    { "boot_ms", &Profile::boot_ms }, { "display_full_ms", &Profile::display_full_ms },
+    { "decode_ms_per_mpx", &Profile::decode_ms_per_mpx }, { "wifi_assoc_ms", &Profile::wifi_assoc_ms },
+    { "dhcp_ms", &Profile::dhcp_ms }, { "network_cache", &Profile::network_cache },
+    { "wifi_early_ms", &Profile::wifi_early_ms },
+    { "rtt_ms", &Profile::rtt_ms }, { "dns_ms", &Profile::dns_ms },
+    { "tls_full_ms", &Profile::tls_full_ms }, { "tls_resumed_ms", &Profile::tls_resumed_ms },
+    { "server_ms", &Profile::server_ms }, { "throughput_kbps", &Profile::throughput_kbps },
+    { "ntp_ms", &Profile::ntp_ms }, { "clock_sync", &Profile::clock_sync },
+    { "https", &Profile::https }, { "mqtt", &Profile::mqtt },
+    { "mqtt_rtt_ms", &Profile::mqtt_rtt_ms }, { "pipeline", &Profile::pipeline },
+    { "mqtt_batched", &Profile::mqtt_batched }, { "discovery_changed", &Profile::discovery_changed },
+    { "battery_pct", &Profile::battery_pct }, { "broker_down", &Profile::broker_down },
+    { "image_kb", &Profile::image_kb },
+    { "image_kpx", &Profile::image_kpx }, { "prefetch", &Profile::prefetch },
+    { "cpu_ma", &Profile::cpu_ma }, { "radio_ma", &Profile::radio_ma },
+    { "display_ma", &Profile::display_ma }, { "sleep_ua", &Profile::sleep_ua },
+    { "battery_mv", &Profile::battery_mv }, { "battery_mah", &Profile::battery_mah },
+};
+
+// Wire sizes of the small messages (bytes, payload + protocol headers)
+#define HTTP_REQUEST_BYTES 220          // GET + Host, User-Agent, Connection
+#define HTTP_CONDITIONAL_BYTES 90       // If-None-Match + If-Modified-Since
+#define HTTP_RESPONSE_HEADER_BYTES 260
+#define CRC32_BODY_BYTES 10
+#define TLS_FULL_RX_BYTES 3800          // Certificate chain + key exchange
+#define TLS_FULL_TX_BYTES 400
+#define TLS_RESUMED_RX_BYTES 250
+#define TLS_RESUMED_TX_BYTES 300
+#define WIFI_JOIN_BYTES 1500            // Probe, auth, association, EAPOL, DHCP
+#define DHCP_BYTES 700                  // DISCOVER/OFFER/REQUEST/ACK (part of WIFI_JOIN_BYTES)
+#define NTP_BYTES 90
+#define MQTT_CONNECT_BYTES 80
+#define MQTT_DISCOVERY_BYTES 420        // One retained Home Assistant config message
+#define MQTT_STATE_BYTES 70             // One retained state message
+#define MQTT_BATCHED_STATE_BYTES 570    // The whole state document (telemetry_payload)
+#define MQTT_SENSOR_COUNT 20            // Sensors published by publishAllTelemetry() (DISCOVERY_SENSORS)
+#define ERROR_SCREEN_DELAY_MS 3000      // delay(3000) after an error screen
+#define FLASH_READ_KBPS 1000            // LittleFS read (prefetched image)
+#define FLASH_WRITE_KBPS 100            // LittleFS write incl. erase (prefetch download)
+
+// =============================================================================
+// Simulated device
+// =============================================================================
+
+enum Activity { ACTIVITY_CPU, ACTIVITY_RADIO, ACTIVITY_DISPLAY, ACTIVITY_DISPLAY_OFFLINE };
+
+// Persists across wakes: RTC memory + NVS
+struct DeviceState {
+    uint8_t imageStateIndex = 0;
+    ImageSlotTable slots;
+    bool tlsSession = false;
+    NetworkCache network;                           // DHCP lease + resolved image host
+    ClockState clock;                               // Last clock sync
+    uint32_t storedVersion[MAX_IMAGE_SLOTS] = {};   // Content version behind the stored ETag
+    PrefetchIndex prefetch;                         // Carousel images in flash
+    uint32_t prefetchedVersion[MAX_IMAGE_SLOTS] = {};  // Content version of each prefetched file
+};
+
+// What the image server holds
+struct ServerState {
+    uint32_t version[MAX_IMAGE_SLOTS] = {};
+    bool fails[MAX_IMAGE_SLOTS] = {};
+};
+
+// Network the simulated device joins
+#define BENCH_IMAGE_HOST "dashboard.example.com"
+#define BENCH_IMAGE_IP 0x0A01A8C0u            // 192.168.1.10
+#define BENCH_NETWORK_HASH networkCacheHash("home")
+static const uint8_t BENCH_BSSID[6] = { 0x24, 0x4B, 0xFE, 0x01, 0x02, 0x03 };
+
+static uint32_t contentCRC32(uint8_t slot, uint32_t version) {
+    return 0x10000000u + slot * 0x100u + version;
+}
+
+struct CycleReport {
+    uint64_t awakeMs = 0;
+    uint64_t phaseMs[7] = {};           // boot, wifi, ntp, crc, image, mqtt, error
+    uint64_t activityMs[4] = {};
+    uint64_t rxBytes = 0;
+    uint64_t txBytes = 0;
+    uint32_t httpRequests = 0;
+    uint32_t tlsFull = 0;
+    uint32_t tlsResumed = 0;
+    uint32_t refreshes = 0;
+    float sleepSeconds = 0;
+    const char* outcome = "";
+};
+
+enum Phase { PHASE_BOOT, PHASE_WIFI, PHASE_NTP, PHASE_CRC, PHASE_IMAGE, PHASE_MQTT, PHASE_ERROR };
+
+class Simulator {
+public:
+    Simulator(const Profile& profile, DeviceState& device, ServerState& server)
+        : _p(profile), _device(device), _server(server) {}
+
+    CycleReport run(const DashboardConfig& config, WakeupReason wakeReason, time_t now);
+
+private:
+    const Profile& _p;
+    DeviceState& _device;
+    ServerState& _server;
+    CycleReport _report;
+    Phase _phase = PHASE_BOOT;
+    bool _connectionOpen = false;
+    bool _dnsCached = false;
+    time_t _now = 0;
+
+    void spend(uint64_t ms, Activity activity) {
+        _report.awakeMs += ms;
+        _report.phaseMs[_phase] += ms;
+        _report.activityMs[activity] += ms;
+    }
+
+    uint64_t transferMs(uint64_t bytes) const {
+        return bytes * 1000 / ((uint64_t)_p.throughput_kbps * 1024);
+    }
+
+    // One HTTP GET on the shared keep-alive connection (HttpConnection)
+    void httpGet(uint32_t bodyBytes, bool conditional) {
+        _report.httpRequests++;
+        if (!_connectionOpen) {
+            uint32_t ip;
+            if (!_dnsCached && !(_p.network_cache && lookupDnsCache(_device.network, BENCH_IMAGE_HOST, (uint32_t)_now, ip))) {
+                spend(_p.dns_ms, ACTIVITY_RADIO);
+                storeDnsCache(_device.network, BENCH_IMAGE_HOST, BENCH_IMAGE_IP, (uint32_t)_now);
+            }
+            _dnsCached = true;
+            spend(_p.rtt_ms, ACTIVITY_RADIO);  // TCP handshake
+            if (_p.https) {
+                if (_device.tlsSession) {
+                    spend(_p.tls_resumed_ms, ACTIVITY_RADIO);
+                    _report.rxBytes += TLS_RESUMED_RX_BYTES;
+                    _report.txBytes += TLS_RESUMED_TX_BYTES;
+                    _report.tlsResumed++;
+                } else {
+                    spend(_p.tls_full_ms, ACTIVITY_RADIO);
+                    _report.rxBytes += TLS_FULL_RX_BYTES;
+                    _report.txBytes += TLS_FULL_TX_BYTES;
+                    _report.tlsFull++;
+                    _device.tlsSession = true;
+                }
+            }
+            _connectionOpen = true;
+        }
+        uint32_t request = HTTP_REQUEST_BYTES + (conditional ? HTTP_CONDITIONAL_BYTES : 0);
+        _report.txBytes += request;
+        _report.rxBytes += HTTP_RESPONSE_HEADER_BYTES + bodyBytes;
+        spend(_p.rtt_ms + _p.server_ms + transferMs(HTTP_RESPONSE_HEADER_BYTES + bodyBytes), ACTIVITY_RADIO);
+        // Date header (ImageManager::applyServerDate)
+        if (_p.clock_sync && shouldUseHttpDate(_device.clock, (uint32_t)_now, (uint32_t)_now, false)) {
+            recordClockSync(_device.clock, (uint32_t)_now, (uint32_t)_now, CLOCK_SOURCE_HTTP_DATE, false);
+        }
+    }
+
+    void refreshPanel(Activity activity = ACTIVITY_DISPLAY) {
+        spend(_p.display_full_ms, activity);
+        _report.refreshes++;
+    }
+
+    void showErrorScreen() {
+        Phase previous = _phase;
+        _phase = PHASE_ERROR;
+        refreshPanel();
+        spend(ERROR_SCREEN_DELAY_MS, ACTIVITY_RADIO);
+        _phase = previous;
+    }
+
+    // Connect time against an unreachable broker: the RTC connect history after
+    // broker_down - 1 failed wakes decides whether this wake probes it (mqtt_connect_policy)
+    uint64_t failedConnectMs(WakeupReason wakeReason) const {
+        MqttConnectStats stats;
+        initMqttConnectStats(stats);
+        recordMqttConnectSuccess(stats, 2 * _p.mqtt_rtt_ms + 10);
+        for (uint32_t i = 1; i < _p.broker_down; i++) {
+            if (planMqttConnect(stats, false).skip) {
+                recordMqttConnectSkipped(stats);
+            } else {
+                recordMqttConnectFailure(stats);
+            }
+        }
+        MqttConnectPlan plan = planMqttConnect(stats, wakeReason != WAKEUP_TIMER);
+        uint64_t ms = 0;
+        for (uint8_t attempt = 1; !plan.skip && attempt <= plan.attempts && canStartMqttAttempt(plan, ms); attempt++) {
+            ms += plan.socketTimeoutS * 1000;
+            if (attempt < plan.attempts && canStartMqttAttempt(plan, ms + plan.retryDelayMs)) {
+                ms += plan.retryDelayMs;
+            }
+        }
+        return ms;
+    }
+
+    // TCP + CONNECT/CONNACK and discovery (MQTTManager::openTelemetry), returns its duration
+    uint64_t openTelemetryMs(WakeupReason wakeReason) {
+        if (_p.broker_down) {
+            return failedConnectMs(wakeReason);  // Nothing reaches the broker, telemetry goes to the backlog
+        }
+        _report.txBytes += MQTT_CONNECT_BYTES;
+        _report.rxBytes += 4;
+        uint64_t ms = 2 * _p.mqtt_rtt_ms + 10;
+        // Discovery set hashed once published; the stored hash is 1, the current one 1 or 2
+        uint32_t currentHash = _p.discovery_changed ? 2 : 1;
+        if (isDiscoveryPublishNeeded(currentHash, 1, wakeReason == WAKEUP_RESET_BUTTON)) {
+            _report.txBytes += MQTT_SENSOR_COUNT * MQTT_DISCOVERY_BYTES;
+            ms += MQTT_SENSOR_COUNT;  // ~1 ms per publish
+        }
+        return ms;
+    }
+
+    void publishStates() {
+        if (_p.broker_down) {
+            return;
+        }
+        uint32_t messages = _p.mqtt_batched ? 1 : MQTT_SENSOR_COUNT;
+        _report.txBytes += _p.mqtt_batched ? MQTT_BATCHED_STATE_BYTES : MQTT_SENSOR_COUNT * MQTT_STATE_BYTES;
+        spend(messages + 30, ACTIVITY_RADIO);  // ~1 ms per publish + 3 x loop()/delay(10)
+    }
+
+    // Low battery timer wakes only record to the RTC backlog (never full in a single cycle)
+    bool telemetryDeferred(WakeupReason wakeReason) const {
+        TelemetryBacklog backlog;
+        initTelemetryBacklog(backlog);
+        return shouldDeferTelemetry(backlog, _p.battery_mv / 1000.0f, (int)_p.battery_pct, wakeReason != WAKEUP_TIMER);
+    }
+
+    void publishTelemetry(WakeupReason wakeReason) {
+        if (!_p.mqtt || telemetryDeferred(wakeReason)) {
+            return;
+        }
+        _phase = PHASE_MQTT;
+        spend(openTelemetryMs(wakeReason), ACTIVITY_RADIO);
+        publishStates();
+    }
+
+    // NormalModeController::refreshWithTelemetry(): the connect runs on the other
+    // core while the panel refreshes, only the part outlasting the refresh adds time
+    void refreshWithTelemetry(WakeupReason wakeReason) {
+        if (!_p.mqtt || !_p.pipeline || telemetryDeferred(wakeReason)) {
+            refreshPanel();
+            publishTelemetry(wakeReason);
+            return;
+        }
+        uint64_t connectMs = openTelemetryMs(wakeReason);
+        refreshPanel();
+        _phase = PHASE_MQTT;
+        if (connectMs > _p.display_full_ms) {
+            spend(connectMs - _p.display_full_ms, ACTIVITY_RADIO);
+        }
+        publishStates();
+    }
+
+    void sleep(float seconds, const char* outcome) {
+        _connectionOpen = false;  // HttpConnection is closed before deep sleep
+        _report.sleepSeconds = seconds;
+        _report.outcome = outcome;
+    }
+
+    void handleFailure(const DashboardConfig& config, WakeupReason wakeReason, uint8_t index);
+    bool displayPrefetched(const DashboardConfig& config, WakeupReason wakeReason);
+    void prefetchNextImages(const DashboardConfig& config, uint8_t currentIndex);
+};
+
+CycleReport Simulator::run(const DashboardConfig& config, WakeupReason wakeReason, time_t now) {
+    _report = CycleReport();
+    _now = now;
+    // WiFiManager::beginConnect(): timer wakes lock onto the same AP and reuse its lease
+    bool leaseReused = _p.network_cache && wakeReason == WAKEUP_TIMER &&
+                       getReusableDhcpLease(_device.network, BENCH_NETWORK_HASH, BENCH_BSSID, (uint32_t)now) != nullptr;
+    uint64_t connectMs = _p.wifi_assoc_ms + (leaseReused ? 0 : _p.dhcp_ms);
+
+    // Timer wakes start association in setup(): it runs during the rest of the boot phase
+    // (not while prefetched images are cached - the wake may not need WiFi)
+    uint64_t earlyMs = 0;
+    if (wakeReason == WAKEUP_TIMER && !hasPrefetchedImages(_device.prefetch)) {
+        earlyMs = _p.wifi_early_ms < _p.boot_ms ? _p.wifi_early_ms : _p.boot_ms;
+        earlyMs = earlyMs < connectMs ? earlyMs : connectMs;
+    }
+    _phase = PHASE_BOOT;
+    spend(_p.boot_ms - earlyMs, ACTIVITY_CPU);
+    spend(earlyMs, ACTIVITY_RADIO);
+
+    if (displayPrefetched(config, wakeReason)) {
+        return _report;
+    }
+
+    _phase = PHASE_WIFI;
+    spend(connectMs - earlyMs, ACTIVITY_RADIO);
+    uint32_t joinBytes = WIFI_JOIN_BYTES - (leaseReused ? DHCP_BYTES : 0);
+    _report.rxBytes += joinBytes / 2;
+    _report.txBytes += joinBytes / 2;
+
+    bool allHoursEnabled = ConfigManager::areAllHoursEnabled(config.updateHours);
+    if (!allHoursEnabled) {
+        // ClockManager: NTP only once the estimated error exceeds CLOCK_MAX_ERROR_SECONDS
+        if (!_p.clock_sync || isClockSyncNeeded(_device.clock, (uint32_t)now, false)) {
+            _phase = PHASE_NTP;
+            spend(_p.ntp_ms, ACTIVITY_RADIO);
+            _report.rxBytes += NTP_BYTES / 2;
+            _report.txBytes += NTP_BYTES / 2;
+            recordClockSync(_device.clock, (uint32_t)now, (uint32_t)now, CLOCK_SOURCE_NTP, false);
+        }
+
+        struct tm* timeinfo = localtime(&now);
+        int hour = ConfigManager::applyTimezoneOffset(timeinfo->tm_hour, config.timezoneOffset);
+        if (wakeReason == WAKEUP_TIMER && !ConfigManager::isHourEnabledInBitmask(hour, config.updateHours)) {
+            float minutes = calculateSleepMinutesToNextEnabledHour(now, config.timezoneOffset, config.updateHours);
+            sleep(minutes > 0 ? minutes * 60.0f : config.getAverageInterval() * 60.0f, "hour disabled");
+            return _report;
+        }
+    }
+
+    uint8_t currentIndex = _device.imageStateIndex % config.imageCount;
+    pruneImageSlots(_device.slots, config.imageCount);
+    NormalModeDecisions decisions = orchestrateNormalModeDecisions(config, wakeReason, currentIndex,
+                                                                   _device.slots.displayedSlot);
+    if (decisions.imageTarget.shouldAdvance) {
+        _device.imageStateIndex = decisions.finalIndex;
+        currentIndex = decisions.finalIndex;
+    }
+    const CRC32Decision& crc32Decision = decisions.crc32Action;
+    bool allowSkip = decisions.unchangedSkip.allowSkip;
+    uint32_t serverVersion = _server.version[currentIndex];
+    uint32_t serverCRC32 = contentCRC32(currentIndex, serverVersion);
+    bool crc32Matched = false;
+
+    if (crc32Decision.strategy == CHANGE_STRATEGY_CRC32) {
+        _phase = PHASE_CRC;
+        httpGet(CRC32_BODY_BYTES, false);
+        crc32Matched = getSlotCRC32(_device.slots, currentIndex) == serverCRC32;
+        if (allowSkip && crc32Matched) {
+            publishTelemetry(wakeReason);
+            sleep(determineSleepDuration(config, now, currentIndex, true).sleepSeconds, "CRC32 match, skipped");
+            return _report;
+        }
+    }
+
+    _phase = PHASE_IMAGE;
+    bool useConditionalGet = crc32Decision.strategy == CHANGE_STRATEGY_CONDITIONAL_GET;
+    bool sendValidators = useConditionalGet && allowSkip && _device.storedVersion[currentIndex] != 0;
+    if (_server.fails[currentIndex]) {
+        httpGet(0, sendValidators);  // 404 / 500: headers only
+        handleFailure(config, wakeReason, currentIndex);
+        return _report;
+    }
+    if (sendValidators && _device.storedVersion[currentIndex] == serverVersion) {
+        httpGet(0, true);  // 304 Not Modified
+        publishTelemetry(wakeReason);
+        sleep(determineSleepDuration(config, now, currentIndex, true).sleepSeconds, "HTTP 304, skipped");
+        return _report;
+    }
+    httpGet(_p.image_kb * 1024, sendValidators);
+    spend((uint64_t)_p.image_kpx * _p.decode_ms_per_mpx / 1000, ACTIVITY_RADIO);
+
+    if (useConditionalGet) {
+        _device.storedVersion[currentIndex] = serverVersion;
+    }
+    recordSlotDisplayed(_device.slots, currentIndex,
+                        crc32Decision.strategy == CHANGE_STRATEGY_CRC32 ? serverCRC32 : 0);
+    if (!config.isCarouselMode()) {
+        _device.imageStateIndex = 0;
+    }
+    refreshWithTelemetry(wakeReason);
+    prefetchNextImages(config, currentIndex);
+    uint8_t sleepIndex = config.isCarouselMode() ? currentIndex : 0;
+    sleep(determineSleepDuration(config, now, sleepIndex, crc32Matched).sleepSeconds, "displayed");
+    return _report;
+}
+
+void Simulator::handleFailure(const DashboardConfig& config, WakeupReason wakeReason, uint8_t index) {
+    // Mirrors NormalModeController::handleImageFailure()
+    bool retrySlot = !config.isCarouselMode() || index == 0;
+    if (retrySlot && _device.imageStateIndex < 2) {
+        _device.imageStateIndex++;
+        invalidateSlot(_device.slots, index);
+        sleep(20.0f, "download failed, retry");
+        return;
+    }
+    if (retrySlot) {
+        showErrorScreen();
+        _device.imageStateIndex = config.isCarouselMode() ? 1 : 0;
+        invalidateSlot(_device.slots, index);
+        clearDisplayedSlot(_device.slots);
+        publishTelemetry(wakeReason);
+        sleep(config.isCarouselMode() ? 20.0f : 60.0f, "download failed, error screen");
+        return;
+    }
+    _device.imageStateIndex = (index + 1) % config.imageCount;
+    publishTelemetry(wakeReason);
+    sleep(20.0f, "download failed, skipped");
+}
+
+bool Simulator::displayPrefetched(const DashboardConfig& config, WakeupReason wakeReason) {
+    // Mirrors NormalModeController::displayPrefetchedImage()
+    if (wakeReason != WAKEUP_TIMER || !config.isCarouselMode() || !hasPrefetchedImages(_device.prefetch)) {
+        return false;
+    }
+    if (!ConfigManager::areAllHoursEnabled(config.updateHours)) {
+        struct tm* timeinfo = localtime(&_now);
+        int hour = ConfigManager::applyTimezoneOffset(timeinfo->tm_hour, config.timezoneOffset);
+        if (!ConfigManager::isHourEnabledInBitmask(hour, config.updateHours)) {
+            return false;
+        }
+    }
+    uint8_t currentIndex = _device.imageStateIndex % config.imageCount;
+    pruneImageSlots(_device.slots, config.imageCount);
+    NormalModeDecisions decisions = orchestrateNormalModeDecisions(config, wakeReason, currentIndex,
+                                                                   _device.slots.displayedSlot);
+    uint8_t target = decisions.imageTarget.shouldAdvance ? decisions.finalIndex : currentIndex;
+    if (!decidePrefetchDisplay(_device.prefetch, target, prefetchUrlHash(config.imageUrls[target].c_str()),
+                               _device.slots.displayedSlot, (uint32_t)_now).useCache) {
+        return false;
+    }
+
+    _phase = PHASE_IMAGE;
+    spend((uint64_t)findPrefetchEntry(_device.prefetch, target)->size * 1000 / (FLASH_READ_KBPS * 1024), ACTIVITY_CPU);
+    spend((uint64_t)_p.image_kpx * _p.decode_ms_per_mpx / 1000, ACTIVITY_CPU);
+    refreshPanel(ACTIVITY_DISPLAY_OFFLINE);
+    _device.imageStateIndex = target;
+    recordSlotDisplayed(_device.slots, target, 0);
+    if (decisions.crc32Action.strategy == CHANGE_STRATEGY_CONDITIONAL_GET) {
+        _device.storedVersion[target] = _device.prefetchedVersion[target];
+    }
+    sleep(determineSleepDuration(config, _now, target, false).sleepSeconds, "prefetched, no WiFi");
+    return true;
+}
+
+void Simulator::prefetchNextImages(const DashboardConfig& config, uint8_t currentIndex) {
+    // Mirrors ImageManager::prefetchImages(): conditional GET per cached slot, download + flash write otherwise
+    uint8_t slots[PREFETCH_MAX_ENTRIES];
+    uint32_t hashes[PREFETCH_MAX_ENTRIES];
+    uint8_t removed[PREFETCH_MAX_ENTRIES];
+    uint8_t count = planPrefetchSlots(config.imageStay, config.imageCount, currentIndex, _p.prefetch, slots);
+    for (uint8_t i = 0; i < count; i++) {
+        hashes[i] = prefetchUrlHash(config.imageUrls[slots[i]].c_str());
+    }
+    retainPrefetchEntries(_device.prefetch, slots, hashes, count, removed);
+
+    _phase = PHASE_IMAGE;
+    uint32_t fileBytes = _p.image_kb * 1024;
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t slot = slots[i];
+        bool cached = findPrefetchEntry(_device.prefetch, slot) != nullptr;
+        if (cached && _device.prefetchedVersion[slot] == _server.version[slot]) {
+            httpGet(0, true);  // 304 - no flash write
+            recordPrefetchValidated(_device.prefetch, slot, (uint32_t)_now);
+            continue;
+        }
+        removePrefetchEntry(_device.prefetch, slot);
+        if (_server.fails[slot] || fileBytes > getPrefetchBudget(_device.prefetch, slot)) {
+            httpGet(0, cached);
+            continue;
+        }
+        httpGet(fileBytes, cached);
+        spend((uint64_t)fileBytes * 1000 / (FLASH_WRITE_KBPS * 1024), ACTIVITY_RADIO);
+        recordPrefetchStored(_device.prefetch, slot, hashes[i], fileBytes, (uint32_t)_now);
+        _device.prefetchedVersion[slot] = _server.version[slot];
+    }
+}
+
+// =============================================================================
+// Scenarios (named after integration/test_normal_mode_scenarios.cpp)
+// =============================================================================
+
+struct Scenario {
+    const char* name;
+    DashboardConfig config;
+    WakeupReason wake;
+    time_t now;
+    uint8_t index;              // imageStateIndex at wake
+    uint8_t displayedSlot;      // Slot on the panel (IMAGE_SLOT_NONE = unknown)
+    bool changed;               // Server content differs from what each slot last showed
+    bool fails;                 // Image request fails
+};
+
+static std::vector<Scenario> scenarios() {
+    const time_t afternoon = createTime(2025, 11, 15, 14, 30, 0);
+    const time_t night = createTime(2025, 11, 15, 3, 0, 0);
+    const uint8_t NONE = IMAGE_SLOT_NONE;
+
+    DashboardConfig single = ConfigBuilder().singleImage("http://example.com/image.png", 15).withCRC32(true).build();
+    DashboardConfig singleNoCrc = ConfigBuilder().singleImage("http://example.com/image.png", 15).build();
+    DashboardConfig singleHttp = ConfigBuilder().singleImage("http://example.com/image.png", 15).withConditionalGet().build();
+    DashboardConfig buttonOnly = ConfigBuilder().singleImage("http://example.com/image.png", 0).withCRC32(true).build();
+    DashboardConfig carousel = ConfigBuilder().carousel()
+        .addImage("http://example.com/img0.png", 5, false)
+        .addImage("http://example.com/img1.png", 10, true)
+        .addImage("http://example.com/img2.png", 15, false)
+        .withCRC32(true).build();
+    DashboardConfig scheduled = ConfigBuilder().singleImage("http://example.com/image.png", 15)
+        .withCRC32(true).withHourlySchedule(7, 22).build();
+
+    return {
+        { "SingleImage_TimerWake_CRC32Match_SkipsDownload",   single,      WAKEUP_TIMER,  afternoon, 0, 0,    false, false },
+        { "SingleImage_TimerWake_CRC32Changed_Downloads",     single,      WAKEUP_TIMER,  afternoon, 0, 0,    true,  false },
+        { "SingleImage_TimerWake_NoChangeDetection",          singleNoCrc, WAKEUP_TIMER,  afternoon, 0, 0,    false, false },
+        { "SingleImage_ButtonWake_AlwaysDownloads",           single,      WAKEUP_BUTTON, afternoon, 0, 0,    false, false },
+        { "Carousel_TimerWake_StayFalse_AdvancesToNext",      carousel,    WAKEUP_TIMER,  afternoon, 0, 0,    false, false },
+        { "Carousel_TimerWake_StayTrue_RemainsOnCurrent",     carousel,    WAKEUP_TIMER,  afternoon, 1, 1,    false, false },
+        { "Carousel_ButtonWake_AlwaysAdvances",               carousel,    WAKEUP_BUTTON, afternoon, 1, 1,    false, false },
+        { "HourlySchedule_DisabledHour_SleepsUntilEnabled",   scheduled,   WAKEUP_TIMER,  night,     0, 0,    false, false },
+        { "ButtonWake_BypassesHourlySchedule",                scheduled,   WAKEUP_BUTTON, night,     0, 0,    false, false },
+        { "HourlySchedule_EnabledHour_CRC32Match",            scheduled,   WAKEUP_TIMER,  afternoon, 0, 0,    false, false },
+        { "ButtonOnlyMode_Interval0_IndefiniteSleep",         buttonOnly,  WAKEUP_BUTTON, afternoon, 0, 0,    false, false },
+        { "ConditionalGet_TimerWake_NotModified_Skips",       singleHttp,  WAKEUP_TIMER,  afternoon, 0, 0,    false, false },
+        { "ConditionalGet_TimerWake_Modified_Displays",       singleHttp,  WAKEUP_TIMER,  afternoon, 0, 0,    true,  false },
+        { "SlotTable_ScreenReplaced_ForcesDownload",          single,      WAKEUP_TIMER,  afternoon, 0, NONE, false, false },
+        { "SlotTable_AutoAdvance_NeverSkipsEvenIfUnchanged",  carousel,    WAKEUP_TIMER,  afternoon, 2, 2,    false, false },
+        { "FirstBoot_PublishesDiscovery",                     single,      WAKEUP_FIRST_BOOT, afternoon, 0, NONE, false, false },
+        { "SingleImage_DownloadFails_RetrySleep",             single,      WAKEUP_TIMER,  afternoon, 0, 0,    true,  true  },
+        { "SingleImage_DownloadFails_ErrorScreen",            single,      WAKEUP_TIMER,  afternoon, 2, 0,    true,  true  },
+    };
+}
+
+// Device and server as they are when the scenario's wake happens
+static void prepare(const Scenario& s, uint8_t prefetch, DeviceState& device, ServerState& server) {
+    device = DeviceState();
+    initImageSlotTable(device.slots);
+    device.imageStateIndex = s.index;
+    device.tlsSession = true;  // Earlier wakes left a session in RTC memory
+    // ... and the lease / image host address from 10 minutes ago
+    initNetworkCache(device.network);
+    DhcpLeaseCache lease = {};
+    lease.ip = 0x2A01A8C0u;
+    storeDhcpLease(device.network, lease, 86400, BENCH_NETWORK_HASH, BENCH_BSSID, (uint32_t)s.now - 600);
+    storeDnsCache(device.network, BENCH_IMAGE_HOST, BENCH_IMAGE_IP, (uint32_t)s.now - 600);
+    // ... and the clock synced with NTP on that wake
+    initClockState(device.clock);
+    recordClockSync(device.clock, (uint32_t)s.now - 600, (uint32_t)s.now - 600, CLOCK_SOURCE_NTP, false);
+    for (uint8_t slot = 0; slot < s.config.imageCount; slot++) {
+        recordSlotDisplayed(device.slots, slot, contentCRC32(slot, 1));
+        device.storedVersion[slot] = 1;
+        server.version[slot] = s.changed ? 2 : 1;
+        server.fails[slot] = s.fails;
+    }
+    if (s.displayedSlot == IMAGE_SLOT_NONE) {
+        clearDisplayedSlot(device.slots);
+    } else {
+        recordSlotDisplayed(device.slots, s.displayedSlot, contentCRC32(s.displayedSlot, 1));
+    }
+    // ... which also prefetched the slots following the one it displayed
+    initPrefetchIndex(device.prefetch);
+    uint8_t prefetched[PREFETCH_MAX_ENTRIES];
+    uint8_t prefetchedCount = s.displayedSlot == IMAGE_SLOT_NONE ? 0 :
+        planPrefetchSlots(s.config.imageStay, s.config.imageCount, s.displayedSlot, prefetch, prefetched);
+    for (uint8_t i = 0; i < prefetchedCount; i++) {
+        uint8_t slot = prefetched[i];
+        recordPrefetchStored(device.prefetch, slot, prefetchUrlHash(s.config.imageUrls[slot].c_str()),
+                             60 * 1024, (uint32_t)s.now - 600);
+        device.prefetchedVersion[slot] = 1;
+    }
+    if (s.wake == WAKEUP_FIRST_BOOT) {
+        device.tlsSession = false;
+        initNetworkCache(device.network);
+        initClockState(device.clock);
+        initPrefetchIndex(device.prefetch);
+    }
+}
+
+// =============================================================================
+// Report
+// =============================================================================
+
+static double energyMilliJoules(const Profile& p, const CycleReport& r) {
+    double mAs = (r.activityMs[ACTIVITY_CPU] * (double)p.cpu_ma +
+                  r.activityMs[ACTIVITY_RADIO] * (double)p.radio_ma +
+                  r.activityMs[ACTIVITY_DISPLAY] * (double)(p.radio_ma + p.display_ma) +
+                  r.activityMs[ACTIVITY_DISPLAY_OFFLINE] * (double)(p.cpu_ma + p.display_ma)) / 1000.0;
+    return mAs * p.battery_mv / 1000.0;
+}
+
+static double chargeMicroAmpHours(const Profile& p, const CycleReport& r) {
+    return energyMilliJoules(p, r) / (p.battery_mv / 1000.0) / 3.6;  // mC -> uAh
+}
+
+// Battery life if this exact cycle repeated forever (sleep compensated like PowerManager)
+static double batteryDays(const Profile& p, const CycleReport& r) {
+    if (r.sleepSeconds <= 0) {
+        return -1;  // Button-only: depends on presses
+    }
+    double sleepSeconds = calculateAdjustedSleepDuration(r.sleepSeconds, r.awakeMs / 1000.0f) / 1e6;
+    double periodSeconds = sleepSeconds + r.awakeMs / 1000.0;
+    double cyclesPerDay = 86400.0 / periodSeconds;
+    double mAhPerDay = cyclesPerDay * chargeMicroAmpHours(p, r) / 1000.0 +
+                       (sleepSeconds * cyclesPerDay / 3600.0) * p.sleep_ua / 1000.0;
+    return p.battery_mah / mAhPerDay;
+}
+
+static void printParameters(const Profile& p) {
+    printf("Profile %s:\n", p.name);
+    for (const Parameter& param : PARAMETERS) {
+        printf("  %-20s %u\n", param.key, p.*param.field);
+    }
+}
+
+int main(int argc, char** argv) {
+    Profile profile = PROFILES[0];
+    bool list = false;
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* eq = strchr(arg, '=');
+        if (strcmp(arg, "list") == 0) {
+            list = true;
+            continue;
+        }
+        if (eq == nullptr) {
+            bool found = false;
+            for (const Profile& candidate : PROFILES) {
+                if (strcmp(candidate.name, arg) == 0) {
+                    profile = candidate;
+                    found = true;
+                }
+            }
+            if (!found) {
+                fprintf(stderr, "Unknown profile: %s (lan, wan-https, weak-wifi)\n", arg);
+                return 1;
+            }
+            continue;
+        }
+        std::string key(arg, eq - arg);
+        bool found = false;
+        for (const Parameter& param : PARAMETERS) {
+            if (key == param.key) {
+                profile.*param.field = (uint32_t)strtoul(eq + 1, nullptr, 10);
+                found = true;
+            }
+        }
+        if (!found) {
+            fprintf(stderr, "Unknown parameter: %s (run with 'list')\n", key.c_str());
+            return 1;
+        }
+    }
+    if (list) {
+        printParameters(profile);
+        return 0;
+    }
+    if (profile.throughput_kbps == 0) {
+        profile.throughput_kbps = 1;
+    }
+
+    printf("Normal-mode cycle model, profile '%s' (%s, %u KB image, MQTT %s)\n\n", profile.name,
+           profile.https ? "HTTPS" : "HTTP", profile.image_kb, profile.mqtt ? "on" : "off");
+    printf("%-48s %7s %6s %6s %6s %6s %6s %6s %8s %8s %4s %7s %8s %7s  %s\n",
+           "scenario", "awake", "wifi", "ntp", "crc", "image", "mqtt", "error",
+           "rx B", "tx B", "req", "mJ", "uAh", "days", "outcome");
+
+    for (const Scenario& s : scenarios()) {
+        DeviceState device;
+        ServerState server;
+        prepare(s, (uint8_t)profile.prefetch, device, server);
+        Simulator simulator(profile, device, server);
+        CycleReport r = simulator.run(s.config, s.wake, s.now);
+
+        double days = batteryDays(profile, r);
+        char daysText[16];
+        if (days < 0) {
+            snprintf(daysText, sizeof(daysText), "-");
+        } else {
+            snprintf(daysText, sizeof(daysText), "%.0f", days);
+        }
+        printf("%-48s %7llu %6llu %6llu %6llu %6llu %6llu %6llu %8llu %8llu %4u %7.0f %8.1f %7s  %s\n",
+               s.name, (unsigned long long)r.awakeMs,
+               (unsigned long long)r.phaseMs[PHASE_WIFI], (unsigned long long)r.phaseMs[PHASE_NTP],
+               (unsigned long long)r.phaseMs[PHASE_CRC], (unsigned long long)r.phaseMs[PHASE_IMAGE],
+               (unsigned long long)r.phaseMs[PHASE_MQTT], (unsigned long long)r.phaseMs[PHASE_ERROR],
+               (unsigned long long)r.rxBytes, (unsigned long long)r.txBytes, r.httpRequests,
+               energyMilliJoules(profile, r), chargeMicroAmpHours(profile, r), daysText, r.outcome);
+    }
+
+    printf("\nTimes in ms (simulated). 'days' = battery life (%u mAh) if the cycle repeated at its\n"
+           "sleep interval; '-' for button-only sleep. Parameters: run with 'list'.\n", profile.battery_mah);
+    return 0;
+}
@@ -0,0 +1,138 @@
+/**
+ * Telemetry payload benchmark (host)
+ *
+ * Compares the batched state document (telemetry_payload) with the
+ * per-topic state messages of MQTTManager::publishAllTelemetry(): bytes on
+ * the wire (MQTT PUBLISH packets including topics and headers), packets
+ * sent, and the time to build the payloads. The per-topic side is modeled
+ * with std::string concatenation, like the Arduino String chain it mirrors.
+ *
+ * Not part of ctest - run manually:
+ *   ./test/build/telemetry_payload_bench [iterations]
+ */
+
+#include <telemetry_payload.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#define DEVICE_ID "a1b2c3d4e5f6"    // 12 hex digits, as generated from the MAC address
+
+struct TopicMessage {
+    std::string topic;
+    std::string payload;
+};
+
+static std::string stateTopic(const char* sensor) {
+    return std::string("homeassistant/sensor/") + DEVICE_ID + "/" + sensor + "/state";
+}
+
+static std::string fixed(float value, int decimals) {
+    char text[32];
+    snprintf(text, sizeof(text), "%.*f", decimals, (double)value);
+    return text;
+}
+
+// Per-topic messages for the same values (publishAllTelemetry without batching)
+static std::vector<TopicMessage> buildPerTopic(const TelemetryState& s) {
+    std::vector<TopicMessage> messages;
+    if (s.batteryVoltage > 0) messages.push_back({ stateTopic("battery_voltage"), fixed(s.batteryVoltage, 3) });
+    if (s.batteryPercentage >= 0) messages.push_back({ stateTopic("battery_percentage"), std::to_string(s.batteryPercentage) });
+    messages.push_back({ stateTopic("wifi_signal"), std::to_string(s.wifiRSSI) });
+    messages.push_back({ stateTopic("loop_time"), fixed(s.loopTimeSeconds, 2) });
+    if (s.lastLog != nullptr) messages.push_back({ stateTopic("last_log"), std::string("[INFO] ") + s.lastLog });
+    char crc[11];
+    snprintf(crc, sizeof(crc), "0x%08X", (unsigned)s.imageCRC32);
+    messages.push_back({ stateTopic("image_crc32"), crc });
+    if (s.wifiBSSID != nullptr) messages.push_back({ stateTopic("wifi_bssid"), s.wifiBSSID });
+    messages.push_back({ stateTopic("loop_time_wifi"), fixed(s.wifiSeconds, 2) });
+    messages.push_back({ stateTopic("loop_time_wifi_early"), fixed(s.wifiEarlySeconds, 2) });
+    messages.push_back({ stateTopic("loop_time_ntp"), fixed(s.ntpSeconds, 2) });
+    messages.push_back({ stateTopic("loop_time_crc"), fixed(s.crcSeconds, 2) });
+    messages.push_back({ stateTopic("loop_time_image"), fixed(s.imageSeconds, 2) });
+    messages.push_back({ stateTopic("loop_time_wifi_retries"), std::to_string(s.wifiRetries) });
+    messages.push_back({ stateTopic("loop_time_crc_retries"), std::to_string(s.crcRetries) });
+    messages.push_back({ stateTopic("loop_time_image_retries"), std::to_string(s.imageRetries) });
+    messages.push_back({ stateTopic("tls_full_handshakes"), std::to_string(s.tlsFullHandshakes) });
+    messages.push_back({ stateTopic("tls_resumed_handshakes"), std::to_string(s.tlsResumedHandshakes) });
+    messages.push_back({ stateTopic("http_reused_connections"), std::to_string(s.httpReusedConnections) });
+    messages.push_back({ stateTopic("wake_charge"), fixed(s.cycleChargeMah, 3) });
+    messages.push_back({ stateTopic("battery_days_remaining"), fixed(s.batteryDaysRemaining, 0) });
+    return messages;
+}
+
+// MQTT 3.1.1 PUBLISH, QoS 0: fixed header (1 + remaining length) + topic length + topic + payload
+static size_t publishPacketBytes(size_t topicLength, size_t payloadLength) {
+    size_t remaining = 2 + topicLength + payloadLength;
+    size_t lengthBytes = remaining < 128 ? 1 : remaining < 16384 ? 2 : 3;
+    return 1 + lengthBytes + remaining;
+}
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 100000;
+    if (iterations <= 0) {
+        iterations = 100000;
+    }
+
+    TelemetryState state;
+    initTelemetryState(state);
+    state.batteryVoltage = 3.987f;
+    state.batteryPercentage = 85;
+    state.hasWifiRSSI = true;
+    state.wifiRSSI = -61;
+    state.loopTimeSeconds = 6.23f;
+    state.lastLog = "Image displayed successfully";
+    state.lastLogSeverity = "info";
+    state.hasImageCRC32 = true;
+    state.imageCRC32 = 0x1A2B3C4D;
+    state.wifiBSSID = "AA:BB:CC:DD:EE:FF";
+    state.wifiSeconds = 1.5f;
+    state.wifiEarlySeconds = 0.42f;
+    state.ntpSeconds = 0.0f;
+    state.crcSeconds = 0.31f;
+    state.imageSeconds = 3.9f;
+    state.wifiRetries = 0;
+    state.crcRetries = 0;
+    state.imageRetries = 0;
+    state.tlsFullHandshakes = 0;
+    state.tlsResumedHandshakes = 2;
+    state.httpReusedConnections = 1;
+    state.cycleChargeMah = 0.183f;
+    state.batteryDaysRemaining = 212.0f;
+
+    // Wire size
+    std::vector<TopicMessage> perTopic = buildPerTopic(state);
+    size_t perTopicBytes = 0;
+    for (const TopicMessage& m : perTopic) {
+        perTopicBytes += publishPacketBytes(m.topic.size(), m.payload.size());
+    }
+    char buffer[TELEMETRY_PAYLOAD_SIZE];
+    size_t documentLength = serializeTelemetryState(state, buffer, sizeof(buffer));
+    std::string batchedTopic = std::string("homeassistant/sensor/") + DEVICE_ID + "/" + TELEMETRY_STATE_TOPIC;
+    size_t batchedBytes = publishPacketBytes(batchedTopic.size(), documentLength);
+
+    // Build time
+    size_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        state.wifiRSSI = -40 - (i & 31);
+        sink += serializeTelemetryState(state, buffer, sizeof(buffer));
+    }
+    double batchedNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        state.wifiRSSI = -40 - (i & 31);
+        sink += buildPerTopic(state).size();
+    }
+    double perTopicNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+    printf("Telemetry state payload, %d iterations\n\n", iterations);
+    printf("%-12s %8s %10s %12s %14s\n", "mode", "packets", "wire B", "payload B", "build ns/op");
+    printf("%-12s %8zu %10zu %12s %14.0f\n", "per-topic", perTopic.size(), perTopicBytes, "-", perTopicNs);
+    printf("%-12s %8d %10zu %12zu %14.0f\n", "batched", 1, batchedBytes, documentLength, batchedNs);
+    printf("\nDocument (%zu of %d bytes):\n%s\n", documentLength, TELEMETRY_PAYLOAD_SIZE, buffer);
+    return sink == 0 ? 1 : 0;
+}
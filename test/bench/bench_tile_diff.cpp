@@ -0,0 +1,129 @@
+/**
+ * Tile diff benchmark (host)
+ *
+ * Builds synthetic 1200x825 1-bit dashboards (header, clock, weather, chart
+ * and a table), applies typical update patterns and reports hashing time
+ * and the refresh decision with the share of the panel a partial refresh
+ * would drive.
+ *
+ * Not part of ctest - run manually:
+ *   ./test/build/tile_diff_bench [iterations]
+ */
+
+#include <tile_diff.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#define WIDTH 1200
+#define HEIGHT 825
+#define STRIDE (WIDTH / 8)
+
+static void fill(std::vector<uint8_t>& frame, int x, int y, int w, int h, bool black) {
+    for (int yy = y; yy < y + h && yy < HEIGHT; yy++) {
+        for (int xx = x; xx < x + w && xx < WIDTH; xx++) {
+            uint8_t mask = 0x80 >> (xx % 8);
+            if (black) {
+                frame[yy * STRIDE + xx / 8] |= mask;
+            } else {
+                frame[yy * STRIDE + xx / 8] &= ~mask;
+            }
+        }
+    }
+}
+
+// "Text": pseudo-random glyph-like strokes driven by a seed
+static void text(std::vector<uint8_t>& frame, int x, int y, int chars, unsigned seed) {
+    fill(frame, x, y, chars * 18, 28, false);
+    for (int c = 0; c < chars; c++) {
+        seed = seed * 1103515245u + 12345u;
+        fill(frame, x + c * 18 + 2, y + 2 + (seed >> 16) % 8, 3 + (seed >> 8) % 10, 16, true);
+    }
+}
+
+static std::vector<uint8_t> baseDashboard() {
+    std::vector<uint8_t> frame(STRIDE * HEIGHT, 0);
+    fill(frame, 0, 0, WIDTH, 60, true);           // Header bar
+    text(frame, 40, 200, 5, 1);                   // Clock
+    text(frame, 700, 200, 12, 2);                 // Weather
+    for (int i = 0; i < 24; i++) {                // Chart
+        fill(frame, 60 + i * 45, 700 - i * 10, 30, 100 + i * 10, true);
+    }
+    for (int r = 0; r < 6; r++) {                 // Table
+        text(frame, 60, 320 + r * 40, 30, 10 + r);
+    }
+    return frame;
+}
+
+struct Scenario {
+    const char* name;
+    void (*apply)(std::vector<uint8_t>&);
+};
+
+static void noChange(std::vector<uint8_t>&) {}
+static void clockTick(std::vector<uint8_t>& f) { text(f, 40, 200, 5, 99); }
+static void clockAndWeather(std::vector<uint8_t>& f) { text(f, 40, 200, 5, 99); text(f, 700, 200, 12, 77); }
+static void tableRow(std::vector<uint8_t>& f) { text(f, 60, 360, 30, 55); }
+static void newChart(std::vector<uint8_t>& f) {
+    fill(f, 0, 450, WIDTH, 375, false);
+    for (int i = 0; i < 24; i++) {
+        fill(f, 60 + i * 45, 500 + (i * 37) % 200, 30, 300 - (i * 37) % 200, true);
+    }
+}
+static void newPage(std::vector<uint8_t>& f) {
+    for (size_t i = 0; i < f.size(); i++) {
+        f[i] = (uint8_t)(f[i] ^ (i * 31));
+    }
+}
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 200;
+    if (iterations < 1) {
+        iterations = 1;
+    }
+
+    std::vector<uint8_t> base = baseDashboard();
+    TileHashGrid previous;
+    computeTileHashes(base.data(), STRIDE, WIDTH, HEIGHT, 1, previous);
+
+    const Scenario scenarios[] = {
+        {"unchanged", noChange},
+        {"clock", clockTick},
+        {"clock+weather", clockAndWeather},
+        {"table row", tableRow},
+        {"new chart", newChart},
+        {"new page", newPage},
+    };
+
+    printf("%dx%d 1-bit, %dx%d tiles, %d iterations\n\n", WIDTH, HEIGHT, TILE_SIZE, TILE_SIZE, iterations);
+    for (const Scenario& s : scenarios) {
+        std::vector<uint8_t> frame = base;
+        s.apply(frame);
+
+        TileHashGrid current;
+        TileDiff diff;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            computeTileHashes(frame.data(), STRIDE, WIDTH, HEIGHT, 1, current);
+            diffTileHashes(previous, current, diff);
+        }
+        double perFrame = std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - start).count() / iterations;
+
+        uint32_t area = 0;
+        for (uint8_t r = 0; r < diff.regionCount; r++) {
+            area += (uint32_t)diff.regions[r].width * diff.regions[r].height;
+        }
+        RefreshDecision decision = decideRefresh(previous, diff, 10);
+        const char* kind = decision.kind == REFRESH_NONE ? "none"
+                         : decision.kind == REFRESH_PARTIAL ? "partial" : "full";
+        printf("%-14s %7.1f us  %4u/%u tiles  %2u regions  %5.1f%% area  -> %s\n",
+               s.name, perFrame, diff.changedTiles, diff.totalTiles, diff.regionCount,
+               100.0 * area / (WIDTH * HEIGHT), kind);
+    }
+    printf("\nA partial refresh drives only the listed area without the full-panel flash;\n"
+           "\"none\" skips the panel update entirely.\n");
+    return 0;
+}
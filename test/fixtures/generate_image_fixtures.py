@@ -0,0 +1,366 @@
+#!/usr/bin/env python3
+"""
+Generate PNG fixtures and golden outputs for the image pipeline tests.
+
+Uses only the Python standard library (zlib + struct) so the fixtures can be
+regenerated anywhere. Each PNG gets a matching .pgm holding the expected
+8-bit grayscale decode, computed here from the source pixels with the same
+formulas as common/src/image_decoder.h (Inkplate luminance weights, alpha
+composited onto white).
+
+The sink goldens (sink_*.pgm, maxval = number of levels - 1) are produced by
+a reference Floyd-Steinberg implementation mirroring FramebufferSink. The IKFB
+fixtures (ikfb_*.ikfb) are those same levels packed in the native format, so
+they share the sink goldens.
+
+JPEG fixtures are produced separately by make_jpeg_fixtures.c (needs libjpeg
+and libpng) because they must be encoded/decoded by libjpeg itself.
+
+Usage:
+    python3 test/fixtures/generate_image_fixtures.py
+"""
+
+import os
+import struct
+import zlib
+
+OUT_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "images")
+
+
+# ---------------------------------------------------------------------------
+# Reference pixel math (must match image_decoder.h)
+# ---------------------------------------------------------------------------
+
+def rgb_to_gray(r, g, b):
+    return (54 * r + 183 * g + 19 * b) >> 8
+
+
+def composite_on_white(gray, alpha):
+    return (gray * alpha + 255 * (255 - alpha) + 127) // 255
+
+
+def c_div(a, b):
+    """Integer division truncating toward zero, like C."""
+    q = abs(a) // b
+    return q if a >= 0 else -q
+
+
+def quantize(gray_rows, width, max_level, dither):
+    """Mirror of FramebufferSink::writeRow."""
+    out = []
+    cur = [0] * (width + 2)
+    nxt = [0] * (width + 2)
+    for row in gray_rows:
+        levels = []
+        for x in range(width):
+            if dither:
+                value = row[x] + cur[x + 1]
+                value = max(0, min(255, value))
+                level = (value * max_level + 127) // 255
+                error = value - level * 255 // max_level
+                cur[x + 2] += c_div(error * 7, 16)
+                nxt[x] += c_div(error * 3, 16)
+                nxt[x + 1] += c_div(error * 5, 16)
+                nxt[x + 2] += c_div(error, 16)
+            else:
+                level = (row[x] * max_level + 127) // 255
+            levels.append(level)
+        if dither:
+            cur, nxt = nxt, [0] * (width + 2)
+        out.append(levels)
+    return out
+
+
+# ---------------------------------------------------------------------------
+# PNG writer
+# ---------------------------------------------------------------------------
+
+def chunk(kind, data):
+    body = kind + data
+    return struct.pack(">I", len(data)) + body + struct.pack(">I", zlib.crc32(body) & 0xFFFFFFFF)
+
+
+def paeth(a, b, c):
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+
+def filter_row(ftype, row, prev, bpp):
+    out = bytearray(len(row))
+    for i in range(len(row)):
+        a = row[i - bpp] if i >= bpp else 0
+        b = prev[i]
+        c = prev[i - bpp] if i >= bpp else 0
+        if ftype == 0:
+            pred = 0
+        elif ftype == 1:
+            pred = a
+        elif ftype == 2:
+            pred = b
+        elif ftype == 3:
+            pred = (a + b) >> 1
+        else:
+            pred = paeth(a, b, c)
+        out[i] = (row[i] - pred) & 0xFF
+    return bytes([ftype]) + bytes(out)
+
+
+def write_png(name, width, height, bit_depth, color_type, rows, filters=None,
+              level=9, strategy=zlib.Z_DEFAULT_STRATEGY, idat_size=None,
+              extra_chunks=(), interlace=0):
+    """rows: list of packed scanline bytes (without filter byte)."""
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color_type]
+    bpp = max(1, channels * bit_depth // 8)
+    raw = bytearray()
+    prev = bytes(len(rows[0]))
+    for y, row in enumerate(rows):
+        ftype = filters[y % len(filters)] if filters else 0
+        raw += filter_row(ftype, row, prev, bpp)
+        prev = row
+
+    comp = zlib.compressobj(level, zlib.DEFLATED, 15, 9, strategy)
+    data = comp.compress(bytes(raw)) + comp.flush()
+
+    png = b"\x89PNG\r\n\x1a\n"
+    png += chunk(b"IHDR", struct.pack(">IIBBBBB", width, height, bit_depth, color_type, 0, 0, interlace))
+    for kind, payload in extra_chunks:
+        png += chunk(kind, payload)
+    step = idat_size or len(data)
+    for i in range(0, len(data), step):
+        png += chunk(b"IDAT", data[i:i + step])
+    png += chunk(b"IEND", b"")
+
+    with open(os.path.join(OUT_DIR, name), "wb") as f:
+        f.write(png)
+
+
+def write_pgm(name, width, height, rows, maxval=255):
+    with open(os.path.join(OUT_DIR, name), "wb") as f:
+        f.write(b"P5\n%d %d\n%d\n" % (width, height, maxval))
+        for row in rows:
+            f.write(bytes(row))
+
+
+def pack_bits(values, depth):
+    out = bytearray()
+    acc = 0
+    nbits = 0
+    for v in values:
+        acc = (acc << depth) | v
+        nbits += depth
+        if nbits == 8:
+            out.append(acc)
+            acc = 0
+            nbits = 0
+    if nbits:
+        out.append(acc << (8 - nbits))
+    return bytes(out)
+
+
+# ---------------------------------------------------------------------------
+# IKFB writer (see common/src/ikfb_decoder.h and scripts/png_to_ikfb.py)
+# ---------------------------------------------------------------------------
+
+IKFB_DEPTH = {1: 1, 2: 2, 3: 4}  # pixel format -> packed bits per pixel
+
+
+def packbits(data):
+    out = bytearray()
+    i = 0
+    n = len(data)
+    while i < n:
+        run = 1
+        while i + run < n and run < 128 and data[i + run] == data[i]:
+            run += 1
+        if run >= 3:
+            out += bytes([257 - run, data[i]])
+            i += run
+            continue
+        start = i
+        i += 1
+        while i < n and i - start < 128 and not (i + 2 < n and data[i] == data[i + 1] == data[i + 2]):
+            i += 1
+        out.append(i - start - 1)
+        out += data[start:i]
+    return bytes(out)
+
+
+def write_ikfb(name, width, height, pixel_format, level_rows, rle, rotation=0):
+    packed = b"".join(pack_bits(r, IKFB_DEPTH[pixel_format]) for r in level_rows)
+    header = b"IKFB" + struct.pack("<BBBBHHI", 1, pixel_format, 1 if rle else 0, rotation, width, height, 0)
+    with open(os.path.join(OUT_DIR, name), "wb") as f:
+        f.write(header + (packbits(packed) if rle else packed))
+
+
+# ---------------------------------------------------------------------------
+# Source patterns
+# ---------------------------------------------------------------------------
+
+def pattern_rgb(x, y, w, h):
+    r = (x * 255) // max(1, w - 1)
+    g = (y * 255) // max(1, h - 1)
+    b = ((x ^ y) * 37) & 0xFF
+    return r, g, b
+
+
+def pattern_gray(x, y, w, h):
+    value = (x * 4 + y * 3) & 0xFF
+    if (x // 8 + y // 8) % 2:
+        value = 255 - value
+    return value
+
+
+def dashboard_gray(x, y, w, h):
+    """Synthetic dashboard: header bar, text-like strokes, a gradient chart."""
+    if y < 80:
+        return 40
+    if y > h - 40:
+        return 230
+    if 120 <= y < 420 and 60 <= x < 560:
+        # "Text" lines: short dark strokes on white
+        line = (y - 120) // 30
+        if (y - 120) % 30 < 14 and ((x - 60) // 9 + line * 3) % 7 != 0:
+            return 20 if (x + line) % 9 < 6 else 255
+        return 255
+    if 120 <= y < 700 and 640 <= x < 1140:
+        # Bar chart with gradient bars
+        bar = (x - 640) // 50
+        top = 700 - ((bar * 53) % 480 + 60)
+        if (x - 640) % 50 < 36 and y >= top:
+            return 60 + ((y - top) * 120) // max(1, 700 - top)
+        return 250 if (y // 40) % 2 else 240
+    if 460 <= y < 700 and 60 <= x < 560:
+        # Photo-like region: gradient plus deterministic grain
+        grain = ((x * 1103515245 + y * 12345) >> 7) & 31
+        return 96 + ((x * 7 + y * 5) % 200) // 2 + grain
+    return 255
+
+
+# ---------------------------------------------------------------------------
+# Fixtures
+# ---------------------------------------------------------------------------
+
+def gen_gray8_filters():
+    w, h = 64, 48
+    gray = [[pattern_gray(x, y, w, h) for x in range(w)] for y in range(h)]
+    rows = [bytes(r) for r in gray]
+    # All five filter types, split over many small IDAT chunks
+    write_png("png_gray8_filters.png", w, h, 8, 0, rows, filters=[0, 1, 2, 3, 4], idat_size=100)
+    write_pgm("png_gray8_filters.pgm", w, h, gray)
+
+    write_pgm("sink_gray8_3bit_dither.pgm", w, h, quantize(gray, w, 7, True), 7)
+    write_pgm("sink_gray8_3bit_nodither.pgm", w, h, quantize(gray, w, 7, False), 7)
+    write_pgm("sink_gray8_1bit_dither.pgm", w, h, quantize(gray, w, 1, True), 1)
+
+    write_ikfb("ikfb_3bit_rle.ikfb", w, h, 3, quantize(gray, w, 7, True), True)
+    write_ikfb("ikfb_1bit_raw.ikfb", w, h, 1, quantize(gray, w, 1, True), False)
+
+
+def gen_ikfb_tricolor():
+    # Odd width: the last byte of each row is padded
+    w, h = 45, 30
+    levels = [[2 if (x // 5 + y // 6) % 3 == 0 else (x + y) % 2 for x in range(w)] for y in range(h)]
+    write_ikfb("ikfb_tricolor_rle.ikfb", w, h, 2, levels, True)
+    write_pgm("ikfb_tricolor.pgm", w, h, levels, 2)
+
+
+def gen_rgb8(name, level, strategy):
+    w, h = 45, 30
+    px = [[pattern_rgb(x, y, w, h) for x in range(w)] for y in range(h)]
+    rows = [bytes(c for p in r for c in p) for r in px]
+    write_png(name + ".png", w, h, 8, 2, rows, filters=[4, 1, 0, 3, 2], level=level, strategy=strategy)
+    write_pgm(name + ".pgm", w, h, [[rgb_to_gray(*p) for p in r] for r in px])
+
+
+def gen_palette4_trns():
+    w, h = 37, 21
+    palette = [((i * 16) & 0xFF, (255 - i * 16) & 0xFF, (i * 40) & 0xFF) for i in range(16)]
+    alpha = [255 - i * 17 for i in range(16)]
+    idx = [[(x // 3 + y) % 16 for x in range(w)] for y in range(h)]
+    rows = [pack_bits(r, 4) for r in idx]
+    plte = bytes(c for p in palette for c in p)
+    write_png("png_palette4_trns.png", w, h, 4, 3, rows, filters=[0, 1, 2],
+              extra_chunks=[(b"PLTE", plte), (b"tRNS", bytes(alpha))])
+    gray = [[composite_on_white(rgb_to_gray(*palette[i]), alpha[i]) for i in r] for r in idx]
+    write_pgm("png_palette4_trns.pgm", w, h, gray)
+
+
+def gen_gray1():
+    w, h = 37, 21
+    bits = [[1 if (x * x + y * 3) % 5 < 2 else 0 for x in range(w)] for y in range(h)]
+    rows = [pack_bits(r, 1) for r in bits]
+    write_png("png_gray1.png", w, h, 1, 0, rows, filters=[0, 2])
+    write_pgm("png_gray1.pgm", w, h, [[255 * v for v in r] for r in bits])
+
+
+def gen_graya8():
+    w, h = 40, 20
+    px = [[(pattern_gray(x, y, w, h), (x * 255) // (w - 1)) for x in range(w)] for y in range(h)]
+    rows = [bytes(c for p in r for c in p) for r in px]
+    write_png("png_graya8.png", w, h, 8, 4, rows, filters=[1, 3, 4])
+    write_pgm("png_graya8.pgm", w, h, [[composite_on_white(g, a) for g, a in r] for r in px])
+
+
+def gen_rgba16():
+    w, h = 33, 17
+    px = []
+    for y in range(h):
+        row = []
+        for x in range(w):
+            r, g, b = pattern_rgb(x, y, w, h)
+            a = (y * 255) // (h - 1)
+            # Low bytes carry noise that must not affect the result
+            row.append(((r << 8) | (x & 0xFF), (g << 8) | 0x5A, (b << 8) | 0xA5, (a << 8) | 0x33))
+        px.append(row)
+    rows = [b"".join(struct.pack(">HHHH", *p) for p in r) for r in px]
+    write_png("png_rgba16.png", w, h, 16, 6, rows, filters=[2, 4, 1])
+    gray = [[composite_on_white(rgb_to_gray(p[0] >> 8, p[1] >> 8, p[2] >> 8), p[3] >> 8) for p in r] for r in px]
+    write_pgm("png_rgba16.pgm", w, h, gray)
+
+
+def gen_gray16_key():
+    w, h = 20, 12
+    key = 0x1234
+    px = [[key if (x + y) % 4 == 0 else ((x * 3000 + y * 700) & 0xFFFF) for x in range(w)] for y in range(h)]
+    rows = [b"".join(struct.pack(">H", v) for v in r) for r in px]
+    write_png("png_gray16_key.png", w, h, 16, 0, rows, filters=[3],
+              extra_chunks=[(b"tRNS", struct.pack(">H", key))])
+    write_pgm("png_gray16_key.pgm", w, h, [[255 if v == key else v >> 8 for v in r] for r in px])
+
+
+def gen_interlaced():
+    w, h = 16, 16
+    rows = [bytes(w) for _ in range(h)]
+    write_png("png_interlaced.png", w, h, 8, 0, rows, interlace=1)
+
+
+def gen_dashboard():
+    w, h = 1200, 820
+    gray = [[dashboard_gray(x, y, w, h) for x in range(w)] for y in range(h)]
+    rows = [bytes(r) for r in gray]
+    write_png("dashboard.png", w, h, 8, 0, rows, filters=[4])
+    write_ikfb("dashboard.ikfb", w, h, 3, quantize(gray, w, 7, True), True)
+    write_ikfb("dashboard_1bit.ikfb", w, h, 1, quantize(gray, w, 1, True), True)
+
+
+def main():
+    os.makedirs(OUT_DIR, exist_ok=True)
+    gen_gray8_filters()
+    gen_ikfb_tricolor()
+    gen_rgb8("png_rgb8_stored", 0, zlib.Z_DEFAULT_STRATEGY)
+    gen_rgb8("png_rgb8_fixed", 9, zlib.Z_FIXED)
+    gen_palette4_trns()
+    gen_gray1()
+    gen_graya8()
+    gen_rgba16()
+    gen_gray16_key()
+    gen_interlaced()
+    gen_dashboard()
+    print("Fixtures written to", OUT_DIR)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,198 @@
+/*
+ * Generate JPEG fixtures and libjpeg golden outputs for the image pipeline tests.
+ *
+ * Every fixture is encoded with libjpeg and decoded again by libjpeg to an
+ * 8-bit grayscale PGM (JDCT_ISLOW), which JpegStreamDecoder must reproduce
+ * exactly. dashboard.jpg (benchmark input, no golden) is re-encoded from
+ * dashboard.png, so run generate_image_fixtures.py first.
+ *
+ * Not part of the CMake build (needs libjpeg and libpng development files):
+ *   cc -O2 -o /tmp/make_jpeg_fixtures test/fixtures/make_jpeg_fixtures.c -ljpeg -lpng
+ *   /tmp/make_jpeg_fixtures test/fixtures/images
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <jpeglib.h>
+#include <png.h>
+
+#define W 61
+#define H 45
+
+static char g_dir[1024];
+
+static const char* path(const char* name) {
+    static char buf[2048];
+    snprintf(buf, sizeof(buf), "%s/%s", g_dir, name);
+    return buf;
+}
+
+/* Same pattern as pattern_rgb() in generate_image_fixtures.py */
+static void make_pattern(unsigned char* rgb) {
+    for (int y = 0; y < H; y++) {
+        for (int x = 0; x < W; x++) {
+            unsigned char* p = rgb + 3 * (y * W + x);
+            p[0] = (unsigned char)((x * 255) / (W - 1));
+            p[1] = (unsigned char)((y * 255) / (H - 1));
+            p[2] = (unsigned char)(((x ^ y) * 37) & 0xFF);
+        }
+    }
+}
+
+typedef struct {
+    int gray_input;
+    int h0, v0;             /* Luminance sampling factors */
+    int restart_interval;   /* In MCUs, 0 = none */
+    int non_interleaved;    /* One scan per component */
+    int progressive;
+    int quality;
+} EncodeOptions;
+
+static void encode(const char* name, const unsigned char* pixels, int w, int h, EncodeOptions opt) {
+    static jpeg_scan_info scans[3] = {
+        { 1, { 0 }, 0, 63, 0, 0 },
+        { 1, { 1 }, 0, 63, 0, 0 },
+        { 1, { 2 }, 0, 63, 0, 0 },
+    };
+    struct jpeg_compress_struct cinfo;
+    struct jpeg_error_mgr jerr;
+    FILE* f = fopen(path(name), "wb");
+    if (!f) { perror(name); exit(1); }
+
+    cinfo.err = jpeg_std_error(&jerr);
+    jpeg_create_compress(&cinfo);
+    jpeg_stdio_dest(&cinfo, f);
+    cinfo.image_width = w;
+    cinfo.image_height = h;
+    cinfo.input_components = opt.gray_input ? 1 : 3;
+    cinfo.in_color_space = opt.gray_input ? JCS_GRAYSCALE : JCS_RGB;
+    jpeg_set_defaults(&cinfo);
+    jpeg_set_quality(&cinfo, opt.quality, TRUE);
+    if (!opt.gray_input) {
+        cinfo.comp_info[0].h_samp_factor = opt.h0;
+        cinfo.comp_info[0].v_samp_factor = opt.v0;
+    }
+    cinfo.restart_interval = opt.restart_interval;
+    if (opt.non_interleaved) {
+        cinfo.scan_info = scans;
+        cinfo.num_scans = 3;
+    }
+    if (opt.progressive) {
+        jpeg_simple_progression(&cinfo);
+    }
+
+    jpeg_start_compress(&cinfo, TRUE);
+    int stride = w * cinfo.input_components;
+    while (cinfo.next_scanline < cinfo.image_height) {
+        JSAMPROW row = (JSAMPROW)(pixels + cinfo.next_scanline * stride);
+        jpeg_write_scanlines(&cinfo, &row, 1);
+    }
+    jpeg_finish_compress(&cinfo);
+    jpeg_destroy_compress(&cinfo);
+    fclose(f);
+}
+
+/* Decode with libjpeg to grayscale and write <name>.pgm next to it */
+static void golden(const char* name) {
+    struct jpeg_decompress_struct cinfo;
+    struct jpeg_error_mgr jerr;
+    FILE* f = fopen(path(name), "rb");
+    if (!f) { perror(name); exit(1); }
+
+    cinfo.err = jpeg_std_error(&jerr);
+    jpeg_create_decompress(&cinfo);
+    jpeg_stdio_src(&cinfo, f);
+    jpeg_read_header(&cinfo, TRUE);
+    cinfo.out_color_space = JCS_GRAYSCALE;
+    cinfo.dct_method = JDCT_ISLOW;
+    jpeg_start_decompress(&cinfo);
+
+    char out[1024];
+    snprintf(out, sizeof(out), "%s", name);
+    strcpy(strrchr(out, '.'), ".pgm");
+    FILE* o = fopen(path(out), "wb");
+    fprintf(o, "P5\n%u %u\n255\n", cinfo.output_width, cinfo.output_height);
+    unsigned char* row = malloc(cinfo.output_width);
+    while (cinfo.output_scanline < cinfo.output_height) {
+        jpeg_read_scanlines(&cinfo, &row, 1);
+        fwrite(row, 1, cinfo.output_width, o);
+    }
+    free(row);
+    fclose(o);
+    jpeg_finish_decompress(&cinfo);
+    jpeg_destroy_decompress(&cinfo);
+    fclose(f);
+}
+
+static unsigned char* read_png_rgb(const char* name, int* w, int* h) {
+    png_image image;
+    memset(&image, 0, sizeof(image));
+    image.version = PNG_IMAGE_VERSION;
+    if (!png_image_begin_read_from_file(&image, path(name))) {
+        fprintf(stderr, "%s: %s\n", name, image.message);
+        exit(1);
+    }
+    image.format = PNG_FORMAT_RGB;
+    unsigned char* buf = malloc(PNG_IMAGE_SIZE(image));
+    png_image_finish_read(&image, NULL, buf, 0, NULL);
+    *w = image.width;
+    *h = image.height;
+    return buf;
+}
+
+int main(int argc, char** argv) {
+    snprintf(g_dir, sizeof(g_dir), "%s", argc > 1 ? argv[1] : ".");
+
+    unsigned char rgb[W * H * 3];
+    unsigned char gray[W * H];
+    make_pattern(rgb);
+    for (int i = 0; i < W * H; i++) {
+        gray[i] = (unsigned char)((54 * rgb[3 * i] + 183 * rgb[3 * i + 1] + 19 * rgb[3 * i + 2]) >> 8);
+    }
+
+    EncodeOptions base = { 0, 1, 1, 0, 0, 0, 85 };
+
+    EncodeOptions o444 = base;
+    encode("jpeg_444.jpg", rgb, W, H, o444);
+    golden("jpeg_444.jpg");
+
+    EncodeOptions o420 = base;
+    o420.h0 = 2; o420.v0 = 2;
+    encode("jpeg_420.jpg", rgb, W, H, o420);
+    golden("jpeg_420.jpg");
+
+    EncodeOptions o422 = base;
+    o422.h0 = 2; o422.v0 = 1;
+    encode("jpeg_422.jpg", rgb, W, H, o422);
+    golden("jpeg_422.jpg");
+
+    EncodeOptions ogray = base;
+    ogray.gray_input = 1;
+    encode("jpeg_gray.jpg", gray, W, H, ogray);
+    golden("jpeg_gray.jpg");
+
+    EncodeOptions orst = o420;
+    orst.restart_interval = 3;
+    encode("jpeg_420_restart.jpg", rgb, W, H, orst);
+    golden("jpeg_420_restart.jpg");
+
+    EncodeOptions oni = o420;
+    oni.non_interleaved = 1;
+    encode("jpeg_noninterleaved.jpg", rgb, W, H, oni);
+    golden("jpeg_noninterleaved.jpg");
+
+    EncodeOptions oprog = o420;
+    oprog.progressive = 1;
+    encode("jpeg_progressive.jpg", rgb, W, H, oprog);
+
+    int dw, dh;
+    unsigned char* dash = read_png_rgb("dashboard.png", &dw, &dh);
+    EncodeOptions odash = o420;
+    odash.quality = 90;
+    encode("dashboard.jpg", dash, dw, dh, odash);
+    free(dash);
+
+    printf("JPEG fixtures written to %s\n", g_dir);
+    return 0;
+}
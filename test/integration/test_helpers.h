@@ -76,6 +76,15 @@ public:
         return *this;
     }
     
+    /**
+     * Enable change detection using HTTP conditional GET (ETag / Last-Modified)
+     */
+    ConfigBuilder& withConditionalGet() {
+        config.useCRC32Check = true;
+        config.changeDetection = CHANGE_DETECTION_HTTP;
+        return *this;
+    }
+    
     /**
      * Configure hourly schedule (inclusive range)
      * @param startHour Start hour (0-23)
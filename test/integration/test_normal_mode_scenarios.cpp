@@ -1255,6 +1255,240 @@ TEST_F(NormalModeIntegrationTest, EndToEnd_AllHoursEnabled_NoScheduleConstraint)
     EXPECT_EQ(calculateSleepMinutesToNextEnabledHour(time2, 0, config.updateHours), -1.0f);
 }
 
+// =============================================================================
+// HTTP CONDITIONAL GET SCENARIOS
+// =============================================================================
+// Conditional GET replaces the .crc32 sidecar request: stored validators are
+// sent with the image request itself, 304 means "unchanged" (skip + sleep) and
+// 200 streams the new image. The decision rules are the same as for CRC32.
+
+// Single image + timer wake + 304 → skip display, sleep interval
+TEST_F(NormalModeIntegrationTest, ConditionalGet_SingleImage_TimerWake_NotModified_Skips) {
+    // GIVEN: Single image with HTTP validator change detection
+    DashboardConfig config = ConfigBuilder()
+        .singleImage("http://example.com/image.png", 15)
+        .withConditionalGet()
+        .build();
+    time_t currentTime = createTime(2025, 11, 15, 14, 30, 0);
+    
+    // WHEN: Timer wake
+    NormalModeDecisions decisions = orchestrateNormalModeDecisions(config, WAKEUP_TIMER, 0);
+    bool notModified = true;  // Server answered 304
+    auto sleepDuration = determineSleepDuration(config, currentTime, decisions.finalIndex, notModified);
+    
+    // THEN: Validators are sent, 304 is treated like a CRC32 match
+    EXPECT_EQ(decisions.crc32Action.strategy, CHANGE_STRATEGY_CONDITIONAL_GET);
+    EXPECT_TRUE(decisions.crc32Action.shouldCheck);
+    EXPECT_EQ(sleepDuration.sleepSeconds, 15.0f * 60.0f);
+    EXPECT_STREQ(sleepDuration.reason, "Image interval (CRC32 matched)");
+}
+
+// Single image + timer wake + 200 → display new image, sleep interval
+TEST_F(NormalModeIntegrationTest, ConditionalGet_SingleImage_TimerWake_Modified_Displays) {
+    DashboardConfig config = ConfigBuilder()
+        .singleImage("http://example.com/image.png", 15)
+        .withConditionalGet()
+        .build();
+    time_t currentTime = createTime(2025, 11, 15, 14, 30, 0);
+    
+    NormalModeDecisions decisions = orchestrateNormalModeDecisions(config, WAKEUP_TIMER, 0);
+    bool notModified = false;  // Server answered 200 with new validators
+    auto sleepDuration = determineSleepDuration(config, currentTime, decisions.finalIndex, notModified);
+    
+    EXPECT_TRUE(decisions.crc32Action.shouldCheck);
+    EXPECT_EQ(sleepDuration.sleepSeconds, 15.0f * 60.0f);
+    EXPECT_STREQ(sleepDuration.reason, "Image interval (image updated)");
+}
+
+// Single image + button wake → unconditional request (validators collected, never 304)
+TEST_F(NormalModeIntegrationTest, ConditionalGet_SingleImage_ButtonWake_AlwaysDownloads) {
+    DashboardConfig config = ConfigBuilder()
+        .singleImage("http://example.com/image.png", 15)
+        .withConditionalGet()
+        .build();
+    
+    NormalModeDecisions decisions = orchestrateNormalModeDecisions(config, WAKEUP_BUTTON, 0);
+    
+    EXPECT_EQ(decisions.crc32Action.strategy, CHANGE_STRATEGY_CONDITIONAL_GET);
+    EXPECT_FALSE(decisions.crc32Action.shouldCheck);
+    EXPECT_STREQ(decisions.crc32Action.reason, "Single image - button press (always download)");
+}
+
+// Carousel: only stay:true images on timer wake send validators
+TEST_F(NormalModeIntegrationTest, ConditionalGet_Carousel_MixedStay_ChecksOnlyStayTrue) {
+    DashboardConfig config = ConfigBuilder()
+        .carousel()
+        .addImage("http://example.com/img1.png", 10, false)
+        .addImage("http://example.com/img2.png", 15, true)
+        .addImage("http://example.com/img3.png", 20, false)
+        .withConditionalGet()
+        .build();
+    
+    // Image 1 (stay:false) → advance to image 2, unconditional download
+    NormalModeDecisions d0 = orchestrateNormalModeDecisions(config, WAKEUP_TIMER, 0);
+    EXPECT_EQ(d0.finalIndex, 1);
+    EXPECT_FALSE(d0.crc32Action.shouldCheck);
+    
+    // Image 2 (stay:true) → stay, conditional request for the same slot
+    NormalModeDecisions d1 = orchestrateNormalModeDecisions(config, WAKEUP_TIMER, 1);
+    EXPECT_EQ(d1.finalIndex, 1);
+    EXPECT_EQ(d1.indexForCRC32, d1.finalIndex) << "Validators must belong to the displayed slot";
+    EXPECT_TRUE(d1.crc32Action.shouldCheck);
+    EXPECT_EQ(d1.crc32Action.strategy, CHANGE_STRATEGY_CONDITIONAL_GET);
+    
+    // Button wake on stay:true → advance, unconditional download
+    NormalModeDecisions d2 = orchestrateNormalModeDecisions(config, WAKEUP_BUTTON, 1);
+    EXPECT_EQ(d2.finalIndex, 2);
+    EXPECT_FALSE(d2.crc32Action.shouldCheck);
+}
+
+// CRC32 sidecar remains the default method when change detection is enabled
+TEST_F(NormalModeIntegrationTest, ConditionalGet_DefaultMethodIsCRC32) {
+    DashboardConfig config = ConfigBuilder()
+        .singleImage("http://example.com/image.png", 15)
+        .withCRC32(true)
+        .build();
+    
+    NormalModeDecisions decisions = orchestrateNormalModeDecisions(config, WAKEUP_TIMER, 0);
+    
+    EXPECT_EQ(decisions.crc32Action.strategy, CHANGE_STRATEGY_CRC32);
+    EXPECT_TRUE(decisions.crc32Action.shouldCheck);
+}
+
+// =============================================================================
+// PER-SLOT CHANGE DETECTION SCENARIOS
+// =============================================================================
+// Each carousel slot keeps the CRC32 of the image it last showed, and the
+// table remembers which slot is on the panel. These tests drive several
+// wakes through orchestrateNormalModeDecisions() with the real slot table,
+// mirroring what NormalModeController does after each cycle.
+
+// Simulate one normal-mode cycle; returns true if the download was skipped
+static bool runCycle(const DashboardConfig& config, ImageSlotTable& table, uint8_t& stateIndex,
+                     WakeupReason wakeReason, const uint32_t serverCRC32[]) {
+    uint8_t currentIndex = stateIndex % config.imageCount;
+    NormalModeDecisions decisions = orchestrateNormalModeDecisions(config, wakeReason, currentIndex, table.displayedSlot);
+    if (decisions.imageTarget.shouldAdvance) {
+        stateIndex = decisions.finalIndex;
+    }
+    uint8_t target = decisions.finalIndex;
+    
+    bool matched = isSlotUnchanged(table, target, serverCRC32[target]);
+    if (decisions.unchangedSkip.allowSkip && matched) {
+        return true;
+    }
+    recordSlotDisplayed(table, target, serverCRC32[target]);
+    return false;
+}
+
+TEST_F(NormalModeIntegrationTest, SlotTable_StayTrueSlot_SkipsWhileUnchanged) {
+    // GIVEN: 3-image carousel, image 2 stays (e.g. a dashboard that refreshes in place)
+    DashboardConfig config = ConfigBuilder()
+        .carousel()
+        .addImage("http://example.com/img1.png", 5, false)
+        .addImage("http://example.com/img2.png", 5, true)
+        .addImage("http://example.com/img3.png", 5, false)
+        .withCRC32(true)
+        .build();
+    ImageSlotTable table;
+    initImageSlotTable(table);
+    uint8_t stateIndex = 0;
+    uint32_t server[3] = {0x11111111, 0x22222222, 0x33333333};
+    
+    // WHEN/THEN: first wake advances to image 2 and downloads it
+    EXPECT_FALSE(runCycle(config, table, stateIndex, WAKEUP_TIMER, server));
+    EXPECT_EQ(stateIndex, 1);
+    
+    // Following timer wakes stay on image 2 and skip while unchanged
+    EXPECT_TRUE(runCycle(config, table, stateIndex, WAKEUP_TIMER, server));
+    EXPECT_TRUE(runCycle(config, table, stateIndex, WAKEUP_TIMER, server));
+    
+    // Content changes on the server → download once, then skip again
+    server[1] = 0x22220000;
+    EXPECT_FALSE(runCycle(config, table, stateIndex, WAKEUP_TIMER, server));
+    EXPECT_TRUE(runCycle(config, table, stateIndex, WAKEUP_TIMER, server));
+}
+
+TEST_F(NormalModeIntegrationTest, SlotTable_AdvanceKeepsOtherSlotsCRC32) {
+    // GIVEN: Two stay:true images, button moves between them
+    DashboardConfig config = ConfigBuilder()
+        .carousel()
+        .addImage("http://example.com/img1.png", 5, true)
+        .addImage("http://example.com/img2.png", 5, true)
+        .withCRC32(true)
+        .build();
+    ImageSlotTable table;
+    initImageSlotTable(table);
+    uint8_t stateIndex = 0;
+    uint32_t server[2] = {0xAAAAAAAA, 0xBBBBBBBB};
+    
+    // Show image 1, then button to image 2, then button back to image 1
+    EXPECT_FALSE(runCycle(config, table, stateIndex, WAKEUP_TIMER, server));
+    EXPECT_FALSE(runCycle(config, table, stateIndex, WAKEUP_BUTTON, server));
+    EXPECT_FALSE(runCycle(config, table, stateIndex, WAKEUP_BUTTON, server));
+    EXPECT_EQ(stateIndex, 0);
+    
+    // THEN: Both slots remember their CRC32 - timer wake on image 1 skips
+    // immediately (a single shared CRC32 would have been overwritten by image 2)
+    EXPECT_TRUE(isSlotUnchanged(table, 1, 0xBBBBBBBB));
+    EXPECT_TRUE(runCycle(config, table, stateIndex, WAKEUP_TIMER, server));
+}
+
+TEST_F(NormalModeIntegrationTest, SlotTable_AutoAdvance_NeverSkipsEvenIfUnchanged) {
+    // GIVEN: All images auto-advance - the target is never what is on screen
+    DashboardConfig config = ConfigBuilder()
+        .carousel()
+        .addImage("http://example.com/img1.png", 5, false)
+        .addImage("http://example.com/img2.png", 5, false)
+        .withCRC32(true)
+        .build();
+    ImageSlotTable table;
+    initImageSlotTable(table);
+    uint8_t stateIndex = 0;
+    uint32_t server[2] = {0x01010101, 0x02020202};
+    
+    // WHEN/THEN: Every wake downloads, otherwise the panel would keep the wrong image
+    for (int wake = 0; wake < 4; wake++) {
+        EXPECT_FALSE(runCycle(config, table, stateIndex, WAKEUP_TIMER, server)) << "wake " << wake;
+    }
+}
+
+TEST_F(NormalModeIntegrationTest, SlotTable_ScreenReplaced_ForcesDownload) {
+    // GIVEN: Single image shown and unchanged
+    DashboardConfig config = ConfigBuilder()
+        .singleImage("http://example.com/image.png", 15)
+        .withCRC32(true)
+        .build();
+    ImageSlotTable table;
+    initImageSlotTable(table);
+    uint8_t stateIndex = 0;
+    uint32_t server[1] = {0x12345678};
+    EXPECT_FALSE(runCycle(config, table, stateIndex, WAKEUP_TIMER, server));
+    EXPECT_TRUE(runCycle(config, table, stateIndex, WAKEUP_TIMER, server));
+    
+    // WHEN: An error or config screen replaced the image
+    clearDisplayedSlot(table);
+    
+    // THEN: Next timer wake downloads even though the CRC32 matches
+    NormalModeDecisions decisions = orchestrateNormalModeDecisions(config, WAKEUP_TIMER, 0, table.displayedSlot);
+    EXPECT_FALSE(decisions.unchangedSkip.allowSkip);
+    EXPECT_FALSE(runCycle(config, table, stateIndex, WAKEUP_TIMER, server));
+    EXPECT_TRUE(runCycle(config, table, stateIndex, WAKEUP_TIMER, server));
+}
+
+TEST_F(NormalModeIntegrationTest, SlotTable_DefaultDisplayedSlot_NeverSkips) {
+    // Orchestration without slot information never allows a skip
+    DashboardConfig config = ConfigBuilder()
+        .singleImage("http://example.com/image.png", 15)
+        .withCRC32(true)
+        .build();
+    
+    NormalModeDecisions decisions = orchestrateNormalModeDecisions(config, WAKEUP_TIMER, 0);
+    
+    EXPECT_TRUE(decisions.crc32Action.shouldCheck);
+    EXPECT_FALSE(decisions.unchangedSkip.allowSkip);
+}
+
 // =============================================================================
 // Main
 // =============================================================================
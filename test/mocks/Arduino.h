@@ -9,14 +9,28 @@
 #include <ctime>
 
 // Mock Arduino String class
+// allocations() counts every non-empty value a String takes on (a heap
+// allocation on the device) - tests reset it to check a path makes none
 class String {
 public:
     std::string _data;
     
+    static int& allocations() {
+        static int count = 0;
+        return count;
+    }
+    
     String() : _data("") {}
-    String(const char* str) : _data(str ? str : "") {}
-    String(const std::string& str) : _data(str) {}
-    String(int value) : _data(std::to_string(value)) {}
+    String(const char* str) : _data(str ? str : "") { counted(); }
+    String(const std::string& str) : _data(str) { counted(); }
+    String(int value) : _data(std::to_string(value)) { counted(); }
+    String(const String& other) : _data(other._data) { counted(); }
+    
+    String& operator=(const String& other) {
+        _data = other._data;
+        counted();
+        return *this;
+    }
     
     const char* c_str() const { return _data.c_str(); }
     size_t length() const { return _data.length(); }
@@ -25,15 +39,18 @@ public:
     
     // Concatenation operators
     String operator+(const String& other) const {
-        String result;
-        result._data = _data + other._data;
-        return result;
+        return String(_data + other._data);
     }
     
     String operator+(const char* s) const {
-        String result;
-        result._data = _data + s;
-        return result;
+        return String(_data + s);
+    }
+
+private:
+    void counted() {
+        if (!_data.empty()) {
+            allocations()++;
+        }
     }
 };
 
@@ -0,0 +1,105 @@
+// Map-backed stand-in for the ESP32 Preferences (NVS) namespace
+// Used by the config blob tests and benchmark in place of the flash
+#ifndef MOCK_MAP_PREFERENCES_H
+#define MOCK_MAP_PREFERENCES_H
+
+#include <config_blob.h>
+#include <cstring>
+#include <map>
+#include <string>
+
+class MapPreferences : public ConfigKeyStore {
+public:
+    MapPreferences() : lookups(0), writes(0), failWrites(false) {}
+
+    // Setup helpers (the key-per-field layout of earlier firmware)
+    void putBool(const char* key, bool value) { _values[key] = std::string(1, value ? 1 : 0); }
+    void putUChar(const char* key, uint8_t value) { _values[key] = std::string(1, (char)value); }
+    void putInt(const char* key, int32_t value) { _values[key] = std::string((const char*)&value, sizeof(value)); }
+    void putString(const char* key, const char* value) { _values[key] = std::string(value, strlen(value) + 1); }
+
+    bool isKey(const char* key) override {
+        lookups++;
+        return _values.count(key) > 0;
+    }
+
+    bool getBool(const char* key, bool defaultValue) override {
+        const std::string* value = find(key, 1);
+        return value != nullptr ? (*value)[0] != 0 : defaultValue;
+    }
+
+    uint8_t getUChar(const char* key, uint8_t defaultValue) override {
+        const std::string* value = find(key, 1);
+        return value != nullptr ? (uint8_t)(*value)[0] : defaultValue;
+    }
+
+    int32_t getInt(const char* key, int32_t defaultValue) override {
+        const std::string* value = find(key, sizeof(int32_t));
+        if (value == nullptr) {
+            return defaultValue;
+        }
+        int32_t result;
+        memcpy(&result, value->data(), sizeof(result));
+        return result;
+    }
+
+    bool getString(const char* key, char* value, size_t size) override {
+        const std::string* stored = find(key, 0);
+        if (stored == nullptr || stored->size() > size) {
+            return false;  // Like nvs_get_str: no partial copy
+        }
+        memcpy(value, stored->data(), stored->size());
+        return true;
+    }
+
+    size_t getBytesLength(const char* key) override {
+        const std::string* value = find(key, 0);
+        return value != nullptr ? value->size() : 0;
+    }
+
+    size_t getBytes(const char* key, void* buffer, size_t size) override {
+        const std::string* value = find(key, 0);
+        if (value == nullptr || value->size() > size) {
+            return 0;
+        }
+        memcpy(buffer, value->data(), value->size());
+        return value->size();
+    }
+
+    size_t putBytes(const char* key, const void* data, size_t size) override {
+        writes++;
+        if (failWrites) {
+            return 0;  // NVS full or power lost during the write
+        }
+        _values[key] = std::string((const char*)data, size);
+        return size;
+    }
+
+    bool remove(const char* key) override {
+        return _values.erase(key) > 0;
+    }
+
+    size_t keyCount() const { return _values.size(); }
+    bool has(const char* key) const { return _values.count(key) > 0; }
+
+    // Overwrite a stored byte as a flash corruption would
+    void corrupt(const char* key, size_t offset) { _values[key][offset] ^= 0x5A; }
+
+    int lookups;        // Read accesses (each one an NVS lookup on the device)
+    int writes;         // Blob writes
+    bool failWrites;
+
+private:
+    std::map<std::string, std::string> _values;
+
+    const std::string* find(const char* key, size_t minSize) {
+        lookups++;
+        std::map<std::string, std::string>::const_iterator it = _values.find(key);
+        if (it == _values.end() || it->second.size() < minSize) {
+            return nullptr;
+        }
+        return &it->second;
+    }
+};
+
+#endif // MOCK_MAP_PREFERENCES_H
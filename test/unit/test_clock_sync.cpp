@@ -0,0 +1,225 @@
+#include <gtest/gtest.h>
+#include <clock_sync.h>
+
+// Test fixture for RTC time keeping and drift correction
+class ClockSyncTest : public ::testing::Test {
+protected:
+    ClockState state;
+    const uint32_t t0 = 1760000000;
+
+    void SetUp() override {
+        initClockState(state);
+    }
+
+    // NTP sync at true time 'at' with a system clock that ran off by 'offset' seconds
+    void ntpSync(uint32_t at, int32_t offset = 0) {
+        recordClockSync(state, at + offset, at, CLOCK_SOURCE_NTP, false);
+    }
+};
+
+// ============================================================================
+// State validation
+// ============================================================================
+
+TEST_F(ClockSyncTest, InitializedStateIsValidAndNeverSynced) {
+    EXPECT_TRUE(isClockStateValid(state));
+    EXPECT_EQ(state.syncedAt, 0u);
+    EXPECT_EQ(estimateClockErrorSeconds(state, t0, false), CLOCK_ERROR_UNKNOWN);
+    EXPECT_TRUE(isClockSyncNeeded(state, t0, false));
+}
+
+TEST_F(ClockSyncTest, ColdBootStateIsInvalid) {
+    ClockState zeroed = {};
+    EXPECT_FALSE(isClockStateValid(zeroed));
+}
+
+TEST_F(ClockSyncTest, CorruptStateIsInvalid) {
+    state.source = CLOCK_SOURCE_HTTP_DATE + 1;
+    EXPECT_FALSE(isClockStateValid(state));
+
+    initClockState(state);
+    state.driftPpm = CLOCK_MAX_DRIFT_PPM + 1;
+    EXPECT_FALSE(isClockStateValid(state));
+}
+
+// ============================================================================
+// Error estimate and sync decision
+// ============================================================================
+
+TEST_F(ClockSyncTest, ErrorGrowsWithDefaultDriftWithoutEstimate) {
+    ntpSync(t0);
+    EXPECT_EQ(estimateClockErrorSeconds(state, t0, false), (uint32_t)CLOCK_NTP_ERROR_SECONDS);
+    // 1000 s at CLOCK_DEFAULT_DRIFT_PPM
+    EXPECT_EQ(estimateClockErrorSeconds(state, t0 + 1000, false),
+              CLOCK_NTP_ERROR_SECONDS + 1000u * CLOCK_DEFAULT_DRIFT_PPM / 1000000);
+}
+
+TEST_F(ClockSyncTest, NtpNeededOnlyOnceErrorExceedsThreshold) {
+    ntpSync(t0);
+    // Default drift reaches CLOCK_MAX_ERROR_SECONDS after ~(60 - 1) / 2 % = 2950 s
+    EXPECT_FALSE(isClockSyncNeeded(state, t0 + 900, false));
+    EXPECT_FALSE(isClockSyncNeeded(state, t0 + 2900, false));
+    EXPECT_TRUE(isClockSyncNeeded(state, t0 + 3000, false));
+}
+
+TEST_F(ClockSyncTest, RtcChipKeepsClockValidForDays) {
+    ntpSync(t0);
+    EXPECT_FALSE(isClockSyncNeeded(state, t0 + 7 * 86400, true));
+    EXPECT_TRUE(isClockSyncNeeded(state, t0 + 30 * 86400, true));
+}
+
+TEST_F(ClockSyncTest, UnsetOrBackwardsClockNeedsSync) {
+    ntpSync(t0);
+    EXPECT_TRUE(isClockSyncNeeded(state, 12, false));         // Clock lost (not set since reset)
+    EXPECT_TRUE(isClockSyncNeeded(state, t0 - 10, false));    // Moved backwards
+}
+
+// ============================================================================
+// Drift estimation and correction
+// ============================================================================
+
+TEST_F(ClockSyncTest, SecondNtpSyncEstimatesDrift) {
+    ntpSync(t0);
+    ntpSync(t0 + 10000, 100);  // Clock ran 100 s fast over 10000 s = 1 %
+
+    EXPECT_EQ(state.driftSamples, 1);
+    EXPECT_EQ(state.driftPpm, 10000);
+    EXPECT_EQ(state.syncedAt, t0 + 10000);
+}
+
+TEST_F(ClockSyncTest, ShortIntervalDoesNotEstimateDrift) {
+    ntpSync(t0);
+    ntpSync(t0 + CLOCK_DRIFT_MIN_INTERVAL_S - 1, 20);
+    EXPECT_EQ(state.driftSamples, 0);
+    EXPECT_EQ(state.driftPpm, 0);
+}
+
+TEST_F(ClockSyncTest, DriftEstimateReducesErrorAndNtpFrequency) {
+    ntpSync(t0);
+    ntpSync(t0 + 10000, 100);
+
+    EXPECT_FALSE(isClockSyncNeeded(state, t0 + 10000 + 6 * 3600, false));
+    EXPECT_EQ(estimateClockErrorSeconds(state, t0 + 10000 + 10000, false),
+              CLOCK_NTP_ERROR_SECONDS + 10000u * CLOCK_RESIDUAL_DRIFT_PPM / 1000000);
+}
+
+TEST_F(ClockSyncTest, CorrectionTakesDriftOffTheClock) {
+    ntpSync(t0);
+    ntpSync(t0 + 10000, 100);  // 1 % fast
+
+    // The raw clock reads 1010 s after the sync when 1000 s passed
+    uint32_t corrected = applyClockDriftCorrection(state, t0 + 10000 + 1010);
+    EXPECT_NEAR((double)corrected, (double)(t0 + 10000 + 1000), 1.0);
+}
+
+TEST_F(ClockSyncTest, SmallCorrectionsAccumulateAcrossWakes) {
+    ntpSync(t0);
+    ntpSync(t0 + 100000, 100);  // 1000 ppm: 0.9 s per 15 minute wake
+
+    // 16 wakes of 900 true seconds on a clock that runs 0.1 % fast
+    uint32_t trueTime = t0 + 100000;
+    double clock = trueTime;
+    for (int wake = 0; wake < 16; wake++) {
+        trueTime += 900;
+        clock += 900 * 1.001;
+        uint32_t read = (uint32_t)clock;
+        clock += (double)applyClockDriftCorrection(state, read) - read;  // settimeofday()
+    }
+    EXPECT_NEAR((double)clock, (double)trueTime, 2.0);  // Uncorrected: 14 s fast
+}
+
+TEST_F(ClockSyncTest, LaterSyncsRefineEstimate) {
+    ntpSync(t0);
+    ntpSync(t0 + 10000, 100);             // 10000 ppm
+    ntpSync(t0 + 20000, -20);             // Corrected clock still 20 s slow: overshoot
+    EXPECT_EQ(state.driftSamples, 2);
+    EXPECT_EQ(state.driftPpm, 10000 - 1000);  // Half the residual of -2000 ppm
+}
+
+TEST_F(ClockSyncTest, ImplausibleDriftIsClamped) {
+    ntpSync(t0);
+    ntpSync(t0 + 4000, 3000);
+    EXPECT_EQ(state.driftPpm, CLOCK_MAX_DRIFT_PPM);
+    EXPECT_TRUE(isClockStateValid(state));
+}
+
+TEST_F(ClockSyncTest, RtcChipSyncDoesNotEstimateSystemDrift) {
+    recordClockSync(state, t0, t0, CLOCK_SOURCE_NTP, true);
+    recordClockSync(state, t0 + 10100, t0 + 10000, CLOCK_SOURCE_NTP, true);
+    EXPECT_EQ(state.driftSamples, 0);
+    EXPECT_EQ(applyClockDriftCorrection(state, t0 + 20000), t0 + 20000);
+}
+
+// ============================================================================
+// HTTP Date
+// ============================================================================
+
+TEST_F(ClockSyncTest, ParsesImfFixdate) {
+    uint32_t time = 0;
+    EXPECT_TRUE(parseHttpDate("Sun, 06 Nov 1994 08:49:37 GMT", time));
+    EXPECT_EQ(time, 784111777u);
+    EXPECT_TRUE(parseHttpDate("Wed, 15 Oct 2025 12:00:00 GMT", time));
+    EXPECT_EQ(time, 1760529600u);
+    EXPECT_TRUE(parseHttpDate("Thu, 29 Feb 2024 23:59:59 GMT", time));
+    EXPECT_EQ(time, 1709251199u);
+}
+
+TEST_F(ClockSyncTest, RejectsMalformedDates) {
+    uint32_t time = 0;
+    EXPECT_FALSE(parseHttpDate(nullptr, time));
+    EXPECT_FALSE(parseHttpDate("", time));
+    EXPECT_FALSE(parseHttpDate("Sunday, 06-Nov-94 08:49:37 GMT", time));  // Obsolete RFC 850
+    EXPECT_FALSE(parseHttpDate("Sun Nov  6 08:49:37 1994", time));         // asctime
+    EXPECT_FALSE(parseHttpDate("Wed, 15 Oct 2025 12:00:00 CET", time));
+    EXPECT_FALSE(parseHttpDate("Wed, 15 Okt 2025 12:00:00 GMT", time));
+    EXPECT_FALSE(parseHttpDate("Wed, 15 anF 2025 12:00:00 GMT", time));   // Straddles two names
+    EXPECT_FALSE(parseHttpDate("Fri, 29 Feb 2025 12:00:00 GMT", time));
+    EXPECT_FALSE(parseHttpDate("Wed, 15 Oct 2025 24:00:00 GMT", time));
+    EXPECT_EQ(time, 0u);
+}
+
+TEST_F(ClockSyncTest, HttpDateSetsUnsyncedClock) {
+    EXPECT_TRUE(shouldUseHttpDate(state, 12, t0, false));
+    EXPECT_FALSE(shouldUseHttpDate(state, 12, 1000, false));  // Server clock not set either
+}
+
+TEST_F(ClockSyncTest, HttpDateUsedOnlyWhenItImprovesTheClock) {
+    ntpSync(t0);
+    EXPECT_FALSE(shouldUseHttpDate(state, t0 + 100, t0 + 101, false));   // Error ~3 s
+    EXPECT_TRUE(shouldUseHttpDate(state, t0 + 900, t0 + 890, false));    // Error ~19 s
+
+    recordClockSync(state, t0 + 900, t0 + 890, CLOCK_SOURCE_HTTP_DATE, false);
+    EXPECT_EQ(estimateClockErrorSeconds(state, t0 + 890, false), (uint32_t)CLOCK_HTTP_DATE_ERROR_SECONDS);
+    EXPECT_FALSE(isClockSyncNeeded(state, t0 + 890 + 900, false));
+}
+
+TEST_F(ClockSyncTest, WrongServerClockIsIgnored) {
+    ntpSync(t0);
+    EXPECT_FALSE(shouldUseHttpDate(state, t0 + 900, t0 + 900 + 86400, false));
+    EXPECT_FALSE(shouldUseHttpDate(state, t0 + 900, t0 - 3600, false));
+}
+
+TEST_F(ClockSyncTest, HttpDateSyncDoesNotEstimateDrift) {
+    ntpSync(t0);
+    recordClockSync(state, t0 + 10100, t0 + 10000, CLOCK_SOURCE_HTTP_DATE, false);
+    ntpSync(t0 + 20000, 100);  // Interval since the Date header, not measured
+    EXPECT_EQ(state.driftSamples, 0);
+    EXPECT_EQ(state.source, CLOCK_SOURCE_NTP);
+}
+
+// ============================================================================
+// Sleep record
+// ============================================================================
+
+TEST_F(ClockSyncTest, SleepRecordEstimatesTimerWake) {
+    recordClockSleep(state, t0, 900);
+    EXPECT_EQ(estimateClockWakeTime(state), t0 + 900);
+}
+
+TEST_F(ClockSyncTest, UnknownSleepHasNoEstimate) {
+    EXPECT_EQ(estimateClockWakeTime(state), 0u);
+    recordClockSleep(state, 12, 900);       // Clock not set when going to sleep
+    EXPECT_EQ(estimateClockWakeTime(state), 0u);
+    recordClockSleep(state, t0, 0);         // Button-only sleep
+    EXPECT_EQ(estimateClockWakeTime(state), 0u);
+}
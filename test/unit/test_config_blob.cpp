@@ -0,0 +1,482 @@
+#include <gtest/gtest.h>
+#include <config_blob.h>
+#include <map_preferences.h>
+#include <cstring>
+#include <string>
+
+// Test fixture for the stored configuration blob, its migration and RTC copy
+class ConfigBlobTest : public ::testing::Test {
+protected:
+    ConfigBlob blob;
+    MapPreferences prefs;
+
+    void SetUp() override {
+        initConfigBlob(blob);
+    }
+
+    bool storedValid(const ConfigBlob& b) {
+        return isConfigBlobValid((const uint8_t*)&b, b.size);
+    }
+
+    // Version 2 carousel device as earlier firmware stored it
+    void storeLegacyCarousel() {
+        prefs.putUChar(PREF_CONFIG_VERSION, 2);
+        prefs.putBool(PREF_CONFIGURED, true);
+        prefs.putString(PREF_WIFI_SSID, "HomeNet");
+        prefs.putString(PREF_WIFI_PASS, "secret123");
+        prefs.putString(PREF_FRIENDLY_NAME, "kitchen");
+        prefs.putString(PREF_MQTT_BROKER, "mqtt://broker.local:1883");
+        prefs.putString(PREF_MQTT_USER, "ha");
+        prefs.putString(PREF_MQTT_PASS, "mqttpw");
+        prefs.putBool(PREF_MQTT_BATCHED, true);
+        prefs.putBool(PREF_USE_CRC32, true);
+        prefs.putUChar(PREF_CHANGE_DETECTION, CHANGE_DETECTION_HTTP);
+        prefs.putString(PREF_TLS_FINGERPRINT, "AB:CD");
+        prefs.putUChar(PREF_UPDATE_HOURS_0, 0x0F);
+        prefs.putUChar(PREF_UPDATE_HOURS_1, 0xF0);
+        prefs.putUChar(PREF_UPDATE_HOURS_2, 0x3C);
+        prefs.putInt(PREF_TIMEZONE_OFFSET, -5);
+        prefs.putUChar(PREF_SCREEN_ROTATION, 3);
+        prefs.putBool(PREF_PARTIAL_REFRESH, true);
+        prefs.putUChar(PREF_FULL_REFRESH_EVERY, 4);
+        prefs.putBool(PREF_USE_STATIC_IP, true);
+        prefs.putString(PREF_STATIC_IP, "192.168.1.50");
+        prefs.putString(PREF_GATEWAY, "192.168.1.1");
+        prefs.putString(PREF_SUBNET, "255.255.255.0");
+        prefs.putString(PREF_PRIMARY_DNS, "1.1.1.1");
+        prefs.putString(PREF_SECONDARY_DNS, "");
+        prefs.putUChar(PREF_IMAGE_COUNT, 2);
+        prefs.putString("img_url_0", "http://example.com/a.png");
+        prefs.putInt("img_int_0", 15);
+        prefs.putBool("img_stay_0", false);
+        prefs.putString("img_url_1", "http://example.com/b.png");
+        prefs.putInt("img_int_1", 0);
+        prefs.putBool("img_stay_1", true);
+        prefs.putUChar(PREF_PREFETCH_COUNT, 2);
+        prefs.putUChar(PREF_FRONTLIGHT_DURATION, 30);
+        prefs.putUChar(PREF_FRONTLIGHT_BRIGHTNESS, 40);
+        prefs.putBool(PREF_OVERLAY_ENABLED, true);
+        prefs.putUChar(PREF_OVERLAY_POSITION, OVERLAY_POS_BOTTOM_LEFT);
+        prefs.putBool(PREF_OVERLAY_SHOW_BATTERY_ICON, false);
+        prefs.putBool(PREF_OVERLAY_SHOW_BATTERY_PCT, true);
+        prefs.putBool(PREF_OVERLAY_SHOW_UPDATE_TIME, false);
+        prefs.putBool(PREF_OVERLAY_SHOW_CYCLE_TIME, true);
+        prefs.putUChar(PREF_OVERLAY_SIZE, OVERLAY_SIZE_LARGE);
+        prefs.putUChar(PREF_OVERLAY_TEXT_COLOR, OVERLAY_COLOR_WHITE);
+    }
+
+    // Per-wake state that must survive a migration
+    void storeStateKeys() {
+        uint8_t slots[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+        prefs.putBytes(PREF_IMAGE_SLOTS, slots, sizeof(slots));
+        prefs.putString("img_etag_0", "\"v1\"");
+        prefs.putUChar(PREF_WIFI_CHANNEL, 6);
+        prefs.putBytes(PREF_MQTT_DISCOVERY_HASH, slots, 4);
+    }
+
+    std::string repeat(char c, size_t count) {
+        return std::string(count, c);
+    }
+};
+
+// ============================================================================
+// Validation
+// ============================================================================
+
+TEST_F(ConfigBlobTest, InitializedBlobIsValidWithDefaults) {
+    EXPECT_TRUE(storedValid(blob));
+    EXPECT_EQ(blob.settings.flags & CONFIG_FLAG_CONFIGURED, 0);
+    EXPECT_EQ(blob.settings.imageCount, 0);
+    EXPECT_EQ(blob.settings.updateHours[0], 0xFF);
+    EXPECT_EQ(blob.settings.fullRefreshEvery, DEFAULT_FULL_REFRESH_EVERY);
+    EXPECT_EQ(blob.settings.frontlightBrightness, DEFAULT_FRONTLIGHT_BRIGHTNESS);
+    EXPECT_EQ(blob.settings.overlayPosition, OVERLAY_POS_TOP_RIGHT);
+    EXPECT_NE(blob.settings.flags & CONFIG_FLAG_OVERLAY_BATTERY_ICON, 0);
+    EXPECT_EQ(blob.settings.flags & CONFIG_FLAG_OVERLAY_CYCLE_TIME, 0);
+    for (int i = 0; i < CONFIG_STRING_COUNT; i++) {
+        EXPECT_STREQ(getConfigString(blob, (ConfigStringId)i), "");
+    }
+    // Empty configuration: header, settings and one terminator per string
+    EXPECT_EQ(blob.size, offsetof(ConfigBlob, strings) + CONFIG_STRING_COUNT);
+}
+
+TEST_F(ConfigBlobTest, ZeroedMemoryIsInvalid) {
+    ConfigBlob zeroed;
+    memset(&zeroed, 0, sizeof(zeroed));
+    EXPECT_FALSE(isConfigBlobValid((const uint8_t*)&zeroed, sizeof(zeroed)));
+    EXPECT_FALSE(isConfigBlobValid(nullptr, 0));
+}
+
+TEST_F(ConfigBlobTest, AnyChangedByteIsDetected) {
+    setConfigString(blob, CONFIG_STR_WIFI_SSID, "HomeNet");
+    blob.settings.imageIntervals[3] = 42;
+    sealConfigBlob(blob);
+    for (size_t offset = 0; offset < blob.size; offset++) {
+        if (offset == offsetof(ConfigBlob, reserved)) {
+            continue;  // Unused header byte
+        }
+        ConfigBlob damaged = blob;
+        ((uint8_t*)&damaged)[offset] ^= 0x01;
+        EXPECT_FALSE(storedValid(damaged)) << "offset " << offset;
+    }
+}
+
+TEST_F(ConfigBlobTest, OtherLayoutVersionIsInvalid) {
+    blob.version = CONFIG_VERSION_CURRENT + 1;
+    sealConfigBlob(blob);
+    EXPECT_FALSE(storedValid(blob));
+}
+
+TEST_F(ConfigBlobTest, TruncatedBytesAreInvalid) {
+    setConfigString(blob, CONFIG_STR_IMAGE_URL, "http://example.com/a.png");
+    sealConfigBlob(blob);
+    EXPECT_TRUE(isConfigBlobValid((const uint8_t*)&blob, blob.size));
+    EXPECT_FALSE(isConfigBlobValid((const uint8_t*)&blob, blob.size - 1));
+}
+
+TEST_F(ConfigBlobTest, UnterminatedOrOverlongStringIsInvalid) {
+    // A sealed blob whose pool ends early (size cut inside the last string)
+    setConfigString(blob, (ConfigStringId)(CONFIG_STRING_COUNT - 1), "http://example.com/j.png");
+    blob.size -= 1;
+    sealConfigBlob(blob);
+    EXPECT_FALSE(storedValid(blob));
+
+    // A string longer than its limit written past the setter
+    initConfigBlob(blob);
+    setConfigString(blob, CONFIG_STR_WIFI_SSID, repeat('s', 32).c_str());
+    memmove(blob.strings + 1, blob.strings, blob.size - offsetof(ConfigBlob, strings));
+    blob.strings[0] = 's';
+    blob.size += 1;
+    sealConfigBlob(blob);
+    EXPECT_FALSE(storedValid(blob));
+}
+
+// ============================================================================
+// Strings
+// ============================================================================
+
+TEST_F(ConfigBlobTest, StringsRoundTrip) {
+    for (int i = 0; i < CONFIG_STRING_COUNT; i++) {
+        std::string value = "value-" + std::to_string(i);
+        ASSERT_TRUE(setConfigString(blob, (ConfigStringId)i, value.c_str()));
+    }
+    sealConfigBlob(blob);
+    EXPECT_TRUE(storedValid(blob));
+    for (int i = 0; i < CONFIG_STRING_COUNT; i++) {
+        EXPECT_EQ(getConfigString(blob, (ConfigStringId)i), "value-" + std::to_string(i));
+    }
+}
+
+TEST_F(ConfigBlobTest, ReplacingAStringMovesTheFollowingOnes) {
+    setConfigString(blob, CONFIG_STR_WIFI_SSID, "first");
+    setConfigString(blob, CONFIG_STR_MQTT_BROKER, "mqtt://broker");
+    setConfigString(blob, (ConfigStringId)(CONFIG_STR_IMAGE_URL + 9), "http://example.com/last.png");
+    uint16_t size = blob.size;
+
+    ASSERT_TRUE(setConfigString(blob, CONFIG_STR_WIFI_SSID, "a-much-longer-network-name"));
+    EXPECT_EQ(blob.size, size + strlen("a-much-longer-network-name") - strlen("first"));
+    EXPECT_STREQ(getConfigString(blob, CONFIG_STR_MQTT_BROKER), "mqtt://broker");
+    EXPECT_STREQ(getConfigString(blob, (ConfigStringId)(CONFIG_STR_IMAGE_URL + 9)), "http://example.com/last.png");
+
+    ASSERT_TRUE(setConfigString(blob, CONFIG_STR_WIFI_SSID, ""));
+    EXPECT_EQ(blob.size, size - strlen("first"));
+    EXPECT_STREQ(getConfigString(blob, CONFIG_STR_MQTT_BROKER), "mqtt://broker");
+    sealConfigBlob(blob);
+    EXPECT_TRUE(storedValid(blob));
+}
+
+TEST_F(ConfigBlobTest, TooLongStringIsRejected) {
+    setConfigString(blob, CONFIG_STR_WIFI_SSID, "HomeNet");
+    uint16_t size = blob.size;
+    EXPECT_FALSE(setConfigString(blob, CONFIG_STR_WIFI_SSID, repeat('x', 33).c_str()));
+    EXPECT_FALSE(setConfigString(blob, CONFIG_STR_IMAGE_URL, repeat('u', MAX_URL_LENGTH + 1).c_str()));
+    EXPECT_FALSE(setConfigString(blob, CONFIG_STRING_COUNT, "out of range"));
+    EXPECT_EQ(blob.size, size);
+    EXPECT_STREQ(getConfigString(blob, CONFIG_STR_WIFI_SSID), "HomeNet");
+}
+
+TEST_F(ConfigBlobTest, LongestValuesOfEveryStringFit) {
+    for (int i = 0; i < CONFIG_STRING_COUNT; i++) {
+        size_t limit = getConfigStringLimit((ConfigStringId)i);
+        ASSERT_TRUE(setConfigString(blob, (ConfigStringId)i, repeat('a' + i % 26, limit).c_str()));
+    }
+    sealConfigBlob(blob);
+    EXPECT_TRUE(storedValid(blob));
+    EXPECT_LE(blob.size, sizeof(ConfigBlob));
+    EXPECT_EQ(strlen(getConfigString(blob, (ConfigStringId)(CONFIG_STRING_COUNT - 1))), MAX_URL_LENGTH);
+}
+
+// ============================================================================
+// Stored Blob
+// ============================================================================
+
+TEST_F(ConfigBlobTest, SavedBlobLoadsBackWithOneRead) {
+    blob.settings.flags |= CONFIG_FLAG_CONFIGURED;
+    blob.settings.imageCount = 1;
+    blob.settings.imageIntervals[0] = 30;
+    setConfigString(blob, CONFIG_STR_WIFI_SSID, "HomeNet");
+    setConfigString(blob, CONFIG_STR_IMAGE_URL, "http://example.com/a.png");
+    ASSERT_TRUE(saveConfigBlob(prefs, blob));
+    EXPECT_EQ(prefs.getBytesLength(PREF_CONFIG_BLOB), blob.size);  // Only the used bytes
+
+    ConfigBlob loaded;
+    prefs.lookups = 0;
+    EXPECT_EQ(loadConfigBlob(prefs, loaded), CONFIG_LOAD_BLOB);
+    EXPECT_EQ(prefs.lookups, 2);  // Length and bytes of one key
+    EXPECT_EQ(memcmp(&loaded, &blob, blob.size), 0);
+    EXPECT_STREQ(getConfigString(loaded, CONFIG_STR_IMAGE_URL), "http://example.com/a.png");
+}
+
+TEST_F(ConfigBlobTest, NothingStoredLoadsUnconfigured) {
+    EXPECT_EQ(loadConfigBlob(prefs, blob), CONFIG_LOAD_EMPTY);
+    EXPECT_TRUE(storedValid(blob));
+    EXPECT_EQ(blob.settings.flags & CONFIG_FLAG_CONFIGURED, 0);
+    EXPECT_EQ(prefs.writes, 0);
+}
+
+TEST_F(ConfigBlobTest, CorruptStoredBlobLoadsUnconfigured) {
+    blob.settings.flags |= CONFIG_FLAG_CONFIGURED;
+    setConfigString(blob, CONFIG_STR_WIFI_SSID, "HomeNet");
+    saveConfigBlob(prefs, blob);
+    prefs.corrupt(PREF_CONFIG_BLOB, offsetof(ConfigBlob, strings) + 2);
+
+    ConfigBlob loaded;
+    EXPECT_EQ(loadConfigBlob(prefs, loaded), CONFIG_LOAD_EMPTY);
+    EXPECT_EQ(loaded.settings.flags & CONFIG_FLAG_CONFIGURED, 0);
+    EXPECT_STREQ(getConfigString(loaded, CONFIG_STR_WIFI_SSID), "");
+}
+
+// ============================================================================
+// Migration
+// ============================================================================
+
+TEST_F(ConfigBlobTest, MigratesCarouselLayout) {
+    storeLegacyCarousel();
+    EXPECT_EQ(loadConfigBlob(prefs, blob), CONFIG_LOAD_MIGRATED);
+    ASSERT_TRUE(storedValid(blob));
+
+    const ConfigSettings& s = blob.settings;
+    EXPECT_NE(s.flags & CONFIG_FLAG_CONFIGURED, 0);
+    EXPECT_NE(s.flags & CONFIG_FLAG_MQTT_BATCHED, 0);
+    EXPECT_NE(s.flags & CONFIG_FLAG_USE_CRC32, 0);
+    EXPECT_NE(s.flags & CONFIG_FLAG_PARTIAL_REFRESH, 0);
+    EXPECT_NE(s.flags & CONFIG_FLAG_USE_STATIC_IP, 0);
+    EXPECT_NE(s.flags & CONFIG_FLAG_OVERLAY_ENABLED, 0);
+    EXPECT_EQ(s.flags & CONFIG_FLAG_OVERLAY_BATTERY_ICON, 0);
+    EXPECT_NE(s.flags & CONFIG_FLAG_OVERLAY_BATTERY_PCT, 0);
+    EXPECT_EQ(s.flags & CONFIG_FLAG_OVERLAY_UPDATE_TIME, 0);
+    EXPECT_NE(s.flags & CONFIG_FLAG_OVERLAY_CYCLE_TIME, 0);
+    EXPECT_EQ(s.changeDetection, CHANGE_DETECTION_HTTP);
+    EXPECT_EQ(s.updateHours[0], 0x0F);
+    EXPECT_EQ(s.updateHours[1], 0xF0);
+    EXPECT_EQ(s.updateHours[2], 0x3C);
+    EXPECT_EQ(s.timezoneOffset, -5);
+    EXPECT_EQ(s.screenRotation, 3);
+    EXPECT_EQ(s.fullRefreshEvery, 4);
+    EXPECT_EQ(s.imageCount, 2);
+    EXPECT_EQ(s.imageIntervals[0], 15);
+    EXPECT_EQ(s.imageIntervals[1], 0);
+    EXPECT_EQ(s.imageStayMask, 0x0002);
+    EXPECT_EQ(s.prefetchCount, 2);
+    EXPECT_EQ(s.frontlightDuration, 30);
+    EXPECT_EQ(s.frontlightBrightness, 40);
+    EXPECT_EQ(s.overlayPosition, OVERLAY_POS_BOTTOM_LEFT);
+    EXPECT_EQ(s.overlaySize, OVERLAY_SIZE_LARGE);
+    EXPECT_EQ(s.overlayTextColor, OVERLAY_COLOR_WHITE);
+
+    EXPECT_STREQ(getConfigString(blob, CONFIG_STR_WIFI_SSID), "HomeNet");
+    EXPECT_STREQ(getConfigString(blob, CONFIG_STR_WIFI_PASSWORD), "secret123");
+    EXPECT_STREQ(getConfigString(blob, CONFIG_STR_FRIENDLY_NAME), "kitchen");
+    EXPECT_STREQ(getConfigString(blob, CONFIG_STR_MQTT_BROKER), "mqtt://broker.local:1883");
+    EXPECT_STREQ(getConfigString(blob, CONFIG_STR_MQTT_USERNAME), "ha");
+    EXPECT_STREQ(getConfigString(blob, CONFIG_STR_MQTT_PASSWORD), "mqttpw");
+    EXPECT_STREQ(getConfigString(blob, CONFIG_STR_TLS_FINGERPRINT), "AB:CD");
+    EXPECT_STREQ(getConfigString(blob, CONFIG_STR_STATIC_IP), "192.168.1.50");
+    EXPECT_STREQ(getConfigString(blob, CONFIG_STR_GATEWAY), "192.168.1.1");
+    EXPECT_STREQ(getConfigString(blob, CONFIG_STR_SUBNET), "255.255.255.0");
+    EXPECT_STREQ(getConfigString(blob, CONFIG_STR_PRIMARY_DNS), "1.1.1.1");
+    EXPECT_STREQ(getConfigString(blob, CONFIG_STR_SECONDARY_DNS), "");
+    EXPECT_STREQ(getConfigString(blob, CONFIG_STR_IMAGE_URL), "http://example.com/a.png");
+    EXPECT_STREQ(getConfigString(blob, (ConfigStringId)(CONFIG_STR_IMAGE_URL + 1)), "http://example.com/b.png");
+    EXPECT_STREQ(getConfigString(blob, (ConfigStringId)(CONFIG_STR_IMAGE_URL + 2)), "");
+}
+
+TEST_F(ConfigBlobTest, MigrationUsesTheOldDefaultsForMissingKeys) {
+    prefs.putBool(PREF_CONFIGURED, true);
+    prefs.putString(PREF_WIFI_SSID, "HomeNet");
+    prefs.putUChar(PREF_IMAGE_COUNT, 1);
+    prefs.putString("img_url_0", "http://example.com/a.png");
+    prefs.putUChar(PREF_CHANGE_DETECTION, 7);  // Unknown method
+
+    ASSERT_TRUE(migrateLegacyConfig(prefs, blob));
+    const ConfigSettings& s = blob.settings;
+    EXPECT_EQ(s.imageIntervals[0], DEFAULT_INTERVAL_MINUTES);
+    EXPECT_EQ(s.changeDetection, CHANGE_DETECTION_CRC32);
+    EXPECT_EQ(s.updateHours[2], 0xFF);
+    EXPECT_EQ(s.fullRefreshEvery, DEFAULT_FULL_REFRESH_EVERY);
+    EXPECT_EQ(s.frontlightBrightness, DEFAULT_FRONTLIGHT_BRIGHTNESS);
+    EXPECT_NE(s.flags & CONFIG_FLAG_OVERLAY_UPDATE_TIME, 0);
+    EXPECT_EQ(s.flags & CONFIG_FLAG_USE_CRC32, 0);
+    EXPECT_EQ(s.overlaySize, OVERLAY_SIZE_MEDIUM);
+}
+
+TEST_F(ConfigBlobTest, MigratesVersion1SingleImage) {
+    prefs.putBool(PREF_CONFIGURED, true);
+    prefs.putString(PREF_WIFI_SSID, "HomeNet");
+    prefs.putString(PREF_IMAGE_URL, "http://example.com/old.png");
+    prefs.putInt(PREF_REFRESH_RATE, 20);
+
+    ASSERT_TRUE(migrateLegacyConfig(prefs, blob));
+    EXPECT_EQ(blob.settings.imageCount, 1);
+    EXPECT_EQ(blob.settings.imageIntervals[0], 20);
+    EXPECT_STREQ(getConfigString(blob, CONFIG_STR_IMAGE_URL), "http://example.com/old.png");
+}
+
+TEST_F(ConfigBlobTest, MigratesWiFiOnlyConfiguration) {
+    // Boot mode saved the credentials, the dashboard step has not run yet
+    prefs.putString(PREF_WIFI_SSID, "HomeNet");
+    prefs.putString(PREF_WIFI_PASS, "secret123");
+
+    EXPECT_EQ(loadConfigBlob(prefs, blob), CONFIG_LOAD_MIGRATED);
+    EXPECT_EQ(blob.settings.flags & CONFIG_FLAG_CONFIGURED, 0);
+    EXPECT_EQ(blob.settings.imageCount, 0);
+    EXPECT_STREQ(getConfigString(blob, CONFIG_STR_WIFI_SSID), "HomeNet");
+}
+
+TEST_F(ConfigBlobTest, MigrationClampsTheImageCount) {
+    prefs.putBool(PREF_CONFIGURED, true);
+    prefs.putUChar(PREF_IMAGE_COUNT, 25);
+    ASSERT_TRUE(migrateLegacyConfig(prefs, blob));
+    EXPECT_EQ(blob.settings.imageCount, MAX_IMAGE_SLOTS);
+    EXPECT_TRUE(storedValid(blob));
+}
+
+TEST_F(ConfigBlobTest, LegacyStringsAtTheLimitMigrate) {
+    storeLegacyCarousel();
+    prefs.putString(PREF_MQTT_BROKER, repeat('b', MAX_MQTT_BROKER_LENGTH).c_str());
+    prefs.putString(PREF_MQTT_PASS, repeat('p', MAX_MQTT_PASSWORD_LENGTH).c_str());
+    ASSERT_EQ(loadConfigBlob(prefs, blob), CONFIG_LOAD_MIGRATED);
+    EXPECT_EQ(strlen(getConfigString(blob, CONFIG_STR_MQTT_BROKER)), (size_t)MAX_MQTT_BROKER_LENGTH);
+    EXPECT_EQ(strlen(getConfigString(blob, CONFIG_STR_MQTT_PASSWORD)), (size_t)MAX_MQTT_PASSWORD_LENGTH);
+}
+
+TEST_F(ConfigBlobTest, OverlongLegacyBrokerAndPasswordKeepTheOldKeys) {
+    // The old portal had no length limit on either field
+    storeLegacyCarousel();
+    prefs.putString(PREF_MQTT_BROKER, ("mqtt://" + repeat('b', MAX_MQTT_BROKER_LENGTH)).c_str());
+    prefs.putString(PREF_MQTT_PASS, repeat('p', MAX_MQTT_PASSWORD_LENGTH + 1).c_str());
+    int writes = prefs.writes;
+
+    const char* rejectedKey = nullptr;
+    EXPECT_EQ(loadConfigBlob(prefs, blob, &rejectedKey), CONFIG_LOAD_LEGACY_KEPT);
+    EXPECT_STREQ(rejectedKey, PREF_MQTT_BROKER);  // First one found
+    EXPECT_EQ(blob.settings.flags & CONFIG_FLAG_CONFIGURED, 0);
+    EXPECT_STREQ(getConfigString(blob, CONFIG_STR_WIFI_SSID), "");
+    EXPECT_TRUE(storedValid(blob));
+
+    // Nothing written or removed: earlier firmware still finds its settings
+    EXPECT_EQ(prefs.writes, writes);
+    EXPECT_FALSE(prefs.has(PREF_CONFIG_BLOB));
+    EXPECT_TRUE(prefs.has(PREF_MQTT_BROKER));
+    EXPECT_TRUE(prefs.has(PREF_MQTT_PASS));
+    EXPECT_TRUE(prefs.has(PREF_WIFI_SSID));
+    EXPECT_TRUE(prefs.has("img_url_1"));
+}
+
+TEST_F(ConfigBlobTest, OverlongLegacyPasswordAloneFailsTheMigration) {
+    storeLegacyCarousel();
+    prefs.putString(PREF_MQTT_PASS, repeat('p', MAX_MQTT_PASSWORD_LENGTH + 1).c_str());
+    const char* rejectedKey = nullptr;
+    EXPECT_FALSE(migrateLegacyConfig(prefs, blob, &rejectedKey));
+    EXPECT_STREQ(rejectedKey, PREF_MQTT_PASS);
+}
+
+TEST_F(ConfigBlobTest, OverlongLegacyImageUrlFailsTheMigration) {
+    storeLegacyCarousel();
+    prefs.putString("img_url_1", ("http://example.com/" + repeat('x', MAX_URL_LENGTH)).c_str());
+    const char* rejectedKey = nullptr;
+    EXPECT_EQ(loadConfigBlob(prefs, blob, &rejectedKey), CONFIG_LOAD_LEGACY_KEPT);
+    EXPECT_STREQ(rejectedKey, PREF_IMAGE_URL_PREFIX);
+    EXPECT_TRUE(prefs.has("img_url_0"));
+}
+
+TEST_F(ConfigBlobTest, MigrationRemovesOldKeysAndKeepsState) {
+    storeLegacyCarousel();
+    storeStateKeys();
+    ASSERT_EQ(loadConfigBlob(prefs, blob), CONFIG_LOAD_MIGRATED);
+
+    EXPECT_TRUE(prefs.has(PREF_CONFIG_BLOB));
+    EXPECT_FALSE(prefs.has(PREF_WIFI_SSID));
+    EXPECT_FALSE(prefs.has(PREF_CONFIG_VERSION));
+    EXPECT_FALSE(prefs.has("img_url_1"));
+    EXPECT_FALSE(prefs.has("img_stay_1"));
+    EXPECT_TRUE(prefs.has(PREF_IMAGE_SLOTS));
+    EXPECT_TRUE(prefs.has("img_etag_0"));
+    EXPECT_TRUE(prefs.has(PREF_WIFI_CHANNEL));
+    EXPECT_TRUE(prefs.has(PREF_MQTT_DISCOVERY_HASH));
+    EXPECT_EQ(prefs.keyCount(), 5u);  // The blob and the four state keys
+}
+
+TEST_F(ConfigBlobTest, FailedSaveKeepsTheOldKeys) {
+    storeLegacyCarousel();
+    prefs.failWrites = true;
+    EXPECT_EQ(loadConfigBlob(prefs, blob), CONFIG_LOAD_MIGRATED);
+    EXPECT_STREQ(getConfigString(blob, CONFIG_STR_WIFI_SSID), "HomeNet");  // Usable this wake
+    EXPECT_TRUE(prefs.has(PREF_WIFI_SSID));                                  // Migrated again next wake
+    EXPECT_FALSE(prefs.has(PREF_CONFIG_BLOB));
+}
+
+TEST_F(ConfigBlobTest, MigrationRunsOnce) {
+    storeLegacyCarousel();
+    ASSERT_EQ(loadConfigBlob(prefs, blob), CONFIG_LOAD_MIGRATED);
+    int writes = prefs.writes;
+
+    ConfigBlob again;
+    EXPECT_EQ(loadConfigBlob(prefs, again), CONFIG_LOAD_BLOB);
+    EXPECT_EQ(prefs.writes, writes);
+    EXPECT_EQ(memcmp(&again, &blob, blob.size), 0);
+}
+
+// ============================================================================
+// RTC Copy
+// ============================================================================
+
+TEST_F(ConfigBlobTest, RtcCopyRestoresTheBlob) {
+    storeLegacyCarousel();
+    loadConfigBlob(prefs, blob);
+    ConfigCache cache;
+    updateConfigCache(cache, blob);
+
+    ConfigBlob restored;
+    ASSERT_TRUE(restoreConfigCache(cache, restored));
+    EXPECT_EQ(memcmp(&restored, &blob, blob.size), 0);
+    EXPECT_STREQ(getConfigString(restored, (ConfigStringId)(CONFIG_STR_IMAGE_URL + 1)), "http://example.com/b.png");
+}
+
+TEST_F(ConfigBlobTest, ZeroedRtcCopyIsAMiss) {
+    ConfigCache cache;
+    memset(&cache, 0, sizeof(cache));  // Cold boot
+    EXPECT_FALSE(restoreConfigCache(cache, blob));
+}
+
+TEST_F(ConfigBlobTest, DamagedRtcCopyIsAMiss) {
+    setConfigString(blob, CONFIG_STR_WIFI_SSID, "HomeNet");
+    sealConfigBlob(blob);
+    ConfigCache cache;
+    updateConfigCache(cache, blob);
+    cache.data[offsetof(ConfigBlob, strings)] ^= 0x20;
+    EXPECT_FALSE(restoreConfigCache(cache, blob));
+}
+
+TEST_F(ConfigBlobTest, ConfigurationTooLargeForRtcIsNotCached) {
+    for (int i = 0; i < MAX_IMAGE_SLOTS; i++) {
+        setConfigString(blob, (ConfigStringId)(CONFIG_STR_IMAGE_URL + i), repeat('u', 200).c_str());
+    }
+    sealConfigBlob(blob);
+    ASSERT_GT(blob.size, CONFIG_CACHE_BYTES);
+
+    ConfigCache cache;
+    updateConfigCache(cache, blob);
+    ConfigBlob restored;
+    EXPECT_FALSE(restoreConfigCache(cache, restored));
+}
@@ -0,0 +1,499 @@
+#include <gtest/gtest.h>
+#include <config_json.h>            // Real production code!
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+
+// ============================================================================
+// Heap accounting - every operator new of the test binary goes through here
+// ============================================================================
+
+static int g_heapAllocations = 0;
+
+void* operator new(size_t size) {
+    g_heapAllocations++;
+    void* memory = malloc(size == 0 ? 1 : size);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void* memory) noexcept {
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    free(memory);
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// Collects the response; fixed size so writing never allocates
+struct FixedSink {
+    char data[8192];
+    size_t length;
+};
+
+static void copyChunk(void* context, const char* data, size_t length) {
+    FixedSink* sink = static_cast<FixedSink*>(context);
+    if (sink->length + length < sizeof(sink->data)) {
+        memcpy(sink->data + sink->length, data, length);
+        sink->data[sink->length + length] = '\0';
+    }
+    sink->length += length;
+}
+
+class ConfigJsonTest : public ::testing::Test {
+protected:
+    FixedSink sink;
+    char buffer[256];
+    char error[CONFIG_JSON_ERROR_SIZE];
+
+    void SetUp() override {
+        sink.length = 0;
+        sink.data[0] = '\0';
+        error[0] = '\0';
+    }
+
+    std::string writeConfig(const DashboardConfig& config) {
+        sink.length = 0;
+        TemplateWriter out(buffer, sizeof(buffer), copyChunk, &sink);
+        writeConfigJson(out, config);
+        out.flush();
+        return std::string(sink.data, sink.length);
+    }
+
+    std::string writeStatus(const DeviceStatus& status) {
+        sink.length = 0;
+        TemplateWriter out(buffer, sizeof(buffer), copyChunk, &sink);
+        writeStatusJson(out, status);
+        out.flush();
+        return std::string(sink.data, sink.length);
+    }
+
+    bool parse(const char* json, DashboardConfig& config) {
+        return parseConfigJson(json, strlen(json), config, error, sizeof(error));
+    }
+};
+
+static DashboardConfig makeConfig() {
+    DashboardConfig config;
+    config.wifiSSID = "HomeNet";
+    config.wifiPassword = "secret";
+    config.friendlyName = "kitchen";
+    config.imageCount = 2;
+    config.imageUrls[0] = "https://ha.example.com/local/dashboard.png";
+    config.imageIntervals[0] = 15;
+    config.imageUrls[1] = "https://ha.example.com/local/calendar.png";
+    config.imageIntervals[1] = 60;
+    config.imageStay[1] = true;
+    config.prefetchCount = 1;
+    config.mqttBroker = "mqtt://192.168.1.10:1883";
+    config.mqttUsername = "homeassistant";
+    config.mqttPassword = "mqtt-password";
+    config.mqttBatchedState = true;
+    config.useCRC32Check = true;
+    config.changeDetection = CHANGE_DETECTION_HTTP;
+    config.timezoneOffset = -5;
+    config.screenRotation = 2;
+    config.partialRefresh = true;
+    config.fullRefreshEvery = 20;
+    config.frontlightDuration = 30;
+    config.frontlightBrightness = 40;
+    config.overlayEnabled = true;
+    config.overlayPosition = OVERLAY_POS_BOTTOM_LEFT;
+    config.overlaySize = OVERLAY_SIZE_LARGE;
+    config.overlayTextColor = OVERLAY_COLOR_WHITE;
+    config.overlayShowCycleTime = true;
+    config.useStaticIP = true;
+    config.staticIP = "192.168.1.50";
+    config.gateway = "192.168.1.1";
+    config.subnet = "255.255.255.0";
+    config.primaryDNS = "1.1.1.1";
+    config.updateHours[0] = 0x00;   // 8:00 - 20:00 only
+    config.updateHours[1] = 0xFF;
+    config.updateHours[2] = 0x1F;
+    return config;
+}
+
+// ============================================================================
+// Round Trip
+// ============================================================================
+
+TEST_F(ConfigJsonTest, RoundTrip_RestoresEveryField) {
+    DashboardConfig original = makeConfig();
+    std::string json = writeConfig(original);
+
+    DashboardConfig copy;
+    copy.wifiPassword = "secret";         // Write-only: not in the document
+    copy.mqttPassword = "mqtt-password";
+    ASSERT_TRUE(parse(json.c_str(), copy)) << error;
+
+    EXPECT_EQ(json, writeConfig(copy));
+    EXPECT_STREQ("HomeNet", copy.wifiSSID.c_str());
+    EXPECT_STREQ("kitchen", copy.friendlyName.c_str());
+    EXPECT_EQ(2, copy.imageCount);
+    EXPECT_STREQ("https://ha.example.com/local/calendar.png", copy.imageUrls[1].c_str());
+    EXPECT_EQ(60, copy.imageIntervals[1]);
+    EXPECT_TRUE(copy.imageStay[1]);
+    EXPECT_EQ(-5, copy.timezoneOffset);
+    EXPECT_EQ(CHANGE_DETECTION_HTTP, copy.changeDetection);
+    EXPECT_EQ(0, memcmp(original.updateHours, copy.updateHours, sizeof(copy.updateHours)));
+    EXPECT_TRUE(copy.useStaticIP);
+    EXPECT_STREQ("255.255.255.0", copy.subnet.c_str());
+    EXPECT_TRUE(validateConfigJson(copy, error, sizeof(error))) << error;
+}
+
+TEST_F(ConfigJsonTest, Write_LeavesPasswordsOut) {
+    std::string json = writeConfig(makeConfig());
+
+    EXPECT_EQ(std::string::npos, json.find("secret"));
+    EXPECT_EQ(std::string::npos, json.find("mqtt-password"));
+    EXPECT_NE(std::string::npos, json.find("\"wifi_password_set\":true"));
+    EXPECT_NE(std::string::npos, json.find("\"mqtt_password_set\":true"));
+
+    EXPECT_NE(std::string::npos, writeConfig(DashboardConfig()).find("\"wifi_password_set\":false"));
+}
+
+TEST_F(ConfigJsonTest, Write_ListsEnabledHours) {
+    std::string json = writeConfig(makeConfig());
+    EXPECT_NE(std::string::npos, json.find("\"update_hours\":[8,9,10,11,12,13,14,15,16,17,18,19,20]"));
+    EXPECT_NE(std::string::npos, json.find(
+        "\"images\":[{\"url\":\"https://ha.example.com/local/dashboard.png\",\"interval\":15,\"stay\":false},"));
+}
+
+TEST_F(ConfigJsonTest, Write_EscapesStrings) {
+    DashboardConfig config;
+    config.wifiSSID = "Cafe \"Net\"\\2\n\t";
+    std::string json = writeConfig(config);
+    EXPECT_EQ(0u, json.find("{\"ssid\":\"Cafe \\\"Net\\\"\\\\2\\n\\t\","));
+
+    DashboardConfig copy;
+    ASSERT_TRUE(parse(json.c_str(), copy)) << error;
+    EXPECT_STREQ(config.wifiSSID.c_str(), copy.wifiSSID.c_str());
+}
+
+// ============================================================================
+// Merging
+// ============================================================================
+
+TEST_F(ConfigJsonTest, Parse_KeepsFieldsLeftOut) {
+    DashboardConfig config = makeConfig();
+    ASSERT_TRUE(parse("{\"friendly_name\":\"hallway\",\"timezone_offset\":1}", config)) << error;
+
+    EXPECT_STREQ("hallway", config.friendlyName.c_str());
+    EXPECT_EQ(1, config.timezoneOffset);
+    EXPECT_STREQ("HomeNet", config.wifiSSID.c_str());
+    EXPECT_STREQ("secret", config.wifiPassword.c_str());
+    EXPECT_EQ(2, config.imageCount);
+    EXPECT_EQ(20, config.fullRefreshEvery);
+}
+
+TEST_F(ConfigJsonTest, Parse_ImagesReplaceTheWholeList) {
+    DashboardConfig config = makeConfig();
+    ASSERT_TRUE(parse("{\"images\":[{\"url\":\"http://10.0.0.2/a.png\"}]}", config)) << error;
+
+    EXPECT_EQ(1, config.imageCount);
+    EXPECT_STREQ("http://10.0.0.2/a.png", config.imageUrls[0].c_str());
+    EXPECT_EQ(DEFAULT_INTERVAL_MINUTES, config.imageIntervals[0]);  // Unset members take defaults
+    EXPECT_FALSE(config.imageStay[0]);
+}
+
+TEST_F(ConfigJsonTest, Parse_UpdateHoursReplaceTheSchedule) {
+    DashboardConfig config = makeConfig();
+    ASSERT_TRUE(parse("{\"update_hours\":[0,7,23]}", config)) << error;
+
+    EXPECT_EQ(0x81, config.updateHours[0]);
+    EXPECT_EQ(0x00, config.updateHours[1]);
+    EXPECT_EQ(0x80, config.updateHours[2]);
+}
+
+TEST_F(ConfigJsonTest, Parse_PasswordsAreWriteOnly) {
+    DashboardConfig config = makeConfig();
+    ASSERT_TRUE(parse("{\"wifi_password\":\"n3w\",\"wifi_password_set\":true,\"mqtt_password_set\":false}", config)) << error;
+
+    EXPECT_STREQ("n3w", config.wifiPassword.c_str());
+    EXPECT_STREQ("mqtt-password", config.mqttPassword.c_str());  // *_password_set is informational
+}
+
+TEST_F(ConfigJsonTest, Parse_NormalizesFingerprint) {
+    DashboardConfig config;
+    ASSERT_TRUE(parse("{\"tls_fingerprint\":"
+                      "\"abcdef0123456789abcdef0123456789abcdef0123456789abcdef0123456789\"}", config)) << error;
+    EXPECT_STREQ("AB:CD:EF:01:23:45:67:89:AB:CD:EF:01:23:45:67:89:"
+                 "AB:CD:EF:01:23:45:67:89:AB:CD:EF:01:23:45:67:89", config.tlsFingerprint.c_str());
+
+    ASSERT_TRUE(parse("{\"tls_fingerprint\":\"\"}", config)) << error;
+    EXPECT_TRUE(config.tlsFingerprint.isEmpty());
+
+    EXPECT_FALSE(parse("{\"tls_fingerprint\":\"AB:CD\"}", config));
+    EXPECT_STREQ("tls_fingerprint: expected SHA-256 as 64 hex digits", error);
+}
+
+TEST_F(ConfigJsonTest, Parse_DecodesUnicodeEscapes) {
+    DashboardConfig config;
+    ASSERT_TRUE(parse("{ \"friendly_name\" : \"caf\\u00e9 \\ud83d\\ude00\\/\" }", config)) << error;
+    EXPECT_STREQ("caf\xC3\xA9 \xF0\x9F\x98\x80/", config.friendlyName.c_str());
+}
+
+// ============================================================================
+// Rejected Documents
+// ============================================================================
+
+TEST_F(ConfigJsonTest, Parse_RejectsUnknownKeys) {
+    DashboardConfig config;
+    EXPECT_FALSE(parse("{\"ssid\":\"a\",\"sssid\":\"b\"}", config));
+    EXPECT_STREQ("Unknown key \"sssid\"", error);
+
+    EXPECT_FALSE(parse("{\"images\":[{\"url\":\"http://a/\",\"uri\":1}]}", config));
+    EXPECT_STREQ("images: unknown key \"uri\"", error);
+}
+
+TEST_F(ConfigJsonTest, Parse_RejectsWrongTypes) {
+    DashboardConfig config;
+    EXPECT_FALSE(parse("{\"ssid\":5}", config));
+    EXPECT_STREQ("ssid: expected a string", error);
+
+    EXPECT_FALSE(parse("{\"partial_refresh\":\"yes\"}", config));
+    EXPECT_STREQ("partial_refresh: expected true or false", error);
+
+    EXPECT_FALSE(parse("{\"screen_rotation\":1.5}", config));
+    EXPECT_STREQ("screen_rotation: expected a whole number", error);
+
+    EXPECT_FALSE(parse("{\"images\":{}}", config));
+    EXPECT_STREQ("images: expected an array", error);
+
+    EXPECT_FALSE(parse("{\"change_detection\":\"etag\"}", config));
+    EXPECT_STREQ("change_detection: expected \"crc32\" or \"http\"", error);
+}
+
+TEST_F(ConfigJsonTest, Parse_RejectsValuesOutOfRange) {
+    DashboardConfig config;
+    EXPECT_FALSE(parse("{\"timezone_offset\":15}", config));
+    EXPECT_STREQ("timezone_offset: out of range (-12 to 14)", error);
+
+    EXPECT_FALSE(parse("{\"update_hours\":[24]}", config));
+    EXPECT_STREQ("update_hours: out of range (0 to 23)", error);
+
+    EXPECT_FALSE(parse("{\"frontlight_duration\":99999999999999}", config));
+    EXPECT_STREQ("frontlight_duration: out of range (0 to 255)", error);
+
+    EXPECT_FALSE(parse("{\"images\":[{\"url\":\"http://a/\",\"interval\":-1}]}", config));
+    EXPECT_EQ(0, strncmp("images.interval: out of range", error, 29)) << error;
+}
+
+TEST_F(ConfigJsonTest, Parse_RejectsStringsThatDoNotFit) {
+    DashboardConfig config;
+    std::string json = "{\"ssid\":\"" + std::string(MAX_SSID_LENGTH + 1, 'x') + "\"}";
+    EXPECT_FALSE(parse(json.c_str(), config));
+    EXPECT_EQ("ssid: too long (max " + std::to_string(MAX_SSID_LENGTH) + " characters)", std::string(error));
+
+    json = "{\"ssid\":\"" + std::string(MAX_SSID_LENGTH, 'x') + "\"}";
+    EXPECT_TRUE(parse(json.c_str(), config)) << error;
+    EXPECT_EQ((size_t)MAX_SSID_LENGTH, config.wifiSSID.length());
+}
+
+TEST_F(ConfigJsonTest, Parse_RejectsTooManyImages) {
+    std::string json = "{\"images\":[";
+    for (int i = 0; i <= MAX_IMAGE_SLOTS; i++) {
+        json += i == 0 ? "{\"url\":\"http://a/\"}" : ",{\"url\":\"http://a/\"}";
+    }
+    json += "]}";
+
+    DashboardConfig config;
+    EXPECT_FALSE(parse(json.c_str(), config));
+    EXPECT_EQ("images: at most " + std::to_string(MAX_IMAGE_SLOTS) + " images", std::string(error));
+
+    EXPECT_FALSE(parse("{\"images\":[{\"interval\":5}]}", config));
+    EXPECT_STREQ("images: image 1 has no url", error);
+}
+
+TEST_F(ConfigJsonTest, Parse_ReportsSyntaxErrors) {
+    DashboardConfig config;
+    EXPECT_FALSE(parse("{\"ssid\" \"a\"}", config));
+    EXPECT_STREQ("Invalid JSON (InvalidInput)", error);
+
+    EXPECT_FALSE(parse("{\"ssid\":\"a\"} x", config));
+    EXPECT_STREQ("Invalid JSON at offset 13", error);
+
+    EXPECT_FALSE(parse("{\"ssid\":\"a", config));
+    EXPECT_EQ(0, strncmp("Invalid JSON", error, 12)) << error;
+
+    EXPECT_FALSE(parse("{\"ssid\":\"a\\u0000b\"}", config));  // Would cut the stored string
+    EXPECT_NE('\0', error[0]);
+    EXPECT_TRUE(config.wifiSSID.isEmpty()) << config.wifiSSID.c_str();  // Nothing applied from a rejected document
+
+    EXPECT_FALSE(parse("[]", config));
+    EXPECT_STREQ("document: expected an object", error);
+
+    EXPECT_FALSE(parseConfigJson("{}", 0, config, error, sizeof(error)));
+}
+
+TEST_F(ConfigJsonTest, Parse_RejectsDocumentsOverThePool) {
+    DashboardConfig config;
+    std::string json = "{\"ssid\":\"" + std::string(CONFIG_JSON_POOL_SIZE, 'x') + "\"}";
+    EXPECT_FALSE(parse(json.c_str(), config));
+    EXPECT_STREQ("Document too large", error);
+}
+
+TEST_F(ConfigJsonTest, Parse_TakesTheApiTokenOnlyWhenAsked) {
+    DashboardConfig config;
+    EXPECT_FALSE(parse("{\"api_token\":\"0123456789abcdef\"}", config));
+    EXPECT_STREQ("Unknown key \"api_token\"", error);
+
+    static const char document[] = "{\"api_token\":\"0123456789abcdef\",\"timezone_offset\":2}";
+    ApiTokenUpdate token;
+    ASSERT_TRUE(parseConfigJson(document, sizeof(document) - 1, config, error, sizeof(error), &token)) << error;
+    EXPECT_TRUE(token.present);
+    EXPECT_STREQ("0123456789abcdef", token.value.c_str());
+    EXPECT_EQ(2, config.timezoneOffset);
+
+    static const char off[] = "{\"api_token\":\"\"}";
+    ASSERT_TRUE(parseConfigJson(off, sizeof(off) - 1, config, error, sizeof(error), &token)) << error;
+    EXPECT_TRUE(token.present);
+    EXPECT_TRUE(token.value.isEmpty());
+
+    static const char none[] = "{\"timezone_offset\":3}";
+    ASSERT_TRUE(parseConfigJson(none, sizeof(none) - 1, config, error, sizeof(error), &token)) << error;
+    EXPECT_FALSE(token.present);
+
+    static const char weak[] = "{\"api_token\":\"short\"}";
+    EXPECT_FALSE(parseConfigJson(weak, sizeof(weak) - 1, config, error, sizeof(error), &token));
+    EXPECT_STREQ("api_token: 16 to 64 characters, no spaces", error);
+}
+
+// ============================================================================
+// Validation
+// ============================================================================
+
+TEST_F(ConfigJsonTest, Validate_MatchesTheForm) {
+    DashboardConfig config = makeConfig();
+    EXPECT_TRUE(validateConfigJson(config, error, sizeof(error))) << error;
+
+    config.wifiSSID = "";
+    EXPECT_FALSE(validateConfigJson(config, error, sizeof(error)));
+    EXPECT_STREQ("ssid is required", error);
+
+    config = makeConfig();
+    config.imageUrls[1] = "ftp://ha.example.com/x.png";
+    EXPECT_FALSE(validateConfigJson(config, error, sizeof(error)));
+    EXPECT_STREQ("Image 2 URL must start with http:// or https://", error);
+
+    config = makeConfig();
+    config.imageCount = 0;
+    EXPECT_FALSE(validateConfigJson(config, error, sizeof(error)));
+    EXPECT_STREQ("At least one image is required", error);
+
+    config = makeConfig();
+    config.friendlyName = "---";
+    EXPECT_FALSE(validateConfigJson(config, error, sizeof(error)));
+    EXPECT_STREQ("friendly_name must contain at least one letter or digit", error);
+
+    config = makeConfig();
+    config.gateway = "192.168.1";
+    EXPECT_FALSE(validateConfigJson(config, error, sizeof(error)));
+    EXPECT_STREQ("Invalid gateway", error);
+
+    config.useStaticIP = false;  // Addresses only matter with a static IP
+    EXPECT_TRUE(validateConfigJson(config, error, sizeof(error))) << error;
+}
+
+TEST_F(ConfigJsonTest, ApiToken_Rules) {
+    EXPECT_TRUE(isValidApiToken("0123456789abcdef"));
+    EXPECT_TRUE(isValidApiToken(std::string(API_TOKEN_MAX_LENGTH, 'k').c_str()));
+    EXPECT_FALSE(isValidApiToken("0123456789abcde"));  // One short
+    EXPECT_FALSE(isValidApiToken(std::string(API_TOKEN_MAX_LENGTH + 1, 'k').c_str()));
+    EXPECT_FALSE(isValidApiToken("0123456789 abcdef"));
+    EXPECT_FALSE(isValidApiToken("0123456789abcdef\x7f"));
+    EXPECT_FALSE(isValidApiToken(nullptr));
+}
+
+TEST_F(ConfigJsonTest, ApiToken_AuthorizesOnlyTheBearerToken) {
+    const char* token = "0123456789abcdef";
+    EXPECT_TRUE(isApiRequestAuthorized("Bearer 0123456789abcdef", token));
+    EXPECT_FALSE(isApiRequestAuthorized("Bearer 0123456789abcdeF", token));
+    EXPECT_FALSE(isApiRequestAuthorized("Bearer 0123456789abcde", token));
+    EXPECT_FALSE(isApiRequestAuthorized("Bearer 0123456789abcdef0", token));
+    EXPECT_FALSE(isApiRequestAuthorized("Basic 0123456789abcdef", token));
+    EXPECT_FALSE(isApiRequestAuthorized("0123456789abcdef", token));
+    EXPECT_FALSE(isApiRequestAuthorized("", token));
+    EXPECT_FALSE(isApiRequestAuthorized(nullptr, token));
+
+    // No token stored: nothing gets through, not even an empty bearer
+    EXPECT_FALSE(isApiRequestAuthorized("Bearer ", ""));
+    EXPECT_FALSE(isApiRequestAuthorized("Bearer x", nullptr));
+}
+
+// ============================================================================
+// Status and Errors
+// ============================================================================
+
+TEST_F(ConfigJsonTest, Status_WritesEveryField) {
+    EnergyStats energy = {};
+    energy.avgCycleMah = 0.5f;
+    energy.avgAwakeSeconds = 7.25f;
+    energy.cycles = 12;
+
+    DeviceStatus status = {};
+    status.firmwareVersion = "1.9.0";
+    status.board = "Inkplate 10";
+    status.mode = "config";
+    status.configured = true;
+    status.apiTokenSet = true;
+    status.deviceId = "kitchen";
+    status.ipAddress = "192.168.1.50";
+    status.hostname = "kitchen";
+    status.connected = true;
+    status.rssi = -61;
+    status.uptimeSeconds = 42;
+    status.freeHeap = 180000;
+    status.energyStats = &energy;
+
+    EXPECT_EQ("{\"firmware_version\":\"1.9.0\",\"board\":\"Inkplate 10\",\"mode\":\"config\","
+              "\"configured\":true,\"api_token_set\":true,\"device_id\":\"kitchen\",\"ip\":\"192.168.1.50\","
+              "\"hostname\":\"kitchen\",\"connected\":true,\"rssi\":-61,\"uptime_seconds\":42,"
+              "\"free_heap\":180000,\"energy\":{\"cycle_mah\":0.5,\"awake_seconds\":7.25,\"cycles\":12}}",
+              writeStatus(status));
+}
+
+TEST_F(ConfigJsonTest, Status_LeavesOutWhatIsUnknown) {
+    DeviceStatus status = {};
+    status.mode = "boot";
+    status.ipAddress = "192.168.4.1";
+    std::string json = writeStatus(status);
+
+    EXPECT_NE(std::string::npos, json.find("\"connected\":false"));
+    EXPECT_EQ(std::string::npos, json.find("rssi"));
+    EXPECT_EQ(std::string::npos, json.find("energy"));
+    EXPECT_NE(std::string::npos, json.find("\"board\":\"\""));
+}
+
+TEST_F(ConfigJsonTest, Error_IsEscaped) {
+    TemplateWriter out(buffer, sizeof(buffer), copyChunk, &sink);
+    writeJsonError(out, "Unknown key \"x\"");
+    out.flush();
+    EXPECT_STREQ("{\"error\":\"Unknown key \\\"x\\\"\"}", sink.data);
+}
+
+// The document lives in its pool block: no operator new, so no String or container growth behind it
+TEST_F(ConfigJsonTest, DocumentsStayInTheirPool) {
+    DashboardConfig config = makeConfig();
+    static const char document[] =
+        "{\"ssid\":\"Office\",\"images\":[{\"url\":\"https://a.example/1.png\",\"interval\":5,\"stay\":true}],"
+        "\"update_hours\":[6,7,8],\"tls_fingerprint\":\"\",\"overlay_enabled\":false}";
+
+    int before = g_heapAllocations;
+    TemplateWriter out(buffer, sizeof(buffer), copyChunk, &sink);
+    writeConfigJson(out, config);
+    out.flush();
+    bool parsed = parseConfigJson(document, sizeof(document) - 1, config, error, sizeof(error));
+    bool valid = validateConfigJson(config, error, sizeof(error));
+    EXPECT_EQ(before, g_heapAllocations);
+
+    EXPECT_TRUE(parsed);
+    EXPECT_TRUE(valid) << error;
+}
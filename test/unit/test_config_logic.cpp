@@ -258,3 +258,34 @@ TEST_F(ConfigLogicTest, Integration_CrossMidnightSchedule) {
     EXPECT_EQ(utcHour, 23);
     EXPECT_TRUE(isHourEnabledInBitmask(utcHour, bitmask));
 }
+
+// ============================================================================
+// Address and URL Validation
+// ============================================================================
+
+TEST_F(ConfigLogicTest, IPv4_AcceptsDottedQuad) {
+    EXPECT_TRUE(isValidIPv4Address("192.168.1.10"));
+    EXPECT_TRUE(isValidIPv4Address("0.0.0.0"));
+    EXPECT_TRUE(isValidIPv4Address("255.255.255.255"));
+}
+
+TEST_F(ConfigLogicTest, IPv4_RejectsMalformed) {
+    EXPECT_FALSE(isValidIPv4Address(nullptr));
+    EXPECT_FALSE(isValidIPv4Address(""));
+    EXPECT_FALSE(isValidIPv4Address("192.168.1"));
+    EXPECT_FALSE(isValidIPv4Address("192.168.1.10.5"));
+    EXPECT_FALSE(isValidIPv4Address("192.168..10"));
+    EXPECT_FALSE(isValidIPv4Address("192.168.1.256"));
+    EXPECT_FALSE(isValidIPv4Address("192.168.1.10 "));
+    EXPECT_FALSE(isValidIPv4Address("192.168.1.-1"));
+    EXPECT_FALSE(isValidIPv4Address("192.168.1."));
+}
+
+TEST_F(ConfigLogicTest, ImageUrl_RequiresHttpScheme) {
+    EXPECT_TRUE(isValidImageUrl("http://ha.local/image.png"));
+    EXPECT_TRUE(isValidImageUrl("https://ha.example.com/image.png"));
+    EXPECT_FALSE(isValidImageUrl("ftp://ha.local/image.png"));
+    EXPECT_FALSE(isValidImageUrl("ha.local/image.png"));
+    EXPECT_FALSE(isValidImageUrl(""));
+    EXPECT_FALSE(isValidImageUrl(nullptr));
+}
@@ -0,0 +1,380 @@
+#include <gtest/gtest.h>
+#include <config_page.h>            // Real production code!
+#include <page_template.h>
+#include <config_portal_html.h>
+#include <config_portal_assets.h>
+#include <cstdlib>
+#include <new>
+#include <regex>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// Heap accounting - every allocation of the test binary goes through here
+// ============================================================================
+
+static int g_heapAllocations = 0;
+
+void* operator new(size_t size) {
+    g_heapAllocations++;
+    void* memory = malloc(size == 0 ? 1 : size);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void* memory) noexcept {
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    free(memory);
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// Records every flush, like the WebServer's chunked response would send it
+struct RecordingSink {
+    std::string output;
+    std::vector<size_t> chunks;
+};
+
+static void recordChunk(void* context, const char* data, size_t length) {
+    RecordingSink* sink = static_cast<RecordingSink*>(context);
+    sink->output.append(data, length);
+    sink->chunks.push_back(length);
+}
+
+// Fixed-size sink for the allocation test (std::string would allocate)
+struct FixedSink {
+    char data[65536];
+    size_t length;
+};
+
+static void copyChunk(void* context, const char* data, size_t length) {
+    FixedSink* sink = static_cast<FixedSink*>(context);
+    if (sink->length + length <= sizeof(sink->data)) {
+        memcpy(sink->data + sink->length, data, length);
+    }
+    sink->length += length;
+}
+
+static DashboardConfig makeConfig() {
+    DashboardConfig config;
+    config.wifiSSID = "HomeNet";
+    config.wifiPassword = "secret";
+    config.friendlyName = "kitchen";
+    config.imageCount = 2;
+    config.imageUrls[0] = "https://ha.example.com/local/dashboard.png";
+    config.imageIntervals[0] = 15;
+    config.imageUrls[1] = "https://ha.example.com/local/calendar.png";
+    config.imageIntervals[1] = 60;
+    config.imageStay[1] = true;
+    config.mqttBroker = "mqtt://192.168.1.10:1883";
+    config.mqttUsername = "homeassistant";
+    config.mqttPassword = "mqtt-password";
+    config.useCRC32Check = true;
+    config.changeDetection = CHANGE_DETECTION_HTTP;
+    config.screenRotation = 2;
+    config.overlayEnabled = true;
+    config.overlayPosition = OVERLAY_POS_BOTTOM_LEFT;
+    config.overlaySize = OVERLAY_SIZE_LARGE;
+    config.overlayTextColor = OVERLAY_COLOR_WHITE;
+    config.overlayShowCycleTime = true;
+    config.updateHours[0] = 0x00;  // Hours 0-7 off
+    config.updateHours[1] = 0xFF;
+    config.updateHours[2] = 0x7F;  // Hour 23 off
+    return config;
+}
+
+static ConfigPageContext makePage(const DashboardConfig& config, bool configMode, bool hasConfig) {
+    ConfigPageContext page = {};
+    page.configMode = configMode;
+    page.hasConfig = hasConfig;
+    page.config = &config;
+    page.deviceName = "inkplate-a1b2c3";
+    page.ipAddress = "192.168.1.42";
+    page.hostname = "kitchen.local";
+    page.connected = true;
+    page.partialRefreshAvailable = true;
+    page.frontlightAvailable = false;
+    page.vcomAvailable = true;
+    page.firmwareVersion = "1.2.3";
+    page.energyStats = nullptr;
+    page.powerProfile = { 40.0f, 100.0f, 50.0f, 20.0f, 1200.0f };
+    return page;
+}
+
+static std::string render(const ConfigPageContext& page, size_t bufferSize = CONFIG_PAGE_BUFFER_SIZE,
+                          RecordingSink* sinkOut = nullptr) {
+    std::vector<char> buffer(bufferSize);
+    RecordingSink sink;
+    TemplateWriter out(buffer.data(), buffer.size(), recordChunk, &sink);
+    renderConfigPage(out, page);
+    out.flush();
+    if (sinkOut != nullptr) {
+        *sinkOut = sink;
+    }
+    return sink.output;
+}
+
+static bool contains(const std::string& html, const std::string& text) {
+    return html.find(text) != std::string::npos;
+}
+
+static size_t countOf(const std::string& html, const std::string& text) {
+    size_t count = 0;
+    for (size_t pos = html.find(text); pos != std::string::npos; pos = html.find(text, pos + 1)) {
+        count++;
+    }
+    return count;
+}
+
+static bool writeGreeting(void* context, TemplateWriter& out, const char* name, size_t length) {
+    if (isTemplateName(name, length, "NAME")) {
+        out.write(static_cast<const char*>(context));
+        return true;
+    }
+    return false;
+}
+
+// ============================================================================
+// TemplateWriter
+// ============================================================================
+
+TEST(TemplateWriterTest, FlushesWhenBufferFull) {
+    char buffer[4];
+    RecordingSink sink;
+    TemplateWriter out(buffer, sizeof(buffer), recordChunk, &sink);
+    out.write("abcdefghij");
+    EXPECT_EQ("abcdefgh", sink.output);  // Two full buffers, "ij" still buffered
+    out.flush();
+    EXPECT_EQ("abcdefghij", sink.output);
+    ASSERT_EQ(3u, sink.chunks.size());
+    EXPECT_EQ(4u, sink.chunks[0]);
+    EXPECT_EQ(2u, sink.chunks[2]);
+    EXPECT_EQ(10u, out.getTotalWritten());
+    EXPECT_EQ(3u, out.getFlushCount());
+}
+
+TEST(TemplateWriterTest, EmptyFlushSendsNothing) {
+    char buffer[8];
+    RecordingSink sink;
+    TemplateWriter out(buffer, sizeof(buffer), recordChunk, &sink);
+    out.flush();
+    out.write(nullptr);
+    out.flush();
+    EXPECT_TRUE(sink.chunks.empty());
+}
+
+TEST(TemplateWriterTest, EscapesHtml) {
+    char buffer[16];
+    RecordingSink sink;
+    TemplateWriter out(buffer, sizeof(buffer), recordChunk, &sink);
+    out.writeEscaped("a<b>&\"c'd");
+    out.flush();
+    EXPECT_EQ("a&lt;b&gt;&amp;&quot;c&#39;d", sink.output);
+}
+
+TEST(TemplateWriterTest, FormatsNumbers) {
+    char buffer[16];
+    RecordingSink sink;
+    TemplateWriter out(buffer, sizeof(buffer), recordChunk, &sink);
+    out.writef("%02u:%.2f", 7u, 1.5);
+    out.flush();
+    EXPECT_EQ("07:1.50", sink.output);
+}
+
+// ============================================================================
+// renderTemplate
+// ============================================================================
+
+TEST(RenderTemplateTest, SubstitutesPlaceholders) {
+    char buffer[8];
+    RecordingSink sink;
+    TemplateWriter out(buffer, sizeof(buffer), recordChunk, &sink);
+    renderTemplate(out, "Hello %NAME%, %NAME%!", writeGreeting, (void*)"Ada");
+    out.flush();
+    EXPECT_EQ("Hello Ada, Ada!", sink.output);
+}
+
+TEST(RenderTemplateTest, KeepsUnknownPlaceholdersAndPlainPercent) {
+    char buffer[8];
+    RecordingSink sink;
+    TemplateWriter out(buffer, sizeof(buffer), recordChunk, &sink);
+    renderTemplate(out, "width: 100%; %OTHER% %lower% 50% %NAME%", writeGreeting, (void*)"x");
+    out.flush();
+    EXPECT_EQ("width: 100%; %OTHER% %lower% 50% x", sink.output);
+}
+
+TEST(RenderTemplateTest, MatchesWholeNamesOnly) {
+    EXPECT_TRUE(isTemplateName("PREFETCH_MAX", 12, "PREFETCH_MAX"));
+    EXPECT_FALSE(isTemplateName("PREFETCH_MAX", 12, "PREFETCH_MAX_HOURS"));
+    EXPECT_FALSE(isTemplateName("PREFETCH_MAX_HOURS", 18, "PREFETCH_MAX"));
+}
+
+// ============================================================================
+// Configuration page
+// ============================================================================
+
+TEST(ConfigPageTest, BootModeOnlyAsksForWiFi) {
+    DashboardConfig config;
+    std::string html = render(makePage(config, false, false));
+    EXPECT_TRUE(contains(html, "Step 1: Connect to WiFi"));
+    EXPECT_TRUE(contains(html, "name='ssid'"));
+    EXPECT_TRUE(contains(html, "➡️ Next: Configure Dashboard"));
+    EXPECT_FALSE(contains(html, "name='ip_mode'"));
+    EXPECT_FALSE(contains(html, "img_url_0"));
+    EXPECT_FALSE(contains(html, "mqttbroker"));
+    EXPECT_FALSE(contains(html, CONFIG_PORTAL_BADGE_HTML));
+    EXPECT_TRUE(contains(html, "</body></html>"));
+}
+
+TEST(ConfigPageTest, ConfigModeShowsEverySection) {
+    DashboardConfig config = makeConfig();
+    std::string html = render(makePage(config, true, true));
+    EXPECT_TRUE(contains(html, "Update your dashboard configuration"));
+    EXPECT_TRUE(contains(html, "name='ip_mode'"));
+    EXPECT_TRUE(contains(html, "img_url_9"));
+    EXPECT_TRUE(contains(html, "mqttbroker"));
+    EXPECT_TRUE(contains(html, "hour_23"));
+    EXPECT_TRUE(contains(html, "🔄 Update Configuration"));
+    EXPECT_TRUE(contains(html, CONFIG_PORTAL_VCOM_BUTTON));
+    EXPECT_TRUE(contains(html, CONFIG_PORTAL_BADGE_HTML));
+    EXPECT_TRUE(contains(html, PORTAL_STYLES_CSS_URL));
+    EXPECT_TRUE(contains(html, PORTAL_MAIN_JS_URL));
+}
+
+TEST(ConfigPageTest, NoPlaceholderLeftUnresolved) {
+    DashboardConfig config = makeConfig();
+    EnergyStats stats = { 0.25f, 6.5f, 12 };
+    ConfigPageContext page = makePage(config, true, true);
+    page.frontlightAvailable = true;
+    page.energyStats = &stats;
+    std::string pages[] = { render(page), render(makePage(config, false, false)),
+                            render(makePage(config, true, false)) };
+    std::regex placeholder("%[A-Z0-9_]+%");
+    for (const std::string& html : pages) {
+        std::smatch match;
+        EXPECT_FALSE(std::regex_search(html, match, placeholder)) << match.str();
+        EXPECT_EQ(countOf(html, "<div"), countOf(html, "</div>"));
+    }
+}
+
+TEST(ConfigPageTest, StoredValuesFillTheForm) {
+    DashboardConfig config = makeConfig();
+    std::string html = render(makePage(config, true, true));
+    EXPECT_TRUE(contains(html, "value='HomeNet'"));
+    EXPECT_TRUE(contains(html, "Password is set. Leave empty to keep current password."));
+    EXPECT_TRUE(contains(html, "value='https://ha.example.com/local/calendar.png'"));
+    EXPECT_TRUE(contains(html, " value='mqtt://192.168.1.10:1883'"));
+    EXPECT_TRUE(contains(html, "<option value='2' selected>180° (Inverted Landscape)</option>"));
+    EXPECT_TRUE(contains(html, "<option value='2' selected>Bottom Left</option>"));
+    EXPECT_TRUE(contains(html, "<option value='2' selected>Large</option>"));
+    EXPECT_TRUE(contains(html, "<option value='3' selected>White</option>"));
+    EXPECT_TRUE(contains(html, "<option value='http' selected>"));
+    EXPECT_FALSE(contains(html, "<option value='0' selected>0°"));
+}
+
+TEST(ConfigPageTest, CarouselRowsBeyondImageCountAreHidden) {
+    DashboardConfig config = makeConfig();
+    std::string html = render(makePage(config, true, true));
+    // Slot 0 is always shown, slot 1 is used, slots 2-9 wait for "Add image"
+    EXPECT_EQ(8u, countOf(html, "' style='display:none;'><div style='display: flex;"));
+    EXPECT_FALSE(contains(html, "id='slot_1' style="));
+    EXPECT_TRUE(contains(html, "name='img_stay_1' checked>"));
+    EXPECT_FALSE(contains(html, "name='img_stay_0' checked>"));
+    EXPECT_TRUE(contains(html, "name='img_int_1' min='0' placeholder='5' value='60'>"));
+    EXPECT_TRUE(contains(html, "name='img_int_5' min='0' placeholder='5' value='5'>"));
+}
+
+TEST(ConfigPageTest, HourGridFollowsBitmask) {
+    DashboardConfig config = makeConfig();
+    std::string html = render(makePage(config, true, true));
+    EXPECT_EQ(24u - 9u, countOf(html, "class='hour-checkbox' checked>"));
+    EXPECT_TRUE(contains(html, "name='hour_8' class='hour-checkbox' checked>"));
+    EXPECT_FALSE(contains(html, "name='hour_7' class='hour-checkbox' checked>"));
+    EXPECT_TRUE(contains(html, "<div>23:00</div><div style='font-size: 11px; color: #999; margin-top: 1px;'>to 00:00</div>"));
+}
+
+TEST(ConfigPageTest, DefaultsWithoutStoredConfig) {
+    DashboardConfig config = makeConfig();  // Stored values must not show
+    std::string html = render(makePage(config, true, false));
+    EXPECT_TRUE(contains(html, "Step 2: Configure your dashboard"));
+    EXPECT_TRUE(contains(html, "💾 Save Configuration"));
+    EXPECT_FALSE(contains(html, "calendar.png"));
+    EXPECT_FALSE(contains(html, "mqtt-password"));
+    EXPECT_EQ(9u, countOf(html, "' style='display:none;'><div style='display: flex;"));
+    EXPECT_EQ(24u, countOf(html, "class='hour-checkbox' checked>"));
+    EXPECT_TRUE(contains(html, "<option value='1' selected>Top Right</option>"));
+    EXPECT_TRUE(contains(html, "<option value='crc32' selected>"));
+}
+
+TEST(ConfigPageTest, StoredValuesAreEscaped) {
+    DashboardConfig config = makeConfig();
+    config.wifiSSID = "Cafe' onfocus='alert(1)";
+    config.friendlyName = "<script>";
+    std::string html = render(makePage(config, true, true));
+    EXPECT_TRUE(contains(html, "value='Cafe&#39; onfocus=&#39;alert(1)'"));
+    EXPECT_FALSE(contains(html, "<script>"));
+}
+
+TEST(ConfigPageTest, NetworkInfoShowsChannelLock) {
+    DashboardConfig config = makeConfig();
+    ConfigPageContext page = makePage(config, true, true);
+    page.channelLocked = true;
+    page.channel = 6;
+    uint8_t bssid[6] = { 0xAA, 0xBB, 0xCC, 0x01, 0x02, 0x03 };
+    memcpy(page.bssid, bssid, sizeof(bssid));
+    std::string html = render(page);
+    EXPECT_TRUE(contains(html, "<small>Channel 6, BSSID AA:BB:CC:01:02:03</small>"));
+    EXPECT_TRUE(contains(html, "<a href='http://kitchen.local' target='_blank'>kitchen.local</a><br>"));
+}
+
+TEST(ConfigPageTest, MeasuredEnergyOnlyAfterWakes) {
+    DashboardConfig config = makeConfig();
+    EnergyStats stats = { 0.25f, 6.5f, 0 };
+    ConfigPageContext page = makePage(config, true, true);
+    page.energyStats = &stats;
+    EXPECT_FALSE(contains(render(page), "id='measured-energy'"));
+
+    stats.cycles = 12;
+    std::string html = render(page);
+    EXPECT_TRUE(contains(html, "data-cycle-mah='0.2500'"));
+    EXPECT_TRUE(contains(html, "data-awake-sec='6.50'"));
+    EXPECT_TRUE(contains(html, "Saved Settings ("));
+}
+
+TEST(ConfigPageTest, OutputIndependentOfBufferSize) {
+    DashboardConfig config = makeConfig();
+    ConfigPageContext page = makePage(config, true, true);
+    RecordingSink small;
+    std::string tiny = render(page, 7, &small);
+    EXPECT_EQ(render(page, CONFIG_PAGE_BUFFER_SIZE), tiny);
+    for (size_t i = 0; i + 1 < small.chunks.size(); i++) {
+        EXPECT_EQ(7u, small.chunks[i]);  // Only the last chunk is partial
+    }
+}
+
+TEST(ConfigPageTest, RendersWithoutHeapAllocation) {
+    DashboardConfig config = makeConfig();
+    EnergyStats stats = { 0.25f, 6.5f, 12 };
+    ConfigPageContext page = makePage(config, true, true);
+    page.energyStats = &stats;
+    static FixedSink sink;
+    sink.length = 0;
+    char buffer[CONFIG_PAGE_BUFFER_SIZE];
+
+    g_heapAllocations = 0;
+    TemplateWriter out(buffer, sizeof(buffer), copyChunk, &sink);
+    renderConfigPage(out, page);
+    out.flush();
+    int allocations = g_heapAllocations;
+
+    EXPECT_EQ(0, allocations);
+    EXPECT_EQ(out.getTotalWritten(), sink.length);
+    EXPECT_LE(sink.length, sizeof(sink.data));
+}
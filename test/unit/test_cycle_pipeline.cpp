@@ -0,0 +1,233 @@
+#include <gtest/gtest.h>
+#include <cycle_pipeline.h>
+#include <string>
+
+// Mock task layer with a simulated clock. The background stage runs when
+// join() is called, starting from the clock value at start(), so the two
+// stages behave as if they ran side by side.
+class MockTaskRunner : public PipelineTaskRunner {
+public:
+    uint32_t clock = 1000;
+    bool failStart = false;
+    bool neverFinishes = false;
+    int startCalls = 0;
+    int joinCalls = 0;
+    uint32_t lastJoinTimeout = 0;
+
+    bool start(PipelineStage stage, void* arg) override {
+        startCalls++;
+        if (failStart) {
+            return false;
+        }
+        _stage = stage;
+        _arg = arg;
+        _startedAt = clock;
+        return true;
+    }
+
+    bool join(uint32_t timeoutMs) override {
+        joinCalls++;
+        lastJoinTimeout = timeoutMs;
+        if (neverFinishes) {
+            clock += timeoutMs;
+            return false;
+        }
+        uint32_t foregroundEnd = clock;
+        clock = _startedAt;
+        _stage(_arg);
+        if (clock < foregroundEnd) {
+            clock = foregroundEnd;
+        }
+        return true;
+    }
+
+    uint32_t nowMs() override {
+        return clock;
+    }
+
+private:
+    PipelineStage _stage = nullptr;
+    void* _arg = nullptr;
+    uint32_t _startedAt = 0;
+};
+
+// A stage that advances the mock clock and records that it ran
+struct StageRecord {
+    MockTaskRunner* runner;
+    uint32_t durationMs;
+    char name;
+    std::string* order;
+};
+
+static void runStage(void* arg) {
+    StageRecord* record = static_cast<StageRecord*>(arg);
+    if (record->runner != nullptr) {
+        record->runner->clock += record->durationMs;
+    }
+    *record->order += record->name;
+}
+
+// Test fixture for the cycle pipeline scheduler
+class CyclePipelineTest : public ::testing::Test {
+protected:
+    MockTaskRunner runner;
+    std::string order;
+
+    StageRecord refresh(uint32_t ms) { return { &runner, ms, 'R', &order }; }
+    StageRecord telemetry(uint32_t ms) { return { &runner, ms, 'T', &order }; }
+};
+
+// ============================================================================
+// Overlapped Runs
+// ============================================================================
+
+TEST_F(CyclePipelineTest, Overlapped_WallTimeIsLongerStage) {
+    CyclePipeline pipeline(&runner);
+    StageRecord fg = refresh(1700);
+    StageRecord bg = telemetry(300);
+
+    PipelineResult result = pipeline.run(runStage, &fg, runStage, &bg);
+
+    EXPECT_TRUE(result.overlapped);
+    EXPECT_FALSE(result.timedOut);
+    EXPECT_EQ(result.foreground_ms, 1700u);
+    EXPECT_EQ(result.background_ms, 300u);
+    EXPECT_EQ(result.total_ms, 1700u);
+    EXPECT_EQ(getPipelineSavedMs(result), 300u);
+}
+
+TEST_F(CyclePipelineTest, Overlapped_BackgroundOutlastsForeground) {
+    CyclePipeline pipeline(&runner);
+    StageRecord fg = refresh(500);
+    StageRecord bg = telemetry(2000);
+
+    PipelineResult result = pipeline.run(runStage, &fg, runStage, &bg);
+
+    EXPECT_EQ(result.foreground_ms, 500u);
+    EXPECT_EQ(result.background_ms, 2000u);
+    EXPECT_EQ(result.total_ms, 2000u);
+    EXPECT_EQ(getPipelineSavedMs(result), 500u);
+}
+
+TEST_F(CyclePipelineTest, Overlapped_BothStagesRunOnceAndJoinBeforeReturn) {
+    CyclePipeline pipeline(&runner);
+    StageRecord fg = refresh(100);
+    StageRecord bg = telemetry(100);
+
+    pipeline.run(runStage, &fg, runStage, &bg);
+
+    EXPECT_EQ(runner.startCalls, 1);
+    EXPECT_EQ(runner.joinCalls, 1);
+    EXPECT_EQ(order.size(), 2u);
+    EXPECT_NE(order.find('R'), std::string::npos);
+    EXPECT_NE(order.find('T'), std::string::npos);
+}
+
+TEST_F(CyclePipelineTest, Overlapped_UsesConfiguredJoinTimeout) {
+    CyclePipeline defaultPipeline(&runner);
+    StageRecord fg = refresh(10);
+    StageRecord bg = telemetry(10);
+    defaultPipeline.run(runStage, &fg, runStage, &bg);
+    EXPECT_EQ(runner.lastJoinTimeout, (uint32_t)CYCLE_PIPELINE_JOIN_TIMEOUT_MS);
+
+    CyclePipeline shortPipeline(&runner, 250);
+    shortPipeline.run(runStage, &fg, runStage, &bg);
+    EXPECT_EQ(runner.lastJoinTimeout, 250u);
+}
+
+TEST_F(CyclePipelineTest, Overlapped_ReusableAcrossRuns) {
+    CyclePipeline pipeline(&runner);
+    StageRecord fg = refresh(1000);
+    StageRecord bg = telemetry(200);
+    pipeline.run(runStage, &fg, runStage, &bg);
+
+    StageRecord bg2 = telemetry(1500);
+    PipelineResult result = pipeline.run(runStage, &fg, runStage, &bg2);
+
+    EXPECT_EQ(result.background_ms, 1500u);
+    EXPECT_EQ(result.total_ms, 1500u);
+    EXPECT_EQ(order, "RTRT");
+}
+
+// ============================================================================
+// Timeout
+// ============================================================================
+
+TEST_F(CyclePipelineTest, Timeout_ReportedAndBackgroundTimeUnknown) {
+    runner.neverFinishes = true;
+    CyclePipeline pipeline(&runner, 5000);
+    StageRecord fg = refresh(1700);
+    StageRecord bg = telemetry(300);
+
+    PipelineResult result = pipeline.run(runStage, &fg, runStage, &bg);
+
+    EXPECT_TRUE(result.overlapped);
+    EXPECT_TRUE(result.timedOut);
+    EXPECT_EQ(result.foreground_ms, 1700u);
+    EXPECT_EQ(result.background_ms, 0u);
+    EXPECT_EQ(result.total_ms, 6700u);
+    EXPECT_EQ(getPipelineSavedMs(result), 0u);
+    EXPECT_EQ(order, "R");  // Background never ran inline as well
+}
+
+// ============================================================================
+// Serial Fallback
+// ============================================================================
+
+TEST_F(CyclePipelineTest, StartFails_RunsSeriallyForegroundFirst) {
+    runner.failStart = true;
+    CyclePipeline pipeline(&runner);
+    StageRecord fg = refresh(1700);
+    StageRecord bg = telemetry(300);
+
+    PipelineResult result = pipeline.run(runStage, &fg, runStage, &bg);
+
+    EXPECT_FALSE(result.overlapped);
+    EXPECT_FALSE(result.timedOut);
+    EXPECT_EQ(order, "RT");
+    EXPECT_EQ(runner.joinCalls, 0);
+    EXPECT_EQ(result.foreground_ms, 1700u);
+    EXPECT_EQ(result.background_ms, 300u);
+    EXPECT_EQ(result.total_ms, 2000u);
+    EXPECT_EQ(getPipelineSavedMs(result), 0u);
+}
+
+TEST_F(CyclePipelineTest, NoRunner_RunsSerially) {
+    CyclePipeline pipeline(nullptr);
+    StageRecord fg = { nullptr, 0, 'R', &order };
+    StageRecord bg = { nullptr, 0, 'T', &order };
+
+    PipelineResult result = pipeline.run(runStage, &fg, runStage, &bg);
+
+    EXPECT_FALSE(result.overlapped);
+    EXPECT_FALSE(result.timedOut);
+    EXPECT_EQ(order, "RT");
+    EXPECT_EQ(result.total_ms, 0u);  // No clock without a task layer
+}
+
+TEST_F(CyclePipelineTest, NoBackground_DoesNotStartTask) {
+    CyclePipeline pipeline(&runner);
+    StageRecord fg = refresh(1700);
+
+    PipelineResult result = pipeline.run(runStage, &fg, nullptr, nullptr);
+
+    EXPECT_FALSE(result.overlapped);
+    EXPECT_EQ(runner.startCalls, 0);
+    EXPECT_EQ(runner.joinCalls, 0);
+    EXPECT_EQ(order, "R");
+    EXPECT_EQ(result.foreground_ms, 1700u);
+    EXPECT_EQ(result.background_ms, 0u);
+    EXPECT_EQ(result.total_ms, 1700u);
+}
+
+TEST_F(CyclePipelineTest, NoForeground_StillRunsBackground) {
+    CyclePipeline pipeline(&runner);
+    StageRecord bg = telemetry(300);
+
+    PipelineResult result = pipeline.run(nullptr, nullptr, runStage, &bg);
+
+    EXPECT_TRUE(result.overlapped);
+    EXPECT_EQ(order, "T");
+    EXPECT_EQ(result.foreground_ms, 0u);
+    EXPECT_EQ(result.total_ms, 300u);
+}
@@ -0,0 +1,291 @@
+#include <gtest/gtest.h>
+#include "config.h"
+#include <dashboard_config.h>
+#include <config_blob.h>
+#include <energy_model.h>
+#include "../../common/src/modes/decision_logic.h"
+#include <cstring>
+#include <string>
+
+// Test fixture for the fixed-capacity configuration and its conversion from the stored blob
+class DashboardConfigTest : public ::testing::Test {
+protected:
+    ConfigBlob blob;
+
+    void SetUp() override {
+        initConfigBlob(blob);
+    }
+
+    // Two-image carousel with MQTT and static IP
+    void fillConfig(DashboardConfig& config) {
+        config.wifiSSID = "HomeNet";
+        config.wifiPassword = "secret123";
+        config.friendlyName = "kitchen";
+        config.mqttBroker = "mqtt://broker.local:1883";
+        config.mqttUsername = "ha";
+        config.mqttPassword = "mqttpw";
+        config.mqttBatchedState = true;
+        config.useCRC32Check = true;
+        config.changeDetection = CHANGE_DETECTION_HTTP;
+        config.tlsFingerprint = "AB:CD";
+        config.updateHours[0] = 0x0F;
+        config.updateHours[1] = 0xF0;
+        config.updateHours[2] = 0x3C;
+        config.timezoneOffset = -5;
+        config.screenRotation = 3;
+        config.partialRefresh = true;
+        config.fullRefreshEvery = 4;
+        config.useStaticIP = true;
+        config.staticIP = "192.168.1.50";
+        config.gateway = "192.168.1.1";
+        config.subnet = "255.255.255.0";
+        config.primaryDNS = "1.1.1.1";
+        config.imageCount = 2;
+        config.imageUrls[0] = "http://example.com/a.png";
+        config.imageIntervals[0] = 15;
+        config.imageUrls[1] = "http://example.com/b.png";
+        config.imageIntervals[1] = 0;
+        config.imageStay[1] = true;
+        config.prefetchCount = 1;
+        config.frontlightDuration = 30;
+        config.frontlightBrightness = 40;
+        config.overlayEnabled = true;
+        config.overlayPosition = OVERLAY_POS_BOTTOM_LEFT;
+        config.overlayShowBatteryIcon = false;
+        config.overlayShowCycleTime = true;
+        config.overlaySize = OVERLAY_SIZE_LARGE;
+        config.overlayTextColor = OVERLAY_COLOR_WHITE;
+    }
+};
+
+// ============================================================================
+// FixedString
+// ============================================================================
+
+TEST_F(DashboardConfigTest, FixedStringStartsEmpty) {
+    FixedString<8> value;
+    EXPECT_STREQ("", value.c_str());
+    EXPECT_EQ(0u, value.length());
+    EXPECT_TRUE(value.isEmpty());
+}
+
+TEST_F(DashboardConfigTest, FixedStringHoldsValuesUpToItsCapacity) {
+    FixedString<8> value;
+    EXPECT_TRUE(value.assign("12345678"));
+    EXPECT_STREQ("12345678", value.c_str());
+    EXPECT_EQ(8u, value.length());
+
+    value = "abc";
+    EXPECT_STREQ("abc", value.c_str());
+    EXPECT_EQ(3u, value.length());
+}
+
+TEST_F(DashboardConfigTest, FixedStringTruncatesLongerValues) {
+    FixedString<8> value;
+    EXPECT_FALSE(value.assign("123456789"));
+    EXPECT_STREQ("12345678", value.c_str());
+    EXPECT_EQ(8u, value.length());
+}
+
+TEST_F(DashboardConfigTest, FixedStringAssignsFromStringTypes) {
+    FixedString<16> value;
+    value = String("from arduino");
+    EXPECT_STREQ("from arduino", value.c_str());
+    value = std::string("from std");
+    EXPECT_STREQ("from std", value.c_str());
+    value.assign(nullptr);
+    EXPECT_TRUE(value.isEmpty());
+}
+
+TEST_F(DashboardConfigTest, FixedStringComparesWithCStrings) {
+    FixedString<16> value("abc");
+    EXPECT_TRUE(value == "abc");
+    EXPECT_TRUE(value != "abd");
+    EXPECT_TRUE(value != "ab");
+    EXPECT_FALSE(value == nullptr);
+}
+
+TEST_F(DashboardConfigTest, FixedStringCopyIsIndependent) {
+    FixedString<16> a("first");
+    FixedString<16> b = a;
+    a = "second";
+    EXPECT_STREQ("first", b.c_str());
+    EXPECT_STREQ("second", a.c_str());
+}
+
+// ============================================================================
+// Conversion from / to the stored blob
+// ============================================================================
+
+TEST_F(DashboardConfigTest, CapacitiesMatchTheStoredLimits) {
+    DashboardConfig config;
+    EXPECT_EQ(getConfigStringLimit(CONFIG_STR_WIFI_SSID), config.wifiSSID.capacity());
+    EXPECT_EQ(getConfigStringLimit(CONFIG_STR_WIFI_PASSWORD), config.wifiPassword.capacity());
+    EXPECT_EQ(getConfigStringLimit(CONFIG_STR_FRIENDLY_NAME), config.friendlyName.capacity());
+    EXPECT_EQ(getConfigStringLimit(CONFIG_STR_MQTT_BROKER), config.mqttBroker.capacity());
+    EXPECT_EQ(getConfigStringLimit(CONFIG_STR_MQTT_USERNAME), config.mqttUsername.capacity());
+    EXPECT_EQ(getConfigStringLimit(CONFIG_STR_MQTT_PASSWORD), config.mqttPassword.capacity());
+    EXPECT_EQ(getConfigStringLimit(CONFIG_STR_TLS_FINGERPRINT), config.tlsFingerprint.capacity());
+    EXPECT_EQ(getConfigStringLimit(CONFIG_STR_STATIC_IP), config.staticIP.capacity());
+    EXPECT_EQ(getConfigStringLimit(CONFIG_STR_GATEWAY), config.gateway.capacity());
+    EXPECT_EQ(getConfigStringLimit(CONFIG_STR_SUBNET), config.subnet.capacity());
+    EXPECT_EQ(getConfigStringLimit(CONFIG_STR_PRIMARY_DNS), config.primaryDNS.capacity());
+    EXPECT_EQ(getConfigStringLimit(CONFIG_STR_SECONDARY_DNS), config.secondaryDNS.capacity());
+    EXPECT_EQ(getConfigStringLimit(CONFIG_STR_IMAGE_URL), config.imageUrls[0].capacity());
+}
+
+TEST_F(DashboardConfigTest, EmptyBlobReadsAsTheDefaults) {
+    DashboardConfig defaults;
+    DashboardConfig config;
+    config.wifiSSID = "stale";
+    config.imageCount = 3;
+    readDashboardConfig(blob, config);
+
+    EXPECT_FALSE(config.isConfigured);
+    EXPECT_TRUE(config.wifiSSID.isEmpty());
+    EXPECT_EQ(0, config.imageCount);
+    EXPECT_EQ(defaults.changeDetection, config.changeDetection);
+    EXPECT_EQ(0, memcmp(defaults.updateHours, config.updateHours, 3));
+    EXPECT_EQ(defaults.screenRotation, config.screenRotation);
+    EXPECT_EQ(defaults.fullRefreshEvery, config.fullRefreshEvery);
+    EXPECT_EQ(defaults.prefetchCount, config.prefetchCount);
+    EXPECT_EQ(defaults.frontlightBrightness, config.frontlightBrightness);
+    EXPECT_EQ(defaults.overlayEnabled, config.overlayEnabled);
+    EXPECT_EQ(defaults.overlayPosition, config.overlayPosition);
+    EXPECT_EQ(defaults.overlayShowBatteryIcon, config.overlayShowBatteryIcon);
+    EXPECT_EQ(defaults.overlayShowBatteryPercentage, config.overlayShowBatteryPercentage);
+    EXPECT_EQ(defaults.overlayShowUpdateTime, config.overlayShowUpdateTime);
+    EXPECT_EQ(defaults.overlayShowCycleTime, config.overlayShowCycleTime);
+    EXPECT_EQ(defaults.overlaySize, config.overlaySize);
+    EXPECT_EQ(defaults.overlayTextColor, config.overlayTextColor);
+}
+
+TEST_F(DashboardConfigTest, WrittenConfigReadsBack) {
+    DashboardConfig written;
+    fillConfig(written);
+    writeDashboardConfig(written, blob);
+    sealConfigBlob(blob);
+    ASSERT_TRUE(isConfigBlobValid((const uint8_t*)&blob, blob.size));
+
+    DashboardConfig config;
+    readDashboardConfig(blob, config);
+    EXPECT_STREQ("HomeNet", config.wifiSSID.c_str());
+    EXPECT_STREQ("secret123", config.wifiPassword.c_str());
+    EXPECT_STREQ("kitchen", config.friendlyName.c_str());
+    EXPECT_STREQ("mqtt://broker.local:1883", config.mqttBroker.c_str());
+    EXPECT_STREQ("ha", config.mqttUsername.c_str());
+    EXPECT_STREQ("mqttpw", config.mqttPassword.c_str());
+    EXPECT_TRUE(config.mqttBatchedState);
+    EXPECT_TRUE(config.useCRC32Check);
+    EXPECT_EQ(CHANGE_DETECTION_HTTP, config.changeDetection);
+    EXPECT_STREQ("AB:CD", config.tlsFingerprint.c_str());
+    EXPECT_EQ(0x0F, config.updateHours[0]);
+    EXPECT_EQ(0xF0, config.updateHours[1]);
+    EXPECT_EQ(0x3C, config.updateHours[2]);
+    EXPECT_EQ(-5, config.timezoneOffset);
+    EXPECT_EQ(3, config.screenRotation);
+    EXPECT_TRUE(config.partialRefresh);
+    EXPECT_EQ(4, config.fullRefreshEvery);
+    EXPECT_TRUE(config.useStaticIP);
+    EXPECT_STREQ("192.168.1.50", config.staticIP.c_str());
+    EXPECT_STREQ("192.168.1.1", config.gateway.c_str());
+    EXPECT_STREQ("255.255.255.0", config.subnet.c_str());
+    EXPECT_STREQ("1.1.1.1", config.primaryDNS.c_str());
+    EXPECT_TRUE(config.secondaryDNS.isEmpty());
+    EXPECT_EQ(2, config.imageCount);
+    EXPECT_STREQ("http://example.com/a.png", config.imageUrls[0].c_str());
+    EXPECT_STREQ("http://example.com/b.png", config.imageUrls[1].c_str());
+    EXPECT_EQ(15, config.imageIntervals[0]);
+    EXPECT_EQ(0, config.imageIntervals[1]);
+    EXPECT_FALSE(config.imageStay[0]);
+    EXPECT_TRUE(config.imageStay[1]);
+    EXPECT_EQ(1, config.prefetchCount);
+    EXPECT_EQ(30, config.frontlightDuration);
+    EXPECT_EQ(40, config.frontlightBrightness);
+    EXPECT_TRUE(config.overlayEnabled);
+    EXPECT_EQ(OVERLAY_POS_BOTTOM_LEFT, config.overlayPosition);
+    EXPECT_FALSE(config.overlayShowBatteryIcon);
+    EXPECT_TRUE(config.overlayShowBatteryPercentage);
+    EXPECT_TRUE(config.overlayShowUpdateTime);
+    EXPECT_TRUE(config.overlayShowCycleTime);
+    EXPECT_EQ(OVERLAY_SIZE_LARGE, config.overlaySize);
+    EXPECT_EQ(OVERLAY_COLOR_WHITE, config.overlayTextColor);
+}
+
+TEST_F(DashboardConfigTest, WriteClearsUnusedSlots) {
+    DashboardConfig config;
+    fillConfig(config);
+    config.imageUrls[5] = "http://example.com/stale.png";
+    config.imageIntervals[5] = 30;
+    config.imageStay[5] = true;
+    writeDashboardConfig(config, blob);
+
+    EXPECT_STREQ("", getConfigString(blob, (ConfigStringId)(CONFIG_STR_IMAGE_URL + 5)));
+    EXPECT_EQ(0, blob.settings.imageIntervals[5]);
+    EXPECT_EQ(0, blob.settings.imageStayMask & (1 << 5));
+}
+
+TEST_F(DashboardConfigTest, WriteLeavesTheConfiguredFlag) {
+    DashboardConfig config;
+    fillConfig(config);
+    config.isConfigured = true;
+    writeDashboardConfig(config, blob);
+    EXPECT_EQ(0, blob.settings.flags & CONFIG_FLAG_CONFIGURED);
+
+    blob.settings.flags |= CONFIG_FLAG_CONFIGURED;
+    config.isConfigured = false;
+    writeDashboardConfig(config, blob);
+    EXPECT_NE(0, blob.settings.flags & CONFIG_FLAG_CONFIGURED);
+}
+
+// ============================================================================
+// Heap allocations (counted by the mocked Arduino String)
+// ============================================================================
+
+TEST_F(DashboardConfigTest, FillingAndCopyingAllocateNothing) {
+    String::allocations() = 0;
+    DashboardConfig config;
+    fillConfig(config);
+    DashboardConfig copy = config;
+    EXPECT_STREQ("HomeNet", copy.wifiSSID.c_str());
+    EXPECT_EQ(0, String::allocations());
+}
+
+TEST_F(DashboardConfigTest, TimerWakeAllocatesNothingForConfiguration) {
+    // Stored configuration mirrored in RTC memory by an earlier wake
+    static DashboardConfig saved;
+    fillConfig(saved);
+    saved.imageStay[1] = false;
+    saved.imageIntervals[1] = 60;
+    writeDashboardConfig(saved, blob);
+    blob.settings.flags |= CONFIG_FLAG_CONFIGURED;
+    sealConfigBlob(blob);
+    static ConfigCache cache;
+    updateConfigCache(cache, blob);
+
+    // What ConfigManager::getConfig() and the normal cycle do with it
+    String::allocations() = 0;
+    static ConfigBlob restored;
+    ASSERT_TRUE(restoreConfigCache(cache, restored));
+    static DashboardConfig config;
+    readDashboardConfig(restored, config);
+    const DashboardConfig& view = config;
+    float wakesPerDay = calculateWakesPerDay(view.imageIntervals, view.imageStay, view.imageCount, view.updateHours);
+    NormalModeDecisions decisions = orchestrateNormalModeDecisions(view, WAKEUP_TIMER, 0);
+    const char* url = view.imageUrls[decisions.finalIndex].c_str();
+
+    EXPECT_EQ(0, String::allocations());
+    EXPECT_TRUE(view.isConfigured);
+    EXPECT_GT(wakesPerDay, 0.0f);
+    EXPECT_STREQ("http://example.com/b.png", url);
+}
+
+TEST_F(DashboardConfigTest, StringValuesAreCounted) {
+    // The counter itself: a String copy of a configuration value allocates
+    DashboardConfig config;
+    fillConfig(config);
+    String::allocations() = 0;
+    String url = config.imageUrls[0].c_str();
+    EXPECT_EQ(1, String::allocations());
+    EXPECT_STREQ("http://example.com/a.png", url.c_str());
+}
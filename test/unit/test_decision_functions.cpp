@@ -201,6 +201,92 @@ TEST_F(DecisionFunctionsTest, CRC32Action_CarouselMixedStay_ChecksOnlyStayTrue)
     EXPECT_FALSE(result.shouldCheck);
 }
 
+TEST_F(DecisionFunctionsTest, CRC32Action_Strategy_FollowsConfig) {
+    config = createSingleImageConfig();
+    
+    // Disabled: no strategy regardless of method
+    config.useCRC32Check = false;
+    config.changeDetection = CHANGE_DETECTION_HTTP;
+    EXPECT_EQ(determineCRC32Action(config, WAKEUP_TIMER, 0).strategy, CHANGE_STRATEGY_NONE);
+    
+    // Enabled with default method: CRC32 sidecar
+    config.useCRC32Check = true;
+    config.changeDetection = CHANGE_DETECTION_CRC32;
+    EXPECT_EQ(determineCRC32Action(config, WAKEUP_TIMER, 0).strategy, CHANGE_STRATEGY_CRC32);
+    
+    // Enabled with HTTP method: conditional GET
+    config.changeDetection = CHANGE_DETECTION_HTTP;
+    EXPECT_EQ(determineCRC32Action(config, WAKEUP_TIMER, 0).strategy, CHANGE_STRATEGY_CONDITIONAL_GET);
+}
+
+TEST_F(DecisionFunctionsTest, CRC32Action_ConditionalGet_SameCheckRulesAsCRC32) {
+    config = createCarouselConfig(3);
+    config.useCRC32Check = true;
+    config.changeDetection = CHANGE_DETECTION_HTTP;
+    config.imageStay[1] = true;
+    
+    // Strategy is reported even when not checking (validators are still collected)
+    auto result = determineCRC32Action(config, WAKEUP_BUTTON, 1);
+    EXPECT_FALSE(result.shouldCheck);
+    EXPECT_EQ(result.strategy, CHANGE_STRATEGY_CONDITIONAL_GET);
+    
+    result = determineCRC32Action(config, WAKEUP_TIMER, 0);
+    EXPECT_FALSE(result.shouldCheck);
+    
+    result = determineCRC32Action(config, WAKEUP_TIMER, 1);
+    EXPECT_TRUE(result.shouldCheck);
+    EXPECT_STREQ(result.reason, "Carousel - timer wake + stay:true (check for skip)");
+}
+
+// =============================================================================
+// Tests for determineUnchangedSkip()
+// =============================================================================
+
+TEST_F(DecisionFunctionsTest, UnchangedSkip_DisabledInConfig_NeverSkips) {
+    config = createSingleImageConfig();
+    config.useCRC32Check = false;
+    
+    auto result = determineUnchangedSkip(config, WAKEUP_TIMER, 0, 0);
+    EXPECT_FALSE(result.allowSkip);
+    EXPECT_STREQ(result.reason, "Change detection disabled");
+}
+
+TEST_F(DecisionFunctionsTest, UnchangedSkip_TargetOnScreen_Skips) {
+    config = createSingleImageConfig();
+    config.useCRC32Check = true;
+    
+    auto result = determineUnchangedSkip(config, WAKEUP_TIMER, 0, 0);
+    EXPECT_TRUE(result.allowSkip);
+    EXPECT_STREQ(result.reason, "Target image on screen (skip if unchanged)");
+}
+
+TEST_F(DecisionFunctionsTest, UnchangedSkip_ButtonWake_NeverSkips) {
+    config = createSingleImageConfig();
+    config.useCRC32Check = true;
+    
+    auto result = determineUnchangedSkip(config, WAKEUP_BUTTON, 0, 0);
+    EXPECT_FALSE(result.allowSkip);
+    EXPECT_STREQ(result.reason, "Manual wake (always refresh)");
+}
+
+TEST_F(DecisionFunctionsTest, UnchangedSkip_ScreenUnknown_NeverSkips) {
+    config = createSingleImageConfig();
+    config.useCRC32Check = true;
+    
+    auto result = determineUnchangedSkip(config, WAKEUP_TIMER, 0, IMAGE_SLOT_NONE);
+    EXPECT_FALSE(result.allowSkip);
+    EXPECT_STREQ(result.reason, "Screen content unknown (always download)");
+}
+
+TEST_F(DecisionFunctionsTest, UnchangedSkip_OtherSlotOnScreen_NeverSkips) {
+    config = createCarouselConfig(3);
+    config.useCRC32Check = true;
+    
+    auto result = determineUnchangedSkip(config, WAKEUP_TIMER, 2, 1);
+    EXPECT_FALSE(result.allowSkip);
+    EXPECT_STREQ(result.reason, "Target image not on screen (always download)");
+}
+
 // =============================================================================
 // Tests for determineSleepDuration()
 // =============================================================================
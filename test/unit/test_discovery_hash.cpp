@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <discovery_hash.h>
+#include <set>
+#include <string>
+
+// Test fixture for Home Assistant discovery change detection
+class DiscoveryHashTest : public ::testing::Test {
+protected:
+    DiscoveryIdentity identity;
+
+    void SetUp() override {
+        identity.deviceId = "a1b2c3d4e5f6";
+        identity.deviceName = "Inkplate Dashboard e5f6";
+        identity.modelName = "Inkplate 5 V2";
+        identity.firmwareVersion = "1.6.0";
+        identity.broker = "192.168.1.50:1883";
+        identity.batchedState = false;
+    }
+
+    uint32_t hash() {
+        return computeDiscoveryHash(identity, DISCOVERY_SENSORS, DISCOVERY_SENSOR_COUNT);
+    }
+};
+
+// ============================================================================
+// Hash Inputs
+// ============================================================================
+
+TEST_F(DiscoveryHashTest, SameInputsSameHash) {
+    uint32_t first = hash();
+    EXPECT_EQ(hash(), first);
+    EXPECT_NE(first, (uint32_t)DISCOVERY_HASH_NONE);
+
+    // Equal contents in different buffers
+    std::string name = identity.deviceName;
+    identity.deviceName = name.c_str();
+    EXPECT_EQ(hash(), first);
+}
+
+TEST_F(DiscoveryHashTest, EveryIdentityFieldChangesHash) {
+    uint32_t base = hash();
+    std::set<uint32_t> seen = { base };
+
+    DiscoveryIdentity original = identity;
+    identity.deviceId = "a1b2c3d4e5f7";
+    seen.insert(hash());
+    identity = original;
+    identity.deviceName = "kitchen";
+    seen.insert(hash());
+    identity = original;
+    identity.modelName = "Inkplate 10";
+    seen.insert(hash());
+    identity = original;
+    identity.firmwareVersion = "1.6.1";
+    seen.insert(hash());
+    identity = original;
+    identity.broker = "192.168.1.50:8883";
+    seen.insert(hash());
+    identity = original;
+    identity.batchedState = true;
+    seen.insert(hash());
+
+    EXPECT_EQ(seen.size(), 7u);
+}
+
+TEST_F(DiscoveryHashTest, FieldBoundariesMatter) {
+    // Same characters, split differently between adjacent fields
+    identity.deviceName = "Inkplate Dashboard";
+    identity.modelName = "5";
+    uint32_t first = hash();
+    identity.deviceName = "Inkplate Dashboard 5";
+    identity.modelName = "";
+    EXPECT_NE(hash(), first);
+}
+
+TEST_F(DiscoveryHashTest, NullFieldHashesLikeEmpty) {
+    identity.deviceName = "";
+    uint32_t empty = hash();
+    identity.deviceName = nullptr;
+    EXPECT_EQ(hash(), empty);
+}
+
+TEST_F(DiscoveryHashTest, SensorListChangesHash) {
+    uint32_t all = hash();
+    EXPECT_NE(computeDiscoveryHash(identity, DISCOVERY_SENSORS, DISCOVERY_SENSOR_COUNT - 1), all);
+
+    // Renamed sensor / changed unit
+    DiscoverySensor sensors[2] = { DISCOVERY_SENSORS[0], DISCOVERY_SENSORS[1] };
+    uint32_t pair = computeDiscoveryHash(identity, sensors, 2);
+    sensors[1].name = "Battery Level";
+    EXPECT_NE(computeDiscoveryHash(identity, sensors, 2), pair);
+    sensors[1] = DISCOVERY_SENSORS[1];
+    sensors[0].unit = "mV";
+    EXPECT_NE(computeDiscoveryHash(identity, sensors, 2), pair);
+
+    // Reordered
+    DiscoverySensor swapped[2] = { DISCOVERY_SENSORS[1], DISCOVERY_SENSORS[0] };
+    EXPECT_NE(computeDiscoveryHash(identity, swapped, 2), pair);
+}
+
+TEST_F(DiscoveryHashTest, EmptySensorList) {
+    uint32_t none = computeDiscoveryHash(identity, nullptr, 0);
+    EXPECT_NE(none, (uint32_t)DISCOVERY_HASH_NONE);
+    EXPECT_EQ(computeDiscoveryHash(identity, DISCOVERY_SENSORS, 0), none);
+    EXPECT_EQ(computeDiscoveryHash(identity, nullptr, 5), none);
+}
+
+// ============================================================================
+// Sensor Table
+// ============================================================================
+
+TEST_F(DiscoveryHashTest, SensorTableUniqueAndComplete) {
+    EXPECT_EQ(DISCOVERY_SENSOR_COUNT, 20u);
+    std::set<std::string> types;
+    for (size_t i = 0; i < DISCOVERY_SENSOR_COUNT; i++) {
+        ASSERT_NE(DISCOVERY_SENSORS[i].type, nullptr);
+        ASSERT_NE(DISCOVERY_SENSORS[i].name, nullptr);
+        ASSERT_NE(DISCOVERY_SENSORS[i].deviceClass, nullptr);
+        ASSERT_NE(DISCOVERY_SENSORS[i].unit, nullptr);
+        types.insert(DISCOVERY_SENSORS[i].type);
+    }
+    EXPECT_EQ(types.size(), DISCOVERY_SENSOR_COUNT);
+    EXPECT_STREQ(DISCOVERY_SENSORS[0].type, "battery_voltage");  // Carries the full device info
+}
+
+// ============================================================================
+// Publish Decision
+// ============================================================================
+
+TEST_F(DiscoveryHashTest, PublishWhenNothingStored) {
+    EXPECT_TRUE(isDiscoveryPublishNeeded(hash(), DISCOVERY_HASH_NONE, false));
+}
+
+TEST_F(DiscoveryHashTest, SkipWhenUnchanged) {
+    uint32_t current = hash();
+    EXPECT_FALSE(isDiscoveryPublishNeeded(current, current, false));
+}
+
+TEST_F(DiscoveryHashTest, PublishWhenChanged) {
+    uint32_t stored = hash();
+    identity.firmwareVersion = "1.7.0";
+    EXPECT_TRUE(isDiscoveryPublishNeeded(hash(), stored, false));
+}
+
+TEST_F(DiscoveryHashTest, ForcedAlwaysPublishes) {
+    uint32_t current = hash();
+    EXPECT_TRUE(isDiscoveryPublishNeeded(current, current, true));
+    EXPECT_TRUE(isDiscoveryPublishNeeded(current, DISCOVERY_HASH_NONE, true));
+}
@@ -0,0 +1,232 @@
+#include <gtest/gtest.h>
+#include <energy_model.h>
+
+// Test fixture for the battery life model
+class EnergyModelTest : public ::testing::Test {
+protected:
+    // Round numbers so expected values can be worked out by hand
+    PowerProfile profile = { 40.0f, 100.0f, 50.0f, 20.0f, 1200.0f };
+
+    const uint8_t ALL_HOURS[3] = { 0xFF, 0xFF, 0xFF };
+    const uint8_t NO_HOURS[3] = { 0x00, 0x00, 0x00 };
+};
+
+// ============================================================================
+// Phase Split Tests
+// ============================================================================
+
+TEST_F(EnergyModelTest, BuildPhases_SubtractsNestedTimings) {
+    // 10s loop: WiFi 2s, NTP 0.5s, CRC 1s, image 5s (incl. 1.5s TLS and 2s refresh)
+    CyclePhases phases = buildCyclePhases(300, 10000, 2000, 500, 1000, 5000, 1500, 2000);
+
+    EXPECT_EQ(phases.boot_ms, 300u);
+    EXPECT_EQ(phases.wifi_ms, 2000u);
+    EXPECT_EQ(phases.tls_ms, 1500u);
+    EXPECT_EQ(phases.transfer_ms, 2500u);   // 1000 + 5000 - 1500 - 2000
+    EXPECT_EQ(phases.refresh_ms, 2000u);
+    EXPECT_EQ(phases.other_ms, 2000u);      // 10000 - 2000 - 1000 - 5000 (includes NTP)
+    EXPECT_EQ(getCycleAwakeMs(phases), 10300u);
+}
+
+TEST_F(EnergyModelTest, BuildPhases_ClampsInconsistentInputs) {
+    // TLS and refresh larger than the phases that contain them, loop shorter than its parts
+    CyclePhases phases = buildCyclePhases(0, 1000, 800, 300, 100, 200, 5000, 900);
+
+    EXPECT_EQ(phases.refresh_ms, 200u);
+    EXPECT_EQ(phases.tls_ms, 100u);
+    EXPECT_EQ(phases.transfer_ms, 0u);
+    EXPECT_EQ(phases.other_ms, 300u);       // At least the NTP time
+}
+
+TEST_F(EnergyModelTest, BuildPhases_SkippedDownload) {
+    // CRC32 match: no image phase, no refresh
+    CyclePhases phases = buildCyclePhases(250, 2500, 1500, 0, 400, 0, 0, 0);
+
+    EXPECT_EQ(phases.refresh_ms, 0u);
+    EXPECT_EQ(phases.transfer_ms, 400u);
+    EXPECT_EQ(phases.other_ms, 600u);
+}
+
+// ============================================================================
+// Charge Tests
+// ============================================================================
+
+TEST_F(EnergyModelTest, CycleCharge_WeightsPhasesByCurrent) {
+    CyclePhases phases = {};
+    phases.boot_ms = 3600;          // 40 mA -> 0.04 mAh
+    phases.wifi_ms = 3600;          // 100 mA -> 0.1 mAh
+    phases.refresh_ms = 3600;       // 150 mA -> 0.15 mAh
+
+    EXPECT_NEAR(estimateCycleCharge(profile, phases), 0.29f, 1e-5f);
+}
+
+TEST_F(EnergyModelTest, CycleCharge_AllWifiPhasesUseWifiCurrent) {
+    CyclePhases phases = {};
+    phases.tls_ms = 900;
+    phases.transfer_ms = 900;
+    phases.other_ms = 1800;
+
+    EXPECT_NEAR(estimateCycleCharge(profile, phases), 0.1f, 1e-5f);
+}
+
+TEST_F(EnergyModelTest, CycleCharge_ZeroPhases) {
+    CyclePhases phases = {};
+    EXPECT_FLOAT_EQ(estimateCycleCharge(profile, phases), 0.0f);
+}
+
+TEST_F(EnergyModelTest, SleepCharge) {
+    EXPECT_NEAR(estimateSleepCharge(profile, 3600.0f), 0.02f, 1e-6f);   // 20 uA for 1 hour
+    EXPECT_NEAR(estimateSleepCharge(profile, 86400.0f), 0.48f, 1e-5f);
+    EXPECT_FLOAT_EQ(estimateSleepCharge(profile, 0.0f), 0.0f);
+    EXPECT_FLOAT_EQ(estimateSleepCharge(profile, -5.0f), 0.0f);
+}
+
+// ============================================================================
+// Running Average Tests
+// ============================================================================
+
+TEST_F(EnergyModelTest, Stats_FirstWakeSetsAverage) {
+    EnergyStats stats = {};
+    updateEnergyStats(stats, 0.2f, 6.0f);
+
+    EXPECT_FLOAT_EQ(stats.avgCycleMah, 0.2f);
+    EXPECT_FLOAT_EQ(stats.avgAwakeSeconds, 6.0f);
+    EXPECT_EQ(stats.cycles, 1u);
+}
+
+TEST_F(EnergyModelTest, Stats_SmoothsLaterWakes) {
+    EnergyStats stats = {};
+    updateEnergyStats(stats, 0.2f, 6.0f);
+    updateEnergyStats(stats, 0.05f, 2.0f);
+
+    EXPECT_NEAR(stats.avgCycleMah, 0.2f * 0.8f + 0.05f * 0.2f, 1e-6f);
+    EXPECT_NEAR(stats.avgAwakeSeconds, 6.0f * 0.8f + 2.0f * 0.2f, 1e-5f);
+    EXPECT_EQ(stats.cycles, 2u);
+}
+
+TEST_F(EnergyModelTest, Stats_ConvergesToMixOfCycles) {
+    // One image update (0.2 mAh) per four skipped checks (0.05 mAh)
+    EnergyStats stats = {};
+    for (int i = 0; i < 500; i++) {
+        updateEnergyStats(stats, (i % 5 == 0) ? 0.2f : 0.05f, 3.0f);
+    }
+    EXPECT_NEAR(stats.avgCycleMah, 0.08f, 0.03f);
+}
+
+// ============================================================================
+// Wakes Per Day Tests
+// ============================================================================
+
+TEST_F(EnergyModelTest, Wakes_SingleImage) {
+    int intervals[] = { 15 };
+    EXPECT_FLOAT_EQ(calculateWakesPerDay(intervals, nullptr, 1, ALL_HOURS), 96.0f);
+}
+
+TEST_F(EnergyModelTest, Wakes_SingleImageStayIsIgnored) {
+    int intervals[] = { 30 };
+    bool stay[] = { true };
+    EXPECT_FLOAT_EQ(calculateWakesPerDay(intervals, stay, 1, ALL_HOURS), 48.0f);
+}
+
+TEST_F(EnergyModelTest, Wakes_ButtonOnly) {
+    int intervals[] = { 0 };
+    EXPECT_FLOAT_EQ(calculateWakesPerDay(intervals, nullptr, 1, ALL_HOURS), 0.0f);
+}
+
+TEST_F(EnergyModelTest, Wakes_NoImages) {
+    EXPECT_FLOAT_EQ(calculateWakesPerDay(nullptr, nullptr, 0, ALL_HOURS), 0.0f);
+}
+
+TEST_F(EnergyModelTest, Wakes_CarouselUsesSumOfIntervals) {
+    // 3 wakes every 5 + 10 + 15 = 30 minutes
+    int intervals[] = { 5, 10, 15 };
+    bool stay[] = { false, false, false };
+    EXPECT_FLOAT_EQ(calculateWakesPerDay(intervals, stay, 3, ALL_HOURS), 144.0f);
+}
+
+TEST_F(EnergyModelTest, Wakes_CarouselStopsAtStayImage) {
+    // Image 1 has stay:true - the carousel stays there at its 10 minute interval
+    int intervals[] = { 5, 10, 15 };
+    bool stay[] = { false, true, false };
+    EXPECT_FLOAT_EQ(calculateWakesPerDay(intervals, stay, 3, ALL_HOURS), 144.0f);
+
+    int intervals2[] = { 5, 20, 15 };
+    EXPECT_FLOAT_EQ(calculateWakesPerDay(intervals2, stay, 3, ALL_HOURS), 72.0f);
+}
+
+TEST_F(EnergyModelTest, Wakes_CarouselButtonOnlyImageStopsTimerWakes) {
+    int intervals[] = { 5, 0, 15 };
+    EXPECT_FLOAT_EQ(calculateWakesPerDay(intervals, nullptr, 3, ALL_HOURS), 0.0f);
+}
+
+TEST_F(EnergyModelTest, Wakes_HourlySchedule) {
+    // Hours 7-22 enabled (16 hours), one disabled block
+    uint8_t hours[3] = { 0x80, 0xFF, 0x7F };
+    int intervals[] = { 15 };
+    EXPECT_FLOAT_EQ(calculateWakesPerDay(intervals, nullptr, 1, hours), 16 * 4 + 1.0f);
+}
+
+TEST_F(EnergyModelTest, Wakes_HourlyScheduleSeveralBlocks) {
+    // Hours 8 and 18 only: two enabled hours, two disabled blocks
+    uint8_t hours[3] = { 0x00, 0x01, 0x04 };
+    int intervals[] = { 60 };
+    EXPECT_FLOAT_EQ(calculateWakesPerDay(intervals, nullptr, 1, hours), 2 + 2.0f);
+}
+
+TEST_F(EnergyModelTest, Wakes_EmptyScheduleTreatedAsAllHours) {
+    int intervals[] = { 60 };
+    EXPECT_FLOAT_EQ(calculateWakesPerDay(intervals, nullptr, 1, NO_HOURS), 24.0f);
+}
+
+// ============================================================================
+// Projection Tests
+// ============================================================================
+
+TEST_F(EnergyModelTest, Projection_DailyChargeAndDays) {
+    // 96 wakes x 0.05 mAh + ~0.48 mAh sleep = ~5.28 mAh/day
+    BatteryProjection p = projectBatteryLife(profile, 0.05f, 3.0f, 96.0f, 100);
+
+    EXPECT_FLOAT_EQ(p.wakesPerDay, 96.0f);
+    EXPECT_NEAR(p.mahPerDay, 4.8f + 0.02f * (86400.0f - 288.0f) / 3600.0f, 1e-3f);
+    EXPECT_NEAR(p.daysFullBattery, 1200.0f / p.mahPerDay, 0.01f);
+    EXPECT_FLOAT_EQ(p.daysRemaining, p.daysFullBattery);
+}
+
+TEST_F(EnergyModelTest, Projection_ScalesWithBatteryPercentage) {
+    BatteryProjection p = projectBatteryLife(profile, 0.05f, 3.0f, 96.0f, 40);
+    EXPECT_NEAR(p.daysRemaining, p.daysFullBattery * 0.4f, 0.01f);
+
+    BatteryProjection empty = projectBatteryLife(profile, 0.05f, 3.0f, 96.0f, -10);
+    EXPECT_FLOAT_EQ(empty.daysRemaining, 0.0f);
+
+    BatteryProjection over = projectBatteryLife(profile, 0.05f, 3.0f, 96.0f, 150);
+    EXPECT_FLOAT_EQ(over.daysRemaining, over.daysFullBattery);
+}
+
+TEST_F(EnergyModelTest, Projection_ButtonOnlyIsSleepOnly) {
+    BatteryProjection p = projectBatteryLife(profile, 0.2f, 6.0f, 0.0f, 100);
+    EXPECT_NEAR(p.mahPerDay, 0.48f, 1e-4f);
+    EXPECT_NEAR(p.daysFullBattery, 2500.0f, 1.0f);
+}
+
+TEST_F(EnergyModelTest, Projection_AwakeAllDayHasNoSleepCharge) {
+    BatteryProjection p = projectBatteryLife(profile, 0.1f, 60.0f, 2000.0f, 100);
+    EXPECT_NEAR(p.mahPerDay, 200.0f, 1e-3f);
+}
+
+TEST_F(EnergyModelTest, Projection_ShorterIntervalShortensLife) {
+    int fast[] = { 5 };
+    int slow[] = { 30 };
+    BatteryProjection pFast = projectBatteryLife(profile, 0.05f, 3.0f,
+                                                 calculateWakesPerDay(fast, nullptr, 1, ALL_HOURS), 100);
+    BatteryProjection pSlow = projectBatteryLife(profile, 0.05f, 3.0f,
+                                                 calculateWakesPerDay(slow, nullptr, 1, ALL_HOURS), 100);
+    EXPECT_LT(pFast.daysFullBattery, pSlow.daysFullBattery);
+}
+
+TEST_F(EnergyModelTest, Projection_ZeroProfile) {
+    PowerProfile none = {};
+    BatteryProjection p = projectBatteryLife(none, 0.0f, 0.0f, 0.0f, 100);
+    EXPECT_FLOAT_EQ(p.daysFullBattery, 0.0f);
+    EXPECT_FLOAT_EQ(p.daysRemaining, 0.0f);
+}
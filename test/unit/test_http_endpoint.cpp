@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <http_endpoint.h>  // Real production code!
+#include <string.h>
+
+// ============================================================================
+// Parse Tests
+// ============================================================================
+
+TEST(HttpEndpointTest, Parse_DefaultPorts) {
+    HttpEndpoint endpoint;
+    ASSERT_TRUE(parseHttpEndpoint("https://example.com/dash/image.png", endpoint));
+    EXPECT_TRUE(endpoint.secure);
+    EXPECT_EQ(endpoint.port, 443);
+    EXPECT_STREQ(endpoint.host, "example.com");
+
+    ASSERT_TRUE(parseHttpEndpoint("http://192.168.1.10/image.png", endpoint));
+    EXPECT_FALSE(endpoint.secure);
+    EXPECT_EQ(endpoint.port, 80);
+    EXPECT_STREQ(endpoint.host, "192.168.1.10");
+}
+
+TEST(HttpEndpointTest, Parse_ExplicitPortAndNoPath) {
+    HttpEndpoint endpoint;
+    ASSERT_TRUE(parseHttpEndpoint("http://homeassistant.local:8123", endpoint));
+    EXPECT_EQ(endpoint.port, 8123);
+    EXPECT_STREQ(endpoint.host, "homeassistant.local");
+
+    ASSERT_TRUE(parseHttpEndpoint("https://example.com?refresh=1", endpoint));
+    EXPECT_STREQ(endpoint.host, "example.com");
+}
+
+TEST(HttpEndpointTest, Parse_SkipsCredentials) {
+    HttpEndpoint endpoint;
+    ASSERT_TRUE(parseHttpEndpoint("https://user:p@ss@example.com:8443/image.png", endpoint));
+    EXPECT_STREQ(endpoint.host, "example.com");
+    EXPECT_EQ(endpoint.port, 8443);
+}
+
+TEST(HttpEndpointTest, Parse_RejectsInvalid) {
+    HttpEndpoint endpoint;
+    EXPECT_FALSE(parseHttpEndpoint(nullptr, endpoint));
+    EXPECT_FALSE(parseHttpEndpoint("ftp://example.com/image.png", endpoint));
+    EXPECT_FALSE(parseHttpEndpoint("https:///image.png", endpoint));
+    EXPECT_FALSE(parseHttpEndpoint("https://example.com:/image.png", endpoint));
+    EXPECT_FALSE(parseHttpEndpoint("https://example.com:0/image.png", endpoint));
+    EXPECT_FALSE(parseHttpEndpoint("https://example.com:65536/image.png", endpoint));
+    EXPECT_FALSE(parseHttpEndpoint("https://example.com:80a/image.png", endpoint));
+    EXPECT_EQ(endpoint.host[0], '\0') << "Failed parse leaves an endpoint that matches nothing";
+}
+
+TEST(HttpEndpointTest, Parse_RejectsTooLongHost) {
+    char url[128] = "https://";
+    memset(url + 8, 'a', HTTP_ENDPOINT_HOST_SIZE);
+    strcpy(url + 8 + HTTP_ENDPOINT_HOST_SIZE, "/image.png");
+    HttpEndpoint endpoint;
+    EXPECT_FALSE(parseHttpEndpoint(url, endpoint));
+}
+
+// ============================================================================
+// Compare Tests
+// ============================================================================
+
+TEST(HttpEndpointTest, Same_ImageAndSidecarShareEndpoint) {
+    HttpEndpoint image;
+    HttpEndpoint sidecar;
+    parseHttpEndpoint("https://Example.com/image.png", image);
+    parseHttpEndpoint("https://example.COM/image.png.crc32", sidecar);
+    EXPECT_TRUE(isSameHttpEndpoint(image, sidecar));
+}
+
+TEST(HttpEndpointTest, Same_DifferentSchemePortOrHost) {
+    HttpEndpoint a;
+    HttpEndpoint b;
+    parseHttpEndpoint("https://example.com/image.png", a);
+
+    parseHttpEndpoint("http://example.com/image.png", b);
+    EXPECT_FALSE(isSameHttpEndpoint(a, b));
+    parseHttpEndpoint("https://example.com:8443/image.png", b);
+    EXPECT_FALSE(isSameHttpEndpoint(a, b));
+    parseHttpEndpoint("https://cdn.example.com/image.png", b);
+    EXPECT_FALSE(isSameHttpEndpoint(a, b));
+}
+
+TEST(HttpEndpointTest, Same_ExplicitDefaultPortMatches) {
+    HttpEndpoint a;
+    HttpEndpoint b;
+    parseHttpEndpoint("https://example.com/image.png", a);
+    parseHttpEndpoint("https://example.com:443/image.png", b);
+    EXPECT_TRUE(isSameHttpEndpoint(a, b));
+}
+
+TEST(HttpEndpointTest, Same_EmptyNeverMatches) {
+    HttpEndpoint a;
+    HttpEndpoint b;
+    clearHttpEndpoint(a);
+    clearHttpEndpoint(b);
+    EXPECT_FALSE(isSameHttpEndpoint(a, b));
+}
+
+TEST(HttpEndpointTest, Set_FromConnectParts) {
+    HttpEndpoint connected;
+    HttpEndpoint requested;
+    ASSERT_TRUE(setHttpEndpoint(connected, "example.com", 443, true));
+    parseHttpEndpoint("https://example.com/image.png", requested);
+    EXPECT_TRUE(isSameHttpEndpoint(connected, requested));
+
+    EXPECT_FALSE(setHttpEndpoint(connected, "", 443, true));
+    EXPECT_FALSE(setHttpEndpoint(connected, nullptr, 443, true));
+}
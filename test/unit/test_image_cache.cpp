@@ -0,0 +1,388 @@
+#include <gtest/gtest.h>
+#include <image_cache.h>
+#include <prefetch_cache.h>
+#include <fnv1a.h>
+#include <cstdio>
+#include <string>
+
+// Stand-in for the LittleFS partition: every cache path is a file in the
+// working directory (prefixed per test, '/' replaced so no directories are needed)
+class FileImageCacheStorage : public ImageCacheStorage {
+public:
+    explicit FileImageCacheStorage(const std::string& prefix) : failRename(false), _prefix(prefix) {}
+
+    ~FileImageCacheStorage() {
+        std::remove(hostPath(IMAGE_CACHE_INDEX_PATH).c_str());
+        std::remove(hostPath(IMAGE_CACHE_INDEX_TEMP_PATH).c_str());
+    }
+
+    size_t read(const char* path, uint8_t* buffer, size_t size) override {
+        FILE* file = std::fopen(hostPath(path).c_str(), "rb");
+        if (file == nullptr) {
+            return 0;
+        }
+        size_t length = std::fread(buffer, 1, size, file);
+        std::fclose(file);
+        return length;
+    }
+
+    bool write(const char* path, const uint8_t* data, size_t size) override {
+        FILE* file = std::fopen(hostPath(path).c_str(), "wb");
+        if (file == nullptr) {
+            return false;
+        }
+        bool written = std::fwrite(data, 1, size, file) == size;
+        return std::fclose(file) == 0 && written;
+    }
+
+    bool rename(const char* from, const char* to) override {
+        if (failRename) {
+            return false;  // Power lost between the write and the rename
+        }
+        std::remove(hostPath(to).c_str());  // LittleFS replaces the destination
+        return std::rename(hostPath(from).c_str(), hostPath(to).c_str()) == 0;
+    }
+
+    bool remove(const char* path) override {
+        return std::remove(hostPath(path).c_str()) == 0;
+    }
+
+    // Overwrite part of a file as a flash corruption would
+    void corrupt(const char* path, long offset, const void* data, size_t size) {
+        FILE* file = std::fopen(hostPath(path).c_str(), "r+b");
+        ASSERT_NE(file, nullptr);
+        std::fseek(file, offset, SEEK_SET);
+        std::fwrite(data, 1, size, file);
+        std::fclose(file);
+    }
+
+    bool failRename;
+
+private:
+    std::string _prefix;
+
+    std::string hostPath(const char* path) const {
+        std::string name = _prefix + path;
+        for (size_t i = 0; i < name.size(); i++) {
+            if (name[i] == '/') {
+                name[i] = '_';
+            }
+        }
+        return name;
+    }
+};
+
+// Test fixture for the on-flash image cache index and its write / display policy
+class ImageCacheTest : public ::testing::Test {
+protected:
+    ImageCacheIndex index;
+    const uint32_t t0 = 1760000000;
+    const uint32_t url1 = prefetchUrlHash("http://example.com/img1.png");
+    const uint32_t url2 = prefetchUrlHash("http://example.com/img2.png");
+    const uint32_t etag1 = imageCacheValidatorHash("\"v1\"", "");
+    const uint32_t etag2 = imageCacheValidatorHash("\"v2\"", "");
+
+    void SetUp() override {
+        initImageCacheIndex(index);
+    }
+
+    std::string storagePrefix() const {
+        return std::string("image_cache_") + ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    }
+};
+
+// ============================================================================
+// Index validation
+// ============================================================================
+
+TEST_F(ImageCacheTest, InitializedIndexIsValidAndEmpty) {
+    EXPECT_TRUE(isImageCacheIndexValid(index));
+    EXPECT_EQ(getImageCacheBytes(index), 0u);
+    for (uint8_t slot = 0; slot < IMAGE_SLOT_COUNT; slot++) {
+        EXPECT_EQ(findImageCacheEntry(index, slot), nullptr);
+    }
+    EXPECT_EQ(findImageCacheEntry(index, IMAGE_SLOT_NONE), nullptr);
+}
+
+TEST_F(ImageCacheTest, ColdBootIndexIsInvalid) {
+    ImageCacheIndex zeroed = {};
+    EXPECT_FALSE(isImageCacheIndexValid(zeroed));
+}
+
+TEST_F(ImageCacheTest, IndexOverTheBudgetIsInvalid) {
+    index.entries[0].size = IMAGE_CACHE_MAX_BYTES;
+    EXPECT_TRUE(isImageCacheIndexValid(index));
+    index.entries[1].size = 1;
+    EXPECT_FALSE(isImageCacheIndexValid(index));
+}
+
+TEST_F(ImageCacheTest, ValidatorHashIsZeroOnlyWithoutValidators) {
+    EXPECT_EQ(imageCacheValidatorHash("", ""), 0u);
+    EXPECT_EQ(imageCacheValidatorHash(nullptr, nullptr), 0u);
+    EXPECT_NE(imageCacheValidatorHash("", "Wed, 21 Oct 2026 07:28:00 GMT"), 0u);
+    EXPECT_NE(etag1, etag2);
+    EXPECT_NE(imageCacheValidatorHash("ab", ""), imageCacheValidatorHash("a", "b"));
+}
+
+TEST_F(ImageCacheTest, SharedHashMatchesFnv1aVectors) {
+    // Published FNV-1a 32-bit test vectors: stored hashes must keep these values
+    EXPECT_EQ(fnv1aString(FNV1A_OFFSET_BASIS, ""), 0x811c9dc5u);
+    EXPECT_EQ(fnv1aString(FNV1A_OFFSET_BASIS, "a"), 0xe40c292cu);
+    EXPECT_EQ(fnv1aString(FNV1A_OFFSET_BASIS, "foobar"), 0xbf9cf968u);
+    EXPECT_EQ(fnv1a(fnv1a(FNV1A_OFFSET_BASIS, "foo", 3), "bar", 3), 0xbf9cf968u);
+    EXPECT_EQ(fnv1aByte(FNV1A_OFFSET_BASIS, 'a'), 0xe40c292cu);
+    EXPECT_EQ(fnv1aString(FNV1A_OFFSET_BASIS, nullptr), FNV1A_OFFSET_BASIS);
+}
+
+// ============================================================================
+// Index file (file-backed stand-in for the flash partition)
+// ============================================================================
+
+TEST_F(ImageCacheTest, SavedIndexLoadsBack) {
+    FileImageCacheStorage storage(storagePrefix());
+    recordImageCacheStored(index, 2, url1, 0x12345678, etag1, 60000, t0);
+    ASSERT_TRUE(saveImageCacheIndex(storage, index));
+
+    ImageCacheIndex loaded;
+    ASSERT_TRUE(loadImageCacheIndex(storage, loaded));
+    const ImageCacheEntry* entry = findImageCacheEntry(loaded, 2);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->urlHash, url1);
+    EXPECT_EQ(entry->crc32, 0x12345678u);
+    EXPECT_EQ(entry->validatorHash, etag1);
+    EXPECT_EQ(entry->size, 60000u);
+    EXPECT_EQ(loaded.bytesWritten, 60000u);
+}
+
+TEST_F(ImageCacheTest, MissingIndexFileLoadsEmpty) {
+    FileImageCacheStorage storage(storagePrefix());
+    recordImageCacheStored(index, 2, url1, 0, etag1, 60000, t0);
+    EXPECT_FALSE(loadImageCacheIndex(storage, index));
+    EXPECT_TRUE(isImageCacheIndexValid(index));
+    EXPECT_EQ(getImageCacheBytes(index), 0u);
+}
+
+TEST_F(ImageCacheTest, CorruptIndexFileIsDiscarded) {
+    FileImageCacheStorage storage(storagePrefix());
+    recordImageCacheStored(index, 2, url1, 0, etag1, 60000, t0);
+    ASSERT_TRUE(saveImageCacheIndex(storage, index));
+    uint32_t otherUrl = url2;
+    storage.corrupt(IMAGE_CACHE_INDEX_PATH, offsetof(ImageCacheIndex, entries) + 2 * sizeof(ImageCacheEntry),
+                    &otherUrl, sizeof(otherUrl));
+
+    ImageCacheIndex loaded;
+    EXPECT_FALSE(loadImageCacheIndex(storage, loaded));
+    EXPECT_EQ(findImageCacheEntry(loaded, 2), nullptr);
+}
+
+TEST_F(ImageCacheTest, TruncatedIndexFileIsDiscarded) {
+    FileImageCacheStorage storage(storagePrefix());
+    ASSERT_TRUE(storage.write(IMAGE_CACHE_INDEX_PATH, (const uint8_t*)&index, sizeof(index) / 2));
+    ImageCacheIndex loaded;
+    EXPECT_FALSE(loadImageCacheIndex(storage, loaded));
+    EXPECT_TRUE(isImageCacheIndexValid(loaded));
+}
+
+TEST_F(ImageCacheTest, IndexFileOfAnotherLayoutIsDiscarded) {
+    FileImageCacheStorage storage(storagePrefix());
+    index.version = IMAGE_CACHE_VERSION + 1;
+    ASSERT_TRUE(saveImageCacheIndex(storage, index));  // Checksum matches, version does not
+    ImageCacheIndex loaded;
+    EXPECT_FALSE(loadImageCacheIndex(storage, loaded));
+    EXPECT_EQ(loaded.version, IMAGE_CACHE_VERSION);
+}
+
+TEST_F(ImageCacheTest, InterruptedSaveKeepsThePreviousIndex) {
+    FileImageCacheStorage storage(storagePrefix());
+    recordImageCacheStored(index, 2, url1, 0, etag1, 60000, t0);
+    ASSERT_TRUE(saveImageCacheIndex(storage, index));
+
+    storage.failRename = true;
+    recordImageCacheStored(index, 3, url2, 0, etag2, 50000, t0 + 60);
+    EXPECT_FALSE(saveImageCacheIndex(storage, index));
+
+    ImageCacheIndex loaded;
+    ASSERT_TRUE(loadImageCacheIndex(storage, loaded));
+    EXPECT_NE(findImageCacheEntry(loaded, 2), nullptr);
+    EXPECT_EQ(findImageCacheEntry(loaded, 3), nullptr);
+}
+
+// ============================================================================
+// Write policy (flash wear)
+// ============================================================================
+
+TEST_F(ImageCacheTest, FirstDownloadOfASlotIsWritten) {
+    ImageCacheWriteDecision decision = decideImageCacheWrite(index, 0, url1, 0, etag1, 60000, 0, t0);
+    EXPECT_TRUE(decision.write);
+    EXPECT_FALSE(decision.current);
+}
+
+TEST_F(ImageCacheTest, UnchangedContentIsNotRewritten) {
+    recordImageCacheStored(index, 0, url1, 0xAABBCCDD, etag1, 60000, t0);
+    ImageCacheWriteDecision byCRC = decideImageCacheWrite(index, 0, url1, 0xAABBCCDD, 0, 60000, 0, t0 + 7200);
+    EXPECT_FALSE(byCRC.write);
+    EXPECT_TRUE(byCRC.current);
+    ImageCacheWriteDecision byValidators = decideImageCacheWrite(index, 0, url1, 0, etag1, 60000, 0, t0 + 7200);
+    EXPECT_FALSE(byValidators.write);
+    EXPECT_TRUE(byValidators.current);
+}
+
+TEST_F(ImageCacheTest, ChangedContentIsRewrittenAtMostHourly) {
+    recordImageCacheStored(index, 0, url1, 0, etag1, 60000, t0);
+    EXPECT_FALSE(decideImageCacheWrite(index, 0, url1, 0, etag2, 60000, 0, t0 + 600).write);
+    EXPECT_FALSE(decideImageCacheWrite(index, 0, url1, 0, 0, 60000, 0, t0 + 600).write);  // No validators
+    EXPECT_TRUE(decideImageCacheWrite(index, 0, url1, 0, etag2, 60000, 0, t0 + IMAGE_CACHE_MIN_REWRITE_SECONDS).write);
+}
+
+TEST_F(ImageCacheTest, ChangedUrlIsWrittenAtOnce) {
+    recordImageCacheStored(index, 0, url1, 0, etag1, 60000, t0);
+    EXPECT_TRUE(decideImageCacheWrite(index, 0, url2, 0, etag1, 60000, 0, t0 + 60).write);
+}
+
+TEST_F(ImageCacheTest, DailyWriteBudgetLimitsFlashWrites) {
+    uint32_t size = IMAGE_CACHE_DAILY_WRITE_BYTES / 4;
+    uint32_t now = (t0 / 86400) * 86400 + 3600;  // 01:00 UTC
+    for (int i = 0; i < 4; i++) {
+        ASSERT_TRUE(decideImageCacheWrite(index, 0, url1, 0, 0, size, 0, now).write);
+        recordImageCacheStored(index, 0, url1, 0, 0, size, now);
+        now += IMAGE_CACHE_MIN_REWRITE_SECONDS;
+    }
+    ImageCacheWriteDecision decision = decideImageCacheWrite(index, 0, url1, 0, 0, size, 0, now);
+    EXPECT_FALSE(decision.write);
+    EXPECT_STREQ(decision.reason, "Daily flash write budget used up");
+
+    // Next UTC day starts a new budget
+    now = (now / 86400 + 1) * 86400;
+    EXPECT_TRUE(decideImageCacheWrite(index, 0, url1, 0, 0, size, 0, now).write);
+}
+
+TEST_F(ImageCacheTest, PrefetchFilesReduceTheSpace) {
+    EXPECT_TRUE(decideImageCacheWrite(index, 0, url1, 0, 0, 60000, IMAGE_CACHE_MAX_BYTES - 60000, t0).write);
+    EXPECT_FALSE(decideImageCacheWrite(index, 0, url1, 0, 0, 60001, IMAGE_CACHE_MAX_BYTES - 60000, t0).write);
+    EXPECT_FALSE(decideImageCacheWrite(index, 0, url1, 0, 0, 0, IMAGE_CACHE_MAX_BYTES, t0).write);
+}
+
+TEST_F(ImageCacheTest, NothingIsWrittenWithoutAClock) {
+    ImageCacheWriteDecision decision = decideImageCacheWrite(index, 0, url1, 0, etag1, 60000, 0, 1000);
+    EXPECT_FALSE(decision.write);
+    EXPECT_FALSE(decideImageCacheWrite(index, IMAGE_SLOT_NONE, url1, 0, etag1, 60000, 0, t0).write);
+}
+
+// ============================================================================
+// Eviction and revalidation
+// ============================================================================
+
+TEST_F(ImageCacheTest, RoomEvictsTheSlotsOwnFile) {
+    recordImageCacheStored(index, 0, url1, 0, etag1, 60000, t0);
+    uint8_t removed[IMAGE_SLOT_COUNT];
+    ASSERT_EQ(makeImageCacheRoom(index, 0, 60000, 0, removed), 1);
+    EXPECT_EQ(removed[0], 0);
+    EXPECT_EQ(findImageCacheEntry(index, 0), nullptr);
+}
+
+TEST_F(ImageCacheTest, RoomEvictsLeastRecentlyValidatedFirst) {
+    recordImageCacheStored(index, 0, url1, 0, 0, 50000, t0);
+    recordImageCacheStored(index, 1, url1, 0, 0, 50000, t0 + 60);
+    recordImageCacheStored(index, 2, url1, 0, 0, 50000, t0 + 120);
+    recordImageCacheValidated(index, 0, url1, 0, 0, t0 + 600);  // No validators - nothing to match
+    recordImageCacheStored(index, 0, url1, 0, etag1, 50000, t0 + 600);
+
+    uint8_t removed[IMAGE_SLOT_COUNT];
+    ASSERT_EQ(makeImageCacheRoom(index, 3, 50000, 0, removed), 1);
+    EXPECT_EQ(removed[0], 1);
+    EXPECT_NE(findImageCacheEntry(index, 0), nullptr);
+    EXPECT_NE(findImageCacheEntry(index, 2), nullptr);
+    EXPECT_LE(getImageCacheBytes(index) + 50000, IMAGE_CACHE_MAX_BYTES);
+}
+
+TEST_F(ImageCacheTest, PrefetchFilesShrinkTheCache) {
+    recordImageCacheStored(index, 0, url1, 0, 0, 60000, t0);
+    recordImageCacheStored(index, 1, url1, 0, 0, 60000, t0 + 60);
+    uint8_t removed[IMAGE_SLOT_COUNT];
+    EXPECT_EQ(makeImageCacheRoom(index, IMAGE_SLOT_NONE, 0, IMAGE_CACHE_MAX_BYTES - 60000, removed), 1);
+    EXPECT_EQ(removed[0], 0);
+    EXPECT_EQ(makeImageCacheRoom(index, IMAGE_SLOT_NONE, 0, IMAGE_CACHE_MAX_BYTES, removed), 1);
+    EXPECT_EQ(getImageCacheBytes(index), 0u);
+    EXPECT_EQ(makeImageCacheRoom(index, IMAGE_SLOT_NONE, 0, IMAGE_CACHE_MAX_BYTES + 1, removed), 0);
+}
+
+TEST_F(ImageCacheTest, RevalidationOnlyAppliesToTheCachedContent) {
+    recordImageCacheStored(index, 0, url1, 0x11111111, etag1, 60000, t0);
+    recordImageCacheValidated(index, 0, url1, 0x22222222, etag2, t0 + 600);
+    EXPECT_EQ(findImageCacheEntry(index, 0)->validatedAt, t0);
+    recordImageCacheValidated(index, 0, url2, 0x11111111, 0, t0 + 600);
+    EXPECT_EQ(findImageCacheEntry(index, 0)->validatedAt, t0);
+    recordImageCacheValidated(index, 0, url1, 0x11111111, 0, t0 + 600);
+    EXPECT_EQ(findImageCacheEntry(index, 0)->validatedAt, t0 + 600);
+    recordImageCacheValidated(index, 0, url1, 0, etag1, t0 + 900);
+    EXPECT_EQ(findImageCacheEntry(index, 0)->validatedAt, t0 + 900);
+    EXPECT_EQ(findImageCacheEntry(index, 0)->storedAt, t0);
+}
+
+TEST_F(ImageCacheTest, RemovedEntryIsNotFound) {
+    recordImageCacheStored(index, 4, url1, 0, etag1, 60000, t0);
+    removeImageCacheEntry(index, 4);
+    EXPECT_EQ(findImageCacheEntry(index, 4), nullptr);
+    EXPECT_EQ(getImageCacheBytes(index), 0u);
+}
+
+// ============================================================================
+// Display decision
+// ============================================================================
+
+TEST_F(ImageCacheTest, FreshCachedSlotIsShown) {
+    recordImageCacheStored(index, 1, url1, 0, etag1, 60000, t0);
+    ImageCacheDisplayDecision decision = decideImageCacheDisplay(index, 1, url1, 0,
+                                                                 IMAGE_CACHE_REDISPLAY_MAX_AGE_SECONDS, t0 + 600);
+    EXPECT_EQ(decision.lookup, IMAGE_CACHE_SHOW);
+}
+
+TEST_F(ImageCacheTest, UncachedOrChangedUrlIsAMiss) {
+    recordImageCacheStored(index, 1, url1, 0, etag1, 60000, t0);
+    EXPECT_EQ(decideImageCacheDisplay(index, 2, url1, 0, IMAGE_CACHE_MAX_STALE_SECONDS, t0).lookup, IMAGE_CACHE_MISS);
+    EXPECT_EQ(decideImageCacheDisplay(index, 1, url2, 0, IMAGE_CACHE_MAX_STALE_SECONDS, t0).lookup, IMAGE_CACHE_MISS);
+}
+
+TEST_F(ImageCacheTest, AgeLimitDependsOnTheUse) {
+    recordImageCacheStored(index, 1, url1, 0, etag1, 60000, t0);
+    uint32_t now = t0 + IMAGE_CACHE_REDISPLAY_MAX_AGE_SECONDS + 1;
+    EXPECT_EQ(decideImageCacheDisplay(index, 1, url1, 0, IMAGE_CACHE_REDISPLAY_MAX_AGE_SECONDS, now).lookup,
+              IMAGE_CACHE_MISS);
+    EXPECT_EQ(decideImageCacheDisplay(index, 1, url1, 0, IMAGE_CACHE_MAX_STALE_SECONDS, now).lookup,
+              IMAGE_CACHE_SHOW);
+    now = t0 + IMAGE_CACHE_MAX_STALE_SECONDS + 1;
+    EXPECT_EQ(decideImageCacheDisplay(index, 1, url1, 0, IMAGE_CACHE_MAX_STALE_SECONDS, now).lookup,
+              IMAGE_CACHE_MISS);
+}
+
+TEST_F(ImageCacheTest, UnsetOrBackwardsClockIsAMiss) {
+    recordImageCacheStored(index, 1, url1, 0, etag1, 60000, t0);
+    EXPECT_EQ(decideImageCacheDisplay(index, 1, url1, 0, IMAGE_CACHE_MAX_STALE_SECONDS, 1000).lookup,
+              IMAGE_CACHE_MISS);
+    EXPECT_EQ(decideImageCacheDisplay(index, 1, url1, 0, IMAGE_CACHE_MAX_STALE_SECONDS, t0 - 60).lookup,
+              IMAGE_CACHE_MISS);
+}
+
+TEST_F(ImageCacheTest, SlotOnScreenNeedsNoDrawing) {
+    recordImageCacheStored(index, 1, url1, 0, etag1, 60000, t0);
+    EXPECT_EQ(decideImageCacheDisplay(index, 1, url1, 1, IMAGE_CACHE_MAX_STALE_SECONDS, t0 + 60).lookup,
+              IMAGE_CACHE_ON_SCREEN);
+}
+
+TEST_F(ImageCacheTest, FailedDownloadFallsBackToTheLastGoodImage) {
+    // Image downloaded and cached, then the server goes down for 12 hours
+    FileImageCacheStorage storage(storagePrefix());
+    ASSERT_TRUE(decideImageCacheWrite(index, 0, url1, 0, etag1, 60000, 0, t0).write);
+    recordImageCacheStored(index, 0, url1, 0, etag1, 60000, t0);
+    ASSERT_TRUE(saveImageCacheIndex(storage, index));
+
+    // Cold boot (battery swap) in between: the RTC copy is gone, the index file is not
+    ImageCacheIndex rtc = {};
+    ASSERT_FALSE(isImageCacheIndexValid(rtc));
+    ASSERT_TRUE(loadImageCacheIndex(storage, rtc));
+
+    // The error screen replaced nothing yet: show the cached copy instead
+    ImageCacheDisplayDecision decision = decideImageCacheDisplay(rtc, 0, url1, IMAGE_SLOT_NONE,
+                                                                 IMAGE_CACHE_MAX_STALE_SECONDS, t0 + 12 * 3600);
+    EXPECT_EQ(decision.lookup, IMAGE_CACHE_SHOW);
+}
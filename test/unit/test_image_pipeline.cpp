@@ -0,0 +1,509 @@
+#include <gtest/gtest.h>
+#include <streaming_image_decoder.h>
+#include <framebuffer_sink.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Fixture files live in test/fixtures/images (see generate_image_fixtures.py)
+#ifndef FIXTURES_DIR
+#define FIXTURES_DIR "fixtures/images"
+#endif
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static std::vector<uint8_t> readFile(const std::string& name) {
+    std::vector<uint8_t> data;
+    std::string path = std::string(FIXTURES_DIR) + "/" + name;
+    FILE* f = fopen(path.c_str(), "rb");
+    if (f == nullptr) {
+        ADD_FAILURE() << "Missing fixture: " << path;
+        return data;
+    }
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        data.insert(data.end(), buf, buf + n);
+    }
+    fclose(f);
+    return data;
+}
+
+struct Pgm {
+    int width = 0;
+    int height = 0;
+    int maxval = 0;
+    std::vector<uint8_t> pixels;
+};
+
+static Pgm readPgm(const std::string& name) {
+    Pgm pgm;
+    std::vector<uint8_t> data = readFile(name);
+    if (data.empty()) {
+        return pgm;
+    }
+    int consumed = 0;
+    std::string header(data.begin(), data.begin() + std::min<size_t>(data.size(), 64));
+    if (sscanf(header.c_str(), "P5 %d %d %d%n", &pgm.width, &pgm.height, &pgm.maxval, &consumed) != 3) {
+        ADD_FAILURE() << "Invalid PGM: " << name;
+        return pgm;
+    }
+    pgm.pixels.assign(data.begin() + consumed + 1, data.end());
+    return pgm;
+}
+
+// Captures decoded 8-bit rows into a full image
+class CaptureSink : public ImageRowSink {
+public:
+    int width = 0;
+    int height = 0;
+    int rows = 0;
+    int beginCalls = 0;
+    bool rowsInOrder = true;
+    std::vector<uint8_t> pixels;
+
+    bool begin(uint16_t w, uint16_t h) override {
+        width = w;
+        height = h;
+        beginCalls++;
+        pixels.assign((size_t)w * h, 0);
+        return true;
+    }
+
+    void writeRow(uint16_t y, const uint8_t* gray, uint16_t w) override {
+        if (y != rows || w != width) {
+            rowsInOrder = false;
+            return;
+        }
+        std::copy(gray, gray + w, pixels.begin() + (size_t)y * width);
+        rows++;
+    }
+};
+
+// Feed a whole file in fixed-size chunks, as the HTTP stream would
+static DecodeStatus decodeInChunks(const std::vector<uint8_t>& file, size_t chunkSize,
+                                   ImageRowSink* sink, StreamingImageDecoder* outDecoder = nullptr) {
+    StreamingImageDecoder local(sink);
+    StreamingImageDecoder& decoder = outDecoder ? *outDecoder : local;
+    for (size_t pos = 0; pos < file.size(); pos += chunkSize) {
+        size_t n = std::min(chunkSize, file.size() - pos);
+        if (decoder.feed(file.data() + pos, n) != DECODE_OK) {
+            break;
+        }
+    }
+    return decoder.finish();
+}
+
+// ============================================================================
+// Format Detection
+// ============================================================================
+
+TEST(ImageFormatTest, DetectsPngJpegAndUnknown) {
+    const uint8_t png[8] = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A };
+    const uint8_t jpeg[4] = { 0xFF, 0xD8, 0xFF, 0xE0 };
+    const uint8_t bmp[8] = { 'B', 'M', 0, 0, 0, 0, 0, 0 };
+
+    EXPECT_EQ(detectImageFormat(png, sizeof(png)), IMAGE_FORMAT_PNG);
+    EXPECT_EQ(detectImageFormat(jpeg, sizeof(jpeg)), IMAGE_FORMAT_JPEG);
+    EXPECT_EQ(detectImageFormat(bmp, sizeof(bmp)), IMAGE_FORMAT_UNKNOWN);
+    EXPECT_EQ(detectImageFormat(png, 4), IMAGE_FORMAT_UNKNOWN);
+}
+
+TEST(ImageFormatTest, DetectsIkfb) {
+    const uint8_t ikfb[8] = { 'I', 'K', 'F', 'B', 1, 3, 1, 0 };
+    EXPECT_EQ(detectImageFormat(ikfb, sizeof(ikfb)), IMAGE_FORMAT_IKFB);
+    EXPECT_EQ(detectImageFormat(ikfb, 3), IMAGE_FORMAT_UNKNOWN);
+
+    EXPECT_TRUE(isIkfbUrl("http://server/dashboard.ikfb"));
+    EXPECT_TRUE(isIkfbUrl("http://server/dashboard.IKFB?t=1"));
+    EXPECT_FALSE(isIkfbUrl("http://server/dashboard.png"));
+    EXPECT_FALSE(isIkfbUrl(nullptr));
+}
+
+// ============================================================================
+// Golden Decode Tests (every fixture x several network chunk sizes)
+// ============================================================================
+
+struct GoldenCase {
+    const char* image;
+    const char* golden;
+    size_t chunkSize;
+};
+
+class GoldenDecodeTest : public ::testing::TestWithParam<GoldenCase> {};
+
+TEST_P(GoldenDecodeTest, MatchesGoldenGrayscale) {
+    const GoldenCase& c = GetParam();
+    std::vector<uint8_t> file = readFile(c.image);
+    Pgm expected = readPgm(c.golden);
+    ASSERT_FALSE(file.empty());
+    ASSERT_EQ(expected.maxval, 255);
+
+    CaptureSink sink;
+    EXPECT_EQ(decodeInChunks(file, c.chunkSize, &sink), DECODE_DONE);
+    EXPECT_EQ(sink.beginCalls, 1);
+    EXPECT_TRUE(sink.rowsInOrder);
+    ASSERT_EQ(sink.width, expected.width);
+    ASSERT_EQ(sink.height, expected.height);
+    EXPECT_EQ(sink.rows, expected.height);
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < expected.pixels.size(); i++) {
+        if (sink.pixels[i] != expected.pixels[i]) {
+            mismatches++;
+        }
+    }
+    EXPECT_EQ(mismatches, 0u) << c.image << " chunk=" << c.chunkSize;
+}
+
+static std::vector<GoldenCase> goldenCases() {
+    const char* files[][2] = {
+        { "png_gray8_filters.png",   "png_gray8_filters.pgm" },
+        { "png_rgb8_stored.png",     "png_rgb8_stored.pgm" },
+        { "png_rgb8_fixed.png",      "png_rgb8_fixed.pgm" },
+        { "png_palette4_trns.png",   "png_palette4_trns.pgm" },
+        { "png_gray1.png",           "png_gray1.pgm" },
+        { "png_graya8.png",          "png_graya8.pgm" },
+        { "png_rgba16.png",          "png_rgba16.pgm" },
+        { "png_gray16_key.png",      "png_gray16_key.pgm" },
+        { "jpeg_444.jpg",            "jpeg_444.pgm" },
+        { "jpeg_420.jpg",            "jpeg_420.pgm" },
+        { "jpeg_422.jpg",            "jpeg_422.pgm" },
+        { "jpeg_gray.jpg",           "jpeg_gray.pgm" },
+        { "jpeg_420_restart.jpg",    "jpeg_420_restart.pgm" },
+        { "jpeg_noninterleaved.jpg", "jpeg_noninterleaved.pgm" },
+    };
+    // 1 byte = worst case, 1460 = typical TCP segment, 1 MB = whole file at once
+    const size_t chunkSizes[] = { 1, 7, 1460, 1u << 20 };
+
+    std::vector<GoldenCase> cases;
+    for (const auto& f : files) {
+        for (size_t chunk : chunkSizes) {
+            cases.push_back({ f[0], f[1], chunk });
+        }
+    }
+    return cases;
+}
+
+static std::string goldenCaseName(const ::testing::TestParamInfo<GoldenCase>& info) {
+    std::string name = info.param.image;
+    for (char& ch : name) {
+        if (!isalnum((unsigned char)ch)) ch = '_';
+    }
+    return name + "_chunk" + std::to_string(info.param.chunkSize);
+}
+
+INSTANTIATE_TEST_SUITE_P(Fixtures, GoldenDecodeTest, ::testing::ValuesIn(goldenCases()), goldenCaseName);
+
+// ============================================================================
+// Unsupported and Broken Input
+// ============================================================================
+
+TEST(ImageDecodeErrorTest, InterlacedPng_Unsupported) {
+    CaptureSink sink;
+    EXPECT_EQ(decodeInChunks(readFile("png_interlaced.png"), 1460, &sink), DECODE_UNSUPPORTED);
+    EXPECT_EQ(sink.rows, 0);
+}
+
+TEST(ImageDecodeErrorTest, ProgressiveJpeg_Unsupported) {
+    CaptureSink sink;
+    EXPECT_EQ(decodeInChunks(readFile("jpeg_progressive.jpg"), 1460, &sink), DECODE_UNSUPPORTED);
+    EXPECT_EQ(sink.rows, 0);
+}
+
+TEST(ImageDecodeErrorTest, UnknownFormat_Unsupported) {
+    std::vector<uint8_t> bmp(64, 0);
+    bmp[0] = 'B';
+    bmp[1] = 'M';
+    CaptureSink sink;
+    StreamingImageDecoder decoder(&sink);
+    EXPECT_EQ(decodeInChunks(bmp, 16, &sink, &decoder), DECODE_UNSUPPORTED);
+    EXPECT_EQ(decoder.getFormat(), IMAGE_FORMAT_UNKNOWN);
+    EXPECT_STREQ(decoder.getError(), "Unrecognized image format");
+}
+
+TEST(ImageDecodeErrorTest, TruncatedPng_Error) {
+    std::vector<uint8_t> file = readFile("png_gray8_filters.png");
+    file.resize(file.size() / 2);
+    CaptureSink sink;
+    EXPECT_EQ(decodeInChunks(file, 1460, &sink), DECODE_ERROR);
+    EXPECT_LT(sink.rows, sink.height);
+}
+
+TEST(ImageDecodeErrorTest, TruncatedJpeg_Error) {
+    std::vector<uint8_t> file = readFile("jpeg_420.jpg");
+    file.resize(file.size() * 2 / 3);
+    CaptureSink sink;
+    EXPECT_EQ(decodeInChunks(file, 1460, &sink), DECODE_ERROR);
+    EXPECT_LT(sink.rows, sink.height);
+}
+
+TEST(ImageDecodeErrorTest, CorruptPngData_ErrorWithoutCrash) {
+    std::vector<uint8_t> file = readFile("png_rgb8_fixed.png");
+    // Overwrite compressed data after the zlib header (IHDR ends at byte 33, IDAT data at 41)
+    for (size_t i = 43; i < 80 && i < file.size(); i++) {
+        file[i] = 0xFF;
+    }
+    CaptureSink sink;
+    EXPECT_EQ(decodeInChunks(file, 1460, &sink), DECODE_ERROR);
+}
+
+TEST(ImageDecodeErrorTest, TooShort_Error) {
+    const uint8_t tiny[3] = { 0xFF, 0xD8, 0xFF };
+    CaptureSink sink;
+    StreamingImageDecoder decoder(&sink);
+    EXPECT_EQ(decoder.feed(tiny, sizeof(tiny)), DECODE_OK);
+    EXPECT_EQ(decoder.finish(), DECODE_ERROR);
+}
+
+// ============================================================================
+// Memory Bounds
+// ============================================================================
+
+TEST(ImageMemoryTest, PngPeakMemoryBoundedByWindow) {
+    std::vector<uint8_t> file = readFile("dashboard.png");
+    CaptureSink sink;
+    StreamingImageDecoder decoder(&sink);
+    EXPECT_EQ(decodeInChunks(file, 1460, &sink, &decoder), DECODE_DONE);
+    EXPECT_EQ(sink.rows, 820);
+    // 32 KB window + Huffman tables + two 1200-byte scanlines + gray row
+    EXPECT_LT(decoder.getPeakMemoryUsage(), 40u * 1024);
+}
+
+TEST(ImageMemoryTest, JpegPeakMemoryBoundedByMcuRow) {
+    std::vector<uint8_t> file = readFile("dashboard.jpg");
+    CaptureSink sink;
+    StreamingImageDecoder decoder(&sink);
+    EXPECT_EQ(decodeInChunks(file, 1460, &sink, &decoder), DECODE_DONE);
+    EXPECT_EQ(sink.rows, 820);
+    // Far smaller than the ~130 KB file a download-then-decode path would buffer
+    EXPECT_LT(decoder.getPeakMemoryUsage(), 32u * 1024);
+    EXPECT_LT(decoder.getPeakMemoryUsage(), file.size());
+}
+
+// ============================================================================
+// Framebuffer Sink (quantization, dithering, clipping)
+// ============================================================================
+
+struct SinkCase {
+    uint8_t bitsPerPixel;
+    bool dither;
+    const char* golden;
+};
+
+class FramebufferSinkGoldenTest : public ::testing::TestWithParam<SinkCase> {};
+
+TEST_P(FramebufferSinkGoldenTest, MatchesGoldenLevels) {
+    const SinkCase& c = GetParam();
+    Pgm expected = readPgm(c.golden);
+    ASSERT_EQ(expected.width, 64);
+    ASSERT_EQ(expected.height, 48);
+
+    std::vector<uint8_t> buffer(PackedFramebuffer::bufferSize(64, 48, c.bitsPerPixel));
+    PackedFramebuffer framebuffer(buffer.data(), 64, 48, c.bitsPerPixel);
+    framebuffer.clear(c.bitsPerPixel == 3 ? 7 : 1);
+    FramebufferSink sink(&framebuffer, c.bitsPerPixel, c.dither, 64, 48);
+
+    EXPECT_EQ(decodeInChunks(readFile("png_gray8_filters.png"), 1460, &sink), DECODE_DONE);
+    EXPECT_EQ(sink.getMaxLevel(), expected.maxval);
+
+    size_t mismatches = 0;
+    for (int y = 0; y < 48; y++) {
+        for (int x = 0; x < 64; x++) {
+            if (framebuffer.getLevel(x, y) != expected.pixels[y * 64 + x]) {
+                mismatches++;
+            }
+        }
+    }
+    EXPECT_EQ(mismatches, 0u) << c.golden;
+}
+
+INSTANTIATE_TEST_SUITE_P(Sink, FramebufferSinkGoldenTest, ::testing::Values(
+    SinkCase{ 3, true, "sink_gray8_3bit_dither.pgm" },
+    SinkCase{ 3, false, "sink_gray8_3bit_nodither.pgm" },
+    SinkCase{ 1, true, "sink_gray8_1bit_dither.pgm" }
+));
+
+TEST(FramebufferSinkTest, ExtremesMapToBlackAndWhite) {
+    uint8_t buffer[4];
+    PackedFramebuffer framebuffer(buffer, 8, 1, 3);
+    FramebufferSink sink(&framebuffer, 3, true, 8, 1);
+    const uint8_t row[8] = { 0, 0, 0, 0, 255, 255, 255, 255 };
+
+    ASSERT_TRUE(sink.begin(8, 1));
+    sink.writeRow(0, row, 8);
+    for (int x = 0; x < 4; x++) {
+        EXPECT_EQ(framebuffer.getLevel(x, 0), 0);
+        EXPECT_EQ(framebuffer.getLevel(x + 4, 0), 7);
+    }
+}
+
+TEST(FramebufferSinkTest, ClipsToScreenAndAppliesOrigin) {
+    // 6x2 screen, 4x3 image placed at (4, -1): only columns 0-1 of rows 1-2 are visible
+    std::vector<uint8_t> buffer(PackedFramebuffer::bufferSize(6, 2, 1));
+    PackedFramebuffer framebuffer(buffer.data(), 6, 2, 1);
+    framebuffer.clear(1);
+    FramebufferSink sink(&framebuffer, 1, false, 6, 2, 4, -1);
+    const uint8_t black[4] = { 0, 0, 0, 0 };
+
+    ASSERT_TRUE(sink.begin(4, 3));
+    for (uint16_t y = 0; y < 3; y++) {
+        sink.writeRow(y, black, 4);
+    }
+    EXPECT_EQ(sink.getRowsWritten(), 3);
+    for (int y = 0; y < 2; y++) {
+        for (int x = 0; x < 6; x++) {
+            EXPECT_EQ(framebuffer.getLevel(x, y), x >= 4 ? 0 : 1) << x << "," << y;
+        }
+    }
+}
+
+TEST(FramebufferSinkTest, MemoryIsTwoErrorRowsPlusLevels) {
+    uint8_t buffer[1];
+    PackedFramebuffer framebuffer(buffer, 1, 1, 1);
+    FramebufferSink sink(&framebuffer, 3, true, 1200, 825);
+    ASSERT_TRUE(sink.begin(1200, 825));
+    EXPECT_EQ(sink.getMemoryUsage(), 2u * 1202 * sizeof(int16_t) + 1200);
+}
+
+// ============================================================================
+// IKFB Native Format (pre-quantized rows, no dithering on the device)
+// ============================================================================
+
+struct IkfbCase {
+    const char* image;
+    uint8_t bitsPerPixel;
+    const char* golden;
+    size_t chunkSize;
+};
+
+class IkfbGoldenTest : public ::testing::TestWithParam<IkfbCase> {};
+
+TEST_P(IkfbGoldenTest, WritesLevelsUnchanged) {
+    const IkfbCase& c = GetParam();
+    Pgm expected = readPgm(c.golden);
+    ASSERT_GT(expected.width, 0);
+    const uint16_t w = (uint16_t)expected.width;
+    const uint16_t h = (uint16_t)expected.height;
+
+    std::vector<uint8_t> buffer(PackedFramebuffer::bufferSize(w, h, c.bitsPerPixel));
+    PackedFramebuffer framebuffer(buffer.data(), w, h, c.bitsPerPixel);
+    framebuffer.clear(1);
+    FramebufferSink sink(&framebuffer, c.bitsPerPixel, true, w, h);
+    StreamingImageDecoder decoder(&sink);
+
+    EXPECT_EQ(decodeInChunks(readFile(c.image), c.chunkSize, &sink, &decoder), DECODE_DONE) << decoder.getError();
+    EXPECT_EQ(decoder.getFormat(), IMAGE_FORMAT_IKFB);
+    EXPECT_EQ(sink.getRowsWritten(), h);
+    EXPECT_EQ(sink.getMemoryUsage(), 0u);  // No dithering buffers
+
+    size_t mismatches = 0;
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            if (framebuffer.getLevel(x, y) != expected.pixels[y * w + x]) {
+                mismatches++;
+            }
+        }
+    }
+    EXPECT_EQ(mismatches, 0u) << c.image;
+}
+
+INSTANTIATE_TEST_SUITE_P(Ikfb, IkfbGoldenTest, ::testing::Values(
+    IkfbCase{ "ikfb_3bit_rle.ikfb", 3, "sink_gray8_3bit_dither.pgm", 1 },
+    IkfbCase{ "ikfb_3bit_rle.ikfb", 3, "sink_gray8_3bit_dither.pgm", 1460 },
+    IkfbCase{ "ikfb_1bit_raw.ikfb", 1, "sink_gray8_1bit_dither.pgm", 7 },
+    IkfbCase{ "ikfb_1bit_raw.ikfb", 1, "sink_gray8_1bit_dither.pgm", 1460 },
+    IkfbCase{ "ikfb_tricolor_rle.ikfb", 2, "ikfb_tricolor.pgm", 3 },
+    IkfbCase{ "ikfb_tricolor_rle.ikfb", 2, "ikfb_tricolor.pgm", 1460 }
+));
+
+TEST(IkfbTest, OtherPixelFormatIsRequantized) {
+    // 1-bit file on a 3-bit panel: expanded to gray 0/255, which dithers exactly to 0/7
+    Pgm expected = readPgm("sink_gray8_1bit_dither.pgm");
+    std::vector<uint8_t> buffer(PackedFramebuffer::bufferSize(64, 48, 3));
+    PackedFramebuffer framebuffer(buffer.data(), 64, 48, 3);
+    FramebufferSink sink(&framebuffer, 3, true, 64, 48);
+
+    EXPECT_EQ(decodeInChunks(readFile("ikfb_1bit_raw.ikfb"), 1460, &sink), DECODE_DONE);
+    EXPECT_GT(sink.getMemoryUsage(), 0u);  // Went through the quantizer
+    for (int y = 0; y < 48; y++) {
+        for (int x = 0; x < 64; x++) {
+            ASSERT_EQ(framebuffer.getLevel(x, y), expected.pixels[y * 64 + x] * 7) << x << "," << y;
+        }
+    }
+}
+
+TEST(IkfbTest, GrayFallbackForPlainSinks) {
+    Pgm expected = readPgm("ikfb_tricolor.pgm");
+    CaptureSink sink;
+    EXPECT_EQ(decodeInChunks(readFile("ikfb_tricolor_rle.ikfb"), 1460, &sink), DECODE_DONE);
+    ASSERT_EQ(sink.rows, expected.height);
+    const uint8_t gray[3] = { 0, 255, 128 };  // Red becomes mid gray
+    for (size_t i = 0; i < expected.pixels.size(); i++) {
+        ASSERT_EQ(sink.pixels[i], gray[expected.pixels[i]]) << i;
+    }
+}
+
+TEST(IkfbTest, RotationAndMemory) {
+    std::vector<uint8_t> file = readFile("dashboard.ikfb");
+    ASSERT_GT(file.size(), 16u);
+    file[7] = 2;  // Rendered for rotation 2
+    CaptureSink sink;
+    StreamingImageDecoder decoder(&sink);
+    EXPECT_EQ(decodeInChunks(file, 1460, &sink, &decoder), DECODE_DONE);
+    EXPECT_EQ(decoder.getRotation(), 2);
+    EXPECT_EQ(sink.rows, 820);
+    // One packed 3-bit row + one level row
+    EXPECT_EQ(decoder.getPeakMemoryUsage(), 600u + 1200u);
+}
+
+static std::vector<uint8_t> ikfbFile(uint8_t format, uint8_t compression, uint16_t w, uint16_t h,
+                                     std::vector<uint8_t> payload) {
+    std::vector<uint8_t> file = { 'I', 'K', 'F', 'B', 1, format, compression, 0,
+                                  (uint8_t)(w & 0xFF), (uint8_t)(w >> 8),
+                                  (uint8_t)(h & 0xFF), (uint8_t)(h >> 8), 0, 0, 0, 0 };
+    file.insert(file.end(), payload.begin(), payload.end());
+    return file;
+}
+
+TEST(IkfbTest, RleRunsCrossRowsAndTrailingBytesIgnored) {
+    // 16x3 1-bit: one run of 6 white bytes covers all rows, then junk
+    CaptureSink sink;
+    EXPECT_EQ(decodeInChunks(ikfbFile(PIXEL_FORMAT_1BIT, IKFB_COMPRESSION_RLE, 16, 3, { 251, 0xFF, 0x00, 0x42 }),
+                             1, &sink), DECODE_DONE);
+    EXPECT_EQ(sink.rows, 3);
+    EXPECT_EQ(sink.pixels, std::vector<uint8_t>(48, 255));
+}
+
+TEST(IkfbTest, MalformedFiles) {
+    CaptureSink sink;
+    StreamingImageDecoder decoder(&sink);
+    // Run of 7 bytes into a 6-byte image
+    EXPECT_EQ(decodeInChunks(ikfbFile(PIXEL_FORMAT_1BIT, IKFB_COMPRESSION_RLE, 16, 3, { 250, 0xFF }),
+                             1460, &sink, &decoder), DECODE_ERROR);
+    EXPECT_STREQ(decoder.getError(), "IKFB run extends past the last row");
+
+    EXPECT_EQ(decodeInChunks(ikfbFile(PIXEL_FORMAT_1BIT, IKFB_COMPRESSION_NONE, 0, 3, {}), 1460, &sink), DECODE_ERROR);
+    EXPECT_EQ(decodeInChunks(ikfbFile(PIXEL_FORMAT_1BIT, IKFB_COMPRESSION_NONE, 16, 3, { 0, 0, 0 }), 1460, &sink),
+              DECODE_ERROR);  // Truncated
+    EXPECT_EQ(decodeInChunks(ikfbFile(4, IKFB_COMPRESSION_NONE, 16, 3, {}), 1460, &sink), DECODE_UNSUPPORTED);
+    EXPECT_EQ(decodeInChunks(ikfbFile(PIXEL_FORMAT_1BIT, 2, 16, 3, {}), 1460, &sink), DECODE_UNSUPPORTED);
+
+    std::vector<uint8_t> future = ikfbFile(PIXEL_FORMAT_1BIT, IKFB_COMPRESSION_NONE, 16, 3, {});
+    future[4] = 2;
+    EXPECT_EQ(decodeInChunks(future, 1460, &sink), DECODE_UNSUPPORTED);
+}
+
+TEST(PackedFramebufferTest, TriColorPacking) {
+    uint8_t buffer[2];
+    PackedFramebuffer framebuffer(buffer, 6, 1, 2);
+    framebuffer.clear(1);
+    EXPECT_EQ(buffer[0], 0x55);
+    const uint8_t levels[3] = { 2, 0, 2 };
+    framebuffer.writeLevels(3, 0, levels, 3);
+    EXPECT_EQ(buffer[0], 0x56);  // 1 1 1 2
+    EXPECT_EQ(buffer[1], 0x25);  // 0 2 + two padding pixels
+    EXPECT_EQ(framebuffer.getLevel(5, 0), 2);
+}
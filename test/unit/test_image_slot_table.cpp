@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <image_slot_table.h>  // Real production code!
+
+// Test fixture for per-slot change detection state
+class ImageSlotTableTest : public ::testing::Test {
+protected:
+    ImageSlotTable table;
+
+    void SetUp() override {
+        initImageSlotTable(table);
+    }
+};
+
+// ============================================================================
+// Initialization and Validation Tests
+// ============================================================================
+
+TEST_F(ImageSlotTableTest, Init_NothingKnownNothingDisplayed) {
+    EXPECT_EQ(table.version, IMAGE_SLOT_TABLE_VERSION);
+    EXPECT_EQ(table.displayedSlot, IMAGE_SLOT_NONE);
+    EXPECT_EQ(table.knownMask, 0);
+    for (uint8_t slot = 0; slot < IMAGE_SLOT_COUNT; slot++) {
+        EXPECT_EQ(getSlotCRC32(table, slot), 0u);
+    }
+    EXPECT_TRUE(isImageSlotTableValid(table));
+}
+
+TEST_F(ImageSlotTableTest, Validate_WrongVersionRejected) {
+    table.version = IMAGE_SLOT_TABLE_VERSION + 1;
+    EXPECT_FALSE(isImageSlotTableValid(table));
+}
+
+TEST_F(ImageSlotTableTest, Validate_OutOfRangeFieldsRejected) {
+    table.displayedSlot = IMAGE_SLOT_COUNT;
+    EXPECT_FALSE(isImageSlotTableValid(table));
+
+    initImageSlotTable(table);
+    table.knownMask = (uint16_t)(1u << IMAGE_SLOT_COUNT);
+    EXPECT_FALSE(isImageSlotTableValid(table));
+}
+
+TEST_F(ImageSlotTableTest, Size_FitsCompactNvsBlob) {
+    EXPECT_EQ(sizeof(ImageSlotTable), 44u);
+}
+
+// ============================================================================
+// Record / Compare Tests
+// ============================================================================
+
+TEST_F(ImageSlotTableTest, Record_StoresCRC32AndDisplayedSlot) {
+    recordSlotDisplayed(table, 3, 0xDEADBEEF);
+
+    EXPECT_EQ(table.displayedSlot, 3);
+    EXPECT_EQ(getSlotCRC32(table, 3), 0xDEADBEEFu);
+    EXPECT_TRUE(isSlotUnchanged(table, 3, 0xDEADBEEF));
+    EXPECT_FALSE(isSlotUnchanged(table, 3, 0x12345678));
+}
+
+TEST_F(ImageSlotTableTest, Record_SlotsAreIndependent) {
+    // Carousel advance must not overwrite other slots (the old single-value bug)
+    recordSlotDisplayed(table, 0, 0x11111111);
+    recordSlotDisplayed(table, 1, 0x22222222);
+    recordSlotDisplayed(table, 2, 0x33333333);
+
+    EXPECT_TRUE(isSlotUnchanged(table, 0, 0x11111111));
+    EXPECT_TRUE(isSlotUnchanged(table, 1, 0x22222222));
+    EXPECT_TRUE(isSlotUnchanged(table, 2, 0x33333333));
+    EXPECT_EQ(table.displayedSlot, 2);
+}
+
+TEST_F(ImageSlotTableTest, Record_UnknownCRC32ForgetsSlot) {
+    recordSlotDisplayed(table, 1, 0xAAAAAAAA);
+    recordSlotDisplayed(table, 1, 0);  // Displayed via a path without CRC32
+
+    EXPECT_EQ(table.displayedSlot, 1);
+    EXPECT_EQ(getSlotCRC32(table, 1), 0u);
+    EXPECT_FALSE(isSlotUnchanged(table, 1, 0xAAAAAAAA));
+}
+
+TEST_F(ImageSlotTableTest, Compare_ZeroNeverMatches) {
+    // 0 means "CRC32 unavailable" on both sides
+    EXPECT_FALSE(isSlotUnchanged(table, 0, 0));
+    recordSlotDisplayed(table, 0, 0x12345678);
+    EXPECT_FALSE(isSlotUnchanged(table, 0, 0));
+}
+
+TEST_F(ImageSlotTableTest, Compare_UnknownSlotNeverMatches) {
+    EXPECT_FALSE(isSlotUnchanged(table, 5, 0x12345678));
+}
+
+TEST_F(ImageSlotTableTest, OutOfRangeSlot_Ignored) {
+    recordSlotDisplayed(table, IMAGE_SLOT_COUNT, 0x12345678);
+    EXPECT_EQ(table.displayedSlot, IMAGE_SLOT_NONE);
+    EXPECT_EQ(table.knownMask, 0);
+    EXPECT_EQ(getSlotCRC32(table, IMAGE_SLOT_NONE), 0u);
+    invalidateSlot(table, IMAGE_SLOT_NONE);  // Must not crash
+}
+
+// ============================================================================
+// Invalidation Tests
+// ============================================================================
+
+TEST_F(ImageSlotTableTest, Invalidate_ForgetsOnlyThatSlot) {
+    recordSlotDisplayed(table, 0, 0x11111111);
+    recordSlotDisplayed(table, 1, 0x22222222);
+
+    invalidateSlot(table, 0);
+
+    EXPECT_FALSE(isSlotUnchanged(table, 0, 0x11111111));
+    EXPECT_TRUE(isSlotUnchanged(table, 1, 0x22222222));
+    EXPECT_EQ(table.displayedSlot, 1) << "Invalidation does not change the screen";
+}
+
+TEST_F(ImageSlotTableTest, ClearDisplayed_KeepsCRC32s) {
+    recordSlotDisplayed(table, 2, 0x33333333);
+
+    clearDisplayedSlot(table);
+
+    EXPECT_EQ(table.displayedSlot, IMAGE_SLOT_NONE);
+    EXPECT_TRUE(isSlotUnchanged(table, 2, 0x33333333));
+}
+
+TEST_F(ImageSlotTableTest, Prune_DropsRemovedSlots) {
+    recordSlotDisplayed(table, 1, 0x22222222);
+    recordSlotDisplayed(table, 4, 0x55555555);
+
+    pruneImageSlots(table, 3);  // Carousel shrunk to 3 images
+
+    EXPECT_TRUE(isSlotUnchanged(table, 1, 0x22222222));
+    EXPECT_FALSE(isSlotUnchanged(table, 4, 0x55555555));
+    EXPECT_EQ(table.displayedSlot, IMAGE_SLOT_NONE) << "Displayed slot no longer exists";
+}
+
+TEST_F(ImageSlotTableTest, Prune_KeepsDisplayedSlotInRange) {
+    recordSlotDisplayed(table, 2, 0x33333333);
+    pruneImageSlots(table, 3);
+    EXPECT_EQ(table.displayedSlot, 2);
+}
@@ -0,0 +1,236 @@
+#include <gtest/gtest.h>
+#include <mqtt_connect_policy.h>
+
+// Test fixture for the adaptive MQTT connect policy
+class MqttConnectPolicyTest : public ::testing::Test {
+protected:
+    MqttConnectStats stats;
+
+    void SetUp() override {
+        initMqttConnectStats(stats);
+    }
+
+    // One timer wake while the broker is down: skip if planned, otherwise fail
+    void failedTimerWake() {
+        MqttConnectPlan plan = planMqttConnect(stats, false);
+        if (plan.skip) {
+            recordMqttConnectSkipped(stats);
+        } else {
+            recordMqttConnectFailure(stats);
+        }
+    }
+
+    // Worst-case connect time of a plan against an unreachable broker
+    uint32_t simulateOutage(const MqttConnectPlan& plan) {
+        uint32_t spent = 0;
+        for (uint8_t attempt = 1; attempt <= plan.attempts && canStartMqttAttempt(plan, spent); attempt++) {
+            spent += plan.socketTimeoutS * 1000;
+            // Same as MQTTManager::connect(): no delay unless the next attempt fits
+            if (attempt < plan.attempts && canStartMqttAttempt(plan, spent + plan.retryDelayMs)) {
+                spent += plan.retryDelayMs;
+            }
+        }
+        return spent;
+    }
+};
+
+// ============================================================================
+// Stats validation
+// ============================================================================
+
+TEST_F(MqttConnectPolicyTest, InitializedStatsAreValid) {
+    EXPECT_TRUE(isMqttConnectStatsValid(stats));
+    EXPECT_EQ(stats.failureStreak, 0);
+    EXPECT_EQ(stats.skipRemaining, 0);
+    EXPECT_EQ(stats.historyCount, 0);
+}
+
+TEST_F(MqttConnectPolicyTest, ColdBootStatsAreInvalid) {
+    MqttConnectStats zeroed = {};
+    EXPECT_FALSE(isMqttConnectStatsValid(zeroed));
+}
+
+TEST_F(MqttConnectPolicyTest, CorruptStatsAreInvalid) {
+    stats.historyCount = MQTT_CONNECT_HISTORY + 1;
+    EXPECT_FALSE(isMqttConnectStatsValid(stats));
+
+    initMqttConnectStats(stats);
+    stats.historyNext = MQTT_CONNECT_HISTORY;
+    EXPECT_FALSE(isMqttConnectStatsValid(stats));
+
+    initMqttConnectStats(stats);
+    stats.skipRemaining = MQTT_BACKOFF_MAX_SKIP + 1;
+    EXPECT_FALSE(isMqttConnectStatsValid(stats));
+}
+
+// ============================================================================
+// Planning without history
+// ============================================================================
+
+TEST_F(MqttConnectPolicyTest, NoHistoryKeepsDefaultTiming) {
+    MqttConnectPlan plan = planMqttConnect(stats, false);
+    EXPECT_FALSE(plan.skip);
+    EXPECT_EQ(plan.attempts, MQTT_CONNECT_MAX_ATTEMPTS);
+    EXPECT_EQ(plan.socketTimeoutS, MQTT_CONNECT_DEFAULT_TIMEOUT_S);
+    EXPECT_EQ(plan.retryDelayMs, MQTT_CONNECT_RETRY_DELAY_MS);
+    EXPECT_EQ(plan.budgetMs, (uint32_t)MQTT_CYCLE_BUDGET_MS);
+}
+
+TEST_F(MqttConnectPolicyTest, BudgetCapsFixedRetryWorstCase) {
+    // The old fixed scheme spent 3 x 2 s + 2 x 1 s = 8 s on a dead broker
+    MqttConnectPlan plan = planMqttConnect(stats, false);
+    EXPECT_LE(simulateOutage(plan), (uint32_t)MQTT_CYCLE_BUDGET_MS);
+}
+
+TEST_F(MqttConnectPolicyTest, AttemptMustFitRemainingBudget) {
+    MqttConnectPlan plan = planMqttConnect(stats, false);
+    EXPECT_TRUE(canStartMqttAttempt(plan, 0));
+    EXPECT_TRUE(canStartMqttAttempt(plan, MQTT_CYCLE_BUDGET_MS - 2000));
+    EXPECT_FALSE(canStartMqttAttempt(plan, MQTT_CYCLE_BUDGET_MS - 1999));
+    EXPECT_FALSE(canStartMqttAttempt(plan, MQTT_CYCLE_BUDGET_MS + 1000));
+}
+
+// ============================================================================
+// Learned latency
+// ============================================================================
+
+TEST_F(MqttConnectPolicyTest, FastBrokerShortensTimeoutAndDelay) {
+    recordMqttConnectSuccess(stats, 80);
+    recordMqttConnectSuccess(stats, 120);
+
+    EXPECT_EQ(getMqttConnectLatencyEstimate(stats), 120u);
+    MqttConnectPlan plan = planMqttConnect(stats, false);
+    EXPECT_EQ(plan.socketTimeoutS, 1);
+    EXPECT_EQ(plan.retryDelayMs, MQTT_CONNECT_MIN_RETRY_DELAY_MS);
+}
+
+TEST_F(MqttConnectPolicyTest, SlowBrokerGetsLongerTimeoutUpToLimit) {
+    recordMqttConnectSuccess(stats, 900);
+    MqttConnectPlan plan = planMqttConnect(stats, false);
+    EXPECT_EQ(plan.socketTimeoutS, 3);  // ceil(3 x 0.9 s)
+    EXPECT_EQ(plan.retryDelayMs, 900);
+
+    recordMqttConnectSuccess(stats, 4000);
+    plan = planMqttConnect(stats, false);
+    EXPECT_EQ(plan.socketTimeoutS, MQTT_CONNECT_MAX_TIMEOUT_S);
+    EXPECT_EQ(plan.retryDelayMs, MQTT_CONNECT_RETRY_DELAY_MS);
+}
+
+TEST_F(MqttConnectPolicyTest, HistoryKeepsOnlyRecentLatencies) {
+    recordMqttConnectSuccess(stats, 1500);  // One slow connect ...
+    for (int i = 0; i < MQTT_CONNECT_HISTORY; i++) {
+        recordMqttConnectSuccess(stats, 100);  // ... ages out
+    }
+    EXPECT_EQ(stats.historyCount, MQTT_CONNECT_HISTORY);
+    EXPECT_EQ(getMqttConnectLatencyEstimate(stats), 100u);
+}
+
+TEST_F(MqttConnectPolicyTest, HugeLatencySaturates) {
+    recordMqttConnectSuccess(stats, 100000);
+    EXPECT_EQ(getMqttConnectLatencyEstimate(stats), 0xFFFFu);
+    EXPECT_EQ(planMqttConnect(stats, false).socketTimeoutS, MQTT_CONNECT_MAX_TIMEOUT_S);
+}
+
+// ============================================================================
+// Broker outages and back-off
+// ============================================================================
+
+TEST_F(MqttConnectPolicyTest, FirstFailureOnlyProbesNextWake) {
+    recordMqttConnectFailure(stats);
+
+    MqttConnectPlan plan = planMqttConnect(stats, false);
+    EXPECT_FALSE(plan.skip);
+    EXPECT_EQ(plan.attempts, 1);
+}
+
+TEST_F(MqttConnectPolicyTest, RepeatedFailuresBackOffExponentially) {
+    recordMqttConnectFailure(stats);
+    EXPECT_EQ(stats.skipRemaining, 0);
+    recordMqttConnectFailure(stats);
+    EXPECT_EQ(stats.skipRemaining, 1);
+    recordMqttConnectFailure(stats);
+    EXPECT_EQ(stats.skipRemaining, 2);
+    recordMqttConnectFailure(stats);
+    EXPECT_EQ(stats.skipRemaining, 4);
+    recordMqttConnectFailure(stats);
+    EXPECT_EQ(stats.skipRemaining, 8);
+}
+
+TEST_F(MqttConnectPolicyTest, BackOffIsCapped) {
+    for (int i = 0; i < 300; i++) {
+        recordMqttConnectFailure(stats);
+    }
+    EXPECT_EQ(stats.failureStreak, 0xFF);
+    EXPECT_EQ(stats.skipRemaining, MQTT_BACKOFF_MAX_SKIP);
+    EXPECT_TRUE(isMqttConnectStatsValid(stats));
+}
+
+TEST_F(MqttConnectPolicyTest, TimerWakesSkipUntilBackOffExpires) {
+    recordMqttConnectFailure(stats);
+    recordMqttConnectFailure(stats);
+    recordMqttConnectFailure(stats);  // Skip the next 2 timer wakes
+
+    EXPECT_TRUE(planMqttConnect(stats, false).skip);
+    recordMqttConnectSkipped(stats);
+    EXPECT_TRUE(planMqttConnect(stats, false).skip);
+    recordMqttConnectSkipped(stats);
+
+    MqttConnectPlan plan = planMqttConnect(stats, false);
+    EXPECT_FALSE(plan.skip);
+    EXPECT_EQ(plan.attempts, 1);
+}
+
+TEST_F(MqttConnectPolicyTest, UserWakeIgnoresBackOff) {
+    for (int i = 0; i < 5; i++) {
+        recordMqttConnectFailure(stats);
+    }
+
+    MqttConnectPlan plan = planMqttConnect(stats, true);
+    EXPECT_FALSE(plan.skip);
+    EXPECT_EQ(plan.attempts, MQTT_CONNECT_MAX_ATTEMPTS);
+}
+
+TEST_F(MqttConnectPolicyTest, RecoveryClearsBackOffAndKeepsHistory) {
+    recordMqttConnectSuccess(stats, 200);
+    for (int i = 0; i < 4; i++) {
+        recordMqttConnectFailure(stats);
+    }
+    recordMqttConnectSuccess(stats, 300);
+
+    MqttConnectPlan plan = planMqttConnect(stats, false);
+    EXPECT_FALSE(plan.skip);
+    EXPECT_EQ(plan.attempts, MQTT_CONNECT_MAX_ATTEMPTS);
+    EXPECT_EQ(stats.failureStreak, 0);
+    EXPECT_EQ(stats.historyCount, 2);
+    EXPECT_EQ(getMqttConnectLatencyEstimate(stats), 300u);
+}
+
+TEST_F(MqttConnectPolicyTest, DayLongOutageContactsBrokerRarely) {
+    // 15 minute timer wakes for 24 hours against a dead broker
+    int attempted = 0;
+    for (int wake = 0; wake < 96; wake++) {
+        if (!planMqttConnect(stats, false).skip) {
+            attempted++;
+        }
+        failedTimerWake();
+    }
+    // 2 probes, then back-off 1+2+4+8+16+32+32 ... wakes between probes
+    EXPECT_LE(attempted, 10);
+    EXPECT_GE(attempted, 5);
+    EXPECT_TRUE(isMqttConnectStatsValid(stats));
+}
+
+TEST_F(MqttConnectPolicyTest, OutageCostsLessThanFixedRetry) {
+    const uint32_t fixedRetryMs = 3 * 2000 + 2 * 1000;
+    uint32_t adaptiveMs = 0;
+    for (int wake = 0; wake < 20; wake++) {
+        MqttConnectPlan plan = planMqttConnect(stats, false);
+        if (plan.skip) {
+            recordMqttConnectSkipped(stats);
+            continue;
+        }
+        adaptiveMs += simulateOutage(plan);
+        recordMqttConnectFailure(stats);
+    }
+    EXPECT_LT(adaptiveMs * 10, fixedRetryMs * 20);  // Over 90 % less radio time
+}
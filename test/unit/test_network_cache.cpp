@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+#include <network_cache.h>
+#include <cstring>
+#include <string>
+
+// Test fixture for the RTC DHCP lease / DNS cache
+class NetworkCacheTest : public ::testing::Test {
+protected:
+    NetworkCache cache;
+    const uint8_t bssid[6] = { 0x24, 0x4B, 0xFE, 0x01, 0x02, 0x03 };
+    const uint32_t now = 1760000000;
+    uint32_t home;
+
+    void SetUp() override {
+        initNetworkCache(cache);
+        home = networkCacheHash("home");
+    }
+
+    DhcpLeaseCache makeLease() {
+        DhcpLeaseCache lease = {};
+        lease.ip = 0x2A01A8C0u;        // 192.168.1.42
+        lease.gateway = 0x0101A8C0u;
+        lease.subnet = 0x00FFFFFFu;
+        lease.dns1 = 0x0101A8C0u;
+        lease.dns2 = 0x08080808u;
+        return lease;
+    }
+};
+
+// ============================================================================
+// Validation
+// ============================================================================
+
+TEST_F(NetworkCacheTest, InitializedCacheIsValidAndEmpty) {
+    EXPECT_TRUE(isNetworkCacheValid(cache));
+    EXPECT_EQ(getReusableDhcpLease(cache, home, bssid, now), nullptr);
+    uint32_t ip;
+    EXPECT_FALSE(lookupDnsCache(cache, "example.com", now, ip));
+}
+
+TEST_F(NetworkCacheTest, ColdBootCacheIsInvalid) {
+    NetworkCache zeroed = {};
+    EXPECT_FALSE(isNetworkCacheValid(zeroed));
+}
+
+TEST_F(NetworkCacheTest, UnterminatedHostIsInvalid) {
+    memset(cache.dns[2].host, 'a', DNS_CACHE_HOST_SIZE);
+    EXPECT_FALSE(isNetworkCacheValid(cache));
+}
+
+TEST_F(NetworkCacheTest, NetworkHashIsStableAndNeverZero) {
+    EXPECT_EQ(networkCacheHash("home"), networkCacheHash("home"));
+    EXPECT_NE(networkCacheHash("home"), networkCacheHash("home-5G"));
+    EXPECT_NE(networkCacheHash(""), 0u);
+    EXPECT_NE(networkCacheHash(nullptr), 0u);
+}
+
+// ============================================================================
+// DHCP lease
+// ============================================================================
+
+TEST_F(NetworkCacheTest, LeaseReusedOnSameNetworkBeforeT1) {
+    storeDhcpLease(cache, makeLease(), 86400, home, bssid, now);
+
+    const DhcpLeaseCache* lease = getReusableDhcpLease(cache, home, bssid, now + 600);
+    ASSERT_NE(lease, nullptr);
+    EXPECT_EQ(lease->ip, 0x2A01A8C0u);
+    EXPECT_EQ(lease->gateway, 0x0101A8C0u);
+    EXPECT_EQ(lease->subnet, 0x00FFFFFFu);
+    EXPECT_EQ(lease->dns2, 0x08080808u);
+    EXPECT_EQ(lease->leaseSeconds, 86400u);
+}
+
+TEST_F(NetworkCacheTest, LeaseNotReusedFromT1) {
+    storeDhcpLease(cache, makeLease(), 86400, home, bssid, now);
+    EXPECT_NE(getReusableDhcpLease(cache, home, bssid, now + 43199), nullptr);
+    EXPECT_EQ(getReusableDhcpLease(cache, home, bssid, now + 43200), nullptr);
+}
+
+TEST_F(NetworkCacheTest, UnknownLeaseTimeUsesDefault) {
+    storeDhcpLease(cache, makeLease(), 0, home, bssid, now);
+    EXPECT_EQ(cache.lease.leaseSeconds, (uint32_t)DHCP_LEASE_DEFAULT_SECONDS);
+    EXPECT_NE(getReusableDhcpLease(cache, home, bssid, now + DHCP_LEASE_DEFAULT_SECONDS / 2 - 1), nullptr);
+    EXPECT_EQ(getReusableDhcpLease(cache, home, bssid, now + DHCP_LEASE_DEFAULT_SECONDS / 2), nullptr);
+}
+
+TEST_F(NetworkCacheTest, LeaseNotReusedOnOtherNetworkOrAccessPoint) {
+    storeDhcpLease(cache, makeLease(), 86400, home, bssid, now);
+
+    EXPECT_EQ(getReusableDhcpLease(cache, networkCacheHash("office"), bssid, now), nullptr);
+    uint8_t otherAp[6] = { 0x24, 0x4B, 0xFE, 0x01, 0x02, 0x04 };
+    EXPECT_EQ(getReusableDhcpLease(cache, home, otherAp, now), nullptr);
+    EXPECT_EQ(getReusableDhcpLease(cache, home, nullptr, now), nullptr);
+}
+
+TEST_F(NetworkCacheTest, LeaseExpiredWhenClockMovedBackwards) {
+    storeDhcpLease(cache, makeLease(), 86400, home, bssid, now);
+    EXPECT_EQ(getReusableDhcpLease(cache, home, bssid, now - 1), nullptr);
+}
+
+TEST_F(NetworkCacheTest, LeaseObtainedBeforeFirstNtpSyncExpires) {
+    // Stored with the unsynced clock shortly after a cold boot, NTP then sets 2025
+    storeDhcpLease(cache, makeLease(), 86400, home, bssid, 12);
+    EXPECT_EQ(getReusableDhcpLease(cache, home, bssid, now), nullptr);
+}
+
+TEST_F(NetworkCacheTest, InvalidatedOrEmptyLeaseNotReused) {
+    storeDhcpLease(cache, makeLease(), 86400, home, bssid, now);
+    invalidateDhcpLease(cache);
+    EXPECT_EQ(getReusableDhcpLease(cache, home, bssid, now), nullptr);
+
+    DhcpLeaseCache noAddress = makeLease();
+    noAddress.ip = 0;
+    storeDhcpLease(cache, noAddress, 86400, home, bssid, now);
+    EXPECT_EQ(getReusableDhcpLease(cache, home, bssid, now), nullptr);
+}
+
+// ============================================================================
+// DNS cache
+// ============================================================================
+
+TEST_F(NetworkCacheTest, ResolvedHostFoundUntilTtl) {
+    EXPECT_TRUE(storeDnsCache(cache, "dashboard.example.com", 0x0A01A8C0u, now));
+
+    uint32_t ip = 0;
+    EXPECT_TRUE(lookupDnsCache(cache, "dashboard.example.com", now + DNS_CACHE_TTL_SECONDS - 1, ip));
+    EXPECT_EQ(ip, 0x0A01A8C0u);
+    EXPECT_FALSE(lookupDnsCache(cache, "dashboard.example.com", now + DNS_CACHE_TTL_SECONDS, ip));
+    EXPECT_FALSE(lookupDnsCache(cache, "dashboard.example.com", now - 1, ip));
+}
+
+TEST_F(NetworkCacheTest, HostNamesMatchCaseInsensitively) {
+    storeDnsCache(cache, "Dashboard.Example.com", 0x0A01A8C0u, now);
+
+    uint32_t ip = 0;
+    EXPECT_TRUE(lookupDnsCache(cache, "dashboard.example.COM", now, ip));
+    EXPECT_FALSE(lookupDnsCache(cache, "dashboard.example.co", now, ip));
+    EXPECT_FALSE(lookupDnsCache(cache, "dashboard.example.com.au", now, ip));
+}
+
+TEST_F(NetworkCacheTest, StoringSameHostUpdatesEntry) {
+    storeDnsCache(cache, "broker.local", 1, now);
+    storeDnsCache(cache, "BROKER.local", 2, now + 10);
+
+    uint32_t ip = 0;
+    EXPECT_TRUE(lookupDnsCache(cache, "broker.local", now + 10, ip));
+    EXPECT_EQ(ip, 2u);
+    int used = 0;
+    for (int i = 0; i < DNS_CACHE_ENTRIES; i++) {
+        used += cache.dns[i].host[0] != '\0';
+    }
+    EXPECT_EQ(used, 1);
+}
+
+TEST_F(NetworkCacheTest, FullCacheReplacesOldestEntry) {
+    for (int i = 0; i < DNS_CACHE_ENTRIES; i++) {
+        std::string host = "host" + std::to_string(i) + ".example.com";
+        storeDnsCache(cache, host.c_str(), 100 + i, now + i);
+    }
+    storeDnsCache(cache, "new.example.com", 200, now + 100);
+
+    uint32_t ip = 0;
+    EXPECT_FALSE(lookupDnsCache(cache, "host0.example.com", now + 100, ip));
+    EXPECT_TRUE(lookupDnsCache(cache, "host1.example.com", now + 100, ip));
+    EXPECT_TRUE(lookupDnsCache(cache, "new.example.com", now + 100, ip));
+    EXPECT_EQ(ip, 200u);
+}
+
+TEST_F(NetworkCacheTest, InvalidatedHostIsResolvedAgain) {
+    storeDnsCache(cache, "dashboard.example.com", 0x0A01A8C0u, now);
+    storeDnsCache(cache, "broker.local", 0x0B01A8C0u, now);
+    invalidateDnsCache(cache, "dashboard.example.com");
+
+    uint32_t ip = 0;
+    EXPECT_FALSE(lookupDnsCache(cache, "dashboard.example.com", now, ip));
+    EXPECT_TRUE(lookupDnsCache(cache, "broker.local", now, ip));
+    invalidateDnsCache(cache, "unknown.example.com");  // No-op
+    invalidateDnsCache(cache, nullptr);
+    EXPECT_TRUE(isNetworkCacheValid(cache));
+}
+
+TEST_F(NetworkCacheTest, UncacheableHostsAreRejected) {
+    std::string longHost(DNS_CACHE_HOST_SIZE, 'a');
+    EXPECT_FALSE(storeDnsCache(cache, longHost.c_str(), 1, now));
+    EXPECT_TRUE(storeDnsCache(cache, longHost.substr(1).c_str(), 1, now));  // Fits with the terminator
+    EXPECT_FALSE(storeDnsCache(cache, "", 1, now));
+    EXPECT_FALSE(storeDnsCache(cache, nullptr, 1, now));
+    EXPECT_FALSE(storeDnsCache(cache, "example.com", 0, now));
+
+    uint32_t ip;
+    EXPECT_FALSE(lookupDnsCache(cache, nullptr, now, ip));
+    EXPECT_TRUE(isNetworkCacheValid(cache));
+}
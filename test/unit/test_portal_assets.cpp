@@ -0,0 +1,214 @@
+#include <gtest/gtest.h>
+#include <portal_assets.h>          // Real production code!
+#include <config_portal_assets.h>   // Generated by scripts/generate_portal_assets.py
+#include <config_portal_css.h>      // Sources the assets are generated from
+#include <config_portal_js.h>
+#include <inflate_stream.h>
+#include <stdio.h>
+#include <string>
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// Same line-based minification as scripts/generate_portal_assets.py
+static std::string minify(const std::string& text, bool stylesheet) {
+    std::string source = text;
+    if (stylesheet) {
+        size_t start;
+        while ((start = source.find("/*")) != std::string::npos) {
+            size_t end = source.find("*/", start + 2);
+            source.erase(start, end == std::string::npos ? std::string::npos : end + 2 - start);
+        }
+    }
+    std::string result;
+    size_t pos = 0;
+    while (pos <= source.size()) {
+        size_t end = source.find('\n', pos);
+        if (end == std::string::npos) {
+            end = source.size();
+        }
+        std::string line = source.substr(pos, end - pos);
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first != std::string::npos) {
+            line = line.substr(first, line.find_last_not_of(" \t\r") - first + 1);
+            if (stylesheet || line.compare(0, 2, "//") != 0) {
+                if (!result.empty()) {
+                    result += '\n';
+                }
+                result += line;
+            }
+        }
+        pos = end + 1;
+    }
+    return result;
+}
+
+static std::string expectedContent(const char* path) {
+    std::string p = path;
+    if (p == "/styles.css") {
+        return minify(CONFIG_PORTAL_CSS, true);
+    }
+    if (p == "/scripts/main.js") {
+        std::string js = CONFIG_PORTAL_MODAL_SCRIPT;
+        js += "\n";
+        js += CONFIG_PORTAL_FRIENDLY_NAME_SCRIPT;
+        js += "\n";
+        js += CONFIG_PORTAL_BATTERY_CALC_SCRIPT;
+        js += "\n";
+        js += CONFIG_PORTAL_BADGE_SCRIPT;
+        return minify(js, false);
+    }
+    if (p == "/scripts/ota.js") {
+        return minify(CONFIG_PORTAL_OTA_SCRIPT, false);
+    }
+    if (p == "/scripts/ota-status.js") {
+        return minify(CONFIG_PORTAL_OTA_STATUS_SCRIPT, false);
+    }
+    ADD_FAILURE() << "No source known for " << path;
+    return "";
+}
+
+static uint32_t crc32(const std::string& data) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < data.size(); i++) {
+        crc ^= (uint8_t)data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+static uint32_t readLE32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void appendOutput(void* context, const uint8_t* data, size_t length) {
+    static_cast<std::string*>(context)->append((const char*)data, length);
+}
+
+// Decompress a gzip stream written without optional header fields
+static bool gunzip(const PortalAsset& asset, std::string& out) {
+    if (asset.length < 18 || asset.data[0] != 0x1f || asset.data[1] != 0x8b ||
+        asset.data[2] != 8 || asset.data[3] != 0) {
+        return false;
+    }
+    InflateStream inflate;
+    if (!inflate.begin(appendOutput, &out)) {
+        return false;
+    }
+    InflateStatus status = inflate.feed(asset.data + 10, asset.length - 18, true);
+    inflate.end();
+    return status == INFLATE_DONE;
+}
+
+static std::string quotedCrc(uint32_t crc) {
+    char etag[16];
+    snprintf(etag, sizeof(etag), "\"%08x\"", crc);
+    return etag;
+}
+
+// ============================================================================
+// Generated Assets
+// ============================================================================
+
+TEST(PortalAssetsTest, Generated_RoundTripToSources) {
+    ASSERT_EQ(4u, PORTAL_ASSET_COUNT);
+    for (size_t i = 0; i < PORTAL_ASSET_COUNT; i++) {
+        const PortalAsset& asset = PORTAL_ASSETS[i];
+        SCOPED_TRACE(asset.path);
+        std::string content;
+        ASSERT_TRUE(gunzip(asset, content));
+        // A mismatch means the sources changed: run scripts/generate_portal_assets.py
+        EXPECT_EQ(expectedContent(asset.path), content);
+        EXPECT_EQ(asset.originalLength, content.size());
+    }
+}
+
+TEST(PortalAssetsTest, Generated_TrailerMatchesContent) {
+    for (size_t i = 0; i < PORTAL_ASSET_COUNT; i++) {
+        const PortalAsset& asset = PORTAL_ASSETS[i];
+        SCOPED_TRACE(asset.path);
+        std::string content;
+        ASSERT_TRUE(gunzip(asset, content));
+        const uint8_t* trailer = asset.data + asset.length - 8;
+        EXPECT_EQ(crc32(content), readLE32(trailer));
+        EXPECT_EQ((uint32_t)content.size(), readLE32(trailer + 4));
+    }
+}
+
+TEST(PortalAssetsTest, Generated_ETagIsContentCrc) {
+    for (size_t i = 0; i < PORTAL_ASSET_COUNT; i++) {
+        const PortalAsset& asset = PORTAL_ASSETS[i];
+        SCOPED_TRACE(asset.path);
+        std::string content;
+        ASSERT_TRUE(gunzip(asset, content));
+        EXPECT_EQ(quotedCrc(crc32(content)), asset.etag);
+    }
+}
+
+TEST(PortalAssetsTest, Generated_UrlsCarryTheETag) {
+    const char* urls[] = {PORTAL_STYLES_CSS_URL, PORTAL_MAIN_JS_URL, PORTAL_OTA_JS_URL, PORTAL_OTA_STATUS_JS_URL};
+    for (size_t i = 0; i < PORTAL_ASSET_COUNT; i++) {
+        const PortalAsset& asset = PORTAL_ASSETS[i];
+        std::string etag = asset.etag;
+        std::string expected = std::string(asset.path) + "?v=" + etag.substr(1, etag.size() - 2);
+        EXPECT_EQ(expected, urls[i]);
+    }
+}
+
+TEST(PortalAssetsTest, Generated_CompressedToLessThanHalf) {
+    for (size_t i = 0; i < PORTAL_ASSET_COUNT; i++) {
+        const PortalAsset& asset = PORTAL_ASSETS[i];
+        SCOPED_TRACE(asset.path);
+        EXPECT_LT(asset.length * 2, asset.originalLength);
+    }
+}
+
+TEST(PortalAssetsTest, Generated_PathsAndContentTypes) {
+    EXPECT_STREQ("/styles.css", PORTAL_ASSETS[0].path);
+    EXPECT_STREQ("text/css", PORTAL_ASSETS[0].contentType);
+    for (size_t i = 1; i < PORTAL_ASSET_COUNT; i++) {
+        EXPECT_STREQ("application/javascript", PORTAL_ASSETS[i].contentType);
+        for (size_t j = 0; j < i; j++) {
+            EXPECT_STRNE(PORTAL_ASSETS[j].path, PORTAL_ASSETS[i].path);
+        }
+    }
+}
+
+// ============================================================================
+// If-None-Match Tests
+// ============================================================================
+
+TEST(PortalAssetsTest, ETag_SingleTag) {
+    EXPECT_TRUE(portalETagMatches("\"b8fb9c6f\"", "\"b8fb9c6f\""));
+    EXPECT_FALSE(portalETagMatches("\"b8fb9c60\"", "\"b8fb9c6f\""));
+}
+
+TEST(PortalAssetsTest, ETag_NotSent) {
+    EXPECT_FALSE(portalETagMatches(nullptr, "\"b8fb9c6f\""));
+    EXPECT_FALSE(portalETagMatches("", "\"b8fb9c6f\""));
+    EXPECT_FALSE(portalETagMatches("   ", "\"b8fb9c6f\""));
+}
+
+TEST(PortalAssetsTest, ETag_ListAndWeak) {
+    EXPECT_TRUE(portalETagMatches("\"aaaaaaaa\", \"b8fb9c6f\"", "\"b8fb9c6f\""));
+    EXPECT_TRUE(portalETagMatches("\"aaaaaaaa\",W/\"b8fb9c6f\"", "\"b8fb9c6f\""));
+    EXPECT_FALSE(portalETagMatches("\"aaaaaaaa\", \"bbbbbbbb\"", "\"b8fb9c6f\""));
+}
+
+TEST(PortalAssetsTest, ETag_Wildcard) {
+    EXPECT_TRUE(portalETagMatches("*", "\"b8fb9c6f\""));
+}
+
+TEST(PortalAssetsTest, ETag_NoPartialMatch) {
+    EXPECT_FALSE(portalETagMatches("\"b8fb9c6\"", "\"b8fb9c6f\""));
+    EXPECT_FALSE(portalETagMatches("\"b8fb9c6f0\"", "\"b8fb9c6f\""));
+    EXPECT_FALSE(portalETagMatches("b8fb9c6f", "\"b8fb9c6f\""));
+}
+
+TEST(PortalAssetsTest, ETag_CommaInsideQuotes) {
+    EXPECT_TRUE(portalETagMatches("\"a,b\", \"b8fb9c6f\"", "\"b8fb9c6f\""));
+    EXPECT_TRUE(portalETagMatches("\"a,b\"", "\"a,b\""));
+}
@@ -0,0 +1,240 @@
+#include <gtest/gtest.h>
+#include <prefetch_cache.h>
+#include <image_slot_table.h>
+
+// Test fixture for the carousel prefetch index and the offline display decision
+class PrefetchCacheTest : public ::testing::Test {
+protected:
+    PrefetchIndex index;
+    const uint32_t t0 = 1760000000;
+    const uint32_t url1 = prefetchUrlHash("http://example.com/img1.png");
+    const uint32_t url2 = prefetchUrlHash("http://example.com/img2.png");
+
+    void SetUp() override {
+        initPrefetchIndex(index);
+    }
+};
+
+// ============================================================================
+// Index validation
+// ============================================================================
+
+TEST_F(PrefetchCacheTest, InitializedIndexIsValidAndEmpty) {
+    EXPECT_TRUE(isPrefetchIndexValid(index));
+    EXPECT_FALSE(hasPrefetchedImages(index));
+    EXPECT_EQ(findPrefetchEntry(index, 0), nullptr);
+    EXPECT_EQ(getPrefetchBudget(index, 0), PREFETCH_MAX_BYTES);
+}
+
+TEST_F(PrefetchCacheTest, ColdBootIndexIsInvalid) {
+    PrefetchIndex zeroed = {};
+    EXPECT_FALSE(isPrefetchIndexValid(zeroed));
+}
+
+TEST_F(PrefetchCacheTest, CorruptIndexIsInvalid) {
+    index.entries[0].slot = IMAGE_SLOT_COUNT;
+    EXPECT_FALSE(isPrefetchIndexValid(index));
+
+    initPrefetchIndex(index);
+    index.entries[0].slot = 3;
+    index.entries[2].slot = 3;  // Same slot twice
+    EXPECT_FALSE(isPrefetchIndexValid(index));
+}
+
+TEST_F(PrefetchCacheTest, UrlHashIsNeverZeroAndDistinguishesUrls) {
+    EXPECT_NE(prefetchUrlHash(""), 0u);
+    EXPECT_NE(prefetchUrlHash(nullptr), 0u);
+    EXPECT_NE(url1, url2);
+    EXPECT_EQ(url1, prefetchUrlHash("http://example.com/img1.png"));
+}
+
+// ============================================================================
+// Planning which slots to fetch ahead
+// ============================================================================
+
+TEST_F(PrefetchCacheTest, PlansNextSlotsInTimerOrder) {
+    bool stay[5] = { false, false, false, false, false };
+    uint8_t slots[PREFETCH_MAX_ENTRIES];
+    ASSERT_EQ(planPrefetchSlots(stay, 5, 1, 3, slots), 3);
+    EXPECT_EQ(slots[0], 2);
+    EXPECT_EQ(slots[1], 3);
+    EXPECT_EQ(slots[2], 4);
+}
+
+TEST_F(PrefetchCacheTest, PlanWrapsButStopsBeforeCurrentSlot) {
+    bool stay[3] = { false, false, false };
+    uint8_t slots[PREFETCH_MAX_ENTRIES];
+    ASSERT_EQ(planPrefetchSlots(stay, 3, 2, 4, slots), 2);
+    EXPECT_EQ(slots[0], 0);
+    EXPECT_EQ(slots[1], 1);
+}
+
+TEST_F(PrefetchCacheTest, PlanEndsAfterStaySlot) {
+    bool stay[4] = { false, true, false, false };
+    uint8_t slots[PREFETCH_MAX_ENTRIES];
+    ASSERT_EQ(planPrefetchSlots(stay, 4, 0, 3, slots), 1);
+    EXPECT_EQ(slots[0], 1);
+
+    // The carousel stays on the current slot: timer wakes never advance
+    EXPECT_EQ(planPrefetchSlots(stay, 4, 1, 3, slots), 0);
+}
+
+TEST_F(PrefetchCacheTest, PlanDepthIsCapped) {
+    bool stay[10] = {};
+    uint8_t slots[PREFETCH_MAX_ENTRIES];
+    EXPECT_EQ(planPrefetchSlots(stay, 10, 0, 9, slots), PREFETCH_MAX_ENTRIES);
+    EXPECT_EQ(planPrefetchSlots(stay, 10, 0, 0, slots), 0);
+}
+
+TEST_F(PrefetchCacheTest, SingleImageModePlansNothing) {
+    bool stay[1] = { false };
+    uint8_t slots[PREFETCH_MAX_ENTRIES];
+    EXPECT_EQ(planPrefetchSlots(stay, 1, 0, 2, slots), 0);
+}
+
+// ============================================================================
+// Storing, eviction and byte budget
+// ============================================================================
+
+TEST_F(PrefetchCacheTest, StoredEntryIsFound) {
+    ASSERT_TRUE(recordPrefetchStored(index, 1, url1, 40000, t0));
+    const PrefetchEntry* entry = findPrefetchEntry(index, 1);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->urlHash, url1);
+    EXPECT_EQ(entry->size, 40000u);
+    EXPECT_EQ(entry->validatedAt, t0);
+    EXPECT_TRUE(hasPrefetchedImages(index));
+    EXPECT_TRUE(isPrefetchIndexValid(index));
+}
+
+TEST_F(PrefetchCacheTest, StoringSameSlotReplacesEntry) {
+    recordPrefetchStored(index, 1, url1, 40000, t0);
+    recordPrefetchStored(index, 1, url1, 50000, t0 + 60);
+    EXPECT_EQ(findPrefetchEntry(index, 1)->size, 50000u);
+    EXPECT_EQ(getPrefetchBudget(index, 2), PREFETCH_MAX_BYTES - 50000u);
+}
+
+TEST_F(PrefetchCacheTest, FullIndexRejectsNewSlot) {
+    for (uint8_t slot = 0; slot < PREFETCH_MAX_ENTRIES; slot++) {
+        ASSERT_TRUE(recordPrefetchStored(index, slot, url1, 1000, t0));
+    }
+    EXPECT_FALSE(recordPrefetchStored(index, PREFETCH_MAX_ENTRIES, url1, 1000, t0));
+    EXPECT_FALSE(recordPrefetchStored(index, IMAGE_SLOT_COUNT, url1, 1000, t0));
+}
+
+TEST_F(PrefetchCacheTest, BudgetExcludesTheSlotsOwnFile) {
+    recordPrefetchStored(index, 1, url1, 60000, t0);
+    recordPrefetchStored(index, 2, url2, 70000, t0);
+    EXPECT_EQ(getPrefetchBudget(index, 1), PREFETCH_MAX_BYTES - 70000u);
+    EXPECT_EQ(getPrefetchBudget(index, 3), PREFETCH_MAX_BYTES - 130000u);
+
+    recordPrefetchStored(index, 3, url1, PREFETCH_MAX_BYTES, t0);  // Over budget (caller's mistake)
+    EXPECT_EQ(getPrefetchBudget(index, 4), 0u);
+}
+
+TEST_F(PrefetchCacheTest, RetainEvictsUnplannedSlots) {
+    recordPrefetchStored(index, 1, url1, 1000, t0);
+    recordPrefetchStored(index, 2, url2, 1000, t0);
+
+    // Carousel moved on: slots 2 and 3 are next
+    uint8_t planned[2] = { 2, 3 };
+    uint32_t hashes[2] = { url2, url1 };
+    uint8_t removed[PREFETCH_MAX_ENTRIES];
+    ASSERT_EQ(retainPrefetchEntries(index, planned, hashes, 2, removed), 1);
+    EXPECT_EQ(removed[0], 1);
+    EXPECT_EQ(findPrefetchEntry(index, 1), nullptr);
+    EXPECT_NE(findPrefetchEntry(index, 2), nullptr);
+}
+
+TEST_F(PrefetchCacheTest, RetainEvictsSlotWhoseUrlChanged) {
+    recordPrefetchStored(index, 1, url1, 1000, t0);
+    uint8_t planned[1] = { 1 };
+    uint32_t hashes[1] = { url2 };
+    uint8_t removed[PREFETCH_MAX_ENTRIES];
+    ASSERT_EQ(retainPrefetchEntries(index, planned, hashes, 1, removed), 1);
+    EXPECT_EQ(removed[0], 1);
+    EXPECT_FALSE(hasPrefetchedImages(index));
+}
+
+TEST_F(PrefetchCacheTest, PrefetchDisabledEvictsEverything) {
+    recordPrefetchStored(index, 1, url1, 1000, t0);
+    recordPrefetchStored(index, 2, url2, 1000, t0);
+    uint8_t removed[PREFETCH_MAX_ENTRIES];
+    EXPECT_EQ(retainPrefetchEntries(index, nullptr, nullptr, 0, removed), 2);
+    EXPECT_FALSE(hasPrefetchedImages(index));
+    EXPECT_TRUE(isPrefetchIndexValid(index));
+}
+
+TEST_F(PrefetchCacheTest, RemovedEntryFreesItsBudget) {
+    recordPrefetchStored(index, 1, url1, 60000, t0);
+    removePrefetchEntry(index, 1);
+    EXPECT_EQ(findPrefetchEntry(index, 1), nullptr);
+    EXPECT_EQ(getPrefetchBudget(index, 2), PREFETCH_MAX_BYTES);
+    removePrefetchEntry(index, PREFETCH_SLOT_NONE);  // No-op on free entries
+    EXPECT_TRUE(isPrefetchIndexValid(index));
+}
+
+// ============================================================================
+// Offline display decision
+// ============================================================================
+
+TEST_F(PrefetchCacheTest, FreshCachedSlotIsDisplayedOffline) {
+    recordPrefetchStored(index, 1, url1, 1000, t0);
+    PrefetchDisplayDecision decision = decidePrefetchDisplay(index, 1, url1, 0, t0 + 600);
+    EXPECT_TRUE(decision.useCache);
+    EXPECT_NE(decision.reason, nullptr);
+}
+
+TEST_F(PrefetchCacheTest, UncachedSlotGoesOnline) {
+    recordPrefetchStored(index, 1, url1, 1000, t0);
+    EXPECT_FALSE(decidePrefetchDisplay(index, 2, url2, 1, t0 + 600).useCache);
+}
+
+TEST_F(PrefetchCacheTest, ChangedUrlGoesOnline) {
+    recordPrefetchStored(index, 1, url1, 1000, t0);
+    EXPECT_FALSE(decidePrefetchDisplay(index, 1, url2, 0, t0 + 600).useCache);
+}
+
+TEST_F(PrefetchCacheTest, SlotOnScreenGoesOnline) {
+    recordPrefetchStored(index, 1, url1, 1000, t0);
+    EXPECT_FALSE(decidePrefetchDisplay(index, 1, url1, 1, t0 + 600).useCache);
+    EXPECT_TRUE(decidePrefetchDisplay(index, 1, url1, IMAGE_SLOT_NONE, t0 + 600).useCache);
+}
+
+TEST_F(PrefetchCacheTest, StaleFileGoesOnlineUntilRevalidated) {
+    recordPrefetchStored(index, 1, url1, 1000, t0);
+    uint32_t late = t0 + PREFETCH_MAX_AGE_SECONDS + 1;
+    EXPECT_TRUE(decidePrefetchDisplay(index, 1, url1, 0, t0 + PREFETCH_MAX_AGE_SECONDS).useCache);
+    EXPECT_FALSE(decidePrefetchDisplay(index, 1, url1, 0, late).useCache);
+
+    recordPrefetchValidated(index, 1, late);  // HTTP 304 on the next online wake
+    EXPECT_TRUE(decidePrefetchDisplay(index, 1, url1, 0, late + 600).useCache);
+}
+
+TEST_F(PrefetchCacheTest, UnsetOrBackwardsClockGoesOnline) {
+    recordPrefetchStored(index, 1, url1, 1000, t0);
+    EXPECT_FALSE(decidePrefetchDisplay(index, 1, url1, 0, 12).useCache);
+    EXPECT_FALSE(decidePrefetchDisplay(index, 1, url1, 0, t0 - 10).useCache);
+}
+
+TEST_F(PrefetchCacheTest, OneOnlineWakeServesTheNextSlotsOffline) {
+    // 4-image carousel, slot 0 displayed online, 2 slots fetched ahead
+    bool stay[4] = { false, false, false, false };
+    uint8_t slots[PREFETCH_MAX_ENTRIES];
+    uint8_t count = planPrefetchSlots(stay, 4, 0, 2, slots);
+    for (uint8_t i = 0; i < count; i++) {
+        recordPrefetchStored(index, slots[i], prefetchUrlHash("u") + slots[i], 30000, t0);
+    }
+
+    uint8_t displayed = 0;
+    uint32_t now = t0;
+    int offline = 0;
+    for (uint8_t target = 1; target < 4; target++) {
+        now += 900;
+        if (decidePrefetchDisplay(index, target, prefetchUrlHash("u") + target, displayed, now).useCache) {
+            offline++;
+        }
+        displayed = target;
+    }
+    EXPECT_EQ(offline, 2);  // Slots 1 and 2; slot 3 needs WiFi
+}
@@ -0,0 +1,276 @@
+#include <gtest/gtest.h>
+#include <telemetry_backlog.h>
+#include <string>
+#include <cstring>
+
+// Test fixture for the offline telemetry ring buffer
+class TelemetryBacklogTest : public ::testing::Test {
+protected:
+    TelemetryBacklog backlog;
+
+    void SetUp() override {
+        initTelemetryBacklog(backlog);
+    }
+
+    // A typical image update, tagged with its timestamp
+    TelemetryRecord makeRecord(uint32_t timestamp) {
+        TelemetryRecord r;
+        r.timestamp = timestamp;
+        r.loopMs = 6230;
+        r.wifiMs = 1500;
+        r.ntpMs = 0;
+        r.crcMs = 310;
+        r.imageMs = 3900;
+        r.batteryMillivolts = 3987;
+        r.batteryPercentage = 85;
+        r.wifiRSSI = -61;
+        r.wifiRetries = 0;
+        r.crcRetries = 1;
+        r.imageRetries = 0;
+        r.result = TELEMETRY_RESULT_DISPLAYED;
+        return r;
+    }
+
+    std::string serialize() {
+        char buffer[TELEMETRY_BACKLOG_DOCUMENT_SIZE];
+        size_t length = serializeTelemetryBacklog(backlog, buffer, sizeof(buffer));
+        EXPECT_EQ(length, strlen(buffer));
+        return std::string(buffer, length);
+    }
+};
+
+// ============================================================================
+// Record Packing
+// ============================================================================
+
+TEST_F(TelemetryBacklogTest, PackRoundTrip) {
+    TelemetryRecord in = makeRecord(1760000000);
+    uint8_t packed[TELEMETRY_RECORD_SIZE];
+    packTelemetryRecord(in, packed);
+
+    TelemetryRecord out;
+    unpackTelemetryRecord(packed, out);
+    EXPECT_EQ(out.timestamp, 1760000000u);
+    EXPECT_EQ(out.loopMs, 6230u);
+    EXPECT_EQ(out.wifiMs, 1500u);
+    EXPECT_EQ(out.ntpMs, 0u);
+    EXPECT_EQ(out.crcMs, 310u);
+    EXPECT_EQ(out.imageMs, 3900u);
+    EXPECT_EQ(out.batteryMillivolts, 3987);
+    EXPECT_EQ(out.batteryPercentage, 85);
+    EXPECT_EQ(out.wifiRSSI, -61);
+    EXPECT_EQ(out.wifiRetries, 0);
+    EXPECT_EQ(out.crcRetries, 1);
+    EXPECT_EQ(out.imageRetries, 0);
+    EXPECT_EQ(out.result, TELEMETRY_RESULT_DISPLAYED);
+}
+
+TEST_F(TelemetryBacklogTest, PackedLayoutIsLittleEndian) {
+    TelemetryRecord in = makeRecord(0x11223344);
+    uint8_t packed[TELEMETRY_RECORD_SIZE];
+    packTelemetryRecord(in, packed);
+
+    EXPECT_EQ(packed[0], 0x44);
+    EXPECT_EQ(packed[3], 0x11);
+    EXPECT_EQ(packed[4] | (packed[5] << 8), 623);   // 6230 ms in 10 ms units
+    EXPECT_EQ(packed[14] | (packed[15] << 8), 3987);
+    EXPECT_EQ(packed[18], (0 << 4) | (1 << 2) | 0);
+    EXPECT_EQ(packed[19], TELEMETRY_RESULT_DISPLAYED);
+}
+
+TEST_F(TelemetryBacklogTest, DurationsRoundedAndSaturated) {
+    TelemetryRecord in = makeRecord(1);
+    in.wifiMs = 1234;           // -> 1230
+    in.ntpMs = 1235;            // -> 1240
+    in.imageMs = 900000;        // 15 min -> 655.35 s
+    uint8_t packed[TELEMETRY_RECORD_SIZE];
+    packTelemetryRecord(in, packed);
+
+    TelemetryRecord out;
+    unpackTelemetryRecord(packed, out);
+    EXPECT_EQ(out.wifiMs, 1230u);
+    EXPECT_EQ(out.ntpMs, 1240u);
+    EXPECT_EQ(out.imageMs, 655350u);
+}
+
+TEST_F(TelemetryBacklogTest, RetriesClamped) {
+    TelemetryRecord in = makeRecord(1);
+    in.wifiRetries = 255;       // "skip" marker from LoopTimings users
+    in.crcRetries = 7;
+    in.imageRetries = 2;
+    uint8_t packed[TELEMETRY_RECORD_SIZE];
+    packTelemetryRecord(in, packed);
+
+    TelemetryRecord out;
+    unpackTelemetryRecord(packed, out);
+    EXPECT_EQ(out.wifiRetries, 15);
+    EXPECT_EQ(out.crcRetries, 3);
+    EXPECT_EQ(out.imageRetries, 2);
+}
+
+TEST_F(TelemetryBacklogTest, NegativeValuesSurvive) {
+    TelemetryRecord in = makeRecord(1);
+    in.batteryPercentage = -1;
+    in.wifiRSSI = -127;
+    uint8_t packed[TELEMETRY_RECORD_SIZE];
+    packTelemetryRecord(in, packed);
+
+    TelemetryRecord out;
+    unpackTelemetryRecord(packed, out);
+    EXPECT_EQ(out.batteryPercentage, -1);
+    EXPECT_EQ(out.wifiRSSI, -127);
+}
+
+// ============================================================================
+// Ring Buffer
+// ============================================================================
+
+TEST_F(TelemetryBacklogTest, ZeroedMemoryIsInvalid) {
+    // RTC memory after a cold boot
+    TelemetryBacklog zeroed;
+    memset(&zeroed, 0, sizeof(zeroed));
+    EXPECT_FALSE(isTelemetryBacklogValid(zeroed));
+    EXPECT_TRUE(isTelemetryBacklogValid(backlog));
+
+    backlog.count = TELEMETRY_BACKLOG_CAPACITY + 1;
+    EXPECT_FALSE(isTelemetryBacklogValid(backlog));
+    backlog.count = 0;
+    backlog.head = TELEMETRY_BACKLOG_CAPACITY;
+    EXPECT_FALSE(isTelemetryBacklogValid(backlog));
+}
+
+TEST_F(TelemetryBacklogTest, PushAndReadInOrder) {
+    for (uint32_t t = 1; t <= 3; t++) {
+        EXPECT_FALSE(pushTelemetryRecord(backlog, makeRecord(t)));
+    }
+    EXPECT_EQ(backlog.count, 3);
+
+    TelemetryRecord r;
+    for (uint8_t i = 0; i < 3; i++) {
+        ASSERT_TRUE(getTelemetryRecord(backlog, i, r));
+        EXPECT_EQ(r.timestamp, i + 1u);
+    }
+    EXPECT_FALSE(getTelemetryRecord(backlog, 3, r));
+}
+
+TEST_F(TelemetryBacklogTest, FullRingDropsOldest) {
+    for (uint32_t t = 1; t <= TELEMETRY_BACKLOG_CAPACITY; t++) {
+        EXPECT_FALSE(pushTelemetryRecord(backlog, makeRecord(t)));
+    }
+    EXPECT_TRUE(pushTelemetryRecord(backlog, makeRecord(100)));
+    EXPECT_TRUE(pushTelemetryRecord(backlog, makeRecord(101)));
+
+    EXPECT_EQ(backlog.count, TELEMETRY_BACKLOG_CAPACITY);
+    EXPECT_EQ(backlog.dropped, 2);
+    EXPECT_TRUE(isTelemetryBacklogValid(backlog));
+
+    TelemetryRecord r;
+    getTelemetryRecord(backlog, 0, r);
+    EXPECT_EQ(r.timestamp, 3u);
+    getTelemetryRecord(backlog, TELEMETRY_BACKLOG_CAPACITY - 1, r);
+    EXPECT_EQ(r.timestamp, 101u);
+}
+
+TEST_F(TelemetryBacklogTest, ClearAfterWrapStartsOver) {
+    for (uint32_t t = 1; t <= TELEMETRY_BACKLOG_CAPACITY + 5; t++) {
+        pushTelemetryRecord(backlog, makeRecord(t));
+    }
+    clearTelemetryBacklog(backlog);
+    EXPECT_EQ(backlog.count, 0);
+    EXPECT_EQ(backlog.dropped, 0);
+    EXPECT_TRUE(isTelemetryBacklogValid(backlog));
+
+    pushTelemetryRecord(backlog, makeRecord(500));
+    TelemetryRecord r;
+    ASSERT_TRUE(getTelemetryRecord(backlog, 0, r));
+    EXPECT_EQ(r.timestamp, 500u);
+}
+
+TEST_F(TelemetryBacklogTest, DroppedCountSaturates) {
+    backlog.dropped = 0xFFFF;
+    for (uint32_t t = 1; t <= TELEMETRY_BACKLOG_CAPACITY + 1; t++) {
+        pushTelemetryRecord(backlog, makeRecord(t));
+    }
+    EXPECT_EQ(backlog.dropped, 0xFFFF);
+}
+
+// ============================================================================
+// Deferral Policy
+// ============================================================================
+
+TEST_F(TelemetryBacklogTest, DefersTimerWakesOnLowBattery) {
+    EXPECT_TRUE(shouldDeferTelemetry(backlog, 3.55f, 10, false));
+    EXPECT_TRUE(shouldDeferTelemetry(backlog, 3.45f, 0, false));
+    EXPECT_FALSE(shouldDeferTelemetry(backlog, 3.60f, TELEMETRY_LOW_BATTERY_PERCENT, false));
+    EXPECT_FALSE(shouldDeferTelemetry(backlog, 4.0f, 75, false));
+}
+
+TEST_F(TelemetryBacklogTest, NeverDefersUserWakesOrWithoutBattery) {
+    EXPECT_FALSE(shouldDeferTelemetry(backlog, 3.55f, 10, true));
+    EXPECT_FALSE(shouldDeferTelemetry(backlog, 0.0f, 0, false));    // USB powered, no battery
+    EXPECT_FALSE(shouldDeferTelemetry(backlog, 3.55f, -1, false));  // Percentage unknown
+}
+
+TEST_F(TelemetryBacklogTest, PublishesWhenRingWouldFill) {
+    for (uint32_t t = 1; t < TELEMETRY_BACKLOG_CAPACITY - 1; t++) {
+        pushTelemetryRecord(backlog, makeRecord(t));
+    }
+    EXPECT_TRUE(shouldDeferTelemetry(backlog, 3.55f, 10, false));
+    pushTelemetryRecord(backlog, makeRecord(99));
+    EXPECT_FALSE(shouldDeferTelemetry(backlog, 3.55f, 10, false));
+}
+
+// ============================================================================
+// Serialization
+// ============================================================================
+
+TEST_F(TelemetryBacklogTest, EmptyBacklogDocument) {
+    EXPECT_EQ(serialize(), "{\"dropped\":0,\"records\":[]}");
+}
+
+TEST_F(TelemetryBacklogTest, RecordsOldestFirst) {
+    pushTelemetryRecord(backlog, makeRecord(1760000000));
+    TelemetryRecord failed = makeRecord(1760000600);
+    failed.result = TELEMETRY_RESULT_ERROR;
+    failed.imageRetries = 2;
+    failed.batteryPercentage = -1;
+    pushTelemetryRecord(backlog, failed);
+
+    EXPECT_EQ(serialize(),
+              "{\"dropped\":0,\"records\":["
+              "{\"t\":1760000000,\"loop\":6.23,\"wifi\":1.50,\"ntp\":0.00,\"crc\":0.31,\"image\":3.90,"
+              "\"mv\":3987,\"pct\":85,\"rssi\":-61,\"retries\":[0,1,0],\"result\":\"displayed\"},"
+              "{\"t\":1760000600,\"loop\":6.23,\"wifi\":1.50,\"ntp\":0.00,\"crc\":0.31,\"image\":3.90,"
+              "\"mv\":3987,\"pct\":-1,\"rssi\":-61,\"retries\":[0,1,2],\"result\":\"error\"}]}");
+}
+
+TEST_F(TelemetryBacklogTest, FullWorstCaseFitsDocumentSize) {
+    TelemetryRecord widest = makeRecord(0xFFFFFFFF);
+    widest.loopMs = widest.wifiMs = widest.ntpMs = widest.crcMs = widest.imageMs = 700000;
+    widest.batteryMillivolts = 0xFFFF;
+    widest.batteryPercentage = -128;
+    widest.wifiRSSI = -128;
+    widest.wifiRetries = widest.crcRetries = widest.imageRetries = 15;
+    widest.result = 200;  // "unknown"
+    for (int i = 0; i < TELEMETRY_BACKLOG_CAPACITY + 3; i++) {
+        pushTelemetryRecord(backlog, widest);
+    }
+
+    char buffer[TELEMETRY_BACKLOG_DOCUMENT_SIZE];
+    size_t length = serializeTelemetryBacklog(backlog, buffer, sizeof(buffer));
+    EXPECT_GT(length, 0u);
+    EXPECT_NE(std::string(buffer).find("\"dropped\":3,"), std::string::npos);
+    EXPECT_NE(std::string(buffer).find("\"result\":\"unknown\""), std::string::npos);
+}
+
+TEST_F(TelemetryBacklogTest, TooSmallBufferReturnsZero) {
+    pushTelemetryRecord(backlog, makeRecord(1));
+    std::string full = serialize();
+
+    char buffer[TELEMETRY_BACKLOG_DOCUMENT_SIZE];
+    EXPECT_EQ(serializeTelemetryBacklog(backlog, buffer, full.size() + 1), full.size());
+    EXPECT_EQ(serializeTelemetryBacklog(backlog, buffer, full.size()), 0u);
+    EXPECT_STREQ(buffer, "");
+    EXPECT_EQ(serializeTelemetryBacklog(backlog, buffer, 10), 0u);
+    EXPECT_EQ(serializeTelemetryBacklog(backlog, nullptr, 100), 0u);
+}
@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+#include <telemetry_payload.h>
+#include <string>
+#include <cstring>
+
+// Test fixture for the batched MQTT state document
+class TelemetryPayloadTest : public ::testing::Test {
+protected:
+    TelemetryState state;
+    char buffer[TELEMETRY_PAYLOAD_SIZE];
+
+    void SetUp() override {
+        initTelemetryState(state);
+    }
+
+    std::string serialize() {
+        size_t length = serializeTelemetryState(state, buffer, sizeof(buffer));
+        EXPECT_EQ(length, strlen(buffer));
+        return std::string(buffer, length);
+    }
+
+    // Every field present, as on a normal image update
+    void fillAll(const char* log = "Image displayed successfully") {
+        state.batteryVoltage = 3.987f;
+        state.batteryPercentage = 85;
+        state.hasWifiRSSI = true;
+        state.wifiRSSI = -61;
+        state.loopTimeSeconds = 6.234f;
+        state.lastLog = log;
+        state.lastLogSeverity = "info";
+        state.hasImageCRC32 = true;
+        state.imageCRC32 = 0x1A2B3C4D;
+        state.wifiBSSID = "AA:BB:CC:DD:EE:FF";
+        state.wifiSeconds = 1.5f;
+        state.wifiEarlySeconds = 0.42f;
+        state.ntpSeconds = 0.0f;
+        state.crcSeconds = 0.31f;
+        state.imageSeconds = 3.9f;
+        state.wifiRetries = 0;
+        state.crcRetries = 1;
+        state.imageRetries = 0;
+        state.tlsFullHandshakes = 1;
+        state.tlsResumedHandshakes = 1;
+        state.httpReusedConnections = 1;
+        state.cycleChargeMah = 0.183f;
+        state.batteryDaysRemaining = 212.4f;
+    }
+};
+
+// ============================================================================
+// Document Content
+// ============================================================================
+
+TEST_F(TelemetryPayloadTest, EmptyStateIsEmptyObject) {
+    EXPECT_EQ(serialize(), "{}");
+}
+
+TEST_F(TelemetryPayloadTest, AllFieldsInSensorOrder) {
+    fillAll();
+    EXPECT_EQ(serialize(),
+              "{\"battery_voltage\":3.987,\"battery_percentage\":85,\"wifi_signal\":-61,"
+              "\"loop_time\":6.23,\"last_log\":\"[INFO] Image displayed successfully\","
+              "\"image_crc32\":\"0x1A2B3C4D\",\"wifi_bssid\":\"AA:BB:CC:DD:EE:FF\","
+              "\"loop_time_wifi\":1.50,\"loop_time_wifi_early\":0.42,\"loop_time_ntp\":0.00,"
+              "\"loop_time_crc\":0.31,\"loop_time_image\":3.90,"
+              "\"loop_time_wifi_retries\":0,\"loop_time_crc_retries\":1,\"loop_time_image_retries\":0,"
+              "\"tls_full_handshakes\":1,\"tls_resumed_handshakes\":1,\"http_reused_connections\":1,"
+              "\"wake_charge\":0.183,\"battery_days_remaining\":212}");
+}
+
+TEST_F(TelemetryPayloadTest, AbsentFieldsAreOmitted) {
+    // Same skip rules as the per-topic messages: no battery, no log, 255 counters, negative timings
+    state.hasWifiRSSI = true;
+    state.wifiRSSI = -70;
+    state.loopTimeSeconds = 2.0f;
+    state.hasImageCRC32 = true;
+    state.imageCRC32 = 0;
+    state.lastLog = "";
+    EXPECT_EQ(serialize(), "{\"wifi_signal\":-70,\"loop_time\":2.00,\"image_crc32\":\"0x00000000\"}");
+}
+
+TEST_F(TelemetryPayloadTest, ZeroCountersArePresent) {
+    state.tlsFullHandshakes = 0;
+    EXPECT_EQ(serialize(), "{\"tls_full_handshakes\":0}");
+}
+
+TEST_F(TelemetryPayloadTest, SeverityUpperCased) {
+    state.lastLog = "Download failed";
+    state.lastLogSeverity = "error";
+    EXPECT_EQ(serialize(), "{\"last_log\":\"[ERROR] Download failed\"}");
+
+    state.lastLogSeverity = nullptr;
+    EXPECT_EQ(serialize(), "{\"last_log\":\"[INFO] Download failed\"}");
+}
+
+TEST_F(TelemetryPayloadTest, LogMessageEscaped) {
+    state.lastLog = "HTTP \"404\" at C:\\path\nnext\tline";
+    EXPECT_EQ(serialize(), "{\"last_log\":\"[INFO] HTTP \\\"404\\\" at C:\\\\path\\u000anext\\u0009line\"}");
+}
+
+TEST_F(TelemetryPayloadTest, LongLogMessageCut) {
+    std::string log(400, 'x');
+    state.lastLog = log.c_str();
+    std::string json = serialize();
+    EXPECT_EQ(json, "{\"last_log\":\"[INFO] " + std::string(TELEMETRY_LOG_MAX_LENGTH, 'x') + "\"}");
+}
+
+TEST_F(TelemetryPayloadTest, LogCutDoesNotSplitUtf8) {
+    // 2-byte characters straddling the cut point
+    std::string log(TELEMETRY_LOG_MAX_LENGTH - 1, 'x');
+    log += "\xC3\xA9\xC3\xA9";
+    state.lastLog = log.c_str();
+    std::string json = serialize();
+    std::string expected = "{\"last_log\":\"[INFO] " + std::string(TELEMETRY_LOG_MAX_LENGTH - 1, 'x') + "\"}";
+    EXPECT_EQ(json, expected);
+}
+
+TEST_F(TelemetryPayloadTest, LogCutCountsEscapedBytes) {
+    // Control characters take 6 bytes each once escaped
+    std::string log(200, '\x01');
+    state.lastLog = log.c_str();
+    std::string json = serialize();
+    std::string escaped;
+    for (int i = 0; i < TELEMETRY_LOG_MAX_LENGTH / 6; i++) {
+        escaped += "\\u0001";
+    }
+    EXPECT_EQ(json, "{\"last_log\":\"[INFO] " + escaped + "\"}");
+}
+
+TEST_F(TelemetryPayloadTest, FloatFormatting) {
+    state.batteryVoltage = 4.2f;
+    state.loopTimeSeconds = 0.006f;
+    state.cycleChargeMah = 0.0f;
+    state.batteryDaysRemaining = 0.4f;
+    EXPECT_EQ(serialize(), "{\"battery_voltage\":4.200,\"loop_time\":0.01,\"wake_charge\":0.000,"
+                           "\"battery_days_remaining\":0}");
+}
+
+// ============================================================================
+// Buffer Limits
+// ============================================================================
+
+TEST_F(TelemetryPayloadTest, WorstCaseFitsPayloadSize) {
+    // Longest log and the widest numbers
+    std::string log(TELEMETRY_LOG_MAX_LENGTH, 'x');
+    fillAll(log.c_str());
+    state.lastLogSeverity = "warning";
+    state.batteryVoltage = 99999.999f;
+    state.batteryPercentage = 100;
+    state.wifiRSSI = -100;
+    state.loopTimeSeconds = 99999.99f;
+    state.wifiSeconds = state.wifiEarlySeconds = 99999.99f;
+    state.imageCRC32 = 0xFFFFFFFF;
+    state.wifiRetries = state.crcRetries = state.imageRetries = 254;
+    state.tlsFullHandshakes = state.tlsResumedHandshakes = state.httpReusedConnections = 254;
+    state.cycleChargeMah = 9999.999f;
+    state.batteryDaysRemaining = 99999.0f;
+
+    size_t length = serializeTelemetryState(state, buffer, sizeof(buffer));
+    EXPECT_GT(length, 0u);
+    EXPECT_LT(length, sizeof(buffer));
+}
+
+TEST_F(TelemetryPayloadTest, TooSmallBufferReturnsZero) {
+    fillAll();
+    char small[64];
+    memset(small, 'z', sizeof(small));
+    EXPECT_EQ(serializeTelemetryState(state, small, sizeof(small)), 0u);
+    EXPECT_EQ(small[0], '\0');
+}
+
+TEST_F(TelemetryPayloadTest, ExactFitSucceeds) {
+    fillAll();
+    size_t length = serializeTelemetryState(state, buffer, sizeof(buffer));
+    ASSERT_GT(length, 0u);
+
+    std::string expected(buffer, length);
+    char exact[TELEMETRY_PAYLOAD_SIZE];
+    EXPECT_EQ(serializeTelemetryState(state, exact, length + 1), length);
+    EXPECT_EQ(std::string(exact), expected);
+    EXPECT_EQ(serializeTelemetryState(state, exact, length), 0u);
+}
+
+TEST_F(TelemetryPayloadTest, NullOrEmptyBuffer) {
+    EXPECT_EQ(serializeTelemetryState(state, nullptr, 100), 0u);
+    EXPECT_EQ(serializeTelemetryState(state, buffer, 0), 0u);
+}
+
+// ============================================================================
+// Discovery Template
+// ============================================================================
+
+TEST_F(TelemetryPayloadTest, ValueTemplateSelectsKey) {
+    char tmpl[160];
+    size_t length = formatTelemetryValueTemplate("battery_voltage", tmpl, sizeof(tmpl));
+    EXPECT_EQ(length, strlen(tmpl));
+    EXPECT_STREQ(tmpl, "{{ value_json.battery_voltage if value_json.battery_voltage is defined else this.state }}");
+}
+
+TEST_F(TelemetryPayloadTest, ValueTemplateFitsLongestKey) {
+    char tmpl[160];
+    EXPECT_GT(formatTelemetryValueTemplate("http_reused_connections", tmpl, sizeof(tmpl)), 0u);
+    EXPECT_EQ(formatTelemetryValueTemplate("http_reused_connections", tmpl, 20), 0u);
+    EXPECT_STREQ(tmpl, "");
+}
@@ -0,0 +1,261 @@
+#include <gtest/gtest.h>
+#include <tile_diff.h>  // Real production code!
+#include <string.h>
+#include <vector>
+
+// 1-bit test frame (8 px per byte, row-major)
+class Frame {
+public:
+    Frame(uint16_t width, uint16_t height)
+        : width(width), height(height), stride((width + 7) / 8), data(stride * height, 0) {}
+
+    void fill(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+        for (uint16_t yy = y; yy < y + h; yy++) {
+            for (uint16_t xx = x; xx < x + w; xx++) {
+                data[yy * stride + xx / 8] |= 0x80 >> (xx % 8);
+            }
+        }
+    }
+
+    void hash(TileHashGrid& grid) const {
+        ASSERT_TRUE(computeTileHashes(data.data(), stride, width, height, 1, grid));
+    }
+
+    uint16_t width;
+    uint16_t height;
+    size_t stride;
+    std::vector<uint8_t> data;
+};
+
+// ============================================================================
+// Hash Tests
+// ============================================================================
+
+TEST(TileDiffTest, Compute_Geometry) {
+    Frame frame(1200, 825);
+    TileHashGrid grid;
+    frame.hash(grid);
+    EXPECT_TRUE(isTileHashGridValid(grid));
+    EXPECT_EQ(grid.cols, 38);   // 1200 / 32 = 37.5
+    EXPECT_EQ(grid.rows, 26);   // 825 / 32 = 25.8
+    EXPECT_EQ(grid.partialCount, 0);
+}
+
+TEST(TileDiffTest, Compute_RejectsTooManyTiles) {
+    std::vector<uint8_t> data(4096 / 8 * 2048, 0);
+    TileHashGrid grid;
+    EXPECT_FALSE(computeTileHashes(data.data(), 4096 / 8, 4096, 2048, 1, grid));
+    EXPECT_FALSE(isTileHashGridValid(grid));
+    EXPECT_FALSE(computeTileHashes(nullptr, 100, 800, 600, 1, grid));
+    EXPECT_FALSE(computeTileHashes(data.data(), 400, 800, 600, 3, grid));
+}
+
+TEST(TileDiffTest, Compute_IgnoresBytesOutsideFrame) {
+    // Stride padding beyond the frame width must not affect the hashes
+    std::vector<uint8_t> a(16 * 40, 0);
+    std::vector<uint8_t> b(16 * 40, 0);
+    for (size_t y = 0; y < 40; y++) {
+        b[y * 16 + 15] = 0xFF;  // Bytes 13..15 are padding for a 100 px wide frame
+    }
+    TileHashGrid ga, gb;
+    ASSERT_TRUE(computeTileHashes(a.data(), 16, 100, 40, 1, ga));
+    ASSERT_TRUE(computeTileHashes(b.data(), 16, 100, 40, 1, gb));
+    EXPECT_EQ(memcmp(ga.hashes, gb.hashes, ga.cols * ga.rows * sizeof(uint16_t)), 0);
+}
+
+TEST(TileDiffTest, Compute_FourBitFrames) {
+    std::vector<uint8_t> data(400 * 64, 0x77);
+    TileHashGrid before, after;
+    ASSERT_TRUE(computeTileHashes(data.data(), 400, 800, 64, 4, before));
+    data[40 * 400 + 399] = 0x70;  // Last pixel of the frame, second tile row
+    ASSERT_TRUE(computeTileHashes(data.data(), 400, 800, 64, 4, after));
+
+    TileDiff diff;
+    diffTileHashes(before, after, diff);
+    EXPECT_EQ(diff.changedTiles, 1);
+    ASSERT_EQ(diff.regionCount, 1);
+    EXPECT_EQ(diff.regions[0].x, 768);
+    EXPECT_EQ(diff.regions[0].y, 32);
+}
+
+// ============================================================================
+// Diff Tests
+// ============================================================================
+
+TEST(TileDiffTest, Diff_IdenticalFrames) {
+    Frame frame(1200, 825);
+    frame.fill(100, 100, 300, 40);
+    TileHashGrid a, b;
+    frame.hash(a);
+    frame.hash(b);
+
+    TileDiff diff;
+    diffTileHashes(a, b, diff);
+    EXPECT_TRUE(diff.comparable);
+    EXPECT_EQ(diff.changedTiles, 0);
+    EXPECT_EQ(diff.regionCount, 0);
+    EXPECT_EQ(diff.totalTiles, 38 * 26);
+}
+
+TEST(TileDiffTest, Diff_SingleRegionMergedAcrossRows) {
+    Frame frame(1200, 825);
+    TileHashGrid before, after;
+    frame.hash(before);
+    frame.fill(70, 40, 60, 50);  // Spans tile cols 2..4, rows 1..2
+    frame.hash(after);
+
+    TileDiff diff;
+    diffTileHashes(before, after, diff);
+    EXPECT_EQ(diff.changedTiles, 6);
+    ASSERT_EQ(diff.regionCount, 1);
+    EXPECT_EQ(diff.regions[0].x, 64);
+    EXPECT_EQ(diff.regions[0].y, 32);
+    EXPECT_EQ(diff.regions[0].width, 96);
+    EXPECT_EQ(diff.regions[0].height, 64);
+}
+
+TEST(TileDiffTest, Diff_SeparateRegions) {
+    Frame frame(1200, 825);
+    TileHashGrid before, after;
+    frame.hash(before);
+    frame.fill(10, 10, 5, 5);        // Tile (0,0)
+    frame.fill(1190, 815, 5, 5);     // Last tile - clipped to the frame
+    frame.hash(after);
+
+    TileDiff diff;
+    diffTileHashes(before, after, diff);
+    EXPECT_EQ(diff.changedTiles, 2);
+    ASSERT_EQ(diff.regionCount, 2);
+    EXPECT_EQ(diff.regions[0].x, 0);
+    EXPECT_EQ(diff.regions[0].width, 32);
+    EXPECT_EQ(diff.regions[1].x, 1184);
+    EXPECT_EQ(diff.regions[1].y, 800);
+    EXPECT_EQ(diff.regions[1].width, 16);
+    EXPECT_EQ(diff.regions[1].height, 25);
+}
+
+TEST(TileDiffTest, Diff_RegionOverflow) {
+    Frame frame(1200, 825);
+    TileHashGrid before, after;
+    frame.hash(before);
+    for (int i = 0; i < TILE_REGION_MAX + 2; i++) {
+        frame.fill((i % 10) * 96, (i / 10) * 96, 4, 4);  // Isolated tiles
+    }
+    frame.hash(after);
+
+    TileDiff diff;
+    diffTileHashes(before, after, diff);
+    EXPECT_EQ(diff.changedTiles, TILE_REGION_MAX + 2);
+    EXPECT_TRUE(diff.regionsOverflow);
+    ASSERT_EQ(diff.regionCount, 1) << "Overflow collapses to the bounding box";
+    EXPECT_EQ(diff.regions[0].x, 0);
+    EXPECT_EQ(diff.regions[0].y, 0);
+    EXPECT_EQ(diff.regions[0].width, 9 * 96 + 32);
+    EXPECT_EQ(diff.regions[0].height, 96 + 32);
+}
+
+TEST(TileDiffTest, Diff_NotComparable) {
+    Frame small(800, 600);
+    Frame large(1200, 825);
+    TileHashGrid a, b, empty;
+    small.hash(a);
+    large.hash(b);
+    initTileHashGrid(empty);
+
+    TileDiff diff;
+    diffTileHashes(a, b, diff);
+    EXPECT_FALSE(diff.comparable);
+    EXPECT_EQ(diff.changedTiles, diff.totalTiles);
+    ASSERT_EQ(diff.regionCount, 1);
+    EXPECT_EQ(diff.regions[0].width, 1200);
+    EXPECT_EQ(diff.regions[0].height, 825);
+
+    diffTileHashes(empty, b, diff);
+    EXPECT_FALSE(diff.comparable);
+}
+
+// ============================================================================
+// Decision Tests
+// ============================================================================
+
+class TileRefreshTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Frame frame(1200, 825);
+        frame.hash(previous);
+        frame.fill(0, 0, 40, 40);  // 4 tiles
+        frame.hash(current);
+        diffTileHashes(previous, current, diff);
+    }
+
+    TileHashGrid previous;
+    TileHashGrid current;
+    TileDiff diff;
+};
+
+TEST_F(TileRefreshTest, SmallChangeIsPartial) {
+    EXPECT_EQ(decideRefresh(previous, diff, 10).kind, REFRESH_PARTIAL);
+}
+
+TEST_F(TileRefreshTest, UnknownScreenIsFull) {
+    initTileHashGrid(previous);  // Another screen was drawn, or cold boot
+    diffTileHashes(previous, current, diff);
+    EXPECT_EQ(decideRefresh(previous, diff, 10).kind, REFRESH_FULL);
+}
+
+TEST_F(TileRefreshTest, UnchangedIsNone) {
+    diffTileHashes(previous, previous, diff);
+    EXPECT_EQ(decideRefresh(previous, diff, 10).kind, REFRESH_NONE);
+}
+
+TEST_F(TileRefreshTest, PeriodicFullRefresh) {
+    previous.partialCount = 9;
+    EXPECT_EQ(decideRefresh(previous, diff, 10).kind, REFRESH_PARTIAL);
+    previous.partialCount = 10;
+    EXPECT_EQ(decideRefresh(previous, diff, 10).kind, REFRESH_FULL);
+    previous.partialCount = 0;
+    EXPECT_EQ(decideRefresh(previous, diff, 0).kind, REFRESH_FULL);
+}
+
+TEST_F(TileRefreshTest, LargeChangeIsFull) {
+    Frame frame(1200, 825);
+    frame.fill(0, 0, 1200, 600);  // ~73% of the tiles
+    frame.hash(current);
+    diffTileHashes(previous, current, diff);
+    EXPECT_EQ(decideRefresh(previous, diff, 10).kind, REFRESH_FULL);
+}
+
+TEST_F(TileRefreshTest, ScatteredSmallChangeIsPartial) {
+    diff.regionsOverflow = true;
+    EXPECT_EQ(decideRefresh(previous, diff, 10).kind, REFRESH_PARTIAL);
+}
+
+TEST_F(TileRefreshTest, CommitCountsPartials) {
+    TileHashGrid stored = previous;
+    stored.partialCount = 3;
+    commitTileHashGrid(stored, current, REFRESH_PARTIAL);
+    EXPECT_EQ(stored.partialCount, 4);
+    EXPECT_EQ(memcmp(stored.hashes, current.hashes, sizeof(stored.hashes)), 0);
+
+    commitTileHashGrid(stored, current, REFRESH_NONE);
+    EXPECT_EQ(stored.partialCount, 4);
+
+    commitTileHashGrid(stored, current, REFRESH_FULL);
+    EXPECT_EQ(stored.partialCount, 0);
+}
+
+TEST_F(TileRefreshTest, CommitRegionsKeepsOtherTiles) {
+    Frame frame(1200, 825);
+    frame.fill(0, 0, 1200, 825);  // Whole buffer differs, only one region was drawn
+    frame.hash(current);
+
+    TileHashGrid stored = previous;
+    TileRegion region = {40, 40, 16, 40};  // Tiles (1,1) and (1,2)
+    commitTileHashRegions(stored, current, &region, 1);
+    EXPECT_EQ(stored.partialCount, 1);
+
+    diffTileHashes(stored, current, diff);
+    EXPECT_EQ(diff.changedTiles, diff.totalTiles - 2);
+    diffTileHashes(previous, stored, diff);
+    EXPECT_EQ(diff.changedTiles, 2);
+}
@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+#include <tile_manifest.h>  // Real production code!
+#include <string.h>
+#include <string>
+
+// Parses a copy (the parser writes into the text)
+class TileManifestTest : public ::testing::Test {
+protected:
+    bool parse(const char* text) {
+        buffer = text;
+        error = nullptr;
+        return parseTileManifest(&buffer[0], manifest, &error);
+    }
+
+    std::string buffer;
+    TileManifest manifest;
+    const char* error;
+};
+
+// ============================================================================
+// URL Detection Tests
+// ============================================================================
+
+TEST(TileManifestUrlTest, DetectsManifestUrls) {
+    EXPECT_TRUE(isTileManifestUrl("http://server/dash/dashboard.tiles"));
+    EXPECT_TRUE(isTileManifestUrl("https://server/dashboard.TILES?v=2"));
+    EXPECT_TRUE(isTileManifestUrl("https://server/dashboard.tiles#top"));
+    EXPECT_FALSE(isTileManifestUrl("http://server/dashboard.png"));
+    EXPECT_FALSE(isTileManifestUrl("http://server/image.png?format=.tiles"));
+    EXPECT_FALSE(isTileManifestUrl("tiles"));
+    EXPECT_FALSE(isTileManifestUrl(nullptr));
+}
+
+// ============================================================================
+// Parse Tests
+// ============================================================================
+
+TEST_F(TileManifestTest, Parse_Valid) {
+    ASSERT_TRUE(parse(
+        "inkplate-tiles 1\n"
+        "size 1200 820\n"
+        "tile 0 0 600 410 8f3a1c22 tiles/0_0.png\n"
+        "tile 600 0 600 410 0x0B9E77D1 tiles/0_1.png\n"
+        "tile 0 410 1200 410 1 /abs/bottom.png\n")) << error;
+    EXPECT_EQ(manifest.width, 1200);
+    EXPECT_EQ(manifest.height, 820);
+    ASSERT_EQ(manifest.tileCount, 3);
+    EXPECT_EQ(manifest.tiles[0].crc32, 0x8f3a1c22u);
+    EXPECT_STREQ(manifest.tiles[0].url, "tiles/0_0.png");
+    EXPECT_EQ(manifest.tiles[1].x, 600);
+    EXPECT_EQ(manifest.tiles[1].crc32, 0x0b9e77d1u);
+    EXPECT_EQ(manifest.tiles[2].y, 410);
+    EXPECT_EQ(manifest.tiles[2].crc32, 1u);
+    EXPECT_STREQ(manifest.tiles[2].url, "/abs/bottom.png");
+}
+
+TEST_F(TileManifestTest, Parse_CommentsBlankLinesAndCRLF) {
+    ASSERT_TRUE(parse(
+        "# generated by generate_tile_manifest.py\r\n"
+        "\r\n"
+        "inkplate-tiles 1\r\n"
+        "  size\t800 600  \r\n"
+        "# header row\r\n"
+        "tile 0 0 800 600 deadbeef full.png\r\n")) << error;
+    ASSERT_EQ(manifest.tileCount, 1);
+    EXPECT_STREQ(manifest.tiles[0].url, "full.png");
+}
+
+TEST_F(TileManifestTest, Parse_NoTrailingNewline) {
+    ASSERT_TRUE(parse("inkplate-tiles 1\nsize 16 16\ntile 0 0 16 16 0 a.png")) << error;
+    EXPECT_STREQ(manifest.tiles[0].url, "a.png");
+}
+
+TEST_F(TileManifestTest, Parse_RejectsBadHeader) {
+    EXPECT_FALSE(parse("inkplate-tiles 2\nsize 16 16\ntile 0 0 16 16 0 a.png\n"));
+    EXPECT_FALSE(parse("size 16 16\ntile 0 0 16 16 0 a.png\n"));
+    EXPECT_FALSE(parse(""));
+    EXPECT_NE(error, nullptr);
+}
+
+TEST_F(TileManifestTest, Parse_RejectsMissingParts) {
+    EXPECT_FALSE(parse("inkplate-tiles 1\n"));
+    EXPECT_FALSE(parse("inkplate-tiles 1\nsize 16 16\n"));
+    EXPECT_STREQ(error, "Manifest lists no tiles");
+    EXPECT_FALSE(parse("inkplate-tiles 1\ntile 0 0 16 16 0 a.png\nsize 16 16\n"));
+    EXPECT_STREQ(error, "Tile before size line");
+}
+
+TEST_F(TileManifestTest, Parse_RejectsMalformedLines) {
+    EXPECT_FALSE(parse("inkplate-tiles 1\nsize 16\ntile 0 0 16 16 0 a.png\n"));
+    EXPECT_FALSE(parse("inkplate-tiles 1\nsize 0 16\ntile 0 0 16 16 0 a.png\n"));
+    EXPECT_FALSE(parse("inkplate-tiles 1\nsize 70000 16\ntile 0 0 16 16 0 a.png\n"));
+    EXPECT_FALSE(parse("inkplate-tiles 1\nsize 16 16\ntile 0 0 16 16 xyz a.png\n"));
+    EXPECT_FALSE(parse("inkplate-tiles 1\nsize 16 16\ntile 0 0 16 16 123456789 a.png\n"));
+    EXPECT_FALSE(parse("inkplate-tiles 1\nsize 16 16\ntile 0 0 16 16 0\n"));
+    EXPECT_FALSE(parse("inkplate-tiles 1\nsize 16 16\ntile 0 0 16 16 0 a.png extra\n"));
+    EXPECT_FALSE(parse("inkplate-tiles 1\nsize 16 16\ntile -8 0 16 16 0 a.png\n"));
+    EXPECT_FALSE(parse("inkplate-tiles 1\nsize 16 16\nimage a.png\n"));
+    EXPECT_STREQ(error, "Unknown manifest line");
+}
+
+TEST_F(TileManifestTest, Parse_RejectsBadGeometry) {
+    EXPECT_FALSE(parse("inkplate-tiles 1\nsize 64 64\ntile 32 0 40 16 0 a.png\n"));
+    EXPECT_STREQ(error, "Tile outside the frame");
+    EXPECT_FALSE(parse("inkplate-tiles 1\nsize 64 64\ntile 0 0 0 16 0 a.png\n"));
+    EXPECT_FALSE(parse("inkplate-tiles 1\nsize 64 64\ntile 4 0 16 16 0 a.png\n"));
+    EXPECT_STREQ(error, "Tile x and width must be multiples of 8");
+    EXPECT_FALSE(parse("inkplate-tiles 1\nsize 64 64\ntile 0 0 12 16 0 a.png\n"));
+    EXPECT_FALSE(parse("inkplate-tiles 1\nsize 64 64\n"
+                       "tile 0 0 32 32 0 a.png\ntile 24 24 16 16 0 b.png\n"));
+    EXPECT_STREQ(error, "Tiles overlap");
+}
+
+TEST_F(TileManifestTest, Parse_OddWidthAtRightEdge) {
+    // The last column may end at an odd frame width
+    EXPECT_TRUE(parse("inkplate-tiles 1\nsize 212 104\n"
+                      "tile 0 0 208 104 0 a.png\ntile 208 0 4 104 0 b.png\n")) << error;
+}
+
+TEST_F(TileManifestTest, Parse_TooManyTiles) {
+    std::string text = "inkplate-tiles 1\nsize 1040 8\n";
+    for (int i = 0; i <= TILE_MANIFEST_MAX_TILES; i++) {
+        text += "tile " + std::to_string(i * 16) + " 0 16 8 0 t.png\n";
+    }
+    EXPECT_FALSE(parse(text.c_str()));
+    EXPECT_STREQ(error, "Too many tiles");
+}
+
+// ============================================================================
+// URL Resolution Tests
+// ============================================================================
+
+TEST(TileManifestUrlTest, Resolve_Relative) {
+    char out[TILE_MANIFEST_URL_SIZE];
+    ASSERT_TRUE(resolveTileUrl("https://host:8443/dash/main.tiles?v=3", "tiles/0_0.png", out, sizeof(out)));
+    EXPECT_STREQ(out, "https://host:8443/dash/tiles/0_0.png");
+    ASSERT_TRUE(resolveTileUrl("http://host/main.tiles", "a.png", out, sizeof(out)));
+    EXPECT_STREQ(out, "http://host/a.png");
+    ASSERT_TRUE(resolveTileUrl("http://host?dash.tiles", "a.png", out, sizeof(out)));
+    EXPECT_STREQ(out, "http://host/a.png");
+}
+
+TEST(TileManifestUrlTest, Resolve_HostRelativeAndAbsolute) {
+    char out[TILE_MANIFEST_URL_SIZE];
+    ASSERT_TRUE(resolveTileUrl("https://host/dash/main.tiles", "/static/a.png", out, sizeof(out)));
+    EXPECT_STREQ(out, "https://host/static/a.png");
+    ASSERT_TRUE(resolveTileUrl("https://host/dash/main.tiles", "http://cdn/a.png", out, sizeof(out)));
+    EXPECT_STREQ(out, "http://cdn/a.png");
+}
+
+TEST(TileManifestUrlTest, Resolve_RejectsOverflowAndBadBase) {
+    char out[24];
+    EXPECT_FALSE(resolveTileUrl("https://host/dash/main.tiles", "tiles/0_0.png", out, sizeof(out)));
+    EXPECT_FALSE(resolveTileUrl("not a url", "a.png", out, sizeof(out)));
+}
+
+// ============================================================================
+// Panel State Tests
+// ============================================================================
+
+class TileManifestStateTest : public TileManifestTest {
+protected:
+    void SetUp() override {
+        ASSERT_TRUE(parse("inkplate-tiles 1\nsize 64 64\n"
+                          "tile 0 0 32 64 11111111 a.png\n"
+                          "tile 32 0 32 64 22222222 b.png\n"));
+        urlHash = tileManifestUrlHash("http://host/dash.tiles");
+        initTileManifestState(state);
+    }
+
+    TileManifestState state;
+    uint32_t urlHash;
+    bool changed[TILE_MANIFEST_MAX_TILES];
+};
+
+TEST_F(TileManifestStateTest, EmptyStateFetchesAll) {
+    EXPECT_EQ(planTileManifestUpdate(state, manifest, urlHash, changed), 2);
+    EXPECT_TRUE(changed[0]);
+    EXPECT_TRUE(changed[1]);
+}
+
+TEST_F(TileManifestStateTest, OnlyChangedTiles) {
+    recordTileManifestState(state, manifest, urlHash);
+    EXPECT_EQ(planTileManifestUpdate(state, manifest, urlHash, changed), 0);
+
+    manifest.tiles[1].crc32 = 0x33333333;
+    EXPECT_EQ(planTileManifestUpdate(state, manifest, urlHash, changed), 1);
+    EXPECT_FALSE(changed[0]);
+    EXPECT_TRUE(changed[1]);
+}
+
+TEST_F(TileManifestStateTest, OtherManifestOrLayoutFetchesAll) {
+    recordTileManifestState(state, manifest, urlHash);
+    EXPECT_EQ(planTileManifestUpdate(state, manifest, tileManifestUrlHash("http://host/other.tiles"), changed), 2);
+
+    manifest.tiles[1].width = 16;  // Same CRCs, different layout
+    EXPECT_EQ(planTileManifestUpdate(state, manifest, urlHash, changed), 2);
+}
+
+TEST_F(TileManifestStateTest, InvalidatedStateFetchesAll) {
+    recordTileManifestState(state, manifest, urlHash);
+    initTileManifestState(state);  // Another screen was drawn
+    EXPECT_EQ(planTileManifestUpdate(state, manifest, urlHash, changed), 2);
+}
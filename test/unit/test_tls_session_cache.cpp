@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include <tls_session_cache.h>  // Real production code!
+#include <string.h>
+
+// Test fixture for the RTC TLS session cache
+class TlsSessionCacheTest : public ::testing::Test {
+protected:
+    TlsSessionCache cache;
+    uint8_t session[64];
+    uint32_t host;
+
+    void SetUp() override {
+        initTlsSessionCache(cache);
+        for (size_t i = 0; i < sizeof(session); i++) {
+            session[i] = (uint8_t)(i * 7 + 1);
+        }
+        host = tlsSessionHostHash("dashboard.example.com", 443, nullptr);
+    }
+};
+
+// ============================================================================
+// Store / Find Tests
+// ============================================================================
+
+TEST_F(TlsSessionCacheTest, Init_IsEmpty) {
+    EXPECT_EQ(findTlsSession(cache, host, 0, nullptr), nullptr);
+}
+
+TEST_F(TlsSessionCacheTest, ZeroedMemory_IsEmpty) {
+    // RTC memory is zeroed on cold boot
+    memset(&cache, 0, sizeof(cache));
+    EXPECT_EQ(findTlsSession(cache, host, 0, nullptr), nullptr);
+}
+
+TEST_F(TlsSessionCacheTest, Store_ThenFindSameHost) {
+    ASSERT_TRUE(storeTlsSession(cache, host, session, sizeof(session), 1700000000));
+
+    size_t length = 0;
+    const uint8_t* found = findTlsSession(cache, host, 1700000060, &length);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(length, sizeof(session));
+    EXPECT_EQ(memcmp(found, session, sizeof(session)), 0);
+}
+
+TEST_F(TlsSessionCacheTest, Find_OtherHostMisses) {
+    storeTlsSession(cache, host, session, sizeof(session), 0);
+    EXPECT_EQ(findTlsSession(cache, tlsSessionHostHash("other.example.com", 443, nullptr), 0, nullptr), nullptr);
+    EXPECT_EQ(findTlsSession(cache, tlsSessionHostHash("dashboard.example.com", 8443, nullptr), 0, nullptr), nullptr);
+}
+
+TEST_F(TlsSessionCacheTest, Store_ReplacesPreviousSession) {
+    uint32_t other = tlsSessionHostHash("other.example.com", 443, nullptr);
+    storeTlsSession(cache, host, session, sizeof(session), 0);
+    storeTlsSession(cache, other, session, 16, 0);
+
+    size_t length = 0;
+    EXPECT_EQ(findTlsSession(cache, host, 0, nullptr), nullptr);
+    EXPECT_NE(findTlsSession(cache, other, 0, &length), nullptr);
+    EXPECT_EQ(length, 16u);
+}
+
+TEST_F(TlsSessionCacheTest, Store_TooLargeLeavesCacheEmpty) {
+    static uint8_t big[TLS_SESSION_MAX_SIZE + 1];
+    storeTlsSession(cache, host, session, sizeof(session), 0);
+
+    EXPECT_FALSE(storeTlsSession(cache, host, big, sizeof(big), 0));
+    EXPECT_EQ(findTlsSession(cache, host, 0, nullptr), nullptr) << "Stale session must not survive a failed store";
+}
+
+TEST_F(TlsSessionCacheTest, Store_EmptyRejected) {
+    EXPECT_FALSE(storeTlsSession(cache, host, session, 0, 0));
+    EXPECT_FALSE(storeTlsSession(cache, host, nullptr, 10, 0));
+}
+
+// ============================================================================
+// Expiry Tests
+// ============================================================================
+
+TEST_F(TlsSessionCacheTest, Expiry_OldSessionNotOffered) {
+    storeTlsSession(cache, host, session, sizeof(session), 1700000000);
+    EXPECT_NE(findTlsSession(cache, host, 1700000000 + TLS_SESSION_MAX_AGE_SECONDS, nullptr), nullptr);
+    EXPECT_EQ(findTlsSession(cache, host, 1700000000 + TLS_SESSION_MAX_AGE_SECONDS + 1, nullptr), nullptr);
+}
+
+TEST_F(TlsSessionCacheTest, Expiry_ClockWentBackwards) {
+    storeTlsSession(cache, host, session, sizeof(session), 1700000000);
+    EXPECT_EQ(findTlsSession(cache, host, 1600000000, nullptr), nullptr);
+}
+
+TEST_F(TlsSessionCacheTest, Expiry_UnknownClockSkipsAgeCheck) {
+    // NTP not synced when stored or now - the server decides
+    storeTlsSession(cache, host, session, sizeof(session), 0);
+    EXPECT_NE(findTlsSession(cache, host, 1800000000, nullptr), nullptr);
+
+    storeTlsSession(cache, host, session, sizeof(session), 1700000000);
+    EXPECT_NE(findTlsSession(cache, host, 0, nullptr), nullptr);
+}
+
+// ============================================================================
+// Host Key Tests
+// ============================================================================
+
+TEST_F(TlsSessionCacheTest, HostHash_CaseInsensitive) {
+    EXPECT_EQ(tlsSessionHostHash("Dashboard.Example.COM", 443, nullptr), host);
+}
+
+TEST_F(TlsSessionCacheTest, HostHash_PinIsPartOfKey) {
+    uint8_t pin[TLS_FINGERPRINT_SIZE] = {0};
+    uint8_t otherPin[TLS_FINGERPRINT_SIZE] = {0};
+    otherPin[31] = 1;
+
+    uint32_t pinned = tlsSessionHostHash("dashboard.example.com", 443, pin);
+    EXPECT_NE(pinned, host);
+    EXPECT_NE(pinned, tlsSessionHostHash("dashboard.example.com", 443, otherPin));
+}
+
+// ============================================================================
+// Fingerprint Tests
+// ============================================================================
+
+TEST(CertFingerprintTest, Parse_ColonSeparated) {
+    uint8_t fp[TLS_FINGERPRINT_SIZE];
+    ASSERT_TRUE(parseCertFingerprint(
+        "00:11:22:33:44:55:66:77:88:99:AA:BB:CC:DD:EE:FF:"
+        "00:11:22:33:44:55:66:77:88:99:aa:bb:cc:dd:ee:ff", fp));
+    EXPECT_EQ(fp[0], 0x00);
+    EXPECT_EQ(fp[10], 0xAA);
+    EXPECT_EQ(fp[31], 0xFF);
+}
+
+TEST(CertFingerprintTest, Parse_PlainAndSpaced) {
+    uint8_t a[TLS_FINGERPRINT_SIZE];
+    uint8_t b[TLS_FINGERPRINT_SIZE];
+    ASSERT_TRUE(parseCertFingerprint("0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef", a));
+    ASSERT_TRUE(parseCertFingerprint(" 01 23 45 67 89 AB CD EF 01 23 45 67 89 AB CD EF 01 23 45 67 89 AB CD EF 01 23 45 67 89 AB CD EF ", b));
+    EXPECT_EQ(memcmp(a, b, sizeof(a)), 0);
+}
+
+TEST(CertFingerprintTest, Parse_RejectsWrongLengthAndGarbage) {
+    uint8_t fp[TLS_FINGERPRINT_SIZE];
+    EXPECT_FALSE(parseCertFingerprint("", fp));
+    EXPECT_FALSE(parseCertFingerprint(nullptr, fp));
+    // SHA-1 (20 bytes) is not accepted
+    EXPECT_FALSE(parseCertFingerprint("00:11:22:33:44:55:66:77:88:99:AA:BB:CC:DD:EE:FF:00:11:22:33", fp));
+    // 33 bytes
+    EXPECT_FALSE(parseCertFingerprint("0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef00", fp));
+    EXPECT_FALSE(parseCertFingerprint("0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdeg", fp));
+    // Separator splitting a byte
+    EXPECT_FALSE(parseCertFingerprint("0:123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef", fp));
+}
+
+TEST(CertFingerprintTest, Format_RoundTrips) {
+    uint8_t fp[TLS_FINGERPRINT_SIZE];
+    for (int i = 0; i < TLS_FINGERPRINT_SIZE; i++) {
+        fp[i] = (uint8_t)(i * 9);
+    }
+    char text[TLS_FINGERPRINT_TEXT_SIZE];
+    formatCertFingerprint(fp, text);
+    EXPECT_EQ(strlen(text), (size_t)TLS_FINGERPRINT_TEXT_SIZE - 1);
+    EXPECT_EQ(strncmp(text, "00:09:12:1B", 11), 0);
+
+    uint8_t parsed[TLS_FINGERPRINT_SIZE];
+    ASSERT_TRUE(parseCertFingerprint(text, parsed));
+    EXPECT_EQ(memcmp(fp, parsed, sizeof(fp)), 0);
+}